@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Compare the cold path (scan + parse + store in the cache) with the warm
+// path (load from the cache) of the on-disk AST cache.
+//
+// Usage: ast_cache_bench [number of functions] [number of iterations]
+
+#include <base/new.h>
+#include <lang/parser/cache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define DEFAULT_FUN_COUNT 2000
+#define DEFAULT_ITERATION_COUNT 5
+#define BENCH_DIR "/tmp/lily_ast_cache_bench"
+#define BENCH_FILE BENCH_DIR "/bench.lily"
+
+static double
+now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void
+generate(FILE *file, Usize fun_count)
+{
+    for (Usize i = 0; i < fun_count; i++) {
+        fprintf(file,
+                "fun compute_%zu(x, y) =\n"
+                "\tmut acc := x * %zu + y\n"
+                "\n"
+                "\twhile acc < 1000 do\n"
+                "\t\tacc += 1\n"
+                "\tend\n"
+                "\n"
+                "\tif acc == 0 do\n"
+                "\t\ttrue\n"
+                "\telse\n"
+                "\t\tfalse\n"
+                "\tend\n"
+                "end\n\n",
+                i,
+                i);
+
+        if (i % 10 == 0)
+            fprintf(file,
+                    "type Point%zu: record =\n"
+                    "\tx Int32,\n"
+                    "\ty Int32\n"
+                    "end\n\n"
+                    "type Color%zu: enum =\n"
+                    "\tHex Uint64,\n"
+                    "\tRgb (Uint8, Uint8, Uint8)\n"
+                    "end\n\n"
+                    "C%zu :: Str := \"constant %zu\";\n\n",
+                    i,
+                    i,
+                    i,
+                    i);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    Usize fun_count =
+      argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_FUN_COUNT;
+    Usize iteration_count =
+      argc > 2 ? strtoull(argv[2], NULL, 10) : DEFAULT_ITERATION_COUNT;
+
+    mkdir(BENCH_DIR, 0755);
+
+    {
+        FILE *file = fopen(BENCH_FILE, "w");
+
+        if (!file) {
+            fprintf(stderr, "error: cannot write %s\n", BENCH_FILE);
+            return 1;
+        }
+
+        generate(file, fun_count);
+        fclose(file);
+    }
+
+    double cold = 0, store = 0, warm = 0;
+    Usize decl_count = 0;
+
+    for (Usize i = 0; i < iteration_count; i++) {
+        // Cold: scan + parse the source, and write the cache file.
+        {
+            struct Source src = NEW(Source, NEW(File, BENCH_FILE));
+            double start = now();
+            struct Parser parser =
+              NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+
+            run__Parser(&parser);
+
+            double parsed = now();
+
+            store__AstCache(BENCH_DIR,
+                            *src.file.content,
+                            parser.decls,
+                            &parser.parse_block);
+
+            double stored = now();
+
+            if (i == 0 || parsed - start < cold)
+                cold = parsed - start;
+
+            if (i == 0 || stored - parsed < store)
+                store = stored - parsed;
+
+            decl_count = len__Vec(*parser.decls);
+
+            FREE(Parser, parser);
+        }
+
+        // Warm: load the declarations from the cache file.
+        {
+            struct Source src = NEW(Source, NEW(File, BENCH_FILE));
+            struct Vec *strings = NEW(Vec, sizeof(struct String));
+            double start = now();
+            struct Vec *decls =
+              load__AstCache(BENCH_DIR, *src.file.content, strings, NULL);
+            double loaded = now();
+
+            if (!decls || len__Vec(*decls) != decl_count) {
+                fprintf(stderr, "error: the cache is not valid\n");
+                return 1;
+            }
+
+            if (i == 0 || loaded - start < warm)
+                warm = loaded - start;
+
+            for (Usize j = len__Vec(*decls); j--;)
+                FREE(DeclAll, get__Vec(*decls, j));
+
+            for (Usize j = len__Vec(*strings); j--;)
+                FREE(String, get__Vec(*strings, j));
+
+            FREE(Vec, decls);
+            FREE(Vec, strings);
+            FREE(Source, src);
+        }
+    }
+
+    printf("decls: %zu (best of %zu)\n", decl_count, iteration_count);
+    printf("cold (scan + parse): %.3fms\n", cold * 1e3);
+    printf("store:               %.3fms\n", store * 1e3);
+    printf("warm (load):         %.3fms\n", warm * 1e3);
+    printf("speedup:             %.1fx\n", cold / warm);
+
+    return 0;
+}
@@ -0,0 +1,1339 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum Op
+{
+    Op0,
+    Op1,
+    Op2,
+    Op3,
+    Op4,
+    Op5,
+    Op6,
+    Op7,
+    Op8,
+    Op9,
+    Op10,
+    Op11,
+    Op12,
+    Op13,
+    Op14,
+    Op15,
+    Op16,
+    Op17,
+    Op18,
+    Op19,
+    Op20,
+    Op21,
+    Op22,
+    Op23,
+    Op24,
+    Op25,
+    Op26,
+    Op27,
+    Op28,
+    Op29,
+    Op30,
+    Op31,
+    Op32,
+    Op33,
+    Op34,
+    Op35,
+    Op36,
+    Op37,
+    Op38,
+    Op39,
+    Op40,
+    Op41,
+    Op42,
+    Op43,
+    Op44,
+    Op45,
+    Op46,
+    Op47,
+    Op48,
+    Op49,
+    Op50,
+    Op51,
+    Op52,
+    Op53,
+    Op54,
+    Op55,
+    Op56,
+    Op57,
+    Op58,
+    Op59,
+    Op60,
+    Op61,
+    Op62,
+    Op63,
+    Op64,
+    Op65,
+    Op66,
+    Op67,
+    Op68,
+    Op69,
+    Op70,
+    Op71,
+    Op72,
+    Op73,
+    Op74,
+    Op75,
+    Op76,
+    Op77,
+    Op78,
+    Op79,
+    Op80,
+    Op81,
+    Op82,
+    Op83,
+    Op84,
+    Op85,
+    Op86,
+    Op87,
+    Op88,
+    Op89,
+    Op90,
+    Op91,
+    Op92,
+    Op93,
+    Op94,
+    Op95,
+    Op96,
+    Op97,
+    Op98,
+    Op99,
+    Op100,
+    Op101,
+    Op102,
+    Op103,
+    Op104,
+    Op105,
+    Op106,
+    Op107,
+    Op108,
+    Op109,
+    Op110,
+    Op111,
+    Op112,
+    Op113,
+    Op114,
+    Op115,
+    Op116,
+    Op117,
+    Op118,
+    Op119,
+    Op120,
+    Op121,
+    Op122,
+    Op123,
+    Op124,
+    Op125,
+    Op126,
+    Op127,
+    Op128,
+    Op129,
+    Op130,
+    Op131,
+    Op132,
+    Op133,
+    Op134,
+    Op135,
+    Op136,
+    Op137,
+    Op138,
+    Op139,
+    Op140,
+    Op141,
+    Op142,
+    Op143,
+    Op144,
+    Op145,
+    Op146,
+    Op147,
+    Op148,
+    Op149,
+    Op150,
+    Op151,
+    Op152,
+    Op153,
+    Op154,
+    Op155,
+    Op156,
+    Op157,
+    Op158,
+    Op159,
+    Op160,
+    Op161,
+    Op162,
+    Op163,
+    Op164,
+    Op165,
+    Op166,
+    Op167,
+    Op168,
+    Op169,
+    Op170,
+    Op171,
+    Op172,
+    Op173,
+    Op174,
+    Op175,
+    Op176,
+    Op177,
+    Op178,
+    Op179,
+    Op180,
+    Op181,
+    Op182,
+    Op183,
+    Op184,
+    Op185,
+    Op186,
+    Op187,
+    Op188,
+    Op189,
+    Op190,
+    Op191,
+    Op192,
+    Op193,
+    Op194,
+    Op195,
+    Op196,
+    Op197,
+    Op198,
+    Op199,
+    Op200,
+    Op201,
+    Op202,
+    Op203,
+    Op204,
+    Op205,
+    Op206,
+    Op207,
+    Op208,
+    Op209,
+    Op210,
+    Op211,
+    Op212,
+    Op213,
+    Op214,
+    Op215,
+    Op216,
+    Op217,
+    Op218,
+    Op219,
+    Op220,
+    Op221,
+    Op222,
+    Op223,
+    Op224,
+    Op225,
+    Op226,
+    Op227,
+    Op228,
+    Op229,
+    Op230,
+    Op231,
+    Op232,
+    Op233,
+    Op234,
+    Op235,
+    Op236,
+    Op237,
+    Op238,
+    Op239,
+    Op240,
+    Op241,
+    Op242,
+    Op243,
+    Op244,
+    Op245,
+    Op246,
+    Op247,
+    Op248,
+    Op249,
+    Op250,
+    Op251,
+    Op252,
+    Op253,
+    Op254,
+    Op255,
+} Op;
+
+static Op
+decode(int64_t n)
+{
+    switch (n) {
+        case 0:
+            return Op0;
+        case 1:
+            return Op1;
+        case 2:
+            return Op2;
+        case 3:
+            return Op3;
+        case 4:
+            return Op4;
+        case 5:
+            return Op5;
+        case 6:
+            return Op6;
+        case 7:
+            return Op7;
+        case 8:
+            return Op8;
+        case 9:
+            return Op9;
+        case 10:
+            return Op10;
+        case 11:
+            return Op11;
+        case 12:
+            return Op12;
+        case 13:
+            return Op13;
+        case 14:
+            return Op14;
+        case 15:
+            return Op15;
+        case 16:
+            return Op16;
+        case 17:
+            return Op17;
+        case 18:
+            return Op18;
+        case 19:
+            return Op19;
+        case 20:
+            return Op20;
+        case 21:
+            return Op21;
+        case 22:
+            return Op22;
+        case 23:
+            return Op23;
+        case 24:
+            return Op24;
+        case 25:
+            return Op25;
+        case 26:
+            return Op26;
+        case 27:
+            return Op27;
+        case 28:
+            return Op28;
+        case 29:
+            return Op29;
+        case 30:
+            return Op30;
+        case 31:
+            return Op31;
+        case 32:
+            return Op32;
+        case 33:
+            return Op33;
+        case 34:
+            return Op34;
+        case 35:
+            return Op35;
+        case 36:
+            return Op36;
+        case 37:
+            return Op37;
+        case 38:
+            return Op38;
+        case 39:
+            return Op39;
+        case 40:
+            return Op40;
+        case 41:
+            return Op41;
+        case 42:
+            return Op42;
+        case 43:
+            return Op43;
+        case 44:
+            return Op44;
+        case 45:
+            return Op45;
+        case 46:
+            return Op46;
+        case 47:
+            return Op47;
+        case 48:
+            return Op48;
+        case 49:
+            return Op49;
+        case 50:
+            return Op50;
+        case 51:
+            return Op51;
+        case 52:
+            return Op52;
+        case 53:
+            return Op53;
+        case 54:
+            return Op54;
+        case 55:
+            return Op55;
+        case 56:
+            return Op56;
+        case 57:
+            return Op57;
+        case 58:
+            return Op58;
+        case 59:
+            return Op59;
+        case 60:
+            return Op60;
+        case 61:
+            return Op61;
+        case 62:
+            return Op62;
+        case 63:
+            return Op63;
+        case 64:
+            return Op64;
+        case 65:
+            return Op65;
+        case 66:
+            return Op66;
+        case 67:
+            return Op67;
+        case 68:
+            return Op68;
+        case 69:
+            return Op69;
+        case 70:
+            return Op70;
+        case 71:
+            return Op71;
+        case 72:
+            return Op72;
+        case 73:
+            return Op73;
+        case 74:
+            return Op74;
+        case 75:
+            return Op75;
+        case 76:
+            return Op76;
+        case 77:
+            return Op77;
+        case 78:
+            return Op78;
+        case 79:
+            return Op79;
+        case 80:
+            return Op80;
+        case 81:
+            return Op81;
+        case 82:
+            return Op82;
+        case 83:
+            return Op83;
+        case 84:
+            return Op84;
+        case 85:
+            return Op85;
+        case 86:
+            return Op86;
+        case 87:
+            return Op87;
+        case 88:
+            return Op88;
+        case 89:
+            return Op89;
+        case 90:
+            return Op90;
+        case 91:
+            return Op91;
+        case 92:
+            return Op92;
+        case 93:
+            return Op93;
+        case 94:
+            return Op94;
+        case 95:
+            return Op95;
+        case 96:
+            return Op96;
+        case 97:
+            return Op97;
+        case 98:
+            return Op98;
+        case 99:
+            return Op99;
+        case 100:
+            return Op100;
+        case 101:
+            return Op101;
+        case 102:
+            return Op102;
+        case 103:
+            return Op103;
+        case 104:
+            return Op104;
+        case 105:
+            return Op105;
+        case 106:
+            return Op106;
+        case 107:
+            return Op107;
+        case 108:
+            return Op108;
+        case 109:
+            return Op109;
+        case 110:
+            return Op110;
+        case 111:
+            return Op111;
+        case 112:
+            return Op112;
+        case 113:
+            return Op113;
+        case 114:
+            return Op114;
+        case 115:
+            return Op115;
+        case 116:
+            return Op116;
+        case 117:
+            return Op117;
+        case 118:
+            return Op118;
+        case 119:
+            return Op119;
+        case 120:
+            return Op120;
+        case 121:
+            return Op121;
+        case 122:
+            return Op122;
+        case 123:
+            return Op123;
+        case 124:
+            return Op124;
+        case 125:
+            return Op125;
+        case 126:
+            return Op126;
+        case 127:
+            return Op127;
+        case 128:
+            return Op128;
+        case 129:
+            return Op129;
+        case 130:
+            return Op130;
+        case 131:
+            return Op131;
+        case 132:
+            return Op132;
+        case 133:
+            return Op133;
+        case 134:
+            return Op134;
+        case 135:
+            return Op135;
+        case 136:
+            return Op136;
+        case 137:
+            return Op137;
+        case 138:
+            return Op138;
+        case 139:
+            return Op139;
+        case 140:
+            return Op140;
+        case 141:
+            return Op141;
+        case 142:
+            return Op142;
+        case 143:
+            return Op143;
+        case 144:
+            return Op144;
+        case 145:
+            return Op145;
+        case 146:
+            return Op146;
+        case 147:
+            return Op147;
+        case 148:
+            return Op148;
+        case 149:
+            return Op149;
+        case 150:
+            return Op150;
+        case 151:
+            return Op151;
+        case 152:
+            return Op152;
+        case 153:
+            return Op153;
+        case 154:
+            return Op154;
+        case 155:
+            return Op155;
+        case 156:
+            return Op156;
+        case 157:
+            return Op157;
+        case 158:
+            return Op158;
+        case 159:
+            return Op159;
+        case 160:
+            return Op160;
+        case 161:
+            return Op161;
+        case 162:
+            return Op162;
+        case 163:
+            return Op163;
+        case 164:
+            return Op164;
+        case 165:
+            return Op165;
+        case 166:
+            return Op166;
+        case 167:
+            return Op167;
+        case 168:
+            return Op168;
+        case 169:
+            return Op169;
+        case 170:
+            return Op170;
+        case 171:
+            return Op171;
+        case 172:
+            return Op172;
+        case 173:
+            return Op173;
+        case 174:
+            return Op174;
+        case 175:
+            return Op175;
+        case 176:
+            return Op176;
+        case 177:
+            return Op177;
+        case 178:
+            return Op178;
+        case 179:
+            return Op179;
+        case 180:
+            return Op180;
+        case 181:
+            return Op181;
+        case 182:
+            return Op182;
+        case 183:
+            return Op183;
+        case 184:
+            return Op184;
+        case 185:
+            return Op185;
+        case 186:
+            return Op186;
+        case 187:
+            return Op187;
+        case 188:
+            return Op188;
+        case 189:
+            return Op189;
+        case 190:
+            return Op190;
+        case 191:
+            return Op191;
+        case 192:
+            return Op192;
+        case 193:
+            return Op193;
+        case 194:
+            return Op194;
+        case 195:
+            return Op195;
+        case 196:
+            return Op196;
+        case 197:
+            return Op197;
+        case 198:
+            return Op198;
+        case 199:
+            return Op199;
+        case 200:
+            return Op200;
+        case 201:
+            return Op201;
+        case 202:
+            return Op202;
+        case 203:
+            return Op203;
+        case 204:
+            return Op204;
+        case 205:
+            return Op205;
+        case 206:
+            return Op206;
+        case 207:
+            return Op207;
+        case 208:
+            return Op208;
+        case 209:
+            return Op209;
+        case 210:
+            return Op210;
+        case 211:
+            return Op211;
+        case 212:
+            return Op212;
+        case 213:
+            return Op213;
+        case 214:
+            return Op214;
+        case 215:
+            return Op215;
+        case 216:
+            return Op216;
+        case 217:
+            return Op217;
+        case 218:
+            return Op218;
+        case 219:
+            return Op219;
+        case 220:
+            return Op220;
+        case 221:
+            return Op221;
+        case 222:
+            return Op222;
+        case 223:
+            return Op223;
+        case 224:
+            return Op224;
+        case 225:
+            return Op225;
+        case 226:
+            return Op226;
+        case 227:
+            return Op227;
+        case 228:
+            return Op228;
+        case 229:
+            return Op229;
+        case 230:
+            return Op230;
+        case 231:
+            return Op231;
+        case 232:
+            return Op232;
+        case 233:
+            return Op233;
+        case 234:
+            return Op234;
+        case 235:
+            return Op235;
+        case 236:
+            return Op236;
+        case 237:
+            return Op237;
+        case 238:
+            return Op238;
+        case 239:
+            return Op239;
+        case 240:
+            return Op240;
+        case 241:
+            return Op241;
+        case 242:
+            return Op242;
+        case 243:
+            return Op243;
+        case 244:
+            return Op244;
+        case 245:
+            return Op245;
+        case 246:
+            return Op246;
+        case 247:
+            return Op247;
+        case 248:
+            return Op248;
+        case 249:
+            return Op249;
+        case 250:
+            return Op250;
+        case 251:
+            return Op251;
+        case 252:
+            return Op252;
+        case 253:
+            return Op253;
+        case 254:
+            return Op254;
+        default:
+            return Op255;
+    }
+}
+
+static int64_t
+apply(Op op, int64_t x)
+{
+    switch (op) {
+        case Op0:
+            return (x * 2 + 0) % 1000003;
+        case Op1:
+            return (x * 3 + 1) % 1000003;
+        case Op2:
+            return (x * 4 + 2) % 1000003;
+        case Op3:
+            return (x * 5 + 3) % 1000003;
+        case Op4:
+            return (x * 6 + 4) % 1000003;
+        case Op5:
+            return (x * 7 + 5) % 1000003;
+        case Op6:
+            return (x * 8 + 6) % 1000003;
+        case Op7:
+            return (x * 2 + 7) % 1000003;
+        case Op8:
+            return (x * 3 + 8) % 1000003;
+        case Op9:
+            return (x * 4 + 9) % 1000003;
+        case Op10:
+            return (x * 5 + 10) % 1000003;
+        case Op11:
+            return (x * 6 + 11) % 1000003;
+        case Op12:
+            return (x * 7 + 12) % 1000003;
+        case Op13:
+            return (x * 8 + 13) % 1000003;
+        case Op14:
+            return (x * 2 + 14) % 1000003;
+        case Op15:
+            return (x * 3 + 15) % 1000003;
+        case Op16:
+            return (x * 4 + 16) % 1000003;
+        case Op17:
+            return (x * 5 + 17) % 1000003;
+        case Op18:
+            return (x * 6 + 18) % 1000003;
+        case Op19:
+            return (x * 7 + 19) % 1000003;
+        case Op20:
+            return (x * 8 + 20) % 1000003;
+        case Op21:
+            return (x * 2 + 21) % 1000003;
+        case Op22:
+            return (x * 3 + 22) % 1000003;
+        case Op23:
+            return (x * 4 + 23) % 1000003;
+        case Op24:
+            return (x * 5 + 24) % 1000003;
+        case Op25:
+            return (x * 6 + 25) % 1000003;
+        case Op26:
+            return (x * 7 + 26) % 1000003;
+        case Op27:
+            return (x * 8 + 27) % 1000003;
+        case Op28:
+            return (x * 2 + 28) % 1000003;
+        case Op29:
+            return (x * 3 + 29) % 1000003;
+        case Op30:
+            return (x * 4 + 30) % 1000003;
+        case Op31:
+            return (x * 5 + 31) % 1000003;
+        case Op32:
+            return (x * 6 + 32) % 1000003;
+        case Op33:
+            return (x * 7 + 33) % 1000003;
+        case Op34:
+            return (x * 8 + 34) % 1000003;
+        case Op35:
+            return (x * 2 + 35) % 1000003;
+        case Op36:
+            return (x * 3 + 36) % 1000003;
+        case Op37:
+            return (x * 4 + 37) % 1000003;
+        case Op38:
+            return (x * 5 + 38) % 1000003;
+        case Op39:
+            return (x * 6 + 39) % 1000003;
+        case Op40:
+            return (x * 7 + 40) % 1000003;
+        case Op41:
+            return (x * 8 + 41) % 1000003;
+        case Op42:
+            return (x * 2 + 42) % 1000003;
+        case Op43:
+            return (x * 3 + 43) % 1000003;
+        case Op44:
+            return (x * 4 + 44) % 1000003;
+        case Op45:
+            return (x * 5 + 45) % 1000003;
+        case Op46:
+            return (x * 6 + 46) % 1000003;
+        case Op47:
+            return (x * 7 + 47) % 1000003;
+        case Op48:
+            return (x * 8 + 48) % 1000003;
+        case Op49:
+            return (x * 2 + 49) % 1000003;
+        case Op50:
+            return (x * 3 + 50) % 1000003;
+        case Op51:
+            return (x * 4 + 51) % 1000003;
+        case Op52:
+            return (x * 5 + 52) % 1000003;
+        case Op53:
+            return (x * 6 + 53) % 1000003;
+        case Op54:
+            return (x * 7 + 54) % 1000003;
+        case Op55:
+            return (x * 8 + 55) % 1000003;
+        case Op56:
+            return (x * 2 + 56) % 1000003;
+        case Op57:
+            return (x * 3 + 57) % 1000003;
+        case Op58:
+            return (x * 4 + 58) % 1000003;
+        case Op59:
+            return (x * 5 + 59) % 1000003;
+        case Op60:
+            return (x * 6 + 60) % 1000003;
+        case Op61:
+            return (x * 7 + 61) % 1000003;
+        case Op62:
+            return (x * 8 + 62) % 1000003;
+        case Op63:
+            return (x * 2 + 63) % 1000003;
+        case Op64:
+            return (x * 3 + 64) % 1000003;
+        case Op65:
+            return (x * 4 + 65) % 1000003;
+        case Op66:
+            return (x * 5 + 66) % 1000003;
+        case Op67:
+            return (x * 6 + 67) % 1000003;
+        case Op68:
+            return (x * 7 + 68) % 1000003;
+        case Op69:
+            return (x * 8 + 69) % 1000003;
+        case Op70:
+            return (x * 2 + 70) % 1000003;
+        case Op71:
+            return (x * 3 + 71) % 1000003;
+        case Op72:
+            return (x * 4 + 72) % 1000003;
+        case Op73:
+            return (x * 5 + 73) % 1000003;
+        case Op74:
+            return (x * 6 + 74) % 1000003;
+        case Op75:
+            return (x * 7 + 75) % 1000003;
+        case Op76:
+            return (x * 8 + 76) % 1000003;
+        case Op77:
+            return (x * 2 + 77) % 1000003;
+        case Op78:
+            return (x * 3 + 78) % 1000003;
+        case Op79:
+            return (x * 4 + 79) % 1000003;
+        case Op80:
+            return (x * 5 + 80) % 1000003;
+        case Op81:
+            return (x * 6 + 81) % 1000003;
+        case Op82:
+            return (x * 7 + 82) % 1000003;
+        case Op83:
+            return (x * 8 + 83) % 1000003;
+        case Op84:
+            return (x * 2 + 84) % 1000003;
+        case Op85:
+            return (x * 3 + 85) % 1000003;
+        case Op86:
+            return (x * 4 + 86) % 1000003;
+        case Op87:
+            return (x * 5 + 87) % 1000003;
+        case Op88:
+            return (x * 6 + 88) % 1000003;
+        case Op89:
+            return (x * 7 + 89) % 1000003;
+        case Op90:
+            return (x * 8 + 90) % 1000003;
+        case Op91:
+            return (x * 2 + 91) % 1000003;
+        case Op92:
+            return (x * 3 + 92) % 1000003;
+        case Op93:
+            return (x * 4 + 93) % 1000003;
+        case Op94:
+            return (x * 5 + 94) % 1000003;
+        case Op95:
+            return (x * 6 + 95) % 1000003;
+        case Op96:
+            return (x * 7 + 96) % 1000003;
+        case Op97:
+            return (x * 8 + 97) % 1000003;
+        case Op98:
+            return (x * 2 + 98) % 1000003;
+        case Op99:
+            return (x * 3 + 99) % 1000003;
+        case Op100:
+            return (x * 4 + 100) % 1000003;
+        case Op101:
+            return (x * 5 + 101) % 1000003;
+        case Op102:
+            return (x * 6 + 102) % 1000003;
+        case Op103:
+            return (x * 7 + 103) % 1000003;
+        case Op104:
+            return (x * 8 + 104) % 1000003;
+        case Op105:
+            return (x * 2 + 105) % 1000003;
+        case Op106:
+            return (x * 3 + 106) % 1000003;
+        case Op107:
+            return (x * 4 + 107) % 1000003;
+        case Op108:
+            return (x * 5 + 108) % 1000003;
+        case Op109:
+            return (x * 6 + 109) % 1000003;
+        case Op110:
+            return (x * 7 + 110) % 1000003;
+        case Op111:
+            return (x * 8 + 111) % 1000003;
+        case Op112:
+            return (x * 2 + 112) % 1000003;
+        case Op113:
+            return (x * 3 + 113) % 1000003;
+        case Op114:
+            return (x * 4 + 114) % 1000003;
+        case Op115:
+            return (x * 5 + 115) % 1000003;
+        case Op116:
+            return (x * 6 + 116) % 1000003;
+        case Op117:
+            return (x * 7 + 117) % 1000003;
+        case Op118:
+            return (x * 8 + 118) % 1000003;
+        case Op119:
+            return (x * 2 + 119) % 1000003;
+        case Op120:
+            return (x * 3 + 120) % 1000003;
+        case Op121:
+            return (x * 4 + 121) % 1000003;
+        case Op122:
+            return (x * 5 + 122) % 1000003;
+        case Op123:
+            return (x * 6 + 123) % 1000003;
+        case Op124:
+            return (x * 7 + 124) % 1000003;
+        case Op125:
+            return (x * 8 + 125) % 1000003;
+        case Op126:
+            return (x * 2 + 126) % 1000003;
+        case Op127:
+            return (x * 3 + 127) % 1000003;
+        case Op128:
+            return (x * 4 + 128) % 1000003;
+        case Op129:
+            return (x * 5 + 129) % 1000003;
+        case Op130:
+            return (x * 6 + 130) % 1000003;
+        case Op131:
+            return (x * 7 + 131) % 1000003;
+        case Op132:
+            return (x * 8 + 132) % 1000003;
+        case Op133:
+            return (x * 2 + 133) % 1000003;
+        case Op134:
+            return (x * 3 + 134) % 1000003;
+        case Op135:
+            return (x * 4 + 135) % 1000003;
+        case Op136:
+            return (x * 5 + 136) % 1000003;
+        case Op137:
+            return (x * 6 + 137) % 1000003;
+        case Op138:
+            return (x * 7 + 138) % 1000003;
+        case Op139:
+            return (x * 8 + 139) % 1000003;
+        case Op140:
+            return (x * 2 + 140) % 1000003;
+        case Op141:
+            return (x * 3 + 141) % 1000003;
+        case Op142:
+            return (x * 4 + 142) % 1000003;
+        case Op143:
+            return (x * 5 + 143) % 1000003;
+        case Op144:
+            return (x * 6 + 144) % 1000003;
+        case Op145:
+            return (x * 7 + 145) % 1000003;
+        case Op146:
+            return (x * 8 + 146) % 1000003;
+        case Op147:
+            return (x * 2 + 147) % 1000003;
+        case Op148:
+            return (x * 3 + 148) % 1000003;
+        case Op149:
+            return (x * 4 + 149) % 1000003;
+        case Op150:
+            return (x * 5 + 150) % 1000003;
+        case Op151:
+            return (x * 6 + 151) % 1000003;
+        case Op152:
+            return (x * 7 + 152) % 1000003;
+        case Op153:
+            return (x * 8 + 153) % 1000003;
+        case Op154:
+            return (x * 2 + 154) % 1000003;
+        case Op155:
+            return (x * 3 + 155) % 1000003;
+        case Op156:
+            return (x * 4 + 156) % 1000003;
+        case Op157:
+            return (x * 5 + 157) % 1000003;
+        case Op158:
+            return (x * 6 + 158) % 1000003;
+        case Op159:
+            return (x * 7 + 159) % 1000003;
+        case Op160:
+            return (x * 8 + 160) % 1000003;
+        case Op161:
+            return (x * 2 + 161) % 1000003;
+        case Op162:
+            return (x * 3 + 162) % 1000003;
+        case Op163:
+            return (x * 4 + 163) % 1000003;
+        case Op164:
+            return (x * 5 + 164) % 1000003;
+        case Op165:
+            return (x * 6 + 165) % 1000003;
+        case Op166:
+            return (x * 7 + 166) % 1000003;
+        case Op167:
+            return (x * 8 + 167) % 1000003;
+        case Op168:
+            return (x * 2 + 168) % 1000003;
+        case Op169:
+            return (x * 3 + 169) % 1000003;
+        case Op170:
+            return (x * 4 + 170) % 1000003;
+        case Op171:
+            return (x * 5 + 171) % 1000003;
+        case Op172:
+            return (x * 6 + 172) % 1000003;
+        case Op173:
+            return (x * 7 + 173) % 1000003;
+        case Op174:
+            return (x * 8 + 174) % 1000003;
+        case Op175:
+            return (x * 2 + 175) % 1000003;
+        case Op176:
+            return (x * 3 + 176) % 1000003;
+        case Op177:
+            return (x * 4 + 177) % 1000003;
+        case Op178:
+            return (x * 5 + 178) % 1000003;
+        case Op179:
+            return (x * 6 + 179) % 1000003;
+        case Op180:
+            return (x * 7 + 180) % 1000003;
+        case Op181:
+            return (x * 8 + 181) % 1000003;
+        case Op182:
+            return (x * 2 + 182) % 1000003;
+        case Op183:
+            return (x * 3 + 183) % 1000003;
+        case Op184:
+            return (x * 4 + 184) % 1000003;
+        case Op185:
+            return (x * 5 + 185) % 1000003;
+        case Op186:
+            return (x * 6 + 186) % 1000003;
+        case Op187:
+            return (x * 7 + 187) % 1000003;
+        case Op188:
+            return (x * 8 + 188) % 1000003;
+        case Op189:
+            return (x * 2 + 189) % 1000003;
+        case Op190:
+            return (x * 3 + 190) % 1000003;
+        case Op191:
+            return (x * 4 + 191) % 1000003;
+        case Op192:
+            return (x * 5 + 192) % 1000003;
+        case Op193:
+            return (x * 6 + 193) % 1000003;
+        case Op194:
+            return (x * 7 + 194) % 1000003;
+        case Op195:
+            return (x * 8 + 195) % 1000003;
+        case Op196:
+            return (x * 2 + 196) % 1000003;
+        case Op197:
+            return (x * 3 + 197) % 1000003;
+        case Op198:
+            return (x * 4 + 198) % 1000003;
+        case Op199:
+            return (x * 5 + 199) % 1000003;
+        case Op200:
+            return (x * 6 + 200) % 1000003;
+        case Op201:
+            return (x * 7 + 201) % 1000003;
+        case Op202:
+            return (x * 8 + 202) % 1000003;
+        case Op203:
+            return (x * 2 + 203) % 1000003;
+        case Op204:
+            return (x * 3 + 204) % 1000003;
+        case Op205:
+            return (x * 4 + 205) % 1000003;
+        case Op206:
+            return (x * 5 + 206) % 1000003;
+        case Op207:
+            return (x * 6 + 207) % 1000003;
+        case Op208:
+            return (x * 7 + 208) % 1000003;
+        case Op209:
+            return (x * 8 + 209) % 1000003;
+        case Op210:
+            return (x * 2 + 210) % 1000003;
+        case Op211:
+            return (x * 3 + 211) % 1000003;
+        case Op212:
+            return (x * 4 + 212) % 1000003;
+        case Op213:
+            return (x * 5 + 213) % 1000003;
+        case Op214:
+            return (x * 6 + 214) % 1000003;
+        case Op215:
+            return (x * 7 + 215) % 1000003;
+        case Op216:
+            return (x * 8 + 216) % 1000003;
+        case Op217:
+            return (x * 2 + 217) % 1000003;
+        case Op218:
+            return (x * 3 + 218) % 1000003;
+        case Op219:
+            return (x * 4 + 219) % 1000003;
+        case Op220:
+            return (x * 5 + 220) % 1000003;
+        case Op221:
+            return (x * 6 + 221) % 1000003;
+        case Op222:
+            return (x * 7 + 222) % 1000003;
+        case Op223:
+            return (x * 8 + 223) % 1000003;
+        case Op224:
+            return (x * 2 + 224) % 1000003;
+        case Op225:
+            return (x * 3 + 225) % 1000003;
+        case Op226:
+            return (x * 4 + 226) % 1000003;
+        case Op227:
+            return (x * 5 + 227) % 1000003;
+        case Op228:
+            return (x * 6 + 228) % 1000003;
+        case Op229:
+            return (x * 7 + 229) % 1000003;
+        case Op230:
+            return (x * 8 + 230) % 1000003;
+        case Op231:
+            return (x * 2 + 231) % 1000003;
+        case Op232:
+            return (x * 3 + 232) % 1000003;
+        case Op233:
+            return (x * 4 + 233) % 1000003;
+        case Op234:
+            return (x * 5 + 234) % 1000003;
+        case Op235:
+            return (x * 6 + 235) % 1000003;
+        case Op236:
+            return (x * 7 + 236) % 1000003;
+        case Op237:
+            return (x * 8 + 237) % 1000003;
+        case Op238:
+            return (x * 2 + 238) % 1000003;
+        case Op239:
+            return (x * 3 + 239) % 1000003;
+        case Op240:
+            return (x * 4 + 240) % 1000003;
+        case Op241:
+            return (x * 5 + 241) % 1000003;
+        case Op242:
+            return (x * 6 + 242) % 1000003;
+        case Op243:
+            return (x * 7 + 243) % 1000003;
+        case Op244:
+            return (x * 8 + 244) % 1000003;
+        case Op245:
+            return (x * 2 + 245) % 1000003;
+        case Op246:
+            return (x * 3 + 246) % 1000003;
+        case Op247:
+            return (x * 4 + 247) % 1000003;
+        case Op248:
+            return (x * 5 + 248) % 1000003;
+        case Op249:
+            return (x * 6 + 249) % 1000003;
+        case Op250:
+            return (x * 7 + 250) % 1000003;
+        case Op251:
+            return (x * 8 + 251) % 1000003;
+        case Op252:
+            return (x * 2 + 252) % 1000003;
+        case Op253:
+            return (x * 3 + 253) % 1000003;
+        case Op254:
+            return (x * 4 + 254) % 1000003;
+        case Op255:
+            return (x * 5 + 255) % 1000003;
+    }
+
+    __builtin_unreachable();
+}
+
+int
+main(void)
+{
+    int64_t x = 1;
+
+    for (int64_t i = 0; i < 50000000; i++)
+        x = apply(decode((x + i) % 256), x);
+
+    printf("%" PRId64 "\n", x);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct Point
+{
+    int64_t x;
+    int64_t y;
+} Point;
+
+typedef struct Particle
+{
+    Point pos;
+    Point vel;
+} Particle;
+
+static Particle
+step(Particle p, int64_t i)
+{
+    return (Particle){
+        .pos = { .x = p.pos.x + p.vel.x, .y = p.pos.y + p.vel.y },
+        .vel = { .x = (p.vel.y + i) % 1009, .y = (p.vel.x * 3 + 1) % 1013 }
+    };
+}
+
+int
+main(void)
+{
+    Particle p = { .pos = { 0, 0 }, .vel = { 1, 2 } };
+
+    for (int64_t i = 0; i < 200000000; i++)
+        p = step(p, i);
+
+    printf("%" PRId64 " %" PRId64 "\n", p.pos.x, p.pos.y);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#!/bin/sh
+
+# MIT License
+#
+# Copyright (c) 2022 ArthurPV
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Compare the C generated by `lily compile` with the same programs written by
+# hand in C: both are built with the same C compiler and flags, the outputs must
+# be equal and the times should be close (the generated code keeps the overflow
+# checks of Lily which the range analysis can't remove, see --stats).
+#
+# Usage: bench/codegen/run.sh [path of lily] [C compiler]
+#
+# LILY_FLAGS is passed to `lily compile`, e.g. LILY_FLAGS=-O0 to measure the
+# generated code without the IR passes.
+
+set -e
+
+LILY=$(realpath "${1:-build/lily}")
+CC=${2:-cc}
+LILY_FLAGS=${LILY_FLAGS:-}
+DIR=$(cd "$(dirname "$0")" && pwd)
+OUT=$(mktemp -d)
+
+trap 'rm -rf "$OUT"' EXIT
+
+# Best time of 3 runs, in seconds.
+best_time() {
+    best=
+    for _ in 1 2 3; do
+        start=$(date +%s.%N)
+        "$1" > "$OUT/output"
+        end=$(date +%s.%N)
+        best=$(awk -v s="$start" -v e="$end" -v b="$best" \
+            'BEGIN { t = e - s; if (b == "" || t < b) b = t; print b }')
+    done
+    echo "$best"
+}
+
+printf "%-10s %10s %10s %8s\n" "bench" "lily" "c" "ratio"
+
+for bench in fib loops records match tail range; do
+    cp "$DIR/$bench.lily" "$OUT"
+    (cd "$OUT" && "$LILY" compile $LILY_FLAGS "$bench.lily" > /dev/null)
+
+    $CC -O2 -w "$OUT/$bench.lily.c" -o "$OUT/$bench.lily.bin"
+    $CC -O2 "$DIR/$bench.c" -o "$OUT/$bench.c.bin"
+
+    if [ "$("$OUT/$bench.lily.bin")" != "$("$OUT/$bench.c.bin")" ]; then
+        echo "error: $bench: the outputs are different" >&2
+        exit 1
+    fi
+
+    lily_time=$(best_time "$OUT/$bench.lily.bin")
+    c_time=$(best_time "$OUT/$bench.c.bin")
+
+    awk -v b="$bench" -v l="$lily_time" -v c="$c_time" \
+        'BEGIN { printf "%-10s %9.3fs %9.3fs %7.2fx\n", b, l, c, l / c }'
+done
@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Render warnings on every line of a generated file, the way the typecheck
+// emits them (each diagnostic copies its line from the file, then the sink
+// sorts and renders all of them in one buffer). The number of warnings is
+// doubled at each step: the time per warning must stay flat.
+//
+// Usage: diagnostic_bench [number of warnings] [number of iterations]
+
+#include <base/new.h>
+#include <base/option.h>
+#include <base/writer.h>
+#include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/sink.h>
+#include <lang/scanner/scanner.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_WARNING_COUNT 100000
+#define DEFAULT_ITERATION_COUNT 3
+#define STEP_COUNT 3
+
+static double
+now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static struct File
+generate_file(Usize line_count)
+{
+    struct File file = { .name = "bench.lily", .content = NEW(String) };
+
+    for (Usize i = 0; i < line_count; i++)
+        push_str__String(file.content, "\tx := ((1 + 2) * 3)\n");
+
+    return file;
+}
+
+// Return the size of the rendered output.
+static Usize
+render_warnings(struct File file, Usize warning_count)
+{
+    struct DiagnosticSink *sink = NEW(DiagnosticSink, 0);
+    struct Writer writer = NEW(WriterBuffer);
+
+    // Pushed from the last line, so the sink has to sort them.
+    for (Usize i = warning_count; i > 0; i--)
+        push__DiagnosticSink(
+          sink,
+          NEW(DiagnosticWithWarn,
+              NEW(LilyWarning, LilyWarningUnusedParen),
+              (struct Location){
+                .s_line = i, .s_col = 7, .e_line = i, .e_col = 19 },
+              file,
+              from__String("remove these parentheses"),
+              None()));
+
+    render__DiagnosticSink(sink, &writer);
+
+    Usize len = writer.len;
+
+    FREE(Writer, writer);
+    FREE(DiagnosticSink, sink);
+
+    return len;
+}
+
+int
+main(int argc, char **argv)
+{
+    Usize warning_count =
+      argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_WARNING_COUNT;
+    Usize iteration_count =
+      argc > 2 ? strtoull(argv[2], NULL, 10) : DEFAULT_ITERATION_COUNT;
+
+    if (warning_count < 1 << (STEP_COUNT - 1)) {
+        fprintf(stderr, "error: expected at least %d warnings\n",
+                1 << (STEP_COUNT - 1));
+        return 1;
+    }
+
+    struct File file = generate_file(warning_count);
+    double times[STEP_COUNT];
+
+    for (Usize step = 0; step < STEP_COUNT; step++) {
+        Usize count = warning_count >> (STEP_COUNT - 1 - step);
+
+        for (Usize i = 0; i < iteration_count; i++) {
+            double start = now();
+            Usize len = render_warnings(file, count);
+            double time = now() - start;
+
+            if (len == 0) {
+                fprintf(stderr, "error: nothing is rendered\n");
+                return 1;
+            }
+
+            if (i == 0 || time < times[step])
+                times[step] = time;
+        }
+
+        printf("warnings: %7zu, render: %9.3fms, per warning: %.3fus\n",
+               count,
+               times[step] * 1e3,
+               times[step] * 1e6 / count);
+    }
+
+    printf("growth for %dx the warnings: %.1fx (best of %zu)\n",
+           1 << (STEP_COUNT - 1),
+           times[STEP_COUNT - 1] / times[0],
+           iteration_count);
+
+    FREE(File, file);
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "generator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define OPTION(name, field)                                                 \
+    if (!strncmp(option, "--" name "=", strlen("--" name "="))) {           \
+        self->field = strtoull(option + strlen("--" name "="), NULL, 10);   \
+        return true;                                                        \
+    }
+
+static void
+write_indent(struct Writer *writer, Usize depth);
+static void
+write_id(struct Writer *writer, const Str prefix, Usize id);
+static void
+generate_imports(struct Writer *writer, struct GeneratorConfig config);
+static void
+generate_literals(struct Writer *writer, struct GeneratorConfig config);
+static void
+generate_enum(struct Writer *writer, struct GeneratorConfig config, Usize id);
+static void
+generate_record(struct Writer *writer,
+                struct GeneratorConfig config,
+                Usize id);
+static void
+generate_class(struct Writer *writer, Usize id);
+static void
+generate_fun(struct Writer *writer,
+             struct GeneratorConfig config,
+             Usize id,
+             Usize depth);
+static void
+generate_modules(struct Writer *writer,
+                 struct GeneratorConfig config,
+                 Usize depth);
+
+struct GeneratorConfig
+default__GeneratorConfig()
+{
+    return (struct GeneratorConfig){ .fun_count = 5000,
+                                     .module_depth = 16,
+                                     .enum_count = 200,
+                                     .enum_variant_count = 50,
+                                     .record_count = 200,
+                                     .record_field_count = 50,
+                                     .class_count = 200,
+                                     .match_arm_count = 20,
+                                     .literal_count = 5000,
+                                     .import_count = 500 };
+}
+
+bool
+parse_option__GeneratorConfig(struct GeneratorConfig *self, const Str option)
+{
+    OPTION("funs", fun_count);
+    OPTION("module-depth", module_depth);
+    OPTION("enums", enum_count);
+    OPTION("enum-variants", enum_variant_count);
+    OPTION("records", record_count);
+    OPTION("record-fields", record_field_count);
+    OPTION("classes", class_count);
+    OPTION("match-arms", match_arm_count);
+    OPTION("literals", literal_count);
+    OPTION("imports", import_count);
+
+    return false;
+}
+
+static void
+write_indent(struct Writer *writer, Usize depth)
+{
+    for (Usize i = 0; i < depth; i++)
+        write_char__Writer(writer, '\t');
+}
+
+static void
+write_id(struct Writer *writer, const Str prefix, Usize id)
+{
+    write_str__Writer(writer, prefix);
+    write_uint__Writer(writer, id);
+}
+
+static void
+generate_imports(struct Writer *writer, struct GeneratorConfig config)
+{
+    for (Usize i = 0; i < config.import_count; i++) {
+        switch (i % 3) {
+            case 0:
+                write_str__Writer(writer, "import \"@std.io");
+                break;
+            case 1:
+                write_str__Writer(writer, "import \"@core.mem");
+                break;
+            default:
+                write_str__Writer(writer, "import \"@std.{fs, path");
+                write_uint__Writer(writer, i);
+                write_char__Writer(writer, '}');
+                break;
+        }
+
+        write_str__Writer(writer, "\" as ");
+        write_id(writer, "imp", i);
+        write_char__Writer(writer, '\n');
+    }
+
+    if (config.import_count > 0)
+        write_char__Writer(writer, '\n');
+}
+
+static void
+generate_literals(struct Writer *writer, struct GeneratorConfig config)
+{
+    for (Usize i = 0; i < config.literal_count; i++) {
+        write_id(writer, "LIT", i);
+
+        switch (i % 6) {
+            case 0:
+                write_str__Writer(writer, " :: Int64 := ");
+                write_uint__Writer(writer, i * 7919);
+                break;
+            case 1:
+                write_str__Writer(writer, " :: Str := \"literal ");
+                write_uint__Writer(writer, i);
+                write_str__Writer(writer, "\\n\"");
+                break;
+            case 2:
+                write_str__Writer(writer, " :: Float64 := ");
+                write_uint__Writer(writer, i);
+                write_str__Writer(writer, ".25");
+                break;
+            case 3:
+                write_str__Writer(writer, " :: Bool := ");
+                write_str__Writer(writer, i % 2 ? "true" : "false");
+                break;
+            case 4:
+                write_str__Writer(writer, " :: Char := 'x'");
+                break;
+            default:
+                write_str__Writer(writer, " := [");
+
+                for (Usize j = 0; j < 8; j++) {
+                    if (j > 0)
+                        write_str__Writer(writer, ", ");
+
+                    write_uint__Writer(writer, i + j);
+                }
+
+                write_char__Writer(writer, ']');
+                break;
+        }
+
+        write_str__Writer(writer, ";\n");
+    }
+
+    if (config.literal_count > 0)
+        write_char__Writer(writer, '\n');
+}
+
+static void
+generate_enum(struct Writer *writer, struct GeneratorConfig config, Usize id)
+{
+    write_id(writer, "type Enum", id);
+    write_str__Writer(writer, ": enum =\n");
+
+    for (Usize i = 0; i < config.enum_variant_count; i++) {
+        write_id(writer, "\tV", i);
+
+        switch (i % 3) {
+            case 1:
+                write_str__Writer(writer, " Uint64");
+                break;
+            case 2:
+                write_str__Writer(writer, " (Uint8, Str, Bool)");
+                break;
+            default:
+                break;
+        }
+
+        if (i + 1 < config.enum_variant_count)
+            write_char__Writer(writer, ',');
+
+        write_char__Writer(writer, '\n');
+    }
+
+    write_str__Writer(writer, "end\n\n");
+}
+
+static void
+generate_record(struct Writer *writer, struct GeneratorConfig config, Usize id)
+{
+    write_id(writer, "type Record", id);
+    write_str__Writer(writer, ": record =\n");
+
+    for (Usize i = 0; i < config.record_field_count; i++) {
+        write_id(writer, "\tfield", i);
+        write_str__Writer(writer, i % 2 ? " Int32" : " Str");
+
+        if (i + 1 < config.record_field_count)
+            write_char__Writer(writer, ',');
+
+        write_char__Writer(writer, '\n');
+    }
+
+    write_str__Writer(writer, "end\n\n");
+}
+
+static void
+generate_class(struct Writer *writer, Usize id)
+{
+    write_id(writer, "object Animal", id);
+    write_str__Writer(writer,
+                      ": trait =\n"
+                      "\t@get_name :: self -> Str\n"
+                      "\t@get_age :: self -> Uint8\n"
+                      "end\n\n");
+
+    write_id(writer, "object Dog", id);
+    write_id(writer, " impl Animal", id);
+    write_str__Writer(writer,
+                      ": class =\n"
+                      "\t@name Str;\n"
+                      "\t@age Uint8;\n"
+                      "\n"
+                      "\tpub fun new(name, age) =\n"
+                      "\t\t@.name = name\n"
+                      "\t\t@.age = age\n"
+                      "\tend\n"
+                      "\n"
+                      "\tpub fun get_name(self) = self.name;\n"
+                      "\tpub fun get_age(self) = self.age;\n"
+                      "end\n\n");
+}
+
+static void
+generate_fun(struct Writer *writer,
+             struct GeneratorConfig config,
+             Usize id,
+             Usize depth)
+{
+    write_indent(writer, depth);
+    write_id(writer, "pub fun compute", id);
+    write_str__Writer(writer, "(x, y) =\n");
+
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "mut acc := x * ");
+    write_uint__Writer(writer, id + 1);
+    write_str__Writer(writer, " + y\n\n");
+
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "while acc < 1000 do\n");
+    write_indent(writer, depth + 2);
+    write_str__Writer(writer, "acc += 1\n");
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "end\n\n");
+
+    if (config.match_arm_count > 0) {
+        write_indent(writer, depth + 1);
+        write_str__Writer(writer, "match acc do\n");
+
+        for (Usize i = 0; i + 1 < config.match_arm_count; i++) {
+            write_indent(writer, depth + 2);
+            write_uint__Writer(writer, i);
+            write_str__Writer(writer, " => ");
+            write_uint__Writer(writer, i * 2);
+            write_str__Writer(writer, ",\n");
+        }
+
+        write_indent(writer, depth + 2);
+        write_str__Writer(writer, "_ => acc,\n");
+        write_indent(writer, depth + 1);
+        write_str__Writer(writer, "end\n\n");
+    }
+
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "if acc == 0 do\n");
+    write_indent(writer, depth + 2);
+    write_str__Writer(writer, "true\n");
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "else\n");
+    write_indent(writer, depth + 2);
+    write_str__Writer(writer, "false\n");
+    write_indent(writer, depth + 1);
+    write_str__Writer(writer, "end\n");
+
+    write_indent(writer, depth);
+    write_str__Writer(writer, "end\n\n");
+}
+
+static void
+generate_modules(struct Writer *writer,
+                 struct GeneratorConfig config,
+                 Usize depth)
+{
+    if (depth == config.module_depth)
+        return;
+
+    write_indent(writer, depth);
+    write_id(writer, "pub module Mod", depth);
+    write_str__Writer(writer, " =\n");
+
+    write_indent(writer, depth + 1);
+    write_id(writer, "pub fun level", depth);
+    write_str__Writer(writer,
+                      depth + 1 < config.module_depth ? "(x) = x + 1;\n\n"
+                                                      : "(x) = x + 1;\n");
+
+    generate_modules(writer, config, depth + 1);
+
+    write_indent(writer, depth);
+    write_str__Writer(writer, "end\n");
+}
+
+void
+generate__Generator(struct Writer *writer, struct GeneratorConfig config)
+{
+    generate_imports(writer, config);
+    generate_literals(writer, config);
+
+    for (Usize i = 0; i < config.enum_count; i++)
+        generate_enum(writer, config, i);
+
+    for (Usize i = 0; i < config.record_count; i++)
+        generate_record(writer, config, i);
+
+    for (Usize i = 0; i < config.class_count; i++)
+        generate_class(writer, i);
+
+    for (Usize i = 0; i < config.fun_count; i++)
+        generate_fun(writer, config, i, 0);
+
+    generate_modules(writer, config, 0);
+}
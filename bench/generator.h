@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Generator of synthetic (but valid) Lily programs, used by lily_gen and
+// parse_bench.
+
+#ifndef LILY_BENCH_GENERATOR_H
+#define LILY_BENCH_GENERATOR_H
+
+#include <base/types.h>
+#include <base/writer.h>
+
+typedef struct GeneratorConfig
+{
+    Usize fun_count;           // number of functions
+    Usize module_depth;        // depth of nested `module`
+    Usize enum_count;          // number of `type ...: enum`
+    Usize enum_variant_count;  // number of variants per enum
+    Usize record_count;        // number of `type ...: record`
+    Usize record_field_count;  // number of fields per record
+    Usize class_count;         // number of classes (each one implements a
+                               // trait)
+    Usize match_arm_count;     // number of arms per `match` (one per function)
+    Usize literal_count;       // number of literal constants
+    Usize import_count;        // number of imports
+} GeneratorConfig;
+
+/**
+ *
+ * @brief Return the default configuration (a program of ~1MB).
+ */
+struct GeneratorConfig
+default__GeneratorConfig();
+
+/**
+ *
+ * @brief Parse an option of the form --name=N.
+ * @return false if the option is unknown.
+ */
+bool
+parse_option__GeneratorConfig(struct GeneratorConfig *self, const Str option);
+
+/**
+ *
+ * @brief Write the generated program.
+ */
+void
+generate__Generator(struct Writer *writer, struct GeneratorConfig config);
+
+#endif // LILY_BENCH_GENERATOR_H
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Write a synthetic Lily program on stdout (or in a file).
+//
+// Usage: lily_gen [-o file] [--funs=N] [--module-depth=N] [--enums=N]
+//                 [--enum-variants=N] [--records=N] [--record-fields=N]
+//                 [--classes=N] [--match-arms=N] [--literals=N]
+//                 [--imports=N]
+
+#include "generator.h"
+
+#include <base/new.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+int
+main(int argc, char **argv)
+{
+    struct GeneratorConfig config = default__GeneratorConfig();
+    int fd = STDOUT_FILENO;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            fd = open(argv[++i], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (fd < 0) {
+                fprintf(stderr, "error: cannot write %s\n", argv[i]);
+                return 1;
+            }
+        } else if (!parse_option__GeneratorConfig(&config, argv[i])) {
+            fprintf(stderr, "error: unknown option: `%s`\n", argv[i]);
+            return 1;
+        }
+    }
+
+    struct Writer writer = NEW(WriterFd, fd);
+
+    generate__Generator(&writer, config);
+
+    bool res = flush__Writer(&writer);
+
+    FREE(Writer, writer);
+
+    if (fd != STDOUT_FILENO)
+        close(fd);
+
+    return res ? 0 : 1;
+}
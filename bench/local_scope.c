@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Compare the resolution of the local values of a function with a backward
+// scan of a flat Vec (every block keeps pushing in the same Vec) and with the
+// lexical scope chain (LocalScopeChain). The generated function has nested
+// blocks, each block declares some locals and every declaration reads all the
+// locals of the enclosing block.
+//
+// Usage: local_scope_bench [locals per block] [depth] [number of iterations]
+
+#include <base/new.h>
+#include <lang/analysis/local_scope.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_LOCAL_COUNT 200
+#define DEFAULT_DEPTH 16
+#define DEFAULT_ITERATION_COUNT 3
+
+static double
+now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static struct Scope *
+scan(struct Vec *locals, struct String *name)
+{
+    for (Usize i = len__Vec(*locals); i--;) {
+        if (eq__String(
+              ((struct Scope *)get__Vec(*locals, i))->name, name, false))
+            return get__Vec(*locals, i);
+    }
+
+    return NULL;
+}
+
+// names[depth][i] is the name of the i-th local of the block at depth.
+static struct String ***
+generate_names(Usize local_count, Usize depth)
+{
+    struct String ***names = malloc(sizeof(struct String **) * depth);
+
+    for (Usize d = 0; d < depth; d++) {
+        names[d] = malloc(sizeof(struct String *) * local_count);
+
+        for (Usize i = 0; i < local_count; i++) {
+            char buffer[64];
+
+            snprintf(buffer, sizeof(buffer), "local_%zu_%zu", d, i);
+            names[d][i] = from__String(buffer);
+        }
+    }
+
+    return names;
+}
+
+static Usize
+resolve_with_scan(struct String ***names,
+                  struct Scope **scopes,
+                  Usize local_count,
+                  Usize depth)
+{
+    struct Vec *locals = NEW(Vec, sizeof(struct Scope));
+    Usize found = 0;
+
+    for (Usize d = 0; d < depth; d++) {
+        for (Usize i = 0; i < local_count; i++) {
+            if (d > 0)
+                for (Usize j = 0; j < local_count; j++)
+                    found += scan(locals, names[d - 1][j]) != NULL;
+
+            push__Vec(locals, scopes[d * local_count + i]);
+        }
+    }
+
+    FREE(Vec, locals);
+
+    return found;
+}
+
+static Usize
+resolve_with_chain(struct String ***names,
+                   struct Scope **scopes,
+                   Usize local_count,
+                   Usize depth)
+{
+    struct LocalScopeChain *chain = NEW(LocalScopeChain);
+    Usize found = 0;
+
+    for (Usize d = 0; d < depth; d++) {
+        enter__LocalScopeChain(chain);
+
+        for (Usize i = 0; i < local_count; i++) {
+            if (d > 0)
+                for (Usize j = 0; j < local_count; j++)
+                    found +=
+                      get__LocalScopeChain(chain, names[d - 1][j]) != NULL;
+
+            add__LocalScopeChain(chain, scopes[d * local_count + i]);
+        }
+    }
+
+    FREE(LocalScopeChain, chain);
+
+    return found;
+}
+
+int
+main(int argc, char **argv)
+{
+    Usize local_count =
+      argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_LOCAL_COUNT;
+    Usize depth = argc > 2 ? strtoull(argv[2], NULL, 10) : DEFAULT_DEPTH;
+    Usize iteration_count =
+      argc > 3 ? strtoull(argv[3], NULL, 10) : DEFAULT_ITERATION_COUNT;
+
+    if (local_count == 0 || depth == 0) {
+        fprintf(stderr, "error: expected at least one local and one block\n");
+        return 1;
+    }
+
+    struct String ***names = generate_names(local_count, depth);
+    struct Scope **scopes =
+      malloc(sizeof(struct Scope *) * local_count * depth);
+
+    for (Usize d = 0; d < depth; d++)
+        for (Usize i = 0; i < local_count; i++)
+            scopes[d * local_count + i] = NEW(Scope,
+                                              "bench",
+                                              names[d][i],
+                                              0,
+                                              ScopeItemKindVariable,
+                                              ScopeKindLocal,
+                                              NULL);
+
+    double scan_time = 0, chain_time = 0;
+    Usize expected = (depth - 1) * local_count * local_count;
+
+    for (Usize i = 0; i < iteration_count; i++) {
+        double start = now();
+        Usize scan_found =
+          resolve_with_scan(names, scopes, local_count, depth);
+        double scanned = now();
+        Usize chain_found =
+          resolve_with_chain(names, scopes, local_count, depth);
+        double chained = now();
+
+        if (scan_found != expected || chain_found != expected) {
+            fprintf(stderr, "error: some locals are not resolved\n");
+            return 1;
+        }
+
+        if (i == 0 || scanned - start < scan_time)
+            scan_time = scanned - start;
+
+        if (i == 0 || chained - scanned < chain_time)
+            chain_time = chained - scanned;
+    }
+
+    printf("locals: %zu, depth: %zu, lookups: %zu (best of %zu)\n",
+           local_count * depth,
+           depth,
+           expected,
+           iteration_count);
+    printf("backward scan: %.3fms\n", scan_time * 1e3);
+    printf("scope chain:   %.3fms\n", chain_time * 1e3);
+    printf("speedup:       %.1fx\n", scan_time / chain_time);
+
+    for (Usize d = 0; d < depth; d++) {
+        for (Usize i = 0; i < local_count; i++) {
+            FREE(Scope, scopes[d * local_count + i]);
+            FREE(String, names[d][i]);
+        }
+
+        free(names[d]);
+    }
+
+    free(names);
+    free(scopes);
+
+    return 0;
+}
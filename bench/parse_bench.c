@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Measure the throughput of the Scanner, the ParseBlock and the Parser
+// separately (tokens/s, decls/s and bytes/s of each phase).
+//
+// Usage: parse_bench [file.lily] [--iterations=N] [generator options]
+//
+// Without file, a program is generated (see lily_gen for the generator
+// options).
+
+#include "generator.h"
+
+#include <base/new.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define DEFAULT_ITERATION_COUNT 5
+#define BENCH_DIR "/tmp/lily_parse_bench"
+#define BENCH_FILE BENCH_DIR "/bench.lily"
+
+static double
+now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void
+report(const Str phase,
+       double time,
+       Usize bytes,
+       Usize tokens,
+       Usize decls)
+{
+    printf("%-12s %9.3fms %12.0f tokens/s %12.0f decls/s %8.2f MB/s\n",
+           phase,
+           time * 1e3,
+           tokens / time,
+           decls / time,
+           bytes / time / 1e6);
+}
+
+int
+main(int argc, char **argv)
+{
+    struct GeneratorConfig config = default__GeneratorConfig();
+    Usize iteration_count = DEFAULT_ITERATION_COUNT;
+    Str filename = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "--iterations=", 13))
+            iteration_count = strtoull(argv[i] + 13, NULL, 10);
+        else if (argv[i][0] != '-')
+            filename = argv[i];
+        else if (!parse_option__GeneratorConfig(&config, argv[i])) {
+            fprintf(stderr, "error: unknown option: `%s`\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!filename) {
+        mkdir(BENCH_DIR, 0755);
+
+        FILE *file = fopen(BENCH_FILE, "w");
+
+        if (!file) {
+            fprintf(stderr, "error: cannot write %s\n", BENCH_FILE);
+            return 1;
+        }
+
+        struct Writer writer = NEW(WriterFd, fileno(file));
+
+        generate__Generator(&writer, config);
+        FREE(Writer, writer);
+        fclose(file);
+
+        filename = BENCH_FILE;
+    }
+
+    double scanner_time = 0, parse_block_time = 0, parser_time = 0;
+    Usize bytes = 0, tokens = 0, decls = 0;
+
+    for (Usize i = 0; i < iteration_count; i++) {
+        struct Source src = NEW(Source, NEW(File, filename));
+        double start = now();
+        // NEW(ParseBlock, ...) runs the Scanner.
+        struct ParseBlock parse_block = NEW(ParseBlock, NEW(Scanner, &src));
+        double scanned = now();
+
+        run__ParseBlock(&parse_block);
+
+        double blocked = now();
+        // The ParseBlock has already been run, so NEW(Parser, ...) doesn't
+        // run it again.
+        struct Parser parser = NEW(Parser, parse_block);
+
+        run__Parser(&parser);
+
+        double parsed = now();
+
+        if (i == 0 || scanned - start < scanner_time)
+            scanner_time = scanned - start;
+
+        if (i == 0 || blocked - scanned < parse_block_time)
+            parse_block_time = blocked - scanned;
+
+        if (i == 0 || parsed - blocked < parser_time)
+            parser_time = parsed - blocked;
+
+        bytes = len__String(*src.file.content);
+        tokens = len__Vec(*parser.parse_block.scanner.tokens);
+        decls = len__Vec(*parser.decls);
+
+        FREE(Parser, parser);
+    }
+
+    printf("file: %s\n", filename);
+    printf("bytes: %zu, tokens: %zu, decls: %zu (best of %zu)\n\n",
+           bytes,
+           tokens,
+           decls,
+           iteration_count);
+    report("Scanner", scanner_time, bytes, tokens, decls);
+    report("ParseBlock", parse_block_time, bytes, tokens, decls);
+    report("Parser", parser_time, bytes, tokens, decls);
+    report("total",
+           scanner_time + parse_block_time + parser_time,
+           bytes,
+           tokens,
+           decls);
+
+    return 0;
+}
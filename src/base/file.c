@@ -34,6 +34,7 @@
 
 #if defined(_WIN32) // TODO: Add support for Windows
 #include <direct.h>
+#include <io.h>
 #else
 #include <dirent.h>
 #endif
@@ -97,6 +98,26 @@ get_extension__Path(struct Path self)
     return extension_str;
 }
 
+Str
+get_canonical__Path(struct Path self)
+{
+    Str path = to_Str__String(*self.path);
+#ifdef LILY_WINDOWS_OS
+    Str canonical = _fullpath(NULL, path, 0);
+
+    if (canonical && _access(canonical, 0) != 0) {
+        free(canonical);
+        canonical = NULL;
+    }
+#else
+    Str canonical = realpath(path, NULL);
+#endif
+
+    free(path);
+
+    return canonical;
+}
+
 struct String *
 read_file__Path(struct Path self)
 {
@@ -60,6 +60,15 @@ is_directory__Path(struct Path self);
 Str
 get_extension__Path(struct Path self);
 
+/**
+ *
+ * @brief Get the canonical path of file (absolute path without `.`, `..` and
+ * symbolic links).
+ * @return the canonical path (allocated) or NULL if the file doesn't exist.
+ */
+Str
+get_canonical__Path(struct Path self);
+
 /**
  *
  * @brief The function try to read the file.
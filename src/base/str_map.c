@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/str_map.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STR_MAP_DEFAULT_CAPACITY 16
+
+static struct StrMapEntry *
+find_entry(struct StrMapEntry *entries,
+           Usize capacity,
+           const char *key,
+           Usize key_len,
+           UInt64 hash);
+static void
+grow(struct StrMap *self);
+
+struct StrMap *
+__new__StrMap()
+{
+    struct StrMap *self = malloc(sizeof(struct StrMap));
+
+    self->entries =
+      calloc(STR_MAP_DEFAULT_CAPACITY, sizeof(struct StrMapEntry));
+    self->len = 0;
+    self->capacity = STR_MAP_DEFAULT_CAPACITY;
+
+    return self;
+}
+
+UInt64
+hash__StrMap(const char *key, Usize key_len)
+{
+    UInt64 hash = 0xcbf29ce484222325ULL;
+
+    for (Usize i = 0; i < key_len; i++) {
+        hash ^= (UInt8)key[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+// Return the entry of key or the empty entry where the key must be inserted.
+static struct StrMapEntry *
+find_entry(struct StrMapEntry *entries,
+           Usize capacity,
+           const char *key,
+           Usize key_len,
+           UInt64 hash)
+{
+    Usize idx = hash & (capacity - 1);
+
+    while (entries[idx].key) {
+        if (entries[idx].hash == hash && entries[idx].key_len == key_len &&
+            !memcmp(entries[idx].key, key, key_len))
+            break;
+
+        idx = (idx + 1) & (capacity - 1);
+    }
+
+    return &entries[idx];
+}
+
+static void
+grow(struct StrMap *self)
+{
+    Usize capacity = self->capacity * 2;
+    struct StrMapEntry *entries = calloc(capacity, sizeof(struct StrMapEntry));
+
+    for (Usize i = 0; i < self->capacity; i++) {
+        struct StrMapEntry *entry = &self->entries[i];
+
+        if (entry->key)
+            *find_entry(
+              entries, capacity, entry->key, entry->key_len, entry->hash) =
+              *entry;
+    }
+
+    free(self->entries);
+
+    self->entries = entries;
+    self->capacity = capacity;
+}
+
+void *
+get__StrMap(struct StrMap self, const Str key)
+{
+    return get_with_len__StrMap(self, key, strlen(key));
+}
+
+void *
+get_with_len__StrMap(struct StrMap self, const char *key, Usize key_len)
+{
+    struct StrMapEntry *entry = find_entry(self.entries,
+                                           self.capacity,
+                                           key,
+                                           key_len,
+                                           hash__StrMap(key, key_len));
+
+    return entry->key ? entry->value : NULL;
+}
+
+void
+insert__StrMap(struct StrMap *self, const Str key, void *value)
+{
+    insert_with_len__StrMap(self, key, strlen(key), value);
+}
+
+void
+insert_with_len__StrMap(struct StrMap *self,
+                        const char *key,
+                        Usize key_len,
+                        void *value)
+{
+    // Keep the load factor under 3/4.
+    if ((self->len + 1) * 4 > self->capacity * 3)
+        grow(self);
+
+    UInt64 hash = hash__StrMap(key, key_len);
+    struct StrMapEntry *entry =
+      find_entry(self->entries, self->capacity, key, key_len, hash);
+
+    if (!entry->key) {
+        entry->key = key;
+        entry->key_len = key_len;
+        entry->hash = hash;
+        self->len++;
+    }
+
+    entry->value = value;
+}
+
+Usize
+len__StrMap(struct StrMap self)
+{
+    return self.len;
+}
+
+void
+__free__StrMap(struct StrMap *self)
+{
+    free(self->entries);
+    free(self);
+}
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_STR_MAP_H
+#define LILY_STR_MAP_H
+
+#include <base/types.h>
+
+typedef struct StrMapEntry
+{
+    const char *key; // const char& (NULL if the entry is empty)
+    Usize key_len;
+    UInt64 hash;
+    void *value; // void&
+} StrMapEntry;
+
+// Hash table (open addressing) with string keys. The keys and the values are
+// not owned by the StrMap, so they must outlive it.
+typedef struct StrMap
+{
+    struct StrMapEntry *entries;
+    Usize len;
+    Usize capacity; // always a power of 2
+} StrMap;
+
+/**
+ *
+ * @brief Construct the StrMap type.
+ */
+struct StrMap *
+__new__StrMap();
+
+/**
+ *
+ * @brief Hash the bytes of key (FNV-1a).
+ */
+UInt64
+hash__StrMap(const char *key, Usize key_len);
+
+/**
+ *
+ * @return the value associated with key or NULL.
+ */
+void *
+get__StrMap(struct StrMap self, const Str key);
+
+/**
+ *
+ * @return the value associated with key (key_len bytes) or NULL.
+ */
+void *
+get_with_len__StrMap(struct StrMap self, const char *key, Usize key_len);
+
+/**
+ *
+ * @brief Insert the value (replace the old value if the key already
+ * exists).
+ */
+void
+insert__StrMap(struct StrMap *self, const Str key, void *value);
+
+/**
+ *
+ * @brief Insert the value with a key of key_len bytes.
+ */
+void
+insert_with_len__StrMap(struct StrMap *self,
+                        const char *key,
+                        Usize key_len,
+                        void *value);
+
+/**
+ *
+ * @return the number of keys.
+ */
+Usize
+len__StrMap(struct StrMap self);
+
+/**
+ *
+ * @brief Free the StrMap type.
+ */
+void
+__free__StrMap(struct StrMap *self);
+
+#endif // LILY_STR_MAP_H
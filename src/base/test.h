@@ -34,13 +34,13 @@
 #define TEST_SKIPPED -1
 
 #define TEST_ASSERT_EQ(l, r) \
-    if (l != r)              \
+    if ((l) != (r))          \
     return TEST_FAILED
 #define TEST_ASSERT_NE(l, r) \
-    if (l == r)              \
+    if ((l) == (r))          \
     return TEST_FAILED
 #define TEST_ASSERT(expr) \
-    if (!expr)            \
+    if (!(expr))          \
     return TEST_FAILED
 
 #define CASE(suite, name, f) add_case__Suite(suite, NEW(Case, #name, f))
@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <assert.h>
+#include <base/thread_pool.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct Worker
+{
+    struct ThreadPool *pool; // struct ThreadPool&
+    Usize id;
+} Worker;
+
+static bool
+pop_front(struct WorkDeque *self, Usize *task);
+static bool
+pop_back(struct WorkDeque *self, Usize *task);
+static int
+run_worker(void *arg);
+
+static bool
+pop_front(struct WorkDeque *self, Usize *task)
+{
+    bool res = false;
+
+    mtx_lock(&self->lock);
+
+    if (self->front < self->back) {
+        *task = self->tasks[self->front++];
+        res = true;
+    }
+
+    mtx_unlock(&self->lock);
+
+    return res;
+}
+
+static bool
+pop_back(struct WorkDeque *self, Usize *task)
+{
+    bool res = false;
+
+    mtx_lock(&self->lock);
+
+    if (self->front < self->back) {
+        *task = self->tasks[--self->back];
+        res = true;
+    }
+
+    mtx_unlock(&self->lock);
+
+    return res;
+}
+
+static int
+run_worker(void *arg)
+{
+    struct Worker *worker = arg;
+    struct ThreadPool *pool = worker->pool;
+    Usize task = 0;
+
+    for (;;) {
+        if (pop_front(&pool->deques[worker->id], &task)) {
+            pool->run(pool->data, task);
+            continue;
+        }
+
+        // No task are pushed while the pool runs, so the work is done when
+        // there is nothing to steal.
+        bool stolen = false;
+
+        for (Usize i = 1; i < pool->worker_count && !stolen; i++)
+            stolen = pop_back(
+              &pool->deques[(worker->id + i) % pool->worker_count], &task);
+
+        if (!stolen)
+            return 0;
+
+        pool->run(pool->data, task);
+    }
+}
+
+struct ThreadPool *
+__new__ThreadPool(Usize worker_count)
+{
+    assert(worker_count > 0 && "expected at least one worker");
+
+    struct ThreadPool *self = malloc(sizeof(struct ThreadPool));
+
+    self->worker_count = worker_count;
+    self->deques = malloc(sizeof(struct WorkDeque) * worker_count);
+    self->tasks = NULL;
+    self->run = NULL;
+    self->data = NULL;
+
+    for (Usize i = 0; i < worker_count; i++)
+        mtx_init(&self->deques[i].lock, mtx_plain);
+
+    return self;
+}
+
+void
+run__ThreadPool(struct ThreadPool *self,
+                Usize task_count,
+                ThreadPoolTask run,
+                void *data)
+{
+    struct Worker *workers = malloc(sizeof(struct Worker) * self->worker_count);
+    thrd_t *threads = malloc(sizeof(thrd_t) * self->worker_count);
+    bool *started = malloc(sizeof(bool) * self->worker_count);
+
+    self->tasks = malloc(sizeof(Usize) * (task_count ? task_count : 1));
+    self->run = run;
+    self->data = data;
+
+    for (Usize i = 0; i < task_count; i++)
+        self->tasks[i] = i;
+
+    for (Usize i = 0; i < self->worker_count; i++) {
+        self->deques[i].tasks = self->tasks;
+        self->deques[i].front = task_count * i / self->worker_count;
+        self->deques[i].back = task_count * (i + 1) / self->worker_count;
+
+        workers[i].pool = self;
+        workers[i].id = i;
+    }
+
+    // If a thread can't be created, its tasks are stolen by the other workers.
+    for (Usize i = 1; i < self->worker_count; i++)
+        started[i] =
+          thrd_create(&threads[i], &run_worker, &workers[i]) == thrd_success;
+
+    run_worker(&workers[0]);
+
+    for (Usize i = 1; i < self->worker_count; i++)
+        if (started[i])
+            thrd_join(threads[i], NULL);
+
+    free(self->tasks);
+    free(started);
+    free(threads);
+    free(workers);
+
+    self->tasks = NULL;
+}
+
+void
+__free__ThreadPool(struct ThreadPool *self)
+{
+    for (Usize i = 0; i < self->worker_count; i++)
+        mtx_destroy(&self->deques[i].lock);
+
+    free(self->deques);
+    free(self);
+}
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_THREAD_POOL_H
+#define LILY_THREAD_POOL_H
+
+#include <base/types.h>
+#include <threads.h>
+
+// Tasks of one worker. The owner takes the tasks from the front, the other
+// workers steal them from the back.
+typedef struct WorkDeque
+{
+    mtx_t lock;
+    Usize *tasks; // Usize* (borrowed from the ThreadPool)
+    Usize front;
+    Usize back;
+} WorkDeque;
+
+typedef void (*ThreadPoolTask)(void *data, Usize task);
+
+// Work-stealing pool: the tasks (numbered from 0) are split in contiguous
+// chunks, one per worker, and a worker whose deque is empty steals from the
+// others until all the deques are empty. The calling thread is the worker 0.
+typedef struct ThreadPool
+{
+    Usize worker_count;
+    struct WorkDeque *deques; // struct WorkDeque*
+    Usize *tasks;             // Usize*
+    ThreadPoolTask run;
+    void *data; // void&
+} ThreadPool;
+
+/**
+ *
+ * @brief Construct the ThreadPool type.
+ * @param worker_count The number of threads (including the calling thread).
+ */
+struct ThreadPool *
+__new__ThreadPool(Usize worker_count);
+
+/**
+ *
+ * @brief Run the tasks 0..task_count-1 and wait for the end of all of them.
+ */
+void
+run__ThreadPool(struct ThreadPool *self,
+                Usize task_count,
+                ThreadPoolTask run,
+                void *data);
+
+/**
+ *
+ * @brief Free the ThreadPool type.
+ */
+void
+__free__ThreadPool(struct ThreadPool *self);
+
+#endif // LILY_THREAD_POOL_H
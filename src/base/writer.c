@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/platform.h>
+#include <base/writer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LILY_WINDOWS_OS
+#include <io.h>
+#define write _write
+#else
+#include <unistd.h>
+#endif
+
+struct Writer
+__new__WriterBuffer()
+{
+    struct Writer self = { .buffer = malloc(256),
+                           .len = 0,
+                           .capacity = 256,
+                           .fd = -1 };
+
+    return self;
+}
+
+struct Writer
+__new__WriterFd(int fd)
+{
+    struct Writer self = { .buffer = malloc(WRITER_FLUSH_SIZE),
+                           .len = 0,
+                           .capacity = WRITER_FLUSH_SIZE,
+                           .fd = fd };
+
+    return self;
+}
+
+static inline void
+reserve(struct Writer *self, Usize len)
+{
+    if (self->len + len <= self->capacity)
+        return;
+
+    if (self->fd >= 0) {
+        flush__Writer(self);
+
+        if (len <= self->capacity)
+            return;
+    }
+
+    while (self->len + len > self->capacity)
+        self->capacity *= 2;
+
+    self->buffer = realloc(self->buffer, self->capacity);
+}
+
+void
+write_bytes__Writer(struct Writer *self, const char *bytes, Usize len)
+{
+    reserve(self, len);
+    memcpy(self->buffer + self->len, bytes, len);
+    self->len += len;
+}
+
+void
+write_char__Writer(struct Writer *self, char c)
+{
+    reserve(self, 1);
+    self->buffer[self->len++] = c;
+}
+
+void
+write_str__Writer(struct Writer *self, const Str s)
+{
+    write_bytes__Writer(self, s, strlen(s));
+}
+
+void
+write_String__Writer(struct Writer *self, struct String *s)
+{
+    Usize len = len__String(*s);
+
+    reserve(self, len);
+
+    for (Usize i = 0; i < len; i++)
+        self->buffer[self->len++] = (char)(UPtr)get__String(*s, i);
+}
+
+void
+write_int__Writer(struct Writer *self, Int64 value)
+{
+    if (value < 0) {
+        write_char__Writer(self, '-');
+        write_uint__Writer(self, -(UInt64)value);
+    } else
+        write_uint__Writer(self, value);
+}
+
+void
+write_uint__Writer(struct Writer *self, UInt64 value)
+{
+    char digits[20];
+    Usize len = 0;
+
+    do {
+        digits[len++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    reserve(self, len);
+
+    while (len--)
+        self->buffer[self->len++] = digits[len];
+}
+
+void
+write_float__Writer(struct Writer *self, Float64 value)
+{
+    char s[32];
+    int len = snprintf(s, sizeof(s), "%g", value);
+
+    write_bytes__Writer(self, s, len);
+}
+
+bool
+flush__Writer(struct Writer *self)
+{
+    if (self->fd < 0)
+        return true;
+
+    Usize written = 0;
+
+    while (written < self->len) {
+        Isize res =
+          write(self->fd, self->buffer + written, self->len - written);
+
+        if (res <= 0) {
+            self->len = 0;
+            return false;
+        }
+
+        written += res;
+    }
+
+    self->len = 0;
+
+    return true;
+}
+
+Str
+take__Writer(struct Writer *self)
+{
+    Str s = malloc(self->len + 1);
+
+    memcpy(s, self->buffer, self->len);
+    s[self->len] = '\0';
+    self->len = 0;
+
+    return s;
+}
+
+void
+__free__Writer(struct Writer self)
+{
+    flush__Writer(&self);
+    free(self.buffer);
+}
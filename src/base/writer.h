@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_WRITER_H
+#define LILY_WRITER_H
+
+#include <base/string.h>
+#include <base/types.h>
+#include <stdbool.h>
+
+// When the Writer is attached to a file descriptor, the buffer is flushed
+// each time its length exceeds this value.
+#define WRITER_FLUSH_SIZE 65536
+
+typedef struct Writer
+{
+    char *buffer;
+    Usize len;
+    Usize capacity;
+    int fd; // -1 if the Writer only writes in its buffer
+} Writer;
+
+/**
+ *
+ * @brief Construct the Writer type (write in a growable buffer).
+ */
+struct Writer
+__new__WriterBuffer();
+
+/**
+ *
+ * @brief Construct the Writer type (write in a file descriptor).
+ */
+struct Writer
+__new__WriterFd(int fd);
+
+/**
+ *
+ * @brief Write len bytes.
+ */
+void
+write_bytes__Writer(struct Writer *self, const char *bytes, Usize len);
+
+/**
+ *
+ * @brief Write a character.
+ */
+void
+write_char__Writer(struct Writer *self, char c);
+
+/**
+ *
+ * @brief Write a C string.
+ */
+void
+write_str__Writer(struct Writer *self, const Str s);
+
+/**
+ *
+ * @brief Write the content of the String.
+ */
+void
+write_String__Writer(struct Writer *self, struct String *s);
+
+/**
+ *
+ * @brief Write a signed integer in decimal.
+ */
+void
+write_int__Writer(struct Writer *self, Int64 value);
+
+/**
+ *
+ * @brief Write an unsigned integer in decimal.
+ */
+void
+write_uint__Writer(struct Writer *self, UInt64 value);
+
+/**
+ *
+ * @brief Write a float (shortest representation with %g).
+ */
+void
+write_float__Writer(struct Writer *self, Float64 value);
+
+/**
+ *
+ * @brief Write the content of the buffer in the file descriptor (do nothing
+ * if the Writer only writes in its buffer).
+ * @return false if the write has failed.
+ */
+bool
+flush__Writer(struct Writer *self);
+
+/**
+ *
+ * @brief Take the content of the buffer (null terminated).
+ * @return Str (owned)
+ */
+Str
+take__Writer(struct Writer *self);
+
+/**
+ *
+ * @brief Flush and free the Writer type.
+ */
+void
+__free__Writer(struct Writer self);
+
+#endif // LILY_WRITER_H
@@ -22,17 +22,28 @@
  * SOFTWARE.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <base/platform.h>
 #include <base/print.h>
 #include <base/util.h>
 #include <command/command.h>
 #include <command/help.h>
+#include <command/parse.h>
+#include <lang/analysis/query.h>
 #include <lang/analysis/typecheck.h>
+#include <lang/diagnostic/sink.h>
+#include <lang/diagnostic/summary.h>
 #include <lang/generate/generate.h>
 #include <lang/generate/generate_c.h>
+#include <lang/ir/ir.h>
+#include <lang/ir/mono.h>
+#include <lang/ir/pass.h>
+#include <lang/parser/ast_dump.h>
+#include <lang/parser/cache.h>
 #include <lang/parser/parser.h>
 #include <lang/scanner/scanner.h>
 #include <lang/scanner/token.h>
@@ -49,6 +60,17 @@
 #error "unknown C compiler"
 #endif
 
+// Wall clock time in seconds (the passes can run on several threads).
+static double
+now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -88,21 +110,153 @@ main(int argc, char **argv)
                 clock_t start = clock();
 #endif
 
-                struct File file = NEW(File, argv[2]);
+                struct CompileOption option =
+                  parse__CompileOption(argc - 2, argv + 2);
+
+                global__DiagnosticSink()->error_limit = option.error_limit;
+
+                double parse_start = now();
+                struct File file = NEW(File, option.filename);
                 struct Source src = NEW(Source, file);
-                struct Scanner scanner = NEW(Scanner, &src);
-                struct ParseBlock parse_block = NEW(ParseBlock, scanner);
-                struct Parser parser = NEW(Parser, parse_block);
+                struct Parser parser = NEW(ParserWithCache, &src);
+
+                if (option.emit == EmitKindAstJson ||
+                    option.emit == EmitKindAstSexpr) {
+                    struct Writer writer = NEW(WriterFd, 1);
+                    struct AstDump dump = NEW(AstDump,
+                                              &writer,
+                                              option.emit == EmitKindAstJson
+                                                ? AstDumpKindJson
+                                                : AstDumpKindSexpr);
+
+                    flush__DiagnosticSink(global__DiagnosticSink());
+                    dump_decls__AstDump(&dump, parser.decls);
+
+                    FREE(AstDump, dump);
+                    FREE(Writer, writer);
+                    FREE(Parser, parser);
+
+                    break;
+                }
+
                 struct Typecheck tc = NEW(Typecheck, parser);
+                double typecheck_start = now();
 
+                tc.jobs = option.jobs;
                 run__Typecheck(&tc, NULL);
 
+                if (option.emit == EmitKindLayout) {
+                    struct Writer writer = NEW(WriterFd, 1);
+                    struct Generate gen = NEW(Generate, tc);
+
+                    write_layout__GenerateC(gen, &writer);
+
+                    FREE(Generate, gen);
+                    FREE(Writer, writer);
+
+                    break;
+                }
+
+                double ir_start = now();
+                struct IrPassStats stats = { 0 };
+                struct IrModule *ir = NEW(IrModule, &tc);
+                struct DiagnosticSink *sink = global__DiagnosticSink();
+
+                // The constants whose value panics at compile time.
+                flush__DiagnosticSink(sink);
+
+                if (sink->count_error > 0) {
+                    emit__Summary(sink->count_error,
+                                  sink->count_warning,
+                                  "the constant evaluation has been failed");
+                    exit(1);
+                }
+
+                limit_instances__IrModule(ir, option.mono_limit);
+                optimize__IrModule(ir, option.opt_level, &stats);
+
+                if (option.emit == EmitKindIr) {
+                    struct Writer writer = NEW(WriterFd, 1);
+
+                    write__IrModule(ir, &writer);
+
+                    FREE(Writer, writer);
+                    FREE(IrModule, ir);
+                    FREE(Typecheck, tc);
+
+                    break;
+                }
+
+                double generate_start = now();
                 struct Generate gen = NEW(Generate, tc);
 
-                write_main_function(&gen);
+                gen.ir = ir;
                 run__GenerateC(gen);
 
+                // The declarations which can't be lowered to C.
+                flush__DiagnosticSink(sink);
+
+                if (sink->count_error > 0) {
+                    emit__Summary(sink->count_error,
+                                  sink->count_warning,
+                                  "the generation of the C has been failed");
+                    exit(1);
+                }
+
+                if (option.time_passes) {
+                    double generate_end = now();
+
+                    fprintf(stderr, "%-14s %10s\n", "pass", "time");
+                    fprintf(stderr,
+                            "%-14s %9.3fs\n",
+                            "parse",
+                            typecheck_start - parse_start);
+                    fprintf(stderr,
+                            "%-14s %9.3fs\n",
+                            "typecheck",
+                            ir_start - typecheck_start);
+                    fprintf(stderr,
+                            "%-14s %9.3fs\n",
+                            "ir",
+                            generate_start - ir_start);
+
+                    // The time of the passes is included in the time of ir.
+                    for (Usize i = 0; i < IR_PASS_COUNT; i++)
+                        if (stats.runs[i])
+                            fprintf(stderr,
+                                    "  %-12s %9.3fs %6zu runs %+7lld insts\n",
+                                    get_name__IrPass(i),
+                                    stats.time[i],
+                                    (size_t)stats.runs[i],
+                                    (long long)stats.insts[i]);
+
+                    fprintf(stderr,
+                            "%-14s %9.3fs\n",
+                            "generate",
+                            generate_end - generate_start);
+                    print__QueryEngine(tc.graph->queries);
+                }
+
+                if (option.stats) {
+                    static const Str checks[IR_CHECK_COUNT] = { "overflow",
+                                                                "division" };
+
+                    fprintf(stderr,
+                            "%-14s %10s %10s\n",
+                            "check",
+                            "total",
+                            "eliminated");
+
+                    for (Usize i = 0; i < IR_CHECK_COUNT; i++)
+                        fprintf(stderr,
+                                "%-14s %10zu %10zu\n",
+                                checks[i],
+                                (size_t)stats.checks.checks[i],
+                                (size_t)stats.checks.eliminated[i]);
+                }
+
                 FREE(Generate, gen);
+                FREE(IrModule, ir);
 
 #ifdef LILY_WINDOWS_OS
                 double total_t = (double)(GetTickCount() - start);
@@ -25,16 +25,30 @@
 #ifndef LILY_HELP_H
 #define LILY_HELP_H
 
-#define MAIN_HELP                                     \
-    "Usage: lily [status] [options]\n"                \
-    "\tbuild            Build lily project\n"         \
-    "\tcompile          Compile a file\n"             \
-    "\thelp             Print the help\n"             \
-    "\tinit             Init a project\n"             \
-    "\tnew              Create a new project\n"       \
-    "\tversion          Print the Lily's version\n\n" \
-    "Options:\n"                                      \
-    "\t--help, -h       Print the help\n"             \
-    "\t--version, -v    Print the version"
+#define MAIN_HELP                                                            \
+    "Usage: lily [status] [options]\n"                                       \
+    "\tbuild            Build lily project\n"                                \
+    "\tcompile          Compile a file\n"                                    \
+    "\thelp             Print the help\n"                                    \
+    "\tinit             Init a project\n"                                    \
+    "\tnew              Create a new project\n"                              \
+    "\tversion          Print the Lily's version\n\n"                        \
+    "Options:\n"                                                             \
+    "\t--help, -h       Print the help\n"                                    \
+    "\t--version, -v    Print the version\n\n"                               \
+    "Compile options:\n"                                                     \
+    "\t--emit=ast-json   Print the AST in JSON\n"                            \
+    "\t--emit=ast-sexpr  Print the AST in S-expression\n"                    \
+    "\t--emit=ir         Print the IR after the optimization passes\n"       \
+    "\t--emit=layout     Print the size of the records, the enums and the\n" \
+    "\t                  optionals in the generated C\n"                     \
+    "\t--error-limit=N   Print at most N errors (0 for no limit)\n"          \
+    "\t--jobs=N, -j N    Check the function bodies on N threads\n"           \
+    "\t--mono-limit=N    Keep at most N instances of a generic function,\n"  \
+    "\t                  the others are boxed (0 for no limit)\n"            \
+    "\t-O0, -O1, -O2     Set the optimization level of the IR (-O1)\n"       \
+    "\t--stats           Print the number of runtime checks and of the\n"    \
+    "\t                  checks eliminated by the range analysis\n"          \
+    "\t--time-passes     Print the time of each pass and the query counters"
 
 #endif // LILY_HELP_H
@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <command/parse.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static enum EmitKind
+parse_emit(const Str value);
+static Usize
+parse_jobs(const Str value);
+static Usize
+parse_error_limit(const Str value);
+static Usize
+parse_opt_level(const Str value);
+static Usize
+parse_mono_limit(const Str value);
+static void
+option_error(const Str msg, const Str arg);
+
+static void
+option_error(const Str msg, const Str arg)
+{
+    fprintf(stderr, "error: %s: `%s`\n", msg, arg);
+    exit(1);
+}
+
+static enum EmitKind
+parse_emit(const Str value)
+{
+    if (!strcmp(value, "ast-json"))
+        return EmitKindAstJson;
+    else if (!strcmp(value, "ast-sexpr"))
+        return EmitKindAstSexpr;
+    else if (!strcmp(value, "ir"))
+        return EmitKindIr;
+    else if (!strcmp(value, "layout"))
+        return EmitKindLayout;
+
+    option_error("unknown value of --emit", value);
+
+    return EmitKindNone;
+}
+
+static Usize
+parse_jobs(const Str value)
+{
+    char *end = NULL;
+    unsigned long long jobs = strtoull(value, &end, 10);
+
+    if (!*value || *end || jobs == 0 || jobs > 256)
+        option_error("invalid number of jobs", value);
+
+    return jobs;
+}
+
+static Usize
+parse_error_limit(const Str value)
+{
+    char *end = NULL;
+    unsigned long long limit = strtoull(value, &end, 10);
+
+    if (!*value || *end)
+        option_error("invalid error limit", value);
+
+    return limit;
+}
+
+static Usize
+parse_opt_level(const Str value)
+{
+    if (strlen(value) != 1 || value[0] < '0' || value[0] > '2')
+        option_error("unknown optimization level", value);
+
+    return value[0] - '0';
+}
+
+static Usize
+parse_mono_limit(const Str value)
+{
+    char *end = NULL;
+    unsigned long long limit = strtoull(value, &end, 10);
+
+    if (!*value || *end)
+        option_error("invalid instance limit", value);
+
+    return limit;
+}
+
+struct CompileOption
+parse__CompileOption(int argc, char **argv)
+{
+    struct CompileOption self = { .filename = NULL,
+                                  .emit = EmitKindNone,
+                                  .jobs = 1,
+                                  .time_passes = false,
+                                  .stats = false,
+                                  .error_limit = 0,
+                                  .opt_level = 1,
+                                  .mono_limit = 0 };
+
+    for (int i = 0; i < argc; i++) {
+        if (!strncmp(argv[i], "--emit=", 7))
+            self.emit = parse_emit(argv[i] + 7);
+        else if (!strncmp(argv[i], "--jobs=", 7))
+            self.jobs = parse_jobs(argv[i] + 7);
+        else if (!strncmp(argv[i], "--error-limit=", 14))
+            self.error_limit = parse_error_limit(argv[i] + 14);
+        else if (!strncmp(argv[i], "--mono-limit=", 13))
+            self.mono_limit = parse_mono_limit(argv[i] + 13);
+        else if (!strcmp(argv[i], "--time-passes"))
+            self.time_passes = true;
+        else if (!strcmp(argv[i], "--stats"))
+            self.stats = true;
+        else if (!strcmp(argv[i], "-j")) {
+            if (i + 1 == argc)
+                option_error("expected a number of jobs after", argv[i]);
+
+            self.jobs = parse_jobs(argv[++i]);
+        } else if (!strncmp(argv[i], "-j", 2))
+            self.jobs = parse_jobs(argv[i] + 2);
+        else if (!strncmp(argv[i], "-O", 2))
+            self.opt_level = parse_opt_level(argv[i] + 2);
+        else if (argv[i][0] == '-')
+            option_error("unknown option", argv[i]);
+        else if (!self.filename)
+            self.filename = argv[i];
+        else
+            option_error("expected only one file", argv[i]);
+    }
+
+    if (!self.filename) {
+        fprintf(stderr, "error: expected a file\n");
+        exit(1);
+    }
+
+    return self;
+}
@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_COMMAND_PARSE_H
+#define LILY_COMMAND_PARSE_H
+
+#include <base/types.h>
+#include <stdbool.h>
+
+enum EmitKind
+{
+    EmitKindNone,
+    EmitKindAstJson,
+    EmitKindAstSexpr,
+    EmitKindIr,
+    EmitKindLayout
+};
+
+typedef struct CompileOption
+{
+    Str filename;
+    enum EmitKind emit;
+    Usize jobs; // number of threads of the typecheck (1 by default)
+    bool time_passes; // print the time of each pass and the query counters
+    bool stats; // print the number of runtime checks (see range.h)
+    Usize error_limit; // maximum number of printed errors (0 for no limit)
+    Usize opt_level;   // optimization level of the IR: 0, 1 (default) or 2
+    Usize mono_limit;  // maximum number of instances of a generic function (0
+                       // for no limit)
+} CompileOption;
+
+/**
+ *
+ * @brief Parse the options of the compile command.
+ * @param argv The arguments which follow `compile`.
+ * @note Exit the program when an option is unknown or invalid.
+ */
+struct CompileOption
+parse__CompileOption(int argc, char **argv);
+
+#endif // LILY_COMMAND_PARSE_H
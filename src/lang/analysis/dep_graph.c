@@ -0,0 +1,326 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <lang/analysis/dep_graph.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// The end of a list of users.
+#define DEP_NONE ((Usize)-1)
+
+static Usize
+hash_symbol(const void *symbol);
+static Usize
+hash_edge(Usize user, Usize used, enum DepKind kind);
+static Usize *
+get_node(struct DepGraph *self, const void *symbol);
+static void
+insert_node(struct DepGraph *self, void *symbol, Usize node);
+static Usize
+get_or_add_node(struct DepGraph *self, void *symbol);
+static bool
+has_edge(struct DepGraph *self, Usize user, Usize used, enum DepKind kind);
+static void
+insert_edge_key(struct DepGraph *self, Usize edge);
+static void
+mark(struct DepGraph *self, Usize node, enum DepState state);
+static void
+propagate(struct DepGraph *self);
+
+static Usize
+hash_symbol(const void *symbol)
+{
+    return ((Usize)(UPtr)symbol >> 4) * 0x9e3779b97f4a7c15;
+}
+
+static Usize
+hash_edge(Usize user, Usize used, enum DepKind kind)
+{
+    return ((user * 0x9e3779b97f4a7c15) ^ (used * 0xc2b2ae3d27d4eb4f)) + kind;
+}
+
+static Usize *
+get_node(struct DepGraph *self, const void *symbol)
+{
+    Usize mask = self->symbol_capacity - 1;
+
+    for (Usize i = hash_symbol(symbol) & mask; self->symbol_keys[i];
+         i = (i + 1) & mask)
+        if (self->symbol_keys[i] == symbol)
+            return &self->symbol_nodes[i];
+
+    return NULL;
+}
+
+static void
+insert_node(struct DepGraph *self, void *symbol, Usize node)
+{
+    if ((self->symbol_len + 1) * 2 > self->symbol_capacity) {
+        void **keys = self->symbol_keys;
+        Usize *nodes = self->symbol_nodes;
+        Usize capacity = self->symbol_capacity;
+
+        self->symbol_capacity *= 2;
+        self->symbol_keys = calloc(self->symbol_capacity, sizeof(void *));
+        self->symbol_nodes = malloc(self->symbol_capacity * sizeof(Usize));
+        self->symbol_len = 0;
+
+        for (Usize i = 0; i < capacity; i++)
+            if (keys[i])
+                insert_node(self, keys[i], nodes[i]);
+
+        free(keys);
+        free(nodes);
+    }
+
+    Usize mask = self->symbol_capacity - 1;
+    Usize i = hash_symbol(symbol) & mask;
+
+    while (self->symbol_keys[i])
+        i = (i + 1) & mask;
+
+    self->symbol_keys[i] = symbol;
+    self->symbol_nodes[i] = node;
+    self->symbol_len++;
+}
+
+static Usize
+get_or_add_node(struct DepGraph *self, void *symbol)
+{
+    Usize *node = get_node(self, symbol);
+
+    if (node)
+        return *node;
+
+    if (self->len == self->capacity) {
+        self->capacity *= 2;
+        self->nodes = realloc(self->nodes, self->capacity * sizeof(DepNode));
+    }
+
+    self->nodes[self->len] = (struct DepNode){
+        .symbol = symbol,
+        .users = { DEP_NONE, DEP_NONE },
+        .state = DepStateValid,
+    };
+    insert_node(self, symbol, self->len);
+
+    return self->len++;
+}
+
+static bool
+has_edge(struct DepGraph *self, Usize user, Usize used, enum DepKind kind)
+{
+    Usize mask = self->edge_keys_capacity - 1;
+
+    for (Usize i = hash_edge(user, used, kind) & mask; self->edge_keys[i];
+         i = (i + 1) & mask) {
+        struct DepEdge *edge = &self->edges[self->edge_keys[i] - 1];
+
+        if (edge->user == user && edge->used == used && edge->kind == kind)
+            return true;
+    }
+
+    return false;
+}
+
+static void
+insert_edge_key(struct DepGraph *self, Usize edge)
+{
+    Usize mask = self->edge_keys_capacity - 1;
+    Usize i = hash_edge(self->edges[edge].user,
+                        self->edges[edge].used,
+                        self->edges[edge].kind) &
+              mask;
+
+    while (self->edge_keys[i])
+        i = (i + 1) & mask;
+
+    self->edge_keys[i] = edge + 1;
+}
+
+static void
+mark(struct DepGraph *self, Usize node, enum DepState state)
+{
+    if (self->nodes[node].state >= state)
+        return;
+
+    if (self->nodes[node].state == DepStateValid)
+        self->invalid_len++;
+
+    self->nodes[node].state = state;
+
+    if (state == DepStateSignature) {
+        if (self->stack_len == self->stack_capacity) {
+            self->stack_capacity *= 2;
+            self->stack =
+              realloc(self->stack, self->stack_capacity * sizeof(Usize));
+        }
+
+        self->stack[self->stack_len++] = node;
+    }
+}
+
+// Walk the users of the signatures on the stack.
+static void
+propagate(struct DepGraph *self)
+{
+    while (self->stack_len > 0) {
+        Usize node = self->stack[--self->stack_len];
+
+        for (Usize edge = self->nodes[node].users[DepKindSignature];
+             edge != DEP_NONE;
+             edge = self->edges[edge].next)
+            mark(self, self->edges[edge].user, DepStateSignature);
+
+        for (Usize edge = self->nodes[node].users[DepKindBody];
+             edge != DEP_NONE;
+             edge = self->edges[edge].next)
+            mark(self, self->edges[edge].user, DepStateBody);
+    }
+}
+
+struct DepGraph *
+__new__DepGraph()
+{
+    struct DepGraph *self = malloc(sizeof(struct DepGraph));
+
+    self->capacity = 16;
+    self->nodes = malloc(self->capacity * sizeof(DepNode));
+    self->len = 0;
+    self->edges_capacity = 16;
+    self->edges = malloc(self->edges_capacity * sizeof(DepEdge));
+    self->edges_len = 0;
+    self->symbol_capacity = 32;
+    self->symbol_keys = calloc(self->symbol_capacity, sizeof(void *));
+    self->symbol_nodes = malloc(self->symbol_capacity * sizeof(Usize));
+    self->symbol_len = 0;
+    self->edge_keys_capacity = 32;
+    self->edge_keys = calloc(self->edge_keys_capacity, sizeof(Usize));
+    self->stack_capacity = 16;
+    self->stack = malloc(self->stack_capacity * sizeof(Usize));
+    self->stack_len = 0;
+    self->invalid_len = 0;
+    mtx_init(&self->lock, mtx_plain);
+
+    return self;
+}
+
+void
+add__DepGraph(struct DepGraph *self,
+              void *user,
+              enum DepKind kind,
+              void *used)
+{
+    if (user == used)
+        return;
+
+    mtx_lock(&self->lock);
+
+    Usize user_node = get_or_add_node(self, user);
+    Usize used_node = get_or_add_node(self, used);
+
+    if (has_edge(self, user_node, used_node, kind)) {
+        mtx_unlock(&self->lock);
+        return;
+    }
+
+    if (self->edges_len == self->edges_capacity) {
+        self->edges_capacity *= 2;
+        self->edges =
+          realloc(self->edges, self->edges_capacity * sizeof(DepEdge));
+    }
+
+    if ((self->edges_len + 1) * 2 > self->edge_keys_capacity) {
+        free(self->edge_keys);
+
+        self->edge_keys_capacity *= 2;
+        self->edge_keys = calloc(self->edge_keys_capacity, sizeof(Usize));
+
+        for (Usize i = 0; i < self->edges_len; i++)
+            insert_edge_key(self, i);
+    }
+
+    self->edges[self->edges_len] =
+      (struct DepEdge){ .user = user_node,
+                        .used = used_node,
+                        .kind = kind,
+                        .next = self->nodes[used_node].users[kind] };
+    self->nodes[used_node].users[kind] = self->edges_len;
+    insert_edge_key(self, self->edges_len++);
+
+    mtx_unlock(&self->lock);
+}
+
+void
+invalidate__DepGraph(struct DepGraph *self,
+                     void *symbol,
+                     enum DepState state)
+{
+    mark(self, get_or_add_node(self, symbol), state);
+    propagate(self);
+}
+
+void
+invalidate_users__DepGraph(struct DepGraph *self, void *symbol)
+{
+    Usize *node = get_node(self, symbol);
+
+    if (!node)
+        return;
+
+    self->stack[self->stack_len++] = *node;
+    propagate(self);
+}
+
+enum DepState
+get_state__DepGraph(struct DepGraph *self, void *symbol)
+{
+    Usize *node = get_node(self, symbol);
+
+    return node ? self->nodes[*node].state : DepStateValid;
+}
+
+void
+validate__DepGraph(struct DepGraph *self, void *symbol)
+{
+    Usize *node = get_node(self, symbol);
+
+    if (node && self->nodes[*node].state != DepStateValid) {
+        self->nodes[*node].state = DepStateValid;
+        self->invalid_len--;
+    }
+}
+
+void
+__free__DepGraph(struct DepGraph *self)
+{
+    mtx_destroy(&self->lock);
+    free(self->nodes);
+    free(self->edges);
+    free(self->symbol_keys);
+    free(self->symbol_nodes);
+    free(self->edge_keys);
+    free(self->stack);
+    free(self);
+}
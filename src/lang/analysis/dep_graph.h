@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_DEP_GRAPH_H
+#define LILY_DEP_GRAPH_H
+
+#include <base/types.h>
+#include <threads.h>
+
+// How a declaration uses another declaration.
+enum DepKind
+{
+    DepKindSignature, // the signature of the user depends on the declaration
+    DepKindBody       // only the body of the user depends on the declaration
+};
+
+#define DEP_KIND_COUNT (DepKindBody + 1)
+
+// What must be checked again in a declaration.
+enum DepState
+{
+    DepStateValid = 0,
+    DepStateBody,     // the body
+    DepStateSignature // the signature and the body, the users are invalidated
+};
+
+typedef struct DepEdge
+{
+    Usize user;
+    Usize used;
+    enum DepKind kind;
+    Usize next; // next user of the same declaration with the same kind
+} DepEdge;
+
+typedef struct DepNode
+{
+    void *symbol;                // void& (the symbol of the declaration)
+    Usize users[DEP_KIND_COUNT]; // first edge of the users of each kind
+    enum DepState state;
+} DepNode;
+
+// The dependencies between the declarations of a file, recorded while they are
+// checked: a change of a declaration only invalidates the declarations which
+// reach it through the edges.
+typedef struct DepGraph
+{
+    struct DepNode *nodes;
+    Usize len;
+    Usize capacity;
+    struct DepEdge *edges;
+    Usize edges_len;
+    Usize edges_capacity;
+    void **symbol_keys; // void& (open addressing, symbol -> node)
+    Usize *symbol_nodes;
+    Usize symbol_len;
+    Usize symbol_capacity;
+    Usize *edge_keys; // open addressing of the edges (the edge + 1, 0 is
+                      // empty), an edge is recorded once
+    Usize edge_keys_capacity;
+    Usize *stack; // nodes to walk (invalidation)
+    Usize stack_len;
+    Usize stack_capacity;
+    Usize invalid_len; // number of nodes which are not DepStateValid
+    mtx_t lock;        // with -j N, the bodies are checked by several threads
+} DepGraph;
+
+/**
+ *
+ * @brief Construct the DepGraph type.
+ */
+struct DepGraph *
+__new__DepGraph();
+
+/**
+ *
+ * @brief Record that user uses the declaration of used.
+ * @note A declaration using itself is not recorded.
+ */
+void
+add__DepGraph(struct DepGraph *self,
+              void *user,
+              enum DepKind kind,
+              void *used);
+
+/**
+ *
+ * @brief Mark the declaration as state (a state is never downgraded). When
+ * the signature is invalidated, the users of the signature are invalidated
+ * with DepStateSignature and the users in a body with DepStateBody.
+ */
+void
+invalidate__DepGraph(struct DepGraph *self,
+                     void *symbol,
+                     enum DepState state);
+
+/**
+ *
+ * @brief Invalidate the users of the declaration as if its signature had
+ * changed, without invalidating the declaration itself.
+ */
+void
+invalidate_users__DepGraph(struct DepGraph *self, void *symbol);
+
+/**
+ *
+ * @return the state of the declaration (DepStateValid if it's unknown).
+ */
+enum DepState
+get_state__DepGraph(struct DepGraph *self, void *symbol);
+
+/**
+ *
+ * @brief Mark the declaration as checked again.
+ */
+void
+validate__DepGraph(struct DepGraph *self, void *symbol);
+
+/**
+ *
+ * @brief Free the DepGraph type.
+ */
+void
+__free__DepGraph(struct DepGraph *self);
+
+#endif // LILY_DEP_GRAPH_H
@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <base/str_map.h>
+#include <lang/analysis/duplicate.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+static inline bool
+can_coexist(enum DuplicateKind kind, enum DuplicateKind kind2);
+
+static inline bool
+can_coexist(enum DuplicateKind kind, enum DuplicateKind kind2)
+{
+    return (kind == DuplicateKindTag && kind2 == DuplicateKindType) ||
+           (kind == DuplicateKindType && kind2 == DuplicateKindTag);
+}
+
+struct DuplicateNames *
+__new__DuplicateNames()
+{
+    struct DuplicateNames *self = malloc(sizeof(struct DuplicateNames));
+
+    self->names = NULL;
+    self->kinds = NULL;
+    self->len = 0;
+    self->capacity = 0;
+
+    return self;
+}
+
+void
+push__DuplicateNames(struct DuplicateNames *self,
+                     struct String *name,
+                     enum DuplicateKind kind)
+{
+    if (self->len == self->capacity) {
+        self->capacity = self->capacity ? self->capacity * 2 : 16;
+        self->names =
+          realloc(self->names, self->capacity * sizeof(struct String *));
+        self->kinds =
+          realloc(self->kinds, self->capacity * sizeof(enum DuplicateKind));
+    }
+
+    self->names[self->len] = name;
+    self->kinds[self->len++] = kind;
+}
+
+Usize *
+get_conflicts__DuplicateNames(const struct DuplicateNames *self)
+{
+    Usize *conflicts = malloc((self->len ? self->len : 1) * sizeof(Usize));
+    // The nearest later item of each kind, stored at the last item of each
+    // name.
+    Usize(*nearest)[DUPLICATE_KIND_COUNT] =
+      malloc((self->len ? self->len : 1) * sizeof(*nearest));
+    Str *keys = malloc((self->len ? self->len : 1) * sizeof(Str));
+    struct StrMap *names = NEW(StrMap);
+
+    // The items are visited from the last to the first, so the nearest later
+    // items of a name are known when an item is visited.
+    for (Usize i = self->len; i--;) {
+        conflicts[i] = DUPLICATE_NONE;
+        keys[i] = NULL;
+
+        if (!self->names[i])
+            continue;
+
+        Str key = to_Str__String(*self->names[i]);
+        Usize *entry = get__StrMap(*names, key);
+
+        if (entry)
+            free(key);
+        else {
+            entry = nearest[i];
+            keys[i] = key;
+
+            for (Usize k = 0; k < DUPLICATE_KIND_COUNT; k++)
+                entry[k] = DUPLICATE_NONE;
+
+            insert__StrMap(names, key, entry);
+        }
+
+        for (Usize k = 0; k < DUPLICATE_KIND_COUNT; k++)
+            if (!can_coexist(self->kinds[i], k) && entry[k] < conflicts[i])
+                conflicts[i] = entry[k];
+
+        entry[self->kinds[i]] = i;
+    }
+
+    FREE(StrMap, names);
+
+    for (Usize i = 0; i < self->len; i++)
+        free(keys[i]);
+
+    free(keys);
+    free(nearest);
+
+    return conflicts;
+}
+
+void
+__free__DuplicateNames(struct DuplicateNames *self)
+{
+    free(self->names);
+    free(self->kinds);
+    free(self);
+}
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_DUPLICATE_H
+#define LILY_DUPLICATE_H
+
+#include <base/string.h>
+#include <base/types.h>
+
+// The index of the conflict of a name without conflict.
+#define DUPLICATE_NONE ((Usize)-1)
+
+enum DuplicateKind
+{
+    DuplicateKindTag,
+    DuplicateKindType, // record or enum
+    DuplicateKindOther
+};
+
+#define DUPLICATE_KIND_COUNT (DuplicateKindOther + 1)
+
+// The names of a scope, in the order of their declarations.
+typedef struct DuplicateNames
+{
+    struct String **names; // struct String& (NULL for an ignored item)
+    enum DuplicateKind *kinds;
+    Usize len;
+    Usize capacity;
+} DuplicateNames;
+
+/**
+ *
+ * @brief Construct the DuplicateNames type.
+ */
+struct DuplicateNames *
+__new__DuplicateNames();
+
+/**
+ *
+ * @brief Push the name of the next item of the scope.
+ * @param name NULL if the item has no name (e.g. an import).
+ */
+void
+push__DuplicateNames(struct DuplicateNames *self,
+                     struct String *name,
+                     enum DuplicateKind kind);
+
+/**
+ *
+ * @return for each item, the index of the first later item in conflict with
+ * it or DUPLICATE_NONE (a tag can share its name with a record or an enum).
+ * The names are hashed once, so the cost is linear in the number of items.
+ */
+Usize *
+get_conflicts__DuplicateNames(const struct DuplicateNames *self);
+
+/**
+ *
+ * @brief Free the DuplicateNames type.
+ */
+void
+__free__DuplicateNames(struct DuplicateNames *self);
+
+#endif // LILY_DUPLICATE_H
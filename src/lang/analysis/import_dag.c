@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <lang/analysis/import_dag.h>
+#include <stdlib.h>
+
+// States of a module during build_waves__ImportDag (stored in its wave).
+#define WAVE_UNVISITED ((Usize)-1)
+#define WAVE_VISITING ((Usize)-2)
+
+struct ImportDag *
+__new__ImportDag()
+{
+    struct ImportDag *self = malloc(sizeof(struct ImportDag));
+
+    self->nodes_map = NEW(StrMap);
+    self->nodes = NEW(Vec, sizeof(struct ImportDagNode));
+    self->waves = NEW(Vec, sizeof(struct Vec));
+
+    return self;
+}
+
+struct ImportDagNode *
+get__ImportDag(struct ImportDag self, const Str path)
+{
+    return get__StrMap(*self.nodes_map, path);
+}
+
+struct ImportDagNode *
+add__ImportDag(struct ImportDag *self, Str path, Str file_name)
+{
+    struct ImportDagNode *node = malloc(sizeof(struct ImportDagNode));
+
+    node->path = path;
+    node->file_name = file_name;
+    node->deps = NEW(Vec, sizeof(struct ImportDagNode));
+    node->id = len__Vec(*self->nodes);
+    node->wave = WAVE_UNVISITED;
+
+    insert__StrMap(self->nodes_map, node->path, node);
+    push__Vec(self->nodes, node);
+
+    return node;
+}
+
+void
+add_dep__ImportDag(struct ImportDagNode *node, struct ImportDagNode *dep)
+{
+    if (!includes__Vec(*node->deps, dep))
+        push__Vec(node->deps, dep);
+}
+
+bool
+build_waves__ImportDag(struct ImportDag *self)
+{
+    // Iterative depth-first search: the wave of a module is known once all
+    // its imports are visited. A module found again while it's being visited
+    // closes a cycle.
+    struct Vec *stack = NEW(Vec, sizeof(struct ImportDagNode));
+    struct Vec *next_dep = NEW(Vec, sizeof(Usize));
+    bool res = true;
+
+    for (Usize i = 0; i < len__Vec(*self->nodes); i++)
+        ((struct ImportDagNode *)get__Vec(*self->nodes, i))->wave =
+          WAVE_UNVISITED;
+
+    for (Usize i = 0; res && i < len__Vec(*self->nodes); i++) {
+        struct ImportDagNode *root = get__Vec(*self->nodes, i);
+
+        if (root->wave != WAVE_UNVISITED)
+            continue;
+
+        root->wave = WAVE_VISITING;
+        push__Vec(stack, root);
+        push__Vec(next_dep, (void *)(UPtr)0);
+
+        while (res && len__Vec(*stack) > 0) {
+            Usize top = len__Vec(*stack) - 1;
+            struct ImportDagNode *node = get__Vec(*stack, top);
+            Usize pos = (Usize)(UPtr)get__Vec(*next_dep, top);
+
+            if (pos < len__Vec(*node->deps)) {
+                struct ImportDagNode *dep = get__Vec(*node->deps, pos);
+
+                modify_item__Vec(next_dep, (void *)(UPtr)(pos + 1), top);
+
+                if (dep->wave == WAVE_VISITING)
+                    res = false;
+                else if (dep->wave == WAVE_UNVISITED) {
+                    dep->wave = WAVE_VISITING;
+                    push__Vec(stack, dep);
+                    push__Vec(next_dep, (void *)(UPtr)0);
+                }
+
+                continue;
+            }
+
+            Usize wave = 0;
+
+            for (Usize j = 0; j < len__Vec(*node->deps); j++) {
+                Usize dep_wave =
+                  ((struct ImportDagNode *)get__Vec(*node->deps, j))->wave;
+
+                if (dep_wave + 1 > wave)
+                    wave = dep_wave + 1;
+            }
+
+            node->wave = wave;
+            pop__Vec(stack);
+            pop__Vec(next_dep);
+        }
+    }
+
+    FREE(Vec, stack);
+    FREE(Vec, next_dep);
+
+    if (!res)
+        return false;
+
+    for (Usize i = 0; i < len__Vec(*self->nodes); i++) {
+        struct ImportDagNode *node = get__Vec(*self->nodes, i);
+
+        while (len__Vec(*self->waves) <= node->wave)
+            push__Vec(self->waves, NEW(Vec, sizeof(struct ImportDagNode)));
+
+        push__Vec(get__Vec(*self->waves, node->wave), node);
+    }
+
+    return true;
+}
+
+void
+__free__ImportDag(struct ImportDag *self)
+{
+    for (Usize i = len__Vec(*self->waves); i--;)
+        FREE(Vec, get__Vec(*self->waves, i));
+
+    for (Usize i = len__Vec(*self->nodes); i--;) {
+        struct ImportDagNode *node = get__Vec(*self->nodes, i);
+
+        FREE(Vec, node->deps);
+        free(node->path);
+        free(node->file_name);
+        free(node);
+    }
+
+    FREE(Vec, self->waves);
+    FREE(Vec, self->nodes);
+    FREE(StrMap, self->nodes_map);
+    free(self);
+}
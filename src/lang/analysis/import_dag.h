@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IMPORT_DAG_H
+#define LILY_IMPORT_DAG_H
+
+#include <base/str_map.h>
+#include <base/types.h>
+#include <base/vec.h>
+#include <stdbool.h>
+
+typedef struct ImportDagNode
+{
+    Str path;         // Str* (canonical path)
+    Str file_name;    // Str* (path written by the first importer, used as
+                      // the file name of the Source of the module)
+    struct Vec *deps; // struct Vec<struct ImportDagNode&>*
+    Usize id;         // index of the module in the nodes of the ImportDag
+    Usize wave;       // all the imports of the module are in a lower wave
+} ImportDagNode;
+
+// Import graph of a compilation session, discovered before any module is
+// typechecked. The modules of a wave only import modules of the previous
+// waves, so the modules of a wave can be loaded in parallel.
+typedef struct ImportDag
+{
+    struct StrMap *nodes_map; // canonical path -> struct ImportDagNode&
+    struct Vec *nodes;        // struct Vec<struct ImportDagNode*>*
+    struct Vec *waves;        // struct Vec<struct Vec<struct ImportDagNode&>*>*
+} ImportDag;
+
+/**
+ *
+ * @brief Construct the ImportDag type.
+ */
+struct ImportDag *
+__new__ImportDag();
+
+/**
+ *
+ * @return the module of the canonical path or NULL.
+ */
+struct ImportDagNode *
+get__ImportDag(struct ImportDag self, const Str path);
+
+/**
+ *
+ * @brief Add a module.
+ * @param path The canonical path (the ImportDag takes the ownership).
+ * @param file_name The ImportDag takes the ownership.
+ */
+struct ImportDagNode *
+add__ImportDag(struct ImportDag *self, Str path, Str file_name);
+
+/**
+ *
+ * @brief Add the import of dep by node (a duplicate import is ignored).
+ */
+void
+add_dep__ImportDag(struct ImportDagNode *node, struct ImportDagNode *dep);
+
+/**
+ *
+ * @brief Split the modules in waves: a module without import is in the wave
+ * 0, and the other modules are in the wave following the last wave of their
+ * imports. In a wave, the modules are in the order of their discovery.
+ * @return false if there is an import cycle (the waves are not built).
+ */
+bool
+build_waves__ImportDag(struct ImportDag *self);
+
+/**
+ *
+ * @brief Free the ImportDag type.
+ */
+void
+__free__ImportDag(struct ImportDag *self);
+
+#endif // LILY_IMPORT_DAG_H
@@ -0,0 +1,703 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/tuple.h>
+#include <lang/analysis/infer.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INFER_MEMO_CAPACITY 64
+
+static void
+push_index(Usize **buffer, Usize *len, Usize *capacity, Usize index);
+static Usize
+push_node(struct Infer *self, struct InferNode node);
+static Usize
+get_children_len(const struct DataTypeSymbol *data_type);
+static struct DataTypeSymbol *
+get_child(const struct DataTypeSymbol *data_type, Usize i);
+static Usize
+hash_data_type(const struct DataTypeSymbol *data_type);
+static Usize *
+get_memo(struct Infer *self, const struct DataTypeSymbol *data_type);
+static void
+insert_memo(struct Infer *self, struct DataTypeSymbol *data_type, Usize node);
+static bool
+same_scope(const struct Scope *a, const struct Scope *b);
+static bool
+same_head(const struct InferNode *a, const struct InferNode *b);
+static void
+join(struct Infer *self, Usize a, Usize b);
+static bool
+occurs(struct Infer *self, Usize var, Usize node);
+static Usize
+instantiate(struct Infer *self, Usize node, struct Vec *copies);
+static struct DataTypeSymbol *
+rebuild(struct Infer *self,
+        const struct DataTypeSymbol *head,
+        struct DataTypeSymbol **children);
+
+static void
+push_index(Usize **buffer, Usize *len, Usize *capacity, Usize index)
+{
+    if (*len == *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 16;
+        *buffer = realloc(*buffer, *capacity * sizeof(Usize));
+    }
+
+    (*buffer)[(*len)++] = index;
+}
+
+static Usize
+push_node(struct Infer *self, struct InferNode node)
+{
+    if (self->len == self->capacity) {
+        self->capacity = self->capacity ? self->capacity * 2 : 16;
+        self->nodes =
+          realloc(self->nodes, self->capacity * sizeof(struct InferNode));
+    }
+
+    node.parent = self->len;
+    self->nodes[self->len] = node;
+
+    return self->len++;
+}
+
+static Usize
+get_children_len(const struct DataTypeSymbol *data_type)
+{
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+        case DataTypeKindRef:
+        case DataTypeKindOptional:
+        case DataTypeKindException:
+        case DataTypeKindMut:
+        case DataTypeKindArray:
+            return 1;
+        case DataTypeKindLambda:
+            return len__Vec(*(struct Vec *)data_type->value.lambda->items[0]) +
+                   1;
+        case DataTypeKindTuple:
+            return data_type->value.tuple ? len__Vec(*data_type->value.tuple)
+                                          : 0;
+        case DataTypeKindCustom:
+            return data_type->value.custom
+                     ? len__Vec(*data_type->value.custom)
+                     : 0;
+        default:
+            return 0;
+    }
+}
+
+static struct DataTypeSymbol *
+get_child(const struct DataTypeSymbol *data_type, Usize i)
+{
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            return data_type->value.ptr;
+        case DataTypeKindRef:
+            return data_type->value.ref;
+        case DataTypeKindOptional:
+            return data_type->value.optional;
+        case DataTypeKindException:
+            return data_type->value.exception;
+        case DataTypeKindMut:
+            return data_type->value.mut;
+        case DataTypeKindArray:
+            return data_type->value.array->items[0];
+        case DataTypeKindLambda: {
+            struct Vec *params = data_type->value.lambda->items[0];
+
+            return i < len__Vec(*params) ? get__Vec(*params, i)
+                                         : data_type->value.lambda->items[1];
+        }
+        case DataTypeKindTuple:
+            return get__Vec(*data_type->value.tuple, i);
+        case DataTypeKindCustom:
+            return get__Vec(*data_type->value.custom, i);
+        default:
+            UNREACHABLE("this data type has no sub data type");
+    }
+}
+
+static Usize
+hash_data_type(const struct DataTypeSymbol *data_type)
+{
+    return ((Usize)(UPtr)data_type >> 4) * 0x9e3779b97f4a7c15;
+}
+
+// The data types are interned, so they are memoized by address.
+static Usize *
+get_memo(struct Infer *self, const struct DataTypeSymbol *data_type)
+{
+    Usize mask = self->memo_capacity - 1;
+
+    for (Usize i = hash_data_type(data_type) & mask; self->memo_keys[i];
+         i = (i + 1) & mask)
+        if (self->memo_keys[i] == data_type)
+            return &self->memo_nodes[i];
+
+    return NULL;
+}
+
+static void
+insert_memo(struct Infer *self, struct DataTypeSymbol *data_type, Usize node)
+{
+    if ((self->memo_len + 1) * 2 > self->memo_capacity) {
+        struct DataTypeSymbol **keys = self->memo_keys;
+        Usize *nodes = self->memo_nodes;
+        Usize capacity = self->memo_capacity;
+
+        self->memo_capacity *= 2;
+        self->memo_keys =
+          calloc(self->memo_capacity, sizeof(struct DataTypeSymbol *));
+        self->memo_nodes = malloc(self->memo_capacity * sizeof(Usize));
+        self->memo_len = 0;
+
+        for (Usize i = 0; i < capacity; i++)
+            if (keys[i])
+                insert_memo(self, keys[i], nodes[i]);
+
+        free(keys);
+        free(nodes);
+    }
+
+    Usize mask = self->memo_capacity - 1;
+    Usize i = hash_data_type(data_type) & mask;
+
+    while (self->memo_keys[i])
+        i = (i + 1) & mask;
+
+    self->memo_keys[i] = data_type;
+    self->memo_nodes[i] = node;
+    self->memo_len++;
+}
+
+// A generic param is copied in each data type where it appears (see
+// type_interner.c), so two scopes are the same if they are at the same
+// position.
+static bool
+same_scope(const struct Scope *a, const struct Scope *b)
+{
+    if (a == b)
+        return true;
+    else if (!a || !b)
+        return false;
+
+    return a->item_kind == b->item_kind && a->id == b->id &&
+           a->filename == b->filename &&
+           eq__String(a->name, b->name, false);
+}
+
+// Two data types of the same class must have the same head: the same kind
+// and the same values, except the sub data types.
+static bool
+same_head(const struct InferNode *a, const struct InferNode *b)
+{
+    if (a->head->kind != b->head->kind || a->children_len != b->children_len)
+        return false;
+
+    switch (a->head->kind) {
+        case DataTypeKindArray: {
+            Usize *size = a->head->value.array->items[1];
+            Usize *size2 = b->head->value.array->items[1];
+
+            return size == size2 || (size && size2 && *size == *size2);
+        }
+        case DataTypeKindCustom:
+            return same_scope(a->head->scope, b->head->scope);
+        default:
+            return true;
+    }
+}
+
+// a and b are two roots, the root of the new class keeps the data type of the
+// class.
+static void
+join(struct Infer *self, Usize a, Usize b)
+{
+    if (self->nodes[a].rank < self->nodes[b].rank) {
+        Usize tmp = a;
+
+        a = b;
+        b = tmp;
+    }
+
+    struct InferNode *root = &self->nodes[a];
+    struct InferNode *child = &self->nodes[b];
+
+    child->parent = a;
+
+    if (root->rank == child->rank)
+        root->rank++;
+
+    if (root->kind == InferNodeKindVar) {
+        if (child->kind == InferNodeKindVar) {
+            if (child->level < root->level)
+                root->level = child->level;
+        } else {
+            root->kind = InferNodeKindType;
+            root->head = child->head;
+            root->children = child->children;
+            root->children_len = child->children_len;
+            root->ground = child->ground;
+        }
+    }
+}
+
+// Check if var occurs in node, and lower the level of the type variables of
+// node to the level of var: they are now reachable from the level of var.
+static bool
+occurs(struct Infer *self, Usize var, Usize node)
+{
+    Usize level = self->nodes[var].level;
+
+    self->epoch++;
+    self->stack_len = 0;
+    push_index(&self->stack, &self->stack_len, &self->stack_capacity, node);
+
+    while (self->stack_len > 0) {
+        Usize root = find__Infer(self, self->stack[--self->stack_len]);
+        struct InferNode *current = &self->nodes[root];
+
+        if (root == var)
+            return true;
+        else if (current->visited == self->epoch || current->ground)
+            continue;
+
+        current->visited = self->epoch;
+
+        if (current->kind == InferNodeKindVar) {
+            if (current->level > level)
+                current->level = level;
+
+            continue;
+        }
+
+        for (Usize i = 0; i < current->children_len; i++)
+            push_index(&self->stack,
+                       &self->stack_len,
+                       &self->stack_capacity,
+                       self->children[current->children + i]);
+    }
+
+    return false;
+}
+
+struct Infer *
+__new__Infer(struct TypeInterner *types)
+{
+    struct Infer *self = malloc(sizeof(struct Infer));
+
+    self->types = types;
+    self->nodes = NULL;
+    self->len = 0;
+    self->capacity = 0;
+    self->children = NULL;
+    self->children_len = 0;
+    self->children_capacity = 0;
+    self->memo_keys =
+      calloc(INFER_MEMO_CAPACITY, sizeof(struct DataTypeSymbol *));
+    self->memo_nodes = malloc(INFER_MEMO_CAPACITY * sizeof(Usize));
+    self->memo_len = 0;
+    self->memo_capacity = INFER_MEMO_CAPACITY;
+    self->stack = NULL;
+    self->stack_len = 0;
+    self->stack_capacity = 0;
+    self->pairs = NULL;
+    self->pairs_len = 0;
+    self->pairs_capacity = 0;
+    self->epoch = 0;
+    self->level = 0;
+
+    return self;
+}
+
+Usize
+fresh__Infer(struct Infer *self)
+{
+    return push_node(self,
+                     (struct InferNode){ .kind = InferNodeKindVar,
+                                         .rank = 0,
+                                         .level = self->level,
+                                         .head = NULL,
+                                         .children = 0,
+                                         .children_len = 0,
+                                         .ground = false,
+                                         .visited = 0 });
+}
+
+Usize
+from_data_type__Infer(struct Infer *self, struct DataTypeSymbol *data_type)
+{
+    if (data_type->kind == DataTypeKindCompilerDefined)
+        return fresh__Infer(self);
+
+    Usize *memo = get_memo(self, data_type);
+
+    if (memo)
+        return *memo;
+
+    Usize len = get_children_len(data_type);
+    Usize *children = len > 0 ? malloc(len * sizeof(Usize)) : NULL;
+    bool ground = true;
+
+    for (Usize i = 0; i < len; i++) {
+        children[i] = from_data_type__Infer(self, get_child(data_type, i));
+        ground = ground && self->nodes[children[i]].ground;
+    }
+
+    Usize first = self->children_len;
+
+    for (Usize i = 0; i < len; i++)
+        push_index(&self->children,
+                   &self->children_len,
+                   &self->children_capacity,
+                   children[i]);
+
+    free(children);
+
+    Usize node = push_node(self,
+                           (struct InferNode){ .kind = InferNodeKindType,
+                                               .rank = 0,
+                                               .level = self->level,
+                                               .head = data_type,
+                                               .children = first,
+                                               .children_len = len,
+                                               .ground = ground,
+                                               .visited = 0 });
+
+    // A data type without type variable is never modified by the
+    // unification, so it is shared by all its occurrences.
+    if (ground)
+        insert_memo(self, data_type, node);
+
+    return node;
+}
+
+Usize
+find__Infer(struct Infer *self, Usize node)
+{
+    Usize root = node;
+
+    while (self->nodes[root].parent != root)
+        root = self->nodes[root].parent;
+
+    // Path compression.
+    while (node != root) {
+        Usize next = self->nodes[node].parent;
+
+        self->nodes[node].parent = root;
+        node = next;
+    }
+
+    return root;
+}
+
+enum InferResult
+unify__Infer(struct Infer *self, Usize a, Usize b)
+{
+    self->pairs_len = 0;
+    push_index(&self->pairs, &self->pairs_len, &self->pairs_capacity, a);
+    push_index(&self->pairs, &self->pairs_len, &self->pairs_capacity, b);
+
+    while (self->pairs_len > 0) {
+        Usize root2 = find__Infer(self, self->pairs[--self->pairs_len]);
+        Usize root = find__Infer(self, self->pairs[--self->pairs_len]);
+
+        if (root == root2)
+            continue;
+
+        struct InferNode *left = &self->nodes[root];
+        struct InferNode *right = &self->nodes[root2];
+
+        if (left->kind == InferNodeKindVar ||
+            right->kind == InferNodeKindVar) {
+            if (left->kind == InferNodeKindVar &&
+                right->kind == InferNodeKindType && occurs(self, root, root2))
+                return InferResultOccurs;
+            else if (right->kind == InferNodeKindVar &&
+                     left->kind == InferNodeKindType &&
+                     occurs(self, root2, root))
+                return InferResultOccurs;
+
+            join(self, root, root2);
+            continue;
+        } else if (!same_head(left, right))
+            return InferResultMismatch;
+
+        Usize children = left->children;
+        Usize children2 = right->children;
+        Usize len = left->children_len;
+
+        // The classes are joined before their children are unified, so the
+        // unification of a cyclic constraint terminates.
+        join(self, root, root2);
+
+        for (Usize i = 0; i < len; i++) {
+            push_index(&self->pairs,
+                       &self->pairs_len,
+                       &self->pairs_capacity,
+                       self->children[children + i]);
+            push_index(&self->pairs,
+                       &self->pairs_len,
+                       &self->pairs_capacity,
+                       self->children[children2 + i]);
+        }
+    }
+
+    return InferResultOk;
+}
+
+void
+enter__Infer(struct Infer *self)
+{
+    self->level++;
+}
+
+void
+exit__Infer(struct Infer *self)
+{
+    self->level--;
+}
+
+void
+generalize__Infer(struct Infer *self, Usize node)
+{
+    self->epoch++;
+    self->stack_len = 0;
+    push_index(&self->stack, &self->stack_len, &self->stack_capacity, node);
+
+    while (self->stack_len > 0) {
+        struct InferNode *current =
+          &self->nodes[find__Infer(self, self->stack[--self->stack_len])];
+
+        if (current->visited == self->epoch || current->ground)
+            continue;
+
+        current->visited = self->epoch;
+
+        if (current->kind == InferNodeKindVar) {
+            if (current->level > self->level)
+                current->level = INFER_GENERIC_LEVEL;
+
+            continue;
+        }
+
+        for (Usize i = 0; i < current->children_len; i++)
+            push_index(&self->stack,
+                       &self->stack_len,
+                       &self->stack_capacity,
+                       self->children[current->children + i]);
+    }
+}
+
+// copies: struct Vec<Usize*>* (the pairs of generalized type variable and of
+// its fresh type variable)
+static Usize
+instantiate(struct Infer *self, Usize node, struct Vec *copies)
+{
+    Usize root = find__Infer(self, node);
+
+    if (self->nodes[root].kind == InferNodeKindVar) {
+        if (self->nodes[root].level != INFER_GENERIC_LEVEL)
+            return root;
+
+        for (Usize i = 0; i < len__Vec(*copies); i++) {
+            Usize *copy = get__Vec(*copies, i);
+
+            if (copy[0] == root)
+                return copy[1];
+        }
+
+        Usize *copy = malloc(sizeof(Usize) * 2);
+
+        copy[0] = root;
+        copy[1] = fresh__Infer(self);
+        push__Vec(copies, copy);
+
+        return copy[1];
+    } else if (self->nodes[root].ground)
+        return root;
+
+    Usize len = self->nodes[root].children_len;
+    Usize *children = malloc(len * sizeof(Usize));
+    bool changed = false;
+
+    for (Usize i = 0; i < len; i++) {
+        Usize child = self->children[self->nodes[root].children + i];
+
+        children[i] = instantiate(self, child, copies);
+        changed = changed || children[i] != find__Infer(self, child);
+    }
+
+    // The data types without generalized type variable are shared.
+    if (!changed) {
+        free(children);
+        return root;
+    }
+
+    Usize first = self->children_len;
+
+    for (Usize i = 0; i < len; i++)
+        push_index(&self->children,
+                   &self->children_len,
+                   &self->children_capacity,
+                   children[i]);
+
+    free(children);
+
+    return push_node(self,
+                     (struct InferNode){ .kind = InferNodeKindType,
+                                         .rank = 0,
+                                         .level = self->level,
+                                         .head = self->nodes[root].head,
+                                         .children = first,
+                                         .children_len = len,
+                                         .ground = false,
+                                         .visited = 0 });
+}
+
+Usize
+instantiate__Infer(struct Infer *self, Usize node)
+{
+    struct Vec *copies = NEW(Vec, sizeof(Usize *));
+    Usize res = instantiate(self, node, copies);
+
+    for (Usize i = len__Vec(*copies); i--;)
+        free(get__Vec(*copies, i));
+
+    FREE(Vec, copies);
+
+    return res;
+}
+
+// The TypeInterner takes the ownership of the values of the new data type, so
+// the name and the generic param of a custom data type are copied.
+static struct DataTypeSymbol *
+rebuild(struct Infer *self,
+        const struct DataTypeSymbol *head,
+        struct DataTypeSymbol **children)
+{
+    Usize len = get_children_len(head);
+
+    switch (head->kind) {
+        case DataTypeKindPtr:
+            return NEW(DataTypeSymbolPtr, self->types, children[0]);
+        case DataTypeKindRef:
+            return NEW(DataTypeSymbolRef, self->types, children[0]);
+        case DataTypeKindOptional:
+            return NEW(DataTypeSymbolOptional, self->types, children[0]);
+        case DataTypeKindException:
+            return NEW(DataTypeSymbolException, self->types, children[0]);
+        case DataTypeKindMut:
+            return NEW(DataTypeSymbolMut, self->types, children[0]);
+        case DataTypeKindArray:
+            return NEW(DataTypeSymbolArray,
+                       self->types,
+                       children[0],
+                       head->value.array->items[1]);
+        case DataTypeKindLambda: {
+            struct Vec *params = NEW(Vec, sizeof(struct DataTypeSymbol));
+
+            for (Usize i = 0; i + 1 < len; i++)
+                push__Vec(params, children[i]);
+
+            return NEW(
+              DataTypeSymbolLambda, self->types, params, children[len - 1]);
+        }
+        case DataTypeKindTuple: {
+            struct Vec *tuple = NEW(Vec, sizeof(struct DataTypeSymbol));
+
+            for (Usize i = 0; i < len; i++)
+                push__Vec(tuple, children[i]);
+
+            return NEW(DataTypeSymbolTuple, self->types, tuple);
+        }
+        case DataTypeKindCustom: {
+            struct Vec *generic_params =
+              NEW(Vec, sizeof(struct DataTypeSymbol));
+
+            for (Usize i = 0; i < len; i++)
+                push__Vec(generic_params, children[i]);
+
+            return NEW(
+              DataTypeSymbolCustom,
+              self->types,
+              generic_params,
+              head->custom_name ? copy__String(head->custom_name) : NULL,
+              head->scope && head->scope->item_kind == ScopeItemKindGeneric
+                ? copy__Scope(head->scope)
+                : head->scope);
+        }
+        default:
+            UNREACHABLE("this data type has no sub data type");
+    }
+}
+
+struct DataTypeSymbol *
+to_data_type__Infer(struct Infer *self, Usize node)
+{
+    struct InferNode *root = &self->nodes[find__Infer(self, node)];
+
+    if (root->kind == InferNodeKindVar)
+        return NEW(DataTypeSymbolCompilerDefined,
+                   self->types,
+                   NEW(CompilerDefinedDataType, "T", false));
+    else if (root->ground || root->children_len == 0)
+        return root->head;
+
+    struct DataTypeSymbol *head = root->head;
+    Usize first = root->children;
+    Usize len = root->children_len;
+    struct DataTypeSymbol **children =
+      malloc(len * sizeof(struct DataTypeSymbol *));
+    bool changed = false;
+
+    for (Usize i = 0; i < len; i++) {
+        children[i] = to_data_type__Infer(self, self->children[first + i]);
+        changed = changed || children[i] != get_child(head, i);
+    }
+
+    struct DataTypeSymbol *res =
+      changed ? rebuild(self, head, children) : head;
+
+    free(children);
+
+    return res;
+}
+
+void
+__free__Infer(struct Infer *self)
+{
+    free(self->nodes);
+    free(self->children);
+    free(self->memo_keys);
+    free(self->memo_nodes);
+    free(self->stack);
+    free(self->pairs);
+    free(self);
+}
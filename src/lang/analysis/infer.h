@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_INFER_H
+#define LILY_INFER_H
+
+#include <base/types.h>
+#include <stdbool.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/type_interner.h>
+
+// The level of a type variable quantified by generalize__Infer.
+#define INFER_GENERIC_LEVEL ((Usize)-1)
+
+enum InferNodeKind
+{
+    InferNodeKindVar,
+    InferNodeKindType
+};
+
+// A node of the union-find. The root of a class holds the data type of the
+// class: a type variable is bound by joining its class with the class of a
+// data type.
+typedef struct InferNode
+{
+    enum InferNodeKind kind;
+    Usize parent;
+    Usize rank;
+    Usize level; // level of a type variable
+    struct DataTypeSymbol *head; // struct DataTypeSymbol& (the data type of a
+                                 // InferNodeKindType, its sub data types are
+                                 // the children)
+    Usize children;              // index of the first child in children
+    Usize children_len;
+    bool ground;   // the data type has no type variable
+    Usize visited; // epoch of the last walk through the node
+} InferNode;
+
+// Constraint-based inference of the data types of a function: the data types
+// are nodes in a union-find with path compression and union by rank, so a
+// constraint costs near constant time, plus the occurs check of the variable
+// it binds.
+typedef struct Infer
+{
+    struct TypeInterner *types; // struct TypeInterner&
+    struct InferNode *nodes;
+    Usize len;
+    Usize capacity;
+    Usize *children; // the children of a type node are contiguous
+    Usize children_len;
+    Usize children_capacity;
+    struct DataTypeSymbol **memo_keys; // struct DataTypeSymbol& (open
+                                       // addressing, data types without
+                                       // CompilerDefined)
+    Usize *memo_nodes;
+    Usize memo_len;
+    Usize memo_capacity;
+    Usize *stack; // nodes to walk (occurs check, generalization)
+    Usize stack_len;
+    Usize stack_capacity;
+    Usize *pairs; // pairs of nodes to unify
+    Usize pairs_len;
+    Usize pairs_capacity;
+    Usize epoch;
+    Usize level; // level of the fresh type variables
+} Infer;
+
+enum InferResult
+{
+    InferResultOk,
+    InferResultMismatch,
+    InferResultOccurs // the type variable occurs in its data type
+};
+
+/**
+ *
+ * @brief Construct the Infer type.
+ */
+struct Infer *
+__new__Infer(struct TypeInterner *types);
+
+/**
+ *
+ * @return a new type variable at the current level.
+ */
+Usize
+fresh__Infer(struct Infer *self);
+
+/**
+ *
+ * @return the node of data_type, a CompilerDefined data type (undef, the
+ * pointee of nil, ...) is a fresh type variable.
+ */
+Usize
+from_data_type__Infer(struct Infer *self, struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @return the root of the class of node.
+ */
+Usize
+find__Infer(struct Infer *self, Usize node);
+
+/**
+ *
+ * @brief Unify the data types of a and b.
+ * @return InferResultOk, or the reason of the failure (the classes unified
+ * before the failure stay unified).
+ */
+enum InferResult
+unify__Infer(struct Infer *self, Usize a, Usize b);
+
+/**
+ *
+ * @brief Enter a let-level: the type variables created after this call can
+ * be generalized at the matching exit__Infer.
+ */
+void
+enter__Infer(struct Infer *self);
+
+/**
+ *
+ * @brief Exit a let-level.
+ */
+void
+exit__Infer(struct Infer *self);
+
+/**
+ *
+ * @brief Quantify the unbound type variables of node created deeper than the
+ * current level (they are the implicit generic params).
+ */
+void
+generalize__Infer(struct Infer *self, Usize node);
+
+/**
+ *
+ * @return a copy of node where each generalized type variable is replaced by a
+ * fresh type variable.
+ */
+Usize
+instantiate__Infer(struct Infer *self, Usize node);
+
+/**
+ *
+ * @return the interned data type of node, an unbound type variable is the
+ * CompilerDefined data type T.
+ */
+struct DataTypeSymbol *
+to_data_type__Infer(struct Infer *self, Usize node);
+
+/**
+ *
+ * @brief Free the Infer type.
+ */
+void
+__free__Infer(struct Infer *self);
+
+#endif // LILY_INFER_H
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <assert.h>
+#include <base/new.h>
+#include <lang/analysis/local_scope.h>
+#include <stdlib.h>
+
+struct LocalScopeChain *
+__new__LocalScopeChain()
+{
+    struct LocalScopeChain *self = malloc(sizeof(struct LocalScopeChain));
+
+    self->index = NEW(ScopeIndex);
+    self->current = NULL;
+
+    return self;
+}
+
+void
+enter__LocalScopeChain(struct LocalScopeChain *self)
+{
+    struct LocalScope *scope = malloc(sizeof(struct LocalScope));
+
+    scope->parent = self->current;
+    scope->depth = self->current ? self->current->depth + 1 : 0;
+    scope->values = NEW(Vec, sizeof(struct Scope));
+
+    self->current = scope;
+}
+
+void
+leave__LocalScopeChain(struct LocalScopeChain *self)
+{
+    struct LocalScope *scope = self->current;
+
+    assert(scope && "no lexical scope to leave");
+
+    for (Usize i = len__Vec(*scope->values); i--;)
+        remove__ScopeIndex(
+          self->index, ((struct Scope *)get__Vec(*scope->values, i))->name);
+
+    self->current = scope->parent;
+
+    FREE(Vec, scope->values);
+    free(scope);
+}
+
+void
+add__LocalScopeChain(struct LocalScopeChain *self, struct Scope *value)
+{
+    assert(self->current && "no lexical scope to declare the value");
+
+    value->depth = self->current->depth;
+    value->id = len__Vec(*self->current->values);
+
+    push__Vec(self->current->values, value);
+    add__ScopeIndex(
+      self->index, value->name, value->item_kind, value->id, value);
+}
+
+struct Scope *
+get__LocalScopeChain(const struct LocalScopeChain *self, struct String *name)
+{
+    struct ScopeIndexItem *item = get__ScopeIndex(self->index, name);
+
+    return item ? item->symbol : NULL;
+}
+
+void
+__free__LocalScopeChain(struct LocalScopeChain *self)
+{
+    while (self->current)
+        leave__LocalScopeChain(self);
+
+    FREE(ScopeIndex, self->index);
+    free(self);
+}
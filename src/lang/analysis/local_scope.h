@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_LOCAL_SCOPE_H
+#define LILY_LOCAL_SCOPE_H
+
+#include <base/string.h>
+#include <base/vec.h>
+#include <lang/analysis/scope_index.h>
+#include <lang/analysis/symbol_table.h>
+
+// Lexical scope of a function (params, body, block, lambda, match arm, ...).
+typedef struct LocalScope
+{
+    struct LocalScope *parent; // struct LocalScope* (NULL for the outermost)
+    Usize depth;
+    struct Vec *values; // struct Vec<struct Scope&>* (the slots of the scope)
+} LocalScope;
+
+// Chain of the lexical scopes of a function. Each local value is resolved to
+// a (depth, slot) pair when it's declared, stored in its Scope (depth and id),
+// and the name index always points to the innermost visible value, so a
+// lookup doesn't depend on the number of locals or on the nesting.
+typedef struct LocalScopeChain
+{
+    struct ScopeIndex *index;   // struct ScopeIndex*
+    struct LocalScope *current; // struct LocalScope*
+} LocalScopeChain;
+
+/**
+ *
+ * @brief Construct the LocalScopeChain type.
+ */
+struct LocalScopeChain *
+__new__LocalScopeChain();
+
+/**
+ *
+ * @brief Open a new lexical scope.
+ */
+void
+enter__LocalScopeChain(struct LocalScopeChain *self);
+
+/**
+ *
+ * @brief Close the current lexical scope, the values declared in it are no
+ * longer visible.
+ */
+void
+leave__LocalScopeChain(struct LocalScopeChain *self);
+
+/**
+ *
+ * @brief Declare a value in the current lexical scope and resolve its depth
+ * and its slot.
+ */
+void
+add__LocalScopeChain(struct LocalScopeChain *self, struct Scope *value);
+
+/**
+ *
+ * @return the innermost visible value with this name or NULL.
+ */
+struct Scope *
+get__LocalScopeChain(const struct LocalScopeChain *self, struct String *name);
+
+/**
+ *
+ * @brief Free the LocalScopeChain type.
+ */
+void
+__free__LocalScopeChain(struct LocalScopeChain *self);
+
+#endif // LILY_LOCAL_SCOPE_H
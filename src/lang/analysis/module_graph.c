@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <lang/analysis/module_graph.h>
+#include <lang/analysis/query.h>
+#include <lang/analysis/type_interner.h>
+#include <lang/analysis/typecheck.h>
+#include <stdlib.h>
+
+struct ModuleGraph *
+__new__ModuleGraph(const struct BuiltinTable *builtins)
+{
+    struct ModuleGraph *self = malloc(sizeof(struct ModuleGraph));
+
+    self->nodes_map = NEW(StrMap);
+    self->nodes = NEW(Vec, sizeof(struct ModuleNode));
+    self->stack = NEW(Vec, sizeof(struct ModuleNode));
+    self->types = NEW(TypeInterner, builtins);
+    self->queries = NEW(QueryEngine);
+
+    return self;
+}
+
+struct ModuleNode *
+get__ModuleGraph(struct ModuleGraph self, const Str path)
+{
+    return get__StrMap(*self.nodes_map, path);
+}
+
+struct ModuleNode *
+add__ModuleGraph(struct ModuleGraph *self, Str path)
+{
+    struct ModuleNode *node = malloc(sizeof(struct ModuleNode));
+
+    node->path = path;
+    node->tc = NULL;
+    node->state = ModuleStateLoading;
+
+    insert__StrMap(self->nodes_map, node->path, node);
+    push__Vec(self->nodes, node);
+    push__Vec(self->stack, node);
+
+    return node;
+}
+
+void
+loaded__ModuleGraph(struct ModuleGraph *self,
+                    struct ModuleNode *node,
+                    struct Typecheck *tc)
+{
+    node->tc = tc;
+    node->state = ModuleStateLoaded;
+
+    if (len__Vec(*self->stack) > 0 &&
+        get__Vec(*self->stack, len__Vec(*self->stack) - 1) == node)
+        pop__Vec(self->stack);
+}
+
+struct String *
+get_cycle__ModuleGraph(struct ModuleGraph self, struct ModuleNode *node)
+{
+    struct String *cycle = NEW(String);
+    Usize start = 0;
+
+    while (start < len__Vec(*self.stack) &&
+           get__Vec(*self.stack, start) != node)
+        start++;
+
+    for (Usize i = start; i < len__Vec(*self.stack); i++) {
+        push_str__String(cycle,
+                         ((struct ModuleNode *)get__Vec(*self.stack, i))->path);
+        push_str__String(cycle, " -> ");
+    }
+
+    push_str__String(cycle, node->path);
+
+    return cycle;
+}
+
+void
+__free__ModuleGraph(struct ModuleGraph *self)
+{
+    for (Usize i = len__Vec(*self->nodes); i--;) {
+        struct ModuleNode *node = get__Vec(*self->nodes, i);
+
+        if (node->tc) {
+            // The Source of an imported module is allocated by
+            // resolve_import.
+            struct Source *src = node->tc->parser.parse_block.scanner.src;
+
+            FREE(Typecheck, *node->tc);
+            free(node->tc);
+            free(src->file.name);
+            free(src);
+        }
+
+        free(node->path);
+        free(node);
+    }
+
+    FREE(Vec, self->nodes);
+    FREE(Vec, self->stack);
+    FREE(StrMap, self->nodes_map);
+    FREE(TypeInterner, self->types);
+    FREE(QueryEngine, self->queries);
+    free(self);
+}
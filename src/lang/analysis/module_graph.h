@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_MODULE_GRAPH_H
+#define LILY_MODULE_GRAPH_H
+
+#include <base/str_map.h>
+#include <base/string.h>
+#include <base/vec.h>
+
+struct BuiltinTable;
+struct QueryEngine;
+struct Typecheck;
+struct TypeInterner;
+
+enum ModuleState
+{
+    ModuleStateLoading, // the module is being typechecked
+    ModuleStateLoaded
+};
+
+typedef struct ModuleNode
+{
+    Str path;              // canonical path
+    struct Typecheck *tc;  // struct Typecheck* (NULL for the root module)
+    enum ModuleState state;
+} ModuleNode;
+
+// All the modules (files) of a compilation session. Each module is loaded,
+// parsed and typechecked once, then its Typecheck (and so its symbols) is
+// shared by every importer. The data types of all the modules are interned in
+// the same TypeInterner and their queries are counted by the same
+// QueryEngine.
+typedef struct ModuleGraph
+{
+    struct StrMap *nodes_map; // canonical path -> struct ModuleNode&
+    struct Vec *nodes;        // struct Vec<struct ModuleNode*>*
+    struct Vec *stack;        // struct Vec<struct ModuleNode&>* (the modules
+                              // being loaded, from the root)
+    struct TypeInterner *types;
+    struct QueryEngine *queries;
+} ModuleGraph;
+
+/**
+ *
+ * @brief Construct the ModuleGraph type.
+ * @param builtins The builtins of the session (can be NULL).
+ */
+struct ModuleGraph *
+__new__ModuleGraph(const struct BuiltinTable *builtins);
+
+/**
+ *
+ * @return the module of the canonical path or NULL.
+ */
+struct ModuleNode *
+get__ModuleGraph(struct ModuleGraph self, const Str path);
+
+/**
+ *
+ * @brief Add a module in loading state.
+ * @param path The canonical path (the ModuleGraph takes the ownership).
+ */
+struct ModuleNode *
+add__ModuleGraph(struct ModuleGraph *self, Str path);
+
+/**
+ *
+ * @brief Mark the last module being loaded as loaded.
+ * @param tc The ModuleGraph takes the ownership (can be NULL).
+ */
+void
+loaded__ModuleGraph(struct ModuleGraph *self,
+                    struct ModuleNode *node,
+                    struct Typecheck *tc);
+
+/**
+ *
+ * @brief Get the import cycle which ends to the module (the module must be in
+ * loading state): e.g. a.lily -> b.lily -> a.lily.
+ */
+struct String *
+get_cycle__ModuleGraph(struct ModuleGraph self, struct ModuleNode *node);
+
+/**
+ *
+ * @brief Free the ModuleGraph type (and the Typecheck of each module, then
+ * the data types).
+ */
+void
+__free__ModuleGraph(struct ModuleGraph *self);
+
+#endif // LILY_MODULE_GRAPH_H
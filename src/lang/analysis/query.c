@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <lang/analysis/query.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct QueryEngine *
+__new__QueryEngine()
+{
+    struct QueryEngine *self = malloc(sizeof(struct QueryEngine));
+
+    for (Usize i = 0; i < QUERY_KIND_COUNT; i++) {
+        atomic_init(&self->hits[i], 0);
+        atomic_init(&self->misses[i], 0);
+        atomic_init(&self->cycles[i], 0);
+    }
+
+    mtx_init(&self->lock, mtx_plain);
+
+    return self;
+}
+
+enum QueryStatus
+begin__QueryEngine(struct QueryEngine *self,
+                   enum QueryKind kind,
+                   enum QueryState *state)
+{
+    switch (*state) {
+        case QueryStateUnchecked:
+            *state = QueryStateInProgress;
+            atomic_fetch_add_explicit(
+              &self->misses[kind], 1, memory_order_relaxed);
+
+            return QueryStatusMiss;
+        case QueryStateInProgress:
+            atomic_fetch_add_explicit(
+              &self->cycles[kind], 1, memory_order_relaxed);
+
+            return QueryStatusCycle;
+        case QueryStateDone:
+            atomic_fetch_add_explicit(
+              &self->hits[kind], 1, memory_order_relaxed);
+
+            return QueryStatusHit;
+    }
+
+    return QueryStatusHit;
+}
+
+void
+end__QueryEngine(enum QueryState *state)
+{
+    *state = QueryStateDone;
+}
+
+void
+count__QueryEngine(struct QueryEngine *self, enum QueryKind kind, bool hit)
+{
+    atomic_fetch_add_explicit(
+      hit ? &self->hits[kind] : &self->misses[kind], 1, memory_order_relaxed);
+}
+
+const Str
+to_Str__QueryKind(enum QueryKind kind)
+{
+    switch (kind) {
+        case QueryKindSignatureOf:
+            return "signature_of";
+        case QueryKindTypeOf:
+            return "type_of";
+        case QueryKindResolve:
+            return "resolve";
+    }
+
+    return "unknown";
+}
+
+void
+print__QueryEngine(const struct QueryEngine *self)
+{
+    fprintf(
+      stderr, "%-14s %10s %10s %10s\n", "query", "hits", "misses", "cycles");
+
+    for (Usize i = 0; i < QUERY_KIND_COUNT; i++)
+        fprintf(stderr,
+                "%-14s %10zu %10zu %10zu\n",
+                to_Str__QueryKind(i),
+                atomic_load(&self->hits[i]),
+                atomic_load(&self->misses[i]),
+                atomic_load(&self->cycles[i]));
+}
+
+void
+__free__QueryEngine(struct QueryEngine *self)
+{
+    mtx_destroy(&self->lock);
+    free(self);
+}
@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_QUERY_H
+#define LILY_QUERY_H
+
+#include <base/types.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <threads.h>
+
+// The typecheck is organized as memoized queries: each query is evaluated at
+// most once, its state is kept next to its result (in the symbol of the
+// declaration or in a memo table) and a query reached again while it's
+// evaluated is a cycle.
+enum QueryState
+{
+    QueryStateUnchecked = 0,
+    QueryStateInProgress,
+    QueryStateDone
+};
+
+enum QueryKind
+{
+    QueryKindSignatureOf, // the signature of a declaration
+    QueryKindTypeOf,      // the type of an expression (value of a constant)
+    QueryKindResolve      // the declaration named by a path
+};
+
+#define QUERY_KIND_COUNT (QueryKindResolve + 1)
+
+enum QueryStatus
+{
+    QueryStatusMiss, // the query must be evaluated by the caller
+    QueryStatusHit,  // the result is already known
+    QueryStatusCycle // the query is being evaluated
+};
+
+// Counters of the queries of a compilation session (shared by all the
+// modules, and so by the threads of -j N).
+typedef struct QueryEngine
+{
+    atomic_size_t hits[QUERY_KIND_COUNT];
+    atomic_size_t misses[QUERY_KIND_COUNT];
+    atomic_size_t cycles[QUERY_KIND_COUNT];
+    mtx_t lock; // protect the memo tables of the resolve query
+} QueryEngine;
+
+/**
+ *
+ * @brief Construct the QueryEngine type.
+ */
+struct QueryEngine *
+__new__QueryEngine();
+
+/**
+ *
+ * @brief Start the query of the given state.
+ * @return QueryStatusMiss if the query was unchecked (its state is now in
+ * progress, the caller must call end__QueryEngine once the result is set),
+ * otherwise QueryStatusHit or QueryStatusCycle.
+ * @note The state of a query is only written by one thread: the signatures
+ * are all checked before the function bodies are dispatched with -j N.
+ */
+enum QueryStatus
+begin__QueryEngine(struct QueryEngine *self,
+                   enum QueryKind kind,
+                   enum QueryState *state);
+
+/**
+ *
+ * @brief Mark the query as done.
+ */
+void
+end__QueryEngine(enum QueryState *state);
+
+/**
+ *
+ * @brief Count the lookup of a query memoized in a table.
+ */
+void
+count__QueryEngine(struct QueryEngine *self, enum QueryKind kind, bool hit);
+
+/**
+ *
+ * @return the name of the query kind.
+ */
+const Str
+to_Str__QueryKind(enum QueryKind kind);
+
+/**
+ *
+ * @brief Print the counters on stderr.
+ */
+void
+print__QueryEngine(const struct QueryEngine *self);
+
+/**
+ *
+ * @brief Free the QueryEngine type.
+ */
+void
+__free__QueryEngine(struct QueryEngine *self);
+
+#endif // LILY_QUERY_H
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <lang/analysis/scope_index.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCOPE_INDEX_KEY_MAX_LEN 256
+
+// Copy the characters of name in buffer, or in a new allocated Str if name is
+// too long for buffer.
+static char *
+get_key(struct String *name, char *buffer, Usize *len);
+
+static char *
+get_key(struct String *name, char *buffer, Usize *len)
+{
+    *len = len__String(*name);
+
+    char *key = *len < SCOPE_INDEX_KEY_MAX_LEN ? buffer : malloc(*len + 1);
+
+    for (Usize i = 0; i < *len; i++)
+        key[i] = (char)(UPtr)get__String(*name, i);
+
+    key[*len] = '\0';
+
+    return key;
+}
+
+struct ScopeIndex *
+__new__ScopeIndex()
+{
+    struct ScopeIndex *self = malloc(sizeof(struct ScopeIndex));
+
+    self->names = NEW(StrMap);
+    self->keys = NEW(Vec, sizeof(Str));
+    self->items = NEW(Vec, sizeof(struct ScopeIndexItem));
+
+    return self;
+}
+
+void
+add__ScopeIndex(struct ScopeIndex *self,
+                struct String *name,
+                enum ScopeItemKind kind,
+                Usize id,
+                void *symbol)
+{
+    char buffer[SCOPE_INDEX_KEY_MAX_LEN];
+    Usize len = 0;
+    char *key = get_key(name, buffer, &len);
+    struct ScopeIndexItem *item = malloc(sizeof(struct ScopeIndexItem));
+
+    item->kind = kind;
+    item->id = id;
+    item->symbol = symbol;
+    item->next = get_with_len__StrMap(*self->names, key, len);
+
+    // The StrMap borrows the key of the first item of each name.
+    if (!item->next) {
+        if (key == buffer)
+            key = strndup(buffer, len);
+
+        push__Vec(self->keys, key);
+    }
+
+    insert_with_len__StrMap(self->names, key, len, item);
+    push__Vec(self->items, item);
+
+    if (item->next && key != buffer)
+        free(key);
+}
+
+struct ScopeIndexItem *
+get__ScopeIndex(const struct ScopeIndex *self, struct String *name)
+{
+    char buffer[SCOPE_INDEX_KEY_MAX_LEN];
+    Usize len = 0;
+    char *key = get_key(name, buffer, &len);
+    struct ScopeIndexItem *item = get_with_len__StrMap(*self->names, key, len);
+
+    if (key != buffer)
+        free(key);
+
+    return item;
+}
+
+struct ScopeIndexItem *
+get_with_kind__ScopeIndex(const struct ScopeIndex *self,
+                          struct String *name,
+                          enum ScopeItemKind kind)
+{
+    struct ScopeIndexItem *item = get__ScopeIndex(self, name);
+
+    while (item && item->kind != kind)
+        item = item->next;
+
+    return item;
+}
+
+void
+remove__ScopeIndex(struct ScopeIndex *self, struct String *name)
+{
+    char buffer[SCOPE_INDEX_KEY_MAX_LEN];
+    Usize len = 0;
+    char *key = get_key(name, buffer, &len);
+    struct ScopeIndexItem *item = get_with_len__StrMap(*self->names, key, len);
+
+    // The item stays in self->items, it's freed with the ScopeIndex.
+    if (item)
+        insert_with_len__StrMap(self->names, key, len, item->next);
+
+    if (key != buffer)
+        free(key);
+}
+
+void
+__free__ScopeIndex(struct ScopeIndex *self)
+{
+    for (Usize i = len__Vec(*self->items); i--;)
+        free(get__Vec(*self->items, i));
+
+    for (Usize i = len__Vec(*self->keys); i--;)
+        free(get__Vec(*self->keys, i));
+
+    FREE(Vec, self->items);
+    FREE(Vec, self->keys);
+    FREE(StrMap, self->names);
+    free(self);
+}
@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_SCOPE_INDEX_H
+#define LILY_SCOPE_INDEX_H
+
+#include <base/str_map.h>
+#include <base/string.h>
+#include <base/vec.h>
+#include <lang/analysis/symbol_table.h>
+
+typedef struct ScopeIndexItem
+{
+    enum ScopeItemKind kind;
+    Usize id;     // index of the symbol in the Vec of its kind
+    void *symbol; // void& (struct FunSymbol&, struct SymbolTable&, ...)
+    struct ScopeIndexItem *next; // struct ScopeIndexItem& (the item which
+                                 // was added before with the same name)
+} ScopeIndexItem;
+
+// Index from name to symbol of one scope (file, module, class, enum, record,
+// ...). When several symbols have the same name, the last added wins, like
+// the backward scans it replaces.
+typedef struct ScopeIndex
+{
+    struct StrMap *names; // struct StrMap<struct ScopeIndexItem&>*
+    struct Vec *keys;     // struct Vec<Str*>*
+    struct Vec *items;    // struct Vec<struct ScopeIndexItem*>*
+} ScopeIndex;
+
+/**
+ *
+ * @brief Construct the ScopeIndex type.
+ */
+struct ScopeIndex *
+__new__ScopeIndex();
+
+/**
+ *
+ * @brief Add a symbol in the scope.
+ */
+void
+add__ScopeIndex(struct ScopeIndex *self,
+                struct String *name,
+                enum ScopeItemKind kind,
+                Usize id,
+                void *symbol);
+
+/**
+ *
+ * @return the last symbol added with this name or NULL.
+ */
+struct ScopeIndexItem *
+get__ScopeIndex(const struct ScopeIndex *self, struct String *name);
+
+/**
+ *
+ * @return the last symbol of this kind added with this name or NULL.
+ */
+struct ScopeIndexItem *
+get_with_kind__ScopeIndex(const struct ScopeIndex *self,
+                          struct String *name,
+                          enum ScopeItemKind kind);
+
+/**
+ *
+ * @brief Remove the last symbol added with this name, the symbol it shadowed
+ * (if any) is visible again.
+ */
+void
+remove__ScopeIndex(struct ScopeIndex *self, struct String *name);
+
+/**
+ *
+ * @brief Free the ScopeIndex type.
+ */
+void
+__free__ScopeIndex(struct ScopeIndex *self);
+
+#endif // LILY_SCOPE_INDEX_H
@@ -24,7 +24,11 @@
 
 #include "lang/parser/ast.h"
 #include <base/macros.h>
+#include <lang/analysis/infer.h>
+#include <lang/analysis/scope_index.h>
 #include <lang/analysis/symbol_table.h>
+#include <lang/analysis/type_interner.h>
+#include <stdatomic.h>
 #include <string.h>
 
 struct Scope *
@@ -39,9 +43,11 @@ __new__Scope(const Str filename,
     self->filename = filename;
     self->name = name;
     self->id = id;
+    self->depth = 0;
     self->item_kind = item_kind;
     self->kind = kind;
     self->previous = previous;
+    self->data_type = NULL;
     return self;
 }
 
@@ -58,341 +64,130 @@ copy__Scope(struct Scope *self)
 void
 __free__LocalDataType(struct LocalDataType *self)
 {
-    if (self->restricted) {
-        FREE(DataTypeSymbolAll, self->restricted->items[0]);
+    if (self->restricted)
         FREE(Tuple, self->restricted);
-    }
 
     free(self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbol(enum DataTypeKind kind)
+__new__DataTypeSymbol(struct TypeInterner *types, enum DataTypeKind kind)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = kind;
-    self->scope = NULL;
-    return self;
+    struct DataTypeSymbol self = { .kind = kind, .scope = NULL };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolPtr(struct DataTypeSymbol *ptr)
+__new__DataTypeSymbolPtr(struct TypeInterner *types, struct DataTypeSymbol *ptr)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindPtr;
-    self->scope = NULL;
-    self->value.ptr = ptr;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindPtr,
+                                   .scope = NULL,
+                                   .value.ptr = ptr };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolRef(struct DataTypeSymbol *ref)
+__new__DataTypeSymbolRef(struct TypeInterner *types, struct DataTypeSymbol *ref)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindRef;
-    self->scope = NULL;
-    self->value.ref = ref;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindRef,
+                                   .scope = NULL,
+                                   .value.ref = ref };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolOptional(struct DataTypeSymbol *optional)
+__new__DataTypeSymbolOptional(struct TypeInterner *types,
+                              struct DataTypeSymbol *optional)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindOptional;
-    self->scope = NULL;
-    self->value.optional = optional;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindOptional,
+                                   .scope = NULL,
+                                   .value.optional = optional };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolException(struct DataTypeSymbol *exception)
+__new__DataTypeSymbolException(struct TypeInterner *types,
+                               struct DataTypeSymbol *exception)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindException;
-    self->scope = NULL;
-    self->value.exception = exception;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindException,
+                                   .scope = NULL,
+                                   .value.exception = exception };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolMut(struct DataTypeSymbol *mut)
+__new__DataTypeSymbolMut(struct TypeInterner *types, struct DataTypeSymbol *mut)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindMut;
-    self->scope = NULL;
-    self->value.mut = mut;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindMut,
+                                   .scope = NULL,
+                                   .value.mut = mut };
+    return intern__TypeInterner(types, &self);
 }
 
+// The Tuple of a lambda or of an array is only allocated by the TypeInterner
+// for a new data type.
 struct DataTypeSymbol *
-__new__DataTypeSymbolLambda(struct Vec *params,
+__new__DataTypeSymbolLambda(struct TypeInterner *types,
+                            struct Vec *params,
                             struct DataTypeSymbol *return_type)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindLambda;
-    self->scope = NULL;
-    self->value.lambda = NEW(Tuple, 2, params, return_type);
-    return self;
+    void *items[2] = { params, return_type };
+    struct Tuple lambda = { .size = 2, .items = items };
+    struct DataTypeSymbol self = { .kind = DataTypeKindLambda,
+                                   .scope = NULL,
+                                   .value.lambda = &lambda };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolArray(struct DataTypeSymbol *data_type, Usize *size)
+__new__DataTypeSymbolArray(struct TypeInterner *types,
+                           struct DataTypeSymbol *data_type,
+                           Usize *size)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindArray;
-    self->scope = NULL;
-    self->value.array = NEW(Tuple, 2, data_type, size);
-    return self;
+    void *items[2] = { data_type, size };
+    struct Tuple array = { .size = 2, .items = items };
+    struct DataTypeSymbol self = { .kind = DataTypeKindArray,
+                                   .scope = NULL,
+                                   .value.array = &array };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolCustom(struct Vec *generic_params,
+__new__DataTypeSymbolCustom(struct TypeInterner *types,
+                            struct Vec *generic_params,
                             struct String *name,
                             struct Scope *scope)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindCustom;
-    self->custom_name = name;
-    self->scope = scope;
-    self->value.custom = generic_params;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindCustom,
+                                   .custom_name = name,
+                                   .scope = scope,
+                                   .value.custom = generic_params };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
-__new__DataTypeSymbolTuple(struct Vec *tuple)
+__new__DataTypeSymbolTuple(struct TypeInterner *types, struct Vec *tuple)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindTuple;
-    self->scope = NULL;
-    self->value.tuple = tuple;
-    return self;
+    struct DataTypeSymbol self = { .kind = DataTypeKindTuple,
+                                   .scope = NULL,
+                                   .value.tuple = tuple };
+    return intern__TypeInterner(types, &self);
 }
 
 struct DataTypeSymbol *
 __new__DataTypeSymbolCompilerDefined(
+  struct TypeInterner *types,
   struct CompilerDefinedDataType compiler_defined)
 {
-    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
-    self->kind = DataTypeKindCompilerDefined;
-    self->scope = NULL;
-    self->value.compiler_defined = compiler_defined;
-    return self;
-}
-
-struct DataTypeSymbol *
-copy__DataTypeSymbol(struct DataTypeSymbol *self)
-{
-    struct DataTypeSymbol *copy = malloc(sizeof(struct DataTypeSymbol));
-
-    memcpy(copy, self, sizeof(struct DataTypeSymbol));
-
-    return copy;
-}
-
-bool
-eq__DataTypeSymbol(struct DataTypeSymbol *self, struct DataTypeSymbol *y)
-{
-    switch (self->kind) {
-        case DataTypeKindSelf:
-            return y->kind == DataTypeKindSelf ? true : false;
-        case DataTypeKindPtr:
-            return y->kind == DataTypeKindPtr
-                     ? eq__DataTypeSymbol(self->value.ptr, y->value.ptr)
-                     : false;
-        case DataTypeKindRef:
-            return y->kind == DataTypeKindRef
-                     ? eq__DataTypeSymbol(self->value.ref, y->value.ref)
-                     : false;
-        case DataTypeKindStr:
-            return y->kind == DataTypeKindStr ? true : false;
-        case DataTypeKindBitStr:
-            return y->kind == DataTypeKindBitStr ? true : false;
-        case DataTypeKindChar:
-            return y->kind == DataTypeKindChar ? true : false;
-        case DataTypeKindBitChar:
-            return y->kind == DataTypeKindBitChar ? true : false;
-        case DataTypeKindI8:
-            return y->kind == DataTypeKindI8 ? true : false;
-        case DataTypeKindI16:
-            return y->kind == DataTypeKindI16 ? true : false;
-        case DataTypeKindI32:
-            return y->kind == DataTypeKindI32 ? true : false;
-        case DataTypeKindI64:
-            return y->kind == DataTypeKindI64 ? true : false;
-        case DataTypeKindI128:
-            return y->kind == DataTypeKindI128 ? true : false;
-        case DataTypeKindU8:
-            return y->kind == DataTypeKindU8 ? true : false;
-        case DataTypeKindU16:
-            return y->kind == DataTypeKindU16 ? true : false;
-        case DataTypeKindU32:
-            return y->kind == DataTypeKindU32 ? true : false;
-        case DataTypeKindU64:
-            return y->kind == DataTypeKindU64 ? true : false;
-        case DataTypeKindU128:
-            return y->kind == DataTypeKindU128 ? true : false;
-        case DataTypeKindF32:
-            return y->kind == DataTypeKindF32 ? true : false;
-        case DataTypeKindF64:
-            return y->kind == DataTypeKindF64 ? true : false;
-        case DataTypeKindBool:
-            return y->kind == DataTypeKindBool ? true : false;
-        case DataTypeKindIsize:
-            return y->kind == DataTypeKindIsize ? true : false;
-        case DataTypeKindUsize:
-            return y->kind == DataTypeKindUsize ? true : false;
-        case DataTypeKindNever:
-            return y->kind == DataTypeKindNever ? true : false;
-        case DataTypeKindAny:
-            return y->kind == DataTypeKindAny ? true : false;
-        case DataTypeKindOptional:
-            return y->kind == DataTypeKindOptional
-                     ? eq__DataTypeSymbol(self->value.optional,
-                                          y->value.optional)
-                     : false;
-        case DataTypeKindUnit:
-            return y->kind == DataTypeKindUnit ? true : false;
-        case DataTypeKindException:
-            return y->kind == DataTypeKindException
-                     ? eq__DataTypeSymbol(self->value.exception,
-                                          y->value.exception)
-                     : false;
-        case DataTypeKindMut:
-            return y->kind == DataTypeKindMut
-                     ? eq__DataTypeSymbol(self->value.mut, y->value.mut)
-                     : false;
-        case DataTypeKindLambda: {
-            struct Vec *v_self = self->value.lambda->items[0];
-            struct Vec *v_y = y->value.lambda->items[0];
-
-            if (len__Vec(*v_self) == len__Vec(*v_y)) {
-                for (Usize i = len__Vec(*v_self); i--;) {
-                    if (!eq__DataTypeSymbol(get__Vec(*v_self, i),
-                                            get__Vec(*v_y, i)))
-                        return false;
-                }
-
-                return eq__DataTypeSymbol(self->value.lambda->items[1],
-                                          y->value.lambda->items[1]);
-            } else
-                return false;
-        }
-        case DataTypeKindArray:
-            return (Usize *)self->value.array->items[1] ==
-                         (Usize *)y->value.array->items[1] &&
-                       eq__DataTypeSymbol(self->value.array->items[0],
-                                          y->value.array->items[0])
-                     ? true
-                     : false;
-        case DataTypeKindTuple: {
-            struct Vec *v_self = self->value.tuple->items[0];
-            struct Vec *v_y = y->value.tuple->items[0];
-
-            for (Usize i = len__Vec(*v_self); i--;) {
-                if (!eq__DataTypeSymbol(get__Vec(*v_self, i),
-                                        get__Vec(*v_y, i)))
-                    return false;
-            }
-
-            return true;
-        }
-        case DataTypeKindCustom:
-            if (y->kind == DataTypeKindCustom) {
-                if (self->custom_name && y->custom_name)
-                    return eq__String(self->custom_name, y->custom_name, false);
-                else if (!self->custom_name && !y->custom_name)
-                    return eq__String(self->scope->name, y->scope->name, false);
-                else
-                    return false;
-            } else
-                return false;
-        case DataTypeKindCompilerDefined:
-            return true;
-    }
-}
-
-void
-__free__DataTypeSymbolAll(struct DataTypeSymbol *self)
-{
-    switch (self->kind) {
-        case DataTypeKindPtr:
-            FREE(DataTypeSymbolPtr, self);
-            break;
-        case DataTypeKindRef:
-            FREE(DataTypeSymbolRef, self);
-            break;
-        case DataTypeKindOptional:
-            FREE(DataTypeSymbolOptional, self);
-            break;
-        case DataTypeKindException:
-            FREE(DataTypeSymbolException, self);
-            break;
-        case DataTypeKindMut:
-            FREE(DataTypeSymbolMut, self);
-            break;
-        case DataTypeKindLambda:
-            FREE(DataTypeSymbolLambda, self);
-            break;
-        case DataTypeKindArray:
-            FREE(DataTypeSymbolArray, self);
-            break;
-        case DataTypeKindCustom:
-            FREE(DataTypeSymbolCustom, self);
-            break;
-        case DataTypeKindTuple:
-            FREE(DataTypeSymbolTuple, self);
-            break;
-        case DataTypeKindCompilerDefined:
-            FREE(DataTypeSymbolCompilerDefined, self);
-            break;
-        default:
-            FREE(DataTypeSymbol, self);
-            break;
-    }
-}
-
-void
-__free__DataTypeSymbolLambda(struct DataTypeSymbol *self)
-{
-    FREE(Vec, self->value.lambda->items[0]);
-    FREE(DataTypeSymbolAll, self->value.lambda->items[1]);
-    FREE(Tuple, self->value.lambda);
-    free(self);
-}
-
-void
-__free__DataTypeSymbolArray(struct DataTypeSymbol *self)
-{
-    if (self->value.array->items[0])
-        FREE(DataTypeSymbolAll, self->value.array->items[0]);
-
-    FREE(Tuple, self->value.array);
-    free(self);
-}
-
-void
-__free__DataTypeSymbolCustom(struct DataTypeSymbol *self)
-{
-    if (self->custom_name)
-        FREE(String, self->custom_name);
-
-    if (self->value.custom) {
-        for (Usize i = len__Vec(*self->value.custom); i--;)
-            FREE(DataTypeSymbolAll, get__Vec(*self->value.custom, i));
-
-        FREE(Vec, self->value.custom);
-    }
-
-    free(self);
+    struct DataTypeSymbol self = { .kind = DataTypeKindCompilerDefined,
+                                   .scope = NULL,
+                                   .value.compiler_defined = compiler_defined };
+    return intern__TypeInterner(types, &self);
 }
 
 void
 __free__GenericSymbolRestrictedDataType(struct Generic *self)
 {
-    FREE(
-      DataTypeSymbolAll,
-      ((struct Tuple *)self->value.restricted_data_type->items[1])->items[0]);
     free(
       ((struct Tuple *)self->value.restricted_data_type->items[1])->items[1]);
     FREE(Tuple, self->value.restricted_data_type->items[1]);
@@ -436,10 +231,35 @@ __free__RecordCallSymbol(struct RecordCallSymbol self)
     }
 }
 
+void
+__free__LambdaSymbol(struct LambdaSymbol self)
+{
+    for (Usize i = len__Vec(*self.params); i--;)
+        FREE(Scope, get__Vec(*self.params, i));
+
+    for (Usize i = len__Vec(*self.body); i--;)
+        FREE(SymbolTableAll, get__Vec(*self.body, i));
+
+    for (Usize i = len__Vec(*self.captures); i--;)
+        FREE(Scope, get__Vec(*self.captures, i));
+
+    if (self.args) {
+        for (Usize i = len__Vec(*self.args); i--;)
+            FREE(ExprSymbolAll, get__Vec(*self.args, i));
+
+        FREE(Vec, self.args);
+    }
+
+    FREE(Vec, self.params);
+    FREE(Vec, self.body);
+    FREE(Vec, self.captures);
+}
+
 void
 __free__VariantSymbol(struct VariantSymbol self)
 {
-    FREE(ExprSymbolAll, self.value);
+    if (self.value)
+        FREE(ExprSymbolAll, self.value);
 }
 
 struct ExprSymbol *
@@ -725,7 +545,6 @@ void
 __free__ExprSymbolFunCall(struct ExprSymbol *self)
 {
     FREE(FunCallSymbol, self->value.fun_call);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -733,15 +552,13 @@ void
 __free__ExprSymbolRecordCall(struct ExprSymbol *self)
 {
     FREE(RecordCallSymbol, self->value.record_call);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
 void
 __free__ExprSymbolLambda(struct ExprSymbol *self)
 {
-    TODO("Free lambda symbol");
-    FREE(DataTypeSymbolAll, self->data_type);
+    FREE(LambdaSymbol, self->value.lambda);
     free(self);
 }
 
@@ -752,8 +569,6 @@ __free__ExprSymbolTuple(struct ExprSymbol *self)
         FREE(ExprSymbolAll, get__Vec(*self->value.tuple, i));
 
     FREE(Vec, self->value.tuple);
-    FREE(DataTypeSymbolAll, self->value.tuple->items[1]);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -764,7 +579,6 @@ __free__ExprSymbolArray(struct ExprSymbol *self)
         FREE(ExprSymbolAll, get__Vec(*self->value.array, i));
 
     FREE(Vec, self->value.array);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -775,7 +589,6 @@ __free__ExprSymbolBlock(struct ExprSymbol *self)
         FREE(SymbolTableAll, get__Vec(*self->value.block, i));
 
     FREE(Vec, self->value.block);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -790,8 +603,6 @@ void
 __free__ExprSymbolGrouping(struct ExprSymbol *self)
 {
     FREE(ExprSymbolAll, self->value.grouping->items[0]);
-    FREE(DataTypeSymbolAll, self->value.grouping->items[1]);
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -874,8 +685,12 @@ __free__MatchSymbol(struct MatchSymbol self)
         FREE(ExprSymbolAll,
              ((struct Tuple *)get__Vec(*self.pattern, i))->items[0]);
 
+        if (((struct Tuple *)get__Vec(*self.pattern, i))->items[1])
+            FREE(ExprSymbolAll,
+                 ((struct Tuple *)get__Vec(*self.pattern, i))->items[1]);
+
         struct Vec *temp =
-          ((struct Tuple *)get__Vec(*self.pattern, i))->items[1];
+          ((struct Tuple *)get__Vec(*self.pattern, i))->items[2];
 
         for (Usize j = len__Vec(*temp); j--;)
             FREE(SymbolTableAll, get__Vec(*temp, j));
@@ -899,7 +714,9 @@ __new__IfBranchSymbol(struct ExprSymbol *cond, struct Vec *body)
 void
 __free__IfBranchSymbol(struct IfBranchSymbol *self)
 {
-    FREE(ExprSymbolAll, self->cond);
+    // The else branch has no condition.
+    if (self->cond)
+        FREE(ExprSymbolAll, self->cond);
 
     for (Usize i = len__Vec(*self->body); i--;)
         FREE(SymbolTableAll, get__Vec(*self->body, i));
@@ -923,11 +740,15 @@ __free__IfCondSymbol(struct IfCondSymbol self)
 {
     FREE(IfBranchSymbol, self.if_);
 
-    for (Usize i = len__Vec(*self.elif); i--;)
-        FREE(IfBranchSymbol, get__Vec(*self.elif, i));
+    if (self.elif) {
+        for (Usize i = len__Vec(*self.elif); i--;)
+            FREE(IfBranchSymbol, get__Vec(*self.elif, i));
 
-    FREE(Vec, self.elif);
-    FREE(IfBranchSymbol, self.else_);
+        FREE(Vec, self.elif);
+    }
+
+    if (self.else_)
+        FREE(IfBranchSymbol, self.else_);
 }
 
 struct TrySymbol
@@ -1015,18 +836,23 @@ __new__FunParamSymbol(struct FunParam *param)
     self->default_defined_data_type = param->param_data_type ? true : false;
     self->name = param->name;
     self->default_ = NULL;
+    self->scope = NULL;
+    self->data_type_var = 0;
     return self;
 }
 
 void
 __free__FunParamSymbol(struct FunParamSymbol *self)
 {
-    FREE(DataTypeSymbolAll, self->param_data_type->items[0]);
-    FREE(Tuple, self->param_data_type);
+    if (self->param_data_type)
+        FREE(Tuple, self->param_data_type);
 
     if (self->kind == FunParamKindDefault)
         FREE(ExprSymbolAll, self->default_);
 
+    if (self->scope)
+        FREE(Scope, self->scope);
+
     free(self);
 }
 
@@ -1040,22 +866,25 @@ __new__FunSymbol(struct Decl *fun_decl)
     self->params = NULL;
     self->visibility = VISIBILITY(fun_decl->value.fun);
     self->is_async = fun_decl->value.fun->is_async;
+    self->is_tailrec = false;
     self->return_type = NULL;
     self->body = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
     self->fun_decl = &*fun_decl;
+    self->local_data_type = NULL;
+    self->infer = NULL;
+    self->return_type_var = 0;
+    atomic_init(&self->body_checked, false);
     return self;
 }
 
-void
-__free__FunSymbol(struct FunSymbol *self)
+static void
+free_check_of_fun(struct FunSymbol *self)
 {
     if (self->tagged_type) {
-        for (Usize i = len__Vec(*self->tagged_type); i--;) {
-            FREE(DataTypeSymbolAll,
-                 ((struct Tuple *)get__Vec(*self->tagged_type, i))->items[0]);
+        for (Usize i = len__Vec(*self->tagged_type); i--;)
             FREE(Tuple, get__Vec(*self->tagged_type, i));
-        }
 
         FREE(Vec, self->tagged_type);
     }
@@ -1067,9 +896,6 @@ __free__FunSymbol(struct FunSymbol *self)
         FREE(Vec, self->params);
     }
 
-    if (self->return_type)
-        FREE(DataTypeSymbolAll, self->return_type);
-
     if (self->body) {
         for (Usize i = len__Vec(*self->body); i--;)
             FREE(SymbolTableAll, get__Vec(*self->body, i));
@@ -1077,6 +903,47 @@ __free__FunSymbol(struct FunSymbol *self)
         FREE(Vec, self->body);
     }
 
+    if (self->local_data_type) {
+        for (Usize i = len__Vec(*self->local_data_type); i--;)
+            FREE(LocalDataType, get__Vec(*self->local_data_type, i));
+
+        FREE(Vec, self->local_data_type);
+    }
+
+    if (self->infer)
+        FREE(Infer, self->infer);
+}
+
+void
+reset__FunSymbol(struct FunSymbol *self, struct Decl *fun_decl)
+{
+    free_check_of_fun(self);
+
+    if (self->scope)
+        FREE(Scope, self->scope);
+
+    self->name = &*fun_decl->value.fun->name;
+    self->tagged_type = NULL;
+    self->generic_params = NULL;
+    self->params = NULL;
+    self->visibility = VISIBILITY(fun_decl->value.fun);
+    self->is_async = fun_decl->value.fun->is_async;
+    self->is_tailrec = false;
+    self->return_type = NULL;
+    self->body = NULL;
+    self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->fun_decl = &*fun_decl;
+    self->local_data_type = NULL;
+    self->infer = NULL;
+    self->return_type_var = 0;
+    atomic_store(&self->body_checked, false);
+}
+
+void
+__free__FunSymbol(struct FunSymbol *self)
+{
+    free_check_of_fun(self);
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1089,6 +956,8 @@ __new__ConstantSymbol(struct Decl *constant_decl)
     self->data_type = NULL;
     self->expr_symbol = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->value = QueryStateUnchecked;
     self->constant_decl = constant_decl;
     self->visibility = VISIBILITY(constant_decl->value.constant);
     return self;
@@ -1098,7 +967,6 @@ void
 __free__ConstantSymbol(struct ConstantSymbol *self)
 {
     FREE(ExprSymbolAll, self->expr_symbol);
-    FREE(DataTypeSymbolAll, self->data_type);
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1110,6 +978,8 @@ __new__ModuleSymbol(struct Decl *module_decl)
     self->name = module_decl->value.module->name;
     self->body = NEW(Vec, sizeof(struct SymbolTable));
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->module_decl = module_decl;
     self->import_loc = NULL;
     self->visibility = VISIBILITY(module_decl->value.module);
@@ -1123,6 +993,9 @@ __free__ModuleSymbol(struct ModuleSymbol *self)
         FREE(SymbolTableAll, get__Vec(*self->body, i));
 
     FREE(Vec, self->body);
+    if (self->index)
+        FREE(ScopeIndex, self->index);
+
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1135,6 +1008,7 @@ __new__AliasSymbol(struct Decl *alias_decl)
     self->generic_params = NULL;
     self->data_type = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
     self->alias_decl = alias_decl;
     self->visibility = VISIBILITY(alias_decl->value.alias);
     return self;
@@ -1143,7 +1017,6 @@ __new__AliasSymbol(struct Decl *alias_decl)
 void
 __free__AliasSymbol(struct AliasSymbol *self)
 {
-    FREE(DataTypeSymbolAll, self->data_type);
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1163,8 +1036,9 @@ __new__FieldRecordSymbol(struct FieldRecord *field_record)
 void
 __free__FieldRecordSymbol(struct FieldRecordSymbol *self)
 {
-    FREE(DataTypeSymbolAll, self->data_type);
-    FREE(ExprSymbolAll, self->value);
+    if (self->value)
+        FREE(ExprSymbolAll, self->value);
+
     free(self);
 }
 
@@ -1176,6 +1050,8 @@ __new__RecordSymbol(struct Decl *record_decl)
     self->generic_params = NULL;
     self->fields = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->visibility = VISIBILITY(record_decl->value.record);
     self->record_decl = record_decl;
     return self;
@@ -1191,6 +1067,9 @@ __free__RecordSymbol(struct RecordSymbol *self)
         FREE(Vec, self->fields);
     }
 
+    if (self->index)
+        FREE(ScopeIndex, self->index);
+
     FREE(Scope, self->scope);
 
     free(self);
@@ -1205,6 +1084,8 @@ __new__RecordObjSymbol(struct Decl *record_decl)
     self->fields = NULL;
     self->attached = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->visibility = VISIBILITY(record_decl->value.record);
     self->record_decl = record_decl;
     return self;
@@ -1227,6 +1108,9 @@ __free__RecordObjSymbol(struct RecordObjSymbol *self)
         FREE(Vec, self->attached);
     }
 
+    if (self->index)
+        FREE(ScopeIndex, self->index);
+
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1250,6 +1134,8 @@ __new__EnumSymbol(struct Decl *enum_decl)
     self->variants = NULL;
     self->type_value = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->enum_decl = enum_decl;
     self->visibility = VISIBILITY(enum_decl->value.enum_);
     self->is_error = enum_decl->value.enum_->is_error;
@@ -1266,8 +1152,8 @@ __free__EnumSymbol(struct EnumSymbol *self)
         FREE(Vec, self->variants);
     }
 
-    if (self->type_value)
-        FREE(DataTypeSymbolAll, self->type_value);
+    if (self->index)
+        FREE(ScopeIndex, self->index);
 
     FREE(Scope, self->scope);
     free(self);
@@ -1283,6 +1169,8 @@ __new__EnumObjSymbol(struct Decl *enum_decl)
     self->attached = NULL;
     self->type_value = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->enum_decl = enum_decl;
     self->visibility = VISIBILITY(enum_decl->value.enum_);
     self->is_error = enum_decl->value.enum_->is_error;
@@ -1306,7 +1194,9 @@ __free__EnumObjSymbol(struct EnumObjSymbol *self)
         FREE(Vec, self->attached);
     }
 
-    FREE(DataTypeSymbol, self->type_value);
+    if (self->index)
+        FREE(ScopeIndex, self->index);
+
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1319,6 +1209,7 @@ __new__ErrorSymbol(struct Decl *error_decl)
     self->generic_params = NULL;
     self->data_type = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
     self->error_decl = error_decl;
     self->visibility = VISIBILITY(error_decl->value.error);
     return self;
@@ -1352,9 +1243,6 @@ __free__MethodSymbol(struct MethodSymbol *self)
         FREE(Vec, self->params);
     }
 
-    if (self->return_type)
-        FREE(DataTypeSymbolAll, self->return_type);
-
     if (self->body) {
         for (Usize i = len__Vec(*self->body); i--;)
             FREE(SymbolTableAll, get__Vec(*self->body, i));
@@ -1381,9 +1269,6 @@ __new__PropertySymbol(struct ClassBodyItem *property_decl)
 void
 __free__PropertySymbol(struct PropertySymbol *self)
 {
-    if (self->data_type)
-        FREE(DataTypeSymbolAll, self->data_type);
-
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1398,6 +1283,8 @@ __new__ClassSymbol(struct Decl *class_decl)
     self->impl = NULL;
     self->body = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
+    self->index = NULL;
     self->class_decl = class_decl;
     self->visibility = VISIBILITY(class_decl->value.class);
     return self;
@@ -1406,19 +1293,11 @@ __new__ClassSymbol(struct Decl *class_decl)
 void
 __free__ClassSymbol(struct ClassSymbol *self)
 {
-    if (self->inheritance) {
-        for (Usize i = len__Vec(*self->inheritance); i--;)
-            FREE(DataTypeSymbolAll, get__Vec(*self->inheritance, i));
-
+    if (self->inheritance)
         FREE(Vec, self->inheritance);
-    }
-
-    if (self->impl) {
-        for (Usize i = len__Vec(*self->impl); i--;)
-            FREE(DataTypeSymbolAll, get__Vec(*self->impl, i));
 
+    if (self->impl)
         FREE(Vec, self->impl);
-    }
 
     if (self->body) {
         for (Usize i = len__Vec(*self->body); i--;)
@@ -1427,6 +1306,9 @@ __free__ClassSymbol(struct ClassSymbol *self)
         FREE(Vec, self->body);
     }
 
+    if (self->index)
+        FREE(ScopeIndex, self->index);
+
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1449,11 +1331,7 @@ __new__PrototypeSymbol(struct TraitBodyItem *prototype_decl)
 void
 __free__PrototypeSymbol(struct PrototypeSymbol *self)
 {
-    for (Usize i = len__Vec(*self->params_type); i--;)
-        FREE(DataTypeSymbolAll, get__Vec(*self->params_type, i));
-
     FREE(Vec, self->params_type);
-    FREE(DataTypeSymbolAll, self->return_type);
     FREE(Scope, self->scope);
     free(self);
 }
@@ -1467,6 +1345,7 @@ __new__TraitSymbol(struct Decl *trait_decl)
     self->inh = NULL;
     self->body = NULL;
     self->scope = NULL;
+    self->signature = QueryStateUnchecked;
     self->trait_decl = trait_decl;
     self->visibility = VISIBILITY(trait_decl->value.trait);
     return self;
@@ -1475,12 +1354,8 @@ __new__TraitSymbol(struct Decl *trait_decl)
 void
 __free__TraitSymbol(struct TraitSymbol *self)
 {
-    if (self->inh) {
-        for (Usize i = len__Vec(*self->inh); i--;)
-            FREE(DataTypeSymbolAll, get__Vec(*self->inh, i));
-
+    if (self->inh)
         FREE(Vec, self->inh);
-    }
 
     if (self->body) {
         for (Usize i = len__Vec(*self->body); i--;)
@@ -1493,6 +1368,55 @@ __free__TraitSymbol(struct TraitSymbol *self)
     free(self);
 }
 
+bool
+eq__LiteralSymbol(const struct LiteralSymbol *self,
+                  const struct LiteralSymbol *y)
+{
+    if (self->kind != y->kind)
+        return false;
+
+    switch (self->kind) {
+        case LiteralSymbolKindBool:
+            return self->value.bool_ == y->value.bool_;
+        case LiteralSymbolKindChar:
+            return self->value.char_ == y->value.char_;
+        case LiteralSymbolKindBitChar:
+            return self->value.bit_char == y->value.bit_char;
+        case LiteralSymbolKindInt8:
+            return self->value.int8 == y->value.int8;
+        case LiteralSymbolKindInt16:
+            return self->value.int16 == y->value.int16;
+        case LiteralSymbolKindInt32:
+            return self->value.int32 == y->value.int32;
+        case LiteralSymbolKindInt64:
+            return self->value.int64 == y->value.int64;
+        case LiteralSymbolKindInt128:
+            return self->value.int128 == y->value.int128;
+        case LiteralSymbolKindUint8:
+            return self->value.uint8 == y->value.uint8;
+        case LiteralSymbolKindUint16:
+            return self->value.uint16 == y->value.uint16;
+        case LiteralSymbolKindUint32:
+            return self->value.uint32 == y->value.uint32;
+        case LiteralSymbolKindUint64:
+            return self->value.uint64 == y->value.uint64;
+        case LiteralSymbolKindUint128:
+            return self->value.uint128 == y->value.uint128;
+        case LiteralSymbolKindFloat32:
+            return self->value.float32 == y->value.float32;
+        case LiteralSymbolKindFloat64:
+            return self->value.float64 == y->value.float64;
+        case LiteralSymbolKindStr:
+            return !strcmp(self->value.str, y->value.str);
+        case LiteralSymbolKindBitStr:
+            return self->value.bit_str == y->value.bit_str;
+        case LiteralSymbolKindUnit:
+            return true;
+    }
+
+    return false;
+}
+
 struct UnaryOpSymbol
 __new__UnaryOpSymbol(struct Expr unary_op, struct ExprSymbol *right)
 {
@@ -1562,8 +1486,14 @@ __new__FunCallSymbol(bool is_builtin, struct Scope *id, struct Vec *params)
 void
 __free__FunCallSymbol(struct FunCallSymbol self)
 {
-    TODO("FREE all");
+    for (Usize i = len__Vec(*self.params); i--;) {
+        FREE(ExprSymbolAll,
+             ((struct Tuple *)get__Vec(*self.params, i))->items[0]);
+        FREE(Tuple, get__Vec(*self.params, i));
+    }
+
     FREE(Vec, self.params);
+    FREE(Scope, self.id);
 }
 
 struct SymbolTable *
@@ -1743,6 +1673,16 @@ get_name__SymbolTable(struct SymbolTable *self)
             return self->value.record_obj->name;
         case SymbolTableKindEnumObj:
             return self->value.enum_obj->name;
+        case SymbolTableKindError:
+            return self->value.error->name;
+        case SymbolTableKindVariant:
+            return self->value.variant->name;
+        case SymbolTableKindField:
+            return self->value.field->name;
+        case SymbolTableKindProperty:
+            return self->value.property->name;
+        case SymbolTableKindMethod:
+            return self->value.method->name;
         default:
             return NULL;
     }
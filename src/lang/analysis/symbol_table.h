@@ -25,9 +25,15 @@
 #ifndef LILY_SYMBOL_TABLE_H
 #define LILY_SYMBOL_TABLE_H
 
+#include <lang/analysis/query.h>
 #include <lang/parser/ast.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
+struct ScopeIndex;
+struct Infer;
+struct TypeInterner;
+
 enum ScopeItemKind
 {
     ScopeItemKindVariable,
@@ -44,7 +50,8 @@ enum ScopeItemKind
     ScopeItemKindClass,
     ScopeItemKindModule,
     ScopeItemKindTrait,
-    ScopeItemKindGeneric
+    ScopeItemKindGeneric,
+    ScopeItemKindField
 };
 
 enum ScopeKind
@@ -57,10 +64,13 @@ typedef struct Scope
 {
     Str filename;
     struct String *name; // struct String&
-    Usize id;
+    Usize id;            // slot of a local value in its lexical scope
+    Usize depth;         // depth of the lexical scope of a local value
     enum ScopeItemKind item_kind;
     enum ScopeKind kind;
     struct Scope *previous;
+    struct DataTypeSymbol *data_type; // struct DataTypeSymbol& (data type of a
+                                      // local value or of a field access)
 } ScopdId;
 
 /**
@@ -96,7 +106,7 @@ typedef struct LocalDataType
 {
     struct String *name; // struct String&
     struct Tuple
-      *restricted; // struct Tuple<struct DataTypeSymbol*, struct Location&>*
+      *restricted; // struct Tuple<struct DataTypeSymbol&, struct Location&>*
 } LocalDataType;
 
 /**
@@ -145,6 +155,10 @@ __new__CompilerDefinedDataType(Str name, bool is_args)
     return self;
 }
 
+// The data types are interned by the TypeInterner of the session (see
+// type_interner.h): they are shared and never modified, and they are freed
+// with the TypeInterner, so all the struct DataTypeSymbol* out of the
+// TypeInterner are borrowed.
 typedef struct DataTypeSymbol
 {
     enum DataTypeKind kind;
@@ -157,10 +171,10 @@ typedef struct DataTypeSymbol
         struct DataTypeSymbol *exception;
         struct DataTypeSymbol *mut;
         struct Tuple *lambda; // struct Tuple<struct Vec<struct
-                              // DataTypeSymbol*>*, struct DataTypeSymbol*>*
-        struct Tuple *array;  // struct Tuple<struct DataTypeSymbol*, Usize*>*
-        struct Vec *custom;   // struct Vec<struct DataTypeSymbol*>*
-        struct Vec *tuple;    // struct Vec<struct DataTypeSymbol*>*
+                              // DataTypeSymbol&>*, struct DataTypeSymbol&>*
+        struct Tuple *array;  // struct Tuple<struct DataTypeSymbol&, Usize*>*
+        struct Vec *custom;   // struct Vec<struct DataTypeSymbol&>*
+        struct Vec *tuple;    // struct Vec<struct DataTypeSymbol&>*
         struct CompilerDefinedDataType
           compiler_defined; // struct CompilerDefinedDataType
     } value;
@@ -176,49 +190,55 @@ typedef struct DataTypeSymbol
  * @brief Construct the DataTypeSymbol type.
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbol(enum DataTypeKind kind);
+__new__DataTypeSymbol(struct TypeInterner *types, enum DataTypeKind kind);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Ptr variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolPtr(struct DataTypeSymbol *ptr);
+__new__DataTypeSymbolPtr(struct TypeInterner *types,
+                         struct DataTypeSymbol *ptr);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Ref variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolRef(struct DataTypeSymbol *ref);
+__new__DataTypeSymbolRef(struct TypeInterner *types,
+                         struct DataTypeSymbol *ref);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Optional variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolOptional(struct DataTypeSymbol *optional);
+__new__DataTypeSymbolOptional(struct TypeInterner *types,
+                              struct DataTypeSymbol *optional);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Exception variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolException(struct DataTypeSymbol *exception);
+__new__DataTypeSymbolException(struct TypeInterner *types,
+                               struct DataTypeSymbol *exception);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Mut variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolMut(struct DataTypeSymbol *mut);
+__new__DataTypeSymbolMut(struct TypeInterner *types,
+                         struct DataTypeSymbol *mut);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Lambda variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolLambda(struct Vec *params,
+__new__DataTypeSymbolLambda(struct TypeInterner *types,
+                            struct Vec *params,
                             struct DataTypeSymbol *return_type);
 
 /**
@@ -226,14 +246,17 @@ __new__DataTypeSymbolLambda(struct Vec *params,
  * @brief Construct the DataTypeSymbol type (Array variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolArray(struct DataTypeSymbol *data_type, Usize *size);
+__new__DataTypeSymbolArray(struct TypeInterner *types,
+                           struct DataTypeSymbol *data_type,
+                           Usize *size);
 
 /**
  *
  * @brief Construct the DataTypeSymbol type (Custom variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolCustom(struct Vec *generic_params,
+__new__DataTypeSymbolCustom(struct TypeInterner *types,
+                            struct Vec *generic_params,
                             struct String *custom_name,
                             struct Scope *scope);
 
@@ -242,7 +265,7 @@ __new__DataTypeSymbolCustom(struct Vec *generic_params,
  * @brief Construct the DataTypeSymbol type (Tuple variant).
  */
 struct DataTypeSymbol *
-__new__DataTypeSymbolTuple(struct Vec *tuple);
+__new__DataTypeSymbolTuple(struct TypeInterner *types, struct Vec *tuple);
 
 /**
  *
@@ -250,134 +273,18 @@ __new__DataTypeSymbolTuple(struct Vec *tuple);
  */
 struct DataTypeSymbol *
 __new__DataTypeSymbolCompilerDefined(
+  struct TypeInterner *types,
   struct CompilerDefinedDataType compiler_defined);
 
 /**
  *
- * @brief Copy the DataTypeSymbol type.
- */
-struct DataTypeSymbol *
-copy__DataTypeSymbol(struct DataTypeSymbol *self);
-
-/**
- *
- * @brief Verify if the DataTypeSymbol type are equal.
- */
-bool
-eq__DataTypeSymbol(struct DataTypeSymbol *self, struct DataTypeSymbol *y);
-
-/**
- *
- * @brief Free the DataTypeSymbol type (all variants).
- */
-void
-__free__DataTypeSymbolAll(struct DataTypeSymbol *self);
-
-/**
- *
- * @brief Free the DataTypeSymbol type.
- */
-inline void
-__free__DataTypeSymbol(struct DataTypeSymbol *self)
-{
-    FREE(Scope, self->scope);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Ptr variant).
- */
-inline void
-__free__DataTypeSymbolPtr(struct DataTypeSymbol *self)
-{
-    FREE(DataTypeSymbolAll, self->value.ptr);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Ref variant).
- */
-inline void
-__free__DataTypeSymbolRef(struct DataTypeSymbol *self)
-{
-    FREE(DataTypeSymbolAll, self->value.ref);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Optional variant).
- */
-inline void
-__free__DataTypeSymbolOptional(struct DataTypeSymbol *self)
-{
-    FREE(DataTypeSymbolAll, self->value.optional);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Exception variant).
- */
-inline void
-__free__DataTypeSymbolException(struct DataTypeSymbol *self)
-{
-    FREE(DataTypeSymbolAll, self->value.exception);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Mut variant).
- */
-inline void
-__free__DataTypeSymbolMut(struct DataTypeSymbol *self)
-{
-    FREE(DataTypeSymbolAll, self->value.mut);
-    free(self);
-}
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Lambda variant).
- */
-void
-__free__DataTypeSymbolLambda(struct DataTypeSymbol *self);
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Array variant).
- */
-void
-__free__DataTypeSymbolArray(struct DataTypeSymbol *self);
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Custom variant).
- */
-void
-__free__DataTypeSymbolCustom(struct DataTypeSymbol *self);
-
-/**
- *
- * @brief Free the DataTypeSymbol type (Tuple variant).
+ * @brief Verify if the DataTypeSymbol type are equal (a CompilerDefined data
+ * type is equal to any data type).
  */
-inline void
-__free__DataTypeSymbolTuple(struct DataTypeSymbol *self)
+inline bool
+eq__DataTypeSymbol(struct DataTypeSymbol *self, struct DataTypeSymbol *y)
 {
-    for (Usize i = len__Vec(*self->value.tuple); i--;)
-        FREE(DataTypeSymbolAll, get__Vec(*self->value.tuple, i));
-
-    FREE(Vec, self->value.tuple);
-    free(self);
-}
-
-inline void
-__free__DataTypeSymbolCompilerDefined(struct DataTypeSymbol *self)
-{
-    free(self);
+    return self == y || self->kind == DataTypeKindCompilerDefined;
 }
 
 /**
@@ -397,10 +304,12 @@ __free__GenericSymbolAll(struct Generic *self);
 typedef struct FunParamSymbol
 {
     enum FunParamKind kind;
-    struct Tuple *param_data_type; // struct Tuple<struct DataTypeSymbol*,
+    struct Tuple *param_data_type; // struct Tuple<struct DataTypeSymbol&,
                                    // struct Location&>*
     struct Location loc;
     bool default_defined_data_type;
+    struct Scope *scope; // struct Scope* (the param as a local value)
+    Usize data_type_var; // node of the data type in the Infer of the function
 
     union
     {
@@ -430,16 +339,25 @@ __free__FunParamSymbol(struct FunParamSymbol *self);
 typedef struct FunSymbol
 {
     struct String *name;     // struct String&
-    struct Vec *tagged_type; // struct Vec<struct Tuple<struct DataTypeSymbol*,
+    struct Vec *tagged_type; // struct Vec<struct Tuple<struct DataTypeSymbol&,
                              // struct Location&>*>*
     struct Vec *generic_params; // struct Vec<struct Generic*>&
     struct Vec *params;         // struct Vec<struct FunParamSymbol*>*
     enum Visibility visibility;
     bool is_async;
+    bool is_tailrec; // tagged #tailrec: its recursive calls must be in tail
+                     // position
     struct DataTypeSymbol *return_type;
     struct Vec *body;      // struct Vec<struct SymbolTable*>*
     struct Scope *scope;   // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *fun_decl; // struct Decl&
+    struct Vec *local_data_type; // struct Vec<struct LocalDataType*>* (from
+                                 // the signature until the body is checked)
+    struct Infer *infer;   // struct Infer* (from the signature until the body
+                           // is checked)
+    Usize return_type_var; // node of the return data type in infer
+    _Atomic bool body_checked; // set by the first thread checking the body
 } FunSymbol;
 
 /**
@@ -449,6 +367,14 @@ typedef struct FunSymbol
 struct FunSymbol *
 __new__FunSymbol(struct Decl *fun_decl);
 
+/**
+ *
+ * @brief Free the results of the check of the function and make it point to
+ * fun_decl, so it can be checked again (see recheck__Typecheck).
+ */
+void
+reset__FunSymbol(struct FunSymbol *self, struct Decl *fun_decl);
+
 /**
  *
  * @brief Free the FunSymbol type.
@@ -459,9 +385,11 @@ __free__FunSymbol(struct FunSymbol *self);
 typedef struct ConstantSymbol
 {
     struct String *name;              // struct String&
-    struct DataTypeSymbol *data_type; // struct DataTypeSymbol*
+    struct DataTypeSymbol *data_type; // struct DataTypeSymbol&
     struct ExprSymbol *expr_symbol;
     struct Scope *scope;        // struct Scope&
+    enum QueryState signature; // state of the signature_of query
+    enum QueryState value;     // state of the type_of query of the value
     struct Decl *constant_decl; // struct Decl&
     enum Visibility visibility;
 } ConstantSymbol;
@@ -484,7 +412,10 @@ typedef struct ModuleSymbol
 {
     struct String *name;         // struct String&
     struct Vec *body;            // struct Vec<SymbolTable*>*
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;         // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *module_decl;    // struct Decl&
     struct Location *import_loc; // for `as` module
     enum Visibility visibility;
@@ -510,6 +441,7 @@ typedef struct AliasSymbol
     struct Vec *generic_params; // struct Vec<struct Generic*>&
     struct DataTypeSymbol *data_type;
     struct Scope *scope;     // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *alias_decl; // struct Decl&
     enum Visibility visibility;
 } AliasSymbol;
@@ -556,7 +488,10 @@ typedef struct RecordSymbol
     struct String *name;        // struct String&
     struct Vec *generic_params; // struct Vec<struct Generic*>&
     struct Vec *fields;         // struct Vec<struct SymbolTable*>*
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;        // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *record_decl;   // struct Decl&
     enum Visibility visibility;
 } RecordSymbol;
@@ -581,7 +516,10 @@ typedef struct RecordObjSymbol
     struct Vec *generic_params; // struct Vec<struct Generic*>&
     struct Vec *fields;         // struct Vec<struct SymbolTable*>*
     struct Vec *attached;       // struct Vec<struct SymbolTable*>*
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;        // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *record_decl;   // struct Decl&
     enum Visibility visibility;
 } RecordObjSymbol;
@@ -621,7 +559,6 @@ __new__VariantEnumSymbol(struct VariantEnum *variant_enum);
 inline void
 __free__VariantEnumSymbol(struct VariantEnumSymbol *self)
 {
-    FREE(DataTypeSymbolAll, self->data_type);
     free(self);
 }
 
@@ -631,7 +568,10 @@ typedef struct EnumSymbol
     struct Vec *generic_params; // struct Vec<struct Generic*>&
     struct Vec *variants;       // struct Vec<struct SymbolTable*>*
     struct DataTypeSymbol *type_value;
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;
+    enum QueryState signature; // state of the signature_of query
     struct Decl *enum_decl; // struct Decl&
     enum Visibility visibility;
     bool is_error;
@@ -658,7 +598,10 @@ typedef struct EnumObjSymbol
     struct Vec *variants;       // struct Vec<struct SymbolTable*>*
     struct Vec *attached;       // struct Vec<struct SymbolTable*>*
     struct DataTypeSymbol *type_value;
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;
+    enum QueryState signature; // state of the signature_of query
     struct Decl *enum_decl; // struct Decl&
     enum Visibility visibility;
     bool is_error;
@@ -684,6 +627,7 @@ typedef struct ErrorSymbol
     struct Vec *generic_params; // srtruct Vec<struct Generic*>&
     struct DataTypeSymbol *data_type;
     struct Scope *scope;
+    enum QueryState signature; // state of the signature_of query
     struct Decl *error_decl; // struct Decl&
     enum Visibility visibility;
 } ErrorSymbol;
@@ -702,9 +646,6 @@ __new__ErrorSymbol(struct Decl *error_decl);
 inline void
 __free__ErrorSymbol(struct ErrorSymbol *self)
 {
-    if (self->data_type)
-        FREE(DataTypeSymbolAll, self->data_type);
-
     FREE(Scope, self->scope);
     free(self);
 }
@@ -764,10 +705,13 @@ typedef struct ClassSymbol
 {
     struct String *name;        // struct String&
     struct Vec *generic_params; // struct Vec<struct Generic*>&
-    struct Vec *inheritance;    // struct Vec<struct DataTypeSymbol*>*
-    struct Vec *impl;           // struct Vec<struct DataTypeSymbol*>*
+    struct Vec *inheritance;    // struct Vec<struct DataTypeSymbol&>*
+    struct Vec *impl;           // struct Vec<struct DataTypeSymbol&>*
     struct Vec *body;           // struct Vec<struct SymbolTable*>*
+    struct ScopeIndex *index; // struct ScopeIndex* (built on the first
+                               // search in the scope)
     struct Scope *scope;        // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *class_decl;    // struct Decl&
     enum Visibility visibility;
 } ClassSymbol;
@@ -789,7 +733,7 @@ __free__ClassSymbol(struct ClassSymbol *self);
 typedef struct PrototypeSymbol
 {
     struct String *name;     // struct String&
-    struct Vec *params_type; // struct Vec<struct DataTypeSymbol*>*
+    struct Vec *params_type; // struct Vec<struct DataTypeSymbol&>*
     struct DataTypeSymbol *return_type;
     struct Scope *scope;                  // struct Scope&
     struct TraitBodyItem *prototype_decl; // struct TraitBodyItem&
@@ -815,9 +759,10 @@ typedef struct TraitSymbol
 {
     struct String *name;        // struct String&
     struct Vec *generic_params; // struct Vec<struct Generic*>&
-    struct Vec *inh;            // struct Vec<struct DataTypeSymbol*>*
+    struct Vec *inh;            // struct Vec<struct DataTypeSymbol&>*
     struct Vec *body;           // struct Vec<struct SymbolTable*>*
     struct Scope *scope;        // struct Scope&
+    enum QueryState signature; // state of the signature_of query
     struct Decl *trait_decl;    // struct Decl&
     enum Visibility visibility;
 } TraitSymbol;
@@ -890,12 +835,13 @@ typedef struct LiteralSymbol
  * @brief Construct LiteralSymbol (Bool variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolBool(bool bool_)
+__new__LiteralSymbolBool(struct TypeInterner *types, bool bool_)
 {
-    struct LiteralSymbol self = { .kind = LiteralSymbolKindBool,
-                                  .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindBool),
-                                  .value.bool_ = bool_ };
+    struct LiteralSymbol self = {
+        .kind = LiteralSymbolKindBool,
+        .data_type = NEW(DataTypeSymbol, types, DataTypeKindBool),
+        .value.bool_ = bool_
+    };
 
     return self;
 }
@@ -905,12 +851,13 @@ __new__LiteralSymbolBool(bool bool_)
  * @brief Construct LiteralSymbol (Char variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolChar(char char_)
+__new__LiteralSymbolChar(struct TypeInterner *types, char char_)
 {
-    struct LiteralSymbol self = { .kind = LiteralSymbolKindChar,
-                                  .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindChar),
-                                  .value.char_ = char_ };
+    struct LiteralSymbol self = {
+        .kind = LiteralSymbolKindChar,
+        .data_type = NEW(DataTypeSymbol, types, DataTypeKindChar),
+        .value.char_ = char_
+    };
 
     return self;
 }
@@ -920,11 +867,11 @@ __new__LiteralSymbolChar(char char_)
  * @brief Construct LiteralSymbol (BitChar variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolBitChar(UInt8 bit_char)
+__new__LiteralSymbolBitChar(struct TypeInterner *types, UInt8 bit_char)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindBitChar,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU8),
+                                    NEW(DataTypeSymbol, types, DataTypeKindU8),
                                   .value.bit_char = bit_char };
 
     return self;
@@ -935,11 +882,11 @@ __new__LiteralSymbolBitChar(UInt8 bit_char)
  * @brief Construct LiteralSymbol (Int8 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolInt8(Int8 int8)
+__new__LiteralSymbolInt8(struct TypeInterner *types, Int8 int8)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindInt8,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindI8),
+                                    NEW(DataTypeSymbol, types, DataTypeKindI8),
                                   .value.int8 = int8 };
 
     return self;
@@ -950,11 +897,11 @@ __new__LiteralSymbolInt8(Int8 int8)
  * @brief Construct LiteralSymbol (Int16 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolInt16(Int16 int16)
+__new__LiteralSymbolInt16(struct TypeInterner *types, Int16 int16)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindInt16,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindI16),
+                                    NEW(DataTypeSymbol, types, DataTypeKindI16),
                                   .value.int16 = int16 };
 
     return self;
@@ -965,11 +912,11 @@ __new__LiteralSymbolInt16(Int16 int16)
  * @brief Construct LiteralSymbol (Int32 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolInt32(Int32 int32)
+__new__LiteralSymbolInt32(struct TypeInterner *types, Int32 int32)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindInt32,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindI32),
+                                    NEW(DataTypeSymbol, types, DataTypeKindI32),
                                   .value.int32 = int32 };
 
     return self;
@@ -980,11 +927,11 @@ __new__LiteralSymbolInt32(Int32 int32)
  * @brief Construct LiteralSymbol (Int64 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolInt64(Int64 int64)
+__new__LiteralSymbolInt64(struct TypeInterner *types, Int64 int64)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindInt64,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindI64),
+                                    NEW(DataTypeSymbol, types, DataTypeKindI64),
                                   .value.int64 = int64 };
 
     return self;
@@ -995,12 +942,13 @@ __new__LiteralSymbolInt64(Int64 int64)
  * @brief Construct LiteralSymbol (Int128 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolInt128(Int128 int128)
+__new__LiteralSymbolInt128(struct TypeInterner *types, Int128 int128)
 {
-    struct LiteralSymbol self = { .kind = LiteralSymbolKindInt128,
-                                  .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindI128),
-                                  .value.int128 = int128 };
+    struct LiteralSymbol self = {
+        .kind = LiteralSymbolKindInt128,
+        .data_type = NEW(DataTypeSymbol, types, DataTypeKindI128),
+        .value.int128 = int128
+    };
 
     return self;
 }
@@ -1010,11 +958,11 @@ __new__LiteralSymbolInt128(Int128 int128)
  * @brief Construct LiteralSymbol (Uint8 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUint8(UInt8 uint8)
+__new__LiteralSymbolUint8(struct TypeInterner *types, UInt8 uint8)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindUint8,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU8),
+                                    NEW(DataTypeSymbol, types, DataTypeKindU8),
                                   .value.uint8 = uint8 };
 
     return self;
@@ -1025,11 +973,11 @@ __new__LiteralSymbolUint8(UInt8 uint8)
  * @brief Construct LiteralSymbol (Uint16 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUint16(UInt16 uint16)
+__new__LiteralSymbolUint16(struct TypeInterner *types, UInt16 uint16)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindUint16,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU16),
+                                    NEW(DataTypeSymbol, types, DataTypeKindU16),
                                   .value.uint16 = uint16 };
 
     return self;
@@ -1040,11 +988,11 @@ __new__LiteralSymbolUint16(UInt16 uint16)
  * @brief Construct LiteralSymbol (Uint32 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUint32(UInt32 uint32)
+__new__LiteralSymbolUint32(struct TypeInterner *types, UInt32 uint32)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindUint32,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU32),
+                                    NEW(DataTypeSymbol, types, DataTypeKindU32),
                                   .value.uint32 = uint32 };
 
     return self;
@@ -1055,11 +1003,11 @@ __new__LiteralSymbolUint32(UInt32 uint32)
  * @brief Construct LiteralSymbol (Uint64 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUint64(UInt64 uint64)
+__new__LiteralSymbolUint64(struct TypeInterner *types, UInt64 uint64)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindUint64,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU64),
+                                    NEW(DataTypeSymbol, types, DataTypeKindU64),
                                   .value.uint64 = uint64 };
 
     return self;
@@ -1070,12 +1018,13 @@ __new__LiteralSymbolUint64(UInt64 uint64)
  * @brief Construct LiteralSymbol (Uint128 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUint128(Int128 uint128)
+__new__LiteralSymbolUint128(struct TypeInterner *types, Int128 uint128)
 {
-    struct LiteralSymbol self = { .kind = LiteralSymbolKindUint128,
-                                  .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindU128),
-                                  .value.uint128 = uint128 };
+    struct LiteralSymbol self = {
+        .kind = LiteralSymbolKindUint128,
+        .data_type = NEW(DataTypeSymbol, types, DataTypeKindU128),
+        .value.uint128 = uint128
+    };
 
     return self;
 }
@@ -1085,11 +1034,11 @@ __new__LiteralSymbolUint128(Int128 uint128)
  * @brief Construct LiteralSymbol (Float32 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolFloat32(Float32 float32)
+__new__LiteralSymbolFloat32(struct TypeInterner *types, Float32 float32)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindFloat32,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindF32),
+                                    NEW(DataTypeSymbol, types, DataTypeKindF32),
                                   .value.float32 = float32 };
 
     return self;
@@ -1100,11 +1049,11 @@ __new__LiteralSymbolFloat32(Float32 float32)
  * @brief Construct LiteralSymbol (Float64 variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolFloat64(Float64 float64)
+__new__LiteralSymbolFloat64(struct TypeInterner *types, Float64 float64)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindFloat64,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindF64),
+                                    NEW(DataTypeSymbol, types, DataTypeKindF64),
                                   .value.float64 = float64 };
 
     return self;
@@ -1115,11 +1064,11 @@ __new__LiteralSymbolFloat64(Float64 float64)
  * @brief Construct LiteralSymbol (Str variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolStr(Str str)
+__new__LiteralSymbolStr(struct TypeInterner *types, Str str)
 {
     struct LiteralSymbol self = { .kind = LiteralSymbolKindStr,
                                   .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindStr),
+                                    NEW(DataTypeSymbol, types, DataTypeKindStr),
                                   .value.str = str };
 
     return self;
@@ -1130,12 +1079,14 @@ __new__LiteralSymbolStr(Str str)
  * @brief Construct LiteralSymbol (BitStr variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolBitStr(UInt8 **bit_str)
+__new__LiteralSymbolBitStr(struct TypeInterner *types, UInt8 **bit_str)
 {
     struct LiteralSymbol self = {
         .kind = LiteralSymbolKindBitStr,
-        .data_type =
-          NEW(DataTypeSymbolArray, NEW(DataTypeSymbol, DataTypeKindU8), NULL),
+        .data_type = NEW(DataTypeSymbolArray,
+                         types,
+                         NEW(DataTypeSymbol, types, DataTypeKindU8),
+                         NULL),
         .value.bit_str = bit_str
     };
 
@@ -1147,20 +1098,24 @@ __new__LiteralSymbolBitStr(UInt8 **bit_str)
  * @brief Construct LiteralSymbol (Unit variant).
  */
 [[maybe_unused]] static inline struct LiteralSymbol
-__new__LiteralSymbolUnit()
+__new__LiteralSymbolUnit(struct TypeInterner *types)
 {
-    struct LiteralSymbol self = { .kind = LiteralSymbolKindUnit,
-                                  .data_type =
-                                    NEW(DataTypeSymbol, DataTypeKindUnit) };
+    struct LiteralSymbol self = {
+        .kind = LiteralSymbolKindUnit,
+        .data_type = NEW(DataTypeSymbol, types, DataTypeKindUnit)
+    };
 
     return self;
 }
 
-inline void
-__free__LiteralSymbol(struct LiteralSymbol self)
-{
-    FREE(DataTypeSymbolAll, self.data_type);
-}
+/**
+ *
+ * @return true if the literals have the same kind and the same value (the Str
+ * literals are compared by content).
+ */
+bool
+eq__LiteralSymbol(const struct LiteralSymbol *self,
+                  const struct LiteralSymbol *y);
 
 typedef struct UnaryOpSymbol
 {
@@ -1223,8 +1178,8 @@ typedef struct FunCallSymbol
 {
     bool is_builtin;
     struct Scope *id;
-    struct Vec *params; // struct Vec<struct Tuple<struct SymbolFunParamCall*,
-                        // struct Location&>*>*
+    struct Vec *params; // struct Vec<struct Tuple<struct ExprSymbol*, struct
+                        // Location&>*>*
 } FunCallSymbol;
 
 /**
@@ -1293,18 +1248,56 @@ __new__RecordCallSymbol(struct Scope id, struct Vec *fields)
 void
 __free__RecordCallSymbol(struct RecordCallSymbol self);
 
+// The captures of a lambda are the local values of the enclosing scopes used
+// by its body (or by the body of a nested lambda), they are captured by value.
 typedef struct LambdaSymbol
 {
-    struct Vec *params; // struct Vec<struct FunParam*>* TODO!!
-    struct DataTypeSymbol *return_type;
-    struct Vec *body; // struct Vec<struct SymbolTable*>*
-    Usize id;
+    struct Vec *params; // struct Vec<struct Scope*>* (declared in the lexical
+                        // scope of the lambda)
+    struct DataTypeSymbol *return_type; // struct DataTypeSymbol& (NULL: Unit)
+    struct DataTypeSymbol *data_type;   // struct DataTypeSymbol& (the Lambda
+                                        // data type)
+    struct Vec *body;                   // struct Vec<struct SymbolTable*>*
+    struct Vec *captures; // struct Vec<struct Scope*>* (copies of the scope
+                          // of the captured values)
+    struct Vec *args; // struct Vec<struct ExprSymbol*>* (NULL if the lambda is
+                      // not instantly called)
 } LambdaSymbol;
 
+/**
+ *
+ * @brief Construct the LambdaSymbol type.
+ */
+inline struct LambdaSymbol
+__new__LambdaSymbol(struct Vec *params,
+                    struct DataTypeSymbol *return_type,
+                    struct DataTypeSymbol *data_type,
+                    struct Vec *body,
+                    struct Vec *captures,
+                    struct Vec *args)
+{
+    struct LambdaSymbol self = { .params = params,
+                                 .return_type = return_type,
+                                 .data_type = data_type,
+                                 .body = body,
+                                 .captures = captures,
+                                 .args = args };
+
+    return self;
+}
+
+/**
+ *
+ * @brief Free the LambdaSymbol type.
+ */
+void
+__free__LambdaSymbol(struct LambdaSymbol self);
+
 typedef struct VariantSymbol
 {
-    struct Scope id;
-    struct ExprSymbol *value;
+    struct Scope id; // index of the variant in its enum, previous is the scope
+                     // of the enum (NULL if the variant is unknown)
+    struct ExprSymbol *value; // NULL without value (Color.Red)
 } VariantSymbol;
 
 /**
@@ -1338,8 +1331,9 @@ typedef struct ExprSymbol
         struct BinaryOpSymbol binary_op;
         struct FunCallSymbol fun_call;
         struct RecordCallSymbol record_call;
-        struct Scope *identifier;
-        struct Scope *identifier_access;
+        struct Scope *identifier; // struct Scope* (depth and slot of a local)
+        struct Scope *identifier_access; // struct Scope* (the last field, the
+                                         // previous scopes lead to the value)
         struct Scope *global_access;
         struct Scope *array_access;
         struct Scope *tuple_access;
@@ -1356,7 +1350,7 @@ typedef struct ExprSymbol
         struct LiteralSymbol literal;
         struct VariableSymbol *variable;
         struct Tuple *
-          grouping; // struct Tuple<struct ExprSymbol*, struct DataTypeSymbol*>*
+          grouping; // struct Tuple<struct ExprSymbol*, struct DataTypeSymbol&>*
     } value;
 } ExprSymbol;
 
@@ -1612,6 +1606,9 @@ __free__ExprSymbolRecordCall(struct ExprSymbol *self);
 inline void
 __free__ExprSymbolIdentifier(struct ExprSymbol *self)
 {
+    if (self->value.identifier)
+        FREE(Scope, self->value.identifier);
+
     free(self);
 }
 
@@ -1622,6 +1619,15 @@ __free__ExprSymbolIdentifier(struct ExprSymbol *self)
 inline void
 __free__ExprSymbolIdentifierAccess(struct ExprSymbol *self)
 {
+    struct Scope *scope = self->value.identifier_access;
+
+    while (scope) {
+        struct Scope *previous = scope->previous;
+
+        FREE(Scope, scope);
+        scope = previous;
+    }
+
     free(self);
 }
 
@@ -1744,7 +1750,6 @@ __free__ExprSymbolRef(struct ExprSymbol *self)
 inline void
 __free__ExprSymbolLiteral(struct ExprSymbol *self)
 {
-    FREE(LiteralSymbol, self->value.literal);
     free(self);
 }
 
@@ -1793,7 +1798,6 @@ __new__VariableSymbol(struct VariableDecl decl, struct Location decl_loc)
 inline void
 __free__VariableSymbol(struct VariableSymbol *self)
 {
-    FREE(DataTypeSymbol, self->data_type);
     FREE(ExprSymbolAll, self->expr);
     FREE(Scope, self->scope);
     free(self);
@@ -1803,6 +1807,7 @@ typedef struct MatchSymbol
 {
     struct ExprSymbol *matching;
     struct Vec *pattern; // struct Vec<struct Tuple<struct ExprSymbol*, struct
+                         // ExprSymbol* (guard, NULL if none), struct
                          // Vec<struct SymbolTable*>*>*
 } MatchSymbol;
 
@@ -0,0 +1,420 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <base/tuple.h>
+#include <lang/analysis/type_interner.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TYPE_KEY_MAX_LEN 256
+
+typedef struct TypeKey
+{
+    char *buffer;
+    Usize len;
+    Usize capacity;
+    char inline_buffer[TYPE_KEY_MAX_LEN];
+} TypeKey;
+
+static void
+push_bytes(struct TypeKey *key, const void *bytes, Usize len);
+static void
+push_uint(struct TypeKey *key, Usize value);
+static void
+push_ptr(struct TypeKey *key, const void *ptr);
+static void
+push_types(struct TypeKey *key, const struct Vec *types);
+static void
+push_String(struct TypeKey *key, const struct String *s);
+static inline bool
+has_value(enum DataTypeKind kind);
+static inline bool
+is_generic(const struct DataTypeSymbol *data_type);
+static void
+write_key(struct TypeKey *key, const struct DataTypeSymbol *data_type);
+static struct DataTypeSymbol *
+new_instance(const struct DataTypeSymbol *data_type);
+static void
+free_values(const struct DataTypeSymbol *data_type);
+static void
+free_instance(struct DataTypeSymbol *self);
+static struct DataTypeSymbol *
+insert(struct TypeInterner *self,
+       struct TypeKey *key,
+       struct DataTypeSymbol *data_type);
+
+static void
+push_bytes(struct TypeKey *key, const void *bytes, Usize len)
+{
+    if (key->len + len > key->capacity) {
+        key->capacity = (key->len + len) * 2;
+
+        if (key->buffer == key->inline_buffer) {
+            key->buffer = malloc(key->capacity);
+            memcpy(key->buffer, key->inline_buffer, key->len);
+        } else
+            key->buffer = realloc(key->buffer, key->capacity);
+    }
+
+    memcpy(key->buffer + key->len, bytes, len);
+    key->len += len;
+}
+
+static void
+push_uint(struct TypeKey *key, Usize value)
+{
+    push_bytes(key, &value, sizeof(Usize));
+}
+
+static void
+push_ptr(struct TypeKey *key, const void *ptr)
+{
+    push_uint(key, (Usize)(UPtr)ptr);
+}
+
+// A NULL Vec (e.g. any tuple) and an empty Vec have a different key.
+static void
+push_types(struct TypeKey *key, const struct Vec *types)
+{
+    if (!types) {
+        push_uint(key, (Usize)-1);
+        return;
+    }
+
+    push_uint(key, len__Vec(*types));
+
+    for (Usize i = 0; i < len__Vec(*types); i++)
+        push_ptr(key, get__Vec(*types, i));
+}
+
+static void
+push_String(struct TypeKey *key, const struct String *s)
+{
+    push_uint(key, len__String(*s));
+
+    for (Usize i = 0; i < len__String(*s); i++) {
+        char c = (char)(UPtr)get__String(*s, i);
+
+        push_bytes(key, &c, 1);
+    }
+}
+
+static inline bool
+has_value(enum DataTypeKind kind)
+{
+    switch (kind) {
+        case DataTypeKindPtr:
+        case DataTypeKindRef:
+        case DataTypeKindOptional:
+        case DataTypeKindException:
+        case DataTypeKindMut:
+        case DataTypeKindLambda:
+        case DataTypeKindArray:
+        case DataTypeKindTuple:
+        case DataTypeKindCustom:
+        case DataTypeKindCompilerDefined:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The Scope of a generic param is allocated for each occurrence of the param,
+// so it's identified by its name and its position instead of its address.
+static inline bool
+is_generic(const struct DataTypeSymbol *data_type)
+{
+    return data_type->kind == DataTypeKindCustom && data_type->scope &&
+           data_type->scope->item_kind == ScopeItemKindGeneric;
+}
+
+static void
+write_key(struct TypeKey *key, const struct DataTypeSymbol *data_type)
+{
+    push_uint(key, data_type->kind);
+
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            push_ptr(key, data_type->value.ptr);
+            break;
+        case DataTypeKindRef:
+            push_ptr(key, data_type->value.ref);
+            break;
+        case DataTypeKindOptional:
+            push_ptr(key, data_type->value.optional);
+            break;
+        case DataTypeKindException:
+            push_ptr(key, data_type->value.exception);
+            break;
+        case DataTypeKindMut:
+            push_ptr(key, data_type->value.mut);
+            break;
+        case DataTypeKindLambda:
+            push_types(key, data_type->value.lambda->items[0]);
+            push_ptr(key, data_type->value.lambda->items[1]);
+            break;
+        case DataTypeKindArray: {
+            Usize *size = data_type->value.array->items[1];
+
+            push_ptr(key, data_type->value.array->items[0]);
+            push_uint(key, size ? 1 : 0);
+            push_uint(key, size ? *size : 0);
+            break;
+        }
+        case DataTypeKindTuple:
+            push_types(key, data_type->value.tuple);
+            break;
+        case DataTypeKindCustom:
+            push_types(key, data_type->value.custom);
+            push_uint(key, data_type->custom_name ? 1 : 0);
+
+            if (data_type->custom_name)
+                push_String(key, data_type->custom_name);
+
+            if (is_generic(data_type)) {
+                push_uint(key, strlen(data_type->scope->filename));
+                push_bytes(key,
+                           data_type->scope->filename,
+                           strlen(data_type->scope->filename));
+                push_String(key, data_type->scope->name);
+                push_uint(key, data_type->scope->id);
+            } else
+                push_ptr(key, data_type->scope);
+
+            break;
+        case DataTypeKindCompilerDefined:
+            push_uint(key, data_type->value.compiler_defined.is_args);
+            push_bytes(key,
+                       data_type->value.compiler_defined.name,
+                       strlen(data_type->value.compiler_defined.name));
+            break;
+        default:
+            break;
+    }
+}
+
+// The Tuple of a lambda or of an array is allocated here, the size of an array
+// is copied (it's borrowed from the AST).
+static struct DataTypeSymbol *
+new_instance(const struct DataTypeSymbol *data_type)
+{
+    struct DataTypeSymbol *self = malloc(sizeof(struct DataTypeSymbol));
+
+    memcpy(self, data_type, sizeof(struct DataTypeSymbol));
+
+    switch (data_type->kind) {
+        case DataTypeKindLambda:
+            self->value.lambda = NEW(Tuple,
+                                     2,
+                                     data_type->value.lambda->items[0],
+                                     data_type->value.lambda->items[1]);
+            break;
+        case DataTypeKindArray: {
+            Usize *size = NULL;
+
+            if (data_type->value.array->items[1]) {
+                size = malloc(sizeof(Usize));
+                *size = *(Usize *)data_type->value.array->items[1];
+            }
+
+            self->value.array =
+              NEW(Tuple, 2, data_type->value.array->items[0], size);
+            break;
+        }
+        default:
+            break;
+    }
+
+    return self;
+}
+
+// Free the values owned by a data type which was not inserted (the sub data
+// types are interned, so they are not freed).
+static void
+free_values(const struct DataTypeSymbol *data_type)
+{
+    switch (data_type->kind) {
+        case DataTypeKindLambda:
+            FREE(Vec, data_type->value.lambda->items[0]);
+            break;
+        case DataTypeKindTuple:
+            if (data_type->value.tuple)
+                FREE(Vec, data_type->value.tuple);
+
+            break;
+        case DataTypeKindCustom:
+            if (data_type->value.custom)
+                FREE(Vec, data_type->value.custom);
+
+            if (data_type->custom_name)
+                FREE(String, data_type->custom_name);
+
+            if (is_generic(data_type))
+                FREE(Scope, data_type->scope);
+
+            break;
+        default:
+            break;
+    }
+}
+
+static void
+free_instance(struct DataTypeSymbol *self)
+{
+    free_values(self);
+
+    switch (self->kind) {
+        case DataTypeKindLambda:
+            FREE(Tuple, self->value.lambda);
+            break;
+        case DataTypeKindArray:
+            free(self->value.array->items[1]);
+            FREE(Tuple, self->value.array);
+            break;
+        default:
+            break;
+    }
+
+    free(self);
+}
+
+// The first data type inserted with a key is the interned instance.
+static struct DataTypeSymbol *
+insert(struct TypeInterner *self,
+       struct TypeKey *key,
+       struct DataTypeSymbol *data_type)
+{
+    struct DataTypeSymbol *interned =
+      get_with_len__StrMap(*self->types, key->buffer, key->len);
+
+    if (interned)
+        return interned;
+
+    char *key_copy = malloc(key->len);
+
+    memcpy(key_copy, key->buffer, key->len);
+    push__Vec(self->keys, key_copy);
+    insert_with_len__StrMap(self->types, key_copy, key->len, data_type);
+
+    return data_type;
+}
+
+struct TypeInterner *
+__new__TypeInterner(const struct BuiltinTable *builtins)
+{
+    struct TypeInterner *self = malloc(sizeof(struct TypeInterner));
+
+    self->types = NEW(StrMap);
+    self->keys = NEW(Vec, sizeof(char *));
+    self->owned = NEW(Vec, sizeof(struct DataTypeSymbol));
+    mtx_init(&self->lock, mtx_plain);
+
+    // The sub data types of a builtin data type are always generated before
+    // it, so they are already interned.
+    for (Usize i = 0; builtins && i < builtins->type_count; i++) {
+        struct TypeKey key = { .len = 0, .capacity = TYPE_KEY_MAX_LEN };
+
+        key.buffer = key.inline_buffer;
+        write_key(&key, builtins->types[i]);
+        insert(self, &key, builtins->types[i]);
+
+        if (key.buffer != key.inline_buffer)
+            free(key.buffer);
+    }
+
+    for (Usize i = 0; i <= DataTypeKindCompilerDefined; i++)
+        self->primitives[i] = NULL;
+
+    for (Usize i = 0; i <= DataTypeKindCompilerDefined; i++)
+        if (!has_value(i))
+            self->primitives[i] = intern__TypeInterner(
+              self, &(struct DataTypeSymbol){ .kind = i, .scope = NULL });
+
+    return self;
+}
+
+struct DataTypeSymbol *
+intern__TypeInterner(struct TypeInterner *self,
+                     const struct DataTypeSymbol *data_type)
+{
+    // The primitive data types are only read after the construction, so they
+    // don't need the lock.
+    if (self->primitives[data_type->kind])
+        return self->primitives[data_type->kind];
+
+    struct TypeKey key = { .len = 0, .capacity = TYPE_KEY_MAX_LEN };
+
+    key.buffer = key.inline_buffer;
+    write_key(&key, data_type);
+
+    mtx_lock(&self->lock);
+
+    struct DataTypeSymbol *interned =
+      get_with_len__StrMap(*self->types, key.buffer, key.len);
+    bool is_new = !interned;
+
+    if (is_new) {
+        interned = insert(self, &key, new_instance(data_type));
+        push__Vec(self->owned, interned);
+    }
+
+    mtx_unlock(&self->lock);
+
+    if (!is_new)
+        free_values(data_type);
+
+    if (key.buffer != key.inline_buffer)
+        free(key.buffer);
+
+    return interned;
+}
+
+Usize
+len__TypeInterner(struct TypeInterner *self)
+{
+    mtx_lock(&self->lock);
+
+    Usize len = len__StrMap(*self->types);
+
+    mtx_unlock(&self->lock);
+
+    return len;
+}
+
+void
+__free__TypeInterner(struct TypeInterner *self)
+{
+    for (Usize i = len__Vec(*self->owned); i--;)
+        free_instance(get__Vec(*self->owned, i));
+
+    for (Usize i = len__Vec(*self->keys); i--;)
+        free(get__Vec(*self->keys, i));
+
+    FREE(Vec, self->owned);
+    FREE(Vec, self->keys);
+    FREE(StrMap, self->types);
+    mtx_destroy(&self->lock);
+    free(self);
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_TYPE_INTERNER_H
+#define LILY_TYPE_INTERNER_H
+
+#include <base/str_map.h>
+#include <base/vec.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/builtin/builtin.h>
+#include <threads.h>
+
+// Hash-consing of the data types of a compilation session: each distinct data
+// type exists once, so two data types are equal if and only if they have the
+// same address. A data type is identified by its kind and by the address of
+// its (interned) sub data types, so the key of a data type has a constant
+// size whatever the depth of the data type.
+typedef struct TypeInterner
+{
+    struct StrMap *types; // struct StrMap<struct DataTypeSymbol&>*
+    struct Vec *keys;     // struct Vec<char*>*
+    struct Vec *owned;    // struct Vec<struct DataTypeSymbol*>* (the builtin
+                          // data types are static)
+    struct DataTypeSymbol
+      *primitives[DataTypeKindCompilerDefined + 1]; // struct DataTypeSymbol&
+                                                    // (by kind, NULL if the
+                                                    // kind has a value)
+    mtx_t lock;
+} TypeInterner;
+
+/**
+ *
+ * @brief Construct the TypeInterner type.
+ * @param builtins The data types of the builtins are the interned instances
+ * of their key.
+ */
+struct TypeInterner *
+__new__TypeInterner(const struct BuiltinTable *builtins);
+
+/**
+ *
+ * @return the interned instance equal to data_type.
+ * @param data_type The sub data types must be interned. The TypeInterner takes
+ * the ownership of the values of data_type (Vec, String, Scope of a generic
+ * param): they are kept by the new instance or freed.
+ */
+struct DataTypeSymbol *
+intern__TypeInterner(struct TypeInterner *self,
+                     const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @return the number of distinct data types.
+ */
+Usize
+len__TypeInterner(struct TypeInterner *self);
+
+/**
+ *
+ * @brief Free the TypeInterner type (and all the interned data types).
+ */
+void
+__free__TypeInterner(struct TypeInterner *self);
+
+#endif // LILY_TYPE_INTERNER_H
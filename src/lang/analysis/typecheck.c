@@ -22,44 +22,97 @@
  * SOFTWARE.
  */
 
+#include <base/file.h>
 #include <base/format.h>
 #include <base/macros.h>
 #include <base/platform.h>
+#include <base/str_map.h>
 #include <base/string.h>
+#include <base/thread_pool.h>
 #include <base/types.h>
 #include <base/vec.h>
+#include <lang/analysis/dep_graph.h>
+#include <lang/analysis/duplicate.h>
+#include <lang/analysis/import_dag.h>
+#include <lang/analysis/infer.h>
+#include <lang/analysis/local_scope.h>
+#include <lang/analysis/scope_index.h>
 #include <lang/analysis/symbol_table.h>
+#include <lang/analysis/type_interner.h>
 #include <lang/analysis/typecheck.h>
 #include <lang/builtin/builtin.h>
 #include <lang/builtin/builtin_c.h>
 #include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/sink.h>
 #include <lang/diagnostic/summary.h>
 #include <lang/parser/ast.h>
+#include <lang/parser/cache.h>
 #include <math.h>
+#include <setjmp.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <string.h>
-
-#define SUMMARY()                                                             \
-    if (count_error > 0) {                                                    \
-        emit__Summary(                                                        \
-          count_error, count_warning, "the typecheck phase has been failed"); \
-        exit(1);                                                              \
+#include <threads.h>
+
+// A worker of the parallel check (function bodies or modules of a wave of
+// imports) only stops its task, the diagnostics of all the tasks are printed
+// once they are done (see run_deferred_tasks). Otherwise, the diagnostics of
+// the phase are printed from the sink of the session.
+#define SUMMARY()                                                         \
+    if (deferred_exit) {                                                  \
+        if (deferred_count_error > 0)                                     \
+            longjmp(*deferred_exit, 1);                                   \
+    } else {                                                              \
+        struct DiagnosticSink *sink = global__DiagnosticSink();           \
+                                                                          \
+        flush__DiagnosticSink(sink);                                      \
+                                                                          \
+        if (sink->count_error > 0) {                                      \
+            emit__Summary(sink->count_error,                              \
+                          sink->count_warning,                            \
+                          "the typecheck phase has been failed");         \
+            exit(1);                                                      \
+        }                                                                 \
     }
 
-static Usize pos = 0;
-static Usize count_error = 0;
-static Usize count_warning = 0;
-static Usize count_fun_id = 0;
-static Usize count_const_id = 0;
-static Usize count_module_id = 0;
-static Usize count_alias_id = 0;
-static Usize count_record_id = 0;
-static Usize count_enum_id = 0;
-static Usize count_error_id = 0;
-static Usize count_class_id = 0;
-static Usize count_trait_id = 0;
-static Usize count_record_obj_id = 0;
-static Usize count_enum_obj_id = 0;
+// Per thread: the modules of a wave of imports are typechecked in parallel.
+static thread_local Usize pos = 0;
+
+// Errors of the task run by the current thread with -j N.
+static thread_local Usize deferred_count_error = 0;
+static thread_local jmp_buf *deferred_exit = NULL; // jmp_buf&
+
+// Errors emitted by the current thread, with or without -j N (compared before
+// and after the check of a part of a declaration, e.g. a pattern).
+static thread_local Usize count_error = 0;
+
+// The declaration of the file scope checked by the current thread: the
+// declarations reached by signature_of during its check are recorded as its
+// dependencies in self->deps.
+static thread_local struct Typecheck *dependent_typecheck =
+  NULL; // struct Typecheck&
+static thread_local void *dependent = NULL; // void& (the symbol)
+static thread_local enum DepKind dependent_kind = DepKindSignature;
+
+// The lambda whose body is checked by the current thread: its return
+// statements return from the lambda and the local values of the enclosing
+// scopes used by its body are its captures.
+typedef struct LambdaContext
+{
+    struct LambdaContext *previous; // struct LambdaContext& (the enclosing
+                                    // lambda, NULL in the function)
+    Usize depth;                    // depth of the lexical scope of the params
+    struct Vec *captures;           // struct Vec<struct Scope*>*
+    struct DataTypeSymbol *return_type; // struct DataTypeSymbol& (NULL if it's
+                                        // not known yet)
+} LambdaContext;
+
+static thread_local struct LambdaContext *current_lambda = NULL;
+
+// Protect the indexes of the nested scopes, which are built at the first
+// search in the scope (see search_item_in_scope).
+static mtx_t scope_index_lock;
+static once_flag scope_index_lock_once = ONCE_FLAG_INIT;
 
 const Int128 MaxUInt8 = 0xFF;
 const Int128 MaxUInt16 = 0xFFFF;
@@ -157,19 +210,38 @@ struct SearchContext
     bool search_primary_type;
 } SearchContext;
 
-inline struct Diagnostic *
+// Tasks run on the thread pool, their diagnostics are printed once they are
+// all done.
+typedef struct DeferredTasks
+{
+    ThreadPoolTask run;
+    void *data; // void&
+    atomic_bool failed;
+} DeferredTasks;
+
+// Modules of a wave of imports, loaded in parallel.
+typedef struct ImportWave
+{
+    struct Typecheck *self; // struct Typecheck& (the root module)
+    struct Vec *nodes;      // struct Vec<struct ImportDagNode&>*
+    struct Vec *parsers;    // struct Vec<struct Parser*>& (indexed by the id
+                            // of the nodes, see discover_imports)
+    struct Typecheck **tcs; // struct Typecheck** (loaded by the tasks)
+} ImportWave;
+
+static inline struct Diagnostic *
 __new__DiagnosticWithErrTypecheck(struct Typecheck *self,
                                   struct LilyError *err,
                                   struct Location loc,
                                   struct String *detail_msg,
                                   struct Option *help);
-inline struct Diagnostic *
+static inline struct Diagnostic *
 __new__DiagnosticWithWarnTypecheck(struct Typecheck *self,
                                    struct LilyWarning *warn,
                                    struct Location loc,
                                    struct String *detail_msg,
                                    struct Option *help);
-inline struct Diagnostic *
+static inline struct Diagnostic *
 __new__DiagnosticWithNoteTypecheck(struct Typecheck *self,
                                    struct String *note,
                                    struct Location loc,
@@ -194,10 +266,88 @@ resolve_import_value(struct Typecheck *self,
                      struct SymbolTable *current_symb,
                      bool is_selector,
                      bool is_pub);
+Str
+get_canonical_path(Str path);
+struct String *
+get_import_path(struct ImportStmtValue *value);
+struct Vec *
+discover_imports(struct Typecheck *self, struct ImportDag *dag);
+void
+load_module_task(void *data, Usize task);
+void
+load_imports_in_waves(struct Typecheck *self);
+void
+run_deferred_task(void *data, Usize task);
+void
+run_deferred_tasks(Usize jobs,
+                   Usize task_count,
+                   ThreadPoolTask run,
+                   void *data);
+// Get the path of the file of the import value (the first value of an import)
+// or NULL if the import value isn't a file.
+struct String *
+get_import_path(struct ImportStmtValue *value)
+{
+    switch (value->kind) {
+        case ImportStmtValueKindStd:
+#ifdef LOCAL
+#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
+            return from__String("lib/std/std.lily");
+#elif defined(LILY_WINDOWS_OS)
+            return from__String("lib\\std\\std.lily");
+#else
+#error "unknown OS"
+#endif
+#else
+#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
+            return from__String("");
+#elif defined(LILY_WINDOWS_OS)
+            return from__String("");
+#else
+#error "unknown OS"
+#endif
+#endif
+        case ImportStmtValueKindCore:
+#ifdef LOCAL
+#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
+            return from__String("lib/core/core.lily");
+#elif defined(LILY_WINDOWS_OS)
+            return from__String("lib\\core\\core.lily");
+#else
+#error "unknown OS"
+#endif
+#else
+#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
+            return from__String("");
+#elif defined(LILY_WINDOWS_OS)
+            return from__String("");
+#else
+#error "unknown OS"
+#endif
+#endif
+        case ImportStmtValueKindFile:
+            return format("{S}", value->value.file);
+        case ImportStmtValueKindAccess:
+            return format("{S}.lily", value->value.access);
+        default:
+            return NULL;
+    }
+}
+
 struct Vec *
 resolve_import(struct Typecheck *self,
                struct Location import_loc,
                struct ImportStmt *import_stmt);
+enum DuplicateKind
+get_duplicate_kind_from_decl(struct Decl *decl);
+void
+emit_duplicate_declaration(struct Typecheck *self,
+                           struct Location loc,
+                           struct Location previous_loc);
+void
+verify_if_decls_are_duplicate(struct Typecheck self,
+                              struct Decl **decls,
+                              Usize len);
 void
 verify_if_decl_is_duplicate(struct Typecheck self);
 void
@@ -218,11 +368,33 @@ void
 push_all_symbols(struct Typecheck *self);
 struct Vec *
 get_local_decl(struct Typecheck *self, struct Scope *scope);
+bool
+begin_query(struct Typecheck *self,
+            enum QueryKind kind,
+            enum QueryState *state,
+            struct Decl *decl);
+void
+signature_of(struct Typecheck *self, struct ScopeIndexItem *item);
+void
+check_decl_in_file_scope(struct Typecheck *self,
+                         enum ScopeItemKind kind,
+                         Usize id,
+                         void *symbol);
+struct ScopeIndexItem *
+resolve(struct Typecheck *self, struct String *name);
+Usize
+recheck_funs(struct Typecheck *self);
+bool
+index_decl_names(struct Vec *decls, struct StrMap *names, struct Vec *keys);
+bool
+is_new_fun_name(struct Typecheck *self, struct String *name);
 void
 check_constant(struct Typecheck *self,
                struct ConstantSymbol *constant,
                Usize id,
                struct Scope *previous);
+struct ExprSymbol *
+type_of_constant(struct Typecheck *self, struct ConstantSymbol *constant);
 void
 check_module(struct Typecheck *self,
              struct ModuleSymbol *module,
@@ -273,12 +445,27 @@ check_fun(struct Typecheck *self,
           struct FunSymbol *fun,
           Usize id,
           struct Scope *previous);
+void
+check_fun_signature(struct Typecheck *self,
+                    struct FunSymbol *fun,
+                    Usize id,
+                    struct Scope *previous);
+void
+check_fun_body_once(struct Typecheck *self, struct FunSymbol *fun);
+void
+check_fun_body_task(void *data, Usize task);
+void
+check_fun_bodies(struct Typecheck *self);
 struct SymbolTable *
 get_info_of_decl_from_scope(struct Typecheck *self,
                             struct Scope *scope,
                             struct Location loc);
 void
 check_symbols(struct Typecheck *self);
+void
+emit_diagnostic(struct Diagnostic *diagnostic);
+void
+init_scope_index_lock();
 struct ModuleSymbol *
 entry_in_module(struct Typecheck *self, struct Vec *id, Usize end_idx);
 struct Scope *
@@ -290,6 +477,10 @@ struct Scope *
 search_with_search_module_context(struct Typecheck *self,
                                   struct Vec *name,
                                   struct SearchContext search_module_context);
+struct ScopeIndexItem *
+search_in_file_scope(struct Typecheck *self,
+                     struct String *name,
+                     enum ScopeItemKind kind);
 struct ConstantSymbol *
 search_in_consts_from_name(struct Typecheck *self, struct String *name);
 struct ModuleSymbol *
@@ -312,6 +503,15 @@ struct TraitSymbol *
 search_in_traits_from_name(struct Typecheck *self, struct String *name);
 struct ErrorSymbol *
 search_in_errors_from_name(struct Typecheck *self, struct String *name);
+enum ScopeItemKind
+get_scope_item_kind_from_symbol_table(struct SymbolTable *symb);
+void
+index_symbols_in_scope(struct ScopeIndex *index, struct Vec *symbols);
+struct SymbolTable *
+search_item_in_scope(struct ScopeIndex **index,
+                     struct Vec *symbols,
+                     struct Vec *attached,
+                     struct String *name);
 struct SymbolTable *
 search_module_item_in_scope(struct Typecheck *self,
                             struct Expr *id,
@@ -340,8 +540,13 @@ struct SymbolTable *
 search_in_custom_scope(struct Typecheck *self,
                        struct Expr *id,
                        struct SymbolTable *scope);
-struct Vec *
+struct FunSymbol *
 search_in_funs_from_fun_call(struct Typecheck *self, struct Expr *id);
+struct FieldRecordSymbol *
+search_field_in_data_type(struct Typecheck *self,
+                          struct DataTypeSymbol *data_type,
+                          struct String *name,
+                          Usize *id);
 struct Vec *
 identifier_access_to_String_vec(struct Expr *id);
 struct DataTypeSymbol *
@@ -354,21 +559,25 @@ check_data_type(struct Typecheck *self,
 struct StmtSymbol
 check_stmt(struct Typecheck *self,
            struct Stmt *stmt,
-           struct Vec *local_value,
+           struct LocalScopeChain *local_value,
            bool is_return_type);
 struct DataTypeSymbol *
 get_data_type_of_expression(struct Typecheck *self,
                             struct ExprSymbol *expr,
-                            struct Vec *local_value);
+                            struct LocalScopeChain *local_value);
 const Str
 get_builtin_module_name_from_data_type(struct DataTypeSymbol *dt);
-struct BuiltinFun *
+const struct BuiltinFun *
 search_fun_builtin(struct Typecheck *self,
                    const Str module_name,
                    const Str fun_name,
                    Usize param_count);
+bool
+is_compiler_defined_param(struct DataTypeSymbol *param);
 void
-verify_type_of_fun_builtin(struct BuiltinFun *fun_builtin,
+verify_type_of_fun_builtin(struct Typecheck *self,
+                           struct Location loc,
+                           const struct BuiltinFun *fun_builtin,
                            Usize param_count,
                            ...);
 static inline struct DataTypeSymbol *
@@ -377,83 +586,289 @@ get_return_type_of_fun_builtin(struct Typecheck *self,
                                const Str fun_name,
                                Usize param_count);
 struct Scope *
-search_in_fun_local_value(struct Vec *local_value, struct String *id);
+search_in_fun_local_value(struct LocalScopeChain *local_value,
+                          struct String *id);
 struct Scope *
 search_value_in_function(struct Typecheck *self,
-                         struct Vec *local_value,
+                         struct LocalScopeChain *local_value,
                          struct String *id,
                          struct Vec *id_access);
 struct DataTypeSymbol *
 check_if_defined_data_type_is_equal_to_infered_data_type(
   struct Typecheck *self,
+  struct FunSymbol *fun,
+  struct Location loc,
   struct DataTypeSymbol *defined_data_type,
   struct DataTypeSymbol *infered_data_type);
+struct FunParamSymbol *
+search_param_in_function(struct FunSymbol *fun, struct Scope *scope);
+Usize
+get_infer_node_of_expression(struct FunSymbol *fun, struct ExprSymbol *expr);
+void
+infer_return_type(struct Typecheck *self,
+                  struct FunSymbol *fun,
+                  struct ExprSymbol *expr);
+void
+generalize_fun_signature(struct FunSymbol *fun);
 struct DataTypeSymbol *
 infer_expression(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Expr *expr,
-                 struct Vec *local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type,
                  struct DataTypeSymbol *defined_data_type,
                  bool is_return_type);
 enum DataTypeKind
 get_data_type_kind_from_literal_symbol(enum LiteralSymbolKind kind);
+bool
+is_literal_without_suffix(struct Expr *expr);
+bool
+has_same_data_type_operands(enum BinaryOpKind kind);
+struct DataTypeSymbol *
+get_literal_defined_data_type(struct DataTypeSymbol *data_type);
+bool
+has_operand_data_type(enum BinaryOpKind kind);
+const Str
+get_builtin_module_name_of_binary_op(enum BinaryOpKind kind,
+                                     struct DataTypeSymbol *operand);
+struct DataTypeSymbol *
+get_generic_data_type_of_binary_op(struct Typecheck *self,
+                                   enum BinaryOpKind kind,
+                                   struct DataTypeSymbol *operand);
+bool
+is_generic_param_data_type(struct DataTypeSymbol *data_type);
+struct DataTypeSymbol *
+get_data_type_of_local_value(struct FunSymbol *fun, struct Scope *scope);
+void
+unify_expression(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct ExprSymbol *expr,
+                 struct DataTypeSymbol *data_type);
+void
+emit_unknown_name(struct Typecheck *self,
+                  enum LilyErrorKind kind,
+                  struct Location loc,
+                  struct String *name);
+struct ExprSymbol *
+check_binary_op(struct Typecheck *self,
+                struct FunSymbol *fun,
+                struct Expr *expr,
+                struct LocalScopeChain *local_value,
+                struct Vec *local_data_type,
+                struct DataTypeSymbol *defined_data_type,
+                bool is_return_type);
+bool
+has_inferred_signature(const struct FunSymbol *fun);
+struct DataTypeSymbol *
+get_data_type_of_called_param(struct Typecheck *self,
+                              struct FunSymbol *fun,
+                              struct FunSymbol *callee,
+                              Usize id);
+struct DataTypeSymbol *
+get_return_type_of_called_fun(struct Typecheck *self,
+                              struct FunSymbol *fun,
+                              struct FunSymbol *callee);
+struct ExprSymbol *
+check_fun_call(struct Typecheck *self,
+               struct FunSymbol *fun,
+               struct Expr *expr,
+               struct LocalScopeChain *local_value,
+               struct Vec *local_data_type,
+               struct DataTypeSymbol *defined_data_type);
+struct ExprSymbol *
+check_closure_call(struct Typecheck *self,
+                   struct FunSymbol *fun,
+                   struct Expr *expr,
+                   struct Scope *local,
+                   struct LocalScopeChain *local_value,
+                   struct Vec *local_data_type,
+                   struct DataTypeSymbol *defined_data_type);
+struct ExprSymbol *
+check_record_call(struct Typecheck *self,
+                  struct FunSymbol *fun,
+                  struct Expr *expr,
+                  struct LocalScopeChain *local_value,
+                  struct Vec *local_data_type,
+                  struct DataTypeSymbol *defined_data_type);
+void
+add_capture(struct Scope *scope);
+struct ExprSymbol *
+check_lambda(struct Typecheck *self,
+             struct FunSymbol *fun,
+             struct Expr *expr,
+             struct LocalScopeChain *local_value,
+             struct Vec *local_data_type,
+             struct DataTypeSymbol *defined_data_type);
+struct EnumSymbol *
+get_enum_of_data_type(struct Typecheck *self, struct DataTypeSymbol *data_type);
+Isize
+get_variant_id(struct EnumSymbol *enum_, struct String *name);
+Isize
+search_variant(struct Typecheck *self,
+               struct Expr *id,
+               struct DataTypeSymbol *data_type,
+               struct EnumSymbol **enum_);
+void
+emit_unknown_variant(struct Typecheck *self, struct Expr *id);
+void
+check_variant_value(struct Typecheck *self,
+                    struct Location loc,
+                    struct VariantEnumSymbol *variant,
+                    struct Expr *value);
+struct ExprSymbol *
+new_variant_symbol(struct Typecheck *self,
+                   struct Expr expr,
+                   struct EnumSymbol *enum_,
+                   Isize id,
+                   struct ExprSymbol *value,
+                   struct DataTypeSymbol *data_type);
+struct ExprSymbol *
+check_variant(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Expr *expr,
+              struct Expr *id,
+              struct Expr *value,
+              struct LocalScopeChain *local_value,
+              struct Vec *local_data_type,
+              struct DataTypeSymbol *defined_data_type);
+struct ExprSymbol *
+check_identifier_access(struct Typecheck *self,
+                        struct FunSymbol *fun,
+                        struct Expr *expr,
+                        struct LocalScopeChain *local_value,
+                        struct Vec *local_data_type,
+                        struct DataTypeSymbol *defined_data_type);
 struct ExprSymbol *
 check_expression(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Expr *expr,
-                 struct Vec *local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type,
                  struct DataTypeSymbol *defined_data_type,
                  bool is_return_type);
+struct ExprSymbol *
+check_condition(struct Typecheck *self,
+                struct FunSymbol *fun,
+                struct Expr *cond,
+                struct LocalScopeChain *local_value,
+                struct Vec *local_data_type);
+struct Vec *
+check_block(struct Typecheck *self,
+            struct FunSymbol *fun,
+            struct Vec *items,
+            struct LocalScopeChain *local_value,
+            struct Vec *local_data_type,
+            bool is_tail);
 struct StmtSymbol
 check_await_stmt(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Stmt *stmt,
-                 struct Vec *local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type);
 struct StmtSymbol
 check_return_stmt(struct Typecheck *self,
                   struct FunSymbol *fun,
                   struct Stmt *stmt,
-                  struct Vec *local_value,
+                  struct LocalScopeChain *local_value,
                   struct Vec *local_data_type);
 struct StmtSymbol
 check_for_stmt(struct Typecheck *self,
                struct FunSymbol *fun,
                struct Stmt *stmt,
-               struct Vec local_value,
+               struct LocalScopeChain *local_value,
                struct Vec *local_data_type);
 struct StmtSymbol
 check_if_stmt(struct Typecheck *self,
               struct FunSymbol *fun,
               struct Stmt *stmt,
-              struct Vec local_value,
+              struct LocalScopeChain *local_value,
+              struct Vec *local_data_type,
+              bool is_tail);
+struct DataTypeSymbol *
+get_matching_data_type(struct FunSymbol *fun, struct ExprSymbol *matching);
+void
+unify_pattern(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Location loc,
+              struct ExprSymbol *matching,
+              struct DataTypeSymbol *matching_data_type,
+              struct DataTypeSymbol *data_type);
+struct ExprSymbol *
+check_pattern(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Expr *pattern,
+              struct ExprSymbol *matching,
+              struct DataTypeSymbol *data_type,
+              struct LocalScopeChain *local_value,
               struct Vec *local_data_type);
+struct ExprSymbol *
+get_pattern_constructor(struct ExprSymbol *pattern);
+bool
+is_same_constructor(struct ExprSymbol *x, struct ExprSymbol *y);
+struct ExprSymbol **
+specialize_pattern_row(struct ExprSymbol **row,
+                       Usize len,
+                       struct ExprSymbol *constructor);
+bool
+is_useful_constructor(struct Typecheck *self,
+                      struct ExprSymbol ***rows,
+                      Usize rows_len,
+                      struct ExprSymbol **row,
+                      Usize len,
+                      struct ExprSymbol *constructor);
+bool
+is_useful_pattern(struct Typecheck *self,
+                  struct ExprSymbol ***rows,
+                  Usize rows_len,
+                  struct ExprSymbol **row,
+                  Usize len);
 struct StmtSymbol
 check_match_stmt(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Stmt *stmt,
-                 struct Vec local_value,
-                 struct Vec *local_data_type);
+                 struct LocalScopeChain *local_value,
+                 struct Vec *local_data_type,
+                 bool is_tail);
 struct StmtSymbol
 check_try_stmt(struct Typecheck *self,
                struct FunSymbol *fun,
                struct Stmt *stmt,
-               struct Vec local_value,
+               struct LocalScopeChain *local_value,
                struct Vec *local_data_type);
 struct StmtSymbol
 check_while_stmt(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Stmt *stmt,
-                 struct Vec local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type);
 void
+check_fun_body_item(struct Typecheck *self,
+                    struct FunSymbol *fun,
+                    struct FunBodyItem *item,
+                    struct Vec *body,
+                    struct LocalScopeChain *local_value,
+                    struct Vec *local_data_type,
+                    bool is_tail);
+void
 check_fun_body(struct Typecheck *self,
                struct FunSymbol *fun,
                struct Vec *fun_body,
-               struct Vec *local_value,
+               struct LocalScopeChain *local_value,
                struct Vec *local_data_type);
+bool
+is_tailrec_tag(struct DataType *tag);
+bool
+is_self_call(struct FunSymbol *fun, struct ExprSymbol *expr);
+void
+check_tail_calls_of_expr(struct Typecheck *self,
+                         struct FunSymbol *fun,
+                         struct ExprSymbol *expr,
+                         bool is_tail);
+void
+check_tail_calls(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct Vec *body,
+                 bool is_tail);
 
 struct Typecheck
 __new__Typecheck(struct Parser parser)
@@ -465,6 +880,8 @@ __new__Typecheck(struct Parser parser)
         .decl =
           len__Vec(*parser.decls) == 0 ? NULL : get__Vec(*parser.decls, 0),
         .buffers = NEW(Vec, sizeof(struct Typecheck)),
+        .graph = NULL,
+        .own_graph = false,
         .builtins = Load_C_builtins(),
         .import_values = NEW(Vec, sizeof(struct Tuple)),
         .funs = NULL,
@@ -477,6 +894,13 @@ __new__Typecheck(struct Parser parser)
         .traits = NULL,
         .records_obj = NULL,
         .enums_obj = NULL,
+        .index = NULL,
+        .types = NULL,
+        .queries = NULL,
+        .resolved = NULL,
+        .deps = NULL,
+        .previous_parsers = NULL,
+        .jobs = 1,
     };
 
     return self;
@@ -485,31 +909,280 @@ __new__Typecheck(struct Parser parser)
 void
 run__Typecheck(struct Typecheck *self, struct Vec *primary_buffer)
 {
+    struct ModuleNode *root = NULL;
+
+    // The root module of the session: the module graph starts here.
+    if (!self->graph) {
+        self->graph = NEW(ModuleGraph, self->builtins);
+        self->own_graph = true;
+        root = add__ModuleGraph(
+          self->graph,
+          get_canonical_path(self->parser.parse_block.scanner.src->file.name));
+    }
+
+    self->types = self->graph->types;
+    self->queries = self->graph->queries;
+
+    // With -j N, all the imported modules are loaded before the root module
+    // resolves its imports.
+    if (root && self->jobs > 1)
+        load_imports_in_waves(self);
+
     {
         resolve_global_import(self);
         verify_if_decl_is_duplicate(*self);
         SUMMARY();
     }
 
+    self->deps = NEW(DepGraph);
+
     push_all_symbols(self);
     check_symbols(self);
     SUMMARY();
+
+    check_fun_bodies(self);
+    SUMMARY();
+
+    // pos is shared by all the Typecheck of the session: an imported module is
+    // entirely typechecked before its importer pushes its symbols.
+    pos = 0;
+
+    if (root)
+        loaded__ModuleGraph(self->graph, root, NULL);
 }
 
-void
-__free__Typecheck(struct Typecheck self)
+Usize
+recheck__Typecheck(struct Typecheck *self, struct Parser parser)
+{
+    run__Parser(&parser);
+
+    struct Vec *decls = self->parser.decls;
+    struct Vec *new_decls = parser.decls;
+    Usize len = len__Vec(*decls);
+
+    if (!self->deps) {
+        FREE(Parser, parser);
+
+        return TYPECHECK_RECHECK_ALL;
+    }
+
+    // The declarations are matched by name, so a declaration which is added,
+    // removed or moved doesn't change the others. The declarations without
+    // name (the imports) are matched in order.
+    struct StrMap *names = NEW(StrMap);
+    struct Vec *keys = NEW(Vec, sizeof(Str));
+    struct Decl **matches = calloc(len ? len : 1, sizeof(struct Decl *));
+    struct Vec *added = NEW(Vec, sizeof(struct Decl));
+    bool recheck_all = !index_decl_names(decls, names, keys);
+
+    for (Usize i = 0, unnamed = 0; !recheck_all && i < len__Vec(*new_decls);
+         i++) {
+        struct Decl *new_decl = get__Vec(*new_decls, i);
+        struct String *name = get_name__Decl(new_decl);
+        Usize id = 0; // index of the previous declaration plus one
+
+        if (name) {
+            Str key = to_Str__String(*name);
+
+            id = (Usize)(UPtr)get__StrMap(*names, key);
+
+            // A name which is added twice is found the second time.
+            if (!id) {
+                insert__StrMap(names, key, (void *)(UPtr)(len + 1));
+                push__Vec(keys, key);
+            } else
+                free(key);
+        } else {
+            while (unnamed < len && get_name__Decl(get__Vec(*decls, unnamed)))
+                ++unnamed;
+
+            id = unnamed < len ? ++unnamed : 0;
+        }
+
+        if (!id) {
+            // Only a new function can be checked in place: it's pushed at the
+            // end of the functions of the file, the ids of the other
+            // functions don't change.
+            if (new_decl->kind == DeclKindFun && is_new_fun_name(self, name))
+                push__Vec(added, new_decl);
+            else
+                recheck_all = true;
+        } else if (id > len || matches[id - 1] ||
+                   ((struct Decl *)get__Vec(*decls, id - 1))->kind !=
+                     new_decl->kind)
+            recheck_all = true;
+        else
+            matches[id - 1] = new_decl;
+    }
+
+    // The changes are all known before the first invalidation, so the
+    // Typecheck is untouched when a change cannot be checked in place.
+    enum DepState *changes = malloc((len ? len : 1) * sizeof(enum DepState));
+
+    for (Usize i = 0; !recheck_all && i < len; i++) {
+        struct Decl *decl = get__Vec(*decls, i);
+        struct Decl *new_decl = matches[i];
+
+        changes[i] = DepStateValid;
+
+        // A removed declaration can be used by the checked expressions of the
+        // other declarations.
+        if (!new_decl)
+            recheck_all = true;
+        else if (hash_decl__AstCache(decl, false) ==
+                 hash_decl__AstCache(new_decl, false)) {
+            // The symbols of a moved declaration hold the previous locations,
+            // a moved function is checked again without invalidating its
+            // users.
+            if (hash_decl_with_locations__AstCache(decl) !=
+                hash_decl_with_locations__AstCache(new_decl)) {
+                if (decl->kind == DeclKindFun)
+                    changes[i] = DepStateBody;
+                else
+                    recheck_all = true;
+            }
+        } else if (decl->kind != DeclKindFun)
+            recheck_all = true;
+        else if (hash_decl__AstCache(decl, true) ==
+                 hash_decl__AstCache(new_decl, true))
+            changes[i] = DepStateBody;
+        else
+            changes[i] = DepStateSignature;
+    }
+
+    if (recheck_all) {
+        for (Usize i = len__Vec(*keys); i--;)
+            free(get__Vec(*keys, i));
+
+        FREE(Vec, keys);
+        FREE(StrMap, names);
+        FREE(Vec, added);
+        free(matches);
+        free(changes);
+        FREE(Parser, parser);
+
+        return TYPECHECK_RECHECK_ALL;
+    }
+
+    // The functions are bound to their new declaration, the other symbols are
+    // unchanged and not moved: they still borrow the AST of the previous
+    // parser.
+    for (Usize i = 0; self->funs && i < len__Vec(*self->funs); i++) {
+        struct FunSymbol *fun = get__Vec(*self->funs, i);
+        Str key = to_Str__String(*fun->name);
+        Usize id = (Usize)(UPtr)get__StrMap(*names, key);
+
+        free(key);
+
+        fun->fun_decl = matches[id - 1];
+        fun->name = fun->fun_decl->value.fun->name;
+
+        if (changes[id - 1] != DepStateValid)
+            invalidate__DepGraph(self->deps, fun, changes[id - 1]);
+    }
+
+    for (Usize i = 0; i < len__Vec(*added); i++) {
+        struct FunSymbol *fun = NEW(FunSymbol, get__Vec(*added, i));
+
+        if (!self->funs)
+            self->funs = NEW(Vec, sizeof(struct FunSymbol));
+
+        push__Vec(self->funs, fun);
+        add__ScopeIndex(self->index,
+                        fun->name,
+                        ScopeItemKindFun,
+                        len__Vec(*self->funs) - 1,
+                        fun);
+        invalidate__DepGraph(self->deps, fun, DepStateSignature);
+    }
+
+    for (Usize i = len__Vec(*keys); i--;)
+        free(get__Vec(*keys, i));
+
+    FREE(Vec, keys);
+    FREE(StrMap, names);
+    FREE(Vec, added);
+    free(matches);
+    free(changes);
+
+    // The symbols which are not checked again still borrow the AST of the
+    // previous parser.
+    if (!self->previous_parsers)
+        self->previous_parsers = NEW(Vec, sizeof(struct Parser));
+
+    struct Parser *previous = malloc(sizeof(struct Parser));
+
+    *previous = self->parser;
+    push__Vec(self->previous_parsers, previous);
+
+    self->parser = parser;
+    self->decl =
+      len__Vec(*parser.decls) == 0 ? NULL : get__Vec(*parser.decls, 0);
+
+    Usize count = recheck_funs(self);
+
+    SUMMARY();
+
+    return count;
+}
+
+// Index the named declarations by name (the value is the index of the
+// declaration plus one), the keys are pushed in keys. Return false if a name is
+// declared twice.
+bool
+index_decl_names(struct Vec *decls, struct StrMap *names, struct Vec *keys)
 {
-    for (Usize i = len__Vec(*self.buffers); i--;) {
-        FREE(Typecheck, *(struct Typecheck *)get__Vec(*self.buffers, i));
-        free(get__Vec(*self.buffers, i));
+    for (Usize i = 0; i < len__Vec(*decls); i++) {
+        struct String *name = get_name__Decl(get__Vec(*decls, i));
+
+        if (!name)
+            continue;
+
+        Str key = to_Str__String(*name);
+
+        push__Vec(keys, key);
+
+        if (get__StrMap(*names, key))
+            return false;
+
+        insert__StrMap(names, key, (void *)(UPtr)(i + 1));
     }
 
+    return true;
+}
+
+// No checked expression of the file refers to a new name. A function of the
+// file hides the builtin functions of Io (see check_fun_call).
+bool
+is_new_fun_name(struct Typecheck *self, struct String *name)
+{
+    if (get__ScopeIndex(self->index, name))
+        return false;
+
+    Str name_str = to_Str__String(*name);
+    bool is_builtin = search_fun_builtin(self, "Io", name_str, 3);
+
+    free(name_str);
+
+    return !is_builtin;
+}
+
+void
+__free__Typecheck(struct Typecheck self)
+{
     FREE(Vec, self.buffers);
 
-    for (Usize i = len__Vec(*self.builtins); i--;)
-        FREE(BuiltinAll, get__Vec(*self.builtins, i));
+    if (self.own_graph)
+        FREE(ModuleGraph, self.graph);
+
+    if (self.index)
+        FREE(ScopeIndex, self.index);
 
-    FREE(Vec, self.builtins);
+    if (self.resolved)
+        FREE(ScopeIndex, self.resolved);
+
+    if (self.deps)
+        FREE(DepGraph, self.deps);
 
     for (Usize i = len__Vec(*self.import_values); i--;) {
         if ((int)(UPtr)((struct Tuple *)get__Vec(*self.import_values, i))
@@ -599,16 +1272,29 @@ __free__Typecheck(struct Typecheck self)
     }
 
     FREE(Parser, self.parser);
+
+    if (self.previous_parsers) {
+        for (Usize i = len__Vec(*self.previous_parsers); i--;) {
+            FREE(Parser, *(struct Parser *)get__Vec(*self.previous_parsers, i));
+            free(get__Vec(*self.previous_parsers, i));
+        }
+
+        FREE(Vec, self.previous_parsers);
+    }
 }
 
-inline struct Diagnostic *
+static inline struct Diagnostic *
 __new__DiagnosticWithErrTypecheck(struct Typecheck *self,
                                   struct LilyError *err,
                                   struct Location loc,
                                   struct String *detail_msg,
                                   struct Option *help)
 {
+    if (deferred_exit)
+        deferred_count_error += 1;
+
     count_error += 1;
+
     return NEW(DiagnosticWithErr,
                err,
                loc,
@@ -617,14 +1303,13 @@ __new__DiagnosticWithErrTypecheck(struct Typecheck *self,
                help);
 }
 
-inline struct Diagnostic *
+static inline struct Diagnostic *
 __new__DiagnosticWithWarnTypecheck(struct Typecheck *self,
                                    struct LilyWarning *warn,
                                    struct Location loc,
                                    struct String *detail_msg,
                                    struct Option *help)
 {
-    count_warning += 1;
     return NEW(DiagnosticWithWarn,
                warn,
                loc,
@@ -633,7 +1318,7 @@ __new__DiagnosticWithWarnTypecheck(struct Typecheck *self,
                help);
 }
 
-inline struct Diagnostic *
+static inline struct Diagnostic *
 __new__DiagnosticWithNoteTypecheck(struct Typecheck *self,
                                    struct String *note,
                                    struct Location loc,
@@ -648,55 +1333,268 @@ __new__DiagnosticWithNoteTypecheck(struct Typecheck *self,
                help);
 }
 
+void
+emit_diagnostic(struct Diagnostic *diagnostic)
+{
+    emit__Diagnostic(diagnostic);
+}
+
 void
 resolve_global_import(struct Typecheck *self)
 {
     struct Vec *imports = NEW(Vec, sizeof(struct Decl));
 
-    for (Usize i = len__Vec(*self->parser.decls); i--;)
+    for (Usize i = 0; i < len__Vec(*self->parser.decls); i++)
         if (((struct Decl *)get__Vec(*self->parser.decls, i))->kind ==
             DeclKindImport)
             push__Vec(imports, get__Vec(*self->parser.decls, i));
 
     // Resolve import in priority @core and @std import value
-    for (Usize i = 0; i < len__Vec(*imports); i++) {
-        enum ImportStmtValueKind kind =
-          ((struct ImportStmtValue *)get__Vec(
-             *((struct Decl *)get__Vec(*imports, i))
-                ->value.import->import_value,
-             i))
-            ->kind;
-
-        if (kind == ImportStmtValueKindCore || kind == ImportStmtValueKindStd) {
-            struct Vec *res = resolve_import(
-              self,
-              ((struct Decl *)get__Vec(*imports, i))->loc,
-              ((struct Decl *)get__Vec(*imports, i))->value.import);
+    for (int priority = 1; priority >= 0; priority--) {
+        for (Usize i = 0; i < len__Vec(*imports); i++) {
+            struct Decl *import = get__Vec(*imports, i);
+            enum ImportStmtValueKind kind =
+              ((struct ImportStmtValue *)get__Vec(
+                 *import->value.import->import_value, 0))
+                ->kind;
+
+            if ((kind == ImportStmtValueKindCore ||
+                 kind == ImportStmtValueKindStd) != priority)
+                continue;
+
+            struct Vec *res =
+              resolve_import(self, import->loc, import->value.import);
 
             concat__Vec(self->import_values, res);
-            remove__Vec(imports, i);
 
             if (res)
                 FREE(Vec, res);
+        }
+    }
+
+    FREE(Vec, imports);
+}
 
-            i = 0;
+void
+run_deferred_task(void *data, Usize task)
+{
+    struct DeferredTasks *tasks = data;
+    jmp_buf task_exit;
+    // The task can be run by the thread which has dispatched it. A failed task
+    // leaves the state of the thread where SUMMARY has jumped, so the state is
+    // reset before each task and restored after it.
+    Usize previous_count_error = deferred_count_error;
+    jmp_buf *previous_exit = deferred_exit;
+    Usize previous_pos = pos;
+    struct Typecheck *previous_dependent_typecheck = dependent_typecheck;
+    void *previous_dependent = dependent;
+    enum DepKind previous_dependent_kind = dependent_kind;
+    struct LambdaContext *previous_lambda = current_lambda;
+
+    deferred_count_error = 0;
+    deferred_exit = &task_exit;
+    pos = 0;
+    dependent_typecheck = NULL;
+    dependent = NULL;
+    dependent_kind = DepKindSignature;
+    current_lambda = NULL;
+
+    // SUMMARY jumps here when the task has failed.
+    if (!setjmp(task_exit))
+        tasks->run(tasks->data, task);
+
+    if (deferred_count_error > 0)
+        atomic_store(&tasks->failed, true);
+
+    deferred_count_error = previous_count_error;
+    deferred_exit = previous_exit;
+    pos = previous_pos;
+    dependent_typecheck = previous_dependent_typecheck;
+    dependent = previous_dependent;
+    dependent_kind = previous_dependent_kind;
+    current_lambda = previous_lambda;
+}
+
+void
+run_deferred_tasks(Usize jobs, Usize task_count, ThreadPoolTask run, void *data)
+{
+    struct ThreadPool *pool = NEW(ThreadPool, jobs);
+    struct DeferredTasks tasks = { .run = run, .data = data };
+
+    atomic_init(&tasks.failed, false);
+    run__ThreadPool(pool, task_count, &run_deferred_task, &tasks);
+    FREE(ThreadPool, pool);
+
+    // The tasks dispatched by a task fail it.
+    if (deferred_exit && atomic_load(&tasks.failed))
+        longjmp(*deferred_exit, 1);
+
+    // The diagnostics of all the tasks are printed together, sorted by
+    // location whatever the worker which has run them.
+    SUMMARY();
+}
+
+// Return struct Vec<struct Parser*>*: the Parser of each module, indexed by the
+// id of its node (NULL for the root module). The Parser is loaded from the
+// cache or scanned and split in blocks, so the source of a module is scanned
+// only once: its declarations are parsed by load_module_task.
+struct Vec *
+discover_imports(struct Typecheck *self, struct ImportDag *dag)
+{
+    struct Vec *parsers = NEW(Vec, sizeof(struct Parser));
+
+    push__Vec(parsers, NULL);
+    add__ImportDag(
+      dag,
+      get_canonical_path(self->parser.parse_block.scanner.src->file.name),
+      strdup(self->parser.parse_block.scanner.src->file.name));
+
+    // The modules are added at the end of the DAG, so the loop ends when all
+    // the modules reachable from the root module are scanned.
+    for (Usize i = 0; i < len__Vec(*dag->nodes); i++) {
+        struct ImportDagNode *node = get__Vec(*dag->nodes, i);
+        struct Parser *parser = &self->parser;
+        struct Vec *imports = NULL;
+
+        if (i > 0) {
+            // Like in resolve_import, the Source is freed with the
+            // ModuleGraph.
+            struct Source *src = malloc(sizeof(struct Source));
+
+            *src = NEW(Source, NEW(File, strdup(node->file_name)));
+            parser = malloc(sizeof(struct Parser));
+            *parser = NEW(ParserFromCache, src);
+            push__Vec(parsers, parser);
+        }
+
+        // The root module and a module loaded from the cache are already
+        // parsed. Only the import declarations of the other modules are
+        // parsed.
+        bool own_imports = i > 0 && !parser->strings;
+
+        if (own_imports)
+            imports = get_imports__Parser(parser);
+        else {
+            imports = NEW(Vec, sizeof(struct ImportStmt));
+
+            for (Usize j = 0; j < len__Vec(*parser->decls); j++) {
+                struct Decl *decl = get__Vec(*parser->decls, j);
+
+                if (decl->kind == DeclKindImport)
+                    push__Vec(imports, decl->value.import);
+            }
+        }
+
+        for (Usize j = 0; j < len__Vec(*imports); j++) {
+            struct ImportStmt *import = get__Vec(*imports, j);
+            struct String *path =
+              len__Vec(*import->import_value) > 0
+                ? get_import_path(get__Vec(*import->import_value, 0))
+                : NULL;
+
+            // The other imports are reported when the module is typechecked.
+            if (!path)
+                continue;
+
+            Str path_str = to_Str__String(*path);
+            Str canonical_path = get_canonical_path(path_str);
+            struct ImportDagNode *dep = get__ImportDag(*dag, canonical_path);
+
+            if (dep) {
+                free(canonical_path);
+                free(path_str);
+            } else
+                dep = add__ImportDag(dag, canonical_path, path_str);
+
+            add_dep__ImportDag(node, dep);
+            FREE(String, path);
         }
+
+        if (own_imports)
+            for (Usize j = len__Vec(*imports); j--;)
+                FREE(ImportStmt, get__Vec(*imports, j));
+
+        FREE(Vec, imports);
     }
 
-    for (Usize i = 0; i < len__Vec(*imports); i++) {
-        struct Vec *res =
-          resolve_import(self,
-                         ((struct Decl *)get__Vec(*imports, i))->loc,
-                         ((struct Decl *)get__Vec(*imports, i))->value.import);
+    return parsers;
+}
+
+void
+load_module_task(void *data, Usize task)
+{
+    struct ImportWave *wave = data;
+    struct ImportDagNode *node = get__Vec(*wave->nodes, task);
+    struct Parser *parser = get__Vec(*wave->parsers, node->id);
+    struct Typecheck *tc = malloc(sizeof(struct Typecheck));
+
+    run__ParserWithCache(parser);
+
+    *tc = NEW(Typecheck, *parser);
+    free(parser);
+    tc->graph = wave->self->graph;
 
-        concat__Vec(self->import_values, res);
+    run__Typecheck(tc, wave->self->buffers);
 
-        if (res)
-            FREE(Vec, res);
+    wave->tcs[task] = tc;
+}
+
+void
+load_imports_in_waves(struct Typecheck *self)
+{
+    struct ImportDag *dag = NEW(ImportDag);
+    struct Vec *parsers = discover_imports(self, dag);
+
+    // With a cycle, the modules are loaded one by one by resolve_import, which
+    // reports the cycle.
+    if (!build_waves__ImportDag(dag)) {
+        for (Usize i = 1; i < len__Vec(*parsers); i++) {
+            struct Parser *parser = get__Vec(*parsers, i);
+            struct Source *src = parser->parse_block.scanner.src;
+
+            FREE(Parser, *parser);
+            free(parser);
+            free(src->file.name);
+            free(src);
+        }
+
+        FREE(Vec, parsers);
+        FREE(ImportDag, dag);
+        return;
     }
 
-    if (imports)
-        FREE(Vec, imports);
+    // The root module is alone in the last wave: it imports (directly or not)
+    // all the other modules.
+    for (Usize i = 0; i + 1 < len__Vec(*dag->waves); i++) {
+        struct Vec *nodes = get__Vec(*dag->waves, i);
+        struct ModuleNode **modules =
+          malloc(sizeof(struct ModuleNode *) * len__Vec(*nodes));
+        struct ImportWave wave = {
+            .self = self,
+            .nodes = nodes,
+            .parsers = parsers,
+            .tcs = malloc(sizeof(struct Typecheck *) * len__Vec(*nodes))
+        };
+
+        for (Usize j = 0; j < len__Vec(*nodes); j++)
+            modules[j] = add__ModuleGraph(
+              self->graph,
+              strdup(((struct ImportDagNode *)get__Vec(*nodes, j))->path));
+
+        run_deferred_tasks(
+          self->jobs, len__Vec(*nodes), &load_module_task, &wave);
+
+        // The modules of the wave are on the top of the loading stack.
+        for (Usize j = len__Vec(*nodes); j--;)
+            loaded__ModuleGraph(self->graph, modules[j], wave.tcs[j]);
+
+        free(modules);
+        free(wave.tcs);
+    }
+
+    // The Parsers are moved in the Typecheck of their module.
+    FREE(Vec, parsers);
+    FREE(ImportDag, dag);
 }
 
 void *
@@ -709,66 +1607,68 @@ search_access_from_buffer(struct Typecheck *self,
     if (buffer) {
         struct Decl *decl = NULL;
         void *symb = NULL;
+        struct ScopeIndexItem *item =
+          buffer->index ? get__ScopeIndex(buffer->index, access) : NULL;
 
-        for (Usize i = len__Vec(*buffer->parser.decls); i--;) {
-            if (eq__String(access,
-                           get_name__Decl(get__Vec(*buffer->parser.decls, i)),
-                           false)) {
-                decl = get__Vec(*buffer->parser.decls, i);
-
-                if (decl->kind != DeclKindTag)
-                    break;
-                else
-                    decl = NULL;
-            }
-        }
-
-        if (!decl) {
+        if (!item) {
             assert(0 && "error");
             SUMMARY();
         }
 
-        switch (decl->kind) {
-            case DeclKindFun:
+        switch (item->kind) {
+            case ScopeItemKindFun:
                 symb = search_in_funs_from_name(buffer, access);
+                decl = ((struct FunSymbol *)symb)->fun_decl;
 
                 break;
-            case DeclKindConstant:
+            case ScopeItemKindConstant:
                 symb = search_in_consts_from_name(buffer, access);
+                decl = ((struct ConstantSymbol *)symb)->constant_decl;
 
                 break;
-            case DeclKindModule:
+            case ScopeItemKindModule:
                 symb = search_in_modules_from_name(buffer, access);
+                decl = ((struct ModuleSymbol *)symb)->module_decl;
 
                 break;
-            case DeclKindAlias:
+            case ScopeItemKindAlias:
                 symb = search_in_aliases_from_name(buffer, access);
+                decl = ((struct AliasSymbol *)symb)->alias_decl;
 
                 break;
-            case DeclKindEnum:
-                if (decl->value.enum_->is_object)
-                    symb = search_in_enums_obj_from_name(buffer, access);
-                else
-                    symb = search_in_enums_from_name(buffer, access);
+            case ScopeItemKindEnum:
+                symb = search_in_enums_from_name(buffer, access);
+                decl = ((struct EnumSymbol *)symb)->enum_decl;
 
                 break;
-            case DeclKindRecord:
-                if (decl->value.record->is_object)
-                    symb = search_in_records_obj_from_name(buffer, access);
-                else
-                    symb = search_in_records_from_name(buffer, access);
+            case ScopeItemKindEnumObj:
+                symb = search_in_enums_obj_from_name(buffer, access);
+                decl = ((struct EnumObjSymbol *)symb)->enum_decl;
 
                 break;
-            case DeclKindError:
-                symb = search_in_errors_from_name(buffer, access);
+            case ScopeItemKindRecord:
+                symb = search_in_records_from_name(buffer, access);
+                decl = ((struct RecordSymbol *)symb)->record_decl;
 
                 break;
-            case DeclKindClass:
+            case ScopeItemKindRecordObj:
+                symb = search_in_records_obj_from_name(buffer, access);
+                decl = ((struct RecordObjSymbol *)symb)->record_decl;
+
+                break;
+            case ScopeItemKindError:
+                symb = search_in_errors_from_name(buffer, access);
+                decl = ((struct ErrorSymbol *)symb)->error_decl;
+
+                break;
+            case ScopeItemKindClass:
                 symb = search_in_classes_from_name(buffer, access);
+                decl = ((struct ClassSymbol *)symb)->class_decl;
 
                 break;
-            case DeclKindTrait:
+            case ScopeItemKindTrait:
                 symb = search_in_traits_from_name(buffer, access);
+                decl = ((struct TraitSymbol *)symb)->trait_decl;
 
                 break;
             default:
@@ -787,77 +1687,69 @@ search_access_from_buffer(struct Typecheck *self,
               from__String(""),                                        \
               Some(format("remove the access named: `{S}`", access))); \
                                                                        \
-        emit__Diagnostic(error);                                       \
+        emit_diagnostic(error);                                       \
     }
 
+        struct SymbolTable *item = NULL;
+
         switch (symb->kind) {
             case SymbolTableKindModule:
-                for (Usize i = len__Vec(*symb->value.module->body); i--;) {
-                    if (eq__String(get_name__SymbolTable(
-                                     get__Vec(*symb->value.module->body, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.module->body, i);
-                }
+                item = search_item_in_scope(&symb->value.module->index,
+                                            symb->value.module->body,
+                                            NULL,
+                                            access);
+
+                if (item)
+                    return item;
 
                 ERR_IMPORT_VALUE_ACCESS_IS_NOT_FOUND();
 
                 return NULL;
             case SymbolTableKindEnum:
-                for (Usize i = len__Vec(*symb->value.enum_->variants); i--;) {
-                    if (eq__String(get_name__SymbolTable(
-                                     get__Vec(*symb->value.enum_->variants, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.enum_->variants, i);
-                }
+                item = search_item_in_scope(&symb->value.enum_->index,
+                                            symb->value.enum_->variants,
+                                            NULL,
+                                            access);
+
+                if (item)
+                    return item;
 
                 ERR_IMPORT_VALUE_ACCESS_IS_NOT_FOUND();
 
                 return NULL;
             case SymbolTableKindClass:
-                for (Usize i = len__Vec(*symb->value.class->body); i--;) {
-                    if (eq__String(get_name__SymbolTable(
-                                     get__Vec(*symb->value.class->body, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.class->body, i);
-                }
+                item = search_item_in_scope(&symb->value.class->index,
+                                            symb->value.class->body,
+                                            NULL,
+                                            access);
+
+                if (item)
+                    return item;
 
                 ERR_IMPORT_VALUE_ACCESS_IS_NOT_FOUND();
 
                 return NULL;
             case SymbolTableKindRecordObj:
-                for (Usize i = len__Vec(*symb->value.record_obj->attached);
-                     i--;) {
-                    if (eq__String(get_name__SymbolTable(get__Vec(
-                                     *symb->value.record_obj->attached, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.record_obj->attached, i);
-                }
+                item = search_item_in_scope(&symb->value.record_obj->index,
+                                            symb->value.record_obj->fields,
+                                            symb->value.record_obj->attached,
+                                            access);
+
+                // Only the attached symbols are accessible from an import.
+                if (item && item->kind != SymbolTableKindField)
+                    return item;
 
                 ERR_IMPORT_VALUE_ACCESS_IS_NOT_FOUND();
 
                 return NULL;
             case SymbolTableKindEnumObj:
-                for (Usize i = len__Vec(*symb->value.enum_obj->variants);
-                     i--;) {
-                    if (eq__String(get_name__SymbolTable(get__Vec(
-                                     *symb->value.enum_obj->variants, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.enum_obj->variants, i);
-                }
+                item = search_item_in_scope(&symb->value.enum_obj->index,
+                                            symb->value.enum_obj->variants,
+                                            symb->value.enum_obj->attached,
+                                            access);
 
-                for (Usize i = len__Vec(*symb->value.enum_obj->attached);
-                     i--;) {
-                    if (eq__String(get_name__SymbolTable(get__Vec(
-                                     *symb->value.enum_obj->attached, i)),
-                                   access,
-                                   false))
-                        return get__Vec(*symb->value.enum_obj->attached, i);
-                }
+                if (item)
+                    return item;
 
                 ERR_IMPORT_VALUE_ACCESS_IS_NOT_FOUND();
 
@@ -880,7 +1772,7 @@ search_access_from_buffer(struct Typecheck *self,
                       Some(from__String(
                         "remove the last access of this import value")));
 
-                emit__Diagnostic(error);
+                emit_diagnostic(error);
 
                 return NULL;
             }
@@ -1029,7 +1921,7 @@ resolve_import_value(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("remove the next import values")));
 
-                    emit__Diagnostic(error);
+                    emit_diagnostic(error);
                 }
 
                 if (as_value) {
@@ -1099,6 +1991,19 @@ exit : {
 }
 }
 
+// Return the canonical path of the file, or a copy of path if the file doesn't
+// exist (the error is reported when the file is read).
+Str
+get_canonical_path(Str path)
+{
+    struct Path *p = NEW(Path, path);
+    Str canonical_path = get_canonical__Path(*p);
+
+    FREE(Path, p);
+
+    return canonical_path ? canonical_path : strdup(path);
+}
+
 struct Vec *
 resolve_import(struct Typecheck *self,
                struct Location import_loc,
@@ -1110,73 +2015,11 @@ resolve_import(struct Typecheck *self,
 
     switch (((struct ImportStmtValue *)get__Vec(*import_stmt->import_value, 0))
               ->kind) {
-        case ImportStmtValueKindStd:
-#ifdef LOCAL
-#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
-            path = from__String("lib/std/std.lily");
-            path_str = to_Str__String(*path);
-#elif defined(LILY_WINDOWS_OS)
-            path = from__String("lib\\std\\std.lily");
-            path_str = to_Str__String(*path);
-#else
-#error "unknown OS"
-#endif
-#else
-#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
-            path = from__String("");
-            path_str = to_Str__String(*path);
-#elif defined(LILY_WINDOWS_OS)
-            path = from__String("");
-            path_str = to_Str__String(*path);
-#else
-#error "unknown OS"
-#endif
-#endif
-            break;
-        case ImportStmtValueKindCore:
-#ifdef LOCAL
-#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
-            path = from__String("lib/core/core.lily");
-            path_str = to_Str__String(*path);
-#elif defined(LILY_WINDOWS_OS)
-            path = from__String("lib\\core\\core.lily");
-            path_str = to_Str__String(*path);
-#else
-#error "unknown OS"
-#endif
-#else
-#if defined(LILY_LINUX_OS) || defined(LILY_APPLE_OS) || defined(LILY_BSD_OS)
-            path = from__String("");
-            path_str = to_Str__String(*path);
-#elif defined(LILY_WINDOWS_OS)
-            path = from__String("");
-            path_str = to_Str__String(*path);
-#else
-#error "unknown OS"
-#endif
-#endif
-            break;
         case ImportStmtValueKindBuiltin:
             TODO("@builtin");
-            break;
-        case ImportStmtValueKindFile:
-            path = format("{S}",
-                          ((struct ImportStmtValue *)get__Vec(
-                             *import_stmt->import_value, 0))
-                            ->value.file);
-            path_str = to_Str__String(*path);
-
             break;
         case ImportStmtValueKindUrl:
             TODO("@url");
-        case ImportStmtValueKindAccess:
-            path = format("{S}.lily",
-                          ((struct ImportStmtValue *)get__Vec(
-                             *import_stmt->import_value, 0))
-                            ->value.access);
-            path_str = to_Str__String(*path);
-
-            break;
         case ImportStmtValueKindSelector:
         case ImportStmtValueKindWildcard: {
             struct Diagnostic *error =
@@ -1188,56 +2031,69 @@ resolve_import(struct Typecheck *self,
                   Some(from__String(
                     "selector or wildcard is not expected value in first")));
 
-            emit__Diagnostic(error);
+            emit_diagnostic(error);
 
             goto exit;
         }
+        default:
+            break;
     }
 
-    // This error is fatal
-    if (!strcmp(path_str, self->parser.parse_block.scanner.src->file.name)) {
-        struct Diagnostic *error =
-          NEW(DiagnosticWithErrTypecheck,
-              self,
-              NEW(LilyError, LilyErrorDependencyCycleOnImportValue),
-              import_loc,
-              from__String(""),
-              Some(from__String("remove this import")));
+    path = get_import_path(get__Vec(*import_stmt->import_value, 0));
+    path_str = to_Str__String(*path);
 
-        emit__Diagnostic(error);
-        SUMMARY();
-    }
+    Str canonical_path = get_canonical_path(path_str);
+    struct ModuleNode *node = get__ModuleGraph(*self->graph, canonical_path);
 
-    struct File file = NEW(File, path_str);
-    struct Source src = NEW(Source, file);
-    struct Scanner scanner = NEW(Scanner, &src);
+    if (node) {
+        free(canonical_path);
+        free(path_str);
 
-    run__Scanner(&scanner);
+        // This error is fatal
+        if (node->state == ModuleStateLoading) {
+            struct Diagnostic *error =
+              NEW(DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyError, LilyErrorDependencyCycleOnImportValue),
+                  import_loc,
+                  get_cycle__ModuleGraph(*self->graph, node),
+                  Some(from__String("remove this import")));
 
-    struct ParseBlock parse_block = NEW(ParseBlock, scanner);
+            emit_diagnostic(error);
+            SUMMARY();
+        }
+    } else {
+        node = add__ModuleGraph(self->graph, canonical_path);
 
-    run__ParseBlock(&parse_block);
+        // The Source (and path_str, used as file name) must outlive this
+        // function: the Scanner (and so the Typecheck of the module) keeps a
+        // pointer on it. They are freed with the ModuleGraph.
+        struct Source *src = malloc(sizeof(struct Source));
 
-    struct Parser parser = NEW(Parser, parse_block);
+        *src = NEW(Source, NEW(File, path_str));
 
-    run__Parser(&parser);
+        struct Parser parser = NEW(ParserWithCache, src);
+        struct Typecheck tc = NEW(Typecheck, parser);
 
-    struct Typecheck tc = NEW(Typecheck, parser);
+        tc.graph = self->graph;
+        tc.jobs = self->jobs;
+        run__Typecheck(&tc, self->buffers);
 
-    run__Typecheck(&tc, self->buffers);
+        // The ModuleGraph owns the Typecheck.
+        struct Typecheck *tc_copy = malloc(sizeof(struct Typecheck));
 
-    struct Typecheck *tc_copy = malloc(sizeof(struct Typecheck));
+        memcpy(tc_copy, &tc, sizeof(struct Typecheck));
+        loaded__ModuleGraph(self->graph, node, tc_copy);
+    }
 
-    memcpy(tc_copy, &tc, sizeof(struct Typecheck));
-    push__Vec(self->buffers, tc_copy);
+    if (!includes__Vec(*self->buffers, node->tc))
+        push__Vec(self->buffers, node->tc);
 
     if (path)
         FREE(String, path);
 
-    FREE(Typecheck, tc);
-
     resolve_import_value(self,
-                         tc_copy,
+                         node->tc,
                          import_loc,
                          import_stmt->import_value,
                          import_stmt->as,
@@ -1251,253 +2107,137 @@ exit : {
 }
 }
 
+enum DuplicateKind
+get_duplicate_kind_from_decl(struct Decl *decl)
+{
+    switch (decl->kind) {
+        case DeclKindTag:
+            return DuplicateKindTag;
+        case DeclKindRecord:
+        case DeclKindEnum:
+            return DuplicateKindType;
+        default:
+            return DuplicateKindOther;
+    }
+}
+
 void
-verify_if_decl_is_duplicate(struct Typecheck self)
+emit_duplicate_declaration(struct Typecheck *self,
+                           struct Location loc,
+                           struct Location previous_loc)
 {
-    for (Usize i = 0; i < len__Vec(*self.parser.decls); i++) {
-        if (((struct Decl *)get__Vec(*self.parser.decls, i))->kind !=
-            DeclKindImport) {
-            for (Usize j = i + 1; j < len__Vec(*self.parser.decls); j++) {
-                if (((struct Decl *)get__Vec(*self.parser.decls, j))->kind !=
-                    DeclKindImport) {
-                    if (eq__String(
-                          get_name__Decl(get__Vec(*self.parser.decls, i)),
-                          get_name__Decl(get__Vec(*self.parser.decls, j)),
-                          false)) {
-                        {
-                            struct Decl *di = get__Vec(*self.parser.decls, i);
-                            struct Decl *dj = get__Vec(*self.parser.decls, j);
-
-                            if ((di->kind == DeclKindTag &&
-                                 (dj->kind == DeclKindRecord ||
-                                  dj->kind == DeclKindEnum)) ||
-                                (dj->kind == DeclKindTag &&
-                                 (di->kind == DeclKindRecord ||
-                                  di->kind == DeclKindEnum))) {
-                                goto exit;
-                            } else
-                                goto error;
-                        }
+    struct Diagnostic *error =
+      NEW(DiagnosticWithErrTypecheck,
+          self,
+          NEW(LilyError, LilyErrorDuplicateDeclaration),
+          loc,
+          from__String(""),
+          Some(from__String("remove this declaration or move the "
+                            "declaration in other scope")));
+
+    struct Diagnostic *note =
+      NEW(DiagnosticWithNoteTypecheck,
+          self,
+          format("this declaration is in conflict with a "
+                 "declaration "
+                 "declared at the location ({d}:{d})",
+                 loc.s_line,
+                 loc.s_col),
+          previous_loc,
+          from__String(""),
+          None());
+
+    emit_diagnostic(error);
+    emit_diagnostic(note);
+}
 
-                    error : {
-                        struct Diagnostic *error = NEW(
-                          DiagnosticWithErrTypecheck,
-                          &self,
-                          NEW(LilyError, LilyErrorDuplicateDeclaration),
-                          ((struct Decl *)get__Vec(*self.parser.decls, j))->loc,
-                          from__String(""),
-                          Some(
-                            from__String("remove this declaration or move the "
-                                         "declaration in other scope")));
-
-                        struct Diagnostic *note = NEW(
-                          DiagnosticWithNoteTypecheck,
-                          &self,
-                          format(
-                            "this declaration is in conflict with a "
-                            "declaration "
-                            "declared at the location ({d}:{d})",
-                            ((struct Decl *)get__Vec(*self.parser.decls, j))
-                              ->loc.s_line,
-                            ((struct Decl *)get__Vec(*self.parser.decls, j))
-                              ->loc.s_col),
-                          ((struct Decl *)get__Vec(*self.parser.decls, i))->loc,
-                          from__String(""),
-                          None());
+void
+verify_if_decls_are_duplicate(struct Typecheck self,
+                              struct Decl **decls,
+                              Usize len)
+{
+    struct DuplicateNames *names = NEW(DuplicateNames);
 
-                        emit__Diagnostic(error);
-                        emit__Diagnostic(note);
+    for (Usize i = 0; i < len; i++)
+        push__DuplicateNames(names,
+                             decls[i] ? get_name__Decl(decls[i]) : NULL,
+                             decls[i] ? get_duplicate_kind_from_decl(decls[i])
+                                      : DuplicateKindOther);
 
-                        break;
-                    }
-                    }
+    Usize *conflicts = get_conflicts__DuplicateNames(names);
 
-                exit : {
-                }
-                }
-            }
-        }
+    for (Usize i = 0; i < len; i++) {
+        if (!decls[i])
+            continue;
 
-        switch (((struct Decl *)get__Vec(*self.parser.decls, i))->kind) {
-            case DeclKindModule:
-                verify_if_decl_is_duplicate_in_module(
-                  self, get__Vec(*self.parser.decls, i));
+        if (conflicts[i] != DUPLICATE_NONE)
+            emit_duplicate_declaration(
+              &self, decls[conflicts[i]]->loc, decls[i]->loc);
 
+        switch (decls[i]->kind) {
+            case DeclKindModule:
+                verify_if_decl_is_duplicate_in_module(self, decls[i]);
                 break;
             case DeclKindEnum:
-                verify_if_decl_is_duplicate_in_enum(
-                  self, get__Vec(*self.parser.decls, i));
-
+                verify_if_decl_is_duplicate_in_enum(self, decls[i]);
                 break;
             case DeclKindRecord:
-                verify_if_decl_is_duplicate_in_record(
-                  self, get__Vec(*self.parser.decls, i));
-
+                verify_if_decl_is_duplicate_in_record(self, decls[i]);
                 break;
             case DeclKindClass:
-                verify_if_decl_is_duplicate_in_class(
-                  self, get__Vec(*self.parser.decls, i));
-
+                verify_if_decl_is_duplicate_in_class(self, decls[i]);
                 break;
             case DeclKindTag:
-                verify_if_decl_is_duplicate_in_tag(
-                  self, get__Vec(*self.parser.decls, i));
-
+                verify_if_decl_is_duplicate_in_tag(self, decls[i]);
                 break;
             case DeclKindTrait:
-                verify_if_decl_is_duplicate_in_trait(
-                  self, get__Vec(*self.parser.decls, i));
-
+                verify_if_decl_is_duplicate_in_trait(self, decls[i]);
                 break;
             default:
                 break;
         }
     }
+
+    free(conflicts);
+    FREE(DuplicateNames, names);
 }
 
 void
-verify_if_decl_is_duplicate_in_module(struct Typecheck self,
-                                      struct Decl *module)
+verify_if_decl_is_duplicate(struct Typecheck self)
 {
-    if (module->value.module->body) {
-        for (Usize i = 0; i < len__Vec(*module->value.module->body); i++) {
-            if (((struct ModuleBodyItem *)get__Vec(*module->value.module->body,
-                                                   i))
-                  ->kind == ModuleBodyItemKindDecl) {
-                for (Usize j = i + 1; j < len__Vec(*module->value.module->body);
-                     j++) {
-                    if (((struct ModuleBodyItem *)get__Vec(
-                           *module->value.module->body, j))
-                          ->kind == ModuleBodyItemKindDecl) {
-                        if (eq__String(
-                              get_name__Decl(((struct ModuleBodyItem *)get__Vec(
-                                                *module->value.module->body, i))
-                                               ->value.decl),
-                              get_name__Decl(((struct ModuleBodyItem *)get__Vec(
-                                                *module->value.module->body, j))
-                                               ->value.decl),
-                              false)) {
-                            {
-                                struct Decl *di =
-                                  ((struct ModuleBodyItem *)get__Vec(
-                                     *module->value.module->body, i))
-                                    ->value.decl;
-                                struct Decl *dj =
-                                  ((struct ModuleBodyItem *)get__Vec(
-                                     *module->value.module->body, j))
-                                    ->value.decl;
-
-                                if ((di->kind == DeclKindTag &&
-                                     (dj->kind == DeclKindRecord ||
-                                      dj->kind == DeclKindEnum)) ||
-                                    (dj->kind == DeclKindTag &&
-                                     (di->kind == DeclKindRecord ||
-                                      di->kind == DeclKindEnum))) {
-                                    goto exit;
-                                } else
-                                    goto error;
-                            }
-
-                        error : {
-                            struct Diagnostic *error =
-                              NEW(DiagnosticWithErrTypecheck,
-                                  &self,
-                                  NEW(LilyError, LilyErrorDuplicateDeclaration),
-                                  ((struct ModuleBodyItem *)get__Vec(
-                                     *module->value.module->body, j))
-                                    ->value.decl->loc,
-                                  from__String(""),
-                                  Some(from__String(
-                                    "remove this declaration or move the "
-                                    "declaration in other scope")));
-
-                            struct Diagnostic *note = NEW(
-                              DiagnosticWithNoteTypecheck,
-                              &self,
-                              format("this declaration is in conflict with a "
-                                     "declaration "
-                                     "declared at the location ({d}:{d})",
-                                     ((struct ModuleBodyItem *)get__Vec(
-                                        *module->value.module->body, j))
-                                       ->value.decl->loc.s_line,
-                                     ((struct ModuleBodyItem *)get__Vec(
-                                        *module->value.module->body, j))
-                                       ->value.decl->loc.s_col),
-                              ((struct ModuleBodyItem *)get__Vec(
-                                 *module->value.module->body, i))
-                                ->value.decl->loc,
-                              from__String(""),
-                              None());
-
-                            emit__Diagnostic(error);
-                            emit__Diagnostic(note);
+    Usize len = len__Vec(*self.parser.decls);
+    struct Decl **decls = malloc((len ? len : 1) * sizeof(struct Decl *));
 
-                            break;
-                        }
+    for (Usize i = 0; i < len; i++) {
+        struct Decl *decl = get__Vec(*self.parser.decls, i);
 
-                        exit : {
-                        }
-                        }
-                    }
-                }
+        decls[i] = decl->kind != DeclKindImport ? decl : NULL;
+    }
 
-                switch (((struct Decl *)((struct ModuleBodyItem *)get__Vec(
-                                           *module->value.module->body, i))
-                           ->value.decl)
-                          ->kind) {
-                    case DeclKindModule:
-                        verify_if_decl_is_duplicate_in_module(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+    verify_if_decls_are_duplicate(self, decls, len);
 
-                        break;
-                    case DeclKindEnum:
-                        verify_if_decl_is_duplicate_in_enum(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+    free(decls);
+}
 
-                        break;
-                    case DeclKindRecord:
-                        verify_if_decl_is_duplicate_in_record(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+void
+verify_if_decl_is_duplicate_in_module(struct Typecheck self,
+                                      struct Decl *module)
+{
+    if (module->value.module->body) {
+        Usize len = len__Vec(*module->value.module->body);
+        struct Decl **decls = malloc((len ? len : 1) * sizeof(struct Decl *));
 
-                        break;
-                    case DeclKindClass:
-                        verify_if_decl_is_duplicate_in_class(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+        for (Usize i = 0; i < len; i++) {
+            struct ModuleBodyItem *item =
+              get__Vec(*module->value.module->body, i);
 
-                        break;
-                    case DeclKindTag:
-                        verify_if_decl_is_duplicate_in_tag(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+            decls[i] =
+              item->kind == ModuleBodyItemKindDecl ? item->value.decl : NULL;
+        }
 
-                        break;
-                    case DeclKindTrait:
-                        verify_if_decl_is_duplicate_in_trait(
-                          self,
-                          ((struct ModuleBodyItem *)get__Vec(
-                             *module->value.module->body, i))
-                            ->value.decl);
+        verify_if_decls_are_duplicate(self, decls, len);
 
-                        break;
-                    default:
-                        break;
-                }
-            }
-        }
+        free(decls);
     }
 }
 
@@ -1505,32 +2245,35 @@ void
 verify_if_decl_is_duplicate_in_enum(struct Typecheck self, struct Decl *enum_)
 {
     if (enum_->value.enum_->variants) {
-        for (Usize i = 0; i < len__Vec(*enum_->value.enum_->variants); i++) {
-            for (Usize j = i + 1; j < len__Vec(*enum_->value.enum_->variants);
-                 j++) {
-                if (eq__String(((struct VariantEnum *)get__Vec(
-                                  *enum_->value.enum_->variants, i))
-                                 ->name,
-                               ((struct VariantEnum *)get__Vec(
-                                  *enum_->value.enum_->variants, j))
-                                 ->name,
-                               false)) {
-                    struct Diagnostic *error =
-                      NEW(DiagnosticWithErrTypecheck,
-                          &self,
-                          NEW(LilyError, LilyErrorDuplicateVariant),
-                          ((struct VariantEnum *)get__Vec(
-                             *enum_->value.enum_->variants, j))
-                            ->loc,
-                          from__String(""),
-                          Some(from__String("remove this variant")));
+        struct DuplicateNames *names = NEW(DuplicateNames);
 
-                    emit__Diagnostic(error);
+        for (Usize i = 0; i < len__Vec(*enum_->value.enum_->variants); i++)
+            push__DuplicateNames(
+              names,
+              ((struct VariantEnum *)get__Vec(*enum_->value.enum_->variants, i))
+                ->name,
+              DuplicateKindOther);
 
-                    break;
-                }
+        Usize *conflicts = get_conflicts__DuplicateNames(names);
+
+        for (Usize i = 0; i < names->len; i++) {
+            if (conflicts[i] != DUPLICATE_NONE) {
+                struct Diagnostic *error =
+                  NEW(DiagnosticWithErrTypecheck,
+                      &self,
+                      NEW(LilyError, LilyErrorDuplicateVariant),
+                      ((struct VariantEnum *)get__Vec(
+                         *enum_->value.enum_->variants, conflicts[i]))
+                        ->loc,
+                      from__String(""),
+                      Some(from__String("remove this variant")));
+
+                emit_diagnostic(error);
             }
         }
+
+        free(conflicts);
+        FREE(DuplicateNames, names);
     }
 }
 
@@ -1539,32 +2282,35 @@ verify_if_decl_is_duplicate_in_record(struct Typecheck self,
                                       struct Decl *record)
 {
     if (record->value.record->fields) {
-        for (Usize i = 0; i < len__Vec(*record->value.record->fields); i++) {
-            for (Usize j = i + 1; j < len__Vec(*record->value.record->fields);
-                 j++) {
-                if (eq__String(((struct FieldRecord *)get__Vec(
-                                  *record->value.record->fields, i))
-                                 ->name,
-                               ((struct FieldRecord *)get__Vec(
-                                  *record->value.record->fields, j))
-                                 ->name,
-                               false)) {
-                    struct Diagnostic *error =
-                      NEW(DiagnosticWithErrTypecheck,
-                          &self,
-                          NEW(LilyError, LilyErrorDuplicateField),
-                          ((struct FieldRecord *)get__Vec(
-                             *record->value.record->fields, j))
-                            ->loc,
-                          from__String(""),
-                          Some(from__String("remove this field")));
+        struct DuplicateNames *names = NEW(DuplicateNames);
 
-                    emit__Diagnostic(error);
+        for (Usize i = 0; i < len__Vec(*record->value.record->fields); i++)
+            push__DuplicateNames(
+              names,
+              ((struct FieldRecord *)get__Vec(*record->value.record->fields, i))
+                ->name,
+              DuplicateKindOther);
 
-                    break;
-                }
+        Usize *conflicts = get_conflicts__DuplicateNames(names);
+
+        for (Usize i = 0; i < names->len; i++) {
+            if (conflicts[i] != DUPLICATE_NONE) {
+                struct Diagnostic *error =
+                  NEW(DiagnosticWithErrTypecheck,
+                      &self,
+                      NEW(LilyError, LilyErrorDuplicateField),
+                      ((struct FieldRecord *)get__Vec(
+                         *record->value.record->fields, conflicts[i]))
+                        ->loc,
+                      from__String(""),
+                      Some(from__String("remove this field")));
+
+                emit_diagnostic(error);
             }
         }
+
+        free(conflicts);
+        FREE(DuplicateNames, names);
     }
 }
 
@@ -1572,58 +2318,33 @@ void
 verify_if_decl_is_duplicate_in_class(struct Typecheck self, struct Decl *class)
 {
     if (class->value.class->body) {
-        for (Usize i = 0; i < len__Vec(*class->value.class->body); i++) {
-            if (((struct ClassBodyItem *)get__Vec(*class->value.class->body, i))
-                  ->kind != ClassBodyItemKindImport) {
-                for (Usize j = i + 1; j < len__Vec(*class->value.class->body);
-                     j++) {
-                    if (((struct ClassBodyItem *)get__Vec(
-                           *class->value.class->body, j))
-                          ->kind != ClassBodyItemKindImport) {
-                        if (eq__String(get_name__ClassBodyItem(get__Vec(
-                                         *class->value.class->body, i)),
-                                       get_name__ClassBodyItem(get__Vec(
-                                         *class->value.class->body, j)),
-                                       false)) {
-                            struct Diagnostic *error =
-                              NEW(DiagnosticWithErrTypecheck,
-                                  &self,
-                                  NEW(LilyError, LilyErrorDuplicateDeclaration),
-                                  ((struct ClassBodyItem *)get__Vec(
-                                     *class->value.class->body, j))
-                                    ->loc,
-                                  from__String(""),
-                                  Some(from__String(
-                                    "remove this declaration or move the "
-                                    "declaration in other scope")));
-
-                            struct Diagnostic *note = NEW(
-                              DiagnosticWithNoteTypecheck,
-                              &self,
-                              format("this declaration is in conflict with a "
-                                     "declaration "
-                                     "declared at the location ({d}:{d})",
-                                     ((struct ClassBodyItem *)get__Vec(
-                                        *class->value.class->body, j))
-                                       ->loc.s_line,
-                                     ((struct ClassBodyItem *)get__Vec(
-                                        *class->value.class->body, j))
-                                       ->loc.s_col),
-                              ((struct ClassBodyItem *)get__Vec(
-                                 *class->value.class->body, i))
-                                ->loc,
-                              from__String(""),
-                              None());
+        struct DuplicateNames *names = NEW(DuplicateNames);
 
-                            emit__Diagnostic(error);
-                            emit__Diagnostic(note);
+        for (Usize i = 0; i < len__Vec(*class->value.class->body); i++) {
+            struct ClassBodyItem *item = get__Vec(*class->value.class->body, i);
 
-                            break;
-                        }
-                    }
-                }
-            }
+            push__DuplicateNames(names,
+                                 item->kind != ClassBodyItemKindImport
+                                   ? get_name__ClassBodyItem(item)
+                                   : NULL,
+                                 DuplicateKindOther);
         }
+
+        Usize *conflicts = get_conflicts__DuplicateNames(names);
+
+        for (Usize i = 0; i < names->len; i++)
+            if (conflicts[i] != DUPLICATE_NONE)
+                emit_duplicate_declaration(
+                  &self,
+                  ((struct ClassBodyItem *)get__Vec(*class->value.class->body,
+                                                    conflicts[i]))
+                    ->loc,
+                  ((struct ClassBodyItem *)get__Vec(*class->value.class->body,
+                                                    i))
+                    ->loc);
+
+        free(conflicts);
+        FREE(DuplicateNames, names);
     }
 }
 
@@ -1647,6 +2368,16 @@ verify_if_decl_is_duplicate_in_trait(struct Typecheck self, struct Decl *trait)
                    ? ((struct Decl *)get__Vec(*self->parser.decls, pos)) \
                    : NULL
 
+// Add the last pushed symbol in the index of the file scope.
+#define INDEX_SYMBOL(type, symbols, kind)                                    \
+    add__ScopeIndex(self->index,                                             \
+                    ((struct type *)get__Vec(*self->symbols,                 \
+                                             len__Vec(*self->symbols) - 1))  \
+                      ->name,                                                \
+                    kind,                                                    \
+                    len__Vec(*self->symbols) - 1,                            \
+                    get__Vec(*self->symbols, len__Vec(*self->symbols) - 1))
+
 #define ALLOC_FUNS() \
     if (!self->funs) \
     self->funs = NEW(Vec, sizeof(struct FunSymbol))
@@ -1694,59 +2425,76 @@ verify_if_decl_is_duplicate_in_trait(struct Typecheck self, struct Decl *trait)
 void
 push_all_symbols(struct Typecheck *self)
 {
+    self->index = NEW(ScopeIndex);
+    self->resolved = NEW(ScopeIndex);
+
     while (pos < len__Vec(*self->parser.decls)) {
         switch (self->decl->kind) {
             case DeclKindFun:
                 ALLOC_FUNS();
                 push__Vec(self->funs, NEW(FunSymbol, self->decl));
+                INDEX_SYMBOL(FunSymbol, funs, ScopeItemKindFun);
                 break;
             case DeclKindConstant:
                 ALLOC_CONSTS();
                 push__Vec(self->consts, NEW(ConstantSymbol, self->decl));
+                INDEX_SYMBOL(ConstantSymbol, consts, ScopeItemKindConstant);
                 break;
             case DeclKindModule:
                 ALLOC_MODULES();
                 push__Vec(self->modules, NEW(ModuleSymbol, self->decl));
+                INDEX_SYMBOL(ModuleSymbol, modules, ScopeItemKindModule);
                 break;
             case DeclKindAlias:
                 ALLOC_ALIASES();
                 push__Vec(self->aliases, NEW(AliasSymbol, self->decl));
+                INDEX_SYMBOL(AliasSymbol, aliases, ScopeItemKindAlias);
                 break;
             case DeclKindRecord:
                 if (self->decl->value.record->is_object) {
                     ALLOC_RECORDS_OBJ();
                     push__Vec(self->records_obj,
                               NEW(RecordObjSymbol, self->decl));
+                    INDEX_SYMBOL(RecordObjSymbol,
+                                 records_obj,
+                                 ScopeItemKindRecordObj);
                 } else {
                     ALLOC_RECORDS();
                     push__Vec(self->records, NEW(RecordSymbol, self->decl));
+                    INDEX_SYMBOL(RecordSymbol, records, ScopeItemKindRecord);
                 }
                 break;
             case DeclKindEnum:
                 if (self->decl->value.enum_->is_object) {
                     ALLOC_ENUMS_OBJ();
                     push__Vec(self->enums_obj, NEW(EnumObjSymbol, self->decl));
+                    INDEX_SYMBOL(
+                      EnumObjSymbol, enums_obj, ScopeItemKindEnumObj);
                 } else {
                     ALLOC_ENUMS();
                     push__Vec(self->enums, NEW(EnumSymbol, self->decl));
+                    INDEX_SYMBOL(EnumSymbol, enums, ScopeItemKindEnum);
                 }
                 break;
             case DeclKindError:
                 ALLOC_ERRORS();
                 push__Vec(self->errors, NEW(ErrorSymbol, self->decl));
+                INDEX_SYMBOL(ErrorSymbol, errors, ScopeItemKindError);
                 break;
             case DeclKindClass:
                 ALLOC_CLASSES();
                 push__Vec(self->classes, NEW(ClassSymbol, self->decl));
+                INDEX_SYMBOL(ClassSymbol, classes, ScopeItemKindClass);
                 break;
             case DeclKindTrait:
                 ALLOC_TRAITS();
                 push__Vec(self->traits, NEW(TraitSymbol, self->decl));
+                INDEX_SYMBOL(TraitSymbol, traits, ScopeItemKindTrait);
                 break;
             case DeclKindTag:
                 break;
             case DeclKindImport:
-                TODO("import");
+                // The imports are already resolved by resolve_global_import.
                 break;
             default:
                 UNREACHABLE("unknown decl kind");
@@ -1779,49 +2527,215 @@ get_local_decl(struct Typecheck *self, struct Scope *scope)
     return local;
 }
 
-void
-check_constant(struct Typecheck *self,
-               struct ConstantSymbol *constant,
-               Usize id,
-               struct Scope *previous)
+// Start the query and return true if the caller must evaluate it. A query
+// reached again during its own evaluation is a cycle: it's an error when decl
+// is passed (e.g. the value of a constant which depends on itself), otherwise
+// the symbol is used as is (recursive data types, recursive functions).
+bool
+begin_query(struct Typecheck *self,
+            enum QueryKind kind,
+            enum QueryState *state,
+            struct Decl *decl)
 {
-    if (!constant->scope) {
-        constant->scope =
-          NEW(Scope,
-              self->parser.parse_block.scanner.src->file.name,
-              constant->name,
-              id,
-              ScopeItemKindConstant,
-              constant->visibility ? ScopeKindGlobal : ScopeKindLocal,
-              previous);
+    switch (begin__QueryEngine(self->queries, kind, state)) {
+        case QueryStatusMiss:
+            return true;
+        case QueryStatusCycle:
+            if (decl) {
+                struct Location loc = decl->loc;
+
+                // The location of a type declaration ends on the next line,
+                // the diagnostic is reported at its start.
+                if (loc.e_line != loc.s_line) {
+                    loc.e_line = loc.s_line;
+                    loc.e_col = loc.s_col;
+                }
 
-        constant->data_type = check_data_type(
-          self,
-          constant->constant_decl->loc,
-          constant->constant_decl->value.constant->data_type,
-          NULL,
-          NULL,
-          (struct SearchContext){ .search_class = true,
-                                  .search_type = true,
-                                  .search_value = false,
-                                  .search_fun = false,
-                                  .search_object = true,
-                                  .search_trait = true,
-                                  .search_variant = false,
-                                  .search_primary_type = true });
+                struct Diagnostic *error =
+                  NEW(DiagnosticWithErrTypecheck,
+                      self,
+                      NEW(LilyError, LilyErrorCycleInDeclaration),
+                      loc,
+                      from__String(""),
+                      Some(format("`{S}` depends on itself",
+                                  get_name__Decl(decl))));
 
-        constant->expr_symbol =
-          check_expression(self,
-                           NULL,
-                           constant->constant_decl->value.constant->expr,
-                           NULL,
+                emit_diagnostic(error);
+            }
+
+            return false;
+        default:
+            return false;
+    }
+}
+
+void
+signature_of(struct Typecheck *self, struct ScopeIndexItem *item)
+{
+    if (dependent_typecheck == self && dependent)
+        add__DepGraph(self->deps, dependent, dependent_kind, item->symbol);
+
+    check_decl_in_file_scope(self, item->kind, item->id, item->symbol);
+}
+
+void
+check_decl_in_file_scope(struct Typecheck *self,
+                         enum ScopeItemKind kind,
+                         Usize id,
+                         void *symbol)
+{
+    struct Typecheck *previous_typecheck = dependent_typecheck;
+    void *previous = dependent;
+    enum DepKind previous_kind = dependent_kind;
+
+    dependent_typecheck = self;
+    dependent = symbol;
+    dependent_kind = DepKindSignature;
+
+    switch (kind) {
+        case ScopeItemKindFun:
+            check_fun(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindConstant:
+            check_constant(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindModule:
+            check_module(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindAlias:
+            check_alias(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindEnum:
+            check_enum(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindRecord:
+            check_record(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindEnumObj:
+            check_enum_obj(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindRecordObj:
+            check_record_obj(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindError:
+            check_error(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindClass:
+            check_class(self, symbol, id, NULL);
+            break;
+        case ScopeItemKindTrait:
+            check_trait(self, symbol, id, NULL);
+            break;
+        default:
+            UNREACHABLE("this item is not a declaration of the file scope");
+    }
+
+    dependent_typecheck = previous_typecheck;
+    dependent = previous;
+    dependent_kind = previous_kind;
+}
+
+// Resolve the name of a custom data type in the file scope. The kinds are
+// searched by order of precedence and the result is memoized in
+// self->resolved (the file scope doesn't change during the check). With -j N,
+// the memo is shared by the threads, so it's accessed under the lock of the
+// QueryEngine.
+struct ScopeIndexItem *
+resolve(struct Typecheck *self, struct String *name)
+{
+    static const enum ScopeItemKind kinds[] = { ScopeItemKindEnum,
+                                                ScopeItemKindRecord,
+                                                ScopeItemKindEnumObj,
+                                                ScopeItemKindRecordObj,
+                                                ScopeItemKindClass,
+                                                ScopeItemKindTrait,
+                                                ScopeItemKindAlias };
+
+    if (!self->index)
+        return NULL;
+
+    mtx_lock(&self->queries->lock);
+
+    struct ScopeIndexItem *item = get__ScopeIndex(self->resolved, name);
+
+    count__QueryEngine(self->queries, QueryKindResolve, item);
+
+    if (!item) {
+        struct ScopeIndexItem *found = NULL;
+
+        for (Usize i = 0; !found && i < sizeof(kinds) / sizeof(*kinds); i++)
+            found = get_with_kind__ScopeIndex(self->index, name, kinds[i]);
+
+        add__ScopeIndex(self->resolved,
+                        name,
+                        found ? found->kind : ScopeItemKindVariable,
+                        found ? found->id : 0,
+                        found ? found->symbol : NULL);
+        item = get__ScopeIndex(self->resolved, name);
+    }
+
+    mtx_unlock(&self->queries->lock);
+
+    return item->symbol ? item : NULL;
+}
+
+void
+check_constant(struct Typecheck *self,
+               struct ConstantSymbol *constant,
+               Usize id,
+               struct Scope *previous)
+{
+    if (begin_query(self, QueryKindSignatureOf, &constant->signature, NULL)) {
+        constant->scope =
+          NEW(Scope,
+              self->parser.parse_block.scanner.src->file.name,
+              constant->name,
+              id,
+              ScopeItemKindConstant,
+              constant->visibility ? ScopeKindGlobal : ScopeKindLocal,
+              previous);
+
+        constant->data_type = check_data_type(
+          self,
+          constant->constant_decl->loc,
+          constant->constant_decl->value.constant->data_type,
+          NULL,
+          NULL,
+          (struct SearchContext){ .search_class = true,
+                                  .search_type = true,
+                                  .search_value = false,
+                                  .search_fun = false,
+                                  .search_object = true,
+                                  .search_trait = true,
+                                  .search_variant = false,
+                                  .search_primary_type = true });
+
+        end__QueryEngine(&constant->signature);
+    }
+
+    type_of_constant(self, constant);
+}
+
+struct ExprSymbol *
+type_of_constant(struct Typecheck *self, struct ConstantSymbol *constant)
+{
+    if (begin_query(
+          self, QueryKindTypeOf, &constant->value, constant->constant_decl)) {
+        // The defined data type gives its size to the numeric value:
+        // N :: Uint8 := 3.
+        constant->expr_symbol =
+          check_expression(self,
+                           NULL,
+                           constant->constant_decl->value.constant->expr,
                            NULL,
                            NULL,
+                           get_literal_defined_data_type(constant->data_type),
                            false);
 
-        if (!previous)
-            ++count_const_id;
+        end__QueryEngine(&constant->value);
     }
+
+    return constant->expr_symbol;
 }
 
 void
@@ -1830,7 +2744,7 @@ check_module(struct Typecheck *self,
              Usize id,
              struct Scope *previous)
 {
-    if (!module->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &module->signature, NULL)) {
         module->scope =
           NEW(Scope,
               self->parser.parse_block.scanner.src->file.name,
@@ -1923,8 +2837,8 @@ check_module(struct Typecheck *self,
                                       from__String(""),
                                       None());
 
-                                    emit__Diagnostic(error);
-                                    emit__Diagnostic(note);
+                                    emit_diagnostic(error);
+                                    emit_diagnostic(note);
                                 }
                             }
 
@@ -2053,8 +2967,7 @@ check_module(struct Typecheck *self,
             }
         }
 
-        if (!previous)
-            ++count_module_id;
+        end__QueryEngine(&module->signature);
     }
 }
 
@@ -2064,7 +2977,8 @@ check_alias(struct Typecheck *self,
             Usize id,
             struct Scope *previous)
 {
-    if (!alias->scope) {
+    if (begin_query(
+          self, QueryKindSignatureOf, &alias->signature, alias->alias_decl)) {
         alias->scope = NEW(Scope,
                            self->parser.parse_block.scanner.src->file.name,
                            alias->name,
@@ -2104,7 +3018,7 @@ check_alias(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("rename this generic argument")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push generic params of enum_decl in enum_->generic_params
@@ -2131,10 +3045,45 @@ check_alias(struct Typecheck *self,
             }
         }
 
-        if (!previous)
-            ++count_alias_id;
+        // An alias which names itself, directly or through other aliases, is
+        // reached again by signature_of and reported by begin_query.
+        struct Vec *local_data_type =
+          NULL; // struct Vec<struct LocalDataType*>*
+
+        if (alias->generic_params) {
+            local_data_type = NEW(Vec, sizeof(struct LocalDataType));
+
+            for (Usize i = 0; i < len__Vec(*alias->generic_params); i++)
+                push__Vec(
+                  local_data_type,
+                  NEW(LocalDataType,
+                      get_name__Generic(get__Vec(*alias->generic_params, i)),
+                      NULL));
+        }
+
+        alias->data_type = check_data_type(
+          self,
+          alias->alias_decl->loc,
+          alias->alias_decl->value.alias->data_type,
+          local_data_type,
+          NULL,
+          (struct SearchContext){ .search_type = true,
+                                  .search_fun = false,
+                                  .search_variant = false,
+                                  .search_value = false,
+                                  .search_trait = true,
+                                  .search_class = true,
+                                  .search_object = true,
+                                  .search_primary_type = true });
+
+        if (local_data_type) {
+            for (Usize i = 0; i < len__Vec(*local_data_type); i++)
+                FREE(LocalDataType, get__Vec(*local_data_type, i));
+
+            FREE(Vec, local_data_type);
+        }
 
-        TODO("Search data type");
+        end__QueryEngine(&alias->signature);
     }
 }
 
@@ -2144,7 +3093,7 @@ check_enum(struct Typecheck *self,
            Usize id,
            struct Scope *previous)
 {
-    if (!enum_->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &enum_->signature, NULL)) {
         enum_->scope = NEW(Scope,
                            self->parser.parse_block.scanner.src->file.name,
                            enum_->name,
@@ -2181,7 +3130,7 @@ check_enum(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("rename this generic argument")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push generic params of enum_decl in enum_->generic_params
@@ -2235,25 +3184,36 @@ check_enum(struct Typecheck *self,
                               from__String(""),
                               Some(from__String("rename this variant")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push variant enum in enum_->variants
-                if (((struct VariantEnum *)get__Vec(
-                       *enum_->enum_decl->value.enum_->variants, i))
-                      ->data_type) {
-                    TODO("Check data type");
-                } else
-                    push__Vec(
-                      enum_->variants,
-                      NEW(
-                        VariantEnumSymbol,
-                        get__Vec(*enum_->enum_decl->value.enum_->variants, i)));
+                struct VariantEnum *variant_enum =
+                  get__Vec(*enum_->enum_decl->value.enum_->variants, i);
+                struct VariantEnumSymbol *variant =
+                  NEW(VariantEnumSymbol, variant_enum);
+
+                if (variant_enum->data_type)
+                    variant->data_type = check_data_type(
+                      self,
+                      variant_enum->loc,
+                      variant_enum->data_type,
+                      NULL,
+                      NULL,
+                      (struct SearchContext){ .search_type = true,
+                                              .search_fun = false,
+                                              .search_variant = false,
+                                              .search_value = false,
+                                              .search_trait = true,
+                                              .search_class = true,
+                                              .search_object = true,
+                                              .search_primary_type = true });
+
+                push__Vec(enum_->variants, NEW(SymbolTableVariant, variant));
             }
         }
 
-        if (!previous)
-            ++count_enum_id;
+        end__QueryEngine(&enum_->signature);
     }
 }
 
@@ -2263,7 +3223,7 @@ check_record(struct Typecheck *self,
              Usize id,
              struct Scope *previous)
 {
-    if (!record->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &record->signature, NULL)) {
         record->scope =
           NEW(Scope,
               self->parser.parse_block.scanner.src->file.name,
@@ -2305,7 +3265,7 @@ check_record(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("rename this generic argument")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push generic params of record_decl in record->generic_params
@@ -2361,25 +3321,36 @@ check_record(struct Typecheck *self,
                               from__String(""),
                               Some(from__String("rename this field")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push field record in record->fields
-                if (((struct FieldRecord *)get__Vec(
-                       *record->record_decl->value.record->fields, i))
-                      ->data_type) {
-                    TODO("Check data type");
-                } else
-                    push__Vec(
-                      record->fields,
-                      NEW(FieldRecordSymbol,
-                          get__Vec(*record->record_decl->value.record->fields,
-                                   i)));
+                struct FieldRecord *field_record =
+                  get__Vec(*record->record_decl->value.record->fields, i);
+                struct FieldRecordSymbol *field =
+                  NEW(FieldRecordSymbol, field_record);
+
+                if (field_record->data_type)
+                    field->data_type = check_data_type(
+                      self,
+                      field_record->loc,
+                      field_record->data_type,
+                      NULL,
+                      NULL,
+                      (struct SearchContext){ .search_type = true,
+                                              .search_fun = false,
+                                              .search_variant = false,
+                                              .search_value = false,
+                                              .search_trait = true,
+                                              .search_class = true,
+                                              .search_object = true,
+                                              .search_primary_type = true });
+
+                push__Vec(record->fields, NEW(SymbolTableField, field));
             }
         }
 
-        if (!previous)
-            ++count_record_id;
+        end__QueryEngine(&record->signature);
     }
 }
 
@@ -2389,7 +3360,7 @@ check_error(struct Typecheck *self,
             Usize id,
             struct Scope *previous)
 {
-    if (!error->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &error->signature, NULL)) {
         error->scope = NEW(Scope,
                            self->parser.parse_block.scanner.src->file.name,
                            error->name,
@@ -2429,7 +3400,7 @@ check_error(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("rename this generic argument")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push generic params of error in error->generic_params
@@ -2460,8 +3431,7 @@ check_error(struct Typecheck *self,
             TODO("check data type");
         }
 
-        if (!previous)
-            ++count_error_id;
+        end__QueryEngine(&error->signature);
     }
 }
 
@@ -2471,7 +3441,7 @@ check_enum_obj(struct Typecheck *self,
                Usize id,
                struct Scope *previous)
 {
-    if (!enum_obj->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &enum_obj->signature, NULL)) {
         enum_obj->scope =
           NEW(Scope,
               self->parser.parse_block.scanner.src->file.name,
@@ -2512,7 +3482,7 @@ check_enum_obj(struct Typecheck *self,
                           from__String(""),
                           Some(from__String("rename this generic argument")));
 
-                        emit__Diagnostic(err);
+                        emit_diagnostic(err);
                     }
 
                 // Push generic params of enum_obj in enum_obj->generic_params
@@ -2547,8 +3517,7 @@ check_enum_obj(struct Typecheck *self,
         if (enum_obj->enum_decl->value.enum_->variants) {
         }
 
-        if (!previous)
-            ++count_enum_obj_id;
+        end__QueryEngine(&enum_obj->signature);
     }
 }
 
@@ -2558,7 +3527,7 @@ check_record_obj(struct Typecheck *self,
                  Usize id,
                  struct Scope *previous)
 {
-    if (!record_obj->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &record_obj->signature, NULL)) {
         record_obj->scope =
           NEW(Scope,
               self->parser.parse_block.scanner.src->file.name,
@@ -2625,8 +3594,7 @@ check_record_obj(struct Typecheck *self,
         {
         }
 
-        if (!previous)
-            ++count_record_obj_id;
+        end__QueryEngine(&record_obj->signature);
     }
 }
 
@@ -2636,7 +3604,7 @@ check_class(struct Typecheck *self,
             Usize id,
             struct Scope *previous)
 {
-    if (!class->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &class->signature, NULL)) {
         class->scope = NEW(Scope,
                            self->parser.parse_block.scanner.src->file.name,
                            class->name,
@@ -2741,8 +3709,7 @@ check_class(struct Typecheck *self,
         if (class->class_decl->value.class->body) {
         }
 
-        if (!previous)
-            ++count_class_id;
+        end__QueryEngine(&class->signature);
     }
 }
 
@@ -2752,7 +3719,7 @@ check_trait(struct Typecheck *self,
             Usize id,
             struct Scope *previous)
 {
-    if (!trait->scope) {
+    if (begin_query(self, QueryKindSignatureOf, &trait->signature, NULL)) {
         trait->scope = NEW(Scope,
                            self->parser.parse_block.scanner.src->file.name,
                            trait->name,
@@ -2772,8 +3739,7 @@ check_trait(struct Typecheck *self,
             TODO("check body");
         }
 
-        if (!previous)
-            ++count_trait_id;
+        end__QueryEngine(&trait->signature);
     }
 }
 
@@ -2783,136 +3749,164 @@ check_fun(struct Typecheck *self,
           Usize id,
           struct Scope *previous)
 {
-    if (!fun->scope) {
-        fun->scope = NEW(Scope,
-                         self->parser.parse_block.scanner.src->file.name,
-                         fun->name,
-                         id,
-                         ScopeItemKindFun,
-                         fun->visibility ? ScopeKindGlobal : ScopeKindLocal,
-                         previous);
-
-        struct FunDecl *fun_decl = fun->fun_decl->value.fun;
-        struct Vec *local_data_type = NULL; // struct Vec<struct Scope*>*
-        struct Vec *local_value = NULL;     // struct Vec<struct Scope*>*
-        struct Vec *local_decl = NULL;      // struct Vec<struct Scope*>*
-        struct Vec *tagged_type = NULL;
-        struct Vec *generic_params = NULL;
-        struct Vec *params = NULL;
-        struct DataTypeSymbol *return_type = NULL;
-        struct Vec *body = NULL;
-
-        if (fun_decl->tags) {
-            tagged_type = NEW(Vec, sizeof(struct Tuple));
-
-            for (Usize i = len__Vec(*fun_decl->tags); i--;) {
-                struct Tuple *current = get__Vec(*fun_decl->tags, i);
-                struct DataTypeSymbol *dts = check_data_type(
-                  self,
-                  *(struct Location *)current->items[1],
-                  current->items[0],
-                  local_data_type,
-                  local_decl,
-                  (struct SearchContext){ .search_type = false,
-                                          .search_fun = false,
-                                          .search_variant = false,
-                                          .search_value = false,
-                                          .search_trait = false,
-                                          .search_class = false,
-                                          .search_object = true,
-                                          .search_primary_type = false });
+    if (begin_query(self, QueryKindSignatureOf, &fun->signature, NULL)) {
+        check_fun_signature(self, fun, id, previous);
+        end__QueryEngine(&fun->signature);
+    }
 
-                if (dts)
-                    push__Vec(tagged_type, dts);
+    // The bodies of the functions of the file are checked once all the
+    // signatures are resolved (see check_fun_bodies), a search of the function
+    // only needs its signature. A signature which is inferred is only resolved
+    // by the body, so this body is checked in place, like the functions of a
+    // module.
+    if (previous || has_inferred_signature(fun))
+        check_fun_body_once(self, fun);
+}
+
+void
+check_fun_signature(struct Typecheck *self,
+                    struct FunSymbol *fun,
+                    Usize id,
+                    struct Scope *previous)
+{
+    fun->scope = NEW(Scope,
+                     self->parser.parse_block.scanner.src->file.name,
+                     fun->name,
+                     id,
+                     ScopeItemKindFun,
+                     fun->visibility ? ScopeKindGlobal : ScopeKindLocal,
+                     previous);
+
+    struct FunDecl *fun_decl = fun->fun_decl->value.fun;
+    struct Vec *local_data_type = NULL; // struct Vec<struct Scope*>*
+    struct Vec *local_decl = NULL;      // struct Vec<struct Scope*>*
+    struct Vec *tagged_type = NULL;
+    struct Vec *generic_params = NULL;
+    struct Vec *params = NULL;
+    struct DataTypeSymbol *return_type = NULL;
+
+    if (fun_decl->tags) {
+        tagged_type = NEW(Vec, sizeof(struct Tuple));
+
+        for (Usize i = len__Vec(*fun_decl->tags); i--;) {
+            struct Tuple *current = get__Vec(*fun_decl->tags, i);
+
+            if (is_tailrec_tag(current->items[0])) {
+                fun->is_tailrec = true;
+                continue;
             }
 
-            SUMMARY();
+            struct DataTypeSymbol *dts = check_data_type(
+              self,
+              *(struct Location *)current->items[1],
+              current->items[0],
+              local_data_type,
+              local_decl,
+              (struct SearchContext){ .search_type = false,
+                                      .search_fun = false,
+                                      .search_variant = false,
+                                      .search_value = false,
+                                      .search_trait = false,
+                                      .search_class = false,
+                                      .search_object = true,
+                                      .search_primary_type = false });
+
+            if (dts)
+                push__Vec(tagged_type, dts);
         }
 
-        if (fun_decl->generic_params) {
-            local_data_type = NEW(Vec, sizeof(struct LocalDataType));
+        SUMMARY();
+    }
 
-            for (Usize i = len__Vec(*fun_decl->generic_params); i--;) {
-                switch (
-                  ((struct Generic *)get__Vec(*fun_decl->generic_params, i))
-                    ->kind) {
-                    case GenericKindDataType:
-                        push__Vec(local_data_type,
-                                  NEW(LocalDataType,
-                                      ((struct Generic *)get__Vec(
-                                         *fun_decl->generic_params, i))
-                                        ->value.data_type,
-                                      NULL));
-                        break;
-                    case GenericKindRestrictedDataType: {
-                        struct DataTypeSymbol *dts = check_data_type(
-                          self,
-                          *(struct Location
-                              *)((struct Tuple *)((struct Generic *)get__Vec(
-                                                    *fun_decl->generic_params,
-                                                    i))
-                                   ->value.restricted_data_type->items[1])
-                             ->items[1],
-                          ((struct Tuple *)((struct Generic *)get__Vec(
-                                              *fun_decl->generic_params, i))
-                             ->value.restricted_data_type->items[1])
-                            ->items[0],
-                          local_data_type,
-                          NULL,
-                          (struct SearchContext){ .search_type = false,
-                                                  .search_fun = false,
-                                                  .search_variant = false,
-                                                  .search_value = false,
-                                                  .search_trait = false,
-                                                  .search_class = false,
-                                                  .search_object = false,
-                                                  .search_primary_type =
-                                                    false });
-
-                        if (dts)
-                            push__Vec(
-                              local_data_type,
+    if (fun_decl->generic_params) {
+        local_data_type = NEW(Vec, sizeof(struct LocalDataType));
+
+        for (Usize i = len__Vec(*fun_decl->generic_params); i--;) {
+            switch (
+              ((struct Generic *)get__Vec(*fun_decl->generic_params, i))
+                ->kind) {
+                case GenericKindDataType:
+                    push__Vec(local_data_type,
                               NEW(LocalDataType,
                                   ((struct Generic *)get__Vec(
                                      *fun_decl->generic_params, i))
-                                    ->value.restricted_data_type->items[0],
-                                  NEW(Tuple,
-                                      2,
-                                      dts,
-                                      *(struct Location
-                                          *)((struct Tuple
-                                                *)((struct Generic *)get__Vec(
-                                                     *fun_decl->generic_params,
-                                                     i))
-                                               ->value.restricted_data_type
-                                               ->items[1])
-                                         ->items[1])));
-                        else
-                            assert(0 && "error");
+                                    ->value.data_type,
+                                  NULL));
+                    break;
+                case GenericKindRestrictedDataType: {
+                    struct DataTypeSymbol *dts = check_data_type(
+                      self,
+                      *(struct Location
+                          *)((struct Tuple *)((struct Generic *)get__Vec(
+                                                *fun_decl->generic_params,
+                                                i))
+                               ->value.restricted_data_type->items[1])
+                         ->items[1],
+                      ((struct Tuple *)((struct Generic *)get__Vec(
+                                          *fun_decl->generic_params, i))
+                         ->value.restricted_data_type->items[1])
+                        ->items[0],
+                      local_data_type,
+                      NULL,
+                      (struct SearchContext){ .search_type = false,
+                                              .search_fun = false,
+                                              .search_variant = false,
+                                              .search_value = false,
+                                              .search_trait = false,
+                                              .search_class = false,
+                                              .search_object = false,
+                                              .search_primary_type =
+                                                false });
+
+                    if (dts)
+                        push__Vec(
+                          local_data_type,
+                          NEW(LocalDataType,
+                              ((struct Generic *)get__Vec(
+                                 *fun_decl->generic_params, i))
+                                ->value.restricted_data_type->items[0],
+                              NEW(Tuple,
+                                  2,
+                                  dts,
+                                  *(struct Location
+                                      *)((struct Tuple
+                                            *)((struct Generic *)get__Vec(
+                                                 *fun_decl->generic_params,
+                                                 i))
+                                           ->value.restricted_data_type
+                                           ->items[1])
+                                     ->items[1])));
+                    else
+                        assert(0 && "error");
 
-                        break;
-                    }
+                    break;
                 }
             }
-
-            SUMMARY();
         }
 
-        if (fun_decl->params) {
-            params = NEW(Vec, sizeof(struct FunParamSymbol));
-            local_value = NEW(Vec, sizeof(struct Scope));
+        SUMMARY();
+    }
+
+    // The params and the return are inferred from the body of the function,
+    // their type variables are generalized when the body is checked.
+    struct Infer *infer = NEW(Infer, self->types);
+
+    enter__Infer(infer);
+    fun->infer = infer;
+
+    if (fun_decl->params) {
+        params = NEW(Vec, sizeof(struct FunParamSymbol));
 
-            for (Usize i = 0; i < len__Vec(*fun_decl->params); i++) {
-                struct FunParamSymbol *param =
-                  NEW(FunParamSymbol, get__Vec(*fun_decl->params, i));
-                struct Vec *ids = NEW(Vec, sizeof(Usize));
-                struct DataTypeSymbol *dts = check_data_type(
+        for (Usize i = 0; i < len__Vec(*fun_decl->params); i++) {
+            struct FunParam *fun_param = get__Vec(*fun_decl->params, i);
+            struct FunParamSymbol *param = NEW(FunParamSymbol, fun_param);
+            struct DataTypeSymbol *dts = NULL;
+
+            if (fun_param->param_data_type)
+                dts = check_data_type(
                   self,
-                  *(struct Location *)((struct FunParam *)get__Vec(
-                                         *fun_decl->params, i))
-                     ->param_data_type->items[1],
-                  ((struct FunParam *)get__Vec(*fun_decl->params, i))
-                    ->param_data_type->items[0],
+                  *(struct Location *)fun_param->param_data_type->items[1],
+                  fun_param->param_data_type->items[0],
                   local_data_type,
                   local_decl,
                   (struct SearchContext){ .search_type = true,
@@ -2922,106 +3916,232 @@ check_fun(struct Typecheck *self,
                                           .search_trait = true,
                                           .search_class = true,
                                           .search_object = true,
-                                          .search_primary_type = false });
-
-                if (dts) {
-                    param->param_data_type =
-                      ((struct FunParam *)get__Vec(*fun_decl->params, i))
-                          ->param_data_type
-                        ? NEW(
-                            Tuple,
-                            2,
-                            dts,
-                            ((struct FunParam *)get__Vec(*fun_decl->params, i))
-                              ->param_data_type->items[1])
-                        : NULL;
-                }
+                                          .search_primary_type = true });
 
-                if (param->default_)
-                    TODO("");
-
-                push__Vec(params, param);
-                push__Vec(local_value,
-                          NEW(Scope,
-                              self->parser.parse_block.scanner.src->file.name,
-                              param->name,
-                              i,
-                              ScopeItemKindParam,
-                              ScopeKindLocal,
-                              NULL));
-            }
-        }
+            if (dts) {
+                param->param_data_type =
+                  NEW(Tuple, 2, dts, fun_param->param_data_type->items[1]);
+                param->data_type_var = from_data_type__Infer(infer, dts);
+            } else
+                param->data_type_var = fresh__Infer(infer);
 
-        if (fun_decl->return_type) {
-            struct DataTypeSymbol *dts = check_data_type(
-              self,
-              *(struct Location *)fun_decl->return_type->items[1],
-              fun_decl->return_type->items[0],
-              local_data_type,
-              local_decl,
-              (struct SearchContext){ .search_type = true,
-                                      .search_fun = false,
-                                      .search_variant = false,
-                                      .search_value = false,
-                                      .search_trait = true,
-                                      .search_class = true,
-                                      .search_object = true,
-                                      .search_primary_type = false });
+            if (param->default_)
+                TODO("");
 
-            if (dts)
-                return_type = dts;
+            param->scope =
+              NEW(Scope,
+                  self->parser.parse_block.scanner.src->file.name,
+                  param->name,
+                  i,
+                  ScopeItemKindParam,
+                  ScopeKindLocal,
+                  NULL);
 
-            SUMMARY();
+            push__Vec(params, param);
         }
+    }
+
+    if (fun_decl->return_type) {
+        struct DataTypeSymbol *dts = check_data_type(
+          self,
+          *(struct Location *)fun_decl->return_type->items[1],
+          fun_decl->return_type->items[0],
+          local_data_type,
+          local_decl,
+          (struct SearchContext){ .search_type = true,
+                                  .search_fun = false,
+                                  .search_variant = false,
+                                  .search_value = false,
+                                  .search_trait = true,
+                                  .search_class = true,
+                                  .search_object = true,
+                                  .search_primary_type = true });
 
-        if (fun_decl->body) {
-            local_value = NEW(Vec, sizeof(struct Scope));
-            body = NEW(Vec, sizeof(struct SymbolTable));
+        if (dts)
+            return_type = dts;
 
-            check_fun_body(self, fun, body, local_value, local_data_type);
-        }
+        SUMMARY();
+    }
 
-        fun->tagged_type = tagged_type;
-        fun->generic_params = generic_params;
-        fun->params = params;
-        fun->return_type = return_type;
-        fun->body = body;
+    fun->tagged_type = tagged_type;
+    fun->generic_params = generic_params;
+    fun->params = params;
+    fun->return_type = return_type;
+    fun->local_data_type = local_data_type;
+    fun->return_type_var = return_type
+                             ? from_data_type__Infer(infer, return_type)
+                             : fresh__Infer(infer);
+}
 
-        if (!previous)
-            ++count_fun_id;
+void
+check_fun_body_once(struct Typecheck *self, struct FunSymbol *fun)
+{
+    bool checked = false;
 
-        if (local_data_type) {
-            for (Usize i = len__Vec(*local_data_type); i--;)
-                FREE(LocalDataType, get__Vec(*local_data_type, i));
+    // With -j N, several threads can reach the body, only the first one
+    // checks it.
+    if (!atomic_compare_exchange_strong(&fun->body_checked, &checked, true))
+        return;
 
-            FREE(Vec, local_data_type);
-        }
+    struct Typecheck *previous_typecheck = dependent_typecheck;
+    void *previous = dependent;
+    enum DepKind previous_kind = dependent_kind;
+    // The body can be reached from the body of a lambda.
+    struct LambdaContext *previous_lambda = current_lambda;
+
+    dependent_typecheck = self;
+    dependent = fun;
+    dependent_kind = DepKindBody;
+    current_lambda = NULL;
+
+    if (fun->fun_decl->value.fun->body) {
+        struct Vec *body = NEW(Vec, sizeof(struct SymbolTable));
+        struct LocalScopeChain *local_value = NEW(LocalScopeChain);
 
-        if (local_value)
-            FREE(Vec, local_value);
+        // The params are in the outermost lexical scope of the function.
+        enter__LocalScopeChain(local_value);
+
+        if (fun->params)
+            for (Usize i = 0; i < len__Vec(*fun->params); i++)
+                add__LocalScopeChain(
+                  local_value,
+                  ((struct FunParamSymbol *)get__Vec(*fun->params, i))->scope);
+
+        enter__LocalScopeChain(local_value);
+        check_fun_body(self, fun, body, local_value, fun->local_data_type);
+
+        FREE(LocalScopeChain, local_value);
+
+        fun->body = body;
+
+        if (fun->is_tailrec)
+            check_tail_calls(self, fun, body, true);
+    }
+
+    if (fun->local_data_type) {
+        for (Usize i = len__Vec(*fun->local_data_type); i--;)
+            FREE(LocalDataType, get__Vec(*fun->local_data_type, i));
+
+        FREE(Vec, fun->local_data_type);
+        fun->local_data_type = NULL;
     }
+
+    if (fun->infer)
+        generalize_fun_signature(fun);
+
+    dependent_typecheck = previous_typecheck;
+    dependent = previous;
+    dependent_kind = previous_kind;
+    current_lambda = previous_lambda;
 }
 
-struct SymbolTable *
-get_info_of_decl_from_scope(struct Typecheck *self,
-                            struct Scope *scope,
-                            struct Location loc)
+void
+check_fun_body_task(void *data, Usize task)
 {
-    struct Vec *scopes = NEW(Vec, sizeof(struct Scope));
+    struct Typecheck *self = data;
 
-    {
-        struct Scope *previous = scope;
+    check_fun_body_once(self, get__Vec(*self->funs, task));
+}
 
-        while (previous) {
-            push__Vec(scopes, previous);
-            previous = scope->previous;
-        }
-    }
+void
+check_fun_bodies(struct Typecheck *self)
+{
+    if (!self->funs)
+        return;
 
-    struct SymbolTable *current = NULL;
+    run_deferred_tasks(
+      self->jobs, len__Vec(*self->funs), &check_fun_body_task, self);
+}
 
-    {
-        struct Scope *first = get__Vec(*scopes, len__Vec(*scopes) - 1);
+// Check again the invalidated functions of the file. When the new body of a
+// function changes its inferred signature, the users of the signature are
+// invalidated in turn.
+Usize
+recheck_funs(struct Typecheck *self)
+{
+    Usize count = 0;
+
+    while (self->deps->invalid_len > 0) {
+        Usize pass_count = 0;
+
+        for (Usize i = 0; self->funs && i < len__Vec(*self->funs); i++) {
+            struct FunSymbol *fun = get__Vec(*self->funs, i);
+            enum DepState state = get_state__DepGraph(self->deps, fun);
+
+            if (state == DepStateValid)
+                continue;
+
+            // The signature inferred with the previous body.
+            Usize params_len = fun->params ? len__Vec(*fun->params) : 0;
+            struct DataTypeSymbol **signature =
+              malloc((params_len + 1) * sizeof(struct DataTypeSymbol *));
+
+            for (Usize j = 0; j < params_len; j++) {
+                struct FunParamSymbol *param = get__Vec(*fun->params, j);
+
+                signature[j] = param->param_data_type
+                                 ? param->param_data_type->items[0]
+                                 : NULL;
+            }
+
+            signature[params_len] = fun->return_type;
+
+            validate__DepGraph(self->deps, fun);
+            reset__FunSymbol(fun, fun->fun_decl);
+            check_decl_in_file_scope(self, ScopeItemKindFun, i, fun);
+            check_fun_body_once(self, fun);
+
+            bool is_same_signature =
+              (fun->params ? len__Vec(*fun->params) : 0) == params_len &&
+              signature[params_len] == fun->return_type;
+
+            for (Usize j = 0; is_same_signature && j < params_len; j++) {
+                struct FunParamSymbol *param = get__Vec(*fun->params, j);
+
+                is_same_signature = signature[j] == (param->param_data_type
+                                                       ? param->param_data_type
+                                                           ->items[0]
+                                                       : NULL);
+            }
+
+            if (state == DepStateBody && !is_same_signature)
+                invalidate_users__DepGraph(self->deps, fun);
+
+            free(signature);
+            ++count;
+            ++pass_count;
+        }
+
+        // The change reaches a declaration which is not a function.
+        if (pass_count == 0) {
+            count = TYPECHECK_RECHECK_ALL;
+            break;
+        }
+    }
+
+    return count;
+}
+
+struct SymbolTable *
+get_info_of_decl_from_scope(struct Typecheck *self,
+                            struct Scope *scope,
+                            struct Location loc)
+{
+    struct Vec *scopes = NEW(Vec, sizeof(struct Scope));
+
+    {
+        struct Scope *previous = scope;
+
+        while (previous) {
+            push__Vec(scopes, previous);
+            previous = scope->previous;
+        }
+    }
+
+    struct SymbolTable *current = NULL;
+
+    {
+        struct Scope *first = get__Vec(*scopes, len__Vec(*scopes) - 1);
 
         switch (first->item_kind) {
             case ScopeItemKindAlias:
@@ -3096,85 +4216,110 @@ get_info_of_decl_from_scope(struct Typecheck *self,
 void
 check_symbols(struct Typecheck *self)
 {
+    // Index of the next symbol of each kind.
+    Usize fun_id = 0;
+    Usize const_id = 0;
+    Usize module_id = 0;
+    Usize alias_id = 0;
+    Usize record_id = 0;
+    Usize enum_id = 0;
+    Usize error_id = 0;
+    Usize class_id = 0;
+    Usize trait_id = 0;
+    Usize record_obj_id = 0;
+    Usize enum_obj_id = 0;
+
     while (pos < len__Vec(*self->parser.decls)) {
         switch (self->decl->kind) {
             case DeclKindFun:
-                check_fun(self,
-                          get__Vec(*self->funs, count_fun_id),
-                          count_fun_id,
-                          NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindFun,
+                                         fun_id,
+                                         get__Vec(*self->funs, fun_id));
+                ++fun_id;
 
                 break;
             case DeclKindConstant:
-                check_constant(self,
-                               get__Vec(*self->consts, count_const_id),
-                               count_const_id,
-                               NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindConstant,
+                                         const_id,
+                                         get__Vec(*self->consts, const_id));
+                ++const_id;
 
                 break;
             case DeclKindModule:
-                check_module(self,
-                             get__Vec(*self->modules, count_module_id),
-                             count_module_id,
-                             NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindModule,
+                                         module_id,
+                                         get__Vec(*self->modules, module_id));
+                ++module_id;
 
                 break;
             case DeclKindAlias:
-                check_alias(self,
-                            get__Vec(*self->aliases, count_alias_id),
-                            count_alias_id,
-                            NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindAlias,
+                                         alias_id,
+                                         get__Vec(*self->aliases, alias_id));
+                ++alias_id;
 
                 break;
             case DeclKindRecord:
-                if (((struct RecordDecl *)get__Vec(*self->parser.decls, pos))
-                      ->is_object)
-                    check_record_obj(
+                if (self->decl->value.record->is_object) {
+                    check_decl_in_file_scope(
                       self,
-                      get__Vec(*self->records_obj, count_record_obj_id),
-                      count_record_obj_id,
-                      NULL);
-                else
-                    check_record(self,
-                                 get__Vec(*self->records, count_record_id),
-                                 count_record_id,
-                                 NULL);
+                      ScopeItemKindRecordObj,
+                      record_obj_id,
+                      get__Vec(*self->records_obj, record_obj_id));
+                    ++record_obj_id;
+                } else {
+                    check_decl_in_file_scope(
+                      self,
+                      ScopeItemKindRecord,
+                      record_id,
+                      get__Vec(*self->records, record_id));
+                    ++record_id;
+                }
 
                 break;
             case DeclKindEnum:
-                if (((struct EnumDecl *)get__Vec(*self->parser.decls, pos))
-                      ->is_object)
-                    check_enum_obj(
+                if (self->decl->value.enum_->is_object) {
+                    check_decl_in_file_scope(
                       self,
-                      get__Vec(*self->enums_obj, count_enum_obj_id),
-                      count_enum_obj_id,
-                      NULL);
-                else
-                    check_enum(self,
-                               get__Vec(*self->enums, count_enum_id),
-                               count_enum_id,
-                               NULL);
+                      ScopeItemKindEnumObj,
+                      enum_obj_id,
+                      get__Vec(*self->enums_obj, enum_obj_id));
+                    ++enum_obj_id;
+                } else {
+                    check_decl_in_file_scope(self,
+                                             ScopeItemKindEnum,
+                                             enum_id,
+                                             get__Vec(*self->enums, enum_id));
+                    ++enum_id;
+                }
 
                 break;
             case DeclKindError:
-                check_error(self,
-                            get__Vec(*self->errors, count_error_id),
-                            count_error_id,
-                            NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindError,
+                                         error_id,
+                                         get__Vec(*self->errors, error_id));
+                ++error_id;
 
                 break;
             case DeclKindClass:
-                check_class(self,
-                            get__Vec(*self->classes, count_class_id),
-                            count_class_id,
-                            NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindClass,
+                                         class_id,
+                                         get__Vec(*self->classes, class_id));
+                ++class_id;
 
                 break;
             case DeclKindTrait:
-                check_trait(self,
-                            get__Vec(*self->traits, count_trait_id),
-                            count_trait_id,
-                            NULL);
+                check_decl_in_file_scope(self,
+                                         ScopeItemKindTrait,
+                                         trait_id,
+                                         get__Vec(*self->traits, trait_id));
+                ++trait_id;
 
                 break;
             case DeclKindTag:
@@ -3226,220 +4371,268 @@ search_from_access(struct Typecheck *self,
     }
 }
 
+struct ScopeIndexItem *
+search_in_file_scope(struct Typecheck *self,
+                     struct String *name,
+                     enum ScopeItemKind kind)
+{
+    if (!self->index)
+        return NULL;
+
+    return get_with_kind__ScopeIndex(self->index, name, kind);
+}
+
 struct ConstantSymbol *
 search_in_consts_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->consts)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindConstant);
 
-    for (Usize i = len__Vec(*self->consts); i--;) {
-        if (eq__String(
-              name,
-              ((struct ConstantSymbol *)get__Vec(*self->consts, i))->name,
-              false)) {
-            check_constant(self, get__Vec(*self->consts, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->consts, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct ModuleSymbol *
 search_in_modules_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->modules)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindModule);
 
-    for (Usize i = len__Vec(*self->modules); i--;) {
-        if (eq__String(
-              name,
-              ((struct ModuleSymbol *)get__Vec(*self->modules, i))->name,
-              false)) {
-            check_module(self, get__Vec(*self->modules, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->modules, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct FunSymbol *
 search_in_funs_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->modules)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindFun);
 
-    for (Usize i = len__Vec(*self->funs); i--;) {
-        if (eq__String(name,
-                       ((struct FunSymbol *)get__Vec(*self->funs, i))->name,
-                       false)) {
-            check_fun(self, get__Vec(*self->funs, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->funs, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct AliasSymbol *
 search_in_aliases_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->aliases)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindAlias);
 
-    for (Usize i = len__Vec(*self->aliases); i--;) {
-        if (eq__String(
-              name,
-              ((struct AliasSymbol *)get__Vec(*self->aliases, i))->name,
-              false)) {
-            check_alias(self, get__Vec(*self->aliases, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->aliases, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct EnumSymbol *
 search_in_enums_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->enums)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindEnum);
 
-    for (Usize i = len__Vec(*self->enums); i--;) {
-        if (eq__String(name,
-                       ((struct EnumSymbol *)get__Vec(*self->enums, i))->name,
-                       false)) {
-            check_enum(self, get__Vec(*self->enums, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->enums, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct RecordSymbol *
 search_in_records_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->records)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindRecord);
 
-    for (Usize i = len__Vec(*self->records); i--;) {
-        if (eq__String(
-              name,
-              ((struct RecordSymbol *)get__Vec(*self->records, i))->name,
-              false)) {
-            check_record(self, get__Vec(*self->records, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->records, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct EnumObjSymbol *
 search_in_enums_obj_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->enums_obj)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindEnumObj);
 
-    for (Usize i = len__Vec(*self->enums_obj); i--;) {
-        if (eq__String(
-              name,
-              ((struct EnumObjSymbol *)get__Vec(*self->enums_obj, i))->name,
-              false)) {
-            check_enum_obj(self, get__Vec(*self->enums_obj, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->enums_obj, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct RecordObjSymbol *
 search_in_records_obj_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->records_obj)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindRecordObj);
 
-    for (Usize i = len__Vec(*self->records_obj); i--;) {
-        if (eq__String(
-              name,
-              ((struct RecordObjSymbol *)get__Vec(*self->records_obj, i))->name,
-              false)) {
-            check_record_obj(self, get__Vec(*self->records_obj, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->records_obj, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct ClassSymbol *
 search_in_classes_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->classes)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindClass);
 
-    for (Usize i = len__Vec(*self->classes); i--;) {
-        if (eq__String(
-              name,
-              ((struct ClassSymbol *)get__Vec(*self->classes, i))->name,
-              false)) {
-            check_class(self, get__Vec(*self->classes, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->classes, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct TraitSymbol *
 search_in_traits_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->traits)
-        return NULL;
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindTrait);
 
-    for (Usize i = len__Vec(*self->traits); i--;) {
-        if (eq__String(name,
-                       ((struct TraitSymbol *)get__Vec(*self->traits, i))->name,
-                       false)) {
-            check_trait(self, get__Vec(*self->traits, i), i, NULL);
+    if (!item)
+        return NULL;
 
-            return get__Vec(*self->traits, i);
-        }
-    }
+    signature_of(self, item);
 
-    return NULL;
+    return item->symbol;
 }
 
 struct ErrorSymbol *
 search_in_errors_from_name(struct Typecheck *self, struct String *name)
 {
-    if (!self->errors)
+    struct ScopeIndexItem *item =
+      search_in_file_scope(self, name, ScopeItemKindError);
+
+    if (!item)
         return NULL;
 
-    for (Usize i = len__Vec(*self->errors); i--;) {
-        if (eq__String(name,
-                       ((struct ErrorSymbol *)get__Vec(*self->errors, i))->name,
-                       false)) {
-            check_error(self, get__Vec(*self->errors, i), i, NULL);
+    signature_of(self, item);
 
-            return get__Vec(*self->errors, i);
-        }
+    return item->symbol;
+}
+
+enum ScopeItemKind
+get_scope_item_kind_from_symbol_table(struct SymbolTable *symb)
+{
+    switch (symb->kind) {
+        case SymbolTableKindFun:
+        case SymbolTableKindMethod:
+            return ScopeItemKindFun;
+        case SymbolTableKindConstant:
+            return ScopeItemKindConstant;
+        case SymbolTableKindModule:
+            return ScopeItemKindModule;
+        case SymbolTableKindAlias:
+            return ScopeItemKindAlias;
+        case SymbolTableKindRecord:
+            return ScopeItemKindRecord;
+        case SymbolTableKindEnum:
+            return ScopeItemKindEnum;
+        case SymbolTableKindError:
+            return ScopeItemKindError;
+        case SymbolTableKindClass:
+            return ScopeItemKindClass;
+        case SymbolTableKindTrait:
+            return ScopeItemKindTrait;
+        case SymbolTableKindRecordObj:
+            return ScopeItemKindRecordObj;
+        case SymbolTableKindEnumObj:
+            return ScopeItemKindEnumObj;
+        case SymbolTableKindVariant:
+            return ScopeItemKindVariant;
+        case SymbolTableKindField:
+        case SymbolTableKindProperty:
+            return ScopeItemKindVariable;
+        default:
+            UNREACHABLE("this symbol has no name");
     }
+}
 
-    return NULL;
+void
+index_symbols_in_scope(struct ScopeIndex *index, struct Vec *symbols)
+{
+    for (Usize i = 0; i < len__Vec(*symbols); i++) {
+        struct SymbolTable *symb = get__Vec(*symbols, i);
+        struct String *name = get_name__SymbolTable(symb);
+
+        if (name)
+            add__ScopeIndex(index,
+                            name,
+                            get_scope_item_kind_from_symbol_table(symb),
+                            i,
+                            symb);
+    }
+}
+
+// The index of a module, class, enum or record scope is built at the first
+// search, because the symbols of the scope are only known after its check.
+// It's built again if the scope has grown since (search during the check of
+// the scope). The symbols take precedence over the attached symbols (enum and
+// record objects). The function bodies can be checked by several threads, so
+// the index is built under scope_index_lock.
+void
+init_scope_index_lock()
+{
+    mtx_init(&scope_index_lock, mtx_plain);
+}
+
+struct SymbolTable *
+search_item_in_scope(struct ScopeIndex **index,
+                     struct Vec *symbols,
+                     struct Vec *attached,
+                     struct String *name)
+{
+    call_once(&scope_index_lock_once, &init_scope_index_lock);
+    mtx_lock(&scope_index_lock);
+
+    Usize count = (symbols ? len__Vec(*symbols) : 0) +
+                  (attached ? len__Vec(*attached) : 0);
+
+    if (*index && len__Vec(*(*index)->items) != count) {
+        FREE(ScopeIndex, *index);
+        *index = NULL;
+    }
+
+    if (!*index) {
+        *index = NEW(ScopeIndex);
+
+        if (attached)
+            index_symbols_in_scope(*index, attached);
+
+        if (symbols)
+            index_symbols_in_scope(*index, symbols);
+    }
+
+    struct ScopeIndexItem *item = get__ScopeIndex(*index, name);
+
+    mtx_unlock(&scope_index_lock);
+
+    return item ? item->symbol : NULL;
 }
 
 struct SymbolTable *
@@ -3447,21 +4640,19 @@ search_module_item_in_scope(struct Typecheck *self,
                             struct Expr *id,
                             struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.module->body); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           ((struct SymbolTable *)get__Vec(
-                              *scope->value.module->body, i))
-                             ->value.variant->name,
-                           false))
-                return get__Vec(*scope->value.module->body, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
+
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.module->index,
+                           scope->value.module->body,
+                           NULL,
+                           id->value.identifier);
 
-    assert(0 && "error: unknown module item");
+    if (!item)
+        assert(0 && "error: unknown module item");
 
-    return NULL;
+    return item;
 }
 
 struct SymbolTable *
@@ -3469,21 +4660,19 @@ search_enum_item_in_scope(struct Typecheck *self,
                           struct Expr *id,
                           struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.enum_->variants); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           ((struct SymbolTable *)get__Vec(
-                              *scope->value.enum_->variants, i))
-                             ->value.variant->name,
-                           false))
-                return get__Vec(*scope->value.enum_->variants, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
 
-    assert(0 && "error: unknown variant");
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.enum_->index,
+                           scope->value.enum_->variants,
+                           NULL,
+                           id->value.identifier);
 
-    return NULL;
+    if (!item)
+        assert(0 && "error: unknown variant");
+
+    return item;
 }
 
 struct SymbolTable *
@@ -3491,21 +4680,19 @@ search_record_item_in_scope(struct Typecheck *self,
                             struct Expr *id,
                             struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.record->fields); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           ((struct SymbolTable *)get__Vec(
-                              *scope->value.record->fields, i))
-                             ->value.field->name,
-                           false))
-                return get__Vec(*scope->value.record->fields, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
+
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.record->index,
+                           scope->value.record->fields,
+                           NULL,
+                           id->value.identifier);
 
-    assert(0 && "error: unknown field");
+    if (!item)
+        assert(0 && "error: unknown field");
 
-    return NULL;
+    return item;
 }
 
 struct SymbolTable *
@@ -3513,32 +4700,19 @@ search_enum_obj_item_in_scope(struct Typecheck *self,
                               struct Expr *id,
                               struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.enum_obj->variants); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           ((struct SymbolTable *)get__Vec(
-                              *scope->value.enum_obj->variants, i))
-                             ->value.variant->name,
-                           false))
-                return get__Vec(*scope->value.enum_obj->variants, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
 
-    for (Usize i = len__Vec(*scope->value.enum_obj->attached); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           get_name__SymbolTable(
-                             get__Vec(*scope->value.enum_obj->attached, i)),
-                           false))
-                return get__Vec(*scope->value.enum_obj->attached, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.enum_obj->index,
+                           scope->value.enum_obj->variants,
+                           scope->value.enum_obj->attached,
+                           id->value.identifier);
 
-    assert(0 && "error: unknown field");
+    if (!item)
+        assert(0 && "error: unknown field");
 
-    return NULL;
+    return item;
 }
 
 struct SymbolTable *
@@ -3546,32 +4720,19 @@ search_record_obj_item_in_scope(struct Typecheck *self,
                                 struct Expr *id,
                                 struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.record_obj->fields); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           ((struct SymbolTable *)get__Vec(
-                              *scope->value.record_obj->fields, i))
-                             ->value.field->name,
-                           false))
-                return get__Vec(*scope->value.record_obj->fields, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
 
-    for (Usize i = len__Vec(*scope->value.record_obj->attached); i--;) {
-        if (id->kind == TokenKindIdentifier) {
-            if (eq__String(id->value.identifier,
-                           get_name__SymbolTable(
-                             get__Vec(*scope->value.record_obj->attached, i)),
-                           false))
-                return get__Vec(*scope->value.record_obj->attached, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.record_obj->index,
+                           scope->value.record_obj->fields,
+                           scope->value.record_obj->attached,
+                           id->value.identifier);
 
-    assert(0 && "error: unknown field");
+    if (!item)
+        assert(0 && "error: unknown field");
 
-    return NULL;
+    return item;
 }
 
 struct SymbolTable *
@@ -3579,20 +4740,19 @@ search_class_item_in_scope(struct Typecheck *self,
                            struct Expr *id,
                            struct SymbolTable *scope)
 {
-    for (Usize i = len__Vec(*scope->value.class->body); i--;) {
-        if (id->kind == ExprKindIdentifier) {
-            if (eq__String(
-                  id->value.identifier,
-                  get_name__SymbolTable(get__Vec(*scope->value.class->body, i)),
-                  false))
-                return get__Vec(*scope->value.class->body, i);
-        } else
-            UNREACHABLE("only identifier expression is expected");
-    }
+    if (id->kind != ExprKindIdentifier)
+        UNREACHABLE("only identifier expression is expected");
 
-    assert(0 && "error: unknown property or method");
+    struct SymbolTable *item =
+      search_item_in_scope(&scope->value.class->index,
+                           scope->value.class->body,
+                           NULL,
+                           id->value.identifier);
 
-    return NULL;
+    if (!item)
+        assert(0 && "error: unknown property or method");
+
+    return item;
 }
 
 struct SymbolTable *
@@ -3674,17 +4834,12 @@ search_in_custom_scope(struct Typecheck *self,
     return NULL;
 }
 
-struct Vec *
+struct FunSymbol *
 search_in_funs_from_fun_call(struct Typecheck *self, struct Expr *id)
 {
-    if (id->kind == ExprKindIdentifier) {
-        for (Usize i = len__Vec(*self->funs); i--;) {
-            if (eq__String(((struct FunSymbol *)get__Vec(*self->funs, i))->name,
-                           id->value.identifier,
-                           false))
-                return get__Vec(*self->funs, i);
-        }
-    } else if (id->kind == ExprKindIdentifierAccess) {
+    if (id->kind == ExprKindIdentifier)
+        return search_in_funs_from_name(self, id->value.identifier);
+    else if (id->kind == ExprKindIdentifierAccess) {
         /* struct Scope *scope = search_in_modules_from_name(
           self,
           id->value.identifier_access,
@@ -3692,8 +4847,45 @@ search_in_funs_from_fun_call(struct Typecheck *self, struct Expr *id)
                                         .search_type = false,
                                         .search_value = false,
                                         .search_variant = false }); */
-    } else
-        assert(0 && "error");
+    }
+
+    return NULL;
+}
+
+// The fields of a record are few, so they are searched in order, the id is
+// the position of the field in the record.
+struct FieldRecordSymbol *
+search_field_in_data_type(struct Typecheck *self,
+                          struct DataTypeSymbol *data_type,
+                          struct String *name,
+                          Usize *id)
+{
+    if (!data_type || data_type->kind != DataTypeKindCustom ||
+        !data_type->scope ||
+        data_type->scope->item_kind != ScopeItemKindRecord ||
+        data_type->scope->filename !=
+          self->parser.parse_block.scanner.src->file.name ||
+        !self->records)
+        return NULL;
+
+    struct RecordSymbol *record =
+      get__Vec(*self->records, data_type->scope->id);
+
+    if (!record->fields)
+        return NULL;
+
+    for (Usize i = 0; i < len__Vec(*record->fields); i++) {
+        struct FieldRecordSymbol *field =
+          ((struct SymbolTable *)get__Vec(*record->fields, i))->value.field;
+
+        if (eq__String(field->name, name, false)) {
+            *id = i;
+
+            return field;
+        }
+    }
+
+    return NULL;
 }
 
 struct Vec *
@@ -3740,56 +4932,39 @@ check_data_type(
                 if (len__Vec(
                       *(struct Vec *)data_type->value.custom->items[0]) == 1) {
                     if (!local_decl) {
-                        struct EnumSymbol *enum_ = search_in_enums_from_name(
+                        struct ScopeIndexItem *item = resolve(
                           self,
                           get__Vec(
                             (*(struct Vec *)data_type->value.custom->items[0]),
                             0));
-                        struct RecordSymbol *record =
-                          !enum_
-                            ? search_in_records_from_name(
-                                self,
-                                get__Vec((*(struct Vec *)
-                                             data_type->value.custom->items[0]),
-                                         0))
-                            : NULL;
-                        struct EnumObjSymbol *enum_obj =
-                          !record && !enum_
-                            ? search_in_enums_obj_from_name(
-                                self,
-                                get__Vec((*(struct Vec *)
-                                             data_type->value.custom->items[0]),
-                                         0))
-                            : NULL;
+
+                        if (item)
+                            signature_of(self, item);
+
+#define RESOLVED(k) \
+    (item && item->kind == ScopeItemKind##k ? item->symbol : NULL)
+
+                        struct EnumSymbol *enum_ = RESOLVED(Enum);
+                        struct RecordSymbol *record = RESOLVED(Record);
+                        struct EnumObjSymbol *enum_obj = RESOLVED(EnumObj);
                         struct RecordObjSymbol *record_obj =
-                          !enum_ && !record && !enum_obj
-                            ? search_in_records_obj_from_name(
-                                self,
-                                get__Vec((*(struct Vec *)
-                                             data_type->value.custom->items[0]),
-                                         0))
-                            : NULL;
-                        struct ClassSymbol *class =
-                          !enum_ && !record && !enum_obj && !record_obj
-                            ? search_in_classes_from_name(
-                                self,
-                                get__Vec((*(struct Vec *)
-                                             data_type->value.custom->items[0]),
-                                         0))
-                            : NULL;
-                        struct TraitSymbol *trait =
-                          !enum_ && !record && !enum_obj && !record_obj &&
-                              !class
-                            ? search_in_traits_from_name(
-                                self,
-                                get__Vec((*(struct Vec *)
-                                             data_type->value.custom->items[0]),
-                                         0))
-                            : NULL;
+                          RESOLVED(RecordObj);
+                        struct ClassSymbol *class = RESOLVED(Class);
+                        struct TraitSymbol *trait = RESOLVED(Trait);
+                        struct AliasSymbol *alias = RESOLVED(Alias);
+
+#undef RESOLVED
+
                         struct Vec *generic_params = NULL;
 
                         if (!data_type->value.custom->items[1]) {
                         return_data_type : {
+                            // The generic params of an alias are not
+                            // substituted yet, only an alias without generic
+                            // params is replaced by its data type.
+                            if (alias && !alias->generic_params)
+                                return alias->data_type;
+
                             if (!enum_ && !record && !enum_obj && !record_obj &&
                                 !class && !trait) {
                                 if (len__Vec(*(struct Vec *)data_type->value
@@ -3808,6 +4983,7 @@ check_data_type(
                                               false)) {
                                             return NEW(
                                               DataTypeSymbolCustom,
+                                              self->types,
                                               generic_params,
                                               NULL,
                                               NEW(
@@ -3841,16 +5017,18 @@ check_data_type(
                                         data_type->value.custom->items[0]),
                                     0));
 
-                                emit__Diagnostic(err); */
+                                emit_diagnostic(err); */
 
                                 return NULL;
                             } else if (enum_ && ctx.search_type) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            enum_->scope);
                             } else if (record && ctx.search_type) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            record->scope);
@@ -3875,28 +5053,32 @@ check_data_type(
                                   from__String(""),
                                   None());
 
-                                emit__Diagnostic(err);
-                                emit__Diagnostic(note);
+                                emit_diagnostic(err);
+                                emit_diagnostic(note);
 
                                 return NULL;
                             } else if (enum_obj) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            enum_obj->scope);
 
                             } else if (record_obj) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            record_obj->scope);
                             } else if (class) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            class->scope);
                             } else if (trait && ctx.search_trait) {
                                 return NEW(DataTypeSymbolCustom,
+                                           self->types,
                                            generic_params,
                                            NULL,
                                            trait->scope);
@@ -3937,6 +5119,7 @@ check_data_type(
                             .search_primary_type = false
                         };
                         /* return NEW(DataTypeSymbolCustom,
+                                   self->types,
                                    data_type->value.custom->items[1],
                                    NULL,
                                    search_in_modules_from_name(
@@ -3957,7 +5140,7 @@ check_data_type(
                       from__String(""),
                       None());
 
-                emit__Diagnostic(err);
+                emit_diagnostic(err);
 
                 return NULL;
             }
@@ -3966,9 +5149,10 @@ check_data_type(
     } else {
         switch (data_type->kind) {
             case DataTypeKindSelf:
-                return NEW(DataTypeSymbol, DataTypeKindSelf);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindSelf);
             case DataTypeKindPtr:
                 return NEW(DataTypeSymbolPtr,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.ptr,
@@ -3977,6 +5161,7 @@ check_data_type(
                                            ctx));
             case DataTypeKindRef:
                 return NEW(DataTypeSymbolRef,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.ref,
@@ -3984,49 +5169,50 @@ check_data_type(
                                            local_decl,
                                            ctx));
             case DataTypeKindStr:
-                return NEW(DataTypeSymbol, DataTypeKindStr);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindStr);
             case DataTypeKindBitStr:
-                return NEW(DataTypeSymbol, DataTypeKindBitStr);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindBitStr);
             case DataTypeKindChar:
-                return NEW(DataTypeSymbol, DataTypeKindChar);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindChar);
             case DataTypeKindBitChar:
-                return NEW(DataTypeSymbol, DataTypeKindBitChar);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindBitChar);
             case DataTypeKindI8:
-                return NEW(DataTypeSymbol, DataTypeKindI8);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindI8);
             case DataTypeKindI16:
-                return NEW(DataTypeSymbol, DataTypeKindI16);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindI16);
             case DataTypeKindI32:
-                return NEW(DataTypeSymbol, DataTypeKindI32);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindI32);
             case DataTypeKindI64:
-                return NEW(DataTypeSymbol, DataTypeKindI64);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindI64);
             case DataTypeKindI128:
-                return NEW(DataTypeSymbol, DataTypeKindI128);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindI128);
             case DataTypeKindU8:
-                return NEW(DataTypeSymbol, DataTypeKindU8);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindU8);
             case DataTypeKindU16:
-                return NEW(DataTypeSymbol, DataTypeKindU16);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindU16);
             case DataTypeKindU32:
-                return NEW(DataTypeSymbol, DataTypeKindU32);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindU32);
             case DataTypeKindU64:
-                return NEW(DataTypeSymbol, DataTypeKindU64);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindU64);
             case DataTypeKindU128:
-                return NEW(DataTypeSymbol, DataTypeKindU128);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindU128);
             case DataTypeKindF32:
-                return NEW(DataTypeSymbol, DataTypeKindF32);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindF32);
             case DataTypeKindF64:
-                return NEW(DataTypeSymbol, DataTypeKindF64);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindF64);
             case DataTypeKindBool:
-                return NEW(DataTypeSymbol, DataTypeKindBool);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindBool);
             case DataTypeKindIsize:
-                return NEW(DataTypeSymbol, DataTypeKindIsize);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindIsize);
             case DataTypeKindUsize:
-                return NEW(DataTypeSymbol, DataTypeKindUsize);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindUsize);
             case DataTypeKindAny:
-                return NEW(DataTypeSymbol, DataTypeKindAny);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindAny);
             case DataTypeKindNever:
-                return NEW(DataTypeSymbol, DataTypeKindNever);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindNever);
             case DataTypeKindOptional:
                 return NEW(DataTypeSymbolOptional,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.optional,
@@ -4034,9 +5220,10 @@ check_data_type(
                                            local_decl,
                                            ctx));
             case DataTypeKindUnit:
-                return NEW(DataTypeSymbol, DataTypeKindUnit);
+                return NEW(DataTypeSymbol, self->types, DataTypeKindUnit);
             case DataTypeKindException:
                 return NEW(DataTypeSymbolException,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.optional,
@@ -4045,6 +5232,7 @@ check_data_type(
                                            ctx));
             case DataTypeKindMut:
                 return NEW(DataTypeSymbolMut,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.mut,
@@ -4054,9 +5242,11 @@ check_data_type(
             case DataTypeKindLambda: {
                 struct Vec *params = NEW(Vec, sizeof(struct DataTypeSymbol));
 
-                for (Usize i = len__Vec(
-                       *(struct Vec *)data_type->value.lambda->items[0]);
-                     i--;)
+                // The params are in the order of the lambda: |A -> B -> C|.
+                for (Usize i = 0;
+                     i < len__Vec(
+                           *(struct Vec *)data_type->value.lambda->items[0]);
+                     i++)
                     push__Vec(
                       params,
                       check_data_type(
@@ -4069,6 +5259,7 @@ check_data_type(
                         ctx));
 
                 return NEW(DataTypeSymbolLambda,
+                           self->types,
                            params,
                            check_data_type(self,
                                            data_type_loc,
@@ -4079,6 +5270,7 @@ check_data_type(
             }
             case DataTypeKindArray:
                 return NEW(DataTypeSymbolArray,
+                           self->types,
                            check_data_type(self,
                                            data_type_loc,
                                            data_type->value.array->items[0],
@@ -4099,7 +5291,7 @@ check_data_type(
                                       local_decl,
                                       ctx));
 
-                return NEW(DataTypeSymbolTuple, tuple);
+                return NEW(DataTypeSymbolTuple, self->types, tuple);
             }
             case DataTypeKindCustom:
                 goto custom_data_type;
@@ -4114,7 +5306,7 @@ check_data_type(
 struct StmtSymbol
 check_stmt(struct Typecheck *self,
            struct Stmt *stmt,
-           struct Vec *local_value,
+           struct LocalScopeChain *local_value,
            bool is_return_type)
 {
     switch (stmt->kind) {
@@ -4134,7 +5326,7 @@ check_stmt(struct Typecheck *self,
 struct DataTypeSymbol *
 get_data_type_of_expression(struct Typecheck *self,
                             struct ExprSymbol *expr,
-                            struct Vec *local_value)
+                            struct LocalScopeChain *local_value)
 {
     switch (expr->kind) {
         case ExprKindUnaryOp:
@@ -4148,6 +5340,9 @@ get_data_type_of_expression(struct Typecheck *self,
         case ExprKindRecordCall:
             TODO("get data type of record call");
         case ExprKindIdentifier:
+            if (expr->data_type)
+                return expr->data_type;
+
             TODO("get data type of identifier");
         case ExprKindIdentifierAccess:
             TODO("get data type of identifier access");
@@ -4156,13 +5351,13 @@ get_data_type_of_expression(struct Typecheck *self,
         case ExprKindTupleAccess:
             TODO("get data type of tuple access");
         case ExprKindLambda:
-            TODO("get data type of lambda");
+            return expr->data_type;
         case ExprKindTuple:
             TODO("get data type of tuple");
         case ExprKindArray:
             TODO("get data type of array");
         case ExprKindVariant:
-            TODO("get data type of variant");
+            return expr->data_type;
         case ExprKindTry:
             TODO("get data type of try");
         case ExprKindIf:
@@ -4234,7 +5429,7 @@ get_builtin_module_name_from_data_type(struct DataTypeSymbol *dt)
         case DataTypeKindUsize:
             return "Usize";
         case DataTypeKindOptional:
-            return "Optonal";
+            return "Optional";
         case DataTypeKindArray:
             return "Array";
         case DataTypeKindTuple:
@@ -4246,37 +5441,54 @@ get_builtin_module_name_from_data_type(struct DataTypeSymbol *dt)
     }
 }
 
-struct BuiltinFun *
+const struct BuiltinFun *
 search_fun_builtin(struct Typecheck *self,
                    const Str module_name,
                    const Str fun_name,
                    Usize param_count)
 {
-    struct BuiltinModule *module = NULL;
-
-    for (Usize i = len__Vec(*self->builtins); i--;)
-        if (!strcmp(
-              ((struct Builtin *)get__Vec(*self->builtins, i))->module->name,
-              module_name)) {
-            module = get__Vec(*self->builtins, i);
-            break;
-        }
-
-    assert(module && "module is not found");
+    // The data types without builtin module (custom data types, ...) have no
+    // builtin operator.
+    if (!module_name)
+        return NULL;
 
-    for (Usize i = len__Vec(*module->items); i--;)
-        if (!strcmp(((struct BuiltinFun *)get__Vec(*module->items, i))->name,
-                    fun_name) &&
-            param_count ==
-              len__Vec(
-                *((struct Builtin *)get__Vec(*module->items, i))->fun->params))
-            return ((struct BuiltinFun *)get__Vec(*module->items, i));
+    return search__BuiltinTable(
+      self->builtins, module_name, fun_name, param_count);
+}
 
-    assert(0 && "fun is not found");
+// The param accepts any data type: 'A, mut 'A, ?'A, ('A...), []'A, ...
+bool
+is_compiler_defined_param(struct DataTypeSymbol *param)
+{
+    switch (param->kind) {
+        case DataTypeKindCompilerDefined:
+            return true;
+        case DataTypeKindMut:
+            return is_compiler_defined_param(param->value.mut);
+        case DataTypeKindException:
+            return is_compiler_defined_param(param->value.exception);
+        case DataTypeKindOptional:
+            return is_compiler_defined_param(param->value.optional);
+        case DataTypeKindPtr:
+            return is_compiler_defined_param(param->value.ptr);
+        case DataTypeKindRef:
+            return is_compiler_defined_param(param->value.ref);
+        case DataTypeKindTuple:
+            return param->value.tuple && len__Vec(*param->value.tuple) > 0 &&
+                   is_compiler_defined_param(get__Vec(*param->value.tuple, 0));
+        case DataTypeKindArray:
+            return is_compiler_defined_param(param->value.array->items[0]);
+        default:
+            return false;
+    }
 }
 
+// The variadic arguments are the data types of the params followed by the
+// defined data type of the result (NULL when it is not known).
 void
-verify_type_of_fun_builtin(struct BuiltinFun *fun_builtin,
+verify_type_of_fun_builtin(struct Typecheck *self,
+                           struct Location loc,
+                           const struct BuiltinFun *fun_builtin,
                            Usize param_count,
                            ...)
 {
@@ -4284,66 +5496,29 @@ verify_type_of_fun_builtin(struct BuiltinFun *fun_builtin,
 
     va_start(vl, param_count);
 
-    for (Usize i = param_count; i--;) {
-        if (((struct DataTypeSymbol *)get__Vec(*fun_builtin->params, i)) !=
-            NULL) {
-            if (((struct DataTypeSymbol *)get__Vec(*fun_builtin->params, i))
-                  ->kind != DataTypeKindCompilerDefined) {
-                struct DataTypeSymbol *params =
-                  va_arg(vl, struct DataTypeSymbol *);
-
-                switch (params->kind) {
-                    case DataTypeKindMut:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *fun_builtin->params, i))
-                              ->value.mut->kind == DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindException:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *fun_builtin->params, i))
-                              ->value.exception->kind ==
-                            DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindOptional:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *fun_builtin->params, i))
-                              ->value.optional->kind ==
-                            DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindPtr:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *fun_builtin->params, i))
-                              ->value.ptr->kind == DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindRef:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *fun_builtin->params, i))
-                              ->value.ref->kind == DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindTuple:
-                        if (((struct DataTypeSymbol *)get__Vec(
-                               *((struct DataTypeSymbol *)get__Vec(
-                                   *fun_builtin->params, i))
-                                  ->value.tuple,
-                               0))
-                              ->kind == DataTypeKindCompilerDefined)
-                            return;
-                    case DataTypeKindArray:
-                        if (((struct DataTypeSymbol
-                                *)((struct DataTypeSymbol *)get__Vec(
-                                     *fun_builtin->params, i))
-                               ->value.array->items[0])
-                              ->kind == DataTypeKindCompilerDefined)
-                            return;
-                    default:
-                        break;
-                }
-                if (((struct DataTypeSymbol *)get__Vec(*fun_builtin->params,
-                                                       i)) !=
-                    va_arg(vl, struct DataTypeSymbol *))
-                    assert(0 && "error");
-            }
-        }
+    for (Usize i = 0; i < param_count; i++) {
+        struct DataTypeSymbol *param = get__Vec(*fun_builtin->params, i);
+        struct DataTypeSymbol *arg = va_arg(vl, struct DataTypeSymbol *);
+
+        // The value of a mutable param is assigned.
+        if (param->kind == DataTypeKindMut)
+            param = param->value.mut;
+
+        if (!arg || arg == param || arg->kind == DataTypeKindCompilerDefined ||
+            is_compiler_defined_param(param))
+            continue;
+
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyError, LilyErrorUnmatchedDataType),
+              loc,
+              from__String(""),
+              None());
+
+        emit_diagnostic(err);
+
+        break;
     }
 
     va_end(vl);
@@ -4355,8 +5530,12 @@ get_return_type_of_fun_builtin(struct Typecheck *self,
                                const Str fun_name,
                                Usize param_count)
 {
-    struct BuiltinFun *fun =
+    const struct BuiltinFun *fun =
       search_fun_builtin(self, module_name, fun_name, param_count);
+
+    if (!fun)
+        return NULL;
+
     struct DataTypeSymbol *dt = get__Vec(*fun->params, fun->params->len - 1);
 
     if (dt->kind == DataTypeKindCompilerDefined)
@@ -4366,59 +5545,215 @@ get_return_type_of_fun_builtin(struct Typecheck *self,
 }
 
 struct Scope *
-search_in_fun_local_value(struct Vec *local_value, struct String *id)
+search_in_fun_local_value(struct LocalScopeChain *local_value,
+                          struct String *id)
 {
-    struct Scope *value = NULL;
-
-    for (Usize i = len__Vec(*local_value); i--;) {
-        if (eq__String(
-              ((struct Scope *)get__Vec(*local_value, i))->name, id, false))
-            return get__Vec(*local_value, i);
-    }
+    if (!local_value)
+        return NULL;
 
-    return value;
+    return get__LocalScopeChain(local_value, id);
 }
 
 struct Scope *
 search_value_in_function(struct Typecheck *self,
-                         struct Vec *local_value,
+                         struct LocalScopeChain *local_value,
                          struct String *id,
                          struct Vec *id_access)
 {
-    if (id) {
-        struct Scope *found_local_value =
-          search_in_fun_local_value(local_value, id);
+    if (!id)
+        return NULL;
 
-        if (!found_local_value) {
-            assert(0 && "error");
-        } else if (found_local_value)
-            return found_local_value;
-    } else if (id_access) {
-    }
+    struct Scope *scope = search_in_fun_local_value(local_value, id);
 
-    return NULL;
+    if (scope)
+        add_capture(scope);
+
+    return scope;
+}
+
+// The value is captured by the lambdas being checked which are nested in its
+// lexical scope.
+void
+add_capture(struct Scope *scope)
+{
+    for (struct LambdaContext *lambda = current_lambda;
+         lambda && scope->depth < lambda->depth;
+         lambda = lambda->previous) {
+        bool is_captured = false;
+
+        for (Usize i = 0; i < len__Vec(*lambda->captures) && !is_captured;
+             i++) {
+            struct Scope *capture = get__Vec(*lambda->captures, i);
+
+            is_captured = capture->depth == scope->depth &&
+                          capture->id == scope->id &&
+                          eq__String(capture->name, scope->name, false);
+        }
+
+        if (!is_captured)
+            push__Vec(lambda->captures, copy__Scope(scope));
+    }
 }
 
 struct DataTypeSymbol *
 check_if_defined_data_type_is_equal_to_infered_data_type(
   struct Typecheck *self,
+  struct FunSymbol *fun,
+  struct Location loc,
   struct DataTypeSymbol *defined_data_type,
   struct DataTypeSymbol *infered_data_type)
 {
-    if (defined_data_type)
-        if (defined_data_type == infered_data_type) {
-            assert(0 && "error");
-            return NULL;
+    if (!defined_data_type || !infered_data_type)
+        return infered_data_type;
+
+    // In a function, the CompilerDefined data types (undef, the pointee of
+    // nil, ...) are type variables bound by the defined data type.
+    if (fun && fun->infer) {
+        Usize infered = from_data_type__Infer(fun->infer, infered_data_type);
+
+        if (unify__Infer(fun->infer,
+                         from_data_type__Infer(fun->infer, defined_data_type),
+                         infered) == InferResultOk)
+            return to_data_type__Infer(fun->infer, infered);
+    } else if (eq__DataTypeSymbol(defined_data_type, infered_data_type))
+        return infered_data_type;
+
+    struct Diagnostic *err =
+      NEW(DiagnosticWithErrTypecheck,
+          self,
+          NEW(LilyError, LilyErrorUnmatchedDataType),
+          loc,
+          from__String(""),
+          None());
+
+    emit_diagnostic(err);
+
+    return defined_data_type;
+}
+
+struct FunParamSymbol *
+search_param_in_function(struct FunSymbol *fun, struct Scope *scope)
+{
+    if (!fun->params || !scope || scope->item_kind != ScopeItemKindParam)
+        return NULL;
+
+    for (Usize i = 0; i < len__Vec(*fun->params); i++) {
+        struct FunParamSymbol *param = get__Vec(*fun->params, i);
+
+        if (eq__String(param->name, scope->name, false))
+            return param;
+    }
+
+    return NULL;
+}
+
+Usize
+get_infer_node_of_expression(struct FunSymbol *fun, struct ExprSymbol *expr)
+{
+    if (expr->kind == ExprKindIdentifier) {
+        struct FunParamSymbol *param =
+          search_param_in_function(fun, expr->value.identifier);
+
+        if (param)
+            return param->data_type_var;
+    }
+
+    // x + y has the data type of its operands (unified by check_binary_op):
+    // fun add(x, y) = x + y returns the data type of x and y.
+    if (expr->kind == ExprKindBinaryOp &&
+        has_operand_data_type(expr->value.binary_op.kind))
+        return get_infer_node_of_expression(fun, expr->value.binary_op.left);
+
+    return expr->data_type ? from_data_type__Infer(fun->infer, expr->data_type)
+                           : fresh__Infer(fun->infer);
+}
+
+void
+infer_return_type(struct Typecheck *self,
+                  struct FunSymbol *fun,
+                  struct ExprSymbol *expr)
+{
+    if (!fun->infer || !expr)
+        return;
+
+    switch (unify__Infer(fun->infer,
+                         fun->return_type_var,
+                         get_infer_node_of_expression(fun, expr))) {
+        case InferResultOk:
+            break;
+        case InferResultMismatch: {
+            struct Diagnostic *err =
+              NEW(DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyError, LilyErrorUnmatchedDataType),
+                  expr->loc,
+                  from__String(""),
+                  Some(from__String("unmatched return data type")));
+
+            emit_diagnostic(err);
+
+            break;
+        }
+        case InferResultOccurs: {
+            struct Diagnostic *err =
+              NEW(DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyError, LilyErrorUnmatchedDataType),
+                  expr->loc,
+                  from__String(""),
+                  Some(from__String("the return data type is infinite")));
+
+            emit_diagnostic(err);
+
+            break;
+        }
+    }
+}
+
+// The data types of the params and of the return which are still unknown after
+// the body are the implicit generic params of the function (the
+// CompilerDefined data type T). A return data type which is never constrained
+// stays Unit.
+void
+generalize_fun_signature(struct FunSymbol *fun)
+{
+    struct Infer *infer = fun->infer;
+    Usize return_root = find__Infer(infer, fun->return_type_var);
+    bool is_return_used = infer->nodes[return_root].kind == InferNodeKindType;
+
+    exit__Infer(infer);
+
+    if (fun->params)
+        for (Usize i = 0; i < len__Vec(*fun->params); i++) {
+            struct FunParamSymbol *param = get__Vec(*fun->params, i);
+
+            generalize__Infer(infer, param->data_type_var);
+
+            if (find__Infer(infer, param->data_type_var) == return_root)
+                is_return_used = true;
+
+            if (!param->param_data_type)
+                param->param_data_type = NEW(
+                  Tuple,
+                  2,
+                  to_data_type__Infer(infer, param->data_type_var),
+                  &param->loc);
         }
 
-    return infered_data_type;
+    generalize__Infer(infer, fun->return_type_var);
+
+    if (!fun->return_type && is_return_used)
+        fun->return_type = to_data_type__Infer(infer, fun->return_type_var);
+
+    FREE(Infer, fun->infer);
+    fun->infer = NULL;
 }
 
 struct DataTypeSymbol *
 infer_expression(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Expr *expr,
-                 struct Vec *local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type,
                  struct DataTypeSymbol *defined_data_type,
                  bool is_return_type)
@@ -4428,8 +5763,20 @@ infer_expression(struct Typecheck *self,
             TODO("infer fun call");
         case ExprKindRecordCall:
             TODO("infer record call");
-        case ExprKindIdentifier:
+        case ExprKindIdentifier: {
+            struct FunParamSymbol *param =
+              fun && fun->infer
+                ? search_param_in_function(
+                    fun,
+                    search_value_in_function(
+                      self, local_value, expr->value.identifier, NULL))
+                : NULL;
+
+            if (param)
+                return to_data_type__Infer(fun->infer, param->data_type_var);
+
             TODO("infer identifier");
+        }
         case ExprKindIdentifierAccess:
             TODO("infer identifier access");
         case ExprKindGlobalAccess:
@@ -4442,7 +5789,7 @@ infer_expression(struct Typecheck *self,
             TODO("infer lambda");
         case ExprKindTuple: {
             if (defined_data_type)
-                return copy__DataTypeSymbol(defined_data_type);
+                return defined_data_type;
             else {
                 struct Vec *dts = NEW(Vec, sizeof(struct DataTypeSymbol));
 
@@ -4456,13 +5803,24 @@ infer_expression(struct Typecheck *self,
                                                NULL,
                                                is_return_type));
 
-                return NEW(DataTypeSymbolTuple, dts);
+                return NEW(DataTypeSymbolTuple, self->types, dts);
             }
         }
         case ExprKindArray:
             TODO("infer array");
-        case ExprKindVariant:
-            TODO("infer variant");
+        case ExprKindVariant: {
+            struct EnumSymbol *enum_ = NULL;
+
+            if (search_variant(
+                  self, expr->value.variant.id, defined_data_type, &enum_) !=
+                -1)
+                return NEW(
+                  DataTypeSymbolCustom, self->types, NULL, NULL, enum_->scope);
+
+            return NEW(DataTypeSymbolCompilerDefined,
+                       self->types,
+                       NEW(CompilerDefinedDataType, "T", false));
+        }
         case ExprKindTry:
             TODO("infer try");
         case ExprKindIf:
@@ -4472,6 +5830,7 @@ infer_expression(struct Typecheck *self,
         case ExprKindQuestionMark:
             if (defined_data_type)
                 return NEW(DataTypeSymbolOptional,
+                           self->types,
                            infer_expression(self,
                                             fun,
                                             expr->value.question_mark,
@@ -4481,6 +5840,7 @@ infer_expression(struct Typecheck *self,
                                             is_return_type));
             else
                 return NEW(DataTypeSymbolOptional,
+                           self->types,
                            infer_expression(self,
                                             fun,
                                             expr->value.question_mark,
@@ -4491,6 +5851,7 @@ infer_expression(struct Typecheck *self,
         case ExprKindDereference:
             if (defined_data_type)
                 return NEW(DataTypeSymbolPtr,
+                           self->types,
                            infer_expression(self,
                                             fun,
                                             expr->value.dereference,
@@ -4500,6 +5861,7 @@ infer_expression(struct Typecheck *self,
                                             is_return_type));
             else
                 return NEW(DataTypeSymbolPtr,
+                           self->types,
                            infer_expression(self,
                                             fun,
                                             expr->value.dereference,
@@ -4509,6 +5871,7 @@ infer_expression(struct Typecheck *self,
                                             is_return_type));
         case ExprKindRef:
             return NEW(DataTypeSymbolRef,
+                       self->types,
                        infer_expression(self,
                                         fun,
                                         expr->value.ref,
@@ -4520,41 +5883,49 @@ infer_expression(struct Typecheck *self,
             TODO("infer self");
         case ExprKindUndef:
             return NEW(DataTypeSymbolCompilerDefined,
+                       self->types,
                        NEW(CompilerDefinedDataType, "T", false));
         case ExprKindNil:
             return NEW(DataTypeSymbolPtr,
+                       self->types,
                        NEW(DataTypeSymbolCompilerDefined,
+                           self->types,
                            NEW(CompilerDefinedDataType, "T", false)));
         case ExprKindNone:
             return NEW(DataTypeSymbolOptional,
+                       self->types,
                        NEW(DataTypeSymbolCompilerDefined,
+                           self->types,
                            NEW(CompilerDefinedDataType, "T", false)));
         case ExprKindWildcard:
             break;
         case ExprKindLiteral:
             switch (expr->value.literal.kind) {
                 case LiteralKindBool:
-                    return NEW(DataTypeSymbol, DataTypeKindBool);
+                    return NEW(DataTypeSymbol, self->types, DataTypeKindBool);
                 case LiteralKindChar:
-                    return NEW(DataTypeSymbol, DataTypeKindChar);
+                    return NEW(DataTypeSymbol, self->types, DataTypeKindChar);
                 case LiteralKindBitChar:
-                    return NEW(DataTypeSymbol, DataTypeKindU8);
+                    return NEW(DataTypeSymbol, self->types, DataTypeKindU8);
                 case LiteralKindInt32:
-                    return (NEW(DataTypeSymbol, DataTypeKindI32));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindI32));
                 case LiteralKindInt64:
-                    return (NEW(DataTypeSymbol, DataTypeKindI64));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindI64));
                 case LiteralKindInt128:
-                    return (NEW(DataTypeSymbol, DataTypeKindI128));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindI128));
                 case LiteralKindFloat:
-                    return (NEW(DataTypeSymbol, DataTypeKindF64));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindF64));
                 case LiteralKindBitStr:
                     return (NEW(DataTypeSymbolArray,
-                                NEW(DataTypeSymbol, DataTypeKindU8),
+                                self->types,
+                                NEW(DataTypeSymbol,
+                                    self->types,
+                                    DataTypeKindU8),
                                 NULL));
                 case LiteralKindStr:
-                    return (NEW(DataTypeSymbol, DataTypeKindStr));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindStr));
                 case LiteralKindUnit:
-                    return (NEW(DataTypeSymbol, DataTypeKindUnit));
+                    return (NEW(DataTypeSymbol, self->types, DataTypeKindUnit));
             }
         case ExprKindGrouping:
             return infer_expression(self,
@@ -4602,288 +5973,1465 @@ get_data_type_kind_from_literal_symbol(enum LiteralSymbolKind kind)
     return data_type_kind_from_literal_symbol_kind[(int)kind];
 }
 
-struct ExprSymbol *
-check_expression(struct Typecheck *self,
-                 struct FunSymbol *fun,
-                 struct Expr *expr,
-                 struct Vec *local_value,
-                 struct Vec *local_data_type,
-                 struct DataTypeSymbol *defined_data_type,
-                 bool is_return_type)
+// The literal is written without suffix (1, -2, (3.0)), its data type is
+// defined by the context.
+bool
+is_literal_without_suffix(struct Expr *expr)
 {
     switch (expr->kind) {
-        case ExprKindUnaryOp: {
-            struct ExprSymbol *right =
-              check_expression(self,
-                               fun,
-                               expr->value.unary_op.right,
-                               local_value,
-                               local_data_type,
-                               NULL,
-                               is_return_type);
+        case ExprKindLiteral:
+            switch (expr->value.literal.kind) {
+                case LiteralKindInt32WithoutSuffix:
+                case LiteralKindInt64WithoutSuffix:
+                case LiteralKindInt128WithoutSuffix:
+                case LiteralKindFloat:
+                    return true;
+                default:
+                    return false;
+            }
+        case ExprKindUnaryOp:
+            return expr->value.unary_op.kind == UnaryOpKindNegative &&
+                   is_literal_without_suffix(expr->value.unary_op.right);
+        case ExprKindGrouping:
+            return is_literal_without_suffix(expr->value.grouping);
+        default:
+            return false;
+    }
+}
 
-            right->data_type = infer_expression(self,
-                                                fun,
-                                                expr->value.unary_op.right,
-                                                local_value,
-                                                local_data_type,
-                                                defined_data_type,
-                                                is_return_type);
+// The numeric data type given to a literal without suffix, the other data
+// types are compared with the data type of the literal after its check.
+struct DataTypeSymbol *
+get_literal_defined_data_type(struct DataTypeSymbol *data_type)
+{
+    if (!data_type)
+        return NULL;
 
-            switch (expr->value.unary_op.kind) {
-                case UnaryOpKindReference: {
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, "Ref", "&", 2),
-                      2,
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+    switch (data_type->kind) {
+        case DataTypeKindMut:
+            return get_literal_defined_data_type(data_type->value.mut);
+        case DataTypeKindI8:
+        case DataTypeKindI16:
+        case DataTypeKindI32:
+        case DataTypeKindI64:
+        case DataTypeKindI128:
+        case DataTypeKindU8:
+        case DataTypeKindU16:
+        case DataTypeKindU32:
+        case DataTypeKindU64:
+        case DataTypeKindU128:
+        case DataTypeKindF32:
+        case DataTypeKindF64:
+            return data_type;
+        default:
+            return NULL;
+    }
+}
 
-                    struct DataTypeSymbol *return_type =
-                      get_return_type_of_fun_builtin(self, "Ref", "&", 2);
+bool
+has_same_data_type_operands(enum BinaryOpKind kind)
+{
+    switch (kind) {
+        case BinaryOpKindChain:
+        case BinaryOpKindMerge:
+        case BinaryOpKindUnmerge:
+        case BinaryOpKindMergeAssign:
+        case BinaryOpKindUnmergeAssign:
+        case BinaryOpKindRepeat:
+        case BinaryOpKindCustom:
+            return false;
+        default:
+            return true;
+    }
+}
 
-                    return NEW(
-                      ExprSymbolUnaryOp,
-                      *expr,
-                      NEW(UnaryOpSymbol, *expr, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        !return_type ? get_data_type_of_expression(
-                                         self, right, local_value)
-                                     : return_type));
-                }
-                case UnaryOpKindBitNot:
-                case UnaryOpKindNegative: {
-                    const Str module_name =
-                      get_builtin_module_name_from_data_type(
-                        get_data_type_of_expression(self, right, local_value));
-                    const Str op_str =
-                      to_str__UnaryOpKind(expr->value.unary_op.kind);
+// The result of the operator has the data type of its operands (x + y).
+bool
+has_operand_data_type(enum BinaryOpKind kind)
+{
+    switch (kind) {
+        case BinaryOpKindAdd:
+        case BinaryOpKindSub:
+        case BinaryOpKindMul:
+        case BinaryOpKindDiv:
+        case BinaryOpKindMod:
+        case BinaryOpKindExponent:
+        case BinaryOpKindBitLShift:
+        case BinaryOpKindBitRShift:
+        case BinaryOpKindBitOr:
+        case BinaryOpKindBitAnd:
+        case BinaryOpKindXor:
+            return true;
+        default:
+            return false;
+    }
+}
 
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, module_name, op_str, 2),
-                      2,
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+const Str
+get_builtin_module_name_of_binary_op(enum BinaryOpKind kind,
+                                     struct DataTypeSymbol *operand)
+{
+    switch (kind) {
+        case BinaryOpKindAnd:
+        case BinaryOpKindOr:
+            return "Bool";
+        case BinaryOpKindMerge:
+        case BinaryOpKindUnmerge:
+        case BinaryOpKindMergeAssign:
+        case BinaryOpKindUnmergeAssign:
+            return "Array";
+        case BinaryOpKindRepeat:
+        case BinaryOpKindConcat:
+        case BinaryOpKindConcatAssign:
+            return "Str";
+        default:
+            return get_builtin_module_name_from_data_type(operand);
+    }
+}
 
-                    return NEW(
-                      ExprSymbolUnaryOp,
-                      *expr,
-                      NEW(UnaryOpSymbol, *expr, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, module_name, op_str, 2)));
-                }
-                case UnaryOpKindNot:
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, "Bool", "not", 2),
-                      2,
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+// The data type of the result when the data type of the operands is only known
+// at the call of the function (fun add(x, y) = x + y).
+struct DataTypeSymbol *
+get_generic_data_type_of_binary_op(struct Typecheck *self,
+                                   enum BinaryOpKind kind,
+                                   struct DataTypeSymbol *operand)
+{
+    switch (kind) {
+        case BinaryOpKindLt:
+        case BinaryOpKindGt:
+        case BinaryOpKindLe:
+        case BinaryOpKindGe:
+        case BinaryOpKindEq:
+        case BinaryOpKindNe:
+        case BinaryOpKindAnd:
+        case BinaryOpKindOr:
+            return NEW(DataTypeSymbol, self->types, DataTypeKindBool);
+        case BinaryOpKindAssign:
+        case BinaryOpKindAddAssign:
+        case BinaryOpKindSubAssign:
+        case BinaryOpKindMulAssign:
+        case BinaryOpKindDivAssign:
+        case BinaryOpKindModAssign:
+        case BinaryOpKindConcatAssign:
+        case BinaryOpKindBitLShiftAssign:
+        case BinaryOpKindBitRShiftAssign:
+        case BinaryOpKindBitOrAssign:
+        case BinaryOpKindXorAssign:
+        case BinaryOpKindBitAndAssign:
+        case BinaryOpKindMergeAssign:
+        case BinaryOpKindUnmergeAssign:
+        case BinaryOpKindExponentAssign:
+            return NEW(DataTypeSymbol, self->types, DataTypeKindUnit);
+        default:
+            return operand;
+    }
+}
 
-                    return NEW(
-                      ExprSymbolUnaryOp,
-                      *expr,
-                      NEW(UnaryOpSymbol, *expr, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, "Bool", "not", 2)));
-                case UnaryOpKindCustom:
-                    TODO("check unary operator kind custom");
-            }
-        }
-        case ExprKindBinaryOp: {
-            struct ExprSymbol *left =
-              check_expression(self,
-                               fun,
-                               expr->value.binary_op.left,
-                               local_value,
-                               local_data_type,
-                               NULL,
-                               is_return_type);
+// T in fun add[T](x T, y T) T: the operators on a generic param are checked
+// when the function is specialized for the data types of the call (see
+// lang/ir), like the implicit generic params.
+bool
+is_generic_param_data_type(struct DataTypeSymbol *data_type)
+{
+    return data_type && data_type->kind == DataTypeKindCustom &&
+           data_type->scope &&
+           data_type->scope->item_kind == ScopeItemKindGeneric;
+}
 
-            struct ExprSymbol *right =
-              check_expression(self,
-                               fun,
-                               expr->value.binary_op.right,
-                               local_value,
-                               local_data_type,
-                               NULL,
-                               is_return_type);
-            const Str op_str = to_str__BinaryOpKind(expr->value.binary_op.kind);
+// The data type of a local value or of a param, the data type of a param is
+// the current solution of its type variable.
+struct DataTypeSymbol *
+get_data_type_of_local_value(struct FunSymbol *fun, struct Scope *scope)
+{
+    struct FunParamSymbol *param =
+      fun ? search_param_in_function(fun, scope) : NULL;
 
-            left->data_type = infer_expression(self,
-                                               fun,
-                                               expr->value.binary_op.left,
-                                               local_value,
-                                               local_data_type,
-                                               defined_data_type,
-                                               is_return_type);
-            right->data_type = infer_expression(self,
-                                                fun,
-                                                expr->value.binary_op.right,
-                                                local_value,
-                                                local_data_type,
-                                                defined_data_type,
-                                                is_return_type);
-
-            switch (expr->value.binary_op.kind) {
-                case BinaryOpKindAdd:
-                case BinaryOpKindSub:
-                case BinaryOpKindMul:
-                case BinaryOpKindDiv:
-                case BinaryOpKindMod:
-                case BinaryOpKindRange:
-                case BinaryOpKindLt:
-                case BinaryOpKindGt:
-                case BinaryOpKindLe:
-                case BinaryOpKindGe:
-                case BinaryOpKindEq:
-                case BinaryOpKindNe:
-                case BinaryOpKindAssign:
-                case BinaryOpKindAddAssign:
-                case BinaryOpKindSubAssign:
-                case BinaryOpKindMulAssign:
-                case BinaryOpKindDivAssign:
-                case BinaryOpKindModAssign:
-                case BinaryOpKindBitLShiftAssign:
-                case BinaryOpKindBitRShiftAssign:
-                case BinaryOpKindBitOrAssign:
-                case BinaryOpKindXorAssign:
-                case BinaryOpKindBitAndAssign:
-                case BinaryOpKindExponentAssign:
-                case BinaryOpKindBitLShift:
-                case BinaryOpKindBitRShift:
-                case BinaryOpKindBitOr:
-                case BinaryOpKindBitAnd:
-                case BinaryOpKindXor:
-                case BinaryOpKindExponent: {
-                    const Str module_name =
-                      get_builtin_module_name_from_data_type(
-                        get_data_type_of_expression(self, left, local_value));
-                    struct BuiltinFun *fun_builtin =
-                      search_fun_builtin(self, module_name, op_str, 3);
+    if (!param)
+        return scope->data_type;
+    else if (fun->infer)
+        return to_data_type__Infer(fun->infer, param->data_type_var);
 
-                    if (!fun_builtin)
-                        assert(0 && "error");
+    return param->param_data_type ? param->param_data_type->items[0] : NULL;
+}
 
-                    verify_type_of_fun_builtin(
-                      fun_builtin,
-                      3,
-                      get_data_type_of_expression(self, left, local_value),
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+void
+unify_expression(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct ExprSymbol *expr,
+                 struct DataTypeSymbol *data_type)
+{
+    if (!fun || !fun->infer || !data_type)
+        return;
+
+    if (unify__Infer(fun->infer,
+                     get_infer_node_of_expression(fun, expr),
+                     from_data_type__Infer(fun->infer, data_type)) !=
+        InferResultOk) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyError, LilyErrorUnmatchedDataType),
+              expr->loc,
+              from__String(""),
+              None());
 
-                    return NEW(
-                      ExprSymbolBinaryOp,
-                      *expr,
-                      NEW(BinaryOpSymbol, *expr, left, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, module_name, op_str, 3)));
-                }
-                case BinaryOpKindAnd:
-                case BinaryOpKindOr: {
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, "Bool", op_str, 3),
-                      3,
-                      get_data_type_of_expression(self, left, local_value),
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+        emit_diagnostic(err);
+    }
+}
 
-                    return NEW(
-                      ExprSymbolBinaryOp,
-                      *expr,
-                      NEW(BinaryOpSymbol, *expr, left, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, "Bool", op_str, 3)));
-                }
-                case BinaryOpKindMergeAssign:
-                case BinaryOpKindUnmergeAssign:
-                case BinaryOpKindMerge:
-                case BinaryOpKindUnmerge: {
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, "Array", op_str, 3),
-                      3,
-                      get_data_type_of_expression(self, left, local_value),
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+// The name is moved in the error.
+void
+emit_unknown_name(struct Typecheck *self,
+                  enum LilyErrorKind kind,
+                  struct Location loc,
+                  struct String *name)
+{
+    struct Diagnostic *err = NEW(DiagnosticWithErrTypecheck,
+                                 self,
+                                 NEW(LilyErrorWithString, kind, name),
+                                 loc,
+                                 from__String(""),
+                                 None());
+
+    emit_diagnostic(err);
+}
 
-                    return NEW(
-                      ExprSymbolBinaryOp,
-                      *expr,
-                      NEW(BinaryOpSymbol, *expr, left, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, "Array", op_str, 3)));
-                }
-                case BinaryOpKindChain:
-                    TODO("check chain binary op");
-                case BinaryOpKindRepeat:
-                case BinaryOpKindConcat:
-                case BinaryOpKindConcatAssign: {
-                    verify_type_of_fun_builtin(
-                      search_fun_builtin(self, "Str", op_str, 3),
-                      3,
-                      get_data_type_of_expression(self, left, local_value),
-                      get_data_type_of_expression(self, right, local_value),
-                      defined_data_type);
+struct ExprSymbol *
+check_binary_op(struct Typecheck *self,
+                struct FunSymbol *fun,
+                struct Expr *expr,
+                struct LocalScopeChain *local_value,
+                struct Vec *local_data_type,
+                struct DataTypeSymbol *defined_data_type,
+                bool is_return_type)
+{
+    enum BinaryOpKind kind = expr->value.binary_op.kind;
+    struct Expr *left_expr = expr->value.binary_op.left;
+    struct Expr *right_expr = expr->value.binary_op.right;
+    bool is_same_data_type = has_same_data_type_operands(kind);
+    struct DataTypeSymbol *operand_defined_data_type =
+      has_operand_data_type(kind) ? defined_data_type : NULL;
+    struct ExprSymbol *left = NULL;
+    struct ExprSymbol *right = NULL;
+
+    // The literal without suffix is checked with the data type of the other
+    // operand: x + 1, 1 + x.
+    if (is_same_data_type && is_literal_without_suffix(left_expr) &&
+        !is_literal_without_suffix(right_expr)) {
+        right = check_expression(self,
+                                 fun,
+                                 right_expr,
+                                 local_value,
+                                 local_data_type,
+                                 operand_defined_data_type,
+                                 is_return_type);
+        left = check_expression(self,
+                                fun,
+                                left_expr,
+                                local_value,
+                                local_data_type,
+                                get_literal_defined_data_type(right->data_type),
+                                is_return_type);
+    } else {
+        left = check_expression(self,
+                                fun,
+                                left_expr,
+                                local_value,
+                                local_data_type,
+                                is_literal_without_suffix(left_expr)
+                                  ? get_literal_defined_data_type(
+                                      operand_defined_data_type)
+                                  : operand_defined_data_type,
+                                is_return_type);
+        right = check_expression(
+          self,
+          fun,
+          right_expr,
+          local_value,
+          local_data_type,
+          is_same_data_type && is_literal_without_suffix(right_expr)
+            ? get_literal_defined_data_type(left->data_type)
+            : NULL,
+          is_return_type);
+    }
 
-                    return NEW(
-                      ExprSymbolBinaryOp,
-                      *expr,
-                      NEW(BinaryOpSymbol, *expr, left, right),
-                      check_if_defined_data_type_is_equal_to_infered_data_type(
-                        self,
-                        defined_data_type,
-                        get_return_type_of_fun_builtin(
-                          self, "Str", op_str, 3)));
-                }
-                case BinaryOpKindCustom:
-                    TODO("check binary op custom");
-            }
-        }
-        case ExprKindFunCall: {
-            TODO("check fun call");
+    struct DataTypeSymbol *operand = left->data_type;
+
+    switch (kind) {
+        case BinaryOpKindAnd:
+        case BinaryOpKindOr: {
+            struct DataTypeSymbol *bool_ =
+              NEW(DataTypeSymbol, self->types, DataTypeKindBool);
+
+            unify_expression(self, fun, left, bool_);
+            unify_expression(self, fun, right, bool_);
+
+            operand = bool_;
+
+            break;
         }
-        case ExprKindRecordCall:
-            TODO("check record call");
-        case ExprKindIdentifier:
-            return NEW(ExprSymbolIdentifier,
-                       *expr,
-                       search_value_in_function(
-                         self, local_value, expr->value.identifier, NULL),
-                       infer_expression(self,
+        case BinaryOpKindChain:
+            TODO("check chain binary op");
+        case BinaryOpKindCustom:
+            TODO("check binary op custom");
+        default:
+            if (is_same_data_type && fun && fun->infer) {
+                Usize left_node = get_infer_node_of_expression(fun, left);
+
+                if (unify__Infer(fun->infer,
+                                 left_node,
+                                 get_infer_node_of_expression(fun, right)) !=
+                    InferResultOk) {
+                    struct Diagnostic *err =
+                      NEW(DiagnosticWithErrTypecheck,
+                          self,
+                          NEW(LilyError, LilyErrorUnmatchedDataType),
+                          expr->loc,
+                          from__String(""),
+                          Some(from__String(
+                            "the operands have different data types")));
+
+                    emit_diagnostic(err);
+                }
+
+                operand = to_data_type__Infer(fun->infer, left_node);
+            }
+    }
+
+    struct DataTypeSymbol *data_type = NULL;
+
+    if (!operand || operand->kind == DataTypeKindCompilerDefined ||
+        is_generic_param_data_type(operand))
+        data_type = get_generic_data_type_of_binary_op(
+          self,
+          kind,
+          operand ? operand
+                  : NEW(DataTypeSymbolCompilerDefined,
+                        self->types,
+                        NEW(CompilerDefinedDataType, "T", false)));
+    else {
+        const Str module_name =
+          get_builtin_module_name_of_binary_op(kind, operand);
+        const Str op_str = to_str__BinaryOpKind(kind);
+        const struct BuiltinFun *fun_builtin =
+          search_fun_builtin(self, module_name, op_str, 3);
+
+        if (fun_builtin) {
+            verify_type_of_fun_builtin(self,
+                                       expr->loc,
+                                       fun_builtin,
+                                       2,
+                                       operand,
+                                       is_same_data_type ? operand
+                                                         : right->data_type);
+
+            data_type = get__Vec(*fun_builtin->params, 2);
+
+            if (data_type->kind == DataTypeKindCompilerDefined)
+                data_type = operand;
+        } else {
+            emit_unknown_name(self,
+                              LilyErrorUnknownFunction,
+                              expr->loc,
+                              module_name
+                                ? format("{s}.{s}", module_name, op_str)
+                                : format("{s}", op_str));
+
+            data_type = get_generic_data_type_of_binary_op(self, kind, operand);
+        }
+    }
+
+    return NEW(ExprSymbolBinaryOp,
+               *expr,
+               NEW(BinaryOpSymbol, *expr, left, right),
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self, fun, expr->loc, defined_data_type, data_type));
+}
+
+// A param or the return of the function has no data type, it's inferred from
+// the body.
+bool
+has_inferred_signature(const struct FunSymbol *fun)
+{
+    const struct FunDecl *fun_decl = fun->fun_decl->value.fun;
+
+    if (!fun_decl->return_type)
+        return true;
+
+    if (fun_decl->params)
+        for (Usize i = 0; i < len__Vec(*fun_decl->params); i++)
+            if (!((struct FunParam *)get__Vec(*fun_decl->params, i))
+                   ->param_data_type)
+                return true;
+
+    return false;
+}
+
+// The data type of the param of the called function. The body of a function
+// with a defined signature can be checked later or by another thread, only its
+// defined data types are read. An inferred signature is resolved before (see
+// check_fun).
+struct DataTypeSymbol *
+get_data_type_of_called_param(struct Typecheck *self,
+                              struct FunSymbol *fun,
+                              struct FunSymbol *callee,
+                              Usize id)
+{
+    struct FunParamSymbol *param = get__Vec(*callee->params, id);
+
+    if (callee == fun || has_inferred_signature(callee))
+        return get_data_type_of_local_value(callee, param->scope);
+
+    return param->param_data_type->items[0];
+}
+
+struct DataTypeSymbol *
+get_return_type_of_called_fun(struct Typecheck *self,
+                              struct FunSymbol *fun,
+                              struct FunSymbol *callee)
+{
+    if ((callee == fun || has_inferred_signature(callee)) && callee->infer)
+        return to_data_type__Infer(callee->infer, callee->return_type_var);
+
+    return callee->return_type
+             ? callee->return_type
+             : NEW(DataTypeSymbol, self->types, DataTypeKindUnit);
+}
+
+struct ExprSymbol *
+check_fun_call(struct Typecheck *self,
+               struct FunSymbol *fun,
+               struct Expr *expr,
+               struct LocalScopeChain *local_value,
+               struct Vec *local_data_type,
+               struct DataTypeSymbol *defined_data_type)
+{
+    struct FunCall *fun_call = &expr->value.fun_call;
+    // A local value hides the functions: f(x) calls the lambda held by f.
+    struct Scope *local =
+      fun_call->id->kind == ExprKindIdentifier
+        ? search_value_in_function(
+            self, local_value, fun_call->id->value.identifier, NULL)
+        : NULL;
+
+    if (local)
+        return check_closure_call(self,
+                                  fun,
+                                  expr,
+                                  local,
+                                  local_value,
+                                  local_data_type,
+                                  defined_data_type);
+
+    struct FunSymbol *callee = search_in_funs_from_fun_call(self, fun_call->id);
+    const struct BuiltinFun *fun_builtin = NULL;
+    Usize param_count = fun_call->params ? len__Vec(*fun_call->params) : 0;
+
+    // The functions of the Io module are called without prefix:
+    // println("{}", x).
+    if (!callee && fun_call->id->kind == ExprKindIdentifier) {
+        Str name = to_Str__String(*fun_call->id->value.identifier);
+
+        fun_builtin = search_fun_builtin(self, "Io", name, 3);
+
+        free(name);
+    }
+
+    if (!callee && !fun_builtin)
+        emit_unknown_name(self,
+                          LilyErrorUnknownFunction,
+                          fun_call->id->loc,
+                          fun_call->id->kind == ExprKindIdentifier
+                            ? format("{S}", fun_call->id->value.identifier)
+                            : from__String("<access>"));
+    else if ((callee &&
+              param_count !=
+                (callee->params ? len__Vec(*callee->params) : 0)) ||
+             (fun_builtin && param_count == 0)) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyErrorWithString,
+                  LilyErrorBadNumberOfParams,
+                  format("{S}", fun_call->id->value.identifier)),
+              expr->loc,
+              from__String(""),
+              None());
+
+        emit_diagnostic(err);
+    }
+
+    struct Vec *params = NEW(Vec, sizeof(struct Tuple));
+    struct DataTypeSymbol **generic_params =
+      calloc(param_count + 1, sizeof(struct DataTypeSymbol *));
+
+    for (Usize i = 0; i < param_count; i++) {
+        struct Tuple *param_call = get__Vec(*fun_call->params, i);
+        struct DataTypeSymbol *param_data_type = NULL;
+
+        if (callee && callee->params && i < len__Vec(*callee->params))
+            param_data_type =
+              get_data_type_of_called_param(self, fun, callee, i);
+        else if (fun_builtin && i == 0)
+            param_data_type = get__Vec(*fun_builtin->params, 0);
+
+        if (is_generic_param_data_type(param_data_type)) {
+            generic_params[i] = param_data_type;
+            param_data_type = NULL;
+        }
+
+        struct ExprSymbol *value =
+          check_expression(self,
+                           fun,
+                           ((struct FunParamCall *)param_call->items[0])->value,
+                           local_value,
+                           local_data_type,
+                           param_data_type &&
+                               param_data_type->kind !=
+                                 DataTypeKindCompilerDefined
+                             ? param_data_type
+                             : NULL,
+                           false);
+
+        // A recursive call constrains the params of the function: fun f(x) =
+        // f(x + 1).
+        if (callee == fun && fun->infer && param_data_type)
+            unify__Infer(fun->infer,
+                         ((struct FunParamSymbol *)get__Vec(*fun->params, i))
+                           ->data_type_var,
+                         get_infer_node_of_expression(fun, value));
+
+        push__Vec(params, NEW(Tuple, 2, value, param_call->items[1]));
+    }
+
+    struct DataTypeSymbol *return_type = NULL;
+
+    if (callee)
+        return_type = get_return_type_of_called_fun(self, fun, callee);
+    else if (fun_builtin)
+        return_type = get__Vec(*fun_builtin->params, 2);
+
+    // A generic param is bound by the data type of the first argument which
+    // has it: add(1, 2) returns Int32, add(1, 2.5) is an error.
+    for (Usize i = 0; i < param_count; i++) {
+        struct DataTypeSymbol *arg =
+          ((struct ExprSymbol *)((struct Tuple *)get__Vec(*params, i))
+             ->items[0])
+            ->data_type;
+
+        if (!generic_params[i] || !arg ||
+            arg->kind == DataTypeKindCompilerDefined)
+            continue;
+
+        for (Usize j = 0; j < i; j++) {
+            struct ExprSymbol *bound =
+              ((struct Tuple *)get__Vec(*params, j))->items[0];
+
+            if (generic_params[j] == generic_params[i] && bound->data_type &&
+                bound->data_type->kind != DataTypeKindCompilerDefined &&
+                !eq__DataTypeSymbol(bound->data_type, arg)) {
+                struct Diagnostic *err = NEW(
+                  DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyError, LilyErrorUnmatchedDataType),
+                  ((struct ExprSymbol *)((struct Tuple *)get__Vec(*params, i))
+                     ->items[0])
+                    ->loc,
+                  from__String(""),
+                  Some(from__String(
+                    "the arguments of a generic param have different data "
+                    "types")));
+
+                emit_diagnostic(err);
+
+                break;
+            }
+        }
+
+        if (return_type == generic_params[i])
+            return_type = arg;
+    }
+
+    free(generic_params);
+
+    if (!return_type)
+        return_type = NEW(DataTypeSymbolCompilerDefined,
+                          self->types,
+                          NEW(CompilerDefinedDataType, "T", false));
+
+    struct Scope *id = NULL;
+
+    if (callee)
+        id = copy__Scope(callee->scope);
+    else if (fun_builtin)
+        id = NEW(Scope,
+                 self->parser.parse_block.scanner.src->file.name,
+                 fun_call->id->value.identifier,
+                 0,
+                 ScopeItemKindFun,
+                 ScopeKindGlobal,
+                 NULL);
+
+    return NEW(ExprSymbolFunCall,
+               *expr,
+               NEW(FunCallSymbol, fun_builtin != NULL, id, params),
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self, fun, expr->loc, defined_data_type, return_type));
+}
+
+// f(x) where f is a local value: the data type of f is a lambda.
+struct ExprSymbol *
+check_closure_call(struct Typecheck *self,
+                   struct FunSymbol *fun,
+                   struct Expr *expr,
+                   struct Scope *local,
+                   struct LocalScopeChain *local_value,
+                   struct Vec *local_data_type,
+                   struct DataTypeSymbol *defined_data_type)
+{
+    struct FunCall *fun_call = &expr->value.fun_call;
+    struct Scope *id = copy__Scope(local);
+    struct DataTypeSymbol *data_type = get_data_type_of_local_value(fun, id);
+    Usize param_count = fun_call->params ? len__Vec(*fun_call->params) : 0;
+
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    id->data_type = data_type;
+
+    struct Vec *params_data_type =
+      data_type && data_type->kind == DataTypeKindLambda
+        ? data_type->value.lambda->items[0]
+        : NULL;
+
+    if (!params_data_type) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyErrorWithString,
+                  LilyErrorNotCallable,
+                  format("{S}", local->name)),
+              fun_call->id->loc,
+              from__String(""),
+              Some(from__String("a called param has the data type of a "
+                                "lambda: f |Int32 -> Int32|")));
+
+        emit_diagnostic(err);
+    } else if (param_count != len__Vec(*params_data_type)) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyErrorWithString,
+                  LilyErrorBadNumberOfParams,
+                  format("{S}", local->name)),
+              expr->loc,
+              from__String(""),
+              None());
+
+        emit_diagnostic(err);
+    }
+
+    struct Vec *params = NEW(Vec, sizeof(struct Tuple));
+
+    for (Usize i = 0; i < param_count; i++) {
+        struct Tuple *param_call = get__Vec(*fun_call->params, i);
+        struct DataTypeSymbol *param_data_type =
+          params_data_type && i < len__Vec(*params_data_type)
+            ? get__Vec(*params_data_type, i)
+            : NULL;
+        struct ExprSymbol *value =
+          check_expression(self,
+                           fun,
+                           ((struct FunParamCall *)param_call->items[0])->value,
+                           local_value,
+                           local_data_type,
+                           param_data_type,
+                           false);
+
+        push__Vec(params, NEW(Tuple, 2, value, param_call->items[1]));
+    }
+
+    struct DataTypeSymbol *return_type =
+      params_data_type ? data_type->value.lambda->items[1]
+                       : NEW(DataTypeSymbolCompilerDefined,
+                             self->types,
+                             NEW(CompilerDefinedDataType, "T", false));
+
+    return NEW(ExprSymbolFunCall,
+               *expr,
+               NEW(FunCallSymbol, false, id, params),
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self, fun, expr->loc, defined_data_type, return_type));
+}
+
+struct ExprSymbol *
+check_record_call(struct Typecheck *self,
+                  struct FunSymbol *fun,
+                  struct Expr *expr,
+                  struct LocalScopeChain *local_value,
+                  struct Vec *local_data_type,
+                  struct DataTypeSymbol *defined_data_type)
+{
+    struct RecordCall *record_call = &expr->value.record_call;
+    struct RecordSymbol *record =
+      record_call->id->kind == ExprKindIdentifier
+        ? search_in_records_from_name(self, record_call->id->value.identifier)
+        : NULL;
+
+    if (!record) {
+        emit_unknown_name(self,
+                          LilyErrorUnknownDataType,
+                          record_call->id->loc,
+                          record_call->id->kind == ExprKindIdentifier
+                            ? format("{S}", record_call->id->value.identifier)
+                            : from__String("<access>"));
+
+        return NEW(ExprSymbolRecordCall,
+                   *expr,
+                   NEW(RecordCallSymbol, (struct Scope){ 0 }, NULL),
+                   defined_data_type
+                     ? defined_data_type
+                     : NEW(DataTypeSymbolCompilerDefined,
+                           self->types,
+                           NEW(CompilerDefinedDataType, "T", false)));
+    }
+
+    struct DataTypeSymbol *data_type =
+      NEW(DataTypeSymbolCustom, self->types, NULL, NULL, record->scope);
+    Usize field_count = record->fields ? len__Vec(*record->fields) : 0;
+    bool *is_initialized =
+      field_count ? calloc(field_count, sizeof(bool)) : NULL;
+    struct Vec *fields = NEW(Vec, sizeof(struct Tuple));
+
+    for (Usize i = 0;
+         record_call->fields && i < len__Vec(*record_call->fields);
+         i++) {
+        struct Tuple *field_call = get__Vec(*record_call->fields, i);
+        struct FieldCall *field = field_call->items[0];
+        Usize id = 0;
+        struct FieldRecordSymbol *field_record =
+          search_field_in_data_type(self, data_type, field->name, &id);
+
+        if (!field_record) {
+            emit_unknown_name(self,
+                              LilyErrorUnknownField,
+                              *(struct Location *)field_call->items[1],
+                              format("{S}", field->name));
+
+            continue;
+        }
+
+        is_initialized[id] = true;
+
+        struct ExprSymbol *value = NULL;
+
+        // The field without value takes the local value of the same name:
+        // Person{name, age := 42}.
+        if (field->value->kind == None) {
+            struct Expr identifier = { .kind = ExprKindIdentifier,
+                                       .loc = *(struct Location *)
+                                                field_call->items[1],
+                                       .value.identifier = field->name };
+
+            value = check_expression(self,
+                                     fun,
+                                     &identifier,
+                                     local_value,
+                                     local_data_type,
+                                     field_record->data_type,
+                                     false);
+        } else
+            value = check_expression(self,
+                                     fun,
+                                     field->value->some,
+                                     local_value,
+                                     local_data_type,
+                                     field_record->data_type,
+                                     false);
+
+        push__Vec(fields,
+                  NEW(Tuple,
+                      2,
+                      NEW(FieldCallSymbol, field_record->name, value),
+                      field_call->items[1]));
+    }
+
+    for (Usize i = 0; i < field_count; i++) {
+        struct FieldRecordSymbol *field_record =
+          ((struct SymbolTable *)get__Vec(*record->fields, i))->value.field;
+
+        if (!is_initialized[i] && !field_record->value)
+            emit_unknown_name(self,
+                              LilyErrorMissingField,
+                              record_call->id->loc,
+                              format("{S}", field_record->name));
+    }
+
+    free(is_initialized);
+
+    return NEW(ExprSymbolRecordCall,
+               *expr,
+               NEW(RecordCallSymbol, *record->scope, fields),
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self, fun, expr->loc, defined_data_type, data_type));
+}
+
+// The enum of the data type (NULL if the data type is not an enum of the
+// file).
+struct EnumSymbol *
+get_enum_of_data_type(struct Typecheck *self, struct DataTypeSymbol *data_type)
+{
+    if (!data_type || data_type->kind != DataTypeKindCustom ||
+        !data_type->scope || data_type->scope->item_kind != ScopeItemKindEnum ||
+        data_type->scope->filename !=
+          self->parser.parse_block.scanner.src->file.name ||
+        !self->enums)
+        return NULL;
+
+    return get__Vec(*self->enums, data_type->scope->id);
+}
+
+// @return the index of the variant in the enum (-1 if it's unknown).
+Isize
+get_variant_id(struct EnumSymbol *enum_, struct String *name)
+{
+    for (Usize i = 0; enum_->variants && i < len__Vec(*enum_->variants); i++)
+        if (eq__String(
+              ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+                ->value.variant->name,
+              name,
+              false))
+            return i;
+
+    return -1;
+}
+
+// The variant is Color.Red, or Red in the enum of the data type (the defined
+// data type of the expression or the data type of the matched value). When
+// the data type is not an enum, Red is searched in the enums of the file
+// (fun letter_to_str(x) = match x do A:_ => "A", ... end).
+// @return the index of the variant in its enum (-1 if it's unknown).
+Isize
+search_variant(struct Typecheck *self,
+               struct Expr *id,
+               struct DataTypeSymbol *data_type,
+               struct EnumSymbol **enum_)
+{
+    *enum_ = NULL;
+
+    if (id->kind == ExprKindIdentifierAccess &&
+        len__Vec(*id->value.identifier_access) == 2) {
+        struct Expr *enum_name = get__Vec(*id->value.identifier_access, 0);
+        struct Expr *variant_name = get__Vec(*id->value.identifier_access, 1);
+
+        if (enum_name->kind == ExprKindIdentifier &&
+            variant_name->kind == ExprKindIdentifier)
+            *enum_ =
+              search_in_enums_from_name(self, enum_name->value.identifier);
+
+        return *enum_ ? get_variant_id(*enum_, variant_name->value.identifier)
+                      : -1;
+    } else if (id->kind != ExprKindIdentifier)
+        return -1;
+
+    *enum_ = get_enum_of_data_type(self, data_type);
+
+    if (*enum_)
+        return get_variant_id(*enum_, id->value.identifier);
+
+    for (Usize i = 0; self->enums && i < len__Vec(*self->enums); i++) {
+        struct EnumSymbol *enum_i = search_in_enums_from_name(
+          self, ((struct EnumSymbol *)get__Vec(*self->enums, i))->name);
+        Isize variant = enum_i ? get_variant_id(enum_i, id->value.identifier)
+                               : -1;
+
+        if (variant != -1) {
+            *enum_ = enum_i;
+
+            return variant;
+        }
+    }
+
+    return -1;
+}
+
+void
+emit_unknown_variant(struct Typecheck *self, struct Expr *id)
+{
+    struct String *name = NULL;
+
+    if (id->kind == ExprKindIdentifier)
+        name = format("{S}", id->value.identifier);
+    else if (id->kind == ExprKindIdentifierAccess &&
+             len__Vec(*id->value.identifier_access) == 2 &&
+             ((struct Expr *)get__Vec(*id->value.identifier_access, 0))->kind ==
+               ExprKindIdentifier &&
+             ((struct Expr *)get__Vec(*id->value.identifier_access, 1))->kind ==
+               ExprKindIdentifier)
+        name = format(
+          "{S}.{S}",
+          ((struct Expr *)get__Vec(*id->value.identifier_access, 0))
+            ->value.identifier,
+          ((struct Expr *)get__Vec(*id->value.identifier_access, 1))
+            ->value.identifier);
+    else
+        name = from__String("<access>");
+
+    emit_unknown_name(self, LilyErrorUnknownVariant, id->loc, name);
+}
+
+// The variant with a value must be built with a value, the variant without
+// value must be built without value.
+void
+check_variant_value(struct Typecheck *self,
+                    struct Location loc,
+                    struct VariantEnumSymbol *variant,
+                    struct Expr *value)
+{
+    if (!variant->data_type == !value)
+        return;
+
+    struct Diagnostic *err = NEW(DiagnosticWithErrTypecheck,
+                                 self,
+                                 NEW(LilyError, LilyErrorUnmatchedDataType),
+                                 loc,
+                                 from__String(""),
+                                 Some(from__String(variant->data_type
+                                                     ? "expected a value"
+                                                     : "the variant has no "
+                                                       "value")));
+
+    emit_diagnostic(err);
+}
+
+// The scope of the variant is its index in the enum, previous is the scope of
+// the enum.
+struct ExprSymbol *
+new_variant_symbol(struct Typecheck *self,
+                   struct Expr expr,
+                   struct EnumSymbol *enum_,
+                   Isize id,
+                   struct ExprSymbol *value,
+                   struct DataTypeSymbol *data_type)
+{
+    struct Scope scope = *enum_->scope;
+
+    scope.name = ((struct SymbolTable *)get__Vec(*enum_->variants, id))
+                   ->value.variant->name;
+    scope.id = id;
+    scope.depth = 0;
+    scope.item_kind = ScopeItemKindVariant;
+    scope.previous = enum_->scope;
+    scope.data_type =
+      NEW(DataTypeSymbolCustom, self->types, NULL, NULL, enum_->scope);
+
+    expr.kind = ExprKindVariant;
+
+    return NEW(
+      ExprSymbolVariant, expr, NEW(VariantSymbol, scope, value), data_type);
+}
+
+// Color.Red, Color.Green:$ or Shape.Circle:2.0, Red:$ when the defined data
+// type is the enum.
+struct ExprSymbol *
+check_variant(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Expr *expr,
+              struct Expr *id,
+              struct Expr *value,
+              struct LocalScopeChain *local_value,
+              struct Vec *local_data_type,
+              struct DataTypeSymbol *defined_data_type)
+{
+    struct EnumSymbol *enum_ = NULL;
+    Isize variant_id = search_variant(self, id, defined_data_type, &enum_);
+
+    if (variant_id == -1) {
+        emit_unknown_variant(self, id);
+
+        return NEW(ExprSymbolVariant,
+                   *expr,
+                   NEW(VariantSymbol, (struct Scope){ 0 }, NULL),
+                   defined_data_type
+                     ? defined_data_type
+                     : NEW(DataTypeSymbolCompilerDefined,
+                           self->types,
+                           NEW(CompilerDefinedDataType, "T", false)));
+    }
+
+    struct VariantEnumSymbol *variant =
+      ((struct SymbolTable *)get__Vec(*enum_->variants, variant_id))
+        ->value.variant;
+    struct ExprSymbol *value_symbol = NULL;
+
+    check_variant_value(self, expr->loc, variant, value);
+
+    if (value && variant->data_type)
+        value_symbol = check_expression(self,
                                         fun,
-                                        expr,
+                                        value,
                                         local_value,
                                         local_data_type,
-                                        defined_data_type,
-                                        is_return_type));
-        case ExprKindIdentifierAccess:
+                                        variant->data_type,
+                                        false);
+
+    return new_variant_symbol(
+      self,
+      *expr,
+      enum_,
+      variant_id,
+      value_symbol,
+      check_if_defined_data_type_is_equal_to_infered_data_type(
+        self,
+        fun,
+        expr->loc,
+        defined_data_type,
+        NEW(DataTypeSymbolCustom, self->types, NULL, NULL, enum_->scope)));
+}
+
+// The first identifier is a local value or a param, the next ones are the
+// fields of its record: p.name. The scope of each field keeps the scope of
+// the previous identifier.
+struct ExprSymbol *
+check_identifier_access(struct Typecheck *self,
+                        struct FunSymbol *fun,
+                        struct Expr *expr,
+                        struct LocalScopeChain *local_value,
+                        struct Vec *local_data_type,
+                        struct DataTypeSymbol *defined_data_type)
+{
+    struct Vec *access = expr->value.identifier_access;
+    struct Expr *first = get__Vec(*access, 0);
+    struct Scope *local =
+      first->kind == ExprKindIdentifier
+        ? search_value_in_function(
+            self, local_value, first->value.identifier, NULL)
+        : NULL;
+
+    // Color.Red
+    if (!local && first->kind == ExprKindIdentifier && len__Vec(*access) == 2 &&
+        search_in_enums_from_name(self, first->value.identifier))
+        return check_variant(self,
+                             fun,
+                             expr,
+                             expr,
+                             NULL,
+                             local_value,
+                             local_data_type,
+                             defined_data_type);
+
+    if (!local) {
+        if (first->kind == ExprKindIdentifier)
+            emit_unknown_name(self,
+                              LilyErrorUnknownIdentifier,
+                              first->loc,
+                              format("{S}", first->value.identifier));
+
+        return NEW(ExprSymbolIdentifierAccess,
+                   *expr,
+                   NULL,
+                   defined_data_type
+                     ? defined_data_type
+                     : NEW(DataTypeSymbolCompilerDefined,
+                           self->types,
+                           NEW(CompilerDefinedDataType, "T", false)));
+    }
+
+    struct Scope *scope = copy__Scope(local);
+    struct DataTypeSymbol *data_type = get_data_type_of_local_value(fun, local);
+
+    scope->previous = NULL;
+    scope->data_type = data_type;
+
+    for (Usize i = 1; i < len__Vec(*access); i++) {
+        struct Expr *item = get__Vec(*access, i);
+        Usize id = 0;
+        struct FieldRecordSymbol *field =
+          item->kind == ExprKindIdentifier
+            ? search_field_in_data_type(
+                self, data_type, item->value.identifier, &id)
+            : NULL;
+
+        if (!field) {
+            emit_unknown_name(self,
+                              LilyErrorUnknownField,
+                              item->loc,
+                              item->kind == ExprKindIdentifier
+                                ? format("{S}", item->value.identifier)
+                                : from__String("<access>"));
+
+            data_type = NULL;
+
+            break;
+        }
+
+        scope = NEW(Scope,
+                    self->parser.parse_block.scanner.src->file.name,
+                    field->name,
+                    id,
+                    ScopeItemKindField,
+                    ScopeKindLocal,
+                    scope);
+        scope->data_type = data_type = field->data_type;
+    }
+
+    return NEW(ExprSymbolIdentifierAccess,
+               *expr,
+               scope,
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self,
+                 fun,
+                 expr->loc,
+                 defined_data_type,
+                 data_type ? data_type
+                           : NEW(DataTypeSymbolCompilerDefined,
+                                 self->types,
+                                 NEW(CompilerDefinedDataType, "T", false))));
+}
+
+// The params of a lambda are declared in its own lexical scope. The data type
+// of a param is its annotation, the data type of the param of the expected
+// lambda (the param of the callee, the variable) or, if the lambda is
+// instantly called, the data type of its argument. The last item of the body
+// is the value of the lambda.
+struct ExprSymbol *
+check_lambda(struct Typecheck *self,
+             struct FunSymbol *fun,
+             struct Expr *expr,
+             struct LocalScopeChain *local_value,
+             struct Vec *local_data_type,
+             struct DataTypeSymbol *defined_data_type)
+{
+    struct Lambda *lambda = &expr->value.lambda;
+    struct Vec *expected_params =
+      !lambda->instantly_call && defined_data_type &&
+          defined_data_type->kind == DataTypeKindLambda
+        ? defined_data_type->value.lambda->items[0]
+        : NULL;
+    Usize params_len = lambda->params ? len__Vec(*lambda->params) : 0;
+    struct Vec *params = NEW(Vec, sizeof(struct Scope));
+    struct Vec *params_data_type = NEW(Vec, sizeof(struct DataTypeSymbol));
+    struct Vec *args =
+      lambda->instantly_call ? NEW(Vec, sizeof(struct ExprSymbol)) : NULL;
+
+    for (Usize i = 0; i < params_len; i++) {
+        struct FunParam *param = get__Vec(*lambda->params, i);
+        struct DataTypeSymbol *data_type = NULL;
+
+        if (param->param_data_type)
+            data_type = check_data_type(
+              self,
+              *(struct Location *)param->param_data_type->items[1],
+              param->param_data_type->items[0],
+              local_data_type,
+              NULL,
+              (struct SearchContext){ .search_type = true,
+                                      .search_fun = false,
+                                      .search_variant = false,
+                                      .search_value = false,
+                                      .search_trait = true,
+                                      .search_class = true,
+                                      .search_object = true,
+                                      .search_primary_type = true });
+        else if (expected_params && i < len__Vec(*expected_params))
+            data_type = get__Vec(*expected_params, i);
+
+        // The arguments of an instant call are in the enclosing scope.
+        if (args) {
+            struct ExprSymbol *arg = check_expression(self,
+                                                      fun,
+                                                      param->value.default_,
+                                                      local_value,
+                                                      local_data_type,
+                                                      data_type,
+                                                      false);
+
+            push__Vec(args, arg);
+
+            if (!data_type)
+                data_type = arg->data_type;
+        }
+
+        if (!data_type) {
+            struct Diagnostic *err =
+              NEW(DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyErrorWithString,
+                      LilyErrorUnknownLambdaParamDataType,
+                      format("{S}", param->name)),
+                  param->loc,
+                  from__String(""),
+                  Some(from__String("annotate the param: fun (x Int32) -> "
+                                    "x + 1")));
+
+            emit_diagnostic(err);
+
+            data_type = NEW(DataTypeSymbolCompilerDefined,
+                            self->types,
+                            NEW(CompilerDefinedDataType, "T", false));
+        }
+
+        struct Scope *scope =
+          NEW(Scope,
+              self->parser.parse_block.scanner.src->file.name,
+              param->name,
+              0,
+              ScopeItemKindVariable,
+              ScopeKindLocal,
+              NULL);
+
+        scope->data_type = data_type;
+        push__Vec(params, scope);
+        push__Vec(params_data_type, data_type);
+    }
+
+    struct LambdaContext context = {
+        .previous = current_lambda,
+        .captures = NEW(Vec, sizeof(struct Scope)),
+        .return_type =
+          lambda->return_type
+            ? check_data_type(
+                self,
+                expr->loc,
+                lambda->return_type,
+                local_data_type,
+                NULL,
+                (struct SearchContext){ .search_type = true,
+                                        .search_fun = false,
+                                        .search_variant = false,
+                                        .search_value = false,
+                                        .search_trait = true,
+                                        .search_class = true,
+                                        .search_object = true,
+                                        .search_primary_type = true })
+          : expected_params ? defined_data_type->value.lambda->items[1]
+                            : NULL
+    };
+    struct Vec *body = NEW(Vec, sizeof(struct SymbolTable));
+    Usize body_len = lambda->body ? len__Vec(*lambda->body) : 0;
+    // The lambda of a constant has no enclosing scope.
+    struct LocalScopeChain *chain = local_value;
+
+    if (!local_value)
+        local_value = NEW(LocalScopeChain);
+
+    // The params are in the outermost lexical scope of the lambda, as in a
+    // function.
+    enter__LocalScopeChain(local_value);
+    context.depth = local_value->current->depth;
+
+    for (Usize i = 0; i < params_len; i++)
+        add__LocalScopeChain(local_value, get__Vec(*params, i));
+
+    enter__LocalScopeChain(local_value);
+    current_lambda = &context;
+
+    for (Usize i = 0; i < body_len; i++) {
+        struct FunBodyItem *item = get__Vec(*lambda->body, i);
+
+        if (i + 1 < body_len || item->kind != FunBodyItemKindExpr ||
+            item->expr->kind == ExprKindVariable) {
+            check_fun_body_item(
+              self, fun, item, body, local_value, local_data_type, false);
+            continue;
+        }
+
+        struct ExprSymbol *value = check_expression(self,
+                                                    fun,
+                                                    item->expr,
+                                                    local_value,
+                                                    local_data_type,
+                                                    context.return_type,
+                                                    false);
+
+        if (!context.return_type)
+            context.return_type = value->data_type;
+
+        push__Vec(body, NEW(SymbolTableExpr, value));
+    }
+
+    current_lambda = context.previous;
+    leave__LocalScopeChain(local_value);
+    leave__LocalScopeChain(local_value);
+
+    if (!chain)
+        FREE(LocalScopeChain, local_value);
+
+    struct DataTypeSymbol *return_type =
+      context.return_type && context.return_type->kind != DataTypeKindUnit
+        ? context.return_type
+        : NULL;
+    struct DataTypeSymbol *data_type =
+      NEW(DataTypeSymbolLambda,
+          self->types,
+          params_data_type,
+          return_type ? return_type
+                      : NEW(DataTypeSymbol, self->types, DataTypeKindUnit));
+
+    return NEW(ExprSymbolLambda,
+               *expr,
+               NEW(LambdaSymbol,
+                   params,
+                   return_type,
+                   data_type,
+                   body,
+                   context.captures,
+                   args),
+               check_if_defined_data_type_is_equal_to_infered_data_type(
+                 self,
+                 fun,
+                 expr->loc,
+                 defined_data_type,
+                 args ? (return_type ? return_type
+                                     : NEW(DataTypeSymbol,
+                                           self->types,
+                                           DataTypeKindUnit))
+                      : data_type));
+}
+
+struct ExprSymbol *
+check_expression(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct Expr *expr,
+                 struct LocalScopeChain *local_value,
+                 struct Vec *local_data_type,
+                 struct DataTypeSymbol *defined_data_type,
+                 bool is_return_type)
+{
+    switch (expr->kind) {
+        case ExprKindUnaryOp: {
+            enum UnaryOpKind kind = expr->value.unary_op.kind;
+            bool is_operand_data_type =
+              kind == UnaryOpKindNegative || kind == UnaryOpKindBitNot;
+            struct ExprSymbol *right =
+              check_expression(self,
+                               fun,
+                               expr->value.unary_op.right,
+                               local_value,
+                               local_data_type,
+                               is_operand_data_type ? defined_data_type : NULL,
+                               is_return_type);
+            struct DataTypeSymbol *data_type = right->data_type;
+
+            switch (kind) {
+                case UnaryOpKindReference:
+                    data_type =
+                      NEW(DataTypeSymbolRef, self->types, right->data_type);
+
+                    break;
+                case UnaryOpKindBitNot:
+                case UnaryOpKindNegative: {
+                    // The data type of the operand is only known at the call
+                    // of the function: fun neg(x) = -x.
+                    if (data_type->kind == DataTypeKindCompilerDefined)
+                        break;
+
+                    const Str module_name =
+                      get_builtin_module_name_from_data_type(data_type);
+                    const Str op_str = to_str__UnaryOpKind(kind);
+                    const struct BuiltinFun *fun_builtin =
+                      search_fun_builtin(self, module_name, op_str, 2);
+
+                    if (fun_builtin) {
+                        verify_type_of_fun_builtin(
+                          self, expr->loc, fun_builtin, 1, data_type);
+
+                        data_type = get__Vec(*fun_builtin->params, 1);
+                    } else
+                        emit_unknown_name(
+                          self,
+                          LilyErrorUnknownFunction,
+                          expr->loc,
+                          module_name ? format("{s}.{s}", module_name, op_str)
+                                      : format("{s}", op_str));
+
+                    break;
+                }
+                case UnaryOpKindNot:
+                    data_type =
+                      NEW(DataTypeSymbol, self->types, DataTypeKindBool);
+
+                    unify_expression(self, fun, right, data_type);
+                    verify_type_of_fun_builtin(
+                      self,
+                      expr->loc,
+                      search_fun_builtin(self, "Bool", "not", 2),
+                      1,
+                      right->data_type);
+
+                    break;
+                case UnaryOpKindCustom:
+                    TODO("check unary operator kind custom");
+            }
+
+            return NEW(
+              ExprSymbolUnaryOp,
+              *expr,
+              NEW(UnaryOpSymbol, *expr, right),
+              check_if_defined_data_type_is_equal_to_infered_data_type(
+                self, fun, expr->loc, defined_data_type, data_type));
+        }
+        case ExprKindBinaryOp:
+            return check_binary_op(self,
+                                   fun,
+                                   expr,
+                                   local_value,
+                                   local_data_type,
+                                   defined_data_type,
+                                   is_return_type);
+        case ExprKindFunCall:
+            return check_fun_call(
+              self, fun, expr, local_value, local_data_type, defined_data_type);
+        case ExprKindRecordCall:
+            return check_record_call(
+              self, fun, expr, local_value, local_data_type, defined_data_type);
+        case ExprKindIdentifier: {
+            // The identifier keeps a copy of the (depth, slot) of the local
+            // value, so the next passes don't have to search it again.
+            struct Scope *identifier = search_value_in_function(
+              self, local_value, expr->value.identifier, NULL);
+            struct DataTypeSymbol *data_type = NULL;
+
+            if (identifier) {
+                identifier = copy__Scope(identifier);
+                data_type = get_data_type_of_local_value(fun, identifier);
+                identifier->data_type = data_type;
+            } else {
+                struct ConstantSymbol *constant =
+                  search_in_consts_from_name(self, expr->value.identifier);
+
+                if (constant) {
+                    identifier = copy__Scope(constant->scope);
+                    data_type =
+                      constant->data_type
+                        ? constant->data_type
+                        : (constant->expr_symbol
+                             ? constant->expr_symbol->data_type
+                             : NULL);
+                } else
+                    emit_unknown_name(self,
+                                      LilyErrorUnknownIdentifier,
+                                      expr->loc,
+                                      format("{S}", expr->value.identifier));
+            }
+
             return NEW(
-              ExprSymbolIdentifierAccess,
+              ExprSymbolIdentifier,
               *expr,
-              search_value_in_function(
-                self, local_value, NULL, expr->value.identifier_access),
-              infer_expression(self,
-                               fun,
-                               expr,
-                               local_value,
-                               local_data_type,
-                               defined_data_type,
-                               is_return_type));
+              identifier,
+              check_if_defined_data_type_is_equal_to_infered_data_type(
+                self,
+                fun,
+                expr->loc,
+                defined_data_type,
+                data_type ? data_type
+                          : NEW(DataTypeSymbolCompilerDefined,
+                                self->types,
+                                NEW(CompilerDefinedDataType, "T", false))));
+        }
+        case ExprKindIdentifierAccess:
+            return check_identifier_access(
+              self, fun, expr, local_value, local_data_type, defined_data_type);
         case ExprKindGlobalAccess:
             TODO("check global access");
         case ExprKindArrayAccess: {
@@ -4893,9 +7441,13 @@ check_expression(struct Typecheck *self,
                   expr->loc);
             struct DataTypeSymbol *defined_data_type_identifier_access_symb =
               defined_data_type ? NEW(DataTypeSymbolArray,
-                                      copy__DataTypeSymbol(defined_data_type),
+                                      self->types,
+                                      defined_data_type,
                                       NULL)
-                                : NEW(DataTypeSymbolArray, NULL, NULL);
+                                : NEW(DataTypeSymbolArray,
+                                      self->types,
+                                      NULL,
+                                      NULL);
             struct ExprSymbol *identifier_access_symb =
               check_expression(self,
                                fun,
@@ -4917,7 +7469,6 @@ check_expression(struct Typecheck *self,
                                    is_return_type));
 
             FREE(ExprAll, identifier_access_expr);
-            FREE(DataTypeSymbolAll, defined_data_type_identifier_access_symb);
             FREE(ExprSymbolAll, identifier_access_symb);
 
             return res;
@@ -4928,7 +7479,7 @@ check_expression(struct Typecheck *self,
                   copy__Vec(expr->value.tuple_access.access),
                   expr->loc);
             struct DataTypeSymbol *defined_data_type_identifier_access_symb =
-              NEW(DataTypeSymbolTuple, NULL);
+              NEW(DataTypeSymbolTuple, self->types, NULL);
             struct ExprSymbol *identifier_access_symb =
               check_expression(self,
                                fun,
@@ -4950,13 +7501,13 @@ check_expression(struct Typecheck *self,
                                    is_return_type));
 
             FREE(ExprAll, identifier_access_expr);
-            FREE(DataTypeSymbolAll, defined_data_type_identifier_access_symb);
             FREE(ExprSymbolAll, identifier_access_symb);
 
             return res;
         }
         case ExprKindLambda:
-            TODO("check lambda");
+            return check_lambda(
+              self, fun, expr, local_value, local_data_type, defined_data_type);
         case ExprKindTuple:
             TODO("check tuple");
         case ExprKindArray: {
@@ -4987,7 +7538,7 @@ check_expression(struct Typecheck *self,
                 return NEW(ExprSymbolArray,
                            *expr,
                            array,
-                           copy__DataTypeSymbol(defined_data_type));
+                           defined_data_type);
             } else {
                 struct Vec *array = NEW(Vec, sizeof(struct ExprSymbol));
 
@@ -5023,34 +7574,14 @@ check_expression(struct Typecheck *self,
             }
         }
         case ExprKindVariant:
-            if (defined_data_type) {
-                struct ExprSymbol *value = NULL;
-                struct Scope *scope = search_from_access(
-                  self,
-                  expr->value.variant.id,
-                  NEW(Vec, sizeof(struct String)),
-                  (struct SearchContext){ .search_class = false,
-                                          .search_fun = false,
-                                          .search_object = false,
-                                          .search_trait = false,
-                                          .search_type = false,
-                                          .search_value = false,
-                                          .search_variant = true,
-                                          .search_primary_type = false });
-
-                if (expr->value.variant.value) {
-                    value = check_expression(self,
-                                             fun,
-                                             expr->value.variant.value,
-                                             local_value,
-                                             local_data_type,
-                                             NULL,
-                                             is_return_type);
-                }
-            } else {
-            }
-            // return NEW(ExprSymbolVariant, *expr, )
-            TODO("check variant");
+            return check_variant(self,
+                                 fun,
+                                 expr,
+                                 expr->value.variant.id,
+                                 expr->value.variant.value,
+                                 local_value,
+                                 local_data_type,
+                                 defined_data_type);
         case ExprKindTry:
             TODO("check try");
         case ExprKindBlock:
@@ -5085,7 +7616,6 @@ check_expression(struct Typecheck *self,
                                     "defined data type");
                     }
 
-                    FREE(DataTypeSymbolAll, expr_dt);
 
                     return NEW(
                       ExprSymbolQuestionMark,
@@ -5120,6 +7650,7 @@ check_expression(struct Typecheck *self,
                                                 .search_object = false,
                                                 .search_primary_type = false }),
                            NEW(DataTypeSymbolOptional,
+                               self->types,
                                infer_expression(self,
                                                 fun,
                                                 expr->value.question_mark,
@@ -5159,7 +7690,6 @@ check_expression(struct Typecheck *self,
                                 "defined data type");
                 }
 
-                FREE(DataTypeSymbolAll, expr_dt);
 
                 return NEW(ExprSymbolDereference,
                            *expr,
@@ -5251,6 +7781,7 @@ check_expression(struct Typecheck *self,
                                                 .search_object = false,
                                                 .search_primary_type = false }),
                            NEW(DataTypeSymbolRef,
+                               self->types,
                                infer_expression(self,
                                                 fun,
                                                 expr->value.ref,
@@ -5264,18 +7795,19 @@ check_expression(struct Typecheck *self,
         case ExprKindUndef:
             if (defined_data_type)
                 return NEW(
-                  ExprSymbol, expr, copy__DataTypeSymbol(defined_data_type));
+                  ExprSymbol, expr, defined_data_type);
             else
                 return NEW(ExprSymbol,
                            expr,
                            NEW(DataTypeSymbolCompilerDefined,
+                               self->types,
                                NEW(CompilerDefinedDataType, "T", false)));
         case ExprKindNil:
             if (defined_data_type)
                 if (defined_data_type->kind == DataTypeKindPtr)
                     return NEW(ExprSymbol,
                                expr,
-                               copy__DataTypeSymbol(defined_data_type));
+                               defined_data_type);
                 else {
                     assert(0 && "error: expected Ptr data type");
                 }
@@ -5283,14 +7815,16 @@ check_expression(struct Typecheck *self,
                 return NEW(ExprSymbol,
                            expr,
                            NEW(DataTypeSymbolPtr,
+                               self->types,
                                NEW(DataTypeSymbolCompilerDefined,
+                                   self->types,
                                    NEW(CompilerDefinedDataType, "T", false))));
         case ExprKindNone:
             if (defined_data_type)
                 if (defined_data_type->kind == DataTypeKindOptional)
                     return NEW(ExprSymbol,
                                expr,
-                               copy__DataTypeSymbol(defined_data_type));
+                               defined_data_type);
                 else {
                     assert(0 && "error: expected Optional data type");
                 }
@@ -5298,7 +7832,9 @@ check_expression(struct Typecheck *self,
                 return NEW(ExprSymbol,
                            expr,
                            NEW(DataTypeSymbolOptional,
+                               self->types,
                                NEW(DataTypeSymbolCompilerDefined,
+                                   self->types,
                                    NEW(CompilerDefinedDataType, "T", false))));
             break;
         case ExprKindWildcard:
@@ -5365,7 +7901,7 @@ check_expression(struct Typecheck *self,
                                       Some(from__String(
                                         "expected integer typed expression")));
 
-                                emit__Diagnostic(err);
+                                emit_diagnostic(err);
                             }
                         }
                     } else
@@ -5408,7 +7944,7 @@ check_expression(struct Typecheck *self,
                                     from__String("define Int64, Int128, Uint64 "
                                                  "or Uint128 data type")));
 
-                                emit__Diagnostic(err);
+                                emit_diagnostic(err);
                             }
                             default: {
                                 kind = (int *)LiteralSymbolKindInt64;
@@ -5425,7 +7961,7 @@ check_expression(struct Typecheck *self,
                                       Some(from__String(
                                         "expected integer typed expression")));
 
-                                emit__Diagnostic(err);
+                                emit_diagnostic(err);
                             }
                         }
                     } else
@@ -5462,7 +7998,7 @@ check_expression(struct Typecheck *self,
                                   Some(from__String("define Int128 "
                                                     "or Uint128 data type")));
 
-                                emit__Diagnostic(err);
+                                emit_diagnostic(err);
                             default: {
                                 kind = (int *)LiteralSymbolKindInt128;
 
@@ -5478,7 +8014,7 @@ check_expression(struct Typecheck *self,
                                       Some(from__String(
                                         "expected integer typed expression")));
 
-                                emit__Diagnostic(err);
+                                emit_diagnostic(err);
                             }
                         }
                     } else
@@ -5524,8 +8060,22 @@ check_expression(struct Typecheck *self,
                             case DataTypeKindF64:
                                 kind = (int *)LiteralSymbolKindFloat64;
                                 break;
-                            default:
-                                assert(0 && "error: expected float data type");
+                            default: {
+                                kind = (int *)LiteralSymbolKindFloat64;
+
+                                struct Diagnostic *err = NEW(
+                                  DiagnosticWithErrTypecheck,
+                                  self,
+                                  NEW(LilyError, LilyErrorUnmatchedDataType),
+                                  expr->loc,
+                                  from__String(
+                                    "incompatibility between defined data "
+                                    "type and expression"),
+                                  Some(from__String(
+                                    "expected float typed expression")));
+
+                                emit_diagnostic(err);
+                            }
                         }
                     } else
                         kind = (int *)LiteralSymbolKindFloat64;
@@ -5559,20 +8109,24 @@ check_expression(struct Typecheck *self,
                 switch ((enum LiteralSymbolKind)(UPtr)kind) {
                     case LiteralSymbolKindBool:
                         ls = NEW(LiteralSymbolBool,
+                                 self->types,
                                  expr->value.literal.value.bool_);
                         break;
                     case LiteralSymbolKindChar:
                         ls = NEW(LiteralSymbolChar,
+                                 self->types,
                                  expr->value.literal.value.char_);
                         break;
                     case LiteralSymbolKindBitChar:
                         ls = NEW(LiteralSymbolBitChar,
+                                 self->types,
                                  expr->value.literal.value.bit_char);
                         break;
                     case LiteralSymbolKindInt8:
                         if (expr->value.literal.value.int32 >= MinInt8 &&
                             expr->value.literal.value.int32 <= MaxInt8)
                             ls = NEW(LiteralSymbolInt8,
+                                     self->types,
                                      (Int8)expr->value.literal.value.int32);
                         else {
                             struct Diagnostic *err =
@@ -5583,15 +8137,16 @@ check_expression(struct Typecheck *self,
                                   from__String("integer is too large for Int8"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolInt8, 0);
+                            ls = NEW(LiteralSymbolInt8, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindInt16:
                         if (expr->value.literal.value.int32 >= MinInt16 &&
                             expr->value.literal.value.int32 <= MaxInt16)
                             ls = NEW(LiteralSymbolInt16,
+                                     self->types,
                                      (Int16)expr->value.literal.value.int32);
                         else {
                             struct Diagnostic *err = NEW(
@@ -5602,31 +8157,36 @@ check_expression(struct Typecheck *self,
                               from__String("integer is too large for Int16"),
                               None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolInt16, 0);
+                            ls = NEW(LiteralSymbolInt16, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindInt32:
                         ls = NEW(LiteralSymbolInt32,
+                                 self->types,
                                  expr->value.literal.value.int32);
                         break;
                     case LiteralSymbolKindInt64:
                         ls = NEW(LiteralSymbolInt64,
+                                 self->types,
                                  expr->value.literal.value.int64);
                         break;
                     case LiteralSymbolKindInt128:
                         if (expr->value.literal.kind == LiteralKindInt64)
                             ls = NEW(LiteralSymbolInt128,
+                                     self->types,
                                      (Int128)expr->value.literal.value.int64);
                         else
                             ls = NEW(LiteralSymbolInt128,
+                                     self->types,
                                      expr->value.literal.value.int128);
                         break;
                     case LiteralSymbolKindUint8:
                         if (expr->value.literal.value.int32 >= 0 &&
                             expr->value.literal.value.int32 <= MaxUInt8)
                             ls = NEW(LiteralSymbolUint8,
+                                     self->types,
                                      (UInt8)expr->value.literal.value.int32);
                         else {
                             struct Diagnostic *err = NEW(
@@ -5637,15 +8197,16 @@ check_expression(struct Typecheck *self,
                               from__String("integer is too large for Uint8"),
                               None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolUint8, 0);
+                            ls = NEW(LiteralSymbolUint8, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindUint16:
                         if (expr->value.literal.value.int32 >= 0 &&
                             expr->value.literal.value.int32 <= MaxUInt16)
                             ls = NEW(LiteralSymbolUint16,
+                                     self->types,
                                      (UInt16)expr->value.literal.value.int32);
                         else {
                             struct Diagnostic *err = NEW(
@@ -5656,14 +8217,15 @@ check_expression(struct Typecheck *self,
                               from__String("integer is too large for Uint16"),
                               None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolUint16, 0);
+                            ls = NEW(LiteralSymbolUint16, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindUint32:
                         if (expr->value.literal.value.int32 >= 0)
                             ls = NEW(LiteralSymbolUint32,
+                                     self->types,
                                      expr->value.literal.value.int32);
                         else {
                             struct Diagnostic *err =
@@ -5674,14 +8236,15 @@ check_expression(struct Typecheck *self,
                                   from__String("integer is less than 0"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolUint32, 0);
+                            ls = NEW(LiteralSymbolUint32, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindUint64:
                         if (expr->value.literal.value.int64 >= 0)
                             ls = NEW(LiteralSymbolUint64,
+                                     self->types,
                                      expr->value.literal.value.int64);
                         else {
                             struct Diagnostic *err =
@@ -5692,14 +8255,15 @@ check_expression(struct Typecheck *self,
                                   from__String("integer is less than 0"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolUint64, 0);
+                            ls = NEW(LiteralSymbolUint64, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindUint128:
                         if (expr->value.literal.value.int128 >= 0)
                             ls = NEW(LiteralSymbolUint128,
+                                     self->types,
                                      expr->value.literal.value.int128);
                         else {
                             struct Diagnostic *err =
@@ -5710,18 +8274,20 @@ check_expression(struct Typecheck *self,
                                   from__String("integer is less than 0"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolUint128, 0);
+                            ls = NEW(LiteralSymbolUint128, self->types, 0);
                         }
                         break;
                     case LiteralSymbolKindFloat32: {
                         Float64 abs_value =
                           fabs(expr->value.literal.value.float_);
 
-                        if (abs_value >= MinPosFloat32 &&
-                            abs_value <= MaxFloat32)
+                        if (abs_value == 0 ||
+                            (abs_value >= MinPosFloat32 &&
+                             abs_value <= MaxFloat32))
                             ls = NEW(LiteralSymbolFloat32,
+                                     self->types,
                                      expr->value.literal.value.float_);
                         else {
                             struct Diagnostic *err =
@@ -5732,9 +8298,9 @@ check_expression(struct Typecheck *self,
                                   from__String("Float32 is out of range"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolFloat32, 0);
+                            ls = NEW(LiteralSymbolFloat32, self->types, 0);
                         }
                         break;
                     }
@@ -5742,9 +8308,11 @@ check_expression(struct Typecheck *self,
                         Float64 abs_value =
                           fabs(expr->value.literal.value.float_);
 
-                        if (abs_value >= MinPosFloat64 &&
-                            abs_value <= MaxFloat64)
+                        if (abs_value == 0 ||
+                            (abs_value >= MinPosFloat64 &&
+                             abs_value <= MaxFloat64))
                             ls = NEW(LiteralSymbolFloat64,
+                                     self->types,
                                      expr->value.literal.value.float_);
                         else {
                             struct Diagnostic *err =
@@ -5755,22 +8323,25 @@ check_expression(struct Typecheck *self,
                                   from__String("Float64 is out of range"),
                                   None());
 
-                            emit__Diagnostic(err);
+                            emit_diagnostic(err);
 
-                            ls = NEW(LiteralSymbolFloat64, 0);
+                            ls = NEW(LiteralSymbolFloat64, self->types, 0);
                         }
                         break;
                     }
                     case LiteralSymbolKindStr:
                         ls =
-                          NEW(LiteralSymbolStr, expr->value.literal.value.str);
+                          NEW(LiteralSymbolStr,
+                              self->types,
+                              expr->value.literal.value.str);
                         break;
                     case LiteralSymbolKindBitStr:
                         ls = NEW(LiteralSymbolBitStr,
+                                 self->types,
                                  expr->value.literal.value.bit_str);
                         break;
                     case LiteralSymbolKindUnit:
-                        ls = NEW(LiteralSymbolUnit);
+                        ls = NEW(LiteralSymbolUnit, self->types);
                         break;
                 }
 
@@ -5824,18 +8395,41 @@ check_expression(struct Typecheck *self,
                                             .search_trait = false,
                                             .search_class = false,
                                             .search_object = false,
-                                            .search_primary_type = false });
+                                            .search_primary_type = true });
                         break;
                 }
             }
 
+            // The value of an optional, a pointer, a reference or an exception
+            // is checked below, only a literal takes the data type of its
+            // value: x :: ?Int64 := 1.
+            struct DataTypeSymbol *defined_data_type_value =
+              defined_data_type_expr_variable;
+
+            if (defined_data_type_value)
+                switch (defined_data_type_value->kind) {
+                    case DataTypeKindOptional:
+                    case DataTypeKindPtr:
+                    case DataTypeKindRef:
+                    case DataTypeKindException:
+                        defined_data_type_value =
+                          is_literal_without_suffix(expr->value.variable.expr)
+                            ? get_literal_defined_data_type(
+                                defined_data_type_value->value.optional)
+                            : NULL;
+
+                        break;
+                    default:
+                        break;
+                }
+
             struct ExprSymbol *expr_variable =
               check_expression(self,
                                fun,
                                expr->value.variable.expr,
                                local_value,
                                local_data_type,
-                               defined_data_type_expr_variable,
+                               defined_data_type_value,
                                is_return_type);
 
             struct ExprSymbol *res =
@@ -5858,124 +8452,724 @@ check_expression(struct Typecheck *self,
                               expr_variable->data_type))
                             goto error;
 
-                        break;
-                    case DataTypeKindRef:
-                        if (!eq__DataTypeSymbol(
-                              defined_data_type_expr_variable->value.ref,
-                              expr_variable->data_type))
-                            goto error;
+                        break;
+                    case DataTypeKindRef:
+                        if (!eq__DataTypeSymbol(
+                              defined_data_type_expr_variable->value.ref,
+                              expr_variable->data_type))
+                            goto error;
+
+                        break;
+                    case DataTypeKindException:
+                        if (!eq__DataTypeSymbol(
+                              defined_data_type_expr_variable->value.exception,
+                              expr_variable->data_type))
+                            goto error;
+
+                        break;
+                    default:
+                        if (!eq__DataTypeSymbol(defined_data_type_expr_variable,
+                                                expr_variable->data_type)) {
+                        error : {
+                            struct Diagnostic *err =
+                              NEW(DiagnosticWithErrTypecheck,
+                                  self,
+                                  NEW(LilyError, LilyErrorUnmatchedDataType),
+                                  expr->loc,
+                                  from__String(""),
+                                  None());
+
+                            emit_diagnostic(err);
+                        }
+                        }
+
+                        break;
+                }
+            }
+
+            res->value.variable->data_type = defined_data_type_expr_variable;
+            res->value.variable->expr = expr_variable;
+            res->value.variable->scope =
+              NEW(Scope,
+                  self->parser.parse_block.scanner.src->file.name,
+                  res->value.variable->name,
+                  0,
+                  ScopeItemKindVariable,
+                  ScopeKindLocal,
+                  NULL);
+            res->value.variable->scope->data_type =
+              defined_data_type_expr_variable ? defined_data_type_expr_variable
+                                              : expr_variable->data_type;
+
+            add__LocalScopeChain(local_value, res->value.variable->scope);
+
+            return res;
+        }
+    }
+}
+
+struct StmtSymbol
+check_await_stmt(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct Stmt *stmt,
+                 struct LocalScopeChain *local_value,
+                 struct Vec *local_data_type)
+{
+    return NEW(StmtSymbolAwait,
+               *stmt,
+               check_expression(self,
+                                fun,
+                                stmt->value.await,
+                                local_value,
+                                local_data_type,
+                                NULL,
+                                false));
+}
+
+struct StmtSymbol
+check_return_stmt(struct Typecheck *self,
+                  struct FunSymbol *fun,
+                  struct Stmt *stmt,
+                  struct LocalScopeChain *local_value,
+                  struct Vec *local_data_type)
+{
+    // The return of a lambda gives the return data type of the lambda if it's
+    // not known yet.
+    if (current_lambda) {
+        struct ExprSymbol *expr = check_expression(self,
+                                                   fun,
+                                                   stmt->value.return_,
+                                                   local_value,
+                                                   local_data_type,
+                                                   current_lambda->return_type,
+                                                   false);
+
+        if (!current_lambda->return_type)
+            current_lambda->return_type = expr->data_type;
+
+        return NEW(StmtSymbolReturn, *stmt, expr);
+    }
+
+    struct ExprSymbol *expr = check_expression(self,
+                                               fun,
+                                               stmt->value.return_,
+                                               local_value,
+                                               local_data_type,
+                                               fun->return_type,
+                                               false);
+
+    infer_return_type(self, fun, expr);
+
+    return NEW(StmtSymbolReturn, *stmt, expr);
+}
+
+struct StmtSymbol
+check_for_stmt(struct Typecheck *self,
+               struct FunSymbol *fun,
+               struct Stmt *stmt,
+               struct LocalScopeChain *local_value,
+               struct Vec *local_data_type)
+{}
+
+struct ExprSymbol *
+check_condition(struct Typecheck *self,
+                struct FunSymbol *fun,
+                struct Expr *cond,
+                struct LocalScopeChain *local_value,
+                struct Vec *local_data_type)
+{
+    struct ExprSymbol *res =
+      check_expression(self,
+                       fun,
+                       cond,
+                       local_value,
+                       local_data_type,
+                       NEW(DataTypeSymbol, self->types, DataTypeKindBool),
+                       false);
+
+    return res;
+}
+
+// The local values of the block are dropped at its end.
+struct Vec *
+check_block(struct Typecheck *self,
+            struct FunSymbol *fun,
+            struct Vec *items,
+            struct LocalScopeChain *local_value,
+            struct Vec *local_data_type,
+            bool is_tail)
+{
+    struct Vec *body = NEW(Vec, sizeof(struct SymbolTable));
+
+    enter__LocalScopeChain(local_value);
+
+    for (Usize i = 0; i < len__Vec(*items); i++)
+        check_fun_body_item(self,
+                            fun,
+                            get__Vec(*items, i),
+                            body,
+                            local_value,
+                            local_data_type,
+                            is_tail && i + 1 == len__Vec(*items));
+
+    leave__LocalScopeChain(local_value);
+
+    return body;
+}
+
+struct StmtSymbol
+check_if_stmt(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Stmt *stmt,
+              struct LocalScopeChain *local_value,
+              struct Vec *local_data_type,
+              bool is_tail)
+{
+    struct IfCond *if_cond = stmt->value.if_;
+    // The if statement is the value of the function when each branch has a
+    // value: fun abs(x) = if x < 0 do -x else x end.
+    bool is_value = is_tail && if_cond->else_;
+    struct IfBranchSymbol *if_ = NEW(IfBranchSymbol,
+                                     check_condition(self,
+                                                     fun,
+                                                     if_cond->if_->cond,
+                                                     local_value,
+                                                     local_data_type),
+                                     check_block(self,
+                                                 fun,
+                                                 if_cond->if_->body,
+                                                 local_value,
+                                                 local_data_type,
+                                                 is_value));
+    struct Vec *elif = NULL;
+    struct IfBranchSymbol *else_ = NULL;
+
+    if (if_cond->elif) {
+        elif = NEW(Vec, sizeof(struct IfBranchSymbol));
+
+        for (Usize i = 0; i < len__Vec(*if_cond->elif); i++) {
+            struct IfBranch *branch = get__Vec(*if_cond->elif, i);
+
+            push__Vec(
+              elif,
+              NEW(IfBranchSymbol,
+                  check_condition(
+                    self, fun, branch->cond, local_value, local_data_type),
+                  check_block(self,
+                              fun,
+                              branch->body,
+                              local_value,
+                              local_data_type,
+                              is_value)));
+        }
+    }
+
+    if (if_cond->else_)
+        else_ = NEW(
+          IfBranchSymbol,
+          NULL,
+          check_block(
+            self, fun, if_cond->else_, local_value, local_data_type, is_value));
+
+    return NEW(StmtSymbolIf, *stmt, NEW(IfCondSymbol, if_, elif, else_));
+}
+
+// The data type of the matched value known so far: the data type of a param
+// without data type is inferred from the patterns (fun is_zero(x) = match x do
+// 0 => true, _ => false end).
+struct DataTypeSymbol *
+get_matching_data_type(struct FunSymbol *fun, struct ExprSymbol *matching)
+{
+    if (fun && fun->infer)
+        return to_data_type__Infer(fun->infer,
+                                   get_infer_node_of_expression(fun, matching));
+
+    return matching->data_type;
+}
+
+// The data type of the matched value is the data type of the pattern.
+void
+unify_pattern(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Location loc,
+              struct ExprSymbol *matching,
+              struct DataTypeSymbol *matching_data_type,
+              struct DataTypeSymbol *data_type)
+{
+    if (matching_data_type &&
+        matching_data_type->kind == DataTypeKindCompilerDefined) {
+        if (matching)
+            unify_expression(self, fun, matching, data_type);
+    } else if (!eq__DataTypeSymbol(matching_data_type, data_type)) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyError, LilyErrorUnmatchedDataType),
+              loc,
+              from__String(""),
+              None());
+
+        emit_diagnostic(err);
+    }
+}
+
+// A pattern is a wildcard (_), a literal, a variant (Color.Red, Red,
+// Shape.Circle:r) or a name which binds the matched value in the arm. The
+// data type is the data type of the matched value, matching is the matched
+// value of the match statement (NULL in the value of a variant).
+struct ExprSymbol *
+check_pattern(struct Typecheck *self,
+              struct FunSymbol *fun,
+              struct Expr *pattern,
+              struct ExprSymbol *matching,
+              struct DataTypeSymbol *data_type,
+              struct LocalScopeChain *local_value,
+              struct Vec *local_data_type)
+{
+    bool is_known =
+      data_type && data_type->kind != DataTypeKindCompilerDefined;
+
+    switch (pattern->kind) {
+        case ExprKindWildcard:
+            return NEW(ExprSymbol, pattern, data_type);
+        case ExprKindGrouping:
+            return check_pattern(self,
+                                 fun,
+                                 pattern->value.grouping,
+                                 matching,
+                                 data_type,
+                                 local_value,
+                                 local_data_type);
+        case ExprKindLiteral: {
+            struct ExprSymbol *literal = check_expression(self,
+                                                          fun,
+                                                          pattern,
+                                                          local_value,
+                                                          local_data_type,
+                                                          is_known ? data_type
+                                                                   : NULL,
+                                                          false);
+
+            if (!is_known && matching)
+                unify_expression(self, fun, matching, literal->data_type);
+
+            return literal;
+        }
+        case ExprKindIdentifier: {
+            struct EnumSymbol *enum_ = get_enum_of_data_type(self, data_type);
+            Isize variant_id =
+              enum_ ? get_variant_id(enum_, pattern->value.identifier) : -1;
+
+            // Red when the matched value is a Color.
+            if (variant_id != -1)
+                return new_variant_symbol(
+                  self, *pattern, enum_, variant_id, NULL, data_type);
+
+            struct Scope *scope =
+              NEW(Scope,
+                  self->parser.parse_block.scanner.src->file.name,
+                  pattern->value.identifier,
+                  0,
+                  ScopeItemKindVariable,
+                  ScopeKindLocal,
+                  NULL);
+
+            scope->data_type = data_type;
+            add__LocalScopeChain(local_value, scope);
+
+            return NEW(ExprSymbolIdentifier, *pattern, scope, data_type);
+        }
+        case ExprKindIdentifierAccess:
+        case ExprKindVariant: {
+            struct Expr *id = pattern->kind == ExprKindVariant
+                                ? pattern->value.variant.id
+                                : pattern;
+            struct Expr *value = pattern->kind == ExprKindVariant
+                                   ? pattern->value.variant.value
+                                   : NULL;
+            struct EnumSymbol *enum_ = NULL;
+            Isize variant_id = search_variant(self, id, data_type, &enum_);
+
+            if (variant_id == -1) {
+                emit_unknown_variant(self, id);
+
+                break;
+            }
+
+            struct VariantEnumSymbol *variant =
+              ((struct SymbolTable *)get__Vec(*enum_->variants, variant_id))
+                ->value.variant;
+            struct DataTypeSymbol *enum_data_type =
+              NEW(DataTypeSymbolCustom, self->types, NULL, NULL, enum_->scope);
+
+            unify_pattern(
+              self, fun, pattern->loc, matching, data_type, enum_data_type);
+
+            // Shape.Circle:$ matches any value of the variant.
+            if (value && !variant->data_type)
+                check_variant_value(self, pattern->loc, variant, value);
+
+            return new_variant_symbol(
+              self,
+              *pattern,
+              enum_,
+              variant_id,
+              value && variant->data_type ? check_pattern(self,
+                                                          fun,
+                                                          value,
+                                                          NULL,
+                                                          variant->data_type,
+                                                          local_value,
+                                                          local_data_type)
+                                          : NULL,
+              enum_data_type);
+        }
+        default: {
+            struct Diagnostic *err =
+              NEW(DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyError, LilyErrorInvalidPattern),
+                  pattern->loc,
+                  from__String(""),
+                  Some(from__String("expected a wildcard, a literal, a "
+                                    "variant or a name")));
+
+            emit_diagnostic(err);
+
+            break;
+        }
+    }
+
+    // The invalid pattern is checked as a wildcard.
+    struct Expr wildcard = { .kind = ExprKindWildcard, .loc = pattern->loc };
+
+    return NEW(ExprSymbol, &wildcard, data_type);
+}
+
+// The constructor of the pattern, NULL for a wildcard or a name (they match
+// any value).
+struct ExprSymbol *
+get_pattern_constructor(struct ExprSymbol *pattern)
+{
+    return pattern && (pattern->kind == ExprKindLiteral ||
+                       pattern->kind == ExprKindVariant)
+             ? pattern
+             : NULL;
+}
+
+bool
+is_same_constructor(struct ExprSymbol *x, struct ExprSymbol *y)
+{
+    if (x->kind != y->kind)
+        return false;
+
+    return x->kind == ExprKindVariant
+             ? x->value.variant.id.id == y->value.variant.id.id
+             : eq__LiteralSymbol(&x->value.literal, &y->value.literal);
+}
+
+// The rows of a pattern matrix are the patterns of the arms, its first column
+// is the matched value. A variant adds a column for its value (a wildcard if
+// the variant has no value).
+static inline Usize
+get_constructor_arity(struct ExprSymbol *constructor)
+{
+    return constructor->kind == ExprKindVariant;
+}
+
+// @return the row matched by the values of the constructor without its first
+// column, preceded by the value of the variant (NULL if the first pattern is
+// another constructor).
+struct ExprSymbol **
+specialize_pattern_row(struct ExprSymbol **row,
+                       Usize len,
+                       struct ExprSymbol *constructor)
+{
+    struct ExprSymbol *head = get_pattern_constructor(row[0]);
+    Usize arity = get_constructor_arity(constructor);
+
+    if (head && !is_same_constructor(head, constructor))
+        return NULL;
+
+    struct ExprSymbol **res =
+      malloc(sizeof(struct ExprSymbol *) * (len - 1 + arity + 1));
+
+    if (arity)
+        res[0] = head ? head->value.variant.value : NULL;
+
+    memcpy(res + arity, row + 1, sizeof(struct ExprSymbol *) * (len - 1));
+
+    return res;
+}
+
+bool
+is_useful_constructor(struct Typecheck *self,
+                      struct ExprSymbol ***rows,
+                      Usize rows_len,
+                      struct ExprSymbol **row,
+                      Usize len,
+                      struct ExprSymbol *constructor)
+{
+    struct ExprSymbol ***specialized =
+      malloc(sizeof(struct ExprSymbol **) * (rows_len + 1));
+    Usize specialized_len = 0;
+    struct ExprSymbol **specialized_row =
+      specialize_pattern_row(row, len, constructor);
+
+    for (Usize i = 0; i < rows_len; i++) {
+        struct ExprSymbol **specialized_i =
+          specialize_pattern_row(rows[i], len, constructor);
+
+        if (specialized_i)
+            specialized[specialized_len++] = specialized_i;
+    }
+
+    bool res = is_useful_pattern(self,
+                                 specialized,
+                                 specialized_len,
+                                 specialized_row,
+                                 len - 1 + get_constructor_arity(constructor));
+
+    for (Usize i = 0; i < specialized_len; i++)
+        free(specialized[i]);
+
+    free(specialized);
+    free(specialized_row);
+
+    return res;
+}
+
+// A row is useful if a value is matched by the row and by none of the rows of
+// the matrix (Maranget, "Warnings for pattern matching"). The variants of the
+// first column are counted by index, the matrix of an enum of hundreds of
+// variants stays linear.
+bool
+is_useful_pattern(struct Typecheck *self,
+                  struct ExprSymbol ***rows,
+                  Usize rows_len,
+                  struct ExprSymbol **row,
+                  Usize len)
+{
+    if (len == 0)
+        return rows_len == 0;
+
+    struct ExprSymbol *head = get_pattern_constructor(row[0]);
+
+    if (head)
+        return is_useful_constructor(self, rows, rows_len, row, len, head);
 
-                        break;
-                    case DataTypeKindException:
-                        if (!eq__DataTypeSymbol(
-                              defined_data_type_expr_variable->value.exception,
-                              expr_variable->data_type))
-                            goto error;
+    struct ExprSymbol **constructors =
+      malloc(sizeof(struct ExprSymbol *) * (rows_len + 1));
+    Usize constructors_len = 0;
+    struct EnumSymbol *enum_ = NULL;
+    bool *is_variant_seen = NULL;
 
-                        break;
-                    default:
-                        if (!eq__DataTypeSymbol(defined_data_type_expr_variable,
-                                                expr_variable->data_type)) {
-                        error : {
-                            struct Diagnostic *err =
-                              NEW(DiagnosticWithErrTypecheck,
-                                  self,
-                                  NEW(LilyError, LilyErrorUnmatchedDataType),
-                                  expr->loc,
-                                  from__String(""),
-                                  None());
+    for (Usize i = 0; i < rows_len; i++) {
+        struct ExprSymbol *constructor = get_pattern_constructor(rows[i][0]);
 
-                            emit__Diagnostic(err);
-                        }
-                        }
+        if (!constructor)
+            continue;
 
-                        break;
-                }
+        if (constructor->kind == ExprKindVariant) {
+            if (!is_variant_seen) {
+                enum_ = get_enum_of_data_type(self, constructor->data_type);
+                is_variant_seen =
+                  calloc(enum_ ? len__Vec(*enum_->variants) : 1, sizeof(bool));
             }
 
-            res->value.variable->data_type = defined_data_type_expr_variable;
-            res->value.variable->expr = expr_variable;
-            res->value.variable->scope =
-              NEW(Scope,
-                  self->parser.parse_block.scanner.src->file.name,
-                  res->value.variable->name,
-                  len__Vec(*local_value),
-                  ScopeItemKindVariable,
-                  ScopeKindLocal,
-                  NULL);
+            if (!enum_ || is_variant_seen[constructor->value.variant.id.id])
+                continue;
 
-            push__Vec(local_value, res->value.variable->scope);
+            is_variant_seen[constructor->value.variant.id.id] = true;
+        } else {
+            Usize j = 0;
 
-            return res;
+            while (j < constructors_len &&
+                   !is_same_constructor(constructors[j], constructor))
+                j++;
+
+            if (j < constructors_len)
+                continue;
         }
+
+        constructors[constructors_len++] = constructor;
     }
+
+    // The constructors cover the values of the data type: all the variants of
+    // the enum, true and false.
+    bool is_complete =
+      constructors_len &&
+      (enum_ ? constructors_len == len__Vec(*enum_->variants)
+             : constructors[0]->kind == ExprKindLiteral &&
+                 constructors[0]->value.literal.kind ==
+                   LiteralSymbolKindBool &&
+                 constructors_len == 2);
+    bool res = false;
+
+    if (is_complete) {
+        for (Usize i = 0; i < constructors_len && !res; i++)
+            res = is_useful_constructor(
+              self, rows, rows_len, row, len, constructors[i]);
+    } else {
+        // The rows whose first pattern is a wildcard or a name.
+        struct ExprSymbol ***defaults =
+          malloc(sizeof(struct ExprSymbol **) * (rows_len + 1));
+        Usize defaults_len = 0;
+
+        for (Usize i = 0; i < rows_len; i++)
+            if (!get_pattern_constructor(rows[i][0]))
+                defaults[defaults_len++] = rows[i] + 1;
+
+        res = is_useful_pattern(self, defaults, defaults_len, row + 1, len - 1);
+
+        free(defaults);
+    }
+
+    free(constructors);
+    free(is_variant_seen);
+
+    return res;
 }
 
+// The arms are checked in order, each in its own local scope (the names bound
+// by its pattern). An arm which only matches values matched by the previous
+// arms without guard is unreachable: it's reported and dropped. An arm whose
+// pattern has an error is left out of the reachability and exhaustiveness
+// checks (the invalid pattern is checked as a wildcard).
 struct StmtSymbol
-check_await_stmt(struct Typecheck *self,
+check_match_stmt(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Stmt *stmt,
-                 struct Vec *local_value,
-                 struct Vec *local_data_type)
+                 struct LocalScopeChain *local_value,
+                 struct Vec *local_data_type,
+                 bool is_tail)
 {
-    return NEW(StmtSymbolAwait,
-               *stmt,
-               check_expression(self,
-                                fun,
-                                stmt->value.await,
-                                local_value,
-                                local_data_type,
-                                NULL,
-                                false));
-}
+    struct MatchStmt *match = stmt->value.match;
+    struct ExprSymbol *matching = check_expression(self,
+                                                   fun,
+                                                   match->matching,
+                                                   local_value,
+                                                   local_data_type,
+                                                   NULL,
+                                                   false);
+    struct Vec *pattern = NEW(Vec, sizeof(struct Tuple));
+    Usize arms_len = len__Vec(*match->pattern);
+    // The patterns of the arms without guard (a pattern matrix of one column).
+    struct ExprSymbol **patterns =
+      malloc(sizeof(struct ExprSymbol *) * (arms_len + 1));
+    struct ExprSymbol ***rows =
+      malloc(sizeof(struct ExprSymbol **) * (arms_len + 1));
+    Usize rows_len = 0;
+    struct DataTypeSymbol *value_data_type = NULL;
+    bool has_invalid_pattern = false;
+
+    for (Usize i = 0; i < arms_len; i++) {
+        struct Tuple *arm = get__Vec(*match->pattern, i);
+
+        enter__LocalScopeChain(local_value);
+
+        Usize previous_count_error = count_error;
+        struct ExprSymbol *arm_pattern =
+          check_pattern(self,
+                        fun,
+                        arm->items[0],
+                        matching,
+                        get_matching_data_type(fun, matching),
+                        local_value,
+                        local_data_type);
+        bool is_invalid_pattern = count_error != previous_count_error;
+        struct ExprSymbol *guard =
+          arm->items[1]
+            ? check_condition(
+                self, fun, arm->items[1], local_value, local_data_type)
+            : NULL;
+        // The match statement is the value of the function when it's the last
+        // item of the body: fun is_zero(x) = match x do 0 => true, _ => false
+        // end.
+        struct ExprSymbol *body = check_expression(self,
+                                                   fun,
+                                                   arm->items[2],
+                                                   local_value,
+                                                   local_data_type,
+                                                   is_tail ? fun->return_type
+                                                           : NULL,
+                                                   false);
+
+        if (is_tail)
+            infer_return_type(self, fun, body);
+
+        leave__LocalScopeChain(local_value);
+
+        has_invalid_pattern |= is_invalid_pattern;
+
+        if (!is_invalid_pattern &&
+            !is_useful_pattern(self, rows, rows_len, &arm_pattern, 1)) {
+            struct Diagnostic *warn =
+              NEW(DiagnosticWithWarnTypecheck,
+                  self,
+                  NEW(LilyWarning, LilyWarningUnreachableMatchArm),
+                  arm_pattern->loc,
+                  from__String("the values of this pattern are matched by "
+                               "the previous arms"),
+                  Some(from__String("remove this arm")));
 
-struct StmtSymbol
-check_return_stmt(struct Typecheck *self,
-                  struct FunSymbol *fun,
-                  struct Stmt *stmt,
-                  struct Vec *local_value,
-                  struct Vec *local_data_type)
-{
-    return NEW(StmtSymbolAwait,
-               *stmt,
-               check_expression(self,
-                                fun,
-                                stmt->value.return_,
-                                local_value,
-                                local_data_type,
-                                NULL,
-                                false));
-}
+            emit_warning__Diagnostic(
+              warn, self->parser.parse_block.disable_warning);
 
-struct StmtSymbol
-check_for_stmt(struct Typecheck *self,
-               struct FunSymbol *fun,
-               struct Stmt *stmt,
-               struct Vec local_value,
-               struct Vec *local_data_type)
-{}
+            FREE(ExprSymbolAll, arm_pattern);
 
-struct StmtSymbol
-check_if_stmt(struct Typecheck *self,
-              struct FunSymbol *fun,
-              struct Stmt *stmt,
-              struct Vec local_value,
-              struct Vec *local_data_type)
-{}
+            if (guard)
+                FREE(ExprSymbolAll, guard);
 
-struct StmtSymbol
-check_match_stmt(struct Typecheck *self,
-                 struct FunSymbol *fun,
-                 struct Stmt *stmt,
-                 struct Vec local_value,
-                 struct Vec *local_data_type)
-{}
+            FREE(ExprSymbolAll, body);
+
+            continue;
+        }
+
+        if (!guard && !is_invalid_pattern) {
+            patterns[rows_len] = arm_pattern;
+            rows[rows_len] = &patterns[rows_len];
+            rows_len++;
+        }
+
+        if (!value_data_type)
+            value_data_type = body->data_type;
+
+        struct Vec *body_items = NEW(Vec, sizeof(struct SymbolTable));
+
+        push__Vec(body_items, NEW(SymbolTableExpr, body));
+        push__Vec(pattern, NEW(Tuple, 3, arm_pattern, guard, body_items));
+    }
+
+    // Without a value for each value of the matched value, the function has
+    // no return value.
+    struct ExprSymbol *wildcard = NULL;
+
+    if (is_tail && !has_invalid_pattern && value_data_type &&
+        value_data_type->kind != DataTypeKindUnit &&
+        is_useful_pattern(self, rows, rows_len, &wildcard, 1)) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrTypecheck,
+              self,
+              NEW(LilyError, LilyErrorNonExhaustiveMatch),
+              stmt->loc,
+              from__String(""),
+              Some(from__String("add an arm with a wildcard (_)")));
+
+        emit_diagnostic(err);
+    }
+
+    free(patterns);
+    free(rows);
+
+    return NEW(StmtSymbolMatch, *stmt, NEW(MatchSymbol, matching, pattern));
+}
 
 struct StmtSymbol
 check_try_stmt(struct Typecheck *self,
                struct FunSymbol *fun,
                struct Stmt *stmt,
-               struct Vec local_value,
+               struct LocalScopeChain *local_value,
                struct Vec *local_data_type)
 {}
 
@@ -5983,113 +9177,362 @@ struct StmtSymbol
 check_while_stmt(struct Typecheck *self,
                  struct FunSymbol *fun,
                  struct Stmt *stmt,
-                 struct Vec local_value,
+                 struct LocalScopeChain *local_value,
                  struct Vec *local_data_type)
-{}
+{
+    return NEW(StmtSymbolWhile,
+               *stmt,
+               NEW(WhileSymbol,
+                   check_condition(self,
+                                   fun,
+                                   stmt->value.while_->cond,
+                                   local_value,
+                                   local_data_type),
+                   check_block(self,
+                               fun,
+                               stmt->value.while_->body,
+                               local_value,
+                               local_data_type,
+                               false)));
+}
+
+// The last item of the body (is_tail) is the value of the function.
+void
+check_fun_body_item(struct Typecheck *self,
+                    struct FunSymbol *fun,
+                    struct FunBodyItem *item,
+                    struct Vec *body,
+                    struct LocalScopeChain *local_value,
+                    struct Vec *local_data_type,
+                    bool is_tail)
+{
+    switch (item->kind) {
+        case FunBodyItemKindExpr: {
+            bool is_value = is_tail && item->expr->kind != ExprKindVariable;
+            struct ExprSymbol *expr =
+              check_expression(self,
+                               fun,
+                               item->expr,
+                               local_value,
+                               local_data_type,
+                               is_value ? fun->return_type : NULL,
+                               false);
+
+            // fun add(x) = x; the body is the return value.
+            if (is_value)
+                infer_return_type(self, fun, expr);
+
+            push__Vec(body, NEW(SymbolTableExpr, expr));
+
+            break;
+        }
+        case FunBodyItemKindStmt: {
+            struct Stmt *stmt = item->stmt;
+
+            switch (stmt->kind) {
+                case StmtKindAwait:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt,
+                                  check_await_stmt(self,
+                                                   fun,
+                                                   stmt,
+                                                   local_value,
+                                                   local_data_type)));
+
+                    break;
+                case StmtKindReturn:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt,
+                                  check_return_stmt(self,
+                                                    fun,
+                                                    stmt,
+                                                    local_value,
+                                                    local_data_type)));
+
+                    break;
+                case StmtKindFor:
+                    push__Vec(
+                      body,
+                      NEW(SymbolTableStmt,
+                          check_for_stmt(
+                            self, fun, stmt, local_value, local_data_type)));
+
+                    break;
+                case StmtKindIf:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt,
+                                  check_if_stmt(self,
+                                                fun,
+                                                stmt,
+                                                local_value,
+                                                local_data_type,
+                                                is_tail)));
+
+                    break;
+                case StmtKindMatch:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt,
+                                  check_match_stmt(self,
+                                                   fun,
+                                                   stmt,
+                                                   local_value,
+                                                   local_data_type,
+                                                   is_tail)));
+
+                    break;
+                case StmtKindTry:
+                    push__Vec(
+                      body,
+                      NEW(SymbolTableStmt,
+                          check_try_stmt(
+                            self, fun, stmt, local_value, local_data_type)));
+
+                    break;
+                case StmtKindWhile:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt,
+                                  check_while_stmt(self,
+                                                   fun,
+                                                   stmt,
+                                                   local_value,
+                                                   local_data_type)));
+
+                    break;
+                case StmtKindBreak:
+                case StmtKindNext:
+                    push__Vec(body,
+                              NEW(SymbolTableStmt, NEW(StmtSymbol, *stmt)));
+
+                    break;
+                case StmtKindImport:
+                    break;
+            }
+
+            break;
+        }
+    }
+}
 
 void
 check_fun_body(struct Typecheck *self,
                struct FunSymbol *fun,
                struct Vec *fun_body,
-               struct Vec *local_value,
+               struct LocalScopeChain *local_value,
                struct Vec *local_data_type)
 {
-    for (Usize i = 0; i < len__Vec(*fun->fun_decl->value.fun->body); i++) {
-        switch (
-          ((struct FunBodyItem *)get__Vec(*fun->fun_decl->value.fun->body, i))
-            ->kind) {
-            case FunBodyItemKindExpr:
-                push__Vec(
-                  fun_body,
-                  NEW(SymbolTableExpr,
-                      check_expression(self,
-                                       fun,
-                                       ((struct FunBodyItem *)get__Vec(
-                                          *fun->fun_decl->value.fun->body, i))
-                                         ->expr,
-                                       local_value,
-                                       local_data_type,
-                                       NULL,
-                                       false)));
+    struct Vec *items = fun->fun_decl->value.fun->body;
+
+    for (Usize i = 0; i < len__Vec(*items); i++)
+        check_fun_body_item(self,
+                            fun,
+                            get__Vec(*items, i),
+                            fun_body,
+                            local_value,
+                            local_data_type,
+                            i + 1 == len__Vec(*items));
+}
+
+// #tailrec is a built-in tag, it is not resolved as a data type.
+bool
+is_tailrec_tag(struct DataType *tag)
+{
+    if (tag->kind != DataTypeKindCustom || tag->value.custom->items[1])
+        return false;
+
+    struct Vec *names = tag->value.custom->items[0];
+
+    if (!names || len__Vec(*names) != 1)
+        return false;
+
+    Str name = to_Str__String(*(struct String *)get__Vec(*names, 0));
+    bool is_tailrec = !strcmp(name, "tailrec");
+
+    free(name);
+
+    return is_tailrec;
+}
+
+bool
+is_self_call(struct FunSymbol *fun, struct ExprSymbol *expr)
+{
+    struct Scope *id = expr->value.fun_call.id;
+
+    return !expr->value.fun_call.is_builtin && id &&
+           id->item_kind == ScopeItemKindFun && fun->scope &&
+           !fun->scope->previous && id->id == fun->scope->id &&
+           eq__String(id->name, fun->scope->name, false);
+}
+
+// A call is in tail position if its value is the value of the function: the
+// last item of the body, a returned expression or the last item of a branch
+// of an if or of an arm of a match in tail position.
+void
+check_tail_calls_of_expr(struct Typecheck *self,
+                         struct FunSymbol *fun,
+                         struct ExprSymbol *expr,
+                         bool is_tail)
+{
+    if (!expr)
+        return;
+
+    switch (expr->kind) {
+        case ExprKindFunCall:
+            if (!is_tail && is_self_call(fun, expr)) {
+                // The name of the callee (the location of the call can end on
+                // the next line).
+                struct Location loc = {
+                    .s_line = expr->loc.s_line,
+                    .s_col = expr->loc.s_col,
+                    .e_line = expr->loc.s_line,
+                    .e_col = expr->loc.s_col + len__String(*fun->name) - 1
+                };
+                struct Diagnostic *err = NEW(
+                  DiagnosticWithErrTypecheck,
+                  self,
+                  NEW(LilyErrorWithString,
+                      LilyErrorNotTailCall,
+                      format("{S}", fun->name)),
+                  loc,
+                  from__String(""),
+                  Some(from__String("the function is tagged #tailrec: "
+                                    "return the value of the call")));
+
+                emit_diagnostic(err);
+            }
 
+            if (expr->value.fun_call.params)
+                for (Usize i = 0; i < len__Vec(*expr->value.fun_call.params);
+                     i++)
+                    check_tail_calls_of_expr(
+                      self,
+                      fun,
+                      ((struct Tuple *)get__Vec(*expr->value.fun_call.params,
+                                                i))
+                        ->items[0],
+                      false);
+
+            break;
+        case ExprKindUnaryOp:
+            check_tail_calls_of_expr(
+              self, fun, expr->value.unary_op.right, false);
+            break;
+        case ExprKindBinaryOp:
+            check_tail_calls_of_expr(
+              self, fun, expr->value.binary_op.left, false);
+            check_tail_calls_of_expr(
+              self, fun, expr->value.binary_op.right, false);
+            break;
+        case ExprKindRecordCall:
+            if (expr->value.record_call.fields)
+                for (Usize i = 0; i < len__Vec(*expr->value.record_call.fields);
+                     i++)
+                    check_tail_calls_of_expr(
+                      self,
+                      fun,
+                      ((struct FieldCallSymbol *)((struct Tuple *)get__Vec(
+                                                    *expr->value.record_call
+                                                       .fields,
+                                                    i))
+                         ->items[0])
+                        ->value,
+                      false);
+
+            break;
+        case ExprKindTuple:
+        case ExprKindArray: {
+            struct Vec *items = expr->kind == ExprKindTuple
+                                  ? expr->value.tuple
+                                  : expr->value.array;
+
+            if (items)
+                for (Usize i = 0; i < len__Vec(*items); i++)
+                    check_tail_calls_of_expr(
+                      self, fun, get__Vec(*items, i), false);
+
+            break;
+        }
+        case ExprKindVariant:
+            check_tail_calls_of_expr(
+              self, fun, expr->value.variant.value, false);
+            break;
+        case ExprKindVariable:
+            check_tail_calls_of_expr(
+              self, fun, expr->value.variable->expr, false);
+            break;
+        case ExprKindGrouping:
+            check_tail_calls_of_expr(
+              self, fun, expr->value.grouping->items[0], is_tail);
+            break;
+        default:
+            break;
+    }
+}
+
+void
+check_tail_calls(struct Typecheck *self,
+                 struct FunSymbol *fun,
+                 struct Vec *body,
+                 bool is_tail)
+{
+    if (!body)
+        return;
+
+    for (Usize i = 0; i < len__Vec(*body); i++) {
+        struct SymbolTable *item = get__Vec(*body, i);
+        bool is_last = is_tail && i + 1 == len__Vec(*body);
+
+        if (item->kind == SymbolTableKindExpr) {
+            check_tail_calls_of_expr(self, fun, item->value.expr, is_last);
+            continue;
+        } else if (item->kind != SymbolTableKindStmt)
+            continue;
+
+        struct StmtSymbol *stmt = &item->value.stmt;
+
+        switch (stmt->kind) {
+            case StmtKindReturn:
+                check_tail_calls_of_expr(self, fun, stmt->value.return_, true);
                 break;
-            case FunBodyItemKindStmt: {
-                struct Stmt *stmt = ((struct FunBodyItem *)get__Vec(
-                                       *fun->fun_decl->value.fun->body, i))
-                                      ->stmt;
+            case StmtKindIf: {
+                struct IfCondSymbol *if_ = &stmt->value.if_;
 
-                switch (stmt->kind) {
-                    case StmtKindAwait:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_await_stmt(
-                              self, fun, stmt, local_value, local_data_type)));
+                check_tail_calls_of_expr(self, fun, if_->if_->cond, false);
+                check_tail_calls(self, fun, if_->if_->body, is_last);
 
-                        break;
-                    case StmtKindReturn:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_return_stmt(
-                              self, fun, stmt, local_value, local_data_type)));
+                if (if_->elif)
+                    for (Usize j = 0; j < len__Vec(*if_->elif); j++) {
+                        struct IfBranchSymbol *elif = get__Vec(*if_->elif, j);
 
-                        break;
-                    case StmtKindFor:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_for_stmt(
-                              self, fun, stmt, *local_value, local_data_type)));
+                        check_tail_calls_of_expr(self, fun, elif->cond, false);
+                        check_tail_calls(self, fun, elif->body, is_last);
+                    }
 
-                        break;
-                    case StmtKindIf:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_if_stmt(
-                              self, fun, stmt, *local_value, local_data_type)));
+                if (if_->else_)
+                    check_tail_calls(self, fun, if_->else_->body, is_last);
 
-                        break;
-                    case StmtKindMatch:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_match_stmt(
-                              self, fun, stmt, *local_value, local_data_type)));
+                break;
+            }
+            case StmtKindMatch: {
+                struct MatchSymbol *match = &stmt->value.match;
 
-                        break;
-                    case StmtKindTry:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_try_stmt(
-                              self, fun, stmt, *local_value, local_data_type)));
+                check_tail_calls_of_expr(self, fun, match->matching, false);
 
-                        break;
-                    case StmtKindWhile:
-                        push__Vec(
-                          fun_body,
-                          NEW(
-                            SymbolTableStmt,
-                            check_while_stmt(
-                              self, fun, stmt, *local_value, local_data_type)));
+                for (Usize j = 0; j < len__Vec(*match->pattern); j++) {
+                    struct Tuple *arm = get__Vec(*match->pattern, j);
 
-                        break;
-                    case StmtKindImport:
-                    case StmtKindBreak:
-                    case StmtKindNext:
-                        break;
+                    check_tail_calls_of_expr(self, fun, arm->items[1], false);
+                    check_tail_calls(self, fun, arm->items[2], is_last);
                 }
 
                 break;
             }
+            case StmtKindWhile:
+                check_tail_calls_of_expr(
+                  self, fun, stmt->value.while_.cond, false);
+                check_tail_calls(self, fun, stmt->value.while_.body, false);
+                break;
+            default:
+                break;
         }
     }
 }
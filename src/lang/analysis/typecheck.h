@@ -25,14 +25,21 @@
 #ifndef LILY_TYPECHECK_H
 #define LILY_TYPECHECK_H
 
+#include <lang/analysis/dep_graph.h>
+#include <lang/analysis/module_graph.h>
 #include <lang/parser/parser.h>
 
 typedef struct Typecheck
 {
     struct Parser parser;
     struct Decl *decl;
-    struct Vec *buffers;       // struct Vec<struct Typecheck*>*
-    struct Vec *builtins;      // struct Vec<struct Builtin*>*
+    struct Vec *buffers;       // struct Vec<struct Typecheck&>* (the imported
+                               // modules, owned by the ModuleGraph)
+    struct ModuleGraph *graph; // struct ModuleGraph* (owned by the root
+                               // Typecheck, shared by the imported modules)
+    bool own_graph;
+    const struct BuiltinTable *builtins; // const struct BuiltinTable& (shared
+                                         // by all the Typecheck)
     struct Vec *import_values; // struct Vec<struct Tuple<struct SymbolTable*>,
                                // int*, Str>* the int* value represents if the
                                // SymbolTable* is free
@@ -47,6 +54,21 @@ typedef struct Typecheck
     struct Vec *traits;        // struct Vec<struct TraitSymbol*>*
     struct Vec *records_obj;   // struct Vec<struct RecordObjSymbol*>*
     struct Vec *enums_obj;     // struct Vec<struct EnumObjSymbol*>
+    struct ScopeIndex *index;  // struct ScopeIndex* (the symbols of the file)
+    struct TypeInterner *types; // struct TypeInterner& (the data types of the
+                                // session, owned by the ModuleGraph)
+    struct QueryEngine *queries; // struct QueryEngine& (owned by the
+                                 // ModuleGraph)
+    struct ScopeIndex *resolved; // struct ScopeIndex* (memo of the resolve
+                                 // query, the symbol is NULL if the name
+                                 // resolves to nothing)
+    struct DepGraph *deps; // struct DepGraph* (the dependencies between the
+                           // declarations of the file)
+    struct Vec *previous_parsers; // struct Vec<struct Parser*>* (the parsers
+                                  // replaced by recheck__Typecheck, the
+                                  // unchanged symbols still borrow their AST)
+    Usize jobs; // number of threads used to load the imported modules and to
+                // check the function bodies (-j N)
 } Typecheck;
 
 /**
@@ -63,6 +85,25 @@ __new__Typecheck(struct Parser parser);
 void
 run__Typecheck(struct Typecheck *self, struct Vec *primary_buffer);
 
+// Returned by recheck__Typecheck when the changes cannot be checked in place.
+#define TYPECHECK_RECHECK_ALL ((Usize)-1)
+
+/**
+ *
+ * @brief Check again the declarations affected by the changes between the
+ * file and its new version (parsed by parser). The declarations are matched
+ * by name, then compared by the hash of their signature and of their body:
+ * only the changed, moved or added functions and the users of a changed
+ * signature are checked again. The functions are bound to their new
+ * declaration.
+ * @return the number of functions checked again or TYPECHECK_RECHECK_ALL if a
+ * declaration is removed, if a declaration which is not a function is added,
+ * moved or changed or if the change reaches a declaration which is not a
+ * function (the Typecheck must then be run again from a new Typecheck).
+ */
+Usize
+recheck__Typecheck(struct Typecheck *self, struct Parser parser);
+
 /**
  *
  * @brief Free the Typecheck type.
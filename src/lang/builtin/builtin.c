@@ -22,95 +22,49 @@
  * SOFTWARE.
  */
 
-#include <base/macros.h>
 #include <base/new.h>
-#include <base/string.h>
 #include <base/vec.h>
-#include <lang/analysis/symbol_table.h>
 #include <lang/builtin/builtin.h>
-#include <stdlib.h>
+#include <string.h>
 
-struct BuiltinFun *
-__new__BuiltinFun(const Str name, struct Vec *params)
-{
-    struct BuiltinFun *self = malloc(sizeof(struct BuiltinFun));
-    self->name = name;
-    self->params = params;
-    return self;
-}
+#define BUILTIN_KEY_MAX_LEN 128
 
 void
-__free__BuiltinFun(struct BuiltinFun *self)
+index__BuiltinTable(struct BuiltinTable *self)
 {
-    for (Usize i = len__Vec(*self->params); i--;)
-        FREE(DataTypeSymbolAll, get__Vec(*self->params, i));
+    self->index = NEW(StrMap);
 
-    FREE(Vec, self->params);
-    free(self);
+    for (Usize i = 0; i < self->entry_count; i++)
+        insert__StrMap(
+          self->index, self->entries[i].key, (void *)&self->entries[i]);
 }
 
-struct BuiltinModule *
-__new__BuiltinModule(const Str name, struct Vec *items)
+const struct BuiltinFun *
+search__BuiltinTable(const struct BuiltinTable *self,
+                     const Str module_name,
+                     const Str fun_name,
+                     Usize param_count)
 {
-    struct BuiltinModule *self = malloc(sizeof(struct BuiltinModule));
-    self->name = name;
-    self->items = items;
-    return self;
-}
+    Usize module_name_len = strlen(module_name);
+    Usize fun_name_len = strlen(fun_name);
+    char key[BUILTIN_KEY_MAX_LEN];
 
-void
-__free__BuiltinModule(struct BuiltinModule *self)
-{
-    for (Usize i = len__Vec(*self->items); i--;)
-        FREE(BuiltinAll, get__Vec(*self->items, i));
+    if (module_name_len + fun_name_len + 1 > BUILTIN_KEY_MAX_LEN)
+        return NULL;
 
-    FREE(Vec, self->items);
-    free(self);
-}
+    memcpy(key, module_name, module_name_len);
+    key[module_name_len] = '.';
+    memcpy(key + module_name_len + 1, fun_name, fun_name_len);
 
-struct Builtin *
-__new__BuiltinFunVar(struct BuiltinFun *fun)
-{
-    struct Builtin *self = malloc(sizeof(struct Builtin));
-    self->kind = BuiltinKindFun;
-    self->fun = fun;
-    return self;
-}
+    const struct BuiltinEntry *entry = get_with_len__StrMap(
+      *self->index, key, module_name_len + fun_name_len + 1);
 
-struct Builtin *
-__new__BuiltinModuleVar(struct BuiltinModule *module)
-{
-    struct Builtin *self = malloc(sizeof(struct Builtin));
-    self->kind = BuiltinKindModule;
-    self->module = module;
-    return self;
-}
+    if (!entry)
+        return NULL;
 
-void
-__free__BuiltinFunVar(struct Builtin *self)
-{
-    FREE(BuiltinFun, self->fun);
-    free(self);
-}
+    for (Usize i = 0; i < entry->fun_count; i++)
+        if (len__Vec(*entry->funs[i].params) == param_count)
+            return &entry->funs[i];
 
-void
-__free__BuiltinModuleVar(struct Builtin *self)
-{
-    FREE(BuiltinModule, self->module);
-    free(self);
-}
-
-void
-__free__BuiltinAll(struct Builtin *self)
-{
-    switch (self->kind) {
-        case BuiltinKindFun:
-            FREE(BuiltinFunVar, self);
-            break;
-        case BuiltinKindModule:
-            FREE(BuiltinModuleVar, self);
-            break;
-        default:
-            UNREACHABLE("unknown builtin kind");
-    }
+    return NULL;
 }
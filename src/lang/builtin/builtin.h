@@ -25,99 +25,64 @@
 #ifndef LILY_BUILTIN_H
 #define LILY_BUILTIN_H
 
+#include <base/str_map.h>
 #include <base/types.h>
 
-enum BuiltinKind
-{
-    BuiltinKindFun,
-    BuiltinKindModule
-};
+// The builtin tables are generated at build time (see builtin_gen.c), so all
+// the types below are only used through const pointers.
 
 typedef struct BuiltinFun
 {
     Str name;
-    struct Vec *params; // struct Vec<struct DataTypeSymbol*>*
+    struct Vec *params; // struct Vec<struct DataTypeSymbol&>*
     // Last params is the return type
 } BuiltinFun;
 
-/**
- *
- * @brief Construct the BuiltinFun type.
- */
-struct BuiltinFun *
-__new__BuiltinFun(const Str name, struct Vec *params);
-
-/**
- *
- * @brief Free the BuiltinFun type.
- */
-void
-__free__BuiltinFun(struct BuiltinFun *self);
+// All the overloads of a function of a module (they differ by their number of
+// params).
+typedef struct BuiltinEntry
+{
+    Str key;                       // <module name>.<fun name>
+    const struct BuiltinFun *funs; // const struct BuiltinFun&
+    Usize fun_count;
+} BuiltinEntry;
 
 typedef struct BuiltinModule
 {
     Str name;
-    struct Vec *items; // struct Vec<struct Builtin*>*
+    const struct BuiltinFun *funs; // const struct BuiltinFun&
+    Usize fun_count;
 } BuiltinModule;
 
-/**
- *
- * @brief Construct the BuiltinModule type.
- */
-struct BuiltinModule *
-__new__BuiltinModule(const Str name, struct Vec *items);
-
-/**
- *
- * @brief Free the BuiltinFun type.
- */
-void
-__free__BuiltinModule(struct BuiltinModule *self);
-
-typedef struct Builtin
+typedef struct BuiltinTable
 {
-    enum BuiltinKind kind;
-
-    union
-    {
-        struct BuiltinFun *fun;
-        struct BuiltinModule *module;
-    };
-} Builtin;
+    const struct BuiltinModule *modules; // const struct BuiltinModule&
+    Usize module_count;
+    const struct BuiltinEntry *entries; // const struct BuiltinEntry&
+    Usize entry_count;
+    struct DataTypeSymbol *const *types; // struct DataTypeSymbol& (each
+                                         // distinct data type, the sub data
+                                         // types first)
+    Usize type_count;
+    struct StrMap *index; // struct StrMap<const struct BuiltinEntry&>*
+} BuiltinTable;
 
 /**
  *
- * @brief Construct the Builtin type (Fun variant).
- */
-struct Builtin *
-__new__BuiltinFunVar(struct BuiltinFun *fun);
-
-/**
- *
- * @brief Construct the Builtin type (Module variant).
- */
-struct Builtin *
-__new__BuiltinModuleVar(struct BuiltinModule *module);
-
-/**
- *
- * @brief Free the Builtin type (Fun variant).
- */
-void
-__free__BuiltinFunVar(struct Builtin *self);
-
-/**
- *
- * @brief Free the Builtin type (Module variant).
+ * @brief Index the entries of the BuiltinTable by their key.
  */
 void
-__free__BuiltinModuleVar(struct Builtin *self);
+index__BuiltinTable(struct BuiltinTable *self);
 
 /**
  *
- * @brief Free the Builtin type (all variants).
+ * @return the function of the module which has param_count params (with the
+ * return type) or NULL.
  */
-void
-__free__BuiltinAll(struct Builtin *self);
+const struct BuiltinFun *
+search__BuiltinTable(const struct BuiltinTable *self,
+                     const Str module_name,
+                     const Str fun_name,
+                     Usize param_count);
 
 #endif // LILY_BUILTIN_H
@@ -25,13 +25,15 @@
 #ifndef LILY_BUILTIN_C_H
 #define LILY_BUILTIN_C_H
 
-#include <base/vec.h>
+#include <lang/builtin/builtin.h>
 
 /**
  *
- * @brief Load all builtins for C transpiler.
+ * @brief Load all builtins for C transpiler. The table is generated from
+ * builtin_c.def at build time and indexed on the first call, then it is
+ * shared (read-only) by all the callers.
  */
-struct Vec *
+const struct BuiltinTable *
 Load_C_builtins();
 
 #endif // LILY_BUILTIN_C_H
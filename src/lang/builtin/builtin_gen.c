@@ -0,0 +1,674 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Compile builtin_c.def into the const tables included by builtin_c.c.
+//
+// Usage: builtin_gen <input.def> <output.inc>
+//
+// Identical data types and identical param lists are only emitted once, and
+// the functions of a module which share a name are emitted next to each other
+// so that one BuiltinEntry covers all of their overloads.
+
+#include <base/new.h>
+#include <base/str_map.h>
+#include <base/vec.h>
+#include <base/writer.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct BuiltinGenFun
+{
+    Str name;
+    Usize params;
+} BuiltinGenFun;
+
+typedef struct BuiltinGen
+{
+    Str filename;
+    Usize line;
+    const char *cursor;
+    struct StrMap *types;  // struct StrMap<Usize+1>*
+    struct StrMap *params; // struct StrMap<Usize+1>*
+    struct Vec *keys;      // struct Vec<Str*>*
+    struct Vec *type_keys; // struct Vec<Str&>*
+    struct Vec *funs;      // struct Vec<struct BuiltinGenFun*>*
+    Str module_name;
+    Usize fun_count;
+    Usize entry_count;
+    Usize module_count;
+    struct Writer types_out;
+    struct Writer params_out;
+    struct Writer funs_out;
+    struct Writer entries_out;
+    struct Writer modules_out;
+} BuiltinGen;
+
+static const struct
+{
+    const Str name;
+    const Str kind;
+} primary_data_types[] = {
+    { "Int8", "I8" },       { "Int16", "I16" },     { "Int32", "I32" },
+    { "Int64", "I64" },     { "Int128", "I128" },   { "Uint8", "U8" },
+    { "Uint16", "U16" },    { "Uint32", "U32" },    { "Uint64", "U64" },
+    { "Uint128", "U128" },  { "Float32", "F32" },   { "Float64", "F64" },
+    { "Bool", "Bool" },     { "Char", "Char" },     { "Str", "Str" },
+    { "Isize", "Isize" },   { "Usize", "Usize" },   { "Unit", "Unit" },
+    { "Any", "Any" },       { "Never", "Never" },
+};
+
+static void
+error(struct BuiltinGen *self, const Str msg);
+static void
+skip_spaces(struct BuiltinGen *self);
+static bool
+eat(struct BuiltinGen *self, const Str s);
+static Usize
+parse_ident(struct BuiltinGen *self);
+static Usize
+register_type(struct BuiltinGen *self,
+              struct Writer *key,
+              struct Writer *helpers,
+              struct Writer *def);
+static Usize
+parse_data_type(struct BuiltinGen *self);
+static Usize
+register_params(struct BuiltinGen *self, struct Vec *params);
+static void
+parse_fun(struct BuiltinGen *self);
+static void
+end_module(struct BuiltinGen *self);
+static void
+write_type_ref(struct Writer *writer, Usize id);
+static void
+write_c_str(struct Writer *writer, const Str s);
+
+static void
+error(struct BuiltinGen *self, const Str msg)
+{
+    fprintf(stderr, "%s:%zu: error: %s\n", self->filename, self->line, msg);
+    exit(1);
+}
+
+static void
+skip_spaces(struct BuiltinGen *self)
+{
+    while (*self->cursor == ' ' || *self->cursor == '\t')
+        self->cursor++;
+}
+
+static bool
+eat(struct BuiltinGen *self, const Str s)
+{
+    skip_spaces(self);
+
+    if (strncmp(self->cursor, s, strlen(s)))
+        return false;
+
+    self->cursor += strlen(s);
+
+    return true;
+}
+
+static Usize
+parse_ident(struct BuiltinGen *self)
+{
+    Usize len = 0;
+
+    while (self->cursor[len] == '_' ||
+           (self->cursor[len] >= 'a' && self->cursor[len] <= 'z') ||
+           (self->cursor[len] >= 'A' && self->cursor[len] <= 'Z') ||
+           (self->cursor[len] >= '0' && self->cursor[len] <= '9'))
+        len++;
+
+    if (len == 0)
+        error(self, "expected data type");
+
+    return len;
+}
+
+// Return the id of the data type. The data type (with its helpers) is only
+// emitted the first time its key is seen.
+static Usize
+register_type(struct BuiltinGen *self,
+              struct Writer *key,
+              struct Writer *helpers,
+              struct Writer *def)
+{
+    Str key_str = take__Writer(key);
+    void *id = get__StrMap(*self->types, key_str);
+
+    FREE(Writer, *key);
+
+    if (id) {
+        free(key_str);
+        FREE(Writer, *helpers);
+        FREE(Writer, *def);
+
+        return (Usize)(UPtr)id - 1;
+    }
+
+    Usize new_id = len__Vec(*self->type_keys);
+
+    push__Vec(self->keys, key_str);
+    push__Vec(self->type_keys, key_str);
+    insert__StrMap(self->types, key_str, (void *)(UPtr)(new_id + 1));
+
+    write_bytes__Writer(&self->types_out, helpers->buffer, helpers->len);
+    write_str__Writer(&self->types_out,
+                      "static const struct DataTypeSymbol builtin_type_");
+    write_uint__Writer(&self->types_out, new_id);
+    write_str__Writer(&self->types_out, " = { ");
+    write_bytes__Writer(&self->types_out, def->buffer, def->len);
+    write_str__Writer(&self->types_out, " };\n");
+
+    FREE(Writer, *helpers);
+    FREE(Writer, *def);
+
+    return new_id;
+}
+
+static Usize
+parse_data_type(struct BuiltinGen *self)
+{
+    struct Writer key = NEW(WriterBuffer);
+    struct Writer helpers = NEW(WriterBuffer);
+    struct Writer def = NEW(WriterBuffer);
+
+    skip_spaces(self);
+
+    static const struct
+    {
+        const Str prefix;
+        const Str kind;
+        const Str field;
+    } prefixes[] = { { "mut ", "Mut", "mut" },
+                     { "?", "Optional", "optional" },
+                     { "*", "Ptr", "ptr" },
+                     { "&", "Ref", "ref" } };
+
+    for (Usize i = 0; i < sizeof(prefixes) / sizeof(*prefixes); i++)
+        if (eat(self, prefixes[i].prefix)) {
+            Usize child = parse_data_type(self);
+
+            write_str__Writer(&key, prefixes[i].prefix);
+            write_str__Writer(&key, get__Vec(*self->type_keys, child));
+            write_str__Writer(&def, ".kind = DataTypeKind");
+            write_str__Writer(&def, prefixes[i].kind);
+            write_str__Writer(&def, ", .value.");
+            write_str__Writer(&def, prefixes[i].field);
+            write_str__Writer(&def, " = ");
+            write_type_ref(&def, child);
+
+            return register_type(self, &key, &helpers, &def);
+        }
+
+    if (eat(self, "[]")) {
+        Usize child = parse_data_type(self);
+        Usize id = len__Vec(*self->type_keys);
+
+        // Array: struct Tuple<struct DataTypeSymbol*, Usize*>, with a NULL
+        // size.
+        write_str__Writer(&helpers, "static void *const builtin_array_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers, "_items[] = { ");
+        write_type_ref(&helpers, child);
+        write_str__Writer(&helpers, ", NULL };\n");
+        write_str__Writer(&helpers, "static const struct Tuple builtin_array_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers,
+                          " = { .size = 2, .items = (void **)builtin_array_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers, "_items };\n");
+
+        write_str__Writer(&key, "[]");
+        write_str__Writer(&key, get__Vec(*self->type_keys, child));
+        write_str__Writer(&def,
+                          ".kind = DataTypeKindArray, .value.array = (struct "
+                          "Tuple *)&builtin_array_");
+        write_uint__Writer(&def, id);
+
+        return register_type(self, &key, &helpers, &def);
+    }
+
+    if (eat(self, "(")) {
+        struct Vec *items = NEW(Vec, sizeof(Usize));
+
+        do {
+            push__Vec(items, (void *)(UPtr)parse_data_type(self));
+        } while (eat(self, ","));
+
+        if (!eat(self, ")"))
+            error(self, "expected `)`");
+
+        Usize id = len__Vec(*self->type_keys);
+
+        write_str__Writer(&helpers,
+                          "static struct DataTypeSymbol *const builtin_tuple_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers, "_items[] = { ");
+        write_char__Writer(&key, '(');
+
+        for (Usize i = 0; i < len__Vec(*items); i++) {
+            Usize item = (Usize)(UPtr)get__Vec(*items, i);
+
+            if (i > 0) {
+                write_str__Writer(&helpers, ", ");
+                write_str__Writer(&key, ", ");
+            }
+
+            write_type_ref(&helpers, item);
+            write_str__Writer(&key, get__Vec(*self->type_keys, item));
+        }
+
+        write_str__Writer(&helpers, " };\n");
+        write_str__Writer(&helpers, "static const struct Vec builtin_tuple_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers, " = BUILTIN_VEC(builtin_tuple_");
+        write_uint__Writer(&helpers, id);
+        write_str__Writer(&helpers, "_items);\n");
+
+        write_char__Writer(&key, ')');
+        write_str__Writer(&def,
+                          ".kind = DataTypeKindTuple, .value.tuple = (struct "
+                          "Vec *)&builtin_tuple_");
+        write_uint__Writer(&def, id);
+
+        FREE(Vec, items);
+
+        return register_type(self, &key, &helpers, &def);
+    }
+
+    if (eat(self, "'")) {
+        Usize len = parse_ident(self);
+        Str name = strndup(self->cursor, len);
+
+        self->cursor += len;
+
+        bool is_args = eat(self, "...");
+
+        write_char__Writer(&key, '\'');
+        write_str__Writer(&key, name);
+        write_str__Writer(&key, is_args ? "..." : "");
+        write_str__Writer(&def,
+                          ".kind = DataTypeKindCompilerDefined, "
+                          ".value.compiler_defined = { .name = ");
+        write_c_str(&def, name);
+        write_str__Writer(&def,
+                          is_args ? ", .is_args = true }"
+                                  : ", .is_args = false }");
+
+        free(name);
+
+        return register_type(self, &key, &helpers, &def);
+    }
+
+    Usize len = parse_ident(self);
+
+    for (Usize i = 0;
+         i < sizeof(primary_data_types) / sizeof(*primary_data_types);
+         i++)
+        if (strlen(primary_data_types[i].name) == len &&
+            !strncmp(self->cursor, primary_data_types[i].name, len)) {
+            self->cursor += len;
+
+            write_str__Writer(&key, primary_data_types[i].name);
+            write_str__Writer(&def, ".kind = DataTypeKind");
+            write_str__Writer(&def, primary_data_types[i].kind);
+
+            return register_type(self, &key, &helpers, &def);
+        }
+
+    error(self, "unknown data type");
+
+    return 0;
+}
+
+static Usize
+register_params(struct BuiltinGen *self, struct Vec *params)
+{
+    struct Writer key = NEW(WriterBuffer);
+
+    for (Usize i = 0; i < len__Vec(*params); i++) {
+        write_uint__Writer(&key, (Usize)(UPtr)get__Vec(*params, i));
+        write_char__Writer(&key, ',');
+    }
+
+    Str key_str = take__Writer(&key);
+    void *id = get__StrMap(*self->params, key_str);
+
+    FREE(Writer, key);
+
+    if (id) {
+        free(key_str);
+
+        return (Usize)(UPtr)id - 1;
+    }
+
+    Usize new_id = len__StrMap(*self->params);
+
+    push__Vec(self->keys, key_str);
+    insert__StrMap(self->params, key_str, (void *)(UPtr)(new_id + 1));
+
+    write_str__Writer(&self->params_out,
+                      "static struct DataTypeSymbol *const builtin_params_");
+    write_uint__Writer(&self->params_out, new_id);
+    write_str__Writer(&self->params_out, "_items[] = { ");
+
+    for (Usize i = 0; i < len__Vec(*params); i++) {
+        if (i > 0)
+            write_str__Writer(&self->params_out, ", ");
+
+        write_type_ref(&self->params_out, (Usize)(UPtr)get__Vec(*params, i));
+    }
+
+    write_str__Writer(&self->params_out,
+                      " };\nstatic const struct Vec builtin_params_");
+    write_uint__Writer(&self->params_out, new_id);
+    write_str__Writer(&self->params_out, " = BUILTIN_VEC(builtin_params_");
+    write_uint__Writer(&self->params_out, new_id);
+    write_str__Writer(&self->params_out, "_items);\n");
+
+    return new_id;
+}
+
+// <fun name> :: <param>, <param> -> <return>
+static void
+parse_fun(struct BuiltinGen *self)
+{
+    if (!self->module_name)
+        error(self, "expected `module` before the first function");
+
+    skip_spaces(self);
+
+    Usize len = 0;
+
+    while (self->cursor[len] && self->cursor[len] != ' ' &&
+           self->cursor[len] != '\t')
+        len++;
+
+    struct BuiltinGenFun *fun = malloc(sizeof(struct BuiltinGenFun));
+    struct Vec *params = NEW(Vec, sizeof(Usize));
+
+    fun->name = strndup(self->cursor, len);
+    self->cursor += len;
+
+    if (!eat(self, "::"))
+        error(self, "expected `::`");
+
+    if (!eat(self, "->")) {
+        do {
+            push__Vec(params, (void *)(UPtr)parse_data_type(self));
+        } while (eat(self, ","));
+
+        if (!eat(self, "->"))
+            error(self, "expected `->`");
+    }
+
+    // The last param is the return type.
+    push__Vec(params, (void *)(UPtr)parse_data_type(self));
+    skip_spaces(self);
+
+    if (*self->cursor && *self->cursor != '\n' && *self->cursor != '#')
+        error(self, "unexpected character after the return type");
+
+    fun->params = register_params(self, params);
+    push__Vec(self->funs, fun);
+
+    FREE(Vec, params);
+}
+
+// Emit the functions of the current module grouped by name.
+static void
+end_module(struct BuiltinGen *self)
+{
+    if (!self->module_name)
+        return;
+
+    Usize first_fun = self->fun_count;
+    Usize count = len__Vec(*self->funs);
+    bool *emitted = calloc(count ? count : 1, sizeof(bool));
+
+    for (Usize i = 0; i < count; i++) {
+        if (emitted[i])
+            continue;
+
+        struct BuiltinGenFun *fun = get__Vec(*self->funs, i);
+        Usize entry_first_fun = self->fun_count;
+
+        for (Usize j = i; j < count; j++) {
+            struct BuiltinGenFun *overload = get__Vec(*self->funs, j);
+
+            if (emitted[j] || strcmp(overload->name, fun->name))
+                continue;
+
+            emitted[j] = true;
+
+            write_str__Writer(&self->funs_out, "    { .name = ");
+            write_c_str(&self->funs_out, overload->name);
+            write_str__Writer(&self->funs_out,
+                              ", .params = (struct Vec *)&builtin_params_");
+            write_uint__Writer(&self->funs_out, overload->params);
+            write_str__Writer(&self->funs_out, " },\n");
+
+            self->fun_count++;
+        }
+
+        struct Writer key = NEW(WriterBuffer);
+
+        write_str__Writer(&key, self->module_name);
+        write_char__Writer(&key, '.');
+        write_str__Writer(&key, fun->name);
+
+        Str key_str = take__Writer(&key);
+
+        FREE(Writer, key);
+
+        write_str__Writer(&self->entries_out, "    { .key = ");
+        write_c_str(&self->entries_out, key_str);
+        write_str__Writer(&self->entries_out, ", .funs = &builtin_funs[");
+        write_uint__Writer(&self->entries_out, entry_first_fun);
+        write_str__Writer(&self->entries_out, "], .fun_count = ");
+        write_uint__Writer(&self->entries_out,
+                           self->fun_count - entry_first_fun);
+        write_str__Writer(&self->entries_out, " },\n");
+
+        self->entry_count++;
+        free(key_str);
+    }
+
+    write_str__Writer(&self->modules_out, "    { .name = ");
+    write_c_str(&self->modules_out, self->module_name);
+    write_str__Writer(&self->modules_out, ", .funs = &builtin_funs[");
+    write_uint__Writer(&self->modules_out, first_fun);
+    write_str__Writer(&self->modules_out, "], .fun_count = ");
+    write_uint__Writer(&self->modules_out, count);
+    write_str__Writer(&self->modules_out, " },\n");
+
+    self->module_count++;
+
+    for (Usize i = count; i--;) {
+        struct BuiltinGenFun *fun = pop__Vec(self->funs);
+
+        free(fun->name);
+        free(fun);
+    }
+
+    free(emitted);
+    free(self->module_name);
+    self->module_name = NULL;
+}
+
+static void
+write_type_ref(struct Writer *writer, Usize id)
+{
+    write_str__Writer(writer, "(struct DataTypeSymbol *)&builtin_type_");
+    write_uint__Writer(writer, id);
+}
+
+static void
+write_c_str(struct Writer *writer, const Str s)
+{
+    write_char__Writer(writer, '"');
+
+    for (Usize i = 0; s[i]; i++) {
+        if (s[i] == '"' || s[i] == '\\')
+            write_char__Writer(writer, '\\');
+
+        write_char__Writer(writer, s[i]);
+    }
+
+    write_char__Writer(writer, '"');
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: builtin_gen <input.def> <output.inc>\n");
+        return 1;
+    }
+
+    FILE *input = fopen(argv[1], "r");
+
+    if (!input) {
+        fprintf(stderr, "error: cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    struct BuiltinGen self = { .filename = argv[1],
+                               .line = 0,
+                               .cursor = NULL,
+                               .types = NEW(StrMap),
+                               .params = NEW(StrMap),
+                               .keys = NEW(Vec, sizeof(Str)),
+                               .type_keys = NEW(Vec, sizeof(Str)),
+                               .funs = NEW(Vec, sizeof(struct BuiltinGenFun)),
+                               .module_name = NULL,
+                               .fun_count = 0,
+                               .entry_count = 0,
+                               .module_count = 0,
+                               .types_out = NEW(WriterBuffer),
+                               .params_out = NEW(WriterBuffer),
+                               .funs_out = NEW(WriterBuffer),
+                               .entries_out = NEW(WriterBuffer),
+                               .modules_out = NEW(WriterBuffer) };
+    Str line = NULL;
+    size_t line_capacity = 0;
+
+    while (getline(&line, &line_capacity, input) != -1) {
+        self.line++;
+        self.cursor = line;
+        skip_spaces(&self);
+
+        if (*self.cursor == '#' || *self.cursor == '\n' || !*self.cursor)
+            continue;
+
+        if (eat(&self, "module ")) {
+            end_module(&self);
+            skip_spaces(&self);
+
+            Usize len = parse_ident(&self);
+
+            self.module_name = strndup(self.cursor, len);
+        } else
+            parse_fun(&self);
+    }
+
+    end_module(&self);
+    free(line);
+    fclose(input);
+
+    int fd = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        fprintf(stderr, "error: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    struct Writer output = NEW(WriterFd, fd);
+
+    write_str__Writer(
+      &output,
+      "// Generated by builtin_gen, do not edit.\n\n"
+      "#define BUILTIN_VEC(array) \\\n"
+      "    { .items = (void **)array, \\\n"
+      "      .len = sizeof(array) / sizeof(*array), \\\n"
+      "      .capacity = sizeof(array) / sizeof(*array), \\\n"
+      "      .default_capacity = sizeof(array) / sizeof(*array), \\\n"
+      "      .item_size = sizeof(struct DataTypeSymbol) }\n\n");
+    write_bytes__Writer(&output, self.types_out.buffer, self.types_out.len);
+    write_str__Writer(
+      &output, "\nstatic struct DataTypeSymbol *const builtin_types[] = {\n");
+
+    for (Usize i = 0; i < len__Vec(*self.type_keys); i++) {
+        write_str__Writer(&output, "    ");
+        write_type_ref(&output, i);
+        write_str__Writer(&output, ",\n");
+    }
+
+    write_str__Writer(&output, "};\n\n");
+    write_bytes__Writer(&output, self.params_out.buffer, self.params_out.len);
+    write_str__Writer(&output,
+                      "\nstatic const struct BuiltinFun builtin_funs[] = {\n");
+    write_bytes__Writer(&output, self.funs_out.buffer, self.funs_out.len);
+    write_str__Writer(
+      &output,
+      "};\n\nstatic const struct BuiltinEntry builtin_entries[] = {\n");
+    write_bytes__Writer(&output, self.entries_out.buffer, self.entries_out.len);
+    write_str__Writer(
+      &output,
+      "};\n\nstatic const struct BuiltinModule builtin_modules[] = {\n");
+    write_bytes__Writer(&output, self.modules_out.buffer, self.modules_out.len);
+    write_str__Writer(&output, "};\n\n#undef BUILTIN_VEC\n");
+
+    bool res = flush__Writer(&output);
+
+    close(fd);
+
+    for (Usize i = len__Vec(*self.keys); i--;)
+        free(get__Vec(*self.keys, i));
+
+    FREE(Vec, self.keys);
+    FREE(Vec, self.type_keys);
+    FREE(Vec, self.funs);
+    FREE(StrMap, self.types);
+    FREE(StrMap, self.params);
+    FREE(Writer, output);
+    FREE(Writer, self.types_out);
+    FREE(Writer, self.params_out);
+    FREE(Writer, self.funs_out);
+    FREE(Writer, self.entries_out);
+    FREE(Writer, self.modules_out);
+
+    if (!res) {
+        fprintf(stderr, "error: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -29,17 +29,20 @@
 #include <base/option.h>
 #include <base/str.h>
 #include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/file_cache.h>
+#include <lang/diagnostic/sink.h>
 #include <lang/scanner/token.h>
 #include <string.h>
 
-static inline const Str
-diagnostic_kind_to_String(enum DiagnosticKind kind);
-static inline const Str
-apply_color(enum DiagnosticKind kind, const Str s);
-struct String *
-detail_to_String(struct Detail self,
-                 enum DiagnosticKind kind,
-                 struct Location loc);
+static Usize
+count_digits(Usize n);
+static void
+write_spaces(struct Writer *writer, Usize count);
+static void
+write_detail(struct Detail self,
+             enum DiagnosticKind kind,
+             struct Location loc,
+             struct Writer *writer);
 static inline struct String *
 lily_error_to_String(struct LilyError err);
 static inline struct String *
@@ -48,39 +51,45 @@ static inline const Str
 get_code_of_lily_error(struct LilyError err);
 static inline const Str
 get_code_of_lily_warning(struct LilyWarning warn);
-struct String *
+Str
 get_line(struct Diagnostic self, Usize line_number);
-struct String *
-diagnostic_to_String(struct Diagnostic self);
 
-static inline const Str
-diagnostic_kind_to_String(enum DiagnosticKind kind)
+// The colour sequences of each kind of diagnostic, they are written as is
+// instead of being rebuilt for each diagnostic.
+static const Str kind_colors[] = { [DiagnosticKindError] = "\x1b[31m",
+                                   [DiagnosticKindWarning] = "\x1b[33m",
+                                   [DiagnosticKindNote] = "\x1b[36m" };
+static const Str kind_labels[] = {
+    [DiagnosticKindError] = "\x1b[31merror\x1b[0m",
+    [DiagnosticKindWarning] = "\x1b[33mwarning\x1b[0m",
+    [DiagnosticKindNote] = "\x1b[36mnote\x1b[0m"
+};
+
+#define RESET_COLOR "\x1b[0m"
+#define HELP_LABEL "\x1b[32mhelp\x1b[0m: "
+
+static Usize
+count_digits(Usize n)
 {
-    switch (kind) {
-        case DiagnosticKindError:
-            return "error";
-        case DiagnosticKindWarning:
-            return "warning";
-        case DiagnosticKindNote:
-            return "note";
-        default:
-            UNREACHABLE("unknown diagnostic kind");
+    Usize count = 1;
+
+    while (n >= 10) {
+        n /= 10;
+        count++;
     }
+
+    return count;
 }
 
-static inline const Str
-apply_color(enum DiagnosticKind kind, const Str s)
+static void
+write_spaces(struct Writer *writer, Usize count)
 {
-    switch (kind) {
-        case DiagnosticKindError:
-            return RED(s);
-        case DiagnosticKindWarning:
-            return YELLOW(s);
-        case DiagnosticKindNote:
-            return CYAN(s);
-        default:
-            UNREACHABLE("unknown diagnostic kind");
-    }
+    static const char spaces[] = "                                ";
+
+    for (; count > sizeof(spaces) - 1; count -= sizeof(spaces) - 1)
+        write_bytes__Writer(writer, spaces, sizeof(spaces) - 1);
+
+    write_bytes__Writer(writer, spaces, count);
 }
 
 struct Detail *
@@ -92,73 +101,39 @@ __new__Detail(struct String *msg, struct Vec *lines)
     return self;
 }
 
-struct String *
-detail_to_String(struct Detail self,
-                 enum DiagnosticKind kind,
-                 struct Location loc)
+static void
+write_detail(struct Detail self,
+             enum DiagnosticKind kind,
+             struct Location loc,
+             struct Writer *writer)
 {
-    Str line_str = of_int__Str((int)loc.e_line);
-    Usize line_str_length = strlen(line_str);
-    struct String *s = NULL;
-
-    if (loc.s_line == loc.e_line) {
-        struct String *repeat1 = repeat__String(" ", line_str_length - 1);
-        struct String *repeat2 = repeat__String(" ", line_str_length);
-        struct String *repeat3 = NEW(String);
-        struct String *repeat4 = NULL;
-        struct String *line = (struct String *)get__Vec(*self.lines, 0);
-
-        for (Usize i = 0; i < loc.s_col - 1; i++)
-            if (get__String(*line, i) == (char *)'\t')
-                push_str__String(repeat3, "\t");
-            else
-                push_str__String(repeat3, " ");
-
-        if (loc.e_col - loc.s_col < 1)
-            repeat4 = repeat__String("^", loc.e_col - loc.s_col + 1);
-        else
-            repeat4 = repeat__String("^", loc.e_col - loc.s_col + 1);
-
-        if (kind == DiagnosticKindError) {
-            s = format("{S} |\n{d} | \x1b[31m{S}\x1b[0m\n{S} | {S}{S} {S}",
-                       repeat1,
-                       loc.s_line,
-                       line,
-                       repeat2,
-                       repeat3,
-                       repeat4,
-                       self.msg);
-        } else if (kind == DiagnosticKindWarning) {
-            s = format("{S} |\n{d} | \x1b[33m{S}\x1b[0m\n{S} | {S}{S} {S}",
-                       repeat1,
-                       loc.s_line,
-                       line,
-                       repeat2,
-                       repeat3,
-                       repeat4,
-                       self.msg);
-        } else {
-            s = format("{S} |\n{d} | \x1b[36m{S}\x1b[0m\n{S} | {S}{S} {S}",
-                       repeat1,
-                       loc.s_line,
-                       line,
-                       repeat2,
-                       repeat3,
-                       repeat4,
-                       self.msg);
-        }
-
-        FREE(String, repeat1);
-        FREE(String, repeat2);
-        FREE(String, repeat3);
-        FREE(String, repeat4);
-    } else {
+    if (loc.s_line != loc.e_line)
         TODO("diagnostic with more one line");
-    }
 
-    free(line_str);
-
-    return s;
+    Usize gutter_width = count_digits(loc.e_line);
+    Str line = get__Vec(*self.lines, 0);
+    Usize line_len = strlen(line);
+
+    write_spaces(writer, gutter_width - 1);
+    write_str__Writer(writer, " |\n");
+    write_uint__Writer(writer, loc.s_line);
+    write_str__Writer(writer, " | ");
+    write_str__Writer(writer, kind_colors[kind]);
+    write_bytes__Writer(writer, line, line_len);
+    write_str__Writer(writer, RESET_COLOR "\n");
+    write_spaces(writer, gutter_width);
+    write_str__Writer(writer, " | ");
+
+    // Keep the tabulations of the line so that the carets are aligned.
+    for (Usize i = 0; i + 1 < loc.s_col; i++)
+        write_char__Writer(writer,
+                           i < line_len && line[i] == '\t' ? '\t' : ' ');
+
+    for (Usize i = loc.s_col; i <= loc.e_col || i == loc.s_col; i++)
+        write_char__Writer(writer, '^');
+
+    write_char__Writer(writer, ' ');
+    write_String__Writer(writer, self.msg);
 }
 
 static inline struct String *
@@ -324,6 +299,37 @@ lily_error_to_String(struct LilyError err)
             return from__String("float is out of range");
         case LilyErrorUnmatchedDataType:
             return from__String("unmatched data type");
+        case LilyErrorCycleInDeclaration:
+            return from__String("cycle in declaration");
+        case LilyErrorUnknownIdentifier:
+            return format("unknown identifier: `{S}`", err.s);
+        case LilyErrorUnknownFunction:
+            return format("unknown function: `{S}`", err.s);
+        case LilyErrorBadNumberOfParams:
+            return format("bad number of params in the call of `{S}`", err.s);
+        case LilyErrorUnknownField:
+            return format("unknown field: `{S}`", err.s);
+        case LilyErrorMissingField:
+            return format("missing field: `{S}`", err.s);
+        case LilyErrorConstantPanics:
+            return format("the value of the constant panics: {S}", err.s);
+        case LilyErrorUnknownVariant:
+            return format("unknown variant: `{S}`", err.s);
+        case LilyErrorInvalidPattern:
+            return from__String("invalid pattern");
+        case LilyErrorNonExhaustiveMatch:
+            return from__String("non-exhaustive match");
+        case LilyErrorNotTailCall:
+            return format("the recursive call of `{S}` is not in tail position",
+                          err.s);
+        case LilyErrorUnknownLambdaParamDataType:
+            return format("the data type of the param `{S}` of the lambda is "
+                          "unknown",
+                          err.s);
+        case LilyErrorNotCallable:
+            return format("`{S}` is not a function or a lambda", err.s);
+        case LilyErrorNotLoweredToC:
+            return format("`{S}` cannot be lowered to C", err.s);
         default:
             UNREACHABLE("unknown lily error kind");
     }
@@ -341,6 +347,8 @@ lily_warning_to_String(struct LilyWarning warn)
             return from__String("ignored generic params");
         case LilyWarningIgnoredLambdaDataType:
             return from__String("ignored lambda data type");
+        case LilyWarningUnreachableMatchArm:
+            return from__String("unreachable match arm");
         default:
             UNREACHABLE("unknown lily warning kind");
     }
@@ -508,6 +516,34 @@ get_code_of_lily_error(struct LilyError err)
             return "0078";
         case LilyErrorUnmatchedDataType:
             return "0079";
+        case LilyErrorCycleInDeclaration:
+            return "0080";
+        case LilyErrorUnknownIdentifier:
+            return "0081";
+        case LilyErrorUnknownFunction:
+            return "0082";
+        case LilyErrorBadNumberOfParams:
+            return "0083";
+        case LilyErrorUnknownField:
+            return "0084";
+        case LilyErrorMissingField:
+            return "0085";
+        case LilyErrorConstantPanics:
+            return "0086";
+        case LilyErrorUnknownVariant:
+            return "0087";
+        case LilyErrorInvalidPattern:
+            return "0088";
+        case LilyErrorNonExhaustiveMatch:
+            return "0089";
+        case LilyErrorNotTailCall:
+            return "0090";
+        case LilyErrorUnknownLambdaParamDataType:
+            return "0091";
+        case LilyErrorNotCallable:
+            return "0092";
+        case LilyErrorNotLoweredToC:
+            return "0093";
         default:
             UNREACHABLE("unknown lily error kind");
     }
@@ -525,6 +561,8 @@ get_code_of_lily_warning(struct LilyWarning warn)
             return "0003";
         case LilyWarningIgnoredLambdaDataType:
             return "0004";
+        case LilyWarningUnreachableMatchArm:
+            return "0005";
         default:
             UNREACHABLE("unknown lily warning kind");
     }
@@ -536,7 +574,7 @@ __free__Detail(struct Detail *self)
     FREE(String, self->msg);
 
     for (Usize i = 0; i < len__Vec(*self->lines); i++)
-        FREE(String, get__Vec(*self->lines, i));
+        free(get__Vec(*self->lines, i));
 
     FREE(Vec, self->lines);
     free(self);
@@ -682,49 +720,27 @@ __new__DiagnosticWithNote(struct String *note,
     return self;
 }
 
-struct String *
+Str
 get_line(struct Diagnostic self, Usize line_number)
 {
-    struct Vec *splitted_content = split__String(*self.file.content, '\n');
-    struct String *line = get__Vec(*splitted_content, line_number - 1);
+    Usize len = 0;
+    const char *line = get_line__DiagnosticFile(
+      get__DiagnosticFile(self.file.name, self.file.content),
+      line_number,
+      &len);
+    Str res = malloc(len + 1);
 
-    for (Usize i = 0; i < len__Vec(*splitted_content); i++) {
-        if (line_number - 1 != i)
-            FREE(String, (struct String *)get__Vec(*splitted_content, i));
-    }
+    memcpy(res, line, len);
+    res[len] = '\0';
 
-    FREE(Vec, splitted_content);
-
-    return line;
+    return res;
 }
 
-struct String *
-diagnostic_to_String(struct Diagnostic self)
+void
+write__Diagnostic(struct Diagnostic self, struct Writer *writer)
 {
-    Str diagnostic_kind_str = diagnostic_kind_to_String(self.kind);
-    struct String *detail_string =
-      detail_to_String(*self.detail, self.kind, self.loc);
-    struct String *help_str = NULL;
     struct String *msg = NULL;
     Str code = NULL;
-    Str kind_str = NULL;
-
-    switch (self.kind) {
-        case DiagnosticKindError:
-            kind_str = RED(diagnostic_kind_str);
-            break;
-        case DiagnosticKindWarning:
-            kind_str = YELLOW(diagnostic_kind_str);
-            break;
-        case DiagnosticKindNote:
-            kind_str = CYAN(diagnostic_kind_str);
-            break;
-        default:
-            UNREACHABLE("unknown diagnostic kind");
-    }
-
-    if (is_Some__Option(self.help))
-        help_str = (struct String *)get__Option(self.help);
 
     if (self.kind == DiagnosticKindError) {
         msg = lily_error_to_String(*self.err);
@@ -732,67 +748,46 @@ diagnostic_to_String(struct Diagnostic self)
     } else if (self.kind == DiagnosticKindWarning) {
         msg = lily_warning_to_String(*self.warn);
         code = get_code_of_lily_warning(*self.warn);
-    } else if (self.kind == DiagnosticKindNote) {
+    } else if (self.kind == DiagnosticKindNote)
         msg = self.note;
-    } else
+    else
         UNREACHABLE("unknown diagnostic kind");
 
-    if (self.kind == DiagnosticKindError ||
-        self.kind == DiagnosticKindWarning) {
-        if (help_str == NULL) {
-            return format("{s}:{d}:{d}: {sa}[{s}]: {Sr}\n {Sr}",
-                          self.file.name,
-                          self.loc.s_line,
-                          self.loc.s_col,
-                          kind_str,
-                          code,
-                          msg,
-                          detail_string);
-        }
-
-        return format(
-          "{s}:{d}:{d}: {sa}[{s}]: {Sr}\n {Sr}\n\x1b[32mhelp\x1b[0m: {Sr}",
-          self.file.name,
-          self.loc.s_line,
-          self.loc.s_col,
-          kind_str,
-          code,
-          msg,
-          detail_string,
-          help_str);
+    write_str__Writer(writer, self.file.name);
+    write_char__Writer(writer, ':');
+    write_uint__Writer(writer, self.loc.s_line);
+    write_char__Writer(writer, ':');
+    write_uint__Writer(writer, self.loc.s_col);
+    write_str__Writer(writer, ": ");
+    write_str__Writer(writer, kind_labels[self.kind]);
+
+    if (code) {
+        write_char__Writer(writer, '[');
+        write_str__Writer(writer, code);
+        write_char__Writer(writer, ']');
     }
 
-    if (help_str == NULL) {
-        return format("{s}:{d}:{d}: {sa}: {S}\n {Sr}",
-                      self.file.name,
-                      self.loc.s_line,
-                      self.loc.s_col,
-                      kind_str,
-                      msg,
-                      detail_string);
+    write_str__Writer(writer, ": ");
+    write_String__Writer(writer, msg);
+    write_str__Writer(writer, "\n ");
+    write_detail(*self.detail, self.kind, self.loc, writer);
+
+    if (is_Some__Option(self.help)) {
+        write_str__Writer(writer, "\n" HELP_LABEL);
+        write_String__Writer(writer, get__Option(self.help));
     }
 
-    return format("{s}:{d}:{d}: {sa}: {S}\n {Sr}\n\x1b[32mhelp\x1b[0m: {Sr}",
-                  self.file.name,
-                  self.loc.s_line,
-                  self.loc.s_col,
-                  kind_str,
-                  msg,
-                  detail_string,
-                  help_str);
+    if (self.kind != DiagnosticKindNote)
+        FREE(String, msg);
 }
 
 void
 emit__Diagnostic(struct Diagnostic *self)
 {
-    struct String *s = diagnostic_to_String(*self);
-
-    Println("{Sr}", s);
-
-    FREE(Diagnostic, self);
+    push__DiagnosticSink(global__DiagnosticSink(), self);
 }
 
-void
+bool
 emit_warning__Diagnostic(struct Diagnostic *self,
                          struct Vec *warning_disable_codes)
 {
@@ -823,6 +818,8 @@ emit_warning__Diagnostic(struct Diagnostic *self,
         //     FREE(String, get__Vec(*self->detail->lines, i));
         FREE(Diagnostic, self);
     }
+
+    return !same_code;
 }
 
 void
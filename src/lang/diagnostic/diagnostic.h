@@ -28,6 +28,7 @@
 #include <base/string.h>
 #include <base/tuple.h>
 #include <base/vec.h>
+#include <base/writer.h>
 #include <lang/scanner/scanner.h>
 
 #define DIAGNOSTIC_ENUM(dgn) dgn(Error) dgn(Warning) dgn(Note)
@@ -42,7 +43,7 @@ enum DiagnosticKind
 typedef struct Detail
 {
     struct String *msg;
-    struct Vec *lines;
+    struct Vec *lines; // struct Vec<Str>*
 } Detail;
 
 /**
@@ -149,7 +150,21 @@ enum LilyErrorKind
     LilyErrorExpectedIntegerDataType,
     LilyErrorExpectedALargerIntegerDataType,
     LilyErrorFloatIsOutOfRange,
-    LilyErrorUnmatchedDataType
+    LilyErrorUnmatchedDataType,
+    LilyErrorCycleInDeclaration,
+    LilyErrorUnknownIdentifier,
+    LilyErrorUnknownFunction,
+    LilyErrorBadNumberOfParams,
+    LilyErrorUnknownField,
+    LilyErrorMissingField,
+    LilyErrorConstantPanics,
+    LilyErrorUnknownVariant,
+    LilyErrorInvalidPattern,
+    LilyErrorNonExhaustiveMatch,
+    LilyErrorNotTailCall,
+    LilyErrorUnknownLambdaParamDataType,
+    LilyErrorNotCallable,
+    LilyErrorNotLoweredToC
 };
 
 typedef struct LilyError
@@ -184,7 +199,8 @@ enum LilyWarningKind
     LilyWarningUnusedParen,
     LilyWarningIgnoredTags,
     LilyWarningIgnoredGenericParams,
-    LilyWarningIgnoredLambdaDataType
+    LilyWarningIgnoredLambdaDataType,
+    LilyWarningUnreachableMatchArm
 };
 
 typedef struct LilyWarning
@@ -266,7 +282,15 @@ __new__DiagnosticWithNote(struct String *note,
 
 /**
  *
- * @brief Print diagnostic.
+ * @brief Render the diagnostic in writer (in one pass).
+ */
+void
+write__Diagnostic(struct Diagnostic self, struct Writer *writer);
+
+/**
+ *
+ * @brief Push the diagnostic in the sink of the session, it's printed at the
+ * end of the phase (see sink.h).
  */
 void
 emit__Diagnostic(struct Diagnostic *self);
@@ -274,8 +298,10 @@ emit__Diagnostic(struct Diagnostic *self);
 /**
  *
  * @brief Print warning diagnostic.
+ * @return false if the code of the warning is disabled (the diagnostic is
+ * freed).
  */
-void
+bool
 emit_warning__Diagnostic(struct Diagnostic *self,
                          struct Vec *warning_disable_codes);
 
@@ -0,0 +1,239 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/str_map.h>
+#include <lang/diagnostic/file_cache.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#define DIAGNOSTIC_FILE_DEFAULT_CAPACITY 16
+
+// The indexed files of the session, by name (open addressing with linear
+// probing). Several entries can have the same name, e.g. the documentation
+// comments are scanned with the name of their file, so an entry is identified
+// by its name and the address of its content.
+static struct DiagnosticFile **files = NULL;
+static Usize files_len = 0;
+static Usize files_capacity = 0;
+static mtx_t files_lock;
+static once_flag files_lock_once = ONCE_FLAG_INIT;
+
+static void
+init_files_lock();
+static bool
+is_file(const struct DiagnosticFile *self,
+        UInt64 hash,
+        const Str name,
+        const struct String *content);
+static struct DiagnosticFile **
+find_file(UInt64 hash, const Str name, const struct String *content);
+static void
+insert_file(struct DiagnosticFile *file);
+static void
+remove_file(Usize i);
+static struct DiagnosticFile *
+new_file(UInt64 hash, const Str name, const struct String *content);
+static void
+free_file(struct DiagnosticFile *self);
+
+static void
+init_files_lock()
+{
+    mtx_init(&files_lock, mtx_plain);
+}
+
+static bool
+is_file(const struct DiagnosticFile *self,
+        UInt64 hash,
+        const Str name,
+        const struct String *content)
+{
+    return self->hash == hash && self->content == content &&
+           !strcmp(self->name, name);
+}
+
+// Return the slot of the file, or NULL when the file is not indexed.
+static struct DiagnosticFile **
+find_file(UInt64 hash, const Str name, const struct String *content)
+{
+    if (files_capacity == 0)
+        return NULL;
+
+    Usize mask = files_capacity - 1;
+
+    for (Usize i = hash & mask; files[i]; i = (i + 1) & mask)
+        if (is_file(files[i], hash, name, content))
+            return &files[i];
+
+    return NULL;
+}
+
+static void
+insert_file(struct DiagnosticFile *file)
+{
+    if ((files_len + 1) * 2 > files_capacity) {
+        struct DiagnosticFile **old = files;
+        Usize capacity = files_capacity;
+
+        files_capacity =
+          capacity ? capacity * 2 : DIAGNOSTIC_FILE_DEFAULT_CAPACITY;
+        files = calloc(files_capacity, sizeof(struct DiagnosticFile *));
+        files_len = 0;
+
+        for (Usize i = 0; i < capacity; i++)
+            if (old[i])
+                insert_file(old[i]);
+
+        free(old);
+    }
+
+    Usize mask = files_capacity - 1;
+    Usize i = file->hash & mask;
+
+    while (files[i])
+        i = (i + 1) & mask;
+
+    files[i] = file;
+    files_len++;
+}
+
+static void
+remove_file(Usize i)
+{
+    Usize mask = files_capacity - 1;
+
+    free_file(files[i]);
+    files[i] = NULL;
+    files_len--;
+
+    // Shift back the next files of the cluster, so that the probing doesn't
+    // stop at the removed slot.
+    for (Usize j = (i + 1) & mask; files[j]; j = (j + 1) & mask) {
+        struct DiagnosticFile *file = files[j];
+
+        files[j] = NULL;
+        files_len--;
+        insert_file(file);
+    }
+}
+
+static struct DiagnosticFile *
+new_file(UInt64 hash, const Str name, const struct String *content)
+{
+    struct DiagnosticFile *self = malloc(sizeof(struct DiagnosticFile));
+    Usize capacity = 64;
+
+    self->name = strdup(name);
+    self->hash = hash;
+    self->content = content;
+    self->len = len__String(*content);
+    self->text = malloc(self->len + 1);
+    self->line_starts = malloc(capacity * sizeof(Usize));
+    self->line_starts[0] = 0;
+    self->line_count = 1;
+
+    for (Usize i = 0; i < self->len; i++) {
+        self->text[i] = (char)(UPtr)content->content->items[i];
+
+        if (self->text[i] != '\n')
+            continue;
+
+        if (self->line_count + 1 == capacity) {
+            capacity *= 2;
+            self->line_starts =
+              realloc(self->line_starts, capacity * sizeof(Usize));
+        }
+
+        self->line_starts[self->line_count++] = i + 1;
+    }
+
+    self->text[self->len] = '\0';
+    self->line_starts[self->line_count] = self->len + 1;
+
+    return self;
+}
+
+static void
+free_file(struct DiagnosticFile *self)
+{
+    free(self->name);
+    free(self->text);
+    free(self->line_starts);
+    free(self);
+}
+
+const struct DiagnosticFile *
+get__DiagnosticFile(const Str name, const struct String *content)
+{
+    UInt64 hash = hash__StrMap(name, strlen(name));
+
+    call_once(&files_lock_once, &init_files_lock);
+    mtx_lock(&files_lock);
+
+    struct DiagnosticFile **slot = find_file(hash, name, content);
+    struct DiagnosticFile *file = slot ? *slot : NULL;
+
+    if (!file) {
+        file = new_file(hash, name, content);
+        insert_file(file);
+    }
+
+    mtx_unlock(&files_lock);
+
+    return file;
+}
+
+const char *
+get_line__DiagnosticFile(const struct DiagnosticFile *self,
+                         Usize line_number,
+                         Usize *len)
+{
+    if (line_number == 0 || line_number > self->line_count) {
+        *len = 0;
+        return self->text + self->len;
+    }
+
+    Usize start = self->line_starts[line_number - 1];
+
+    *len = self->line_starts[line_number] - start - 1;
+
+    return self->text + start;
+}
+
+void
+forget__DiagnosticFile(const Str name, const struct String *content)
+{
+    UInt64 hash = hash__StrMap(name, strlen(name));
+
+    call_once(&files_lock_once, &init_files_lock);
+    mtx_lock(&files_lock);
+
+    struct DiagnosticFile **slot = find_file(hash, name, content);
+
+    if (slot)
+        remove_file(slot - files);
+
+    mtx_unlock(&files_lock);
+}
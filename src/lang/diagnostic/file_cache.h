@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_DIAGNOSTIC_FILE_CACHE_H
+#define LILY_DIAGNOSTIC_FILE_CACHE_H
+
+#include <base/string.h>
+#include <base/types.h>
+
+// The lines of a source file, indexed once for all the diagnostics of the file
+// (before, each diagnostic splitted the whole content to get its line). An
+// entry is never modified once it is published.
+typedef struct DiagnosticFile
+{
+    char *name;                   // char* (copy of the file name)
+    UInt64 hash;                  // hash of the name
+    const struct String *content; // const struct String& (only compared)
+    Usize len;          // length of the content when the lines were indexed
+    char *text;         // char* (the content in contiguous memory)
+    Usize *line_starts; // Usize* (offset of each line, then len + 1)
+    Usize line_count;
+} DiagnosticFile;
+
+/**
+ *
+ * @return the indexed lines of the content of the file, they are indexed at
+ * the first call (the result is valid until forget__DiagnosticFile is called
+ * with the same file).
+ * @note Can be called by several threads at the same time.
+ */
+const struct DiagnosticFile *
+get__DiagnosticFile(const Str name, const struct String *content);
+
+/**
+ *
+ * @return the line (without new line) at line_number (starts at 1) and its
+ * length in len, or an empty line when the file is shorter.
+ */
+const char *
+get_line__DiagnosticFile(const struct DiagnosticFile *self,
+                         Usize line_number,
+                         Usize *len);
+
+/**
+ *
+ * @brief Drop the indexed lines of the content of the file (must be called
+ * before the content is freed).
+ */
+void
+forget__DiagnosticFile(const Str name, const struct String *content);
+
+#endif // LILY_DIAGNOSTIC_FILE_CACHE_H
@@ -0,0 +1,306 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <base/option.h>
+#include <lang/diagnostic/sink.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+// The last group pushed by the current thread: a note joins it.
+static thread_local const struct DiagnosticSink *last_sink =
+  NULL; // const struct DiagnosticSink&
+static thread_local Usize last_epoch = 0;
+static thread_local Usize last_group = 0;
+static thread_local struct Location last_group_loc;
+static thread_local Str last_group_file = NULL; // Str&
+
+static struct DiagnosticSink global_sink;
+
+static bool
+is_same_string(struct String *s, struct String *s2);
+static bool
+is_same_diagnostic(const struct Diagnostic *self,
+                   const struct Diagnostic *other);
+static bool
+is_same_group_loc(const struct DiagnosticSinkNode *self,
+                  const struct DiagnosticSinkNode *other);
+static int
+compare_nodes(const void *self, const void *other);
+static void
+drop_node(struct DiagnosticSink *self, struct DiagnosticSinkNode *node);
+
+static bool
+is_same_string(struct String *s, struct String *s2)
+{
+    if (!s || !s2)
+        return s == s2;
+
+    return eq__String(s, s2, false);
+}
+
+static bool
+is_same_diagnostic(const struct Diagnostic *self,
+                   const struct Diagnostic *other)
+{
+    if (self->kind != other->kind ||
+        memcmp(&self->loc, &other->loc, sizeof(struct Location)) ||
+        strcmp(self->file.name, other->file.name) ||
+        !is_same_string(self->detail->msg, other->detail->msg) ||
+        is_Some__Option(self->help) != is_Some__Option(other->help) ||
+        (is_Some__Option(self->help) &&
+         !is_same_string(get__Option(self->help), get__Option(other->help))))
+        return false;
+
+    switch (self->kind) {
+        case DiagnosticKindError:
+            return self->err->kind == other->err->kind &&
+                   is_same_string(self->err->s, other->err->s);
+        case DiagnosticKindWarning:
+            return self->warn->kind == other->warn->kind &&
+                   is_same_string(self->warn->s, other->warn->s);
+        default:
+            return is_same_string(self->note, other->note);
+    }
+}
+
+static bool
+is_same_group_loc(const struct DiagnosticSinkNode *self,
+                  const struct DiagnosticSinkNode *other)
+{
+    return self->group_loc.s_line == other->group_loc.s_line &&
+           self->group_loc.s_col == other->group_loc.s_col &&
+           !strcmp(self->group_file, other->group_file);
+}
+
+static int
+compare_nodes(const void *self, const void *other)
+{
+    const struct DiagnosticSinkNode *a =
+      *(const struct DiagnosticSinkNode **)self;
+    const struct DiagnosticSinkNode *b =
+      *(const struct DiagnosticSinkNode **)other;
+    int cmp = strcmp(a->group_file, b->group_file);
+
+    if (cmp)
+        return cmp;
+
+    if (a->group_loc.s_line != b->group_loc.s_line)
+        return a->group_loc.s_line < b->group_loc.s_line ? -1 : 1;
+
+    if (a->group_loc.s_col != b->group_loc.s_col)
+        return a->group_loc.s_col < b->group_loc.s_col ? -1 : 1;
+
+    if (a->group != b->group)
+        return a->group < b->group ? -1 : 1;
+
+    return a->seq < b->seq ? -1 : a->seq > b->seq;
+}
+
+// The counters don't count the dropped duplicates.
+static void
+drop_node(struct DiagnosticSink *self, struct DiagnosticSinkNode *node)
+{
+    if (node->diagnostic->kind == DiagnosticKindError)
+        atomic_fetch_sub(&self->count_error, 1);
+    else if (node->diagnostic->kind == DiagnosticKindWarning)
+        atomic_fetch_sub(&self->count_warning, 1);
+}
+
+struct DiagnosticSink *
+__new__DiagnosticSink(Usize error_limit)
+{
+    struct DiagnosticSink *self = malloc(sizeof(struct DiagnosticSink));
+
+    atomic_init(&self->head, NULL);
+    atomic_init(&self->len, 0);
+    atomic_init(&self->epoch, 0);
+    atomic_init(&self->count_error, 0);
+    atomic_init(&self->count_warning, 0);
+    self->error_limit = error_limit;
+
+    return self;
+}
+
+struct DiagnosticSink *
+global__DiagnosticSink()
+{
+    return &global_sink;
+}
+
+void
+push__DiagnosticSink(struct DiagnosticSink *self,
+                     struct Diagnostic *diagnostic)
+{
+    struct DiagnosticSinkNode *node =
+      malloc(sizeof(struct DiagnosticSinkNode));
+    Usize epoch = atomic_load(&self->epoch);
+
+    node->diagnostic = diagnostic;
+    node->seq = atomic_fetch_add(&self->len, 1);
+
+    if (diagnostic->kind == DiagnosticKindNote && last_sink == self &&
+        last_epoch == epoch && last_group_file) {
+        node->group = last_group;
+    } else {
+        last_sink = self;
+        last_epoch = epoch;
+        last_group = node->seq;
+        last_group_loc = diagnostic->loc;
+        last_group_file = diagnostic->file.name;
+        node->group = node->seq;
+    }
+
+    node->group_loc = last_group_loc;
+    node->group_file = last_group_file;
+
+    if (diagnostic->kind == DiagnosticKindError)
+        atomic_fetch_add(&self->count_error, 1);
+    else if (diagnostic->kind == DiagnosticKindWarning)
+        atomic_fetch_add(&self->count_warning, 1);
+
+    node->next = atomic_load(&self->head);
+
+    while (!atomic_compare_exchange_weak(&self->head, &node->next, node))
+        ;
+}
+
+Usize
+render__DiagnosticSink(struct DiagnosticSink *self, struct Writer *writer)
+{
+    struct DiagnosticSinkNode *head = atomic_exchange(&self->head, NULL);
+    Usize len = 0;
+
+    atomic_fetch_add(&self->epoch, 1);
+
+    for (struct DiagnosticSinkNode *node = head; node; node = node->next)
+        ++len;
+
+    if (len == 0)
+        return 0;
+
+    struct DiagnosticSinkNode **nodes =
+      malloc(len * sizeof(struct DiagnosticSinkNode *));
+    // The rendered diagnostics of the location of the current group, the
+    // duplicates are only searched among them.
+    struct DiagnosticSinkNode **kept =
+      malloc(len * sizeof(struct DiagnosticSinkNode *));
+    Usize kept_len = 0;
+    Usize window = 0;
+    Usize error_count = 0;
+    Usize hidden_error_count = 0;
+    bool is_limited = false;
+
+    len = 0;
+
+    for (struct DiagnosticSinkNode *node = head; node; node = node->next)
+        nodes[len++] = node;
+
+    qsort(nodes, len, sizeof(struct DiagnosticSinkNode *), &compare_nodes);
+
+    for (Usize i = 0; i < len; i++) {
+        struct DiagnosticSinkNode *node = nodes[i];
+        bool is_duplicate = false;
+
+        // Once the limit is reached, the next groups are not rendered.
+        if (self->error_limit > 0 && error_count >= self->error_limit &&
+            node->group == node->seq)
+            is_limited = true;
+
+        if (is_limited) {
+            hidden_error_count += node->diagnostic->kind == DiagnosticKindError;
+            continue;
+        }
+
+        if (kept_len > 0 && !is_same_group_loc(kept[kept_len - 1], node))
+            window = kept_len;
+
+        for (Usize j = window; !is_duplicate && j < kept_len; j++)
+            is_duplicate =
+              is_same_diagnostic(kept[j]->diagnostic, node->diagnostic);
+
+        if (is_duplicate) {
+            drop_node(self, node);
+            continue;
+        }
+
+        write__Diagnostic(*node->diagnostic, writer);
+        write_char__Writer(writer, '\n');
+
+        kept[kept_len++] = node;
+        error_count += node->diagnostic->kind == DiagnosticKindError;
+    }
+
+    if (hidden_error_count > 0) {
+        write_str__Writer(writer, "\x1b[36mnote\x1b[0m: ");
+        write_uint__Writer(writer, hidden_error_count);
+        write_str__Writer(writer, " more errors are not shown (--error-limit=");
+        write_uint__Writer(writer, self->error_limit);
+        write_str__Writer(writer, ")\n");
+    }
+
+    for (Usize i = 0; i < len; i++) {
+        FREE(Diagnostic, nodes[i]->diagnostic);
+        free(nodes[i]);
+    }
+
+    free(nodes);
+    free(kept);
+
+    return kept_len;
+}
+
+void
+flush__DiagnosticSink(struct DiagnosticSink *self)
+{
+    struct Writer writer = NEW(WriterBuffer);
+
+    render__DiagnosticSink(self, &writer);
+
+    if (writer.len > 0) {
+        fwrite(writer.buffer, 1, writer.len, stdout);
+        fflush(stdout);
+    }
+
+    FREE(Writer, writer);
+}
+
+void
+__free__DiagnosticSink(struct DiagnosticSink *self)
+{
+    struct DiagnosticSinkNode *node = atomic_load(&self->head);
+
+    while (node) {
+        struct DiagnosticSinkNode *next = node->next;
+
+        FREE(Diagnostic, node->diagnostic);
+        free(node);
+        node = next;
+    }
+
+    free(self);
+}
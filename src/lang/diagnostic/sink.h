@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_DIAGNOSTIC_SINK_H
+#define LILY_DIAGNOSTIC_SINK_H
+
+#include <base/types.h>
+#include <base/writer.h>
+#include <lang/diagnostic/diagnostic.h>
+#include <stdatomic.h>
+
+typedef struct DiagnosticSinkNode
+{
+    struct Diagnostic *diagnostic; // struct Diagnostic*
+    Usize seq;   // order of the push in the sink
+    Usize group; // seq of the error or the warning which the note follows
+                 // (its own seq otherwise)
+    struct Location group_loc; // location of the first diagnostic of the group
+    Str group_file;            // Str& (the file of the group)
+    struct DiagnosticSinkNode *next;
+} DiagnosticSinkNode;
+
+// The diagnostics of a phase, pushed without lock by all the threads. At the
+// end of the phase, they are sorted by file, line and column (a note stays
+// after the diagnostic which it follows), the identical diagnostics are
+// dropped and the others are rendered in one buffered write.
+typedef struct DiagnosticSink
+{
+    _Atomic(struct DiagnosticSinkNode *) head; // struct DiagnosticSinkNode*
+    atomic_size_t len;
+    atomic_size_t epoch; // incremented at each flush
+    atomic_size_t count_error;
+    atomic_size_t count_warning;
+    Usize error_limit; // maximum number of rendered errors (0 for no limit)
+} DiagnosticSink;
+
+/**
+ *
+ * @brief Construct the DiagnosticSink type.
+ */
+struct DiagnosticSink *
+__new__DiagnosticSink(Usize error_limit);
+
+/**
+ *
+ * @return the sink of the compilation session (see emit__Diagnostic).
+ */
+struct DiagnosticSink *
+global__DiagnosticSink();
+
+/**
+ *
+ * @brief Push the diagnostic in the sink (take the ownership).
+ * @note Can be called by several threads at the same time.
+ */
+void
+push__DiagnosticSink(struct DiagnosticSink *self,
+                     struct Diagnostic *diagnostic);
+
+/**
+ *
+ * @brief Sort, deduplicate and render the pushed diagnostics in writer, then
+ * free them. The counters no longer count the dropped duplicates.
+ * @return the number of rendered diagnostics.
+ */
+Usize
+render__DiagnosticSink(struct DiagnosticSink *self, struct Writer *writer);
+
+/**
+ *
+ * @brief Render the pushed diagnostics on the standard output.
+ */
+void
+flush__DiagnosticSink(struct DiagnosticSink *self);
+
+/**
+ *
+ * @brief Free the DiagnosticSink type (the diagnostics which are not rendered
+ * are dropped).
+ */
+void
+__free__DiagnosticSink(struct DiagnosticSink *self);
+
+#endif // LILY_DIAGNOSTIC_SINK_H
@@ -27,6 +27,7 @@
 #include <base/new.h>
 #include <base/print.h>
 #include <base/string.h>
+#include <lang/diagnostic/sink.h>
 #include <lang/diagnostic/summary.h>
 
 void
@@ -35,6 +36,9 @@ emit__Summary(Int32 count_error, Int32 count_warning, const Str msg)
     Str error = NULL;
     Str warning = NULL;
 
+    // The diagnostics of the failed phase are printed before its summary.
+    flush__DiagnosticSink(global__DiagnosticSink());
+
     if (count_error > 1)
         error = "errors";
     else
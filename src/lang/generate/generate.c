@@ -31,7 +31,7 @@
 struct Generate
 __new__Generate(struct Typecheck tc)
 {
-    struct Generate self = { .output = NEW(String), .tc = tc };
+    struct Generate self = { .output = NEW(String), .tc = tc, .ir = NULL };
 
     return self;
 }
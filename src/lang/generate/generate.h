@@ -27,11 +27,13 @@
 
 #include <base/string.h>
 #include <lang/analysis/typecheck.h>
+#include <lang/ir/ir.h>
 
 typedef struct Generate
 {
     struct String *output;
     struct Typecheck tc;
+    struct IrModule *ir; // struct IrModule& (NULL: built by the generator)
 } Generate;
 
 struct Generate
@@ -23,18 +23,2315 @@
  */
 
 #include <base/format.h>
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/option.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/diagnostic/diagnostic.h>
 #include <lang/generate/generate_c.h>
+#include <lang/generate/layout.h>
+#include <lang/ir/mono.h>
+#include <lang/ir/pass.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-void
-write_main_function(struct Generate *self)
+// The functions, the constants, the records and the enums which have a native C
+// representation are lowered to a self-contained C file: the integers of Lily
+// are the integers of C (Int32 -> int32_t) and the checked arithmetic is done
+// with the overflow builtins of the C compiler (unless the range analysis
+// proved that it can't fail, see range.h), so the C compiler can keep the
+// values in registers and optimize the arithmetic like hand-written C. The
+// bodies are written from their optimized IR (see lang/ir): a register is a
+// local variable and a block is a label. Each instance of a generic function
+// is a C function, a boxed instance holds its generic values in a LilyBox. A
+// closure is a LilyClosure: the function of its lambda, which takes the
+// environment as first param, and the environment of the captured values (in
+// the frame of the function if the closure does not escape, otherwise on the
+// heap, where it's never freed). The records, the enums and the optionals
+// follow the layout planned in layout.h (smallest tag, niches, fields sorted
+// by alignment). A declaration which has no C representation is an error
+// and the C file is not written.
+
+enum TypeDeclState
+{
+    TypeDeclStateUnknown = 0,
+    TypeDeclStateChecking,
+    TypeDeclStateSupported,
+    TypeDeclStateUnsupported
+};
+
+typedef struct GenerateC
+{
+    struct Generate *gen;
+    struct IrModule *ir; // struct IrModule&
+    struct IrFun *fun;   // struct IrFun& (function being lowered)
+    struct String *output; // struct String& (the file or the buffer of the
+                           // declaration being lowered)
+    bool failed; // the declaration being lowered has no C representation
+    bool *funs_supported;   // one per function of the module
+    bool *consts_supported; // one per constant of the file
+    bool *lambdas_supported; // one per lambda of the module
+    enum TypeDeclState *records_state;
+    enum TypeDeclState *enums_state;
+    bool *records_written;
+    bool *enums_written;
+    struct LayoutPlanner layout; // the order of the fields, the tags and the
+                                 // niches (see layout.h)
+    Usize current_const; // constant being lowered (to record its dependencies)
+    bool *consts_deps;   // consts_deps[i * consts_len + j]: the value of the
+                         // constant i uses the constant j
+    Usize count_error;   // number of declarations without C representation
+} GenerateC;
+
+static const Str prelude =
+  "#include <inttypes.h>\n"
+  "#include <stdbool.h>\n"
+  "#include <stdint.h>\n"
+  "#include <stdio.h>\n"
+  "#include <stdlib.h>\n"
+  "#include <string.h>\n"
+  "\n"
+  "__attribute__((noreturn, cold)) static void\n"
+  "lily_panic(const char *msg)\n"
+  "{\n"
+  "    fprintf(stderr, \"panic: %s\\n\", msg);\n"
+  "    exit(101);\n"
+  "}\n"
+  "\n"
+  "#define LILY_CHECKED(op, T, x, y)                                    \\\n"
+  "    ({                                                               \\\n"
+  "        T lily_r;                                                    \\\n"
+  "        if (__builtin_expect(                                        \\\n"
+  "              __builtin_##op##_overflow((x), (y), &lily_r), 0))      \\\n"
+  "            lily_panic(\"integer overflow\");                          \\\n"
+  "        lily_r;                                                      \\\n"
+  "    })\n"
+  "#define LILY_ADD(T, x, y) LILY_CHECKED(add, T, x, y)\n"
+  "#define LILY_SUB(T, x, y) LILY_CHECKED(sub, T, x, y)\n"
+  "#define LILY_MUL(T, x, y) LILY_CHECKED(mul, T, x, y)\n"
+  "#define LILY_NEG(T, x) LILY_CHECKED(sub, T, (T)0, x)\n"
+  "#define LILY_DIVIDE(op, T, x, y)                                     \\\n"
+  "    ({                                                               \\\n"
+  "        T lily_x = (x), lily_y = (y), lily_r;                        \\\n"
+  "        if (__builtin_expect(lily_y == 0, 0))                        \\\n"
+  "            lily_panic(\"division by zero\");                          \\\n"
+  "        if ((T)-1 < 0 && lily_y == (T)-1 &&                          \\\n"
+  "            __builtin_sub_overflow((T)0, lily_x, &lily_r))           \\\n"
+  "            lily_panic(\"integer overflow\");                          \\\n"
+  "        lily_x op lily_y;                                            \\\n"
+  "    })\n"
+  "#define LILY_DIV(T, x, y) LILY_DIVIDE(/, T, x, y)\n"
+  "#define LILY_MOD(T, x, y) LILY_DIVIDE(%, T, x, y)\n"
+  "#define LILY_SHL(T, x, y)                                            \\\n"
+  "    ({                                                               \\\n"
+  "        T lily_x = (x), lily_r;                                      \\\n"
+  "        __typeof__(y) lily_y = (y);                                  \\\n"
+  "        if (__builtin_expect((uint64_t)lily_y >= sizeof(T) * 8, 0))  \\\n"
+  "            lily_panic(\"shift out of range\");                        \\\n"
+  "        lily_r = (T)((uint64_t)lily_x << lily_y);                    \\\n"
+  "        if ((T)-1 < 0 && (lily_x >> (sizeof(T) * 8 - 1) ||           \\\n"
+  "                          lily_r >> lily_y != lily_x))               \\\n"
+  "            lily_panic(\"shift out of range\");                        \\\n"
+  "        lily_r;                                                      \\\n"
+  "    })\n"
+  "#define LILY_SHR(T, x, y)                                            \\\n"
+  "    ({                                                               \\\n"
+  "        T lily_x = (x);                                              \\\n"
+  "        __typeof__(y) lily_y = (y);                                  \\\n"
+  "        if (__builtin_expect((uint64_t)lily_y >= sizeof(T) * 8, 0))  \\\n"
+  "            lily_panic(\"shift out of range\");                        \\\n"
+  "        (T)(lily_x >> lily_y);                                       \\\n"
+  "    })\n"
+  "\n"
+  "typedef union LilyBox\n"
+  "{\n"
+  "    int8_t i8;\n"
+  "    int16_t i16;\n"
+  "    int32_t i32;\n"
+  "    int64_t i64;\n"
+  "    uint8_t u8;\n"
+  "    uint16_t u16;\n"
+  "    uint32_t u32;\n"
+  "    uint64_t u64;\n"
+  "    float f32;\n"
+  "    double f64;\n"
+  "    bool b;\n"
+  "    char c;\n"
+  "    const char *s;\n"
+  "    intptr_t isize;\n"
+  "    size_t usize;\n"
+  "} LilyBox;\n"
+  "\n"
+  "typedef struct LilyClosure\n"
+  "{\n"
+  "    void (*fun)(void);\n"
+  "    void *env;\n"
+  "} LilyClosure;\n"
+  "\n"
+  "__attribute__((unused)) static void *\n"
+  "lily_alloc(const void *value, size_t size)\n"
+  "{\n"
+  "    void *p = malloc(size);\n"
+  "    if (!p)\n"
+  "        lily_panic(\"out of memory\");\n"
+  "    return memcpy(p, value, size);\n"
+  "}\n";
+
+static inline void
+write_str(struct GenerateC *self, const Str s)
+{
+    push_str__String(self->output, s);
+}
+
+static inline void
+write_string(struct GenerateC *self, struct String *s)
+{
+    append__String(self->output, s, true);
+}
+
+// The declarations of a file without declaration of this kind are NULL.
+static inline Usize
+get_len(struct Vec *decls)
+{
+    return decls ? len__Vec(*decls) : 0;
+}
+
+static inline struct DataTypeSymbol *
+strip_mut(struct DataTypeSymbol *data_type)
+{
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    return data_type;
+}
+
+static inline bool
+is_known(struct DataTypeSymbol *data_type)
+{
+    return data_type && data_type->kind != DataTypeKindCompilerDefined;
+}
+
+static bool
+is_int(struct DataTypeSymbol *data_type)
+{
+    switch (data_type ? data_type->kind : DataTypeKindCompilerDefined) {
+        case DataTypeKindI8:
+        case DataTypeKindI16:
+        case DataTypeKindI32:
+        case DataTypeKindI64:
+        case DataTypeKindI128:
+        case DataTypeKindU8:
+        case DataTypeKindU16:
+        case DataTypeKindU32:
+        case DataTypeKindU64:
+        case DataTypeKindU128:
+        case DataTypeKindIsize:
+        case DataTypeKindUsize:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static inline bool
+is_float(struct DataTypeSymbol *data_type)
+{
+    return data_type && (data_type->kind == DataTypeKindF32 ||
+                         data_type->kind == DataTypeKindF64);
+}
+
+static inline Isize
+search_record(struct GenerateC *self, struct Scope *scope)
+{
+    return search_record__LayoutPlanner(&self->layout, scope);
+}
+
+static inline Isize
+search_enum(struct GenerateC *self, struct Scope *scope)
+{
+    return search_enum__LayoutPlanner(&self->layout, scope);
+}
+
+// The layout of the enum of the data type (NULL if it's not an enum).
+static const struct Layout *
+get_enum_layout(struct GenerateC *self, struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    Isize id = data_type && data_type->kind == DataTypeKindCustom
+                 ? search_enum(self, data_type->scope)
+                 : -1;
+
+    return id != -1 ? get_enum_layout__LayoutPlanner(&self->layout, id) : NULL;
+}
+
+// The variant without payload of an enum whose layout is a niche.
+static Usize
+get_niche_variant(const struct EnumSymbol *enum_)
+{
+    for (Usize i = 0; i < len__Vec(*enum_->variants); i++)
+        if (!((struct SymbolTable *)get__Vec(*enum_->variants, i))
+               ->value.variant->data_type)
+            return i;
+
+    return 0;
+}
+
+static struct String *
+get_c_type(struct GenerateC *self, struct DataTypeSymbol *data_type);
+
+// A record (or an enum with payload) can be held by value only if all its
+// fields can: a record which contains itself by value has no C representation.
+static bool
+is_record_supported(struct GenerateC *self, Usize id)
+{
+    struct RecordSymbol *record = get__Vec(*self->gen->tc.records, id);
+
+    switch (self->records_state[id]) {
+        case TypeDeclStateSupported:
+            return true;
+        case TypeDeclStateChecking:
+        case TypeDeclStateUnsupported:
+            return false;
+        default:
+            break;
+    }
+
+    bool is_supported = !record->generic_params;
+
+    self->records_state[id] = TypeDeclStateChecking;
+
+    for (Usize i = 0;
+         is_supported && record->fields && i < len__Vec(*record->fields);
+         i++) {
+        struct String *field_type = get_c_type(
+          self,
+          ((struct SymbolTable *)get__Vec(*record->fields, i))
+            ->value.field->data_type);
+
+        is_supported = field_type != NULL;
+
+        if (field_type)
+            FREE(String, field_type);
+    }
+
+    self->records_state[id] =
+      is_supported ? TypeDeclStateSupported : TypeDeclStateUnsupported;
+
+    return is_supported;
+}
+
+static bool
+is_enum_supported(struct GenerateC *self, Usize id)
+{
+    struct EnumSymbol *enum_ = get__Vec(*self->gen->tc.enums, id);
+
+    switch (self->enums_state[id]) {
+        case TypeDeclStateSupported:
+            return true;
+        case TypeDeclStateChecking:
+        case TypeDeclStateUnsupported:
+            return false;
+        default:
+            break;
+    }
+
+    bool is_supported = !enum_->generic_params && enum_->variants;
+
+    self->enums_state[id] = TypeDeclStateChecking;
+
+    for (Usize i = 0; is_supported && i < len__Vec(*enum_->variants); i++) {
+        struct DataTypeSymbol *data_type =
+          ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+            ->value.variant->data_type;
+
+        if (data_type) {
+            struct String *variant_type = get_c_type(self, data_type);
+
+            is_supported = variant_type != NULL;
+
+            if (variant_type)
+                FREE(String, variant_type);
+        }
+    }
+
+    self->enums_state[id] =
+      is_supported ? TypeDeclStateSupported : TypeDeclStateUnsupported;
+
+    return is_supported;
+}
+
+// Return NULL if the data type has no C representation.
+static struct String *
+get_c_type(struct GenerateC *self, struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    if (!data_type)
+        return from__String("void");
+
+    switch (data_type->kind) {
+        case DataTypeKindI8:
+            return from__String("int8_t");
+        case DataTypeKindI16:
+            return from__String("int16_t");
+        case DataTypeKindI32:
+            return from__String("int32_t");
+        case DataTypeKindI64:
+            return from__String("int64_t");
+        case DataTypeKindI128:
+            return from__String("__int128");
+        case DataTypeKindU8:
+        case DataTypeKindBitChar:
+            return from__String("uint8_t");
+        case DataTypeKindU16:
+            return from__String("uint16_t");
+        case DataTypeKindU32:
+            return from__String("uint32_t");
+        case DataTypeKindU64:
+            return from__String("uint64_t");
+        case DataTypeKindU128:
+            return from__String("unsigned __int128");
+        case DataTypeKindF32:
+            return from__String("float");
+        case DataTypeKindF64:
+            return from__String("double");
+        case DataTypeKindBool:
+            return from__String("bool");
+        case DataTypeKindChar:
+            return from__String("char");
+        case DataTypeKindStr:
+            return from__String("const char *");
+        case DataTypeKindIsize:
+            return from__String("intptr_t");
+        case DataTypeKindUsize:
+            return from__String("size_t");
+        case DataTypeKindUnit:
+        case DataTypeKindNever:
+            return from__String("void");
+        case DataTypeKindPtr:
+        case DataTypeKindRef: {
+            struct DataTypeSymbol *pointee = strip_mut(
+              data_type->kind == DataTypeKindPtr ? data_type->value.ptr
+                                                 : data_type->value.ref);
+            Isize record_id =
+              pointee && pointee->kind == DataTypeKindCustom
+                ? search_record(self, pointee->scope)
+                : -1;
+
+            // The records are declared before their definition, so a record
+            // can point to itself.
+            if (record_id != -1) {
+                struct RecordSymbol *record =
+                  get__Vec(*self->gen->tc.records, record_id);
+
+                return record->generic_params
+                         ? NULL
+                         : format("lily__{S} *", record->name);
+            }
+
+            struct String *pointee_type = get_c_type(self, pointee);
+
+            if (!pointee_type)
+                return NULL;
+
+            push_str__String(pointee_type, " *");
+
+            return pointee_type;
+        }
+        case DataTypeKindCustom: {
+            if (is_generic__DataTypeSymbol(data_type))
+                return from__String("LilyBox");
+
+            Isize id = search_record(self, data_type->scope);
+
+            if (id != -1)
+                return is_record_supported(self, id)
+                         ? format("lily__{S}", data_type->scope->name)
+                         : NULL;
+
+            id = search_enum(self, data_type->scope);
+
+            if (id != -1)
+                return is_enum_supported(self, id)
+                         ? format("lily__{S}", data_type->scope->name)
+                         : NULL;
+
+            return NULL;
+        }
+        // ?&T is &T and ?Color is Color, none is their niche (see layout.h).
+        case DataTypeKindOptional:
+            return get_layout__LayoutPlanner(&self->layout, data_type).kind ==
+                       LayoutKindNiche
+                     ? get_c_type(self, data_type->value.optional)
+                     : NULL;
+        case DataTypeKindCompilerDefined:
+            return from__String("LilyBox");
+        case DataTypeKindLambda:
+            return from__String("LilyClosure");
+        default:
+            return NULL;
+    }
+}
+
+static void
+write_data_type(struct GenerateC *self, struct DataTypeSymbol *data_type)
+{
+    struct String *c_type = get_c_type(self, data_type);
+
+    if (c_type)
+        write_string(self, c_type);
+    else
+        self->failed = true;
+}
+
+static inline bool
+is_void(struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    return !data_type || data_type->kind == DataTypeKindUnit ||
+           data_type->kind == DataTypeKindNever;
+}
+
+static void
+write_char(struct GenerateC *self, char c)
+{
+    char s[2] = { c, '\0' };
+
+    write_str(self, s);
+}
+
+// The scanner keeps the escapes \n, \t, \r and \b of the string literals.
+static void
+write_escaped_char(struct GenerateC *self, Str s, Usize *i)
+{
+    char c = s[*i];
+
+    if (c == '\\' && s[*i + 1] &&
+        (s[*i + 1] == 'n' || s[*i + 1] == 't' || s[*i + 1] == 'r' ||
+         s[*i + 1] == 'b')) {
+        write_char(self, '\\');
+        write_char(self, s[++*i]);
+    } else if (c == '\\' || c == '"') {
+        write_char(self, '\\');
+        write_char(self, c);
+    } else if ((unsigned char)c < 0x20 || (unsigned char)c >= 0x7f) {
+        char escape[5];
+
+        snprintf(escape, sizeof(escape), "\\%03o", (unsigned char)c);
+        write_str(self, escape);
+    } else
+        write_char(self, c);
+}
+
+static void
+write_signed(struct GenerateC *self, Str c_type, Int64 value)
+{
+    char s[64];
+
+    // -9223372036854775808LL is the negation of a too large literal.
+    if (value == INT64_MIN)
+        snprintf(s, sizeof(s), "((%s)INT64_MIN)", c_type);
+    else
+        snprintf(s, sizeof(s), "((%s)%lldLL)", c_type, (long long)value);
+
+    write_str(self, s);
+}
+
+static void
+write_unsigned(struct GenerateC *self, Str c_type, UInt64 value)
+{
+    char s[64];
+
+    snprintf(
+      s, sizeof(s), "((%s)%lluULL)", c_type, (unsigned long long)value);
+    write_str(self, s);
+}
+
+static void
+write_int128(struct GenerateC *self, Str c_type, Int128 value)
+{
+    if (value >= (Int128)INT64_MIN && value <= (Int128)INT64_MAX) {
+        write_signed(self, c_type, (Int64)value);
+        return;
+    }
+
+    char s[128];
+
+    snprintf(s,
+             sizeof(s),
+             "((%s)(((unsigned __int128)%lluULL << 64) | %lluULL))",
+             c_type,
+             (unsigned long long)((UInt128)value >> 64),
+             (unsigned long long)(UInt64)value);
+    write_str(self, s);
+}
+
+static void
+write_float(struct GenerateC *self, Str c_type, Float64 value)
+{
+    char s[64];
+
+    if (value != value)
+        snprintf(s, sizeof(s), "((%s)__builtin_nan(\"\"))", c_type);
+    else if (value == __builtin_inf() || value == -__builtin_inf())
+        snprintf(s,
+                 sizeof(s),
+                 "((%s)%s__builtin_inf())",
+                 c_type,
+                 value < 0 ? "-" : "");
+    else {
+        int len = snprintf(s, sizeof(s), "((%s)%.17g", c_type, value);
+
+        if (!strpbrk(s + strlen(c_type) + 3, ".e"))
+            len += snprintf(s + len, sizeof(s) - len, ".0");
+
+        snprintf(s + len, sizeof(s) - len, ")");
+    }
+
+    write_str(self, s);
+}
+
+static void
+write_literal(struct GenerateC *self, struct LiteralSymbol literal)
+{
+    switch (literal.kind) {
+        case LiteralSymbolKindBool:
+            write_str(self, literal.value.bool_ ? "true" : "false");
+            break;
+        case LiteralSymbolKindChar:
+            write_signed(self, "char", literal.value.char_);
+            break;
+        case LiteralSymbolKindBitChar:
+            write_unsigned(self, "uint8_t", literal.value.bit_char);
+            break;
+        case LiteralSymbolKindInt8:
+            write_signed(self, "int8_t", literal.value.int8);
+            break;
+        case LiteralSymbolKindInt16:
+            write_signed(self, "int16_t", literal.value.int16);
+            break;
+        case LiteralSymbolKindInt32:
+            write_signed(self, "int32_t", literal.value.int32);
+            break;
+        case LiteralSymbolKindInt64:
+            write_signed(self, "int64_t", literal.value.int64);
+            break;
+        case LiteralSymbolKindInt128:
+            write_int128(self, "__int128", literal.value.int128);
+            break;
+        case LiteralSymbolKindUint8:
+            write_unsigned(self, "uint8_t", literal.value.uint8);
+            break;
+        case LiteralSymbolKindUint16:
+            write_unsigned(self, "uint16_t", literal.value.uint16);
+            break;
+        case LiteralSymbolKindUint32:
+            write_unsigned(self, "uint32_t", literal.value.uint32);
+            break;
+        case LiteralSymbolKindUint64:
+            write_unsigned(self, "uint64_t", literal.value.uint64);
+            break;
+        case LiteralSymbolKindUint128:
+            write_int128(self, "unsigned __int128", literal.value.uint128);
+            break;
+        case LiteralSymbolKindFloat32:
+            write_float(self, "float", literal.value.float32);
+            break;
+        case LiteralSymbolKindFloat64:
+            write_float(self, "double", literal.value.float64);
+            break;
+        case LiteralSymbolKindStr:
+            write_char(self, '"');
+
+            for (Usize i = 0; literal.value.str[i]; i++)
+                write_escaped_char(self, literal.value.str, &i);
+
+            write_char(self, '"');
+            break;
+        default:
+            self->failed = true;
+    }
+}
+
+static void
+write_reg(struct GenerateC *self, Usize reg)
+{
+    char s[32];
+
+    snprintf(s, sizeof(s), "r%zu", (size_t)reg);
+    write_str(self, s);
+}
+
+static void
+write_block_label(struct GenerateC *self, Usize block)
+{
+    char s[32];
+
+    snprintf(s, sizeof(s), "bb%zu", (size_t)block);
+    write_str(self, s);
+}
+
+static inline struct DataTypeSymbol *
+get_reg_data_type(struct GenerateC *self, Usize reg)
+{
+    return self->fun->regs[reg];
+}
+
+static void
+write_reg_data_type(struct GenerateC *self, Usize reg)
+{
+    write_data_type(self, get_reg_data_type(self, reg));
+}
+
+static Str
+get_arithmetic_macro(enum IrOp op)
+{
+    switch (op) {
+        case IrOpAdd:
+            return "LILY_ADD";
+        case IrOpSub:
+            return "LILY_SUB";
+        case IrOpMul:
+            return "LILY_MUL";
+        case IrOpDiv:
+            return "LILY_DIV";
+        case IrOpMod:
+            return "LILY_MOD";
+        default:
+            UNREACHABLE("expected arithmetic operator");
+    }
+}
+
+static Str
+get_c_op(enum IrOp op)
+{
+    switch (op) {
+        case IrOpAdd:
+            return " + ";
+        case IrOpSub:
+            return " - ";
+        case IrOpMul:
+            return " * ";
+        case IrOpDiv:
+            return " / ";
+        case IrOpMod:
+            return " % ";
+        case IrOpLt:
+            return " < ";
+        case IrOpGt:
+            return " > ";
+        case IrOpLe:
+            return " <= ";
+        case IrOpGe:
+            return " >= ";
+        case IrOpEq:
+            return " == ";
+        case IrOpNe:
+            return " != ";
+        case IrOpXor:
+            return " ^ ";
+        case IrOpShl:
+            return " << ";
+        case IrOpShr:
+            return " >> ";
+        case IrOpBitOr:
+            return " | ";
+        case IrOpBitAnd:
+            return " & ";
+        default:
+            UNREACHABLE("expected binary operator");
+    }
+}
+
+static void
+write_infix_op(struct GenerateC *self, Str op, Usize left, Usize right)
+{
+    write_str(self, "(");
+    write_reg(self, left);
+    write_str(self, op);
+    write_reg(self, right);
+    write_str(self, ")");
+}
+
+// The bitwise operators promote the operands to int: the result is converted
+// back to the type of the operands.
+static void
+write_bit_op(struct GenerateC *self, Str op, Usize left, Usize right)
+{
+    write_str(self, "((");
+    write_reg_data_type(self, left);
+    write_str(self, ")");
+    write_infix_op(self, op, left, right);
+    write_str(self, ")");
+}
+
+static void
+write_binary(struct GenerateC *self, const struct IrInst *inst)
+{
+    Usize left = inst->args[0];
+    Usize right = inst->args[1];
+    struct DataTypeSymbol *data_type = get_reg_data_type(self, left);
+
+    switch (inst->value.op) {
+        case IrOpAdd:
+        case IrOpSub:
+        case IrOpMul:
+        case IrOpDiv:
+        case IrOpMod:
+            // The range analysis proved that the operation can't fail.
+            if ((is_float(data_type) && inst->value.op != IrOpMod) ||
+                (is_int(data_type) && inst->is_unchecked))
+                write_infix_op(self, get_c_op(inst->value.op), left, right);
+            else if (is_int(data_type)) {
+                write_str(self, get_arithmetic_macro(inst->value.op));
+                write_str(self, "(");
+                write_data_type(self, data_type);
+                write_str(self, ", ");
+                write_reg(self, left);
+                write_str(self, ", ");
+                write_reg(self, right);
+                write_str(self, ")");
+            } else
+                self->failed = true;
+
+            break;
+        case IrOpEq:
+        case IrOpNe:
+            if (data_type && data_type->kind == DataTypeKindStr) {
+                write_str(self, "(strcmp(");
+                write_reg(self, left);
+                write_str(self, ", ");
+                write_reg(self, right);
+                write_str(self,
+                          inst->value.op == IrOpEq ? ") == 0)" : ") != 0)");
+                break;
+            }
+
+            // fall through
+        case IrOpLt:
+        case IrOpGt:
+        case IrOpLe:
+        case IrOpGe:
+            if (data_type && (data_type->kind == DataTypeKindCustom ||
+                              data_type->kind == DataTypeKindStr))
+                self->failed = true;
+            else
+                write_infix_op(self, get_c_op(inst->value.op), left, right);
+
+            break;
+        case IrOpXor:
+            if (data_type && data_type->kind == DataTypeKindBool) {
+                write_infix_op(self, " != ", left, right);
+                break;
+            }
+
+            // fall through
+        default:
+            // A shift by a negative value or by the width of the integer (or
+            // more) panics, like a shift which overflows a signed integer (see
+            // fold_int).
+            if ((inst->value.op == IrOpShl || inst->value.op == IrOpShr) &&
+                is_int(data_type)) {
+                write_str(
+                  self, inst->value.op == IrOpShl ? "LILY_SHL(" : "LILY_SHR(");
+                write_data_type(self, data_type);
+                write_str(self, ", ");
+                write_reg(self, left);
+                write_str(self, ", ");
+                write_reg(self, right);
+                write_str(self, ")");
+                break;
+            }
+
+            write_bit_op(self, get_c_op(inst->value.op), left, right);
+    }
+}
+
+static void
+write_unary(struct GenerateC *self, const struct IrInst *inst)
+{
+    Usize right = inst->args[0];
+
+    switch (inst->value.op) {
+        case IrOpNeg:
+            if (is_float(get_reg_data_type(self, right)) ||
+                inst->is_unchecked) {
+                write_str(self, "(-");
+                write_reg(self, right);
+                write_str(self, ")");
+            } else {
+                write_str(self, "LILY_NEG(");
+                write_reg_data_type(self, right);
+                write_str(self, ", ");
+                write_reg(self, right);
+                write_str(self, ")");
+            }
+
+            break;
+        case IrOpNot:
+            write_str(self, "(!");
+            write_reg(self, right);
+            write_str(self, ")");
+            break;
+        case IrOpBitNot:
+            write_str(self, "((");
+            write_reg_data_type(self, right);
+            write_str(self, ")~");
+            write_reg(self, right);
+            write_str(self, ")");
+            break;
+        default:
+            self->failed = true;
+    }
+}
+
+// Write the conversion of printf of an argument of println: the {} of the
+// format are replaced by the conversion of the data type of the argument.
+static void
+write_print_conversion(struct GenerateC *self, struct String *args, Usize arg)
+{
+    struct DataTypeSymbol *data_type = strip_mut(get_reg_data_type(self, arg));
+    Str conversion = NULL;
+    Str cast = NULL;
+    bool is_bool = false;
+
+    switch (data_type ? data_type->kind : DataTypeKindCompilerDefined) {
+        case DataTypeKindI8:
+        case DataTypeKindI16:
+        case DataTypeKindI32:
+            conversion = "%\" PRId32 \"";
+            cast = "int32_t";
+            break;
+        case DataTypeKindI64:
+            conversion = "%\" PRId64 \"";
+            cast = "int64_t";
+            break;
+        case DataTypeKindU8:
+        case DataTypeKindU16:
+        case DataTypeKindU32:
+            conversion = "%\" PRIu32 \"";
+            cast = "uint32_t";
+            break;
+        case DataTypeKindU64:
+            conversion = "%\" PRIu64 \"";
+            cast = "uint64_t";
+            break;
+        case DataTypeKindIsize:
+            conversion = "%\" PRIdPTR \"";
+            cast = "intptr_t";
+            break;
+        case DataTypeKindUsize:
+            conversion = "%zu";
+            cast = "size_t";
+            break;
+        case DataTypeKindF32:
+        case DataTypeKindF64:
+            conversion = "%g";
+            cast = "double";
+            break;
+        case DataTypeKindChar:
+            conversion = "%c";
+            cast = "char";
+            break;
+        case DataTypeKindStr:
+            conversion = "%s";
+            break;
+        case DataTypeKindBool:
+            conversion = "%s";
+            is_bool = true;
+            break;
+        default:
+            self->failed = true;
+            return;
+    }
+
+    write_str(self, conversion);
+
+    struct String *output = self->output;
+
+    self->output = args;
+
+    write_str(self, ", ");
+
+    if (cast)
+        write_string(self, format("({s})", cast));
+
+    write_reg(self, arg);
+
+    if (is_bool)
+        write_str(self, " ? \"true\" : \"false\"");
+
+    self->output = output;
+}
+
+// println("{} + {} = {}", x, y, x + y) -> printf("%" PRId32 " + ...\n", ...)
+static void
+write_print(struct GenerateC *self, const struct IrInst *inst)
+{
+    Str s = inst->value.print.format;
+    struct String *args = NEW(String);
+    Usize arg_id = 0;
+
+    write_str(self, "printf(\"");
+
+    for (Usize i = 0; s[i]; i++) {
+        if (s[i] == '{' && s[i + 1] == '}') {
+            if (arg_id >= inst->args_len) {
+                self->failed = true;
+                break;
+            }
+
+            write_print_conversion(self, args, inst->args[arg_id++]);
+            i++;
+        } else if (s[i] == '%')
+            write_str(self, "%%");
+        else
+            write_escaped_char(self, s, &i);
+    }
+
+    if (arg_id != inst->args_len)
+        self->failed = true;
+
+    write_str(self, inst->value.print.newline ? "\\n\"" : "\"");
+    write_string(self, args);
+    write_str(self, ")");
+}
+
+static void
+write_call(struct GenerateC *self, const struct IrInst *inst)
+{
+    if (!self->funs_supported[inst->value.fun]) {
+        self->failed = true;
+        return;
+    }
+
+    write_string(
+      self,
+      format("lily__{S}(", get_fun_name__IrModule(self->ir, inst->value.fun)));
+
+    for (Usize i = 0; i < inst->args_len; i++) {
+        if (i > 0)
+            write_str(self, ", ");
+
+        write_reg(self, inst->args[i]);
+    }
+
+    write_str(self, ")");
+}
+
+// closure main__lambda0 %1 -> ((LilyClosure){ (void (*)(void))
+// lily__main__lambda0__closure, (lily_env0 = (struct lily__main__lambda0__env){
+// r1 }, &lily_env0) }), the environment of an escaping closure is copied on
+// the heap.
+static void
+write_closure(struct GenerateC *self, const struct IrInst *inst)
+{
+    struct String *name = self->ir->lambdas[inst->value.closure.lambda].name;
+
+    if (!self->lambdas_supported[inst->value.closure.lambda]) {
+        self->failed = true;
+        return;
+    }
+
+    write_str(self, "((LilyClosure){ (void (*)(void))");
+    write_string(self, format("lily__{S}__closure, ", name));
+
+    if (!inst->args_len) {
+        write_str(self, "NULL })");
+        return;
+    } else if (inst->value.closure.is_heap)
+        write_string(self, format("lily_alloc(&(struct lily__{S}__env)", name));
+    else
+        write_string(self,
+                     format("(lily_env{d} = (struct lily__{S}__env)",
+                            (int)inst->dst,
+                            name));
+
+    write_str(self, "{ ");
+
+    for (Usize i = 0; i < inst->args_len; i++) {
+        if (i > 0)
+            write_str(self, ", ");
+
+        write_reg(self, inst->args[i]);
+    }
+
+    write_str(self, " }, ");
+
+    if (inst->value.closure.is_heap)
+        write_string(self, format("sizeof(struct lily__{S}__env)) })", name));
+    else
+        write_string(self, format("&lily_env{d}) })", (int)inst->dst));
+}
+
+// callclosure %0, %1 -> ((int32_t (*)(void *, int32_t))r0.fun)(r0.env, r1)
+static void
+write_call_closure(struct GenerateC *self, const struct IrInst *inst)
+{
+    struct DataTypeSymbol *data_type =
+      strip_mut(get_reg_data_type(self, inst->args[0]));
+    struct Vec *params = data_type->value.lambda->items[0];
+
+    write_str(self, "((");
+    write_data_type(self, data_type->value.lambda->items[1]);
+    write_str(self, " (*)(void *");
+
+    for (Usize i = 0; params && i < len__Vec(*params); i++) {
+        write_str(self, ", ");
+        write_data_type(self, get__Vec(*params, i));
+    }
+
+    write_str(self, "))");
+    write_reg(self, inst->args[0]);
+    write_str(self, ".fun)(");
+    write_reg(self, inst->args[0]);
+    write_str(self, ".env");
+
+    for (Usize i = 1; i < inst->args_len; i++) {
+        write_str(self, ", ");
+        write_reg(self, inst->args[i]);
+    }
+
+    write_str(self, ")");
+}
+
+// record Point(1, 2) -> ((lily__Point){ .x = r1, .y = r2 })
+static void
+write_record(struct GenerateC *self, const struct IrInst *inst)
+{
+    struct RecordSymbol *record =
+      get__Vec(*self->gen->tc.records, inst->value.record);
+
+    if (!is_record_supported(self, inst->value.record)) {
+        self->failed = true;
+        return;
+    }
+
+    write_string(self, format("((lily__{S})", record->name));
+    write_str(self, "{ ");
+
+    for (Usize i = 0; i < inst->args_len; i++) {
+        write_string(
+          self,
+          format("{s}.{S} = ",
+                 i > 0 ? ", " : "",
+                 ((struct SymbolTable *)get__Vec(*record->fields, i))
+                   ->value.field->name));
+        write_reg(self, inst->args[i]);
+    }
+
+    write_str(self, " })");
+}
+
+// The member of LilyBox which holds a value of the data type.
+static Str
+get_box_member(struct DataTypeSymbol *data_type)
+{
+    switch (strip_mut(data_type)->kind) {
+        case DataTypeKindI8:
+            return "i8";
+        case DataTypeKindI16:
+            return "i16";
+        case DataTypeKindI32:
+            return "i32";
+        case DataTypeKindI64:
+            return "i64";
+        case DataTypeKindU8:
+            return "u8";
+        case DataTypeKindU16:
+            return "u16";
+        case DataTypeKindU32:
+            return "u32";
+        case DataTypeKindU64:
+            return "u64";
+        case DataTypeKindF32:
+            return "f32";
+        case DataTypeKindF64:
+            return "f64";
+        case DataTypeKindBool:
+            return "b";
+        case DataTypeKindChar:
+            return "c";
+        case DataTypeKindStr:
+            return "s";
+        case DataTypeKindIsize:
+            return "isize";
+        case DataTypeKindUsize:
+            return "usize";
+        default:
+            return NULL;
+    }
+}
+
+// box r1 -> ((LilyBox){ .i32 = r1 }), unbox r2 -> r2.i32
+static void
+write_box(struct GenerateC *self, const struct IrInst *inst)
+{
+    Usize value =
+      inst->kind == IrInstKindBox ? inst->args[0] : inst->dst;
+    Str member = get_box_member(get_reg_data_type(self, value));
+
+    if (!member) {
+        self->failed = true;
+        return;
+    }
+
+    if (inst->kind == IrInstKindBox) {
+        write_string(self, format("((LilyBox){{ .{s} = ", member));
+        write_reg(self, inst->args[0]);
+        write_str(self, " })");
+    } else {
+        write_reg(self, inst->args[0]);
+        write_string(self, format(".{s}", member));
+    }
+}
+
+static void
+write_constant_value(struct GenerateC *self, Usize id)
+{
+    if (!self->consts_supported[id]) {
+        self->failed = true;
+        return;
+    }
+
+    if (self->consts_deps)
+        self->consts_deps[self->current_const * get_len(self->gen->tc.consts) +
+                          id] = true;
+
+    write_string(
+      self,
+      format("lily__{S}",
+             ((struct ConstantSymbol *)get__Vec(*self->gen->tc.consts, id))
+               ->name));
+}
+
+// lily__Shape__Circle (the name of the tag of the variant)
+static void
+write_variant_tag(struct GenerateC *self,
+                  const struct EnumSymbol *enum_,
+                  Usize variant)
+{
+    write_string(
+      self,
+      format("lily__{S}__{S}",
+             enum_->name,
+             ((struct SymbolTable *)get__Vec(*enum_->variants, variant))
+               ->value.variant->name));
+}
+
+// variant Circle r1 -> ((lily__Shape){ .tag = lily__Shape__Circle,
+// .value.Circle = r1 }), payload Circle r2 -> r2.value.Circle. The variant
+// with payload of a niche is its payload, the other one is NULL.
+static void
+write_variant(struct GenerateC *self, const struct IrInst *inst)
+{
+    struct DataTypeSymbol *data_type = get_reg_data_type(
+      self, inst->kind == IrInstKindVariant ? inst->dst : inst->args[0]);
+    struct EnumSymbol *enum_ = get_enum__IrModule(self->ir, data_type);
+    const struct Layout *layout = get_enum_layout(self, data_type);
+    struct String *name =
+      ((struct SymbolTable *)get__Vec(*enum_->variants, inst->value.variant))
+        ->value.variant->name;
+
+    if (layout->kind == LayoutKindNiche) {
+        if (inst->args_len)
+            write_reg(self, inst->args[0]);
+        else
+            write_string(self, format("((lily__{S})NULL)", enum_->name));
+    } else if (inst->kind == IrInstKindPayload) {
+        write_reg(self, inst->args[0]);
+        write_string(self, format(".value.{S}", name));
+    } else if (layout->kind == LayoutKindEnum)
+        write_variant_tag(self, enum_, inst->value.variant);
+    else {
+        write_string(self, format("((lily__{S}){{ .tag = ", enum_->name));
+        write_variant_tag(self, enum_, inst->value.variant);
+
+        if (inst->args_len) {
+            write_string(self, format(", .value.{S} = ", name));
+            write_reg(self, inst->args[0]);
+        }
+
+        write_str(self, " })");
+    }
+}
+
+static void
+write_inst(struct GenerateC *self, const struct IrInst *inst, const bool *used)
+{
+    write_str(self, "    ");
+
+    // The value of a call or of a checked operation is not used: only the
+    // effect remains.
+    if (inst->dst != IR_NONE && !used[inst->dst])
+        write_str(self, "(void)");
+    else if (inst->dst != IR_NONE) {
+        write_reg(self, inst->dst);
+        write_str(self, " = ");
+    }
+
+    switch (inst->kind) {
+        case IrInstKindConst:
+            write_literal(self, inst->value.literal);
+            break;
+        case IrInstKindCopy:
+            write_reg(self, inst->args[0]);
+            break;
+        case IrInstKindUnary:
+            write_unary(self, inst);
+            break;
+        case IrInstKindBinary:
+            write_binary(self, inst);
+            break;
+        case IrInstKindCall:
+            write_call(self, inst);
+            break;
+        case IrInstKindPrint:
+            write_print(self, inst);
+            break;
+        case IrInstKindRecord:
+            write_record(self, inst);
+            break;
+        case IrInstKindField:
+            write_reg(self, inst->args[0]);
+            write_string(self,
+                         format("{s}{S}",
+                                inst->value.field.is_ptr ? "->" : ".",
+                                inst->value.field.name));
+            break;
+        case IrInstKindSetField:
+            write_reg(self, inst->args[0]);
+            write_str(self, ";\n    ");
+            write_reg(self, inst->dst);
+            write_string(self, format(".{S} = ", inst->value.field.name));
+            write_reg(self, inst->args[1]);
+            break;
+        case IrInstKindConstant:
+            write_constant_value(self, inst->value.constant);
+            break;
+        case IrInstKindBox:
+        case IrInstKindUnbox:
+            write_box(self, inst);
+            break;
+        case IrInstKindVariant:
+        case IrInstKindPayload:
+            write_variant(self, inst);
+            break;
+        case IrInstKindClosure:
+            write_closure(self, inst);
+            break;
+        case IrInstKindCallClosure:
+            write_call_closure(self, inst);
+            break;
+    }
+
+    write_str(self, ";\n");
+}
+
+// The arguments are assigned to the parameters of the block, then the block is
+// reached. If an argument is a parameter of the block assigned before (a loop
+// which swaps two values), all the arguments go through temporaries, declared
+// in a C block of their own since a function can have several such edges.
+static void
+write_edge(struct GenerateC *self, const struct IrEdge *edge, Str indent)
 {
-    append__String(self->output, from__String("int main() {\n"), true);
-    append__String(self->output, from__String("\treturn 0;\n"), true);
-    append__String(self->output, from__String("}"), true);
+    const struct IrBlock *block = &self->fun->blocks[edge->block];
+    bool needs_tmp = false;
+    Str outer = indent;
+    char tmp_indent[64];
+
+    for (Usize i = 0; i < edge->args_len && !needs_tmp; i++)
+        for (Usize j = 0; j < i; j++)
+            if (edge->args[i] == block->params[j]) {
+                needs_tmp = true;
+                break;
+            }
+
+    if (needs_tmp) {
+        write_str(self, indent);
+        write_str(self, "{\n");
+        snprintf(tmp_indent, sizeof(tmp_indent), "%s    ", indent);
+        indent = tmp_indent;
+    }
+
+    for (Usize i = 0; i < edge->args_len; i++) {
+        if (edge->args[i] == block->params[i])
+            continue;
+
+        write_str(self, indent);
+
+        if (needs_tmp) {
+            write_reg_data_type(self, edge->args[i]);
+            write_string(self, format(" lily_tmp{d} = ", (int)i));
+        } else {
+            write_reg(self, block->params[i]);
+            write_str(self, " = ");
+        }
+
+        write_reg(self, edge->args[i]);
+        write_str(self, ";\n");
+    }
+
+    for (Usize i = 0; needs_tmp && i < edge->args_len; i++)
+        if (edge->args[i] != block->params[i]) {
+            write_str(self, indent);
+            write_reg(self, block->params[i]);
+            write_string(self, format(" = lily_tmp{d};\n", (int)i));
+        }
+
+    if (needs_tmp) {
+        write_str(self, outer);
+        write_str(self, "}\n");
+    }
+
+    write_str(self, outer);
+    write_str(self, "goto ");
+    write_block_label(self, edge->block);
+    write_str(self, ";\n");
+}
+
+// A switch on an enum with payload tests its tag, the cases of an enum are
+// its tags. The tag of a niche is computed from its payload:
+// switch (r1 ? lily__Link__Node : lily__Link__Empty).
+static void
+write_switch(struct GenerateC *self, const struct IrTerm *term)
+{
+    struct DataTypeSymbol *data_type = get_reg_data_type(self, term->value);
+    struct EnumSymbol *enum_ = get_enum__IrModule(self->ir, data_type);
+    const struct Layout *layout =
+      enum_ ? get_enum_layout(self, data_type) : NULL;
+
+    write_str(self, "    switch (");
+    write_reg(self, term->value);
+
+    if (layout && layout->kind == LayoutKindNiche) {
+        Usize niche = get_niche_variant(enum_);
+
+        write_str(self, " ? ");
+        write_variant_tag(self, enum_, niche == 0 ? 1 : 0);
+        write_str(self, " : ");
+        write_variant_tag(self, enum_, niche);
+    }
+
+    write_str(self,
+              layout && layout->kind == LayoutKindTagged ? ".tag) {\n"
+                                                         : ") {\n");
+
+    for (Usize i = 0; i < term->cases_len; i++) {
+        write_str(self, "        case ");
+
+        if (enum_)
+            write_variant_tag(self, enum_, term->cases[i].value);
+        else
+            write_signed(self, "int64_t", term->cases[i].value);
+
+        write_str(self, ":\n");
+        write_edge(self, &term->cases[i].edge, "            ");
+    }
+
+    write_str(self, "        default:\n");
+    write_edge(self, &term->edges[0], "            ");
+    write_str(self, "    }\n");
+}
+
+static void
+write_term(struct GenerateC *self, const struct IrTerm *term)
+{
+    switch (term->kind) {
+        case IrTermKindJump:
+            write_edge(self, &term->edges[0], "    ");
+            break;
+        case IrTermKindBranch:
+            write_str(self, "    if (");
+            write_reg(self, term->value);
+            write_str(self, ") {\n");
+            write_edge(self, &term->edges[0], "        ");
+            write_str(self, "    }\n");
+            write_edge(self, &term->edges[1], "    ");
+            break;
+        case IrTermKindSwitch:
+            write_switch(self, term);
+            break;
+        case IrTermKindReturn:
+            if (term->value == IR_NONE)
+                write_str(self, "    return;\n");
+            else {
+                write_str(self, "    return ");
+                write_reg(self, term->value);
+                write_str(self, ";\n");
+            }
+
+            break;
+        default:
+            write_str(self, "    __builtin_unreachable();\n");
+    }
+}
+
+static void
+mark_used(bool *used, Usize reg)
+{
+    if (reg != IR_NONE)
+        used[reg] = true;
+}
+
+// The registers are declared at the start of the function, the blocks are
+// labels (the edges jump with goto).
+static void
+write_fun_body(struct GenerateC *self, struct IrFun *fun)
+{
+    bool *used = calloc(fun->regs_len + 1, sizeof(bool));
+    bool *declared = calloc(fun->regs_len + 1, sizeof(bool));
+    bool *targeted = calloc(fun->blocks_len + 1, sizeof(bool));
+
+    self->fun = fun;
+
+    for (Usize i = 0; i < fun->blocks_len; i++) {
+        struct IrBlock *block = &fun->blocks[i];
+
+        for (Usize j = 0; j < block->insts_len; j++) {
+            for (Usize k = 0; k < block->insts[j].args_len; k++)
+                mark_used(used, block->insts[j].args[k]);
+
+            if (block->insts[j].kind == IrInstKindSetField)
+                mark_used(used, block->insts[j].dst);
+        }
+
+        if (block->term.kind == IrTermKindBranch ||
+            block->term.kind == IrTermKindSwitch ||
+            block->term.kind == IrTermKindReturn)
+            mark_used(used, block->term.value);
+
+        for (Usize j = 0; j < get_edges_len__IrTerm(&block->term); j++) {
+            struct IrEdge *edge = get_edge__IrTerm(&block->term, j);
+
+            targeted[edge->block] = true;
+
+            for (Usize k = 0; k < edge->args_len; k++)
+                mark_used(used, edge->args[k]);
+        }
+    }
+
+    write_str(self, "{\n");
+
+    for (Usize i = 1; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].params_len; j++)
+            declared[fun->blocks[i].params[j]] = true;
+
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            Usize dst = fun->blocks[i].insts[j].dst;
+
+            if (dst != IR_NONE && used[dst])
+                declared[dst] = true;
+        }
+
+    for (Usize i = 0; i < fun->regs_len; i++)
+        if (declared[i]) {
+            write_str(self, "    ");
+            write_reg_data_type(self, i);
+            write_str(self, " ");
+            write_reg(self, i);
+            write_str(self, ";\n");
+        }
+
+    // The environments of the closures which do not escape.
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            const struct IrInst *inst = &fun->blocks[i].insts[j];
+
+            if (inst->kind == IrInstKindClosure && inst->args_len &&
+                !inst->value.closure.is_heap)
+                write_string(
+                  self,
+                  format("    struct lily__{S}__env lily_env{d};\n",
+                         self->ir->lambdas[inst->value.closure.lambda].name,
+                         (int)inst->dst));
+        }
+
+    for (Usize i = 0; i < fun->blocks_len; i++) {
+        if (targeted[i]) {
+            write_block_label(self, i);
+            write_str(self, ":;\n");
+        }
+
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            write_inst(self, &fun->blocks[i].insts[j], used);
+
+        write_term(self, &fun->blocks[i].term);
+    }
+
+    write_str(self, "}\n");
+
+    free(used);
+    free(declared);
+    free(targeted);
+}
+
+static void
+write_signature(struct GenerateC *self, struct IrFun *ir, struct String *name)
+{
+    const struct IrBlock *entry = &ir->blocks[0];
+
+    self->fun = ir;
+
+    write_str(self, "static ");
+    write_data_type(self, ir->return_type);
+    write_string(self, format("\nlily__{S}(", name));
+
+    if (entry->params_len == 0)
+        write_str(self, "void");
+
+    for (Usize i = 0; i < entry->params_len; i++) {
+        if (i > 0)
+            write_str(self, ", ");
+
+        write_reg_data_type(self, entry->params[i]);
+        write_str(self, " ");
+        write_reg(self, entry->params[i]);
+    }
+
+    write_str(self, ")");
+}
+
+static inline void
+write_fun_signature(struct GenerateC *self, Usize id)
+{
+    write_signature(
+      self, self->ir->funs[id], get_fun_name__IrModule(self->ir, id));
+}
+
+static void
+write_fun(struct GenerateC *self, Usize id)
+{
+    write_fun_signature(self, id);
+    write_str(self, "\n");
+    write_fun_body(self, self->ir->funs[id]);
+}
+
+// The captured values of a lambda:
+// struct lily__main__lambda0__env { int32_t c0; };
+static void
+write_env_decl(struct GenerateC *self, Usize id)
+{
+    const struct IrLambda *lambda = &self->ir->lambdas[id];
+    const struct IrBlock *entry = &lambda->fun->blocks[0];
+
+    self->fun = lambda->fun;
+
+    write_string(self, format("struct lily__{S}__env\n", lambda->name));
+    write_str(self, "{\n");
+
+    for (Usize i = 0; i < lambda->captures_len; i++) {
+        write_str(self, "    ");
+        write_reg_data_type(self, entry->params[i]);
+        write_string(self, format(" c{d};\n", (int)i));
+    }
+
+    write_str(self, "};\n\n");
+}
+
+// The function of the closures of a lambda takes their environment, then the
+// params of the lambda:
+// static int32_t lily__main__lambda0__closure(void *lily_env, int32_t r1)
+static void
+write_closure_signature(struct GenerateC *self, Usize id)
+{
+    const struct IrLambda *lambda = &self->ir->lambdas[id];
+    const struct IrBlock *entry = &lambda->fun->blocks[0];
+
+    self->fun = lambda->fun;
+
+    write_str(self, "static ");
+    write_data_type(self, lambda->fun->return_type);
+    write_string(
+      self, format("\nlily__{S}__closure(void *lily_env", lambda->name));
+
+    for (Usize i = lambda->captures_len; i < entry->params_len; i++) {
+        write_str(self, ", ");
+        write_reg_data_type(self, entry->params[i]);
+        write_str(self, " ");
+        write_reg(self, entry->params[i]);
+    }
+
+    write_str(self, ")");
+}
+
+// The lambda is a function whose first params are the captured values, the
+// function of its closures unpacks their environment and calls it.
+static void
+write_lambda(struct GenerateC *self, Usize id)
+{
+    const struct IrLambda *lambda = &self->ir->lambdas[id];
+    const struct IrBlock *entry = &lambda->fun->blocks[0];
+
+    write_signature(self, lambda->fun, lambda->name);
+    write_str(self, "\n");
+    write_fun_body(self, lambda->fun);
+    write_str(self, "\n");
+    write_closure_signature(self, id);
+    write_str(self, "\n{\n");
+
+    if (lambda->captures_len)
+        write_string(
+          self,
+          format("    struct lily__{S}__env *lily_e = lily_env;\n",
+                 lambda->name));
+    else
+        write_str(self, "    (void)lily_env;\n");
+
+    write_str(self, lambda->fun->return_type ? "    return " : "    ");
+    write_string(self, format("lily__{S}(", lambda->name));
+
+    for (Usize i = 0; i < entry->params_len; i++) {
+        if (i > 0)
+            write_str(self, ", ");
+
+        if (i < lambda->captures_len)
+            write_string(self, format("lily_e->c{d}", (int)i));
+        else
+            write_reg(self, entry->params[i]);
+    }
+
+    write_str(self, ");\n}\n");
+}
+
+// The value of a constant computed at compile time is static data:
+// { .x = ((int64_t)1LL), .y = ((int64_t)2LL) }
+static void
+write_value(struct GenerateC *self, const struct IrValue *value)
+{
+    if (!value->is_record) {
+        write_literal(self, value->literal);
+        return;
+    } else if (!is_record_supported(self, value->record)) {
+        self->failed = true;
+        return;
+    }
+
+    struct RecordSymbol *record =
+      get__Vec(*self->gen->tc.records, value->record);
+
+    write_str(self, "{ ");
+
+    for (Usize i = 0; i < value->fields_len; i++) {
+        write_string(
+          self,
+          format("{s}.{S} = ",
+                 i > 0 ? ", " : "",
+                 ((struct SymbolTable *)get__Vec(*record->fields, i))
+                   ->value.field->name));
+        write_value(self, &value->fields[i]);
+    }
+
+    write_str(self, " }");
+}
+
+static void
+write_constant(struct GenerateC *self, Usize id)
+{
+    struct ConstantSymbol *constant = get__Vec(*self->gen->tc.consts, id);
+
+    if (!is_known(strip_mut(constant->data_type)) ||
+        is_void(constant->data_type) ||
+        !has_constant__IrModule(self->ir, id)) {
+        self->failed = true;
+        return;
+    }
+
+    // The other constants are initialized at the start of the program, in
+    // the order of their dependencies (see write_main_function).
+    if (self->ir->values[id]) {
+        write_str(self, "__attribute__((unused)) static const ");
+        write_data_type(self, constant->data_type);
+        write_string(self, format(" lily__{S} = ", constant->name));
+        write_value(self, self->ir->values[id]);
+        write_str(self, ";\n");
+    } else {
+        write_str(self, "__attribute__((unused)) static ");
+        write_data_type(self, constant->data_type);
+        write_string(self, format(" lily__{S};\n", constant->name));
+    }
+}
+
+// The value of a constant which is not a literal is computed by a function:
+// static int32_t lily__init__N(void) { ... }
+static void
+write_constant_init(struct GenerateC *self, Usize id)
+{
+    struct ConstantSymbol *constant = get__Vec(*self->gen->tc.consts, id);
+
+    write_constant(self, id);
+
+    if (!self->ir->consts[id])
+        return;
+
+    self->current_const = id;
+
+    write_str(self, "static ");
+    write_data_type(self, constant->data_type);
+    write_string(self, format("\nlily__init__{S}(void)\n", constant->name));
+    write_fun_body(self, self->ir->consts[id]);
+}
+
+// Try to lower the declaration in a buffer: return false if it has no C
+// representation.
+static bool
+try_write(struct GenerateC *self,
+          void (*write)(struct GenerateC *, Usize),
+          Usize id)
+{
+    struct String *output = self->output;
+    struct String *buffer = NEW(String);
+
+    self->output = buffer;
+    self->failed = false;
+
+    write(self, id);
+
+    self->output = output;
+
+    FREE(String, buffer);
+
+    return !self->failed;
+}
+
+// A function is lowered if it has an IR and if its body only calls lowered
+// functions: all the functions with IR are assumed lowered, then the
+// unsupported ones are removed until nothing changes.
+static void
+check_supported(struct GenerateC *self)
+{
+    struct Typecheck *tc = &self->gen->tc;
+    bool changed = true;
+
+    for (Usize i = 0; i < self->ir->funs_len; i++)
+        self->funs_supported[i] = self->ir->funs[i] != NULL;
+
+    for (Usize i = 0; i < get_len(tc->consts); i++)
+        self->consts_supported[i] = has_constant__IrModule(self->ir, i);
+
+    for (Usize i = 0; i < self->ir->lambdas_len; i++)
+        self->lambdas_supported[i] = self->ir->lambdas[i].fun != NULL;
+
+    while (changed) {
+        changed = false;
+
+        for (Usize i = 0; i < self->ir->lambdas_len; i++)
+            if (self->lambdas_supported[i] &&
+                (!try_write(self, &write_env_decl, i) ||
+                 !try_write(self, &write_lambda, i))) {
+                self->lambdas_supported[i] = false;
+                changed = true;
+            }
+
+        for (Usize i = 0; i < get_len(tc->consts); i++)
+            if (self->consts_supported[i] &&
+                !try_write(self, &write_constant_init, i)) {
+                self->consts_supported[i] = false;
+                changed = true;
+            }
+
+        for (Usize i = 0; i < self->ir->funs_len; i++)
+            if (self->funs_supported[i] &&
+                !try_write(self, &write_fun, i)) {
+                self->funs_supported[i] = false;
+                changed = true;
+            }
+    }
+}
+
+static void
+write_custom_decl(struct GenerateC *self, struct DataTypeSymbol *data_type);
+
+// The fields are written in the order of their layout.
+static void
+write_record_decl(struct GenerateC *self, Usize id)
+{
+    struct RecordSymbol *record = get__Vec(*self->gen->tc.records, id);
+    const struct RecordLayout *layout =
+      get_record_layout__LayoutPlanner(&self->layout, id);
+
+    if (self->records_written[id])
+        return;
+
+    self->records_written[id] = true;
+
+    // The records held by value are defined before.
+    for (Usize i = 0; record->fields && i < len__Vec(*record->fields); i++)
+        write_custom_decl(
+          self,
+          ((struct SymbolTable *)get__Vec(*record->fields, i))
+            ->value.field->data_type);
+
+    write_string(self, format("struct lily__{S}\n", record->name));
+    write_str(self, "{\n");
+
+    for (Usize i = 0; record->fields && i < len__Vec(*record->fields); i++) {
+        struct FieldRecordSymbol *field =
+          ((struct SymbolTable *)get__Vec(*record->fields, layout->order[i]))
+            ->value.field;
+
+        write_str(self, "    ");
+        write_data_type(self, field->data_type);
+        write_string(self, format(" {S};\n", field->name));
+    }
+
+    write_str(self, "};\n\n");
+}
+
+// The tags of the variants are constants:
+// enum Color = Red, Green -> typedef uint8_t lily__Color;
+// enum Shape = Circle Float64, Square Float64 -> the tag and the union of the
+// payloads;
+// enum Link = Node &Node, Empty -> typedef lily__Node * lily__Link; (Empty is
+// NULL).
+static void
+write_enum_decl(struct GenerateC *self, Usize id)
+{
+    struct EnumSymbol *enum_ = get__Vec(*self->gen->tc.enums, id);
+    const struct Layout *layout =
+      get_enum_layout__LayoutPlanner(&self->layout, id);
+
+    if (self->enums_written[id])
+        return;
+
+    self->enums_written[id] = true;
+
+    for (Usize i = 0; i < len__Vec(*enum_->variants); i++)
+        write_custom_decl(self,
+                          ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+                            ->value.variant->data_type);
+
+    write_str(self, "enum\n{\n");
+
+    for (Usize i = 0; i < len__Vec(*enum_->variants); i++)
+        write_string(
+          self,
+          format("    lily__{S}__{S},\n",
+                 enum_->name,
+                 ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+                   ->value.variant->name));
+
+    write_str(self, "};\n");
+
+    if (layout->kind == LayoutKindEnum) {
+        write_string(self,
+                     format("typedef {s} lily__{S};\n\n",
+                            get_tag_type__Layout(layout),
+                            enum_->name));
+
+        return;
+    } else if (layout->kind == LayoutKindNiche) {
+        write_str(self, "typedef ");
+        write_data_type(
+          self,
+          ((struct SymbolTable *)get__Vec(
+             *enum_->variants, get_niche_variant(enum_) == 0 ? 1 : 0))
+            ->value.variant->data_type);
+        write_string(self, format(" lily__{S};\n\n", enum_->name));
+
+        return;
+    }
+
+    write_string(self, format("struct lily__{S}\n", enum_->name));
+    write_str(self, "{\n    ");
+    write_str(self, get_tag_type__Layout(layout));
+    write_str(self, " tag;\n    union\n    {\n");
+
+    for (Usize i = 0; i < len__Vec(*enum_->variants); i++) {
+        struct VariantEnumSymbol *variant =
+          ((struct SymbolTable *)get__Vec(*enum_->variants, i))->value.variant;
+
+        if (variant->data_type) {
+            write_str(self, "        ");
+            write_data_type(self, variant->data_type);
+            write_string(self, format(" {S};\n", variant->name));
+        }
+    }
+
+    write_str(self, "    } value;\n};\n\n");
+}
+
+static void
+write_custom_decl(struct GenerateC *self, struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    if (!data_type || data_type->kind != DataTypeKindCustom)
+        return;
+
+    Isize id = search_record(self, data_type->scope);
+
+    if (id != -1) {
+        write_record_decl(self, id);
+        return;
+    }
+
+    id = search_enum(self, data_type->scope);
+
+    if (id != -1)
+        write_enum_decl(self, id);
+}
+
+// The diagnostic is reported at the start of the declaration.
+static void
+emit_not_lowered(struct GenerateC *self,
+                 struct String *name,
+                 struct Location loc,
+                 Str help)
+{
+    loc.e_line = loc.s_line;
+    loc.e_col = loc.s_col;
+
+    emit__Diagnostic(
+      NEW(DiagnosticWithErr,
+          NEW(LilyErrorWithString, LilyErrorNotLoweredToC, format("{S}", name)),
+          loc,
+          self->gen->tc.parser.parse_block.scanner.src->file,
+          from__String(""),
+          Some(from__String(help))));
+
+    self->count_error += 1;
+}
+
+static void
+write_type_decls(struct GenerateC *self)
+{
+    struct Typecheck *tc = &self->gen->tc;
+
+    for (Usize i = 0; i < get_len(tc->records); i++) {
+        struct RecordSymbol *record = get__Vec(*tc->records, i);
+
+        if (!record->generic_params)
+            write_string(
+              self,
+              format("typedef struct lily__{S} lily__{S};\n",
+                     record->name,
+                     record->name));
+    }
+
+    for (Usize i = 0; i < get_len(tc->enums); i++) {
+        struct EnumSymbol *enum_ = get__Vec(*tc->enums, i);
+
+        if (is_enum_supported(self, i) &&
+            get_enum_layout__LayoutPlanner(&self->layout, i)->kind ==
+              LayoutKindTagged)
+            write_string(self,
+                         format("typedef struct lily__{S} lily__{S};\n",
+                                enum_->name,
+                                enum_->name));
+    }
+
+    write_str(self, "\n");
+
+    for (Usize i = 0; i < get_len(tc->enums); i++) {
+        struct EnumSymbol *enum_ = get__Vec(*tc->enums, i);
+
+        if (is_enum_supported(self, i))
+            write_enum_decl(self, i);
+        else if (!enum_->generic_params && enum_->variants)
+            emit_not_lowered(self,
+                             enum_->name,
+                             enum_->enum_decl->loc,
+                             "a variant has a data type without C "
+                             "representation");
+    }
+
+    for (Usize i = 0; i < get_len(tc->records); i++) {
+        struct RecordSymbol *record = get__Vec(*tc->records, i);
+
+        if (is_record_supported(self, i))
+            write_record_decl(self, i);
+        else if (record->generic_params)
+            write_string(
+              self,
+              format("// record {S}: generic, not lowered to C\n\n",
+                     record->name));
+        else
+            emit_not_lowered(self,
+                             record->name,
+                             record->record_decl->loc,
+                             "a field has a data type without C "
+                             "representation (or contains the record)");
+    }
+}
+
+static void
+write_constant_init_in_order(struct GenerateC *self, Usize id, UInt8 *state)
+{
+    Usize len = get_len(self->gen->tc.consts);
+    struct ConstantSymbol *constant = get__Vec(*self->gen->tc.consts, id);
+
+    if (state[id])
+        return;
+
+    state[id] = 1;
+
+    for (Usize i = 0; i < len; i++)
+        if (self->consts_deps[id * len + i])
+            write_constant_init_in_order(self, i, state);
+
+    if (self->ir->consts[id])
+        write_string(self,
+                     format("    lily__{S} = lily__init__{S}();\n",
+                            constant->name,
+                            constant->name));
+}
+
+static void
+write_main_function(struct GenerateC *self)
+{
+    struct Typecheck *tc = &self->gen->tc;
+    Usize consts_len = get_len(tc->consts);
+    struct FunSymbol *main_fun = NULL;
+
+    for (Usize i = 0; i < get_len(tc->funs); i++) {
+        struct FunSymbol *fun = get__Vec(*tc->funs, i);
+        Str name = to_Str__String(*fun->name);
+
+        if (!strcmp(name, "main") && self->funs_supported[i])
+            main_fun = fun;
+
+        free(name);
+    }
+
+    write_str(self, "int\nmain(void)\n{\n");
+
+    // The dependencies of the constants are recorded while their initializer
+    // is written (see run__GenerateC).
+    if (consts_len) {
+        UInt8 *state = calloc(consts_len, sizeof(UInt8));
+
+        for (Usize i = 0; i < consts_len; i++)
+            if (self->consts_supported[i])
+                write_constant_init_in_order(self, i, state);
+
+        free(state);
+    }
+
+    if (!main_fun)
+        write_str(self, "    return 0;\n");
+    else if (is_int(strip_mut(main_fun->return_type)))
+        write_str(self, "    return (int)lily__main();\n");
+    else
+        write_str(self, "    lily__main();\n    return 0;\n");
+
+    write_str(self, "}\n");
 }
 
 void
 run__GenerateC(struct Generate self)
 {
-    write_on_file__Generate(self);
+    struct Typecheck *tc = &self.tc;
+    Usize consts_len = get_len(tc->consts);
+    struct IrModule *ir = self.ir;
+
+    // Without module from the driver, the IR is built with the passes of -O1.
+    if (!ir) {
+        ir = NEW(IrModule, tc);
+        optimize__IrModule(ir, 1, NULL);
+    }
+
+    Usize funs_len = ir->funs_len;
+
+    struct GenerateC gen = {
+        .gen = &self,
+        .ir = ir,
+        .fun = NULL,
+        .output = self.output,
+        .failed = false,
+        .funs_supported = malloc(sizeof(bool) * (funs_len + 1)),
+        .consts_supported = malloc(sizeof(bool) * (consts_len + 1)),
+        .lambdas_supported = malloc(sizeof(bool) * (ir->lambdas_len + 1)),
+        .records_state =
+          calloc(get_len(tc->records) + 1, sizeof(enum TypeDeclState)),
+        .enums_state =
+          calloc(get_len(tc->enums) + 1, sizeof(enum TypeDeclState)),
+        .records_written = calloc(get_len(tc->records) + 1, sizeof(bool)),
+        .enums_written = calloc(get_len(tc->enums) + 1, sizeof(bool)),
+        .layout = NEW(LayoutPlanner, tc),
+        .current_const = 0,
+        .consts_deps = NULL,
+        .count_error = 0
+    };
+
+    check_supported(&gen);
+
+    write_str(&gen, prelude);
+    write_str(&gen, "\n");
+    write_type_decls(&gen);
+
+    for (Usize i = 0; i < ir->lambdas_len; i++)
+        if (gen.lambdas_supported[i] && ir->lambdas[i].captures_len)
+            write_env_decl(&gen, i);
+
+    for (Usize i = 0; i < funs_len; i++)
+        if (gen.funs_supported[i]) {
+            write_str(&gen, "__attribute__((unused)) ");
+            write_fun_signature(&gen, i);
+            write_str(&gen, ";\n");
+        }
+
+    for (Usize i = 0; i < ir->lambdas_len; i++)
+        if (gen.lambdas_supported[i]) {
+            write_str(&gen, "__attribute__((unused)) ");
+            write_signature(&gen, ir->lambdas[i].fun, ir->lambdas[i].name);
+            write_str(&gen, ";\n__attribute__((unused)) ");
+            write_closure_signature(&gen, i);
+            write_str(&gen, ";\n");
+        }
+
+    write_str(&gen, "\n");
+
+    // The dependencies of the constants are recorded for the order of their
+    // initialization.
+    gen.consts_deps =
+      consts_len ? calloc(consts_len * consts_len, sizeof(bool)) : NULL;
+
+    for (Usize i = 0; i < consts_len; i++) {
+        struct ConstantSymbol *constant = get__Vec(*tc->consts, i);
+
+        if (gen.consts_supported[i]) {
+            write_constant_init(&gen, i);
+            write_str(&gen, "\n");
+        } else
+            emit_not_lowered(&gen,
+                             constant->name,
+                             constant->constant_decl->loc,
+                             "the value uses an expression which is not "
+                             "supported by the C generation");
+    }
+
+    for (Usize i = 0; i < funs_len; i++) {
+        struct String *name = get_fun_name__IrModule(ir, i);
+
+        if (gen.funs_supported[i]) {
+            write_fun(&gen, i);
+            write_str(&gen, "\n");
+        } else if (i < ir->file_funs_len && ir->generics[i])
+            write_string(
+              &gen,
+              format("// fun {S}: generic, lowered for each instance\n\n",
+                     name));
+        else if (i >= ir->file_funs_len &&
+                 ir->instances[i - ir->file_funs_len].is_demoted)
+            write_string(
+              &gen,
+              format("// fun {S}: calls the boxed instance\n\n", name));
+        else if (i >= ir->file_funs_len &&
+                 ir->instances[i - ir->file_funs_len].is_boxed)
+            write_string(
+              &gen,
+              format("// fun {S}: not boxed (operates on its generic values)"
+                     "\n\n",
+                     name));
+        else {
+            struct FunSymbol *fun = get__Vec(
+              *tc->funs,
+              i < ir->file_funs_len
+                ? i
+                : ir->instances[i - ir->file_funs_len].fun);
+
+            emit_not_lowered(&gen,
+                             name,
+                             fun->fun_decl->loc,
+                             "the body uses an expression which is not "
+                             "supported by the C generation");
+        }
+    }
+
+    for (Usize i = 0; i < ir->lambdas_len; i++)
+        if (gen.lambdas_supported[i]) {
+            write_lambda(&gen, i);
+            write_str(&gen, "\n");
+        } else if (ir->lambdas[i].fun)
+            emit_not_lowered(&gen,
+                             ir->lambdas[i].name,
+                             ir->lambdas[i].loc,
+                             "the body uses an expression which is not "
+                             "supported by the C generation");
+
+    write_main_function(&gen);
+
+    free(gen.funs_supported);
+    free(gen.consts_supported);
+    free(gen.lambdas_supported);
+    free(gen.records_state);
+    free(gen.enums_state);
+    free(gen.records_written);
+    free(gen.enums_written);
+    free(gen.consts_deps);
+    FREE(LayoutPlanner, gen.layout);
+
+    if (!self.ir)
+        FREE(IrModule, ir);
+
+    if (!gen.count_error)
+        write_on_file__Generate(self);
+}
+
+static bool
+is_record_lowered(void *data, Usize id)
+{
+    return is_record_supported(data, id);
+}
+
+static bool
+is_enum_lowered(void *data, Usize id)
+{
+    return is_enum_supported(data, id);
+}
+
+static bool
+is_lowered(void *data, struct DataTypeSymbol *data_type)
+{
+    struct String *c_type = get_c_type(data, data_type);
+
+    if (!c_type)
+        return false;
+
+    FREE(String, c_type);
+
+    return true;
+}
+
+// The data types are checked like in run__GenerateC, without lowering the
+// functions.
+void
+write_layout__GenerateC(struct Generate self, struct Writer *writer)
+{
+    struct Typecheck *tc = &self.tc;
+    struct GenerateC gen = {
+        .gen = &self,
+        .ir = NULL,
+        .fun = NULL,
+        .output = self.output,
+        .failed = false,
+        .funs_supported = NULL,
+        .consts_supported = NULL,
+        .lambdas_supported = NULL,
+        .records_state =
+          calloc(get_len(tc->records) + 1, sizeof(enum TypeDeclState)),
+        .enums_state =
+          calloc(get_len(tc->enums) + 1, sizeof(enum TypeDeclState)),
+        .records_written = NULL,
+        .enums_written = NULL,
+        .layout = NEW(LayoutPlanner, tc),
+        .current_const = 0,
+        .consts_deps = NULL,
+        .count_error = 0
+    };
+    struct LayoutLowering lowering = { .data = &gen,
+                                       .is_record_lowered = &is_record_lowered,
+                                       .is_enum_lowered = &is_enum_lowered,
+                                       .is_lowered = &is_lowered };
+
+    write__LayoutPlanner(&gen.layout, writer, &lowering);
+
+    free(gen.records_state);
+    free(gen.enums_state);
+    FREE(LayoutPlanner, gen.layout);
 }
@@ -25,12 +25,17 @@
 #ifndef LILY_GENERATE_C_H
 #define LILY_GENERATE_C_H
 
+#include <base/writer.h>
 #include <lang/generate/generate.h>
 
 void
-write_main_function(struct Generate *self);
+run__GenerateC(struct Generate self);
 
+/**
+ *
+ * @brief Print the layout of the data types lowered to C (--emit=layout).
+ */
 void
-run__GenerateC(struct Generate self);
+write_layout__GenerateC(struct Generate self, struct Writer *writer);
 
 #endif // LILY_GENERATE_C_H
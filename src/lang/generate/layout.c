@@ -0,0 +1,675 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <lang/generate/layout.h>
+#include <lang/ir/mono.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+enum
+{
+    LayoutStateUnplanned = 0,
+    LayoutStatePlanning,
+    LayoutStatePlanned
+};
+
+// The declarations of a file without declaration of this kind are NULL.
+static inline Usize
+get_len(struct Vec *decls)
+{
+    return decls ? len__Vec(*decls) : 0;
+}
+
+static inline struct DataTypeSymbol *
+strip_mut(struct DataTypeSymbol *data_type)
+{
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    return data_type;
+}
+
+static inline Usize
+align_up(Usize offset, Usize align)
+{
+    return align > 1 ? (offset + align - 1) / align * align : offset;
+}
+
+static inline struct Layout
+scalar(Usize size, Usize align)
+{
+    return (struct Layout){ .kind = LayoutKindScalar,
+                            .size = size,
+                            .align = align,
+                            .tag_size = 0,
+                            .payload_offset = 0,
+                            .niche = 0 };
+}
+
+static inline struct Layout
+unknown()
+{
+    return (struct Layout){ .kind = LayoutKindUnknown,
+                            .size = 0,
+                            .align = 1,
+                            .tag_size = 0,
+                            .payload_offset = 0,
+                            .niche = 0 };
+}
+
+// The smallest unsigned integer which holds the values 0 to count - 1.
+static inline Usize
+get_tag_size(Usize count)
+{
+    return count <= 0x100 ? 1 : count <= 0x10000 ? 2 : 4;
+}
+
+static inline bool
+is_top_level(struct Scope *scope, struct Scope *symbol_scope)
+{
+    return symbol_scope && !symbol_scope->previous &&
+           eq__String(scope->name, symbol_scope->name, false);
+}
+
+struct LayoutPlanner
+__new__LayoutPlanner(struct Typecheck *tc)
+{
+    Usize records_len = get_len(tc->records);
+    Usize enums_len = get_len(tc->enums);
+
+    return (struct LayoutPlanner){
+        .tc = tc,
+        .records = calloc(records_len + 1, sizeof(struct RecordLayout)),
+        .enums = calloc(enums_len + 1, sizeof(struct Layout)),
+        .records_state = calloc(records_len + 1, sizeof(UInt8)),
+        .enums_state = calloc(enums_len + 1, sizeof(UInt8))
+    };
+}
+
+Isize
+search_record__LayoutPlanner(const struct LayoutPlanner *self,
+                             struct Scope *scope)
+{
+    if (!scope || scope->item_kind != ScopeItemKindRecord)
+        return -1;
+
+    for (Usize i = 0; i < get_len(self->tc->records); i++)
+        if (is_top_level(
+              scope,
+              ((struct RecordSymbol *)get__Vec(*self->tc->records, i))->scope))
+            return i;
+
+    return -1;
+}
+
+Isize
+search_enum__LayoutPlanner(const struct LayoutPlanner *self,
+                           struct Scope *scope)
+{
+    if (!scope || scope->item_kind != ScopeItemKindEnum)
+        return -1;
+
+    for (Usize i = 0; i < get_len(self->tc->enums); i++)
+        if (is_top_level(
+              scope,
+              ((struct EnumSymbol *)get__Vec(*self->tc->enums, i))->scope))
+            return i;
+
+    return -1;
+}
+
+// The fields are stable sorted by alignment (the largest first): the
+// alignments are powers of two, so each field starts right after the previous
+// one and the only padding is at the end.
+const struct RecordLayout *
+get_record_layout__LayoutPlanner(struct LayoutPlanner *self, Usize id)
+{
+    struct RecordLayout *record_layout = &self->records[id];
+
+    switch (self->records_state[id]) {
+        case LayoutStatePlanned:
+            return record_layout;
+        case LayoutStatePlanning:
+            // The record contains itself by value.
+            record_layout->layout = unknown();
+            return record_layout;
+        default:
+            break;
+    }
+
+    struct RecordSymbol *record = get__Vec(*self->tc->records, id);
+    Usize len = get_len(record->fields);
+    struct Layout *fields = malloc(sizeof(struct Layout) * (len + 1));
+    bool is_known = !record->generic_params;
+
+    self->records_state[id] = LayoutStatePlanning;
+    record_layout->order = malloc(sizeof(Usize) * (len + 1));
+    record_layout->offsets = malloc(sizeof(Usize) * (len + 1));
+
+    for (Usize i = 0; i < len; i++) {
+        fields[i] = get_layout__LayoutPlanner(
+          self,
+          ((struct SymbolTable *)get__Vec(*record->fields, i))
+            ->value.field->data_type);
+        is_known = is_known && fields[i].kind != LayoutKindUnknown;
+        record_layout->order[i] = i;
+    }
+
+    if (!record->record_decl->value.record->is_repr_c)
+        for (Usize i = 1; i < len; i++) {
+            Usize field = record_layout->order[i];
+            Usize j = i;
+
+            for (; j > 0 &&
+                   fields[record_layout->order[j - 1]].align <
+                     fields[field].align;
+                 j--)
+                record_layout->order[j] = record_layout->order[j - 1];
+
+            record_layout->order[j] = field;
+        }
+
+    Usize offset = 0;
+    Usize align = 1;
+
+    for (Usize i = 0; i < len; i++) {
+        struct Layout *field = &fields[record_layout->order[i]];
+
+        offset = align_up(offset, field->align);
+        record_layout->offsets[record_layout->order[i]] = offset;
+        offset += field->size;
+
+        if (field->align > align)
+            align = field->align;
+    }
+
+    // A record which contains itself is unknown, even if it was planned as
+    // known while it was planning.
+    if (is_known && record_layout->layout.kind != LayoutKindUnknown)
+        record_layout->layout =
+          (struct Layout){ .kind = LayoutKindRecord,
+                           .size = align_up(offset, align),
+                           .align = align,
+                           .tag_size = 0,
+                           .payload_offset = 0,
+                           .niche = 0 };
+    else
+        record_layout->layout = unknown();
+
+    self->records_state[id] = LayoutStatePlanned;
+
+    free(fields);
+
+    return record_layout;
+}
+
+const struct Layout *
+get_enum_layout__LayoutPlanner(struct LayoutPlanner *self, Usize id)
+{
+    struct Layout *layout = &self->enums[id];
+
+    switch (self->enums_state[id]) {
+        case LayoutStatePlanned:
+            return layout;
+        case LayoutStatePlanning:
+            *layout = unknown();
+            return layout;
+        default:
+            break;
+    }
+
+    struct EnumSymbol *enum_ = get__Vec(*self->tc->enums, id);
+    Usize len = get_len(enum_->variants);
+    Usize tag_size = get_tag_size(len);
+    Usize payload_size = 0;
+    Usize payload_align = 1;
+    Usize payloads_len = 0;
+    struct DataTypeSymbol *payload = NULL;
+    bool is_known = !enum_->generic_params;
+
+    self->enums_state[id] = LayoutStatePlanning;
+    layout->kind = LayoutKindEnum;
+
+    for (Usize i = 0; i < len; i++) {
+        struct DataTypeSymbol *data_type =
+          ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+            ->value.variant->data_type;
+
+        if (!data_type)
+            continue;
+
+        struct Layout variant = get_layout__LayoutPlanner(self, data_type);
+
+        is_known = is_known && variant.kind != LayoutKindUnknown;
+        payload = data_type;
+        payloads_len++;
+
+        if (variant.size > payload_size)
+            payload_size = variant.size;
+
+        if (variant.align > payload_align)
+            payload_align = variant.align;
+    }
+
+    if (!is_known || layout->kind == LayoutKindUnknown)
+        *layout = unknown();
+    else if (!payloads_len)
+        *layout = (struct Layout){ .kind = LayoutKindEnum,
+                                   .size = tag_size,
+                                   .align = tag_size,
+                                   .tag_size = tag_size,
+                                   .payload_offset = 0,
+                                   .niche = 0 };
+    else if (len == 2 && payloads_len == 1 && has_null_niche(payload))
+        *layout = (struct Layout){ .kind = LayoutKindNiche,
+                                   .size = payload_size,
+                                   .align = payload_align,
+                                   .tag_size = 0,
+                                   .payload_offset = 0,
+                                   .niche = 0 };
+    else {
+        Usize align = payload_align > tag_size ? payload_align : tag_size;
+        Usize payload_offset = align_up(tag_size, payload_align);
+
+        *layout =
+          (struct Layout){ .kind = LayoutKindTagged,
+                           .size = align_up(payload_offset + payload_size,
+                                            align),
+                           .align = align,
+                           .tag_size = tag_size,
+                           .payload_offset = payload_offset,
+                           .niche = 0 };
+    }
+
+    self->enums_state[id] = LayoutStatePlanned;
+
+    return layout;
+}
+
+struct Layout
+get_layout__LayoutPlanner(struct LayoutPlanner *self,
+                          struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    if (!data_type)
+        return scalar(0, 1);
+
+    switch (data_type->kind) {
+        case DataTypeKindI8:
+        case DataTypeKindU8:
+        case DataTypeKindBitChar:
+        case DataTypeKindBool:
+        case DataTypeKindChar:
+            return scalar(1, 1);
+        case DataTypeKindI16:
+        case DataTypeKindU16:
+            return scalar(2, 2);
+        case DataTypeKindI32:
+        case DataTypeKindU32:
+        case DataTypeKindF32:
+            return scalar(4, 4);
+        case DataTypeKindI64:
+        case DataTypeKindU64:
+            return scalar(sizeof(Int64), alignof(Int64));
+        case DataTypeKindF64:
+            return scalar(sizeof(double), alignof(double));
+        case DataTypeKindI128:
+        case DataTypeKindU128:
+            return scalar(sizeof(__int128), alignof(__int128));
+        case DataTypeKindIsize:
+        case DataTypeKindUsize:
+        case DataTypeKindStr:
+        case DataTypeKindPtr:
+        case DataTypeKindRef:
+            return scalar(sizeof(void *), alignof(void *));
+        case DataTypeKindUnit:
+        case DataTypeKindNever:
+            return scalar(0, 1);
+        // LilyClosure: the function and the environment.
+        case DataTypeKindLambda:
+            return scalar(2 * sizeof(void *), alignof(void *));
+        // LilyBox: the largest member is 8 bytes.
+        case DataTypeKindCompilerDefined:
+            return scalar(sizeof(Int64), alignof(Int64));
+        case DataTypeKindOptional: {
+            struct DataTypeSymbol *value = strip_mut(data_type->value.optional);
+            struct Layout layout = get_layout__LayoutPlanner(self, value);
+
+            if (layout.kind == LayoutKindUnknown)
+                return layout;
+
+            if (has_null_niche(value)) {
+                layout.kind = LayoutKindNiche;
+                layout.niche = 0;
+
+                return layout;
+            }
+
+            // The first value which is not a variant.
+            if (layout.kind == LayoutKindEnum) {
+                Isize id = search_enum__LayoutPlanner(self, value->scope);
+
+                layout.niche =
+                  get_len(((struct EnumSymbol *)get__Vec(*self->tc->enums, id))
+                            ->variants);
+
+                if (layout.niche < ((Usize)1 << (8 * layout.tag_size))) {
+                    layout.kind = LayoutKindNiche;
+
+                    return layout;
+                }
+            }
+
+            Usize payload_offset = align_up(1, layout.align);
+
+            return (struct Layout){ .kind = LayoutKindOptional,
+                                    .size = align_up(payload_offset +
+                                                       layout.size,
+                                                     layout.align),
+                                    .align = layout.align,
+                                    .tag_size = 1,
+                                    .payload_offset = payload_offset,
+                                    .niche = 0 };
+        }
+        case DataTypeKindCustom: {
+            if (is_generic__DataTypeSymbol(data_type))
+                return scalar(sizeof(Int64), alignof(Int64));
+
+            Isize id = search_record__LayoutPlanner(self, data_type->scope);
+
+            if (id != -1)
+                return get_record_layout__LayoutPlanner(self, id)->layout;
+
+            id = search_enum__LayoutPlanner(self, data_type->scope);
+
+            if (id != -1)
+                return *get_enum_layout__LayoutPlanner(self, id);
+
+            return unknown();
+        }
+        default:
+            return unknown();
+    }
+}
+
+Str
+get_tag_type__Layout(const struct Layout *self)
+{
+    switch (self->tag_size) {
+        case 1:
+            return "uint8_t";
+        case 2:
+            return "uint16_t";
+        default:
+            return "uint32_t";
+    }
+}
+
+bool
+has_null_niche(struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    return data_type && (data_type->kind == DataTypeKindRef ||
+                         data_type->kind == DataTypeKindStr);
+}
+
+static void
+write_size(struct Writer *writer, const struct Layout *layout)
+{
+    write_str__Writer(writer, "size ");
+    write_uint__Writer(writer, layout->size);
+    write_str__Writer(writer, ", align ");
+    write_uint__Writer(writer, layout->align);
+}
+
+static void
+write_tag(struct Writer *writer, const struct Layout *layout)
+{
+    write_str__Writer(writer, ", tag Uint");
+    write_uint__Writer(writer, 8 * layout->tag_size);
+}
+
+// ?&Point: size 8, align 8, none = NULL
+// ?Color: size 1, align 1, none = 3
+// ?Int64: size 16, align 8, flag Uint8, value at 8
+static void
+write_optional(struct LayoutPlanner *self,
+               struct Writer *writer,
+               struct DataTypeSymbol *data_type)
+{
+    struct Layout layout = get_layout__LayoutPlanner(self, data_type);
+
+    write__DataTypeSymbol(writer, data_type);
+    write_str__Writer(writer, ": ");
+
+    switch (layout.kind) {
+        case LayoutKindNiche:
+            write_size(writer, &layout);
+            write_str__Writer(writer, ", none = ");
+
+            if (has_null_niche(strip_mut(data_type)->value.optional))
+                write_str__Writer(writer, "NULL");
+            else
+                write_uint__Writer(writer, layout.niche);
+
+            break;
+        case LayoutKindOptional:
+            write_size(writer, &layout);
+            write_str__Writer(writer, ", flag Uint8, value at ");
+            write_uint__Writer(writer, layout.payload_offset);
+            break;
+        default:
+            write_str__Writer(writer, "unknown");
+    }
+
+    write_char__Writer(writer, '\n');
+}
+
+// The optional data types are reported once (they are interned).
+static void
+collect_optional(struct DataTypeSymbol *data_type,
+                 struct DataTypeSymbol ***optionals,
+                 Usize *len)
+{
+    data_type = strip_mut(data_type);
+
+    if (!data_type || data_type->kind != DataTypeKindOptional)
+        return;
+
+    for (Usize i = 0; i < *len; i++)
+        if ((*optionals)[i] == data_type)
+            return;
+
+    *optionals =
+      realloc(*optionals, sizeof(struct DataTypeSymbol *) * (*len + 1));
+    (*optionals)[(*len)++] = data_type;
+}
+
+// record Point: size 16, align 8
+//     y Int64: offset 0
+//     x Int32: offset 8
+static void
+write_record(struct LayoutPlanner *self, struct Writer *writer, Usize id)
+{
+    struct RecordSymbol *record = get__Vec(*self->tc->records, id);
+    const struct RecordLayout *layout =
+      get_record_layout__LayoutPlanner(self, id);
+
+    write_str__Writer(writer, "record ");
+    write_String__Writer(writer, record->name);
+
+    if (record->record_decl->value.record->is_repr_c)
+        write_str__Writer(writer, " #repr_c");
+
+    write_str__Writer(writer, ": ");
+
+    if (layout->layout.kind == LayoutKindUnknown) {
+        write_str__Writer(writer, "unknown\n\n");
+        return;
+    }
+
+    write_size(writer, &layout->layout);
+    write_char__Writer(writer, '\n');
+
+    for (Usize i = 0; i < get_len(record->fields); i++) {
+        struct FieldRecordSymbol *field =
+          ((struct SymbolTable *)get__Vec(*record->fields, layout->order[i]))
+            ->value.field;
+
+        write_str__Writer(writer, "    ");
+        write_String__Writer(writer, field->name);
+        write_char__Writer(writer, ' ');
+        write__DataTypeSymbol(writer, field->data_type);
+        write_str__Writer(writer, ": offset ");
+        write_uint__Writer(writer, layout->offsets[layout->order[i]]);
+        write_char__Writer(writer, '\n');
+    }
+
+    write_char__Writer(writer, '\n');
+}
+
+// enum Color: size 1, align 1, tag Uint8
+// enum Shape: size 8, align 4, tag Uint8, payload at 4
+// enum Link: size 8, align 8, Empty = NULL
+static void
+write_enum(struct LayoutPlanner *self, struct Writer *writer, Usize id)
+{
+    struct EnumSymbol *enum_ = get__Vec(*self->tc->enums, id);
+    const struct Layout *layout = get_enum_layout__LayoutPlanner(self, id);
+
+    write_str__Writer(writer, "enum ");
+    write_String__Writer(writer, enum_->name);
+    write_str__Writer(writer, ": ");
+
+    switch (layout->kind) {
+        case LayoutKindEnum:
+            write_size(writer, layout);
+            write_tag(writer, layout);
+            break;
+        case LayoutKindTagged:
+            write_size(writer, layout);
+            write_tag(writer, layout);
+            write_str__Writer(writer, ", payload at ");
+            write_uint__Writer(writer, layout->payload_offset);
+            break;
+        case LayoutKindNiche:
+            write_size(writer, layout);
+
+            for (Usize i = 0; i < get_len(enum_->variants); i++) {
+                struct VariantEnumSymbol *variant =
+                  ((struct SymbolTable *)get__Vec(*enum_->variants, i))
+                    ->value.variant;
+
+                if (!variant->data_type) {
+                    write_str__Writer(writer, ", ");
+                    write_String__Writer(writer, variant->name);
+                    write_str__Writer(writer, " = NULL");
+                }
+            }
+
+            break;
+        default:
+            write_str__Writer(writer, "unknown");
+    }
+
+    write_str__Writer(writer, "\n\n");
+}
+
+void
+write__LayoutPlanner(struct LayoutPlanner *self,
+                     struct Writer *writer,
+                     const struct LayoutLowering *lowering)
+{
+    struct Typecheck *tc = self->tc;
+    struct DataTypeSymbol **optionals = NULL;
+    Usize optionals_len = 0;
+
+    for (Usize i = 0; i < get_len(tc->records); i++) {
+        struct RecordSymbol *record = get__Vec(*tc->records, i);
+
+        if (!lowering->is_record_lowered(lowering->data, i))
+            continue;
+
+        write_record(self, writer, i);
+
+        for (Usize j = 0; j < get_len(record->fields); j++)
+            collect_optional(
+              ((struct SymbolTable *)get__Vec(*record->fields, j))
+                ->value.field->data_type,
+              &optionals,
+              &optionals_len);
+    }
+
+    for (Usize i = 0; i < get_len(tc->enums); i++) {
+        struct EnumSymbol *enum_ = get__Vec(*tc->enums, i);
+
+        if (!lowering->is_enum_lowered(lowering->data, i))
+            continue;
+
+        write_enum(self, writer, i);
+
+        for (Usize j = 0; j < get_len(enum_->variants); j++)
+            collect_optional(
+              ((struct SymbolTable *)get__Vec(*enum_->variants, j))
+                ->value.variant->data_type,
+              &optionals,
+              &optionals_len);
+    }
+
+    for (Usize i = 0; i < get_len(tc->funs); i++) {
+        struct FunSymbol *fun = get__Vec(*tc->funs, i);
+
+        for (Usize j = 0; j < get_len(fun->params); j++)
+            collect_optional(
+              ((struct FunParamSymbol *)get__Vec(*fun->params, j))
+                ->param_data_type->items[0],
+              &optionals,
+              &optionals_len);
+
+        collect_optional(fun->return_type, &optionals, &optionals_len);
+    }
+
+    for (Usize i = 0; i < optionals_len; i++)
+        if (lowering->is_lowered(lowering->data, optionals[i]))
+            write_optional(self, writer, optionals[i]);
+
+    free(optionals);
+}
+
+void
+__free__LayoutPlanner(struct LayoutPlanner self)
+{
+    for (Usize i = 0; i < get_len(self.tc->records); i++) {
+        free(self.records[i].order);
+        free(self.records[i].offsets);
+    }
+
+    free(self.records);
+    free(self.enums);
+    free(self.records_state);
+    free(self.enums_state);
+}
@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_GENERATE_LAYOUT_H
+#define LILY_GENERATE_LAYOUT_H
+
+#include <base/writer.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/typecheck.h>
+
+// The layout of the data types in the generated C (the sizes are those of the
+// C compiler which builds the compiler):
+// - the tag of an enum is the smallest unsigned integer which holds all its
+//   variants, an enum without payload is its tag;
+// - an enum with payload is its tag and the union of its payloads, except an
+//   enum of two variants whose payload can't be NULL (&T or Str): the variant
+//   without payload is NULL (the niche of the payload);
+// - ?T is T when T has a niche (NULL for &T and Str, the first unused tag for
+//   an enum without payload), otherwise a flag and the value. ?*T has no
+//   niche since nil is a valid pointer;
+// - the fields of a record are sorted by alignment (the largest first) to
+//   remove the padding between them, unless the record is tagged #repr_c.
+
+enum LayoutKind
+{
+    LayoutKindScalar, // integer, float, Bool, Char, Str, pointer, closure, ...
+    LayoutKindRecord,
+    LayoutKindEnum,     // enum without payload (its tag)
+    LayoutKindTagged,   // tag and union of the payloads
+    LayoutKindNiche,    // the value without payload is the niche of the payload
+    LayoutKindOptional, // flag and value
+    LayoutKindUnknown   // no layout (generic, record which contains itself)
+};
+
+typedef struct Layout
+{
+    enum LayoutKind kind;
+    Usize size;
+    Usize align;
+    Usize tag_size;       // Enum, Tagged, Optional
+    Usize payload_offset; // Tagged, Optional
+    Usize niche;          // Niche: the value without payload (0 for NULL)
+} Layout;
+
+typedef struct RecordLayout
+{
+    struct Layout layout;
+    Usize *order;   // Usize* (the index of the fields in memory order)
+    Usize *offsets; // Usize* (the offset of each field)
+} RecordLayout;
+
+// Tell which data types are lowered to C (see write_layout__GenerateC).
+typedef struct LayoutLowering
+{
+    void *data;
+    bool (*is_record_lowered)(void *data, Usize id);
+    bool (*is_enum_lowered)(void *data, Usize id);
+    bool (*is_lowered)(void *data, struct DataTypeSymbol *data_type);
+} LayoutLowering;
+
+typedef struct LayoutPlanner
+{
+    struct Typecheck *tc;         // struct Typecheck&
+    struct RecordLayout *records; // struct RecordLayout* (one per record)
+    struct Layout *enums;         // struct Layout* (one per enum)
+    UInt8 *records_state;         // 0: not planned, 1: planning, 2: planned
+    UInt8 *enums_state;
+} LayoutPlanner;
+
+/**
+ *
+ * @brief Construct the LayoutPlanner type, the layouts are planned on demand.
+ */
+struct LayoutPlanner
+__new__LayoutPlanner(struct Typecheck *tc);
+
+/**
+ *
+ * @return the id of the record (or of the enum) declared in the scope, -1 if
+ * the scope is not a record (or an enum) of the file.
+ */
+Isize
+search_record__LayoutPlanner(const struct LayoutPlanner *self,
+                             struct Scope *scope);
+
+Isize
+search_enum__LayoutPlanner(const struct LayoutPlanner *self,
+                           struct Scope *scope);
+
+/**
+ *
+ * @return the layout of the record.
+ */
+const struct RecordLayout *
+get_record_layout__LayoutPlanner(struct LayoutPlanner *self, Usize id);
+
+/**
+ *
+ * @return the layout of the enum.
+ */
+const struct Layout *
+get_enum_layout__LayoutPlanner(struct LayoutPlanner *self, Usize id);
+
+/**
+ *
+ * @return the layout of the data type.
+ */
+struct Layout
+get_layout__LayoutPlanner(struct LayoutPlanner *self,
+                          struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @return the C type of the tag (uint8_t, uint16_t or uint32_t).
+ */
+Str
+get_tag_type__Layout(const struct Layout *self);
+
+/**
+ *
+ * @return true if the value of the data type is never NULL (&T, Str).
+ */
+bool
+has_null_niche(struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @brief Print the layout of the records, of the enums and of the optional
+ * data types of their fields and of the signatures (--emit=layout). Only the
+ * data types lowered to C are printed: the others have no layout in the
+ * generated C.
+ */
+void
+write__LayoutPlanner(struct LayoutPlanner *self,
+                     struct Writer *writer,
+                     const struct LayoutLowering *lowering);
+
+/**
+ *
+ * @brief Free the LayoutPlanner type.
+ */
+void
+__free__LayoutPlanner(struct LayoutPlanner self);
+
+#endif // LILY_GENERATE_LAYOUT_H
@@ -0,0 +1,225 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/ir/closure.h>
+#include <stdlib.h>
+
+static void
+mark_used(const struct IrFun *fun, bool *used)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            if (fun->blocks[i].insts[j].kind == IrInstKindClosure)
+                used[fun->blocks[i].insts[j].value.closure.lambda] = true;
+}
+
+// A lambda is added before the lambdas of its body, so they are visited after
+// it.
+void
+remove_unused_lambdas__IrModule(struct IrModule *self)
+{
+    bool *used = calloc(self->lambdas_len + 1, sizeof(bool));
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            mark_used(self->funs[i], used);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            mark_used(self->consts[i], used);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (!self->lambdas[i].fun)
+            continue;
+        else if (used[i])
+            mark_used(self->lambdas[i].fun, used);
+        else {
+            FREE(IrFun, self->lambdas[i].fun);
+            self->lambdas[i].fun = NULL;
+        }
+
+    free(used);
+}
+
+static inline void
+escape(bool *escapes, Usize reg, bool *changed)
+{
+    if (reg != IR_NONE && !escapes[reg]) {
+        escapes[reg] = true;
+        *changed = true;
+    }
+}
+
+// The registers of the function which escape. params has the escaping params
+// of each function of the module (NULL if the function is not lowered).
+static bool *
+compute_escapes(const struct IrFun *fun, bool **params)
+{
+    bool *escapes = calloc(fun->regs_len + 1, sizeof(bool));
+    bool changed = true;
+
+    // A value escapes through the copies and the closures which capture it,
+    // the function is visited until nothing changes.
+    while (changed) {
+        changed = false;
+
+        for (Usize i = 0; i < fun->blocks_len; i++) {
+            const struct IrBlock *block = &fun->blocks[i];
+
+            for (Usize j = 0; j < block->insts_len; j++) {
+                const struct IrInst *inst = &block->insts[j];
+
+                switch (inst->kind) {
+                    case IrInstKindCopy:
+                    case IrInstKindClosure:
+                        if (inst->dst != IR_NONE && escapes[inst->dst])
+                            for (Usize k = 0; k < inst->args_len; k++)
+                                escape(escapes, inst->args[k], &changed);
+
+                        break;
+                    case IrInstKindCall: {
+                        const bool *callee = params[inst->value.fun];
+
+                        for (Usize k = 0; k < inst->args_len; k++)
+                            if (!callee || callee[k])
+                                escape(escapes, inst->args[k], &changed);
+
+                        break;
+                    }
+                    case IrInstKindCallClosure:
+                        for (Usize k = 1; k < inst->args_len; k++)
+                            escape(escapes, inst->args[k], &changed);
+
+                        break;
+                    case IrInstKindPrint:
+                    case IrInstKindUnary:
+                    case IrInstKindBinary:
+                    case IrInstKindField:
+                    case IrInstKindPayload:
+                        break;
+                    default:
+                        for (Usize k = 0; k < inst->args_len; k++)
+                            escape(escapes, inst->args[k], &changed);
+                }
+            }
+
+            struct IrTerm *term = (struct IrTerm *)&block->term;
+
+            if (term->kind == IrTermKindReturn)
+                escape(escapes, term->value, &changed);
+
+            // A block param can receive the closure of a previous iteration
+            // of a loop, whose environment is overwritten.
+            for (Usize j = 0; j < get_edges_len__IrTerm(term); j++) {
+                const struct IrEdge *edge = get_edge__IrTerm(term, j);
+
+                for (Usize k = 0; k < edge->args_len; k++)
+                    escape(escapes, edge->args[k], &changed);
+            }
+        }
+    }
+
+    return escapes;
+}
+
+static Usize
+mark_closures(struct IrFun *fun, bool **params)
+{
+    bool *escapes = compute_escapes(fun, params);
+    Usize stack = 0;
+
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            struct IrInst *inst = &fun->blocks[i].insts[j];
+
+            if (inst->kind != IrInstKindClosure)
+                continue;
+
+            inst->value.closure.is_heap =
+              inst->dst == IR_NONE || escapes[inst->dst];
+            stack += !inst->value.closure.is_heap;
+        }
+
+    free(escapes);
+
+    return stack;
+}
+
+Usize
+mark_escaping_closures__IrModule(struct IrModule *self)
+{
+    bool **params = calloc(self->funs_len + 1, sizeof(bool *));
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            params[i] =
+              calloc(self->funs[i]->blocks[0].params_len + 1, sizeof(bool));
+
+    // The params of a function escape if they escape in its body, which
+    // depends on the params of its callees (until nothing changes).
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (Usize i = 0; i < self->funs_len; i++) {
+            if (!self->funs[i])
+                continue;
+
+            bool *escapes = compute_escapes(self->funs[i], params);
+            const struct IrBlock *entry = &self->funs[i]->blocks[0];
+
+            for (Usize j = 0; j < entry->params_len; j++)
+                if (escapes[entry->params[j]] && !params[i][j]) {
+                    params[i][j] = true;
+                    changed = true;
+                }
+
+            free(escapes);
+        }
+    }
+
+    Usize stack = 0;
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            stack += mark_closures(self->funs[i], params);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            stack += mark_closures(self->consts[i], params);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            stack += mark_closures(self->lambdas[i].fun, params);
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        free(params[i]);
+
+    free(params);
+
+    return stack;
+}
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IR_CLOSURE_H
+#define LILY_IR_CLOSURE_H
+
+#include <lang/ir/ir.h>
+
+// A closure holds a lambda and the environment of its captured values. The
+// environment of a closure which does not escape the function where it's
+// created is allocated in the frame of the function: the closure is only
+// called, passed to a param which does not escape or captured by a closure
+// which does not escape. A closure escapes if it's returned, stored (in a
+// record, a variant, a box or the environment of an escaping closure), passed
+// to a block param or to a closure, since the callee is not known.
+
+/**
+ *
+ * @brief Free the lambdas which are not used by a function, a constant or a
+ * used lambda (all their closures are removed or inlined).
+ */
+void
+remove_unused_lambdas__IrModule(struct IrModule *self);
+
+/**
+ *
+ * @brief Compute which closures of the module escape (see above) and allocate
+ * the environment of the others on the stack.
+ * @return the number of closures whose environment is on the stack.
+ */
+Usize
+mark_escaping_closures__IrModule(struct IrModule *self);
+
+#endif // LILY_IR_CLOSURE_H
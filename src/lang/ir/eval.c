@@ -0,0 +1,527 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <base/format.h>
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/option.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/diagnostic/diagnostic.h>
+#include <lang/ir/eval.h>
+#include <stdlib.h>
+
+// The constants are computed by running their initializer on the IR: a
+// register holds a literal or a record, the control flow follows the taken
+// edges. The operators have the semantics of the generated C (see
+// fold__IrInst), so a constant has the same value at compile time and at run
+// time.
+
+typedef struct IrEvaluator
+{
+    const struct IrModule *module; // struct IrModule&
+    Usize steps;
+    Usize depth;
+    Str panic; // Str& (the reason of the panic)
+} IrEvaluator;
+
+static struct IrValue *
+new_literal(struct LiteralSymbol literal)
+{
+    struct IrValue *self = malloc(sizeof(struct IrValue));
+
+    *self = (struct IrValue){ .is_record = false, .literal = literal };
+
+    return self;
+}
+
+static void
+set_reg(struct IrValue **regs, Usize reg, struct IrValue *value)
+{
+    if (regs[reg])
+        FREE(IrValue, regs[reg]);
+
+    regs[reg] = value;
+}
+
+static Isize
+get_field_index(const struct IrModule *module,
+                const struct IrValue *value,
+                struct String *name)
+{
+    struct RecordSymbol *record =
+      get__Vec(*module->tc->records, value->record);
+
+    for (Usize i = 0; i < value->fields_len; i++)
+        if (eq__String(((struct SymbolTable *)get__Vec(*record->fields, i))
+                         ->value.field->name,
+                       name,
+                       false))
+            return i;
+
+    return -1;
+}
+
+// Replace the field of the record by a copy of value.
+static void
+set_field(struct IrValue *record, Usize id, const struct IrValue *value)
+{
+    struct IrValue *old = malloc(sizeof(struct IrValue));
+    struct IrValue *new = clone__IrValue(value);
+
+    *old = record->fields[id];
+    record->fields[id] = *new;
+
+    FREE(IrValue, old);
+    free(new);
+}
+
+static bool
+is_zero(struct LiteralSymbol literal)
+{
+    switch (literal.kind) {
+        case LiteralSymbolKindInt8:
+            return literal.value.int8 == 0;
+        case LiteralSymbolKindInt16:
+            return literal.value.int16 == 0;
+        case LiteralSymbolKindInt32:
+            return literal.value.int32 == 0;
+        case LiteralSymbolKindInt64:
+            return literal.value.int64 == 0;
+        case LiteralSymbolKindUint8:
+            return literal.value.uint8 == 0;
+        case LiteralSymbolKindUint16:
+            return literal.value.uint16 == 0;
+        case LiteralSymbolKindUint32:
+            return literal.value.uint32 == 0;
+        case LiteralSymbolKindUint64:
+            return literal.value.uint64 == 0;
+        default:
+            return false;
+    }
+}
+
+static Str
+get_panic_reason(const struct IrInst *inst, const struct IrValue *y)
+{
+    switch (inst->value.op) {
+        case IrOpDiv:
+        case IrOpMod:
+            return is_zero(y->literal) ? "division by zero" : "overflow";
+        case IrOpShl:
+        case IrOpShr:
+            return "shift out of range";
+        default:
+            return "overflow";
+    }
+}
+
+static enum IrFoldStatus
+eval_fun(struct IrEvaluator *self,
+         const struct IrFun *fun,
+         struct IrValue **args,
+         struct IrValue **result);
+
+static enum IrFoldStatus
+eval_inst(struct IrEvaluator *self,
+          const struct IrFun *fun,
+          const struct IrInst *inst,
+          struct IrValue **regs)
+{
+    struct IrValue *result = NULL;
+
+    for (Usize i = 0; i < inst->args_len; i++)
+        if (!regs[inst->args[i]])
+            return IrFoldStatusUnknown;
+
+    switch (inst->kind) {
+        case IrInstKindConst:
+            result = new_literal(inst->value.literal);
+            break;
+        case IrInstKindCopy:
+        case IrInstKindBox:
+        case IrInstKindUnbox:
+            result = clone__IrValue(regs[inst->args[0]]);
+            break;
+        case IrInstKindUnary:
+        case IrInstKindBinary: {
+            struct IrValue *x = regs[inst->args[0]];
+            struct IrValue *y =
+              inst->kind == IrInstKindBinary ? regs[inst->args[1]] : NULL;
+            struct LiteralSymbol literal;
+
+            if (x->is_record || (y && y->is_record))
+                return IrFoldStatusUnknown;
+
+            enum IrFoldStatus status = fold__IrInst(
+              fun, inst, &x->literal, y ? &y->literal : NULL, &literal);
+
+            if (status == IrFoldStatusPanic)
+                self->panic = get_panic_reason(inst, y);
+
+            if (status != IrFoldStatusDone)
+                return status;
+
+            result = new_literal(literal);
+            break;
+        }
+        case IrInstKindCall: {
+            const struct IrFun *callee = self->module->funs[inst->value.fun];
+
+            if (!callee || self->depth >= IR_EVAL_MAX_DEPTH)
+                return IrFoldStatusUnknown;
+
+            struct IrValue **args =
+              malloc(sizeof(struct IrValue *) * (inst->args_len + 1));
+
+            for (Usize i = 0; i < inst->args_len; i++)
+                args[i] = regs[inst->args[i]];
+
+            enum IrFoldStatus status = eval_fun(self, callee, args, &result);
+
+            free(args);
+
+            if (status != IrFoldStatusDone)
+                return status;
+
+            break;
+        }
+        case IrInstKindRecord:
+            result = malloc(sizeof(struct IrValue));
+            *result =
+              (struct IrValue){ .is_record = true,
+                                .record = inst->value.record,
+                                .fields = malloc(sizeof(struct IrValue) *
+                                                 (inst->args_len + 1)),
+                                .fields_len = inst->args_len };
+
+            for (Usize i = 0; i < inst->args_len; i++) {
+                struct IrValue *field = clone__IrValue(regs[inst->args[i]]);
+
+                result->fields[i] = *field;
+                free(field);
+            }
+
+            break;
+        case IrInstKindField:
+        case IrInstKindSetField: {
+            struct IrValue *record = regs[inst->args[0]];
+            Isize id = -1;
+
+            if (!inst->value.field.is_ptr && record->is_record)
+                id = get_field_index(
+                  self->module, record, inst->value.field.name);
+
+            if (id == -1)
+                return IrFoldStatusUnknown;
+
+            if (inst->kind == IrInstKindField)
+                result = clone__IrValue(&record->fields[id]);
+            else {
+                result = clone__IrValue(record);
+                set_field(result, id, regs[inst->args[1]]);
+            }
+
+            break;
+        }
+        case IrInstKindConstant:
+            if (!self->module->values[inst->value.constant])
+                return IrFoldStatusUnknown;
+
+            result = clone__IrValue(self->module->values[inst->value.constant]);
+            break;
+        default:
+            // The prints are done at run time.
+            return IrFoldStatusUnknown;
+    }
+
+    if (inst->dst != IR_NONE)
+        set_reg(regs, inst->dst, result);
+    else if (result)
+        FREE(IrValue, result);
+
+    return IrFoldStatusDone;
+}
+
+// The arguments are copied before the parameters are assigned: an argument can
+// be a parameter of the block (loop).
+static void
+take_edge(struct IrValue **regs,
+          const struct IrFun *fun,
+          const struct IrEdge *edge)
+{
+    const struct IrBlock *block = &fun->blocks[edge->block];
+    struct IrValue **args =
+      malloc(sizeof(struct IrValue *) * (edge->args_len + 1));
+
+    for (Usize i = 0; i < edge->args_len; i++)
+        args[i] = regs[edge->args[i]] ? clone__IrValue(regs[edge->args[i]])
+                                      : NULL;
+
+    for (Usize i = 0; i < edge->args_len; i++)
+        set_reg(regs, block->params[i], args[i]);
+
+    free(args);
+}
+
+static enum IrFoldStatus
+eval_fun(struct IrEvaluator *self,
+         const struct IrFun *fun,
+         struct IrValue **args,
+         struct IrValue **result)
+{
+    struct IrValue **regs = calloc(fun->regs_len + 1, sizeof(struct IrValue *));
+    enum IrFoldStatus status = IrFoldStatusUnknown;
+    Usize id = 0;
+
+    for (Usize i = 0; i < fun->blocks[0].params_len; i++)
+        regs[fun->blocks[0].params[i]] = clone__IrValue(args[i]);
+
+    self->depth++;
+
+    while (self->steps++ < IR_EVAL_MAX_STEPS) {
+        const struct IrBlock *block = &fun->blocks[id];
+        const struct IrTerm *term = &block->term;
+
+        status = IrFoldStatusDone;
+        self->steps += block->insts_len;
+
+        for (Usize i = 0; i < block->insts_len && status == IrFoldStatusDone;
+             i++)
+            status = eval_inst(self, fun, &block->insts[i], regs);
+
+        if (status != IrFoldStatusDone)
+            break;
+
+        status = IrFoldStatusUnknown;
+
+        if (term->kind == IrTermKindReturn) {
+            if (term->value == IR_NONE)
+                *result = NULL;
+            else if (regs[term->value])
+                *result = clone__IrValue(regs[term->value]);
+            else
+                break;
+
+            status = IrFoldStatusDone;
+            break;
+        } else if (term->kind == IrTermKindJump) {
+            take_edge(regs, fun, &term->edges[0]);
+            id = term->edges[0].block;
+        } else if (term->kind == IrTermKindBranch && regs[term->value] &&
+                   !regs[term->value]->is_record &&
+                   regs[term->value]->literal.kind == LiteralSymbolKindBool) {
+            const struct IrEdge *edge =
+              &term->edges[regs[term->value]->literal.value.bool_ ? 0 : 1];
+
+            take_edge(regs, fun, edge);
+            id = edge->block;
+        } else if (term->kind == IrTermKindSwitch && regs[term->value] &&
+                   !regs[term->value]->is_record) {
+            // The values of the enums are not computed: the switch is on a
+            // literal.
+            const struct IrEdge *edge = &term->edges[0];
+            Int64 value;
+
+            if (!get_case_value__LiteralSymbol(&regs[term->value]->literal,
+                                               &value))
+                break;
+
+            for (Usize i = 0; i < term->cases_len; i++)
+                if (term->cases[i].value == value)
+                    edge = &term->cases[i].edge;
+
+            take_edge(regs, fun, edge);
+            id = edge->block;
+        } else
+            break;
+    }
+
+    self->depth--;
+
+    for (Usize i = 0; i < fun->regs_len; i++)
+        if (regs[i])
+            FREE(IrValue, regs[i]);
+
+    free(regs);
+
+    return status;
+}
+
+enum IrFoldStatus
+eval__IrFun(const struct IrModule *module,
+            const struct IrFun *self,
+            struct IrValue **args,
+            struct IrValue **result,
+            Str *panic)
+{
+    struct IrEvaluator evaluator = {
+        .module = module, .steps = 0, .depth = 0, .panic = NULL
+    };
+    enum IrFoldStatus status = eval_fun(&evaluator, self, args, result);
+
+    if (status == IrFoldStatusPanic && panic)
+        *panic = evaluator.panic;
+
+    return status;
+}
+
+static void
+emit_panic(struct IrModule *self, struct ConstantSymbol *constant, Str panic)
+{
+    if (!constant->constant_decl)
+        return;
+
+    emit__Diagnostic(
+      NEW(DiagnosticWithErr,
+          NEW(LilyErrorWithString,
+              LilyErrorConstantPanics,
+              from__String(panic)),
+          constant->constant_decl->loc,
+          self->tc->parser.parse_block.scanner.src->file,
+          from__String(""),
+          Some(format("the value of `{S}` is computed at compile time",
+                      constant->name))));
+}
+
+// The constants used by the initializer are computed first.
+static void
+evaluate_constant(struct IrModule *self, Usize id, UInt8 *state)
+{
+    struct ConstantSymbol *constant = get__Vec(*self->tc->consts, id);
+    struct IrFun *init = self->consts[id];
+
+    if (state[id])
+        return;
+
+    state[id] = 1;
+
+    if (constant->expr_symbol &&
+        constant->expr_symbol->kind == ExprKindLiteral) {
+        self->values[id] = new_literal(constant->expr_symbol->value.literal);
+        return;
+    } else if (!init)
+        return;
+
+    for (Usize i = 0; i < init->blocks_len; i++)
+        for (Usize j = 0; j < init->blocks[i].insts_len; j++)
+            if (init->blocks[i].insts[j].kind == IrInstKindConstant)
+                evaluate_constant(
+                  self, init->blocks[i].insts[j].value.constant, state);
+
+    struct IrValue *value = NULL;
+    Str panic = NULL;
+
+    switch (eval__IrFun(self, init, NULL, &value, &panic)) {
+        case IrFoldStatusDone:
+            self->values[id] = value;
+            FREE(IrFun, init);
+            self->consts[id] = NULL;
+            break;
+        case IrFoldStatusPanic:
+            emit_panic(self, constant, panic);
+            break;
+        default:
+            break;
+    }
+}
+
+// The value of a function without parameter, computed once (funs_state: 0
+// not computed, 1 computed, 2 unknown).
+static const struct IrValue *
+get_fun_value(struct IrModule *self,
+              Usize id,
+              UInt8 *funs_state,
+              struct IrValue **funs_value)
+{
+    if (!funs_state[id]) {
+        struct IrFun *fun = self->funs[id];
+
+        funs_state[id] = 2;
+
+        if (fun && fun->blocks[0].params_len == 0 && fun->return_type &&
+            eval__IrFun(self, fun, NULL, &funs_value[id], NULL) ==
+              IrFoldStatusDone)
+            funs_state[id] = 1;
+    }
+
+    return funs_state[id] == 1 ? funs_value[id] : NULL;
+}
+
+static void
+replace_known_values(struct IrModule *self,
+                     struct IrFun *fun,
+                     UInt8 *funs_state,
+                     struct IrValue **funs_value)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            struct IrInst *inst = &fun->blocks[i].insts[j];
+            const struct IrValue *value = NULL;
+
+            if (inst->kind == IrInstKindConstant)
+                value = self->values[inst->value.constant];
+            else if (inst->kind == IrInstKindCall && inst->args_len == 0 &&
+                     inst->dst != IR_NONE)
+                value =
+                  get_fun_value(self, inst->value.fun, funs_state, funs_value);
+
+            // A record stays a use of the constant (static data in C).
+            if (value && !value->is_record) {
+                FREE(IrInst, inst);
+                *inst = (struct IrInst){ .kind = IrInstKindConst,
+                                         .dst = inst->dst,
+                                         .value.literal = value->literal };
+            }
+        }
+}
+
+void
+evaluate_constants__IrModule(struct IrModule *self)
+{
+    UInt8 *state = calloc(self->consts_len + 1, sizeof(UInt8));
+    UInt8 *funs_state = calloc(self->funs_len + 1, sizeof(UInt8));
+    struct IrValue **funs_value =
+      calloc(self->funs_len + 1, sizeof(struct IrValue *));
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        evaluate_constant(self, i, state);
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            replace_known_values(self, self->funs[i], funs_state, funs_value);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            replace_known_values(
+              self, self->consts[i], funs_state, funs_value);
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (funs_value[i])
+            FREE(IrValue, funs_value[i]);
+
+    free(state);
+    free(funs_state);
+    free(funs_value);
+}
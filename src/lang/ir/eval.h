@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LILY_IR_EVAL_H
+#define LILY_IR_EVAL_H
+
+#include <lang/ir/ir.h>
+#include <lang/ir/pass.h>
+
+// Beyond IR_EVAL_MAX_STEPS instructions or IR_EVAL_MAX_DEPTH nested calls, the
+// value is left to the run time.
+#define IR_EVAL_MAX_STEPS 1000000
+#define IR_EVAL_MAX_DEPTH 256
+
+/**
+ *
+ * @brief Run the function at compile time. The function must not print.
+ * @param args The values of the parameters (borrowed).
+ * @param result The returned value (NULL for a Unit function).
+ * @param panic The reason of the panic if the function panics.
+ * @return IrFoldStatusUnknown if the value is not computed at compile time.
+ */
+enum IrFoldStatus
+eval__IrFun(const struct IrModule *module,
+            const struct IrFun *self,
+            struct IrValue **args,
+            struct IrValue **result,
+            Str *panic);
+
+/**
+ *
+ * @brief Compute the value of the constants at compile time, then replace the
+ * uses of the constants and the calls of the functions without parameter by
+ * their value. An error is emitted for a constant whose computation panics
+ * (overflow, division by zero, ...).
+ */
+void
+evaluate_constants__IrModule(struct IrModule *self);
+
+#endif // LILY_IR_EVAL_H
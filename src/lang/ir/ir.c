@@ -0,0 +1,905 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/ir/ir.h>
+#include <lang/ir/mono.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void
+push_index(Usize **buffer, Usize *len, Usize *capacity, Usize index)
+{
+    if (*len == *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 4;
+        *buffer = realloc(*buffer, *capacity * sizeof(Usize));
+    }
+
+    (*buffer)[(*len)++] = index;
+}
+
+bool
+has_constant__IrModule(const struct IrModule *self, Usize id)
+{
+    struct ConstantSymbol *constant = get__Vec(*self->tc->consts, id);
+
+    return constant->expr_symbol &&
+           (constant->expr_symbol->kind == ExprKindLiteral ||
+            self->values[id] || self->consts[id]);
+}
+
+struct EnumSymbol *
+get_enum__IrModule(const struct IrModule *self,
+                   const struct DataTypeSymbol *data_type)
+{
+    if (!data_type || data_type->kind != DataTypeKindCustom ||
+        !data_type->scope || data_type->scope->item_kind != ScopeItemKindEnum ||
+        data_type->scope->filename !=
+          self->tc->parser.parse_block.scanner.src->file.name ||
+        !self->tc->enums)
+        return NULL;
+
+    return get__Vec(*self->tc->enums, data_type->scope->id);
+}
+
+struct String *
+get_fun_name__IrModule(const struct IrModule *self, Usize id)
+{
+    if (id < self->file_funs_len)
+        return ((struct FunSymbol *)get__Vec(*self->tc->funs, id))->name;
+
+    return self->instances[id - self->file_funs_len].name;
+}
+
+Usize
+add_reg__IrFun(struct IrFun *self, struct DataTypeSymbol *data_type)
+{
+    if (self->regs_len == self->regs_capacity) {
+        self->regs_capacity =
+          self->regs_capacity ? self->regs_capacity * 2 : 16;
+        self->regs =
+          realloc(self->regs,
+                  self->regs_capacity * sizeof(struct DataTypeSymbol *));
+    }
+
+    self->regs[self->regs_len] = data_type;
+
+    return self->regs_len++;
+}
+
+Usize
+add_block__IrFun(struct IrFun *self)
+{
+    if (self->blocks_len == self->blocks_capacity) {
+        self->blocks_capacity =
+          self->blocks_capacity ? self->blocks_capacity * 2 : 4;
+        self->blocks =
+          realloc(self->blocks, self->blocks_capacity * sizeof(struct IrBlock));
+    }
+
+    self->blocks[self->blocks_len] = (struct IrBlock){ 0 };
+
+    return self->blocks_len++;
+}
+
+void
+push_inst__IrBlock(struct IrBlock *self, struct IrInst inst)
+{
+    if (self->insts_len == self->insts_capacity) {
+        self->insts_capacity =
+          self->insts_capacity ? self->insts_capacity * 2 : 4;
+        self->insts =
+          realloc(self->insts, self->insts_capacity * sizeof(struct IrInst));
+    }
+
+    self->insts[self->insts_len++] = inst;
+}
+
+void
+push_param__IrBlock(struct IrBlock *self, Usize reg)
+{
+    push_index(&self->params, &self->params_len, &self->params_capacity, reg);
+}
+
+void
+push_arg__IrEdge(struct IrEdge *self, Usize reg)
+{
+    push_index(&self->args, &self->args_len, &self->args_capacity, reg);
+}
+
+void
+push_case__IrTerm(struct IrTerm *self, Int64 value)
+{
+    if (self->cases_len == self->cases_capacity) {
+        self->cases_capacity =
+          self->cases_capacity ? self->cases_capacity * 2 : 4;
+        self->cases =
+          realloc(self->cases, self->cases_capacity * sizeof(struct IrCase));
+    }
+
+    self->cases[self->cases_len++] = (struct IrCase){ .value = value };
+}
+
+Usize
+get_edges_len__IrTerm(const struct IrTerm *self)
+{
+    switch (self->kind) {
+        case IrTermKindJump:
+            return 1;
+        case IrTermKindBranch:
+            return 2;
+        case IrTermKindSwitch:
+            return 1 + self->cases_len;
+        default:
+            return 0;
+    }
+}
+
+struct IrEdge *
+get_edge__IrTerm(struct IrTerm *self, Usize edge)
+{
+    if (self->kind == IrTermKindSwitch && edge > 0)
+        return &self->cases[edge - 1].edge;
+
+    return &self->edges[edge];
+}
+
+void
+__free__IrTerm(struct IrTerm *self)
+{
+    free(self->edges[0].args);
+    free(self->edges[1].args);
+
+    for (Usize i = 0; i < self->cases_len; i++)
+        free(self->cases[i].edge.args);
+
+    free(self->cases);
+}
+
+bool
+get_case_value__LiteralSymbol(const struct LiteralSymbol *self, Int64 *value)
+{
+    switch (self->kind) {
+        case LiteralSymbolKindBool:
+            *value = self->value.bool_;
+            return true;
+        case LiteralSymbolKindChar:
+            *value = self->value.char_;
+            return true;
+        case LiteralSymbolKindBitChar:
+            *value = self->value.bit_char;
+            return true;
+        case LiteralSymbolKindInt8:
+            *value = self->value.int8;
+            return true;
+        case LiteralSymbolKindInt16:
+            *value = self->value.int16;
+            return true;
+        case LiteralSymbolKindInt32:
+            *value = self->value.int32;
+            return true;
+        case LiteralSymbolKindInt64:
+            *value = self->value.int64;
+            return true;
+        case LiteralSymbolKindUint8:
+            *value = self->value.uint8;
+            return true;
+        case LiteralSymbolKindUint16:
+            *value = self->value.uint16;
+            return true;
+        case LiteralSymbolKindUint32:
+            *value = self->value.uint32;
+            return true;
+        case LiteralSymbolKindUint64:
+            *value = (Int64)self->value.uint64;
+            return true;
+        default:
+            return false;
+    }
+}
+
+Usize
+count_insts__IrFun(const struct IrFun *self)
+{
+    Usize count = 0;
+
+    for (Usize i = 0; i < self->blocks_len; i++)
+        count += self->blocks[i].insts_len;
+
+    return count;
+}
+
+static Str
+get_op_name(enum IrOp op)
+{
+    switch (op) {
+        case IrOpAdd:
+            return "add";
+        case IrOpSub:
+            return "sub";
+        case IrOpMul:
+            return "mul";
+        case IrOpDiv:
+            return "div";
+        case IrOpMod:
+            return "mod";
+        case IrOpLt:
+            return "lt";
+        case IrOpGt:
+            return "gt";
+        case IrOpLe:
+            return "le";
+        case IrOpGe:
+            return "ge";
+        case IrOpEq:
+            return "eq";
+        case IrOpNe:
+            return "ne";
+        case IrOpXor:
+            return "xor";
+        case IrOpShl:
+            return "shl";
+        case IrOpShr:
+            return "shr";
+        case IrOpBitOr:
+            return "bitor";
+        case IrOpBitAnd:
+            return "bitand";
+        case IrOpNeg:
+            return "neg";
+        case IrOpNot:
+            return "not";
+        case IrOpBitNot:
+            return "bitnot";
+        default:
+            UNREACHABLE("unknown IR operator");
+    }
+}
+
+void
+write__DataTypeSymbol(struct Writer *writer,
+                      const struct DataTypeSymbol *data_type)
+{
+    if (!data_type) {
+        write_str__Writer(writer, "Unit");
+        return;
+    }
+
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            write_char__Writer(writer, '*');
+            write__DataTypeSymbol(writer, data_type->value.ptr);
+            break;
+        case DataTypeKindRef:
+            write_char__Writer(writer, '&');
+            write__DataTypeSymbol(writer, data_type->value.ref);
+            break;
+        case DataTypeKindMut:
+            write_str__Writer(writer, "mut ");
+            write__DataTypeSymbol(writer, data_type->value.mut);
+            break;
+        case DataTypeKindOptional:
+            write_char__Writer(writer, '?');
+            write__DataTypeSymbol(writer, data_type->value.optional);
+            break;
+        case DataTypeKindCustom:
+            if (data_type->scope)
+                write_String__Writer(writer, data_type->scope->name);
+            else
+                write_str__Writer(writer, "Custom");
+
+            break;
+        case DataTypeKindCompilerDefined:
+            write_str__Writer(writer, data_type->value.compiler_defined.name);
+            break;
+        case DataTypeKindStr:
+            write_str__Writer(writer, "Str");
+            break;
+        case DataTypeKindChar:
+            write_str__Writer(writer, "Char");
+            break;
+        case DataTypeKindBitChar:
+            write_str__Writer(writer, "BitChar");
+            break;
+        case DataTypeKindI8:
+            write_str__Writer(writer, "Int8");
+            break;
+        case DataTypeKindI16:
+            write_str__Writer(writer, "Int16");
+            break;
+        case DataTypeKindI32:
+            write_str__Writer(writer, "Int32");
+            break;
+        case DataTypeKindI64:
+            write_str__Writer(writer, "Int64");
+            break;
+        case DataTypeKindI128:
+            write_str__Writer(writer, "Int128");
+            break;
+        case DataTypeKindU8:
+            write_str__Writer(writer, "Uint8");
+            break;
+        case DataTypeKindU16:
+            write_str__Writer(writer, "Uint16");
+            break;
+        case DataTypeKindU32:
+            write_str__Writer(writer, "Uint32");
+            break;
+        case DataTypeKindU64:
+            write_str__Writer(writer, "Uint64");
+            break;
+        case DataTypeKindU128:
+            write_str__Writer(writer, "Uint128");
+            break;
+        case DataTypeKindF32:
+            write_str__Writer(writer, "Float32");
+            break;
+        case DataTypeKindF64:
+            write_str__Writer(writer, "Float64");
+            break;
+        case DataTypeKindBool:
+            write_str__Writer(writer, "Bool");
+            break;
+        case DataTypeKindIsize:
+            write_str__Writer(writer, "Isize");
+            break;
+        case DataTypeKindUsize:
+            write_str__Writer(writer, "Usize");
+            break;
+        case DataTypeKindUnit:
+            write_str__Writer(writer, "Unit");
+            break;
+        case DataTypeKindNever:
+            write_str__Writer(writer, "Never");
+            break;
+        case DataTypeKindLambda: {
+            struct Vec *params = data_type->value.lambda->items[0];
+
+            write_char__Writer(writer, '|');
+
+            for (Usize i = 0; params && i < len__Vec(*params); i++) {
+                write__DataTypeSymbol(writer, get__Vec(*params, i));
+                write_str__Writer(writer, " -> ");
+            }
+
+            write__DataTypeSymbol(writer, data_type->value.lambda->items[1]);
+            write_char__Writer(writer, '|');
+            break;
+        }
+        default:
+            write_str__Writer(writer, "?");
+    }
+}
+
+static void
+write_int128(struct Writer *writer, Int128 value, bool is_signed)
+{
+    if (is_signed && value >= (Int128)INT64_MIN && value <= (Int128)INT64_MAX)
+        write_int__Writer(writer, (Int64)value);
+    else if (!is_signed && (UInt128)value <= UINT64_MAX)
+        write_uint__Writer(writer, (UInt64)value);
+    else {
+        char s[64];
+
+        snprintf(s,
+                 sizeof(s),
+                 "0x%016llx%016llx",
+                 (unsigned long long)((UInt128)value >> 64),
+                 (unsigned long long)(UInt64)value);
+        write_str__Writer(writer, s);
+    }
+}
+
+static void
+write_literal(struct Writer *writer, struct LiteralSymbol literal)
+{
+    switch (literal.kind) {
+        case LiteralSymbolKindBool:
+            write_str__Writer(writer, literal.value.bool_ ? "true" : "false");
+            break;
+        case LiteralSymbolKindChar:
+            write_char__Writer(writer, '\'');
+            write_char__Writer(writer, literal.value.char_);
+            write_char__Writer(writer, '\'');
+            break;
+        case LiteralSymbolKindBitChar:
+            write_uint__Writer(writer, literal.value.bit_char);
+            break;
+        case LiteralSymbolKindInt8:
+            write_int__Writer(writer, literal.value.int8);
+            break;
+        case LiteralSymbolKindInt16:
+            write_int__Writer(writer, literal.value.int16);
+            break;
+        case LiteralSymbolKindInt32:
+            write_int__Writer(writer, literal.value.int32);
+            break;
+        case LiteralSymbolKindInt64:
+            write_int__Writer(writer, literal.value.int64);
+            break;
+        case LiteralSymbolKindInt128:
+            write_int128(writer, literal.value.int128, true);
+            break;
+        case LiteralSymbolKindUint8:
+            write_uint__Writer(writer, literal.value.uint8);
+            break;
+        case LiteralSymbolKindUint16:
+            write_uint__Writer(writer, literal.value.uint16);
+            break;
+        case LiteralSymbolKindUint32:
+            write_uint__Writer(writer, literal.value.uint32);
+            break;
+        case LiteralSymbolKindUint64:
+            write_uint__Writer(writer, literal.value.uint64);
+            break;
+        case LiteralSymbolKindUint128:
+            write_int128(writer, literal.value.uint128, false);
+            break;
+        case LiteralSymbolKindFloat32:
+            write_float__Writer(writer, literal.value.float32);
+            break;
+        case LiteralSymbolKindFloat64:
+            write_float__Writer(writer, literal.value.float64);
+            break;
+        case LiteralSymbolKindStr:
+            write_char__Writer(writer, '"');
+            write_str__Writer(writer, literal.value.str);
+            write_char__Writer(writer, '"');
+            break;
+        default:
+            write_str__Writer(writer, "?");
+    }
+}
+
+static void
+write_reg(struct Writer *writer, Usize reg)
+{
+    write_char__Writer(writer, '%');
+    write_uint__Writer(writer, reg);
+}
+
+static void
+write_regs(struct Writer *writer, const Usize *regs, Usize len)
+{
+    for (Usize i = 0; i < len; i++) {
+        if (i > 0)
+            write_str__Writer(writer, ", ");
+
+        write_reg(writer, regs[i]);
+    }
+}
+
+static void
+write_edge(struct Writer *writer, const struct IrEdge *edge)
+{
+    write_str__Writer(writer, "bb");
+    write_uint__Writer(writer, edge->block);
+
+    if (edge->args_len) {
+        write_char__Writer(writer, '(');
+        write_regs(writer, edge->args, edge->args_len);
+        write_char__Writer(writer, ')');
+    }
+}
+
+static void
+write_variant_name(struct Writer *writer,
+                   const struct EnumSymbol *enum_,
+                   Usize variant)
+{
+    if (enum_)
+        write_String__Writer(
+          writer,
+          ((struct SymbolTable *)get__Vec(*enum_->variants, variant))
+            ->value.variant->name);
+    else
+        write_uint__Writer(writer, variant);
+}
+
+static void
+write_inst(const struct IrModule *self,
+           const struct IrFun *fun,
+           struct Writer *writer,
+           const struct IrInst *inst)
+{
+    write_str__Writer(writer, "    ");
+
+    if (inst->dst != IR_NONE) {
+        write_reg(writer, inst->dst);
+        write_str__Writer(writer, ": ");
+        write__DataTypeSymbol(writer, fun->regs[inst->dst]);
+        write_str__Writer(writer, " = ");
+    }
+
+    switch (inst->kind) {
+        case IrInstKindConst:
+            write_str__Writer(writer, "const ");
+            write_literal(writer, inst->value.literal);
+            break;
+        case IrInstKindCopy:
+            write_str__Writer(writer, "copy ");
+            break;
+        case IrInstKindUnary:
+        case IrInstKindBinary:
+            write_str__Writer(writer, get_op_name(inst->value.op));
+            write_str__Writer(writer, inst->is_unchecked ? " unchecked " : " ");
+            break;
+        case IrInstKindCall:
+            write_str__Writer(writer, "call ");
+            write_String__Writer(writer,
+                                 get_fun_name__IrModule(self, inst->value.fun));
+            write_char__Writer(writer, ' ');
+            break;
+        case IrInstKindPrint:
+            write_str__Writer(writer,
+                              inst->value.print.newline ? "println \""
+                                                        : "print \"");
+            write_str__Writer(writer, inst->value.print.format);
+            write_str__Writer(writer, inst->args_len ? "\", " : "\"");
+            break;
+        case IrInstKindRecord:
+            write_str__Writer(writer, "record ");
+            write_String__Writer(writer,
+                                 ((struct RecordSymbol *)get__Vec(
+                                    *self->tc->records, inst->value.record))
+                                   ->name);
+            write_char__Writer(writer, ' ');
+            break;
+        case IrInstKindField:
+        case IrInstKindSetField:
+            write_str__Writer(writer,
+                              inst->kind == IrInstKindField ? "field "
+                                                            : "setfield ");
+            write_String__Writer(writer, inst->value.field.name);
+            write_str__Writer(writer, inst->value.field.is_ptr ? "* " : " ");
+            break;
+        case IrInstKindConstant:
+            write_str__Writer(writer, "constant ");
+            write_String__Writer(
+              writer,
+              ((struct ConstantSymbol *)get__Vec(*self->tc->consts,
+                                                 inst->value.constant))
+                ->name);
+            break;
+        case IrInstKindBox:
+            write_str__Writer(writer, "box ");
+            break;
+        case IrInstKindUnbox:
+            write_str__Writer(writer, "unbox ");
+            break;
+        case IrInstKindVariant:
+        case IrInstKindPayload:
+            write_str__Writer(writer,
+                              inst->kind == IrInstKindVariant ? "variant "
+                                                              : "payload ");
+            write_variant_name(
+              writer,
+              get_enum__IrModule(self,
+                                 fun->regs[inst->kind == IrInstKindVariant
+                                             ? inst->dst
+                                             : inst->args[0]]),
+              inst->value.variant);
+            write_str__Writer(writer, inst->args_len ? " " : "");
+            break;
+        case IrInstKindClosure:
+            write_str__Writer(writer,
+                              inst->value.closure.is_heap ? "closure heap "
+                                                          : "closure stack ");
+            write_String__Writer(
+              writer, self->lambdas[inst->value.closure.lambda].name);
+            write_str__Writer(writer, inst->args_len ? " " : "");
+            break;
+        case IrInstKindCallClosure:
+            write_str__Writer(writer, "callclosure ");
+            break;
+    }
+
+    write_regs(writer, inst->args, inst->args_len);
+    write_char__Writer(writer, '\n');
+}
+
+// switch %0 [Red: bb1, Green: bb2], bb3
+static void
+write_switch(const struct IrModule *self,
+             const struct IrFun *fun,
+             struct Writer *writer,
+             const struct IrTerm *term)
+{
+    struct EnumSymbol *enum_ = get_enum__IrModule(self, fun->regs[term->value]);
+
+    write_str__Writer(writer, "switch ");
+    write_reg(writer, term->value);
+    write_str__Writer(writer, " [");
+
+    for (Usize i = 0; i < term->cases_len; i++) {
+        if (i > 0)
+            write_str__Writer(writer, ", ");
+
+        if (enum_)
+            write_variant_name(writer, enum_, term->cases[i].value);
+        else
+            write_int__Writer(writer, term->cases[i].value);
+
+        write_str__Writer(writer, ": ");
+        write_edge(writer, &term->cases[i].edge);
+    }
+
+    write_str__Writer(writer, "], ");
+    write_edge(writer, &term->edges[0]);
+}
+
+static void
+write_term(const struct IrModule *self,
+           const struct IrFun *fun,
+           struct Writer *writer,
+           const struct IrTerm *term)
+{
+    write_str__Writer(writer, "    ");
+
+    switch (term->kind) {
+        case IrTermKindNone:
+            write_str__Writer(writer, "<none>");
+            break;
+        case IrTermKindJump:
+            write_str__Writer(writer, "jmp ");
+            write_edge(writer, &term->edges[0]);
+            break;
+        case IrTermKindBranch:
+            write_str__Writer(writer, "br ");
+            write_reg(writer, term->value);
+            write_str__Writer(writer, ", ");
+            write_edge(writer, &term->edges[0]);
+            write_str__Writer(writer, ", ");
+            write_edge(writer, &term->edges[1]);
+            break;
+        case IrTermKindSwitch:
+            write_switch(self, fun, writer, term);
+            break;
+        case IrTermKindReturn:
+            write_str__Writer(writer, "ret");
+
+            if (term->value != IR_NONE) {
+                write_char__Writer(writer, ' ');
+                write_reg(writer, term->value);
+            }
+
+            break;
+        case IrTermKindUnreachable:
+            write_str__Writer(writer, "unreachable");
+            break;
+    }
+
+    write_char__Writer(writer, '\n');
+}
+
+static void
+write_fun(const struct IrModule *self,
+          const struct IrFun *fun,
+          struct Writer *writer,
+          Str keyword)
+{
+    write_str__Writer(writer, keyword);
+    write_String__Writer(writer, fun->name);
+    write_str__Writer(writer, " -> ");
+    write__DataTypeSymbol(writer, fun->return_type);
+    write_str__Writer(writer, " {\n");
+
+    for (Usize i = 0; i < fun->blocks_len; i++) {
+        const struct IrBlock *block = &fun->blocks[i];
+
+        write_str__Writer(writer, "bb");
+        write_uint__Writer(writer, i);
+
+        if (block->params_len) {
+            write_char__Writer(writer, '(');
+
+            for (Usize j = 0; j < block->params_len; j++) {
+                if (j > 0)
+                    write_str__Writer(writer, ", ");
+
+                write_reg(writer, block->params[j]);
+                write_str__Writer(writer, ": ");
+                write__DataTypeSymbol(writer, fun->regs[block->params[j]]);
+            }
+
+            write_char__Writer(writer, ')');
+        }
+
+        write_str__Writer(writer, ":\n");
+
+        for (Usize j = 0; j < block->insts_len; j++)
+            write_inst(self, fun, writer, &block->insts[j]);
+
+        write_term(self, fun, writer, &block->term);
+    }
+
+    write_str__Writer(writer, "}\n\n");
+}
+
+// Point{x := 1, y := 2}
+static void
+write_value(const struct IrModule *self,
+            struct Writer *writer,
+            const struct IrValue *value)
+{
+    if (!value->is_record) {
+        write_literal(writer, value->literal);
+        return;
+    }
+
+    struct RecordSymbol *record =
+      get__Vec(*self->tc->records, value->record);
+
+    write_String__Writer(writer, record->name);
+    write_char__Writer(writer, '{');
+
+    for (Usize i = 0; i < value->fields_len; i++) {
+        if (i > 0)
+            write_str__Writer(writer, ", ");
+
+        write_String__Writer(
+          writer,
+          ((struct SymbolTable *)get__Vec(*record->fields, i))
+            ->value.field->name);
+        write_str__Writer(writer, " := ");
+        write_value(self, writer, &value->fields[i]);
+    }
+
+    write_char__Writer(writer, '}');
+}
+
+void
+write__IrModule(const struct IrModule *self, struct Writer *writer)
+{
+    for (Usize i = 0; i < self->consts_len; i++) {
+        struct ConstantSymbol *constant = get__Vec(*self->tc->consts, i);
+
+        if (self->values[i]) {
+            write_str__Writer(writer, "const ");
+            write_String__Writer(writer, constant->name);
+            write_str__Writer(writer, ": ");
+            write__DataTypeSymbol(writer, constant->data_type);
+            write_str__Writer(writer, " = ");
+            write_value(self, writer, self->values[i]);
+            write_str__Writer(writer, "\n\n");
+        } else if (self->consts[i])
+            write_fun(self, self->consts[i], writer, "const ");
+    }
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            write_fun(self, self->funs[i], writer, "fun ");
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            write_fun(self, self->lambdas[i].fun, writer, "lambda ");
+}
+
+struct IrValue *
+clone__IrValue(const struct IrValue *self)
+{
+    struct IrValue *clone = malloc(sizeof(struct IrValue));
+
+    *clone = *self;
+
+    if (self->is_record) {
+        clone->fields =
+          malloc(sizeof(struct IrValue) * (self->fields_len + 1));
+
+        for (Usize i = 0; i < self->fields_len; i++) {
+            struct IrValue *field = clone__IrValue(&self->fields[i]);
+
+            clone->fields[i] = *field;
+            free(field);
+        }
+    }
+
+    return clone;
+}
+
+// Free the fields of the value (not the value itself).
+static void
+free_fields(struct IrValue *self)
+{
+    for (Usize i = 0; i < self->fields_len; i++)
+        free_fields(&self->fields[i]);
+
+    free(self->fields);
+}
+
+void
+__free__IrValue(struct IrValue *self)
+{
+    free_fields(self);
+    free(self);
+}
+
+void
+__free__IrInst(struct IrInst *self)
+{
+    free(self->args);
+}
+
+void
+__free__IrBlock(struct IrBlock *self)
+{
+    for (Usize i = 0; i < self->insts_len; i++)
+        FREE(IrInst, &self->insts[i]);
+
+    free(self->insts);
+    free(self->params);
+    FREE(IrTerm, &self->term);
+}
+
+void
+__free__IrFun(struct IrFun *self)
+{
+    for (Usize i = 0; i < self->blocks_len; i++)
+        FREE(IrBlock, &self->blocks[i]);
+
+    free(self->blocks);
+    free(self->regs);
+    free(self);
+}
+
+void
+__free__IrModule(struct IrModule *self)
+{
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            FREE(IrFun, self->funs[i]);
+
+    for (Usize i = 0; i < self->file_funs_len; i++)
+        if (self->generics[i])
+            FREE(IrGeneric, self->generics[i]);
+
+    for (Usize i = 0; i < self->instances_len; i++)
+        FREE(IrInstance, &self->instances[i]);
+
+    for (Usize i = 0; i < self->consts_len; i++) {
+        if (self->consts[i])
+            FREE(IrFun, self->consts[i]);
+
+        if (self->values[i])
+            FREE(IrValue, self->values[i]);
+    }
+
+    for (Usize i = 0; i < self->lambdas_len; i++) {
+        if (self->lambdas[i].fun)
+            FREE(IrFun, self->lambdas[i].fun);
+
+        FREE(String, self->lambdas[i].name);
+    }
+
+    FREE(StrMap, self->instances_cache);
+    free(self->funs);
+    free(self->generics);
+    free(self->instances);
+    free(self->consts);
+    free(self->values);
+    free(self->lambdas);
+    free(self);
+}
@@ -0,0 +1,463 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IR_H
+#define LILY_IR_H
+
+#include <base/str_map.h>
+#include <base/types.h>
+#include <base/writer.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/typecheck.h>
+
+// The checked bodies are lowered to a mid-level IR in SSA form before the C
+// generation: the values are typed virtual registers, defined once, and the
+// control flow is a graph of basic blocks. A block takes parameters instead
+// of phi nodes, the edges which jump to the block pass their values.
+
+// No register: the value of a Unit call, a return without value, ...
+#define IR_NONE ((Usize)-1)
+
+enum IrOp
+{
+    IrOpAdd,
+    IrOpSub,
+    IrOpMul,
+    IrOpDiv,
+    IrOpMod,
+    IrOpLt,
+    IrOpGt,
+    IrOpLe,
+    IrOpGe,
+    IrOpEq,
+    IrOpNe,
+    IrOpXor,
+    IrOpShl,
+    IrOpShr,
+    IrOpBitOr,
+    IrOpBitAnd,
+    IrOpNeg,
+    IrOpNot,
+    IrOpBitNot
+};
+
+enum IrInstKind
+{
+    IrInstKindConst,    // dst = literal
+    IrInstKindCopy,     // dst = args[0]
+    IrInstKindUnary,    // dst = op args[0]
+    IrInstKindBinary,   // dst = args[0] op args[1]
+    IrInstKindCall,     // dst = fun(args), dst is IR_NONE for a Unit function
+    IrInstKindPrint,    // print the args with the format
+    IrInstKindRecord,   // dst = record { args in the order of the fields }
+    IrInstKindField,    // dst = args[0].name
+    IrInstKindSetField, // dst = args[0] with name = args[1]
+    IrInstKindConstant, // dst = the value of the constant
+    IrInstKindBox,      // dst = args[0] in a generic value (see mono.h)
+    IrInstKindUnbox,    // dst = the value of the data type of dst in args[0]
+    IrInstKindVariant,  // dst = the variant of the enum of dst (with the value
+                        // args[0] if the variant has a value)
+    IrInstKindPayload,  // dst = the value of args[0] (of the variant)
+    IrInstKindClosure,  // dst = the lambda with the captured values args
+    IrInstKindCallClosure // dst = args[0](args[1..]), dst is IR_NONE for a
+                          // Unit lambda
+};
+
+typedef struct IrInst
+{
+    enum IrInstKind kind;
+    Usize dst;
+    Usize *args;
+    Usize args_len;
+    bool is_unchecked; // the arithmetic can't overflow or divide by zero (see
+                       // range.h)
+
+    union
+    {
+        struct LiteralSymbol literal; // the Str literals are borrowed
+        enum IrOp op;
+        Usize fun;      // index in the functions of the module (the
+                        // functions of the file, then the instances)
+        Usize record;   // index in the records of the file
+        Usize constant; // index in the constants of the file
+        Usize variant;  // index of the variant in its enum
+        struct
+        {
+            Usize lambda; // index in the lambdas of the module
+            bool is_heap; // the closure escapes: its environment is
+                          // allocated on the heap (see closure.h)
+        } closure;
+        struct
+        {
+            Str format; // Str&
+            bool newline;
+        } print;
+        struct
+        {
+            struct String *name; // struct String&
+            bool is_ptr;         // args[0] points to the record
+        } field;
+    } value;
+} IrInst;
+
+typedef struct IrEdge
+{
+    Usize block;
+    Usize *args; // one per parameter of the block
+    Usize args_len;
+    Usize args_capacity;
+} IrEdge;
+
+// The value is the index of a variant (the tag of an enum) or the value of a
+// Bool, a Char or an integer of at most 64 bits.
+typedef struct IrCase
+{
+    Int64 value;
+    struct IrEdge edge;
+} IrCase;
+
+enum IrTermKind
+{
+    IrTermKindNone, // the block is being built
+    IrTermKindJump,
+    IrTermKindBranch, // value ? edges[0] : edges[1]
+    IrTermKindSwitch, // the edge of the case of value, edges[0] if no case
+                      // has the value
+    IrTermKindReturn, // value is IR_NONE in a Unit function
+    IrTermKindUnreachable
+};
+
+// The edges of a terminator are numbered: a switch has the default edge,
+// then the edge of each case (see get_edge__IrTerm).
+typedef struct IrTerm
+{
+    enum IrTermKind kind;
+    Usize value;
+    struct IrEdge edges[2];
+    struct IrCase *cases; // one per distinct value of a switch
+    Usize cases_len;
+    Usize cases_capacity;
+} IrTerm;
+
+typedef struct IrBlock
+{
+    Usize *params;
+    Usize params_len;
+    Usize params_capacity;
+    struct IrInst *insts;
+    Usize insts_len;
+    Usize insts_capacity;
+    struct IrTerm term;
+} IrBlock;
+
+// The entry is the first block, its parameters are the parameters of the
+// function.
+typedef struct IrFun
+{
+    struct String *name;                // struct String&
+    struct DataTypeSymbol *return_type; // struct DataTypeSymbol& (NULL: Unit)
+    struct DataTypeSymbol **regs; // struct DataTypeSymbol& (type of each
+                                  // register)
+    Usize regs_len;
+    Usize regs_capacity;
+    struct IrBlock *blocks;
+    Usize blocks_len;
+    Usize blocks_capacity;
+} IrFun;
+
+// A value computed at compile time: a literal or a record.
+typedef struct IrValue
+{
+    bool is_record;
+    struct LiteralSymbol literal; // the Str literals are borrowed
+    Usize record;                 // index in the records of the file
+    struct IrValue *fields;       // struct IrValue* (one per field, in the
+                                  // order of the record)
+    Usize fields_len;
+} IrValue;
+
+// The generic params of a function are the data types of its params which
+// are a generic param (T in fun add[T](x T, y T) T) or an implicit generic
+// param (fun twice(x) = x + x). The params of the same generic param share it,
+// each implicit generic param is distinct.
+typedef struct IrGeneric
+{
+    Usize *slots; // one per param of the function: index of its generic param
+                  // (IR_NONE if the data type of the param is concrete)
+    Usize slots_len;
+    struct DataTypeSymbol **params; // struct DataTypeSymbol& (one per generic
+                                    // param, its data type in the function)
+    Usize len;
+    bool is_supported; // a generic param is only the data type of a param or
+                       // of the return (not ?T, []T, ...)
+} IrGeneric;
+
+// A generic function specialized for the data types of its generic params,
+// the instances are cached by the (interned) data types (see mono.h).
+typedef struct IrInstance
+{
+    Usize fun; // index of the generic function in the functions of the file
+    struct DataTypeSymbol **args; // struct DataTypeSymbol& (one per generic
+                                  // param)
+    Usize args_len;
+    Usize id; // index of the instance in the functions of the module
+    struct DataTypeSymbol *return_type; // struct DataTypeSymbol& (NULL: Unit
+                                        // or not known yet)
+    struct String *name; // struct String* (add2__Int32)
+    char *key;           // char* (key of the instance in the cache)
+    Usize key_len;
+    Usize uses;     // number of calls
+    bool is_boxed;  // an arg is a generic param: the instance is shared
+    bool is_demoted; // the calls go to the boxed instance (see
+                     // limit_instances__IrModule)
+} IrInstance;
+
+// The body of a lambda is lowered to a function whose params are the captured
+// values, then the params of the lambda.
+typedef struct IrLambda
+{
+    struct IrFun *fun;   // struct IrFun* (NULL if the lambda is not lowered)
+    struct String *name; // struct String* (main__lambda0)
+    Usize captures_len;
+    struct Location loc; // location of the lambda expression
+} IrLambda;
+
+typedef struct IrModule
+{
+    struct Typecheck *tc; // struct Typecheck&
+    struct IrFun **funs;  // struct IrFun* (one per function of the file, then
+                          // one per instance, NULL if the function is not
+                          // lowered or is generic)
+    Usize funs_len;
+    Usize funs_capacity;
+    Usize file_funs_len; // number of functions of the file
+    struct IrGeneric **generics; // struct IrGeneric* (one per function of the
+                                 // file, NULL if it is not generic)
+    struct IrInstance *instances; // one per function after file_funs_len
+    Usize instances_len;
+    Usize instances_capacity;
+    struct StrMap *instances_cache; // struct StrMap<Usize (instance + 1)>*
+    struct IrFun **consts; // struct IrFun* (one per constant of the file,
+                           // computes its value, NULL for a literal or if the
+                           // constant is not lowered)
+    struct IrValue **values; // struct IrValue* (one per constant of the file,
+                             // NULL if the value is not known at compile time)
+    Usize consts_len;
+    struct IrLambda *lambdas; // one per lowered lambda expression
+    Usize lambdas_len;
+    Usize lambdas_capacity;
+} IrModule;
+
+/**
+ *
+ * @brief Construct the IrModule type: lower the checked functions and
+ * constants of tc. A generic function is lowered once per instance (the data
+ * types of the arguments of its calls). A function is not lowered if its body
+ * uses an expression without IR or if it calls a function which is not
+ * lowered. The tail calls are replaced by jumps (see
+ * eliminate_tail_calls__IrModule). The value of the constants is computed at
+ * compile time when possible (see evaluate_constants__IrModule).
+ * A lambda is lowered to a function of the module, its value is a closure
+ * (see closure.h).
+ */
+struct IrModule *
+__new__IrModule(struct Typecheck *tc);
+
+/**
+ *
+ * @brief Specialize the generic function for the data types of its generic
+ * params (lowered on the first call with these data types).
+ * @return the index of the instance in the functions of the module or IR_NONE
+ * if the instance is not lowered.
+ */
+Usize
+instantiate__IrModule(struct IrModule *self,
+                      Usize fun,
+                      struct DataTypeSymbol **args);
+
+/**
+ *
+ * @return the name of the function of the module (the name of its declaration
+ * or of its instance).
+ */
+struct String *
+get_fun_name__IrModule(const struct IrModule *self, Usize id);
+
+/**
+ *
+ * @return true if the value of the constant is available: the constant is a
+ * literal, its value is computed or it has an initializer.
+ */
+bool
+has_constant__IrModule(const struct IrModule *self, Usize id);
+
+/**
+ *
+ * @return the enum of the data type (NULL if the data type is not an enum of
+ * the file).
+ */
+struct EnumSymbol *
+get_enum__IrModule(const struct IrModule *self,
+                   const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @brief Add a register of the data type to the function.
+ */
+Usize
+add_reg__IrFun(struct IrFun *self, struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @brief Add an empty block to the function.
+ * @note The pointers to the blocks are invalidated.
+ */
+Usize
+add_block__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Push the instruction at the end of the block (take the ownership of
+ * the args).
+ */
+void
+push_inst__IrBlock(struct IrBlock *self, struct IrInst inst);
+
+/**
+ *
+ * @brief Push the param at the end of the block.
+ */
+void
+push_param__IrBlock(struct IrBlock *self, Usize reg);
+
+/**
+ *
+ * @brief Push an argument at the end of the edge.
+ */
+void
+push_arg__IrEdge(struct IrEdge *self, Usize reg);
+
+/**
+ *
+ * @brief Add a case to the switch, its edge is the last edge of the
+ * terminator.
+ */
+void
+push_case__IrTerm(struct IrTerm *self, Int64 value);
+
+/**
+ *
+ * @return the number of edges of the terminator.
+ */
+Usize
+get_edges_len__IrTerm(const struct IrTerm *self);
+
+/**
+ *
+ * @return the edge of the terminator (edges[0], edges[1] or the edge of a
+ * case of a switch).
+ */
+struct IrEdge *
+get_edge__IrTerm(struct IrTerm *self, Usize edge);
+
+/**
+ *
+ * @brief Free the edges of the terminator.
+ */
+void
+__free__IrTerm(struct IrTerm *self);
+
+/**
+ *
+ * @return true if the literal is the value of a case of a switch (a Bool, a
+ * Char or an integer of at most 64 bits).
+ */
+bool
+get_case_value__LiteralSymbol(const struct LiteralSymbol *self, Int64 *value);
+
+/**
+ *
+ * @return the number of instructions of the function.
+ */
+Usize
+count_insts__IrFun(const struct IrFun *self);
+
+/**
+ *
+ * @brief Print the data type as in the IR (Int32, *Point, ...).
+ */
+void
+write__DataTypeSymbol(struct Writer *writer,
+                      const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @brief Print the IR of the module (--emit=ir).
+ */
+void
+write__IrModule(const struct IrModule *self, struct Writer *writer);
+
+/**
+ *
+ * @return a deep copy of the value.
+ */
+struct IrValue *
+clone__IrValue(const struct IrValue *self);
+
+/**
+ *
+ * @brief Free the IrValue type.
+ */
+void
+__free__IrValue(struct IrValue *self);
+
+/**
+ *
+ * @brief Free the instruction (its args).
+ */
+void
+__free__IrInst(struct IrInst *self);
+
+/**
+ *
+ * @brief Free the block (its instructions and its edges).
+ */
+void
+__free__IrBlock(struct IrBlock *self);
+
+/**
+ *
+ * @brief Free the IrFun type.
+ */
+void
+__free__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Free the IrModule type.
+ */
+void
+__free__IrModule(struct IrModule *self);
+
+#endif // LILY_IR_H
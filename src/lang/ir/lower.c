@@ -0,0 +1,2216 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/format.h>
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/ir/closure.h>
+#include <lang/ir/eval.h>
+#include <lang/ir/ir.h>
+#include <lang/ir/mono.h>
+#include <lang/ir/tail.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The SSA form is built while the body is walked (Braun et al., "Simple and
+// Efficient Construction of Static Single Assignment Form"): the last value
+// written in a local is recorded per block, a read in a block without write
+// looks for the value in the predecessors and adds a block parameter where
+// several values meet. A block is sealed when all its predecessors are known,
+// the reads in a block which is not sealed (a loop header) add a parameter
+// which receives its arguments when the block is sealed.
+
+typedef struct IrVar
+{
+    struct String *name; // struct String&
+    Usize depth;
+    Usize id;
+    struct DataTypeSymbol *data_type; // struct DataTypeSymbol&
+    Usize next; // next local in the same slot (a sibling scope) or IR_NONE
+} IrVar;
+
+// The locals of a depth, indexed by their slot (see LocalScopeChain).
+typedef struct IrSlots
+{
+    Usize *vars; // first local in the slot or IR_NONE
+    Usize len;
+} IrSlots;
+
+typedef struct IrDef
+{
+    Usize var;
+    Usize reg;
+} IrDef;
+
+typedef struct IrDefs
+{
+    struct IrDef *items;
+    Usize len;
+    Usize capacity;
+} IrDefs;
+
+typedef struct IrPreds
+{
+    Usize *blocks;
+    Usize *edges; // edge of the terminator of the predecessor
+    Usize len;
+    Usize capacity;
+} IrPreds;
+
+// A row of the pattern matrix of a match statement: the pattern of the arm
+// for each tested value (see lower_match) and the names bound by the tests
+// already done.
+typedef struct IrMatchRow
+{
+    struct ExprSymbol **patterns; // struct ExprSymbol& (NULL: any value)
+    struct IrDefs bindings;
+    Usize arm;
+} IrMatchRow;
+
+typedef struct IrMatch
+{
+    struct Vec *arms; // struct Vec<struct Tuple<pattern, guard, body>*>&
+    Usize *blocks;    // block of the body of each arm
+    Usize exit;       // block reached when no arm matches
+} IrMatch;
+
+typedef struct IrLoop
+{
+    Usize header; // next
+    Usize exit;   // break
+} IrLoop;
+
+typedef struct IrBuilder
+{
+    struct IrModule *module;
+    struct IrFun *fun;
+    Usize block; // block where the instructions are pushed
+    struct IrVar *vars;
+    Usize vars_len;
+    Usize vars_capacity;
+    struct IrSlots *slots; // one per depth
+    Usize slots_len;
+    // One per block of the function.
+    struct IrDefs *defs;       // last value of the locals written in the block
+    struct IrDefs *incomplete; // parameters added before the block is sealed
+    struct IrPreds *preds;
+    bool *sealed;
+    Usize blocks_capacity;
+    struct IrLoop *loops;
+    Usize loops_len;
+    Usize loops_capacity;
+    bool failed; // the body has an expression without IR
+    // The instance of a generic function being lowered.
+    const struct IrGeneric *generic; // struct IrGeneric& (NULL if the function
+                                     // is not generic)
+    struct DataTypeSymbol **args;    // struct DataTypeSymbol& (one per generic
+                                     // param)
+    bool is_boxed; // a generic param is boxed
+} IrBuilder;
+
+// The declarations of a file without declaration of this kind are NULL.
+static inline Usize
+get_len(struct Vec *decls)
+{
+    return decls ? len__Vec(*decls) : 0;
+}
+
+static inline struct DataTypeSymbol *
+strip_mut(struct DataTypeSymbol *data_type)
+{
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    return data_type;
+}
+
+static inline bool
+is_known(struct DataTypeSymbol *data_type)
+{
+    return data_type && data_type->kind != DataTypeKindCompilerDefined;
+}
+
+static inline bool
+is_void(struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    return !data_type || data_type->kind == DataTypeKindUnit ||
+           data_type->kind == DataTypeKindNever;
+}
+
+static inline bool
+is_top_level(struct Scope *scope, struct Scope *symbol_scope)
+{
+    return symbol_scope && !symbol_scope->previous &&
+           eq__String(scope->name, symbol_scope->name, false);
+}
+
+static Isize
+search_fun(struct Typecheck *tc, struct Scope *scope)
+{
+    for (Usize i = 0; i < get_len(tc->funs); i++) {
+        struct FunSymbol *fun = get__Vec(*tc->funs, i);
+
+        if (fun->scope && fun->scope->id == scope->id &&
+            is_top_level(scope, fun->scope))
+            return i;
+    }
+
+    return -1;
+}
+
+static Isize
+search_const(struct Typecheck *tc, struct Scope *scope)
+{
+    for (Usize i = 0; i < get_len(tc->consts); i++)
+        if (is_top_level(
+              scope,
+              ((struct ConstantSymbol *)get__Vec(*tc->consts, i))->scope))
+            return i;
+
+    return -1;
+}
+
+static Isize
+search_record(struct Typecheck *tc, struct Scope *scope)
+{
+    if (!scope || scope->item_kind != ScopeItemKindRecord)
+        return -1;
+
+    for (Usize i = 0; i < get_len(tc->records); i++)
+        if (is_top_level(
+              scope,
+              ((struct RecordSymbol *)get__Vec(*tc->records, i))->scope))
+            return i;
+
+    return -1;
+}
+
+static Usize
+new_block(struct IrBuilder *self)
+{
+    Usize block = add_block__IrFun(self->fun);
+
+    if (block == self->blocks_capacity) {
+        self->blocks_capacity =
+          self->blocks_capacity ? self->blocks_capacity * 2 : 8;
+        self->defs = realloc(self->defs,
+                             self->blocks_capacity * sizeof(struct IrDefs));
+        self->incomplete = realloc(
+          self->incomplete, self->blocks_capacity * sizeof(struct IrDefs));
+        self->preds = realloc(self->preds,
+                              self->blocks_capacity * sizeof(struct IrPreds));
+        self->sealed =
+          realloc(self->sealed, self->blocks_capacity * sizeof(bool));
+    }
+
+    self->defs[block] = (struct IrDefs){ 0 };
+    self->incomplete[block] = (struct IrDefs){ 0 };
+    self->preds[block] = (struct IrPreds){ 0 };
+    self->sealed[block] = false;
+
+    return block;
+}
+
+static void
+push_def(struct IrDefs *defs, Usize var, Usize reg)
+{
+    if (defs->len == defs->capacity) {
+        defs->capacity = defs->capacity ? defs->capacity * 2 : 8;
+        defs->items =
+          realloc(defs->items, defs->capacity * sizeof(struct IrDef));
+    }
+
+    defs->items[defs->len++] = (struct IrDef){ .var = var, .reg = reg };
+}
+
+static void
+push_pred(struct IrPreds *preds, Usize block, Usize edge)
+{
+    if (preds->len == preds->capacity) {
+        preds->capacity = preds->capacity ? preds->capacity * 2 : 4;
+        preds->blocks =
+          realloc(preds->blocks, preds->capacity * sizeof(Usize));
+        preds->edges = realloc(preds->edges, preds->capacity * sizeof(Usize));
+    }
+
+    preds->blocks[preds->len] = block;
+    preds->edges[preds->len++] = edge;
+}
+
+static inline struct IrBlock *
+get_block(struct IrBuilder *self, Usize block)
+{
+    return &self->fun->blocks[block];
+}
+
+static Usize
+fail(struct IrBuilder *self);
+
+// A value of a generic data type is only held by a boxed instance.
+static Usize
+new_reg(struct IrBuilder *self, struct DataTypeSymbol *data_type)
+{
+    if (has_generic__DataTypeSymbol(data_type) &&
+        !(self->is_boxed && is_generic__DataTypeSymbol(data_type)))
+        fail(self);
+
+    return add_reg__IrFun(self->fun, data_type);
+}
+
+// The data type in the instance: T is the data type of the generic param, the
+// implicit generic params are unknown (the data type of the value is used).
+static struct DataTypeSymbol *
+resolve(struct IrBuilder *self, struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    if (!self->generic || !is_generic__DataTypeSymbol(data_type))
+        return data_type;
+    else if (data_type->kind == DataTypeKindCustom)
+        for (Usize i = 0; i < self->generic->len; i++)
+            if (self->generic->params[i] == data_type)
+                return self->args[i];
+
+    return NULL;
+}
+
+// The operators, the prints and the branches do not apply to a boxed value.
+static inline bool
+is_boxed(struct IrBuilder *self, Usize reg)
+{
+    return reg != IR_NONE &&
+           is_generic__DataTypeSymbol(strip_mut(self->fun->regs[reg]));
+}
+
+static Usize *
+copy_args(const Usize *args, Usize len)
+{
+    if (!len)
+        return NULL;
+
+    Usize *copy = malloc(len * sizeof(Usize));
+
+    memcpy(copy, args, len * sizeof(Usize));
+
+    return copy;
+}
+
+static void
+push_inst(struct IrBuilder *self, struct IrInst inst)
+{
+    push_inst__IrBlock(get_block(self, self->block), inst);
+}
+
+static inline struct IrInst *
+last_inst(struct IrBuilder *self)
+{
+    struct IrBlock *block = get_block(self, self->block);
+
+    return &block->insts[block->insts_len - 1];
+}
+
+static Usize
+push_value(struct IrBuilder *self,
+           enum IrInstKind kind,
+           struct DataTypeSymbol *data_type,
+           const Usize *args,
+           Usize args_len)
+{
+    Usize dst = new_reg(self, data_type);
+
+    push_inst(self,
+              (struct IrInst){ .kind = kind,
+                               .dst = dst,
+                               .args = copy_args(args, args_len),
+                               .args_len = args_len });
+
+    return dst;
+}
+
+static void
+set_edge(struct IrBuilder *self,
+         Usize from,
+         Usize edge,
+         Usize to,
+         const Usize *args,
+         Usize args_len)
+{
+    struct IrEdge *ir_edge =
+      get_edge__IrTerm(&get_block(self, from)->term, edge);
+
+    ir_edge->block = to;
+
+    for (Usize i = 0; i < args_len; i++)
+        push_arg__IrEdge(ir_edge, args[i]);
+
+    push_pred(&self->preds[to], from, edge);
+}
+
+static void
+jump(struct IrBuilder *self, Usize to, const Usize *args, Usize args_len)
+{
+    get_block(self, self->block)->term.kind = IrTermKindJump;
+    set_edge(self, self->block, 0, to, args, args_len);
+}
+
+static void
+branch(struct IrBuilder *self, Usize cond, Usize then, Usize else_)
+{
+    struct IrTerm *term = &get_block(self, self->block)->term;
+
+    if (is_boxed(self, cond))
+        fail(self);
+
+    term->kind = IrTermKindBranch;
+    term->value = cond;
+    set_edge(self, self->block, 0, then, NULL, 0);
+    set_edge(self, self->block, 1, else_, NULL, 0);
+}
+
+static inline bool
+is_terminated(struct IrBuilder *self)
+{
+    return get_block(self, self->block)->term.kind != IrTermKindNone;
+}
+
+static void
+seal(struct IrBuilder *self, Usize block);
+
+// The code which follows a return, a break or a next is lowered in a block
+// without predecessor (removed by the simplification of the CFG).
+static void
+start_dead_block(struct IrBuilder *self)
+{
+    self->block = new_block(self);
+    seal(self, self->block);
+}
+
+static struct IrSlots *
+get_slots(struct IrBuilder *self, Usize depth, Usize id)
+{
+    if (depth >= self->slots_len) {
+        self->slots =
+          realloc(self->slots, (depth + 1) * sizeof(struct IrSlots));
+        memset(self->slots + self->slots_len,
+               0,
+               (depth + 1 - self->slots_len) * sizeof(struct IrSlots));
+        self->slots_len = depth + 1;
+    }
+
+    struct IrSlots *slots = &self->slots[depth];
+
+    if (id >= slots->len) {
+        Usize len = id + 1 > slots->len * 2 ? id + 1 : slots->len * 2;
+
+        slots->vars = realloc(slots->vars, len * sizeof(Usize));
+
+        for (Usize i = slots->len; i < len; i++)
+            slots->vars[i] = IR_NONE;
+
+        slots->len = len;
+    }
+
+    return slots;
+}
+
+// A local is found by its (depth, slot) pair. The scopes of the same depth
+// (the branches of an if) reuse the slots, so the name is still compared.
+static Usize
+get_var(struct IrBuilder *self, struct Scope *scope)
+{
+    struct IrSlots *slots = get_slots(self, scope->depth, scope->id);
+
+    for (Usize i = slots->vars[scope->id]; i != IR_NONE; i = self->vars[i].next)
+        if (eq__String(self->vars[i].name, scope->name, false))
+            return i;
+
+    if (self->vars_len == self->vars_capacity) {
+        self->vars_capacity =
+          self->vars_capacity ? self->vars_capacity * 2 : 8;
+        self->vars =
+          realloc(self->vars, self->vars_capacity * sizeof(struct IrVar));
+    }
+
+    struct DataTypeSymbol *data_type = resolve(self, scope->data_type);
+
+    self->vars[self->vars_len] =
+      (struct IrVar){ .name = scope->name,
+                      .depth = scope->depth,
+                      .id = scope->id,
+                      .data_type = is_known(data_type) ? data_type : NULL,
+                      .next = slots->vars[scope->id] };
+    slots->vars[scope->id] = self->vars_len;
+
+    return self->vars_len++;
+}
+
+static void
+write_var(struct IrBuilder *self, Usize block, Usize var, Usize reg)
+{
+    struct IrDefs *defs = &self->defs[block];
+
+    if (!self->vars[var].data_type)
+        self->vars[var].data_type = self->fun->regs[reg];
+
+    for (Usize i = 0; i < defs->len; i++)
+        if (defs->items[i].var == var) {
+            defs->items[i].reg = reg;
+            return;
+        }
+
+    push_def(defs, var, reg);
+}
+
+static Usize
+read_var(struct IrBuilder *self, Usize block, Usize var);
+
+// Pass the value of the local from each predecessor to the parameter.
+static void
+add_param_args(struct IrBuilder *self, Usize block, Usize var)
+{
+    for (Usize i = 0; i < self->preds[block].len; i++) {
+        Usize pred = self->preds[block].blocks[i];
+        Usize value = read_var(self, pred, var);
+
+        push_arg__IrEdge(get_edge__IrTerm(&get_block(self, pred)->term,
+                                          self->preds[block].edges[i]),
+                         value);
+    }
+}
+
+static Usize
+read_var(struct IrBuilder *self, Usize block, Usize var)
+{
+    struct IrDefs *defs = &self->defs[block];
+
+    for (Usize i = 0; i < defs->len; i++)
+        if (defs->items[i].var == var)
+            return defs->items[i].reg;
+
+    Usize reg;
+
+    if (!self->sealed[block]) {
+        reg = new_reg(self, self->vars[var].data_type);
+        push_param__IrBlock(get_block(self, block), reg);
+        push_def(&self->incomplete[block], var, reg);
+    } else if (self->preds[block].len == 1)
+        reg = read_var(self, self->preds[block].blocks[0], var);
+    else {
+        // The parameter is written before the arguments are read, so a loop
+        // reaches it instead of adding another parameter.
+        reg = new_reg(self, self->vars[var].data_type);
+        push_param__IrBlock(get_block(self, block), reg);
+        write_var(self, block, var, reg);
+        add_param_args(self, block, var);
+    }
+
+    write_var(self, block, var, reg);
+
+    return reg;
+}
+
+static void
+seal(struct IrBuilder *self, Usize block)
+{
+    struct IrDefs *incomplete = &self->incomplete[block];
+
+    for (Usize i = 0; i < incomplete->len; i++)
+        add_param_args(self, block, incomplete->items[i].var);
+
+    self->sealed[block] = true;
+}
+
+static Usize
+lower_expr(struct IrBuilder *self, struct ExprSymbol *expr);
+
+static void
+lower_body(struct IrBuilder *self, struct Vec *body, bool is_value);
+
+static Usize
+fail(struct IrBuilder *self)
+{
+    self->failed = true;
+
+    return IR_NONE;
+}
+
+static Usize
+lower_literal(struct IrBuilder *self, struct ExprSymbol *expr)
+{
+    struct LiteralSymbol literal = expr->value.literal;
+    struct DataTypeSymbol *data_type = resolve(self, expr->data_type);
+
+    if (literal.kind == LiteralSymbolKindUnit)
+        return IR_NONE;
+    else if (literal.kind == LiteralSymbolKindBitStr)
+        return fail(self);
+
+    if (!is_known(data_type))
+        data_type = strip_mut(literal.data_type);
+
+    Usize dst = new_reg(self, data_type);
+
+    push_inst(self,
+              (struct IrInst){ .kind = IrInstKindConst,
+                               .dst = dst,
+                               .value.literal = literal });
+
+    return dst;
+}
+
+static Usize
+lower_value_name(struct IrBuilder *self, struct Scope *scope)
+{
+    switch (scope->item_kind) {
+        case ScopeItemKindVariable:
+        case ScopeItemKindParam:
+            return read_var(self, self->block, get_var(self, scope));
+        case ScopeItemKindConstant: {
+            Isize id = search_const(self->module->tc, scope);
+
+            if (id == -1)
+                return fail(self);
+
+            struct ConstantSymbol *constant =
+              get__Vec(*self->module->tc->consts, id);
+            Usize dst = new_reg(self, strip_mut(constant->data_type));
+
+            push_inst(self,
+                      (struct IrInst){ .kind = IrInstKindConstant,
+                                       .dst = dst,
+                                       .value.constant = id });
+
+            return dst;
+        }
+        default:
+            return fail(self);
+    }
+}
+
+static inline bool
+is_ptr(struct DataTypeSymbol *data_type)
+{
+    data_type = strip_mut(data_type);
+
+    return data_type && (data_type->kind == DataTypeKindPtr ||
+                         data_type->kind == DataTypeKindRef);
+}
+
+static Usize
+lower_field(struct IrBuilder *self, Usize value, struct Scope *field)
+{
+    struct DataTypeSymbol *data_type = resolve(self, field->data_type);
+
+    if (!is_known(data_type) || is_boxed(self, value))
+        return fail(self);
+
+    Usize dst = new_reg(self, data_type);
+
+    push_inst(self,
+              (struct IrInst){
+                .kind = IrInstKindField,
+                .dst = dst,
+                .args = copy_args(&value, 1),
+                .args_len = 1,
+                .value.field = { .name = field->name,
+                                 .is_ptr = is_ptr(self->fun->regs[value]) } });
+
+    return dst;
+}
+
+static Usize
+lower_identifier_access(struct IrBuilder *self, struct Scope *scope)
+{
+    if (!scope->previous)
+        return lower_value_name(self, scope);
+
+    Usize value = lower_identifier_access(self, scope->previous);
+
+    return self->failed ? IR_NONE : lower_field(self, value, scope);
+}
+
+// p.a.x = v -> p = setfield(p, a, setfield(p.a, x, v)): the records are
+// values, the assignment of a field builds a new record.
+static void
+assign_field(struct IrBuilder *self, struct Scope *scope, Usize value)
+{
+    if (!scope->previous) {
+        if (scope->item_kind != ScopeItemKindVariable &&
+            scope->item_kind != ScopeItemKindParam) {
+            fail(self);
+            return;
+        }
+
+        write_var(self, self->block, get_var(self, scope), value);
+        return;
+    }
+
+    Usize record = lower_identifier_access(self, scope->previous);
+
+    // The assignment through a pointer writes in memory: not lowered.
+    if (self->failed || is_ptr(self->fun->regs[record])) {
+        fail(self);
+        return;
+    }
+
+    Usize args[2] = { record, value };
+    Usize dst = push_value(
+      self, IrInstKindSetField, self->fun->regs[record], args, 2);
+
+    last_inst(self)->value.field.name = scope->name;
+    last_inst(self)->value.field.is_ptr = false;
+
+    assign_field(self, scope->previous, dst);
+}
+
+static void
+assign(struct IrBuilder *self, struct ExprSymbol *left, Usize value)
+{
+    if (value == IR_NONE) {
+        fail(self);
+        return;
+    }
+
+    switch (left->kind) {
+        case ExprKindIdentifier:
+            assign_field(self, left->value.identifier, value);
+            break;
+        case ExprKindIdentifierAccess:
+            assign_field(self, left->value.identifier_access, value);
+            break;
+        default:
+            fail(self);
+    }
+}
+
+// Return false if the operator has no IR.
+static bool
+get_op(enum BinaryOpKind kind, enum IrOp *op, bool *is_assign)
+{
+    *is_assign = true;
+
+    switch (kind) {
+        case BinaryOpKindAdd:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindAddAssign:
+            *op = IrOpAdd;
+            return true;
+        case BinaryOpKindSub:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindSubAssign:
+            *op = IrOpSub;
+            return true;
+        case BinaryOpKindMul:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindMulAssign:
+            *op = IrOpMul;
+            return true;
+        case BinaryOpKindDiv:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindDivAssign:
+            *op = IrOpDiv;
+            return true;
+        case BinaryOpKindMod:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindModAssign:
+            *op = IrOpMod;
+            return true;
+        case BinaryOpKindXor:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindXorAssign:
+            *op = IrOpXor;
+            return true;
+        case BinaryOpKindBitLShift:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindBitLShiftAssign:
+            *op = IrOpShl;
+            return true;
+        case BinaryOpKindBitRShift:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindBitRShiftAssign:
+            *op = IrOpShr;
+            return true;
+        case BinaryOpKindBitOr:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindBitOrAssign:
+            *op = IrOpBitOr;
+            return true;
+        case BinaryOpKindBitAnd:
+            *is_assign = false;
+            // fall through
+        case BinaryOpKindBitAndAssign:
+            *op = IrOpBitAnd;
+            return true;
+        default:
+            break;
+    }
+
+    *is_assign = false;
+
+    switch (kind) {
+        case BinaryOpKindLt:
+            *op = IrOpLt;
+            return true;
+        case BinaryOpKindGt:
+            *op = IrOpGt;
+            return true;
+        case BinaryOpKindLe:
+            *op = IrOpLe;
+            return true;
+        case BinaryOpKindGe:
+            *op = IrOpGe;
+            return true;
+        case BinaryOpKindEq:
+            *op = IrOpEq;
+            return true;
+        case BinaryOpKindNe:
+            *op = IrOpNe;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static struct DataTypeSymbol *
+get_bool(struct IrBuilder *self)
+{
+    return NEW(DataTypeSymbol, self->module->tc->types, DataTypeKindBool);
+}
+
+// x and y -> br x, bb_y, bb_join(x); bb_y: jmp bb_join(y)
+static Usize
+lower_logical_op(struct IrBuilder *self, struct BinaryOpSymbol binary_op)
+{
+    Usize left = lower_expr(self, binary_op.left);
+
+    if (self->failed || is_boxed(self, left))
+        return fail(self);
+
+    Usize right_block = new_block(self);
+    Usize join = new_block(self);
+    Usize result = new_reg(self, self->fun->regs[left]);
+    struct IrTerm *term = &get_block(self, self->block)->term;
+
+    push_param__IrBlock(get_block(self, join), result);
+    term->kind = IrTermKindBranch;
+    term->value = left;
+
+    if (binary_op.kind == BinaryOpKindAnd) {
+        set_edge(self, self->block, 0, right_block, NULL, 0);
+        set_edge(self, self->block, 1, join, &left, 1);
+    } else {
+        set_edge(self, self->block, 0, join, &left, 1);
+        set_edge(self, self->block, 1, right_block, NULL, 0);
+    }
+
+    seal(self, right_block);
+    self->block = right_block;
+
+    Usize right = lower_expr(self, binary_op.right);
+
+    if (self->failed || is_boxed(self, right))
+        return fail(self);
+
+    jump(self, join, &right, 1);
+    seal(self, join);
+    self->block = join;
+
+    return result;
+}
+
+static Usize
+lower_binary_op(struct IrBuilder *self,
+                struct ExprSymbol *expr,
+                struct BinaryOpSymbol binary_op)
+{
+    if (binary_op.kind == BinaryOpKindAnd || binary_op.kind == BinaryOpKindOr)
+        return lower_logical_op(self, binary_op);
+
+    if (binary_op.kind == BinaryOpKindAssign) {
+        assign(self, binary_op.left, lower_expr(self, binary_op.right));
+
+        return IR_NONE;
+    }
+
+    enum IrOp op;
+    bool is_assign;
+
+    if (!get_op(binary_op.kind, &op, &is_assign))
+        return fail(self);
+
+    Usize args[2] = { lower_expr(self, binary_op.left), IR_NONE };
+
+    if (!self->failed)
+        args[1] = lower_expr(self, binary_op.right);
+
+    if (self->failed || args[0] == IR_NONE || args[1] == IR_NONE ||
+        is_boxed(self, args[0]) || is_boxed(self, args[1]))
+        return fail(self);
+
+    struct DataTypeSymbol *data_type;
+
+    if (op >= IrOpLt && op <= IrOpNe) {
+        data_type = resolve(self, expr->data_type);
+
+        if (!is_known(data_type))
+            data_type = get_bool(self);
+    } else {
+        data_type = self->fun->regs[args[0]];
+
+        if (!is_known(data_type))
+            data_type = self->fun->regs[args[1]];
+    }
+
+    Usize dst = push_value(self, IrInstKindBinary, data_type, args, 2);
+
+    last_inst(self)->value.op = op;
+
+    if (is_assign) {
+        assign(self, binary_op.left, dst);
+
+        return IR_NONE;
+    }
+
+    return dst;
+}
+
+static Usize
+lower_unary_op(struct IrBuilder *self, struct UnaryOpSymbol unary_op)
+{
+    enum IrOp op;
+
+    switch (unary_op.kind) {
+        case UnaryOpKindNegative:
+            op = IrOpNeg;
+            break;
+        case UnaryOpKindNot:
+            op = IrOpNot;
+            break;
+        case UnaryOpKindBitNot:
+            op = IrOpBitNot;
+            break;
+        default:
+            return fail(self);
+    }
+
+    Usize right = lower_expr(self, unary_op.right);
+
+    if (self->failed || right == IR_NONE || is_boxed(self, right))
+        return fail(self);
+
+    Usize dst =
+      push_value(self, IrInstKindUnary, self->fun->regs[right], &right, 1);
+
+    last_inst(self)->value.op = op;
+
+    return dst;
+}
+
+static Usize *
+lower_args(struct IrBuilder *self, struct Vec *params, Usize start)
+{
+    Usize len = get_len(params);
+    Usize *args = len > start ? malloc((len - start) * sizeof(Usize)) : NULL;
+
+    for (Usize i = start; i < len && !self->failed; i++) {
+        args[i - start] =
+          lower_expr(self, ((struct Tuple *)get__Vec(*params, i))->items[0]);
+
+        if (args[i - start] == IR_NONE)
+            fail(self);
+    }
+
+    return args;
+}
+
+static Usize
+lower_print(struct IrBuilder *self, struct FunCallSymbol fun_call, bool newline)
+{
+    if (get_len(fun_call.params) == 0)
+        return fail(self);
+
+    struct ExprSymbol *format =
+      ((struct Tuple *)get__Vec(*fun_call.params, 0))->items[0];
+
+    if (format->kind != ExprKindLiteral ||
+        format->value.literal.kind != LiteralSymbolKindStr)
+        return fail(self);
+
+    Usize *args = lower_args(self, fun_call.params, 1);
+
+    for (Usize i = 0; i + 1 < len__Vec(*fun_call.params) && !self->failed;
+         i++)
+        if (is_boxed(self, args[i]))
+            fail(self);
+
+    push_inst(
+      self,
+      (struct IrInst){ .kind = IrInstKindPrint,
+                       .dst = IR_NONE,
+                       .args = args,
+                       .args_len = len__Vec(*fun_call.params) - 1,
+                       .value.print = {
+                         .format = format->value.literal.value.str,
+                         .newline = newline } });
+
+    return IR_NONE;
+}
+
+// The generic params of the callee are bound by the data types of the
+// arguments: add2(1, 2) calls add2__Int32.
+static Usize
+instantiate_call(struct IrBuilder *self, Usize fun, Usize *args, Usize len)
+{
+    const struct IrGeneric *generic = self->module->generics[fun];
+
+    if (!generic->is_supported || len != generic->slots_len)
+        return IR_NONE;
+
+    struct DataTypeSymbol **params =
+      malloc(sizeof(struct DataTypeSymbol *) * (len + 1));
+    struct DataTypeSymbol **bound =
+      malloc(sizeof(struct DataTypeSymbol *) * (generic->len + 1));
+
+    for (Usize i = 0; i < len; i++)
+        params[i] = strip_mut(self->fun->regs[args[i]]);
+
+    Usize callee = bind__IrGeneric(generic, params, bound)
+                     ? instantiate__IrModule(self->module, fun, bound)
+                     : IR_NONE;
+
+    if (callee != IR_NONE)
+        self->module->instances[callee - self->module->file_funs_len].uses++;
+
+    free(params);
+    free(bound);
+
+    return callee;
+}
+
+// The callee is the first argument: %f(%x) is callclosure %f, %x.
+static Usize
+lower_closure_call(struct IrBuilder *self,
+                   Usize closure,
+                   const Usize *args,
+                   Usize len)
+{
+    if (closure == IR_NONE || self->failed)
+        return fail(self);
+
+    struct DataTypeSymbol *data_type = strip_mut(self->fun->regs[closure]);
+
+    if (data_type->kind != DataTypeKindLambda)
+        return fail(self);
+
+    struct DataTypeSymbol *return_type = data_type->value.lambda->items[1];
+    Usize *call_args = malloc((len + 1) * sizeof(Usize));
+
+    call_args[0] = closure;
+
+    if (len)
+        memcpy(call_args + 1, args, len * sizeof(Usize));
+
+    Usize dst =
+      is_void(return_type) ? IR_NONE : new_reg(self, strip_mut(return_type));
+
+    push_inst(self,
+              (struct IrInst){ .kind = IrInstKindCallClosure,
+                               .dst = dst,
+                               .args = call_args,
+                               .args_len = len + 1 });
+
+    return dst;
+}
+
+static Usize
+lower_fun_call(struct IrBuilder *self, struct FunCallSymbol fun_call)
+{
+    if (fun_call.is_builtin) {
+        Str name = to_Str__String(*fun_call.id->name);
+        Usize result = !strcmp(name, "println") || !strcmp(name, "print")
+                         ? lower_print(self, fun_call, !strcmp(name, "println"))
+                         : fail(self);
+
+        free(name);
+
+        return result;
+    } else if (fun_call.id->item_kind == ScopeItemKindVariable ||
+               fun_call.id->item_kind == ScopeItemKindParam) {
+        // The local value holds a closure.
+        Usize closure = lower_value_name(self, fun_call.id);
+        Usize *args = lower_args(self, fun_call.params, 0);
+        Usize dst = lower_closure_call(
+          self, closure, args, get_len(fun_call.params));
+
+        free(args);
+
+        return dst;
+    }
+
+    Isize id = search_fun(self->module->tc, fun_call.id);
+
+    if (id == -1)
+        return fail(self);
+
+    struct FunSymbol *fun = get__Vec(*self->module->tc->funs, id);
+    Usize *args = lower_args(self, fun_call.params, 0);
+    Usize callee = id;
+    struct DataTypeSymbol *return_type =
+      is_void(fun->return_type) ? NULL : strip_mut(fun->return_type);
+
+    if (self->module->generics[id] && !self->failed) {
+        callee = instantiate_call(self, id, args, get_len(fun_call.params));
+
+        // The return of an implicit generic function is not known while its
+        // recursive instance is lowered.
+        if (callee == IR_NONE ||
+            (return_type &&
+             !self->module->instances[callee - self->module->file_funs_len]
+                .return_type))
+            fail(self);
+        else if (return_type)
+            return_type =
+              self->module->instances[callee - self->module->file_funs_len]
+                .return_type;
+    }
+
+    Usize dst =
+      !return_type || self->failed ? IR_NONE : new_reg(self, return_type);
+
+    push_inst(self,
+              (struct IrInst){ .kind = IrInstKindCall,
+                               .dst = dst,
+                               .args = args,
+                               .args_len = get_len(fun_call.params),
+                               .value.fun = callee });
+
+    return dst;
+}
+
+// The fields are passed in the order of the record, with the default values of
+// the missing ones.
+static Usize
+lower_record_call(struct IrBuilder *self,
+                  struct ExprSymbol *expr,
+                  struct RecordCallSymbol record_call)
+{
+    Isize id = search_record(self->module->tc, &record_call.id);
+    struct DataTypeSymbol *data_type = resolve(self, expr->data_type);
+
+    if (id == -1 || !record_call.fields || !is_known(data_type))
+        return fail(self);
+
+    struct RecordSymbol *record = get__Vec(*self->module->tc->records, id);
+
+    if (record->generic_params)
+        return fail(self);
+
+    Usize len = get_len(record->fields);
+    Usize *args = len ? malloc(len * sizeof(Usize)) : NULL;
+
+    for (Usize i = 0; i < len && !self->failed; i++) {
+        struct FieldRecordSymbol *field =
+          ((struct SymbolTable *)get__Vec(*record->fields, i))->value.field;
+        struct ExprSymbol *value = field->value;
+
+        for (Usize j = 0; j < len__Vec(*record_call.fields); j++) {
+            struct FieldCallSymbol *field_call =
+              ((struct Tuple *)get__Vec(*record_call.fields, j))->items[0];
+
+            if (eq__String(field_call->name, field->name, false)) {
+                value = field_call->value;
+                break;
+            }
+        }
+
+        args[i] = value ? lower_expr(self, value) : fail(self);
+
+        if (args[i] == IR_NONE || is_boxed(self, args[i]))
+            fail(self);
+    }
+
+    Usize dst = new_reg(self, data_type);
+
+    push_inst(self,
+              (struct IrInst){ .kind = IrInstKindRecord,
+                               .dst = dst,
+                               .args = args,
+                               .args_len = len,
+                               .value.record = id });
+
+    return dst;
+}
+
+// Color.Red -> variant Red, Shape.Circle:r -> variant Circle %r
+static Usize
+lower_variant(struct IrBuilder *self, struct ExprSymbol *expr)
+{
+    struct VariantSymbol variant = expr->value.variant;
+    struct DataTypeSymbol *data_type = resolve(self, expr->data_type);
+    struct EnumSymbol *enum_ = get_enum__IrModule(self->module, data_type);
+    Usize value = IR_NONE;
+
+    if (!enum_ || enum_->generic_params)
+        return fail(self);
+
+    if (variant.value) {
+        value = lower_expr(self, variant.value);
+
+        if (value == IR_NONE || is_boxed(self, value))
+            return fail(self);
+    }
+
+    Usize dst = push_value(
+      self, IrInstKindVariant, data_type, &value, variant.value ? 1 : 0);
+
+    last_inst(self)->value.variant = variant.id.id;
+
+    return dst;
+}
+
+static struct IrBuilder
+new_builder(struct IrModule *module,
+            struct String *name,
+            struct DataTypeSymbol *return_type);
+
+static struct IrFun *
+finish(struct IrBuilder *self);
+
+static Usize
+add_lambda(struct IrModule *self,
+           struct String *fun_name,
+           struct Location loc)
+{
+    if (self->lambdas_len == self->lambdas_capacity) {
+        self->lambdas_capacity =
+          self->lambdas_capacity ? self->lambdas_capacity * 2 : 4;
+        self->lambdas = realloc(
+          self->lambdas, self->lambdas_capacity * sizeof(struct IrLambda));
+    }
+
+    self->lambdas[self->lambdas_len] = (struct IrLambda){
+        .fun = NULL,
+        .name = format("{S}__lambda{d}", fun_name, (int)self->lambdas_len),
+        .captures_len = 0,
+        .loc = loc
+    };
+
+    return self->lambdas_len++;
+}
+
+// The body of the lambda is lowered to a function of the module whose first
+// params are the captured values: fun (x Int32) -> (x + k) in main is
+// main__lambda0(k, x), its value is the closure of main__lambda0 with %k.
+static Usize
+lower_lambda(struct IrBuilder *self,
+             struct LambdaSymbol lambda,
+             struct Location loc)
+{
+    struct DataTypeSymbol *data_type = resolve(self, lambda.data_type);
+    Usize captures_len = get_len(lambda.captures);
+    Usize *captures =
+      captures_len ? malloc(captures_len * sizeof(Usize)) : NULL;
+
+    if (!is_known(data_type))
+        fail(self);
+
+    for (Usize i = 0; i < captures_len && !self->failed; i++)
+        if ((captures[i] = lower_value_name(
+               self, get__Vec(*lambda.captures, i))) == IR_NONE ||
+            is_boxed(self, captures[i]))
+            fail(self);
+
+    if (self->failed) {
+        free(captures);
+        return IR_NONE;
+    }
+
+    Usize id = add_lambda(self->module, self->fun->name, loc);
+    struct IrBuilder builder = new_builder(
+      self->module, self->module->lambdas[id].name, lambda.return_type);
+    bool has_value = builder.fun->return_type != NULL;
+
+    builder.generic = self->generic;
+    builder.args = self->args;
+    builder.is_boxed = self->is_boxed;
+    builder.fun->return_type = resolve(&builder, builder.fun->return_type);
+
+    if (has_value && !is_known(builder.fun->return_type))
+        fail(&builder);
+
+    for (Usize i = 0; i < captures_len; i++) {
+        Usize reg = new_reg(&builder, self->fun->regs[captures[i]]);
+
+        push_param__IrBlock(get_block(&builder, 0), reg);
+        write_var(&builder,
+                  0,
+                  get_var(&builder, get__Vec(*lambda.captures, i)),
+                  reg);
+    }
+
+    for (Usize i = 0; i < get_len(lambda.params) && !builder.failed; i++) {
+        struct Scope *param = get__Vec(*lambda.params, i);
+        struct DataTypeSymbol *param_data_type =
+          resolve(&builder, param->data_type);
+
+        if (!is_known(param_data_type) || is_void(param_data_type)) {
+            fail(&builder);
+            break;
+        }
+
+        Usize reg = new_reg(&builder, param_data_type);
+
+        push_param__IrBlock(get_block(&builder, 0), reg);
+        write_var(&builder, 0, get_var(&builder, param), reg);
+    }
+
+    lower_body(&builder, lambda.body, has_value);
+
+    struct IrFun *fun = finish(&builder);
+
+    self->module->lambdas[id].fun = fun;
+    self->module->lambdas[id].captures_len = captures_len;
+
+    if (!fun) {
+        free(captures);
+        return fail(self);
+    }
+
+    Usize dst = new_reg(self, data_type);
+
+    push_inst(self,
+              (struct IrInst){ .kind = IrInstKindClosure,
+                               .dst = dst,
+                               .args = captures,
+                               .args_len = captures_len,
+                               .value.closure = { .lambda = id,
+                                                  .is_heap = true } });
+
+    if (!lambda.args)
+        return dst;
+
+    // fun (x, y := 8) -> (x + y)(2, y := 4) is called where it's defined.
+    Usize args_len = get_len(lambda.args);
+    Usize *args = args_len ? malloc(args_len * sizeof(Usize)) : NULL;
+
+    for (Usize i = 0; i < args_len && !self->failed; i++)
+        if ((args[i] = lower_expr(self, get__Vec(*lambda.args, i))) ==
+            IR_NONE)
+            fail(self);
+
+    Usize result = lower_closure_call(self, dst, args, args_len);
+
+    free(args);
+
+    return result;
+}
+
+static Usize
+lower_expr(struct IrBuilder *self, struct ExprSymbol *expr)
+{
+    if (self->failed)
+        return IR_NONE;
+
+    switch (expr->kind) {
+        case ExprKindLiteral:
+            return lower_literal(self, expr);
+        case ExprKindIdentifier:
+            return lower_value_name(self, expr->value.identifier);
+        case ExprKindIdentifierAccess:
+            return lower_identifier_access(self,
+                                           expr->value.identifier_access);
+        case ExprKindGrouping:
+            return lower_expr(self, expr->value.grouping->items[0]);
+        case ExprKindUnaryOp:
+            return lower_unary_op(self, expr->value.unary_op);
+        case ExprKindBinaryOp:
+            return lower_binary_op(self, expr, expr->value.binary_op);
+        case ExprKindFunCall:
+            return lower_fun_call(self, expr->value.fun_call);
+        case ExprKindRecordCall:
+            return lower_record_call(self, expr, expr->value.record_call);
+        case ExprKindVariant:
+            return lower_variant(self, expr);
+        case ExprKindLambda:
+            return lower_lambda(self, expr->value.lambda, expr->loc);
+        case ExprKindVariable: {
+            struct VariableSymbol *variable = expr->value.variable;
+            Usize value = lower_expr(self, variable->expr);
+
+            if (value == IR_NONE)
+                return fail(self);
+
+            write_var(self, self->block, get_var(self, variable->scope), value);
+
+            return IR_NONE;
+        }
+        default:
+            return fail(self);
+    }
+}
+
+static void
+lower_return(struct IrBuilder *self, Usize value)
+{
+    struct IrTerm *term = &get_block(self, self->block)->term;
+
+    term->kind = IrTermKindReturn;
+    term->value = value;
+    start_dead_block(self);
+}
+
+static void
+lower_if(struct IrBuilder *self, struct IfCondSymbol if_, bool is_value)
+{
+    Usize join = new_block(self);
+    Usize elif_len = get_len(if_.elif);
+
+    for (Usize i = 0; i <= elif_len && !self->failed; i++) {
+        struct IfBranchSymbol *branch_ =
+          i == 0 ? if_.if_ : get__Vec(*if_.elif, i - 1);
+        Usize cond = lower_expr(self, branch_->cond);
+
+        if (self->failed || cond == IR_NONE) {
+            fail(self);
+            return;
+        }
+
+        Usize then = new_block(self);
+        Usize next = new_block(self);
+
+        branch(self, cond, then, next);
+        seal(self, then);
+        seal(self, next);
+
+        self->block = then;
+        lower_body(self, branch_->body, is_value);
+
+        if (!is_terminated(self))
+            jump(self, join, NULL, 0);
+
+        self->block = next;
+    }
+
+    if (if_.else_)
+        lower_body(self, if_.else_->body, is_value);
+
+    if (!is_terminated(self))
+        jump(self, join, NULL, 0);
+
+    seal(self, join);
+    self->block = join;
+}
+
+static void
+lower_while(struct IrBuilder *self, struct WhileSymbol while_)
+{
+    Usize header = new_block(self);
+
+    jump(self, header, NULL, 0);
+    self->block = header;
+
+    Usize cond = lower_expr(self, while_.cond);
+
+    if (self->failed || cond == IR_NONE) {
+        fail(self);
+        return;
+    }
+
+    Usize body = new_block(self);
+    Usize exit = new_block(self);
+
+    branch(self, cond, body, exit);
+    seal(self, body);
+
+    if (self->loops_len == self->loops_capacity) {
+        self->loops_capacity =
+          self->loops_capacity ? self->loops_capacity * 2 : 4;
+        self->loops =
+          realloc(self->loops, self->loops_capacity * sizeof(struct IrLoop));
+    }
+
+    self->loops[self->loops_len++] =
+      (struct IrLoop){ .header = header, .exit = exit };
+    self->block = body;
+    lower_body(self, while_.body, false);
+
+    if (!is_terminated(self))
+        jump(self, header, NULL, 0);
+
+    self->loops_len--;
+    seal(self, header);
+    seal(self, exit);
+    self->block = exit;
+}
+
+static inline bool
+is_any_pattern(const struct ExprSymbol *pattern)
+{
+    return !pattern || pattern->kind == ExprKindWildcard ||
+           pattern->kind == ExprKindIdentifier;
+}
+
+// The value tested by the pattern: the index of a variant or the value of a
+// literal (false if the literal is not a case of a switch: Str, Float64, ...).
+static bool
+get_pattern_case(const struct ExprSymbol *pattern, Int64 *value)
+{
+    if (pattern->kind == ExprKindVariant) {
+        *value = pattern->value.variant.id.id;
+        return true;
+    }
+
+    return pattern->kind == ExprKindLiteral &&
+           get_case_value__LiteralSymbol(&pattern->value.literal, value);
+}
+
+static void
+free_match_rows(struct IrMatchRow *rows, Usize len)
+{
+    for (Usize i = 0; i < len; i++) {
+        free(rows[i].patterns);
+        free(rows[i].bindings.items);
+    }
+
+    free(rows);
+}
+
+static void
+lower_decision(struct IrBuilder *self,
+               struct IrMatch *match,
+               struct IrMatchRow *rows,
+               Usize rows_len,
+               Usize *values,
+               Usize len);
+
+// The first row matches: its names are bound, then its guard is tested (the
+// next rows are tried if it's false).
+static void
+lower_match_leaf(struct IrBuilder *self,
+                 struct IrMatch *match,
+                 struct IrMatchRow *rows,
+                 Usize rows_len,
+                 Usize *values,
+                 Usize len)
+{
+    struct IrMatchRow *row = &rows[0];
+    struct Tuple *arm = get__Vec(*match->arms, row->arm);
+
+    for (Usize i = 0; i < row->bindings.len; i++)
+        write_var(self,
+                  self->block,
+                  row->bindings.items[i].var,
+                  row->bindings.items[i].reg);
+
+    for (Usize i = 0; i < len; i++)
+        if (row->patterns[i] && row->patterns[i]->kind == ExprKindIdentifier)
+            write_var(self,
+                      self->block,
+                      get_var(self, row->patterns[i]->value.identifier),
+                      values[i]);
+
+    if (!arm->items[1]) {
+        jump(self, match->blocks[row->arm], NULL, 0);
+        return;
+    }
+
+    Usize cond = lower_expr(self, arm->items[1]);
+
+    if (self->failed || cond == IR_NONE) {
+        fail(self);
+        return;
+    }
+
+    Usize next = new_block(self);
+
+    branch(self, cond, match->blocks[row->arm], next);
+    seal(self, next);
+    self->block = next;
+    lower_decision(self, match, rows + 1, rows_len - 1, values, len);
+}
+
+// The block of the edge tests the rows which match the case (value is NULL for
+// the default edge: the rows which match any value). The tested column is
+// removed, or replaced by the value of the variant if a row tests or binds it.
+static void
+lower_match_case(struct IrBuilder *self,
+                 struct IrMatch *match,
+                 struct IrMatchRow *rows,
+                 Usize rows_len,
+                 Usize *values,
+                 Usize len,
+                 Usize column,
+                 struct EnumSymbol *enum_,
+                 const Int64 *value,
+                 Usize from,
+                 Usize edge)
+{
+    Usize block = new_block(self);
+
+    set_edge(self, from, edge, block, NULL, 0);
+    seal(self, block);
+    self->block = block;
+
+    bool has_payload = false;
+
+    for (Usize i = 0; enum_ && value && i < rows_len && !has_payload; i++) {
+        struct ExprSymbol *pattern = rows[i].patterns[column];
+
+        has_payload = pattern && pattern->kind == ExprKindVariant &&
+                      pattern->value.variant.id.id == (Usize)*value &&
+                      pattern->value.variant.value &&
+                      pattern->value.variant.value->kind != ExprKindWildcard;
+    }
+
+    Usize case_len = len - 1 + has_payload;
+    Usize *case_values = malloc(sizeof(Usize) * (case_len + 1));
+
+    memcpy(case_values, values, column * sizeof(Usize));
+    memcpy(case_values + column + has_payload,
+           values + column + 1,
+           (len - column - 1) * sizeof(Usize));
+
+    if (has_payload) {
+        struct DataTypeSymbol *data_type = resolve(
+          self,
+          ((struct SymbolTable *)get__Vec(*enum_->variants, *value))
+            ->value.variant->data_type);
+
+        if (!is_known(data_type)) {
+            free(case_values);
+            fail(self);
+            return;
+        }
+
+        case_values[column] = push_value(
+          self, IrInstKindPayload, data_type, &values[column], 1);
+        last_inst(self)->value.variant = *value;
+    }
+
+    struct IrMatchRow *case_rows =
+      malloc(sizeof(struct IrMatchRow) * (rows_len + 1));
+    Usize case_rows_len = 0;
+
+    for (Usize i = 0; i < rows_len; i++) {
+        struct ExprSymbol *pattern = rows[i].patterns[column];
+        struct IrMatchRow *row = &case_rows[case_rows_len];
+        Int64 case_value;
+
+        if (!is_any_pattern(pattern) &&
+            (!value || !get_pattern_case(pattern, &case_value) ||
+             case_value != *value))
+            continue;
+
+        *row = (struct IrMatchRow){
+            .patterns = malloc(sizeof(struct ExprSymbol *) * (case_len + 1)),
+            .arm = rows[i].arm
+        };
+
+        for (Usize j = 0; j < rows[i].bindings.len; j++)
+            push_def(&row->bindings,
+                     rows[i].bindings.items[j].var,
+                     rows[i].bindings.items[j].reg);
+
+        if (pattern && pattern->kind == ExprKindIdentifier)
+            push_def(&row->bindings,
+                     get_var(self, pattern->value.identifier),
+                     values[column]);
+
+        memcpy(row->patterns,
+               rows[i].patterns,
+               column * sizeof(struct ExprSymbol *));
+        memcpy(row->patterns + column + has_payload,
+               rows[i].patterns + column + 1,
+               (len - column - 1) * sizeof(struct ExprSymbol *));
+
+        if (has_payload)
+            row->patterns[column] = pattern && pattern->kind == ExprKindVariant
+                                      ? pattern->value.variant.value
+                                      : NULL;
+
+        case_rows_len++;
+    }
+
+    lower_decision(
+      self, match, case_rows, case_rows_len, case_values, case_len);
+    free_match_rows(case_rows, case_rows_len);
+    free(case_values);
+}
+
+// The first value tested by the first row is switched on: each distinct
+// constructor of its column (in the order of the rows) is a case, the rows
+// which match any value go to each case and to the default.
+static void
+lower_decision(struct IrBuilder *self,
+               struct IrMatch *match,
+               struct IrMatchRow *rows,
+               Usize rows_len,
+               Usize *values,
+               Usize len)
+{
+    if (self->failed)
+        return;
+    else if (!rows_len) {
+        jump(self, match->exit, NULL, 0);
+        return;
+    }
+
+    Usize column = 0;
+
+    while (column < len && is_any_pattern(rows[0].patterns[column]))
+        column++;
+
+    if (column == len) {
+        lower_match_leaf(self, match, rows, rows_len, values, len);
+        return;
+    }
+
+    struct ExprSymbol *head = rows[0].patterns[column];
+    struct EnumSymbol *enum_ =
+      head->kind == ExprKindVariant
+        ? get_enum__IrModule(self->module,
+                             strip_mut(self->fun->regs[values[column]]))
+        : NULL;
+    bool is_bool = head->kind == ExprKindLiteral &&
+                   head->value.literal.kind == LiteralSymbolKindBool;
+
+    if ((head->kind == ExprKindVariant &&
+         (!enum_ || enum_->generic_params)) ||
+        is_boxed(self, values[column])) {
+        fail(self);
+        return;
+    }
+
+    Int64 *cases = malloc(sizeof(Int64) * (rows_len + 1));
+    Usize cases_len = 0;
+    bool *is_seen =
+      enum_ ? calloc(len__Vec(*enum_->variants), sizeof(bool)) : NULL;
+
+    for (Usize i = 0; i < rows_len && !self->failed; i++) {
+        struct ExprSymbol *pattern = rows[i].patterns[column];
+        Int64 value;
+        Usize j = 0;
+
+        if (is_any_pattern(pattern))
+            continue;
+        else if (!get_pattern_case(pattern, &value)) {
+            fail(self);
+            break;
+        } else if (is_seen) {
+            if (is_seen[value])
+                continue;
+
+            is_seen[value] = true;
+        } else {
+            while (j < cases_len && cases[j] != value)
+                j++;
+
+            if (j < cases_len)
+                continue;
+        }
+
+        cases[cases_len++] = value;
+    }
+
+    bool is_complete = enum_ ? cases_len == len__Vec(*enum_->variants)
+                             : is_bool && cases_len == 2;
+    Usize from = self->block;
+    struct IrTerm *term = &get_block(self, from)->term;
+
+    term->kind = is_bool ? IrTermKindBranch : IrTermKindSwitch;
+    term->value = values[column];
+
+    for (Usize i = 0; !is_bool && i < cases_len; i++)
+        push_case__IrTerm(term, cases[i]);
+
+    // The edge 0 of a branch is true, the edges of the cases of a switch follow
+    // its default edge.
+    for (Usize i = 0; i < cases_len && !self->failed; i++)
+        lower_match_case(self,
+                         match,
+                         rows,
+                         rows_len,
+                         values,
+                         len,
+                         column,
+                         enum_,
+                         &cases[i],
+                         from,
+                         is_bool ? !cases[i] : i + 1);
+
+    if (!self->failed && !is_complete)
+        lower_match_case(self,
+                         match,
+                         rows,
+                         rows_len,
+                         values,
+                         len,
+                         column,
+                         enum_,
+                         NULL,
+                         from,
+                         is_bool ? cases[0] : 0);
+    else if (!self->failed && !is_bool) {
+        // A switch on all the variants has no default.
+        Usize block = new_block(self);
+
+        set_edge(self, from, 0, block, NULL, 0);
+        seal(self, block);
+        get_block(self, block)->term.kind = IrTermKindUnreachable;
+    }
+
+    free(cases);
+    free(is_seen);
+}
+
+// The arms are compiled to a decision tree (Maranget, "Compiling pattern
+// matching to good decision trees"): a value is tested once on each path
+// whatever the number of arms, a switch on the tag of an enum is a jump table
+// in C. The body of each arm is lowered once, after the tree.
+static void
+lower_match(struct IrBuilder *self, struct MatchSymbol match, bool is_value)
+{
+    Usize value = lower_expr(self, match.matching);
+
+    if (self->failed || value == IR_NONE) {
+        fail(self);
+        return;
+    }
+
+    Usize arms_len = get_len(match.pattern);
+    struct IrMatch ir_match = { .arms = match.pattern,
+                                .blocks = malloc(sizeof(Usize) *
+                                                 (arms_len + 1)),
+                                .exit = new_block(self) };
+    struct IrMatchRow *rows =
+      malloc(sizeof(struct IrMatchRow) * (arms_len + 1));
+
+    for (Usize i = 0; i < arms_len; i++) {
+        ir_match.blocks[i] = new_block(self);
+        rows[i] = (struct IrMatchRow){ .patterns =
+                                         malloc(sizeof(struct ExprSymbol *)),
+                                       .arm = i };
+        rows[i].patterns[0] =
+          ((struct Tuple *)get__Vec(*match.pattern, i))->items[0];
+    }
+
+    lower_decision(self, &ir_match, rows, arms_len, &value, 1);
+    free_match_rows(rows, arms_len);
+
+    for (Usize i = 0; i < arms_len && !self->failed; i++) {
+        seal(self, ir_match.blocks[i]);
+        self->block = ir_match.blocks[i];
+        lower_body(self,
+                   ((struct Tuple *)get__Vec(*match.pattern, i))->items[2],
+                   is_value);
+
+        if (!is_terminated(self))
+            jump(self, ir_match.exit, NULL, 0);
+    }
+
+    seal(self, ir_match.exit);
+    self->block = ir_match.exit;
+    free(ir_match.blocks);
+}
+
+static void
+lower_stmt(struct IrBuilder *self, struct StmtSymbol stmt, bool is_value)
+{
+    switch (stmt.kind) {
+        case StmtKindReturn: {
+            Usize value = stmt.value.return_
+                            ? lower_expr(self, stmt.value.return_)
+                            : IR_NONE;
+
+            if (!self->failed)
+                lower_return(self, value);
+
+            break;
+        }
+        case StmtKindIf:
+            lower_if(self, stmt.value.if_, is_value);
+            break;
+        case StmtKindWhile:
+            lower_while(self, stmt.value.while_);
+            break;
+        case StmtKindMatch:
+            lower_match(self, stmt.value.match, is_value);
+            break;
+        case StmtKindNext:
+        case StmtKindBreak:
+            if (!self->loops_len) {
+                fail(self);
+                break;
+            }
+
+            jump(self,
+                 stmt.kind == StmtKindNext
+                   ? self->loops[self->loops_len - 1].header
+                   : self->loops[self->loops_len - 1].exit,
+                 NULL,
+                 0);
+            start_dead_block(self);
+            break;
+        default:
+            fail(self);
+    }
+}
+
+// If is_value, the last item is the value of the body: it's returned.
+static void
+lower_body(struct IrBuilder *self, struct Vec *body, bool is_value)
+{
+    for (Usize i = 0; i < get_len(body) && !self->failed; i++) {
+        struct SymbolTable *item = get__Vec(*body, i);
+        bool is_tail = is_value && i == len__Vec(*body) - 1;
+
+        switch (item->kind) {
+            case SymbolTableKindExpr: {
+                Usize value = lower_expr(self, item->value.expr);
+
+                if (is_tail && value != IR_NONE && !self->failed)
+                    lower_return(self, value);
+
+                break;
+            }
+            case SymbolTableKindStmt:
+                lower_stmt(self, item->value.stmt, is_tail);
+                break;
+            default:
+                fail(self);
+        }
+    }
+}
+
+static struct IrFun *
+finish(struct IrBuilder *self)
+{
+    for (Usize i = 0; i < self->fun->blocks_len; i++) {
+        free(self->defs[i].items);
+        free(self->incomplete[i].items);
+        free(self->preds[i].blocks);
+        free(self->preds[i].edges);
+    }
+
+    free(self->defs);
+    free(self->incomplete);
+    free(self->preds);
+    free(self->sealed);
+    free(self->vars);
+
+    for (Usize i = 0; i < self->slots_len; i++)
+        free(self->slots[i].vars);
+
+    free(self->slots);
+    free(self->loops);
+
+    if (self->failed) {
+        FREE(IrFun, self->fun);
+        return NULL;
+    }
+
+    // The end of a function without value returns, the end of a function
+    // with value is unreachable (the body returns before).
+    for (Usize i = 0; i < self->fun->blocks_len; i++) {
+        struct IrTerm *term = &self->fun->blocks[i].term;
+
+        if (term->kind == IrTermKindNone) {
+            term->kind = self->fun->return_type ? IrTermKindUnreachable
+                                                : IrTermKindReturn;
+            term->value = IR_NONE;
+        }
+    }
+
+    return self->fun;
+}
+
+static struct IrBuilder
+new_builder(struct IrModule *module,
+            struct String *name,
+            struct DataTypeSymbol *return_type)
+{
+    struct IrBuilder self = { 0 };
+
+    self.module = module;
+    self.fun = calloc(1, sizeof(struct IrFun));
+    self.fun->name = name;
+    self.fun->return_type =
+      is_void(return_type) ? NULL : strip_mut(return_type);
+    self.block = new_block(&self);
+    seal(&self, self.block);
+
+    return self;
+}
+
+// The params of an instance have the data type of their generic param.
+static void
+lower_params(struct IrBuilder *self, struct FunSymbol *fun)
+{
+    for (Usize i = 0; i < get_len(fun->params) && !self->failed; i++) {
+        struct FunParamSymbol *param = get__Vec(*fun->params, i);
+        struct DataTypeSymbol *data_type = resolve(
+          self,
+          param->param_data_type ? param->param_data_type->items[0] : NULL);
+
+        if (self->generic && self->generic->slots[i] != IR_NONE)
+            data_type = self->args[self->generic->slots[i]];
+
+        if ((!is_known(data_type) &&
+             !(self->is_boxed && is_generic__DataTypeSymbol(data_type))) ||
+            is_void(data_type)) {
+            fail(self);
+            break;
+        }
+
+        Usize reg = new_reg(self, data_type);
+
+        push_param__IrBlock(get_block(self, 0), reg);
+        write_var(self, 0, get_var(self, param->scope), reg);
+    }
+}
+
+static struct IrFun *
+lower_fun(struct IrModule *module, struct FunSymbol *fun)
+{
+    if (fun->is_async)
+        return NULL;
+
+    struct IrBuilder self = new_builder(module, fun->name, fun->return_type);
+
+    lower_params(&self, fun);
+
+    if (self.fun->return_type && !is_known(self.fun->return_type))
+        fail(&self);
+
+    lower_body(&self, fun->body, self.fun->return_type != NULL);
+
+    return finish(&self);
+}
+
+// The return of an instance of an implicit generic function has the data type
+// of the returned values.
+static void
+infer_return_type(struct IrBuilder *self)
+{
+    for (Usize i = 0; i < self->fun->blocks_len; i++) {
+        struct IrTerm *term = &self->fun->blocks[i].term;
+
+        if (term->kind != IrTermKindReturn || term->value == IR_NONE)
+            continue;
+        else if (!self->fun->return_type)
+            self->fun->return_type = self->fun->regs[term->value];
+        else if (self->fun->return_type != self->fun->regs[term->value])
+            fail(self);
+    }
+
+    if (!self->fun->return_type)
+        fail(self);
+}
+
+static struct IrFun *
+lower_instance(struct IrModule *module, Usize instance)
+{
+    struct IrInstance *ir_instance = &module->instances[instance];
+    struct FunSymbol *fun = get__Vec(*module->tc->funs, ir_instance->fun);
+    struct IrBuilder self =
+      new_builder(module, ir_instance->name, fun->return_type);
+
+    self.generic = module->generics[ir_instance->fun];
+    self.args = ir_instance->args;
+    self.is_boxed = ir_instance->is_boxed;
+
+    bool has_value = self.fun->return_type != NULL;
+
+    // The recursive calls reach the instance being lowered.
+    self.fun->return_type = resolve(&self, self.fun->return_type);
+    ir_instance->return_type = self.fun->return_type;
+    module->funs[ir_instance->id] = self.fun;
+
+    if (fun->is_async || !self.generic->is_supported)
+        fail(&self);
+
+    lower_params(&self, fun);
+    lower_body(&self, fun->body, has_value);
+
+    if (has_value && !self.fun->return_type && !self.failed)
+        infer_return_type(&self);
+
+    ir_instance = &module->instances[instance];
+    ir_instance->return_type = self.fun->return_type;
+
+    return finish(&self);
+}
+
+Usize
+instantiate__IrModule(struct IrModule *self,
+                      Usize fun,
+                      struct DataTypeSymbol **args)
+{
+    Usize instance = search_instance__IrModule(self, fun, args);
+
+    if (instance != IR_NONE)
+        return self->funs[self->instances[instance].id]
+                 ? self->instances[instance].id
+                 : IR_NONE;
+
+    instance = add_instance__IrModule(self, fun, args);
+
+    Usize id = self->instances[instance].id;
+    struct IrFun *ir = lower_instance(self, instance);
+
+    self->funs[id] = ir;
+
+    return ir ? id : IR_NONE;
+}
+
+// The value of a constant which is not a literal is computed by a function
+// without parameter.
+static struct IrFun *
+lower_constant(struct IrModule *module, struct ConstantSymbol *constant)
+{
+    if (!constant->expr_symbol ||
+        constant->expr_symbol->kind == ExprKindLiteral)
+        return NULL;
+
+    struct IrBuilder self =
+      new_builder(module, constant->name, constant->data_type);
+
+    if (!self.fun->return_type || !is_known(self.fun->return_type))
+        fail(&self);
+
+    Usize value = lower_expr(&self, constant->expr_symbol);
+
+    if (value == IR_NONE)
+        fail(&self);
+    else if (!self.failed)
+        lower_return(&self, value);
+
+    return finish(&self);
+}
+
+// Return false if the function uses a function, a constant or a lambda which
+// is not lowered.
+static bool
+uses_lowered(struct IrModule *self, struct IrFun *fun)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            struct IrInst *inst = &fun->blocks[i].insts[j];
+
+            if ((inst->kind == IrInstKindCall &&
+                 !self->funs[inst->value.fun]) ||
+                (inst->kind == IrInstKindConstant &&
+                 !has_constant__IrModule(self, inst->value.constant)) ||
+                (inst->kind == IrInstKindClosure &&
+                 !self->lambdas[inst->value.closure.lambda].fun))
+                return false;
+        }
+
+    return true;
+}
+
+struct IrModule *
+__new__IrModule(struct Typecheck *tc)
+{
+    struct IrModule *self = malloc(sizeof(struct IrModule));
+
+    self->tc = tc;
+    self->file_funs_len = get_len(tc->funs);
+    self->funs_len = self->file_funs_len;
+    self->funs_capacity = self->funs_len + 1;
+    self->funs = calloc(self->funs_capacity, sizeof(struct IrFun *));
+    self->generics = calloc(self->funs_len + 1, sizeof(struct IrGeneric *));
+    self->instances = NULL;
+    self->instances_len = 0;
+    self->instances_capacity = 0;
+    self->instances_cache = NEW(StrMap);
+
+    for (Usize i = 0; i < self->file_funs_len; i++)
+        self->generics[i] = NEW(IrGeneric, get__Vec(*tc->funs, i));
+    self->consts_len = get_len(tc->consts);
+    self->consts = calloc(self->consts_len + 1, sizeof(struct IrFun *));
+    self->values = calloc(self->consts_len + 1, sizeof(struct IrValue *));
+    self->lambdas = NULL;
+    self->lambdas_len = 0;
+    self->lambdas_capacity = 0;
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        self->consts[i] = lower_constant(self, get__Vec(*tc->consts, i));
+
+    // The instances are lowered at their first call (self->funs grows).
+    for (Usize i = 0; i < self->file_funs_len; i++)
+        if (!self->generics[i]) {
+            struct IrFun *fun = lower_fun(self, get__Vec(*tc->funs, i));
+
+            self->funs[i] = fun;
+        }
+
+    // The users of a declaration which is not lowered are removed until
+    // nothing changes.
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (Usize i = 0; i < self->consts_len; i++)
+            if (self->consts[i] && !uses_lowered(self, self->consts[i])) {
+                FREE(IrFun, self->consts[i]);
+                self->consts[i] = NULL;
+                changed = true;
+            }
+
+        for (Usize i = 0; i < self->funs_len; i++)
+            if (self->funs[i] && !uses_lowered(self, self->funs[i])) {
+                FREE(IrFun, self->funs[i]);
+                self->funs[i] = NULL;
+                changed = true;
+            }
+
+        for (Usize i = 0; i < self->lambdas_len; i++)
+            if (self->lambdas[i].fun &&
+                !uses_lowered(self, self->lambdas[i].fun)) {
+                FREE(IrFun, self->lambdas[i].fun);
+                self->lambdas[i].fun = NULL;
+                changed = true;
+            }
+    }
+
+    remove_unused_lambdas__IrModule(self);
+    eliminate_tail_calls__IrModule(self);
+    evaluate_constants__IrModule(self);
+
+    return self;
+}
@@ -0,0 +1,569 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <base/format.h>
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/str_map.h>
+#include <lang/ir/mono.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline Usize
+get_len(struct Vec *items)
+{
+    return items ? len__Vec(*items) : 0;
+}
+
+static inline struct DataTypeSymbol *
+strip_mut(struct DataTypeSymbol *data_type)
+{
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    return data_type;
+}
+
+bool
+is_generic__DataTypeSymbol(const struct DataTypeSymbol *data_type)
+{
+    return data_type && (data_type->kind == DataTypeKindCompilerDefined ||
+                         (data_type->kind == DataTypeKindCustom &&
+                          data_type->scope &&
+                          data_type->scope->item_kind == ScopeItemKindGeneric));
+}
+
+static bool
+has_generic_item(const struct Vec *data_types)
+{
+    for (Usize i = 0; data_types && i < len__Vec(*data_types); i++)
+        if (has_generic__DataTypeSymbol(get__Vec(*data_types, i)))
+            return true;
+
+    return false;
+}
+
+bool
+has_generic__DataTypeSymbol(const struct DataTypeSymbol *data_type)
+{
+    if (!data_type)
+        return false;
+    else if (is_generic__DataTypeSymbol(data_type))
+        return true;
+
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            return has_generic__DataTypeSymbol(data_type->value.ptr);
+        case DataTypeKindRef:
+            return has_generic__DataTypeSymbol(data_type->value.ref);
+        case DataTypeKindOptional:
+            return has_generic__DataTypeSymbol(data_type->value.optional);
+        case DataTypeKindException:
+            return has_generic__DataTypeSymbol(data_type->value.exception);
+        case DataTypeKindMut:
+            return has_generic__DataTypeSymbol(data_type->value.mut);
+        case DataTypeKindArray:
+            return has_generic__DataTypeSymbol(
+              data_type->value.array->items[0]);
+        case DataTypeKindLambda:
+            return has_generic_item(data_type->value.lambda->items[0]) ||
+                   has_generic__DataTypeSymbol(
+                     data_type->value.lambda->items[1]);
+        case DataTypeKindTuple:
+            return has_generic_item(data_type->value.tuple);
+        case DataTypeKindCustom:
+            return has_generic_item(data_type->value.custom);
+        default:
+            return false;
+    }
+}
+
+// The members of LilyBox (see generate_c.c).
+bool
+is_boxable__DataTypeSymbol(const struct DataTypeSymbol *data_type)
+{
+    if (!data_type)
+        return false;
+
+    switch (data_type->kind) {
+        case DataTypeKindI8:
+        case DataTypeKindI16:
+        case DataTypeKindI32:
+        case DataTypeKindI64:
+        case DataTypeKindU8:
+        case DataTypeKindU16:
+        case DataTypeKindU32:
+        case DataTypeKindU64:
+        case DataTypeKindF32:
+        case DataTypeKindF64:
+        case DataTypeKindBool:
+        case DataTypeKindChar:
+        case DataTypeKindStr:
+        case DataTypeKindIsize:
+        case DataTypeKindUsize:
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct IrGeneric *
+__new__IrGeneric(struct FunSymbol *fun)
+{
+    Usize params_len = get_len(fun->params);
+    struct DataTypeSymbol *return_type = strip_mut(fun->return_type);
+    bool is_generic = has_generic__DataTypeSymbol(return_type);
+
+    for (Usize i = 0; i < params_len && !is_generic; i++) {
+        struct FunParamSymbol *param = get__Vec(*fun->params, i);
+
+        is_generic = !param->param_data_type ||
+                     has_generic__DataTypeSymbol(
+                       strip_mut(param->param_data_type->items[0]));
+    }
+
+    if (!is_generic)
+        return NULL;
+
+    struct IrGeneric *self = malloc(sizeof(struct IrGeneric));
+
+    self->slots = malloc(sizeof(Usize) * (params_len + 1));
+    self->slots_len = params_len;
+    self->params = malloc(sizeof(struct DataTypeSymbol *) * (params_len + 1));
+    self->len = 0;
+    self->is_supported = true;
+
+    for (Usize i = 0; i < params_len; i++) {
+        struct FunParamSymbol *param = get__Vec(*fun->params, i);
+        struct DataTypeSymbol *data_type =
+          param->param_data_type ? strip_mut(param->param_data_type->items[0])
+                                 : NULL;
+
+        self->slots[i] = IR_NONE;
+
+        if (data_type && !is_generic__DataTypeSymbol(data_type)) {
+            if (has_generic__DataTypeSymbol(data_type))
+                self->is_supported = false;
+
+            continue;
+        }
+
+        // The params of the same generic param share it, an implicit generic
+        // param is distinct.
+        if (data_type && data_type->kind == DataTypeKindCustom)
+            for (Usize j = 0; j < self->len; j++)
+                if (self->params[j] == data_type)
+                    self->slots[i] = j;
+
+        if (self->slots[i] == IR_NONE) {
+            self->slots[i] = self->len;
+            self->params[self->len++] = data_type;
+        }
+    }
+
+    // The return of an implicit generic function is known when the instance
+    // is lowered, T in fun f[T]() T is not bound by the arguments.
+    if (return_type && return_type->kind == DataTypeKindCustom &&
+        is_generic__DataTypeSymbol(return_type)) {
+        bool is_bound = false;
+
+        for (Usize i = 0; i < self->len; i++)
+            is_bound = is_bound || self->params[i] == return_type;
+
+        self->is_supported = self->is_supported && is_bound;
+    } else if (!is_generic__DataTypeSymbol(return_type) &&
+               has_generic__DataTypeSymbol(return_type))
+        self->is_supported = false;
+
+    return self;
+}
+
+bool
+bind__IrGeneric(const struct IrGeneric *self,
+                struct DataTypeSymbol **params,
+                struct DataTypeSymbol **args)
+{
+    for (Usize i = 0; i < self->len; i++)
+        args[i] = NULL;
+
+    for (Usize i = 0; i < self->slots_len; i++) {
+        Usize slot = self->slots[i];
+
+        if (slot == IR_NONE)
+            continue;
+        else if (!params[i] || (args[slot] && args[slot] != params[i]))
+            return false;
+
+        args[slot] = params[i];
+    }
+
+    return true;
+}
+
+void
+__free__IrGeneric(struct IrGeneric *self)
+{
+    free(self->slots);
+    free(self->params);
+    free(self);
+}
+
+// The key of an instance is the index of the function followed by the address
+// of the data type of each generic param (the data types are interned).
+static char *
+new_key(Usize fun, struct DataTypeSymbol **args, Usize args_len, Usize *len)
+{
+    *len = sizeof(Usize) + args_len * sizeof(struct DataTypeSymbol *);
+
+    char *key = malloc(*len);
+
+    memcpy(key, &fun, sizeof(Usize));
+
+    if (args_len)
+        memcpy(key + sizeof(Usize),
+               args,
+               args_len * sizeof(struct DataTypeSymbol *));
+
+    return key;
+}
+
+Usize
+search_instance__IrModule(const struct IrModule *self,
+                          Usize fun,
+                          struct DataTypeSymbol **args)
+{
+    Usize key_len;
+    char *key = new_key(fun, args, self->generics[fun]->len, &key_len);
+    Usize instance =
+      (Usize)(UPtr)get_with_len__StrMap(*self->instances_cache, key, key_len);
+
+    free(key);
+
+    return instance ? instance - 1 : IR_NONE;
+}
+
+// add2__Int32, first__box (a boxed generic param), ... The name is made unique
+// among the instances of the function (*Int32 and &Int32 are both _Int32).
+static struct String *
+new_name(const struct IrModule *self, Usize fun, struct DataTypeSymbol **args)
+{
+    struct String *name = format(
+      "{S}_", ((struct FunSymbol *)get__Vec(*self->tc->funs, fun))->name);
+
+    for (Usize i = 0; i < self->generics[fun]->len; i++) {
+        push_str__String(name, "_");
+
+        if (is_generic__DataTypeSymbol(args[i])) {
+            push_str__String(name, "box");
+            continue;
+        }
+
+        struct Writer writer = NEW(WriterBuffer);
+
+        write__DataTypeSymbol(&writer, args[i]);
+
+        Str data_type = take__Writer(&writer);
+
+        for (Usize j = 0; data_type[j]; j++)
+            if (!(data_type[j] >= 'a' && data_type[j] <= 'z') &&
+                !(data_type[j] >= 'A' && data_type[j] <= 'Z') &&
+                !(data_type[j] >= '0' && data_type[j] <= '9'))
+                data_type[j] = '_';
+
+        push_str__String(name, data_type);
+        free(data_type);
+        FREE(Writer, writer);
+    }
+
+    for (Usize i = 0; i < self->instances_len; i++)
+        if (self->instances[i].fun == fun &&
+            eq__String(self->instances[i].name, name, false)) {
+            struct String *suffix = format("_{d}", (int)self->instances_len);
+
+            append__String(name, suffix, true);
+            break;
+        }
+
+    return name;
+}
+
+Usize
+add_instance__IrModule(struct IrModule *self,
+                       Usize fun,
+                       struct DataTypeSymbol **args)
+{
+    Usize args_len = self->generics[fun]->len;
+
+    if (self->instances_len == self->instances_capacity) {
+        self->instances_capacity =
+          self->instances_capacity ? self->instances_capacity * 2 : 4;
+        self->instances =
+          realloc(self->instances,
+                  self->instances_capacity * sizeof(struct IrInstance));
+    }
+
+    if (self->funs_len == self->funs_capacity) {
+        self->funs_capacity *= 2;
+        self->funs =
+          realloc(self->funs, self->funs_capacity * sizeof(struct IrFun *));
+    }
+
+    struct IrInstance instance = {
+        .fun = fun,
+        .args = malloc(sizeof(struct DataTypeSymbol *) * (args_len + 1)),
+        .args_len = args_len,
+        .id = self->funs_len,
+        .return_type = NULL,
+        .name = new_name(self, fun, args),
+        .uses = 0,
+        .is_boxed = false,
+        .is_demoted = false
+    };
+
+    for (Usize i = 0; i < args_len; i++) {
+        instance.args[i] = args[i];
+        instance.is_boxed =
+          instance.is_boxed || is_generic__DataTypeSymbol(args[i]);
+    }
+
+    instance.key = new_key(fun, args, args_len, &instance.key_len);
+    self->funs[self->funs_len++] = NULL;
+    self->instances[self->instances_len] = instance;
+    insert_with_len__StrMap(self->instances_cache,
+                            instance.key,
+                            instance.key_len,
+                            (void *)(UPtr)(self->instances_len + 1));
+
+    return self->instances_len++;
+}
+
+// call f__Int32 %1 -> %2 = box %1, %3 = call f__box %2, unbox %3: the args
+// whose param is boxed are boxed, the result is unboxed if it is boxed.
+static void
+redirect_calls(struct IrFun *self, Usize from, const struct IrFun *to, Usize id)
+{
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        struct IrBlock *block = &self->blocks[i];
+        struct IrInst *insts = block->insts;
+        Usize insts_len = block->insts_len;
+
+        block->insts = NULL;
+        block->insts_len = 0;
+        block->insts_capacity = 0;
+
+        for (Usize j = 0; j < insts_len; j++) {
+            struct IrInst inst = insts[j];
+
+            if (inst.kind != IrInstKindCall || inst.value.fun != from) {
+                push_inst__IrBlock(block, inst);
+                continue;
+            }
+
+            for (Usize k = 0; k < inst.args_len; k++) {
+                struct DataTypeSymbol *param =
+                  to->regs[to->blocks[0].params[k]];
+
+                if (!is_generic__DataTypeSymbol(param) ||
+                    is_generic__DataTypeSymbol(self->regs[inst.args[k]]))
+                    continue;
+
+                Usize boxed = add_reg__IrFun(self, param);
+                Usize *args = malloc(sizeof(Usize));
+
+                args[0] = inst.args[k];
+                push_inst__IrBlock(block,
+                                   (struct IrInst){ .kind = IrInstKindBox,
+                                                    .dst = boxed,
+                                                    .args = args,
+                                                    .args_len = 1 });
+                inst.args[k] = boxed;
+            }
+
+            Usize dst = inst.dst;
+
+            inst.value.fun = id;
+
+            if (dst != IR_NONE && is_generic__DataTypeSymbol(to->return_type) &&
+                !is_generic__DataTypeSymbol(self->regs[dst]))
+                inst.dst = add_reg__IrFun(self, to->return_type);
+
+            push_inst__IrBlock(block, inst);
+
+            if (inst.dst != dst) {
+                Usize *args = malloc(sizeof(Usize));
+
+                args[0] = inst.dst;
+                push_inst__IrBlock(block,
+                                   (struct IrInst){ .kind = IrInstKindUnbox,
+                                                    .dst = dst,
+                                                    .args = args,
+                                                    .args_len = 1 });
+            }
+        }
+
+        free(insts);
+    }
+}
+
+// A boxed instance is lowered after the other functions: it is dropped if it
+// calls a function which is not lowered (until nothing changes).
+static void
+drop_unlowered_boxed(struct IrModule *self)
+{
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (Usize i = 0; i < self->instances_len; i++) {
+            struct IrFun *fun = self->funs[self->instances[i].id];
+            bool is_lowered = true;
+
+            if (!fun || !self->instances[i].is_boxed)
+                continue;
+
+            for (Usize j = 0; j < fun->blocks_len && is_lowered; j++)
+                for (Usize k = 0; k < fun->blocks[j].insts_len; k++) {
+                    struct IrInst *inst = &fun->blocks[j].insts[k];
+
+                    if ((inst->kind == IrInstKindCall &&
+                         !self->funs[inst->value.fun]) ||
+                        (inst->kind == IrInstKindConstant &&
+                         !has_constant__IrModule(self,
+                                                 inst->value.constant)) ||
+                        (inst->kind == IrInstKindClosure &&
+                         !self->lambdas[inst->value.closure.lambda].fun))
+                        is_lowered = false;
+                }
+
+            if (!is_lowered) {
+                FREE(IrFun, fun);
+                self->funs[self->instances[i].id] = NULL;
+                changed = true;
+            }
+        }
+    }
+}
+
+static bool
+is_boxable_instance(const struct IrInstance *self)
+{
+    for (Usize i = 0; i < self->args_len; i++)
+        if (!is_boxable__DataTypeSymbol(self->args[i]))
+            return false;
+
+    return true;
+}
+
+// Demote the instance: its calls go to the boxed instance.
+static void
+demote_instance(struct IrModule *self, Usize instance, Usize boxed)
+{
+    struct IrInstance *demoted = &self->instances[instance];
+    const struct IrFun *to = self->funs[boxed];
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            redirect_calls(self->funs[i], demoted->id, to, boxed);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            redirect_calls(self->consts[i], demoted->id, to, boxed);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            redirect_calls(self->lambdas[i].fun, demoted->id, to, boxed);
+
+    self->instances[boxed - self->file_funs_len].uses += demoted->uses;
+    demoted->is_demoted = true;
+    FREE(IrFun, self->funs[demoted->id]);
+    self->funs[demoted->id] = NULL;
+}
+
+Usize
+limit_instances__IrModule(struct IrModule *self, Usize limit)
+{
+    Usize demoted = 0;
+
+    if (limit == 0)
+        return 0;
+
+    Usize *instances = malloc(sizeof(Usize) * (self->instances_len + 1));
+
+    for (Usize fun = 0; fun < self->file_funs_len; fun++) {
+        if (!self->generics[fun])
+            continue;
+
+        Usize len = 0;
+
+        // The specialized instances, sorted by the number of calls (the first
+        // instance wins a tie).
+        for (Usize i = 0; i < self->instances_len; i++) {
+            struct IrInstance *instance = &self->instances[i];
+
+            if (instance->fun != fun || instance->is_boxed ||
+                !self->funs[instance->id])
+                continue;
+
+            Usize j = len++;
+
+            for (; j > 0 && self->instances[instances[j - 1]].uses <
+                              instance->uses;
+                 j--)
+                instances[j] = instances[j - 1];
+
+            instances[j] = i;
+        }
+
+        if (len <= limit)
+            continue;
+
+        Usize boxed =
+          instantiate__IrModule(self, fun, self->generics[fun]->params);
+
+        drop_unlowered_boxed(self);
+
+        if (boxed == IR_NONE || !self->funs[boxed])
+            continue;
+
+        for (Usize i = limit; i < len; i++)
+            if (is_boxable_instance(&self->instances[instances[i]])) {
+                demote_instance(self, instances[i], boxed);
+                demoted++;
+            }
+    }
+
+    free(instances);
+
+    return demoted;
+}
+
+void
+__free__IrInstance(struct IrInstance *self)
+{
+    FREE(String, self->name);
+    free(self->args);
+    free(self->key);
+}
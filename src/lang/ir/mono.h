@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LILY_IR_MONO_H
+#define LILY_IR_MONO_H
+
+#include <lang/ir/ir.h>
+
+// The generic functions are monomorphized: each (function, data types of the
+// generic params) is lowered once, in its own C function, the instances are
+// cached by the address of the interned data types. To cap the growth of the
+// code, the instances which are called the least can share a boxed instance:
+// its generic values are a LilyBox (a union of the scalar data types) and the
+// callers box the arguments and unbox the result.
+
+/**
+ *
+ * @return true if the data type is a generic param or an implicit generic param
+ * (a boxed value in a boxed instance).
+ */
+bool
+is_generic__DataTypeSymbol(const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @return true if the data type is or contains a generic param.
+ */
+bool
+has_generic__DataTypeSymbol(const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @return true if a value of the data type can be boxed (a scalar).
+ */
+bool
+is_boxable__DataTypeSymbol(const struct DataTypeSymbol *data_type);
+
+/**
+ *
+ * @brief Construct the IrGeneric type.
+ * @return NULL if the function is not generic.
+ */
+struct IrGeneric *
+__new__IrGeneric(struct FunSymbol *fun);
+
+/**
+ *
+ * @brief Bind the generic params to the data types of the arguments.
+ * @param params The data type of the argument of each param.
+ * @param args The data type of each generic param (the result).
+ * @return false if a generic param has two data types.
+ */
+bool
+bind__IrGeneric(const struct IrGeneric *self,
+                struct DataTypeSymbol **params,
+                struct DataTypeSymbol **args);
+
+/**
+ *
+ * @brief Free the IrGeneric type.
+ */
+void
+__free__IrGeneric(struct IrGeneric *self);
+
+/**
+ *
+ * @return the index of the instance of the function for the args (one per
+ * generic param) in the instances of the module, IR_NONE if it is not in the
+ * cache.
+ */
+Usize
+search_instance__IrModule(const struct IrModule *self,
+                          Usize fun,
+                          struct DataTypeSymbol **args);
+
+/**
+ *
+ * @brief Add an instance (not lowered yet) of the function for the args and
+ * reserve its function in the module.
+ * @return the index of the instance in the instances of the module.
+ */
+Usize
+add_instance__IrModule(struct IrModule *self,
+                       Usize fun,
+                       struct DataTypeSymbol **args);
+
+/**
+ *
+ * @brief Keep at most limit instances per generic function: the calls of the
+ * instances used the least go to the boxed instance of the function. A
+ * function which operates on its generic values (x + y, println, ...) has no
+ * boxed instance, all its instances are kept.
+ * @param limit The maximum number of instances (0 for no limit).
+ * @return the number of demoted instances.
+ */
+Usize
+limit_instances__IrModule(struct IrModule *self, Usize limit);
+
+/**
+ *
+ * @brief Free the instance (not its function).
+ */
+void
+__free__IrInstance(struct IrInstance *self);
+
+#endif // LILY_IR_MONO_H
@@ -0,0 +1,1451 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/ir/closure.h>
+#include <lang/ir/pass.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Maximum number of rounds of the passes of -O1 on a function.
+#define IR_MAX_ROUNDS 8
+
+// The edges which jump to a block.
+typedef struct IrEdgeRefs
+{
+    struct IrEdge **items; // struct IrEdge&
+    Usize len;
+    Usize capacity;
+} IrEdgeRefs;
+
+Str
+get_name__IrPass(enum IrPass pass)
+{
+    switch (pass) {
+        case IrPassCopyPropagation:
+            return "copy-prop";
+        case IrPassConstantFolding:
+            return "const-fold";
+        case IrPassSimplifyCfg:
+            return "simplify-cfg";
+        case IrPassDeadCode:
+            return "dce";
+        case IrPassInline:
+            return "inline";
+        case IrPassEscape:
+            return "escape";
+        case IrPassRange:
+            return "range";
+        default:
+            UNREACHABLE("unknown IR pass");
+    }
+}
+
+static struct IrEdgeRefs *
+collect_edges(struct IrFun *self)
+{
+    struct IrEdgeRefs *refs =
+      calloc(self->blocks_len + 1, sizeof(struct IrEdgeRefs));
+
+    for (Usize i = 0; i < self->blocks_len; i++)
+        for (Usize j = 0; j < get_edges_len__IrTerm(&self->blocks[i].term);
+             j++) {
+            struct IrEdge *edge = get_edge__IrTerm(&self->blocks[i].term, j);
+            struct IrEdgeRefs *to = &refs[edge->block];
+
+            if (to->len == to->capacity) {
+                to->capacity = to->capacity ? to->capacity * 2 : 4;
+                to->items =
+                  realloc(to->items, to->capacity * sizeof(struct IrEdge *));
+            }
+
+            to->items[to->len++] = edge;
+        }
+
+    return refs;
+}
+
+static void
+free_edges(struct IrEdgeRefs *refs, Usize len)
+{
+    for (Usize i = 0; i < len; i++)
+        free(refs[i].items);
+
+    free(refs);
+}
+
+static Usize *
+new_repl(struct IrFun *self)
+{
+    Usize *repl = malloc((self->regs_len + 1) * sizeof(Usize));
+
+    for (Usize i = 0; i < self->regs_len; i++)
+        repl[i] = i;
+
+    return repl;
+}
+
+static Usize
+resolve(Usize *repl, Usize reg)
+{
+    if (reg == IR_NONE)
+        return reg;
+
+    Usize root = reg;
+
+    while (repl[root] != root)
+        root = repl[root];
+
+    while (repl[reg] != root) {
+        Usize next = repl[reg];
+
+        repl[reg] = root;
+        reg = next;
+    }
+
+    return root;
+}
+
+static void
+rewrite_uses(struct IrFun *self, Usize *repl)
+{
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        struct IrBlock *block = &self->blocks[i];
+
+        for (Usize j = 0; j < block->insts_len; j++)
+            for (Usize k = 0; k < block->insts[j].args_len; k++)
+                block->insts[j].args[k] =
+                  resolve(repl, block->insts[j].args[k]);
+
+        if (block->term.kind == IrTermKindBranch ||
+            block->term.kind == IrTermKindSwitch ||
+            block->term.kind == IrTermKindReturn)
+            block->term.value = resolve(repl, block->term.value);
+
+        for (Usize j = 0; j < get_edges_len__IrTerm(&block->term); j++) {
+            struct IrEdge *edge = get_edge__IrTerm(&block->term, j);
+
+            for (Usize k = 0; k < edge->args_len; k++)
+                edge->args[k] = resolve(repl, edge->args[k]);
+        }
+    }
+}
+
+static void
+remove_param(struct IrFun *self,
+             Usize block,
+             Usize param,
+             struct IrEdgeRefs *refs)
+{
+    struct IrBlock *ir_block = &self->blocks[block];
+
+    memmove(&ir_block->params[param],
+            &ir_block->params[param + 1],
+            (ir_block->params_len - param - 1) * sizeof(Usize));
+    ir_block->params_len--;
+
+    for (Usize i = 0; i < refs[block].len; i++) {
+        struct IrEdge *edge = refs[block].items[i];
+
+        memmove(&edge->args[param],
+                &edge->args[param + 1],
+                (edge->args_len - param - 1) * sizeof(Usize));
+        edge->args_len--;
+    }
+}
+
+static bool
+eq_edge(const struct IrEdge *x, const struct IrEdge *y)
+{
+    return x->block == y->block && x->args_len == y->args_len &&
+           (!x->args_len ||
+            !memcmp(x->args, y->args, x->args_len * sizeof(Usize)));
+}
+
+// Replace the branch or the switch by a jump on one of its edges.
+static void
+jump_to_edge(struct IrTerm *term, Usize edge)
+{
+    struct IrEdge taken = *get_edge__IrTerm(term, edge);
+
+    *get_edge__IrTerm(term, edge) = (struct IrEdge){ 0 };
+    FREE(IrTerm, term);
+    *term = (struct IrTerm){ .kind = IrTermKindJump,
+                             .value = IR_NONE,
+                             .edges[0] = taken };
+}
+
+static void
+remove_inst(struct IrBlock *self, Usize inst)
+{
+    FREE(IrInst, &self->insts[inst]);
+    memmove(&self->insts[inst],
+            &self->insts[inst + 1],
+            (self->insts_len - inst - 1) * sizeof(struct IrInst));
+    self->insts_len--;
+}
+
+bool
+propagate_copies__IrFun(struct IrFun *self)
+{
+    Usize *repl = new_repl(self);
+    Usize *boxed = new_repl(self);
+    bool changed = false;
+
+    // unbox (box x) is x (an inlined boxed instance).
+    for (Usize i = 0; i < self->blocks_len; i++)
+        for (Usize j = 0; j < self->blocks[i].insts_len; j++)
+            if (self->blocks[i].insts[j].kind == IrInstKindBox)
+                boxed[self->blocks[i].insts[j].dst] =
+                  self->blocks[i].insts[j].args[0];
+
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        struct IrBlock *block = &self->blocks[i];
+
+        for (Usize j = block->insts_len; j-- > 0;) {
+            struct IrInst *inst = &block->insts[j];
+
+            if (inst->kind == IrInstKindUnbox &&
+                boxed[inst->args[0]] != inst->args[0] &&
+                self->regs[boxed[inst->args[0]]] == self->regs[inst->dst])
+                inst->args[0] = boxed[inst->args[0]];
+            else if (inst->kind != IrInstKindCopy)
+                continue;
+
+            repl[inst->dst] = inst->args[0];
+            remove_inst(block, j);
+            changed = true;
+        }
+    }
+
+    free(boxed);
+
+    // A parameter whose arguments are a single value (or the parameter itself,
+    // in a loop) is this value: x := 0 while c do println("{}", x) end.
+    struct IrEdgeRefs *refs = collect_edges(self);
+    bool changed_params = true;
+
+    while (changed_params) {
+        changed_params = false;
+
+        for (Usize i = 1; i < self->blocks_len; i++) {
+            struct IrBlock *block = &self->blocks[i];
+
+            for (Usize j = block->params_len; j-- > 0;) {
+                Usize param = block->params[j];
+                Usize value = IR_NONE;
+                bool is_trivial = true;
+
+                for (Usize k = 0; k < refs[i].len && is_trivial; k++) {
+                    Usize arg = resolve(repl, refs[i].items[k]->args[j]);
+
+                    if (arg == param || arg == value)
+                        continue;
+                    else if (value == IR_NONE)
+                        value = arg;
+                    else
+                        is_trivial = false;
+                }
+
+                if (is_trivial && value != IR_NONE) {
+                    repl[param] = value;
+                    remove_param(self, i, j, refs);
+                    changed_params = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    free_edges(refs, self->blocks_len);
+
+    if (changed)
+        rewrite_uses(self, repl);
+
+    free(repl);
+
+    return changed;
+}
+
+static bool
+get_int(struct LiteralSymbol literal, Int128 *value)
+{
+    switch (literal.kind) {
+        case LiteralSymbolKindInt8:
+            *value = literal.value.int8;
+            return true;
+        case LiteralSymbolKindInt16:
+            *value = literal.value.int16;
+            return true;
+        case LiteralSymbolKindInt32:
+            *value = literal.value.int32;
+            return true;
+        case LiteralSymbolKindInt64:
+            *value = literal.value.int64;
+            return true;
+        case LiteralSymbolKindUint8:
+            *value = literal.value.uint8;
+            return true;
+        case LiteralSymbolKindUint16:
+            *value = literal.value.uint16;
+            return true;
+        case LiteralSymbolKindUint32:
+            *value = literal.value.uint32;
+            return true;
+        case LiteralSymbolKindUint64:
+            *value = literal.value.uint64;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool
+get_float(struct LiteralSymbol literal, Float64 *value)
+{
+    switch (literal.kind) {
+        case LiteralSymbolKindFloat32:
+            *value = literal.value.float32;
+            return true;
+        case LiteralSymbolKindFloat64:
+            *value = literal.value.float64;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The folded integers are at most 64 bits wide: Int128 holds all their values
+// and the results of their operations before the range check.
+typedef struct IrIntType
+{
+    enum LiteralSymbolKind kind;
+    Int128 min;
+    Int128 max;
+    Usize width;
+} IrIntType;
+
+static bool
+get_int_type(struct DataTypeSymbol *data_type, struct IrIntType *type)
+{
+    switch (data_type ? data_type->kind : DataTypeKindCompilerDefined) {
+        case DataTypeKindI8:
+            *type = (struct IrIntType){ LiteralSymbolKindInt8, INT8_MIN,
+                                        INT8_MAX, 8 };
+            return true;
+        case DataTypeKindI16:
+            *type = (struct IrIntType){ LiteralSymbolKindInt16, INT16_MIN,
+                                        INT16_MAX, 16 };
+            return true;
+        case DataTypeKindI32:
+            *type = (struct IrIntType){ LiteralSymbolKindInt32, INT32_MIN,
+                                        INT32_MAX, 32 };
+            return true;
+        case DataTypeKindI64:
+            *type = (struct IrIntType){ LiteralSymbolKindInt64, INT64_MIN,
+                                        INT64_MAX, 64 };
+            return true;
+        case DataTypeKindU8:
+            *type =
+              (struct IrIntType){ LiteralSymbolKindUint8, 0, UINT8_MAX, 8 };
+            return true;
+        case DataTypeKindU16:
+            *type =
+              (struct IrIntType){ LiteralSymbolKindUint16, 0, UINT16_MAX, 16 };
+            return true;
+        case DataTypeKindU32:
+            *type =
+              (struct IrIntType){ LiteralSymbolKindUint32, 0, UINT32_MAX, 32 };
+            return true;
+        case DataTypeKindU64:
+            *type =
+              (struct IrIntType){ LiteralSymbolKindUint64, 0, UINT64_MAX, 64 };
+            return true;
+        default:
+            return false;
+    }
+}
+
+static struct LiteralSymbol
+new_int(struct IrIntType type, struct DataTypeSymbol *data_type, Int128 value)
+{
+    struct LiteralSymbol literal = { .kind = type.kind,
+                                     .data_type = data_type };
+
+    switch (type.kind) {
+        case LiteralSymbolKindInt8:
+            literal.value.int8 = (Int8)value;
+            break;
+        case LiteralSymbolKindInt16:
+            literal.value.int16 = (Int16)value;
+            break;
+        case LiteralSymbolKindInt32:
+            literal.value.int32 = (Int32)value;
+            break;
+        case LiteralSymbolKindInt64:
+            literal.value.int64 = (Int64)value;
+            break;
+        case LiteralSymbolKindUint8:
+            literal.value.uint8 = (UInt8)value;
+            break;
+        case LiteralSymbolKindUint16:
+            literal.value.uint16 = (UInt16)value;
+            break;
+        case LiteralSymbolKindUint32:
+            literal.value.uint32 = (UInt32)value;
+            break;
+        case LiteralSymbolKindUint64:
+            literal.value.uint64 = (UInt64)value;
+            break;
+        default:
+            UNREACHABLE("expected integer literal");
+    }
+
+    return literal;
+}
+
+static inline struct LiteralSymbol
+new_bool(struct DataTypeSymbol *data_type, bool value)
+{
+    return (struct LiteralSymbol){ .kind = LiteralSymbolKindBool,
+                                   .data_type = data_type,
+                                   .value.bool_ = value };
+}
+
+static bool
+fold_compare(enum IrOp op, int order, bool *result)
+{
+    switch (op) {
+        case IrOpLt:
+            *result = order < 0;
+            return true;
+        case IrOpGt:
+            *result = order > 0;
+            return true;
+        case IrOpLe:
+            *result = order <= 0;
+            return true;
+        case IrOpGe:
+            *result = order >= 0;
+            return true;
+        case IrOpEq:
+            *result = order == 0;
+            return true;
+        case IrOpNe:
+            *result = order != 0;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Same semantics as the generated C: the operations which overflow are not
+// folded (they panic), the unsigned shifts wrap.
+static enum IrFoldStatus
+fold_int(const struct IrFun *fun,
+         const struct IrInst *inst,
+         Int128 x,
+         Int128 y,
+         struct LiteralSymbol *result)
+{
+    struct DataTypeSymbol *data_type = fun->regs[inst->dst];
+    struct IrIntType type;
+    Int128 value;
+    bool order;
+
+    if (fold_compare(inst->value.op, (x > y) - (x < y), &order)) {
+        *result = new_bool(data_type, order);
+        return IrFoldStatusDone;
+    }
+
+    if (!get_int_type(data_type, &type))
+        return IrFoldStatusUnknown;
+
+    switch (inst->value.op) {
+        case IrOpAdd:
+            value = x + y;
+            break;
+        case IrOpSub:
+            value = x - y;
+            break;
+        case IrOpMul:
+            if (__builtin_mul_overflow(x, y, &value))
+                return IrFoldStatusPanic;
+
+            break;
+        case IrOpDiv:
+        case IrOpMod:
+            if (y == 0)
+                return IrFoldStatusPanic;
+
+            value = inst->value.op == IrOpDiv ? x / y : x % y;
+            break;
+        case IrOpXor:
+            value = x ^ y;
+            break;
+        case IrOpBitOr:
+            value = x | y;
+            break;
+        case IrOpBitAnd:
+            value = x & y;
+            break;
+        case IrOpShl:
+            if (y < 0 || y >= (Int128)type.width || x < 0)
+                return IrFoldStatusPanic;
+
+            value = x << y;
+
+            if (type.min == 0)
+                value &= type.max;
+
+            break;
+        case IrOpShr:
+            if (y < 0 || y >= (Int128)type.width)
+                return IrFoldStatusPanic;
+
+            value = x >> y;
+            break;
+        case IrOpNeg:
+            value = -x;
+            break;
+        case IrOpBitNot:
+            value = type.min == 0 ? type.max - x : ~x;
+            break;
+        default:
+            return IrFoldStatusUnknown;
+    }
+
+    if (value < type.min || value > type.max)
+        return IrFoldStatusPanic;
+
+    *result = new_int(type, data_type, value);
+
+    return IrFoldStatusDone;
+}
+
+static bool
+fold_float(const struct IrFun *fun,
+           const struct IrInst *inst,
+           Float64 x,
+           Float64 y,
+           struct LiteralSymbol *result)
+{
+    struct DataTypeSymbol *data_type = fun->regs[inst->dst];
+    Float64 value;
+    bool order;
+
+    // The comparisons with NaN are false (except !=).
+    if (x != x || y != y) {
+        if (inst->value.op >= IrOpLt && inst->value.op <= IrOpNe) {
+            *result = new_bool(data_type, inst->value.op == IrOpNe);
+            return true;
+        }
+    } else if (fold_compare(inst->value.op, (x > y) - (x < y), &order)) {
+        *result = new_bool(data_type, order);
+        return true;
+    }
+
+    switch (inst->value.op) {
+        case IrOpAdd:
+            value = x + y;
+            break;
+        case IrOpSub:
+            value = x - y;
+            break;
+        case IrOpMul:
+            value = x * y;
+            break;
+        case IrOpDiv:
+            value = x / y;
+            break;
+        case IrOpNeg:
+            value = -x;
+            break;
+        default:
+            return false;
+    }
+
+    if (!data_type || (data_type->kind != DataTypeKindF32 &&
+                       data_type->kind != DataTypeKindF64))
+        return false;
+
+    *result =
+      data_type->kind == DataTypeKindF32
+        ? (struct LiteralSymbol){ .kind = LiteralSymbolKindFloat32,
+                                  .data_type = data_type,
+                                  .value.float32 = (Float32)value }
+        : (struct LiteralSymbol){ .kind = LiteralSymbolKindFloat64,
+                                  .data_type = data_type,
+                                  .value.float64 = value };
+
+    return true;
+}
+
+static bool
+fold_bool(const struct IrFun *fun,
+          const struct IrInst *inst,
+          bool x,
+          bool y,
+          struct LiteralSymbol *result)
+{
+    switch (inst->value.op) {
+        case IrOpNot:
+            *result = new_bool(fun->regs[inst->dst], !x);
+            return true;
+        case IrOpEq:
+            *result = new_bool(fun->regs[inst->dst], x == y);
+            return true;
+        case IrOpNe:
+        case IrOpXor:
+            *result = new_bool(fun->regs[inst->dst], x != y);
+            return true;
+        default:
+            return false;
+    }
+}
+
+enum IrFoldStatus
+fold__IrInst(const struct IrFun *fun,
+             const struct IrInst *inst,
+             const struct LiteralSymbol *x,
+             const struct LiteralSymbol *y,
+             struct LiteralSymbol *result)
+{
+    Int128 x_int, y_int = 0;
+    Float64 x_float, y_float = 0;
+    bool folded = false;
+
+    if (get_int(*x, &x_int) && (!y || get_int(*y, &y_int)))
+        return fold_int(fun, inst, x_int, y_int, result);
+    else if (get_float(*x, &x_float) && (!y || get_float(*y, &y_float)))
+        folded = fold_float(fun, inst, x_float, y_float, result);
+    else if (x->kind == LiteralSymbolKindBool &&
+             (!y || y->kind == LiteralSymbolKindBool))
+        folded =
+          fold_bool(fun, inst, x->value.bool_, y && y->value.bool_, result);
+    else if (x->kind == LiteralSymbolKindChar && y &&
+             y->kind == LiteralSymbolKindChar) {
+        bool order;
+
+        if (fold_compare(inst->value.op,
+                         (x->value.char_ > y->value.char_) -
+                           (x->value.char_ < y->value.char_),
+                         &order)) {
+            *result = new_bool(fun->regs[inst->dst], order);
+            folded = true;
+        }
+    }
+
+    return folded ? IrFoldStatusDone : IrFoldStatusUnknown;
+}
+
+bool
+fold_constants__IrFun(struct IrFun *self)
+{
+    // The constant value of each register (NULL if unknown).
+    struct LiteralSymbol **values =
+      calloc(self->regs_len + 1, sizeof(struct LiteralSymbol *));
+    // The variant instruction which defines each register (NULL if unknown).
+    struct IrInst **variants =
+      calloc(self->regs_len + 1, sizeof(struct IrInst *));
+    bool changed = false;
+    bool changed_round = true;
+
+    // The blocks are not sorted in dominance order (loops): the rounds stop
+    // when nothing changes.
+    while (changed_round) {
+        changed_round = false;
+
+        for (Usize i = 0; i < self->blocks_len; i++) {
+            struct IrBlock *block = &self->blocks[i];
+
+            for (Usize j = 0; j < block->insts_len; j++) {
+                struct IrInst *inst = &block->insts[j];
+                struct LiteralSymbol result;
+
+                if (inst->kind == IrInstKindConst) {
+                    values[inst->dst] = &inst->value.literal;
+                    continue;
+                } else if (inst->kind == IrInstKindVariant) {
+                    variants[inst->dst] = inst;
+                    continue;
+                } else if (inst->kind == IrInstKindPayload &&
+                           variants[inst->args[0]] &&
+                           variants[inst->args[0]]->args_len) {
+                    // payload (variant V x) is x.
+                    inst->kind = IrInstKindCopy;
+                    inst->args[0] = variants[inst->args[0]]->args[0];
+                    changed_round = true;
+                    changed = true;
+                    continue;
+                } else if ((inst->kind != IrInstKindUnary &&
+                            inst->kind != IrInstKindBinary) ||
+                           !values[inst->args[0]] ||
+                           (inst->kind == IrInstKindBinary &&
+                            !values[inst->args[1]]))
+                    continue;
+
+                if (fold__IrInst(self,
+                                 inst,
+                                 values[inst->args[0]],
+                                 inst->kind == IrInstKindBinary
+                                   ? values[inst->args[1]]
+                                   : NULL,
+                                 &result) == IrFoldStatusDone) {
+                    FREE(IrInst, inst);
+                    *inst = (struct IrInst){ .kind = IrInstKindConst,
+                                             .dst = inst->dst,
+                                             .value.literal = result };
+                    values[inst->dst] = &inst->value.literal;
+                    changed_round = true;
+                    changed = true;
+                }
+            }
+
+            struct IrTerm *term = &block->term;
+
+            Int64 value;
+
+            if (term->kind == IrTermKindBranch && values[term->value] &&
+                values[term->value]->kind == LiteralSymbolKindBool) {
+                jump_to_edge(term, values[term->value]->value.bool_ ? 0 : 1);
+                changed_round = true;
+                changed = true;
+            } else if (term->kind == IrTermKindSwitch &&
+                       ((values[term->value] &&
+                         get_case_value__LiteralSymbol(values[term->value],
+                                                       &value)) ||
+                        variants[term->value])) {
+                Usize taken = 0;
+
+                if (variants[term->value])
+                    value = variants[term->value]->value.variant;
+
+                for (Usize k = 0; k < term->cases_len && !taken; k++)
+                    if (term->cases[k].value == value)
+                        taken = k + 1;
+
+                jump_to_edge(term, taken);
+                changed_round = true;
+                changed = true;
+            }
+        }
+    }
+
+    free(values);
+    free(variants);
+
+    return changed;
+}
+
+// The instructions which can panic or print are kept even if their value is
+// not used.
+static bool
+has_effect(const struct IrFun *fun, const struct IrInst *inst)
+{
+    struct DataTypeSymbol *data_type =
+      inst->args_len ? fun->regs[inst->args[0]] : NULL;
+    bool is_float = data_type && (data_type->kind == DataTypeKindF32 ||
+                                  data_type->kind == DataTypeKindF64);
+
+    switch (inst->kind) {
+        case IrInstKindCall:
+        case IrInstKindCallClosure:
+        case IrInstKindPrint:
+            return true;
+        case IrInstKindUnary:
+            return inst->value.op == IrOpNeg && !is_float &&
+                   !inst->is_unchecked;
+        case IrInstKindBinary:
+            return inst->value.op <= IrOpMod && !is_float &&
+                   !inst->is_unchecked;
+        default:
+            return false;
+    }
+}
+
+static void
+mark_live(bool *live, Usize **stack, Usize *len, Usize reg)
+{
+    if (reg == IR_NONE || live[reg])
+        return;
+
+    live[reg] = true;
+    (*stack)[(*len)++] = reg;
+}
+
+bool
+eliminate_dead_code__IrFun(struct IrFun *self)
+{
+    Usize regs_len = self->regs_len + 1;
+    bool *live = calloc(regs_len, sizeof(bool));
+    Usize *stack = malloc(regs_len * sizeof(Usize));
+    Usize stack_len = 0;
+    // The definition of each register: an instruction or a parameter.
+    Usize *def_block = malloc(regs_len * sizeof(Usize));
+    Usize *def_index = malloc(regs_len * sizeof(Usize));
+    bool *def_is_param = calloc(regs_len, sizeof(bool));
+    struct IrEdgeRefs *refs = collect_edges(self);
+    bool changed = false;
+
+    for (Usize i = 0; i < regs_len; i++)
+        def_block[i] = IR_NONE;
+
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        struct IrBlock *block = &self->blocks[i];
+
+        for (Usize j = 0; j < block->params_len; j++) {
+            def_block[block->params[j]] = i;
+            def_index[block->params[j]] = j;
+            def_is_param[block->params[j]] = true;
+        }
+
+        for (Usize j = 0; j < block->insts_len; j++) {
+            struct IrInst *inst = &block->insts[j];
+
+            if (inst->dst != IR_NONE) {
+                def_block[inst->dst] = i;
+                def_index[inst->dst] = j;
+            }
+
+            if (has_effect(self, inst))
+                for (Usize k = 0; k < inst->args_len; k++)
+                    mark_live(live, &stack, &stack_len, inst->args[k]);
+        }
+
+        if (block->term.kind == IrTermKindBranch ||
+            block->term.kind == IrTermKindSwitch ||
+            block->term.kind == IrTermKindReturn)
+            mark_live(live, &stack, &stack_len, block->term.value);
+
+        // The parameters of the entry are the parameters of the function.
+        if (i == 0)
+            for (Usize j = 0; j < block->params_len; j++)
+                mark_live(live, &stack, &stack_len, block->params[j]);
+    }
+
+    while (stack_len) {
+        Usize reg = stack[--stack_len];
+        Usize block = def_block[reg];
+
+        if (block == IR_NONE)
+            continue;
+        else if (def_is_param[reg]) {
+            for (Usize i = 0; i < refs[block].len; i++)
+                mark_live(live,
+                          &stack,
+                          &stack_len,
+                          refs[block].items[i]->args[def_index[reg]]);
+        } else {
+            struct IrInst *inst = &self->blocks[block].insts[def_index[reg]];
+
+            for (Usize i = 0; i < inst->args_len; i++)
+                mark_live(live, &stack, &stack_len, inst->args[i]);
+        }
+    }
+
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        struct IrBlock *block = &self->blocks[i];
+
+        for (Usize j = block->insts_len; j-- > 0;)
+            if (!has_effect(self, &block->insts[j]) &&
+                (block->insts[j].dst == IR_NONE ||
+                 !live[block->insts[j].dst])) {
+                remove_inst(block, j);
+                changed = true;
+            }
+
+        for (Usize j = block->params_len; i > 0 && j-- > 0;)
+            if (!live[block->params[j]]) {
+                remove_param(self, i, j, refs);
+                changed = true;
+            }
+    }
+
+    free_edges(refs, self->blocks_len);
+    free(live);
+    free(stack);
+    free(def_block);
+    free(def_index);
+    free(def_is_param);
+
+    return changed;
+}
+
+static bool
+is_forward_block(const struct IrFun *self, Usize block)
+{
+    const struct IrBlock *ir_block = &self->blocks[block];
+
+    return block != 0 && ir_block->params_len == 0 &&
+           ir_block->insts_len == 0 && ir_block->term.kind == IrTermKindJump;
+}
+
+// Follow the empty blocks which only jump: return the edge which leaves the
+// last one (NULL if the edge does not jump to an empty block or on a cycle).
+static const struct IrEdge *
+get_forward_edge(const struct IrFun *self, Usize block)
+{
+    const struct IrEdge *edge = NULL;
+
+    for (Usize i = 0; i < self->blocks_len && is_forward_block(self, block);
+         i++) {
+        edge = &self->blocks[block].term.edges[0];
+        block = edge->block;
+    }
+
+    return is_forward_block(self, block) ? NULL : edge;
+}
+
+static bool
+remove_unreachable_blocks(struct IrFun *self)
+{
+    Usize *map = malloc((self->blocks_len + 1) * sizeof(Usize));
+    Usize *stack = malloc((self->blocks_len + 1) * sizeof(Usize));
+    Usize stack_len = 0;
+    Usize len = 0;
+
+    for (Usize i = 0; i < self->blocks_len; i++)
+        map[i] = IR_NONE;
+
+    map[0] = 0;
+    stack[stack_len++] = 0;
+
+    while (stack_len) {
+        struct IrTerm *term = &self->blocks[stack[--stack_len]].term;
+
+        for (Usize i = 0; i < get_edges_len__IrTerm(term); i++) {
+            Usize block = get_edge__IrTerm(term, i)->block;
+
+            if (map[block] == IR_NONE) {
+                map[block] = 0;
+                stack[stack_len++] = block;
+            }
+        }
+    }
+
+    for (Usize i = 0; i < self->blocks_len; i++)
+        if (map[i] != IR_NONE) {
+            map[i] = len;
+            self->blocks[len++] = self->blocks[i];
+        } else
+            FREE(IrBlock, &self->blocks[i]);
+
+    bool changed = len != self->blocks_len;
+
+    self->blocks_len = len;
+
+    for (Usize i = 0; changed && i < len; i++)
+        for (Usize j = 0; j < get_edges_len__IrTerm(&self->blocks[i].term);
+             j++) {
+            struct IrEdge *edge = get_edge__IrTerm(&self->blocks[i].term, j);
+
+            edge->block = map[edge->block];
+        }
+
+    free(map);
+    free(stack);
+
+    return changed;
+}
+
+// The instructions of the block go at the end of its single predecessor, which
+// jumps to it.
+static void
+merge_block(struct IrFun *self, Usize pred, Usize block, Usize *repl)
+{
+    struct IrBlock *ir_pred = &self->blocks[pred];
+    struct IrBlock *ir_block = &self->blocks[block];
+    struct IrEdge *edge = &ir_pred->term.edges[0];
+
+    for (Usize i = 0; i < ir_block->params_len; i++)
+        repl[ir_block->params[i]] = edge->args[i];
+
+    for (Usize i = 0; i < ir_block->insts_len; i++)
+        push_inst__IrBlock(ir_pred, ir_block->insts[i]);
+
+    free(edge->args);
+    ir_pred->term = ir_block->term;
+    ir_block->term = (struct IrTerm){ .kind = IrTermKindUnreachable };
+    ir_block->insts_len = 0;
+    ir_block->params_len = 0;
+}
+
+bool
+simplify_cfg__IrFun(struct IrFun *self)
+{
+    Usize *repl = new_repl(self);
+    bool changed = false;
+    bool changed_round = true;
+
+    while (changed_round) {
+        changed_round = false;
+
+        for (Usize i = 0; i < self->blocks_len; i++) {
+            struct IrTerm *term = &self->blocks[i].term;
+
+            // br c, bb1(x), bb1(x) -> jmp bb1(x) (same for a switch)
+            if (term->kind == IrTermKindBranch ||
+                term->kind == IrTermKindSwitch) {
+                bool is_single = true;
+
+                for (Usize j = 1; j < get_edges_len__IrTerm(term) && is_single;
+                     j++)
+                    is_single = eq_edge(get_edge__IrTerm(term, 0),
+                                        get_edge__IrTerm(term, j));
+
+                if (is_single) {
+                    jump_to_edge(term, 0);
+                    changed_round = true;
+                }
+            }
+
+            for (Usize j = 0; j < get_edges_len__IrTerm(term); j++) {
+                struct IrEdge *edge = get_edge__IrTerm(term, j);
+                const struct IrEdge *forward =
+                  get_forward_edge(self, edge->block);
+
+                if (!forward || forward == edge)
+                    continue;
+
+                // The empty block has no parameter: the edge has no argument.
+                edge->block = forward->block;
+
+                for (Usize k = 0; k < forward->args_len; k++)
+                    push_arg__IrEdge(edge, forward->args[k]);
+
+                changed_round = true;
+            }
+        }
+
+        changed_round |= remove_unreachable_blocks(self);
+
+        Usize *preds = calloc(self->blocks_len + 1, sizeof(Usize));
+
+        for (Usize i = 0; i < self->blocks_len; i++)
+            for (Usize j = 0; j < get_edges_len__IrTerm(&self->blocks[i].term);
+                 j++)
+                preds[get_edge__IrTerm(&self->blocks[i].term, j)->block]++;
+
+        for (Usize i = 0; i < self->blocks_len; i++)
+            while (self->blocks[i].term.kind == IrTermKindJump) {
+                Usize block = self->blocks[i].term.edges[0].block;
+
+                if (block == 0 || block == i || preds[block] != 1)
+                    break;
+
+                merge_block(self, i, block, repl);
+                preds[block] = 0;
+                changed_round = true;
+            }
+
+        free(preds);
+
+        changed_round |= remove_unreachable_blocks(self);
+        changed |= changed_round;
+    }
+
+    if (changed)
+        rewrite_uses(self, repl);
+
+    free(repl);
+
+    return changed;
+}
+
+static bool
+is_inlinable(const struct IrFun *self)
+{
+    if (!self || self->blocks_len > IR_INLINE_MAX_BLOCKS ||
+        count_insts__IrFun(self) > IR_INLINE_MAX_INSTS)
+        return false;
+
+    for (Usize i = 0; i < self->blocks_len; i++)
+        for (Usize j = 0; j < self->blocks[i].insts_len; j++)
+            if (self->blocks[i].insts[j].kind == IrInstKindCall ||
+                self->blocks[i].insts[j].kind == IrInstKindCallClosure)
+                return false;
+
+    return true;
+}
+
+// The lambda called by callclosure if its closure is created in the function
+// (NULL if it's not known).
+static struct IrFun *
+get_called_lambda(const struct IrModule *module,
+                  const struct IrFun *fun,
+                  const struct IrInst *call)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            const struct IrInst *inst = &fun->blocks[i].insts[j];
+
+            if (inst->dst == call->args[0])
+                return inst->kind == IrInstKindClosure
+                         ? module->lambdas[inst->value.closure.lambda].fun
+                         : NULL;
+        }
+
+    return NULL;
+}
+
+// callclosure %f, %x -> the captures of the closure %f, then %x (the params of
+// the lambda).
+static void
+pass_captures(const struct IrFun *fun, struct IrInst *call)
+{
+    const struct IrInst *closure = NULL;
+
+    for (Usize i = 0; i < fun->blocks_len && !closure; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            if (fun->blocks[i].insts[j].dst == call->args[0]) {
+                closure = &fun->blocks[i].insts[j];
+                break;
+            }
+
+    Usize len = closure->args_len + call->args_len - 1;
+    Usize *args = malloc((len + 1) * sizeof(Usize));
+
+    if (closure->args_len)
+        memcpy(args, closure->args, closure->args_len * sizeof(Usize));
+
+    if (call->args_len > 1)
+        memcpy(args + closure->args_len,
+               call->args + 1,
+               (call->args_len - 1) * sizeof(Usize));
+
+    free(call->args);
+    call->args = args;
+    call->args_len = len;
+}
+
+static void
+copy_edge(struct IrEdge *to,
+          const struct IrEdge *from,
+          const Usize *regs,
+          Usize blocks_start)
+{
+    *to = (struct IrEdge){ .block = blocks_start + from->block };
+
+    for (Usize i = 0; i < from->args_len; i++)
+        push_arg__IrEdge(to, regs[from->args[i]]);
+}
+
+// The block of the call is split: it jumps to the copy of the callee, whose
+// returns jump to the rest of the block with the result as parameter.
+static void
+inline_call(struct IrFun *self,
+            Usize block,
+            Usize inst,
+            const struct IrFun *callee)
+{
+    Usize next = add_block__IrFun(self);
+    Usize blocks_start = self->blocks_len;
+    struct IrBlock *ir_block = &self->blocks[block];
+    struct IrBlock *ir_next = &self->blocks[next];
+    struct IrInst call = ir_block->insts[inst];
+
+    if (call.dst != IR_NONE)
+        push_param__IrBlock(ir_next, call.dst);
+
+    for (Usize i = inst + 1; i < ir_block->insts_len; i++)
+        push_inst__IrBlock(ir_next, ir_block->insts[i]);
+
+    ir_next->term = ir_block->term;
+    ir_block->insts_len = inst;
+    ir_block->term = (struct IrTerm){ .kind = IrTermKindJump,
+                                      .value = IR_NONE,
+                                      .edges[0] = { .block = blocks_start } };
+
+    for (Usize i = 0; i < call.args_len; i++)
+        push_arg__IrEdge(&ir_block->term.edges[0], call.args[i]);
+
+    FREE(IrInst, &call);
+
+    Usize *regs = malloc((callee->regs_len + 1) * sizeof(Usize));
+
+    for (Usize i = 0; i < callee->regs_len; i++)
+        regs[i] = add_reg__IrFun(self, callee->regs[i]);
+
+    for (Usize i = 0; i < callee->blocks_len; i++)
+        add_block__IrFun(self);
+
+    for (Usize i = 0; i < callee->blocks_len; i++) {
+        const struct IrBlock *from = &callee->blocks[i];
+        struct IrBlock *to = &self->blocks[blocks_start + i];
+
+        for (Usize j = 0; j < from->params_len; j++)
+            push_param__IrBlock(to, regs[from->params[j]]);
+
+        for (Usize j = 0; j < from->insts_len; j++) {
+            struct IrInst copy = from->insts[j];
+
+            copy.dst = copy.dst == IR_NONE ? IR_NONE : regs[copy.dst];
+            copy.args =
+              copy.args_len ? malloc(copy.args_len * sizeof(Usize)) : NULL;
+
+            for (Usize k = 0; k < copy.args_len; k++)
+                copy.args[k] = regs[from->insts[j].args[k]];
+
+            push_inst__IrBlock(to, copy);
+        }
+
+        switch (from->term.kind) {
+            case IrTermKindReturn:
+                to->term = (struct IrTerm){ .kind = IrTermKindJump,
+                                            .value = IR_NONE,
+                                            .edges[0] = { .block = next } };
+
+                if (from->term.value != IR_NONE && call.dst != IR_NONE)
+                    push_arg__IrEdge(&to->term.edges[0],
+                                     regs[from->term.value]);
+
+                break;
+            case IrTermKindJump:
+            case IrTermKindBranch:
+            case IrTermKindSwitch:
+                to->term.kind = from->term.kind;
+                to->term.value = from->term.value == IR_NONE
+                                   ? IR_NONE
+                                   : regs[from->term.value];
+
+                for (Usize j = 0; j < from->term.cases_len; j++)
+                    push_case__IrTerm(&to->term, from->term.cases[j].value);
+
+                for (Usize j = 0; j < get_edges_len__IrTerm(&from->term); j++)
+                    copy_edge(get_edge__IrTerm(&to->term, j),
+                              get_edge__IrTerm((struct IrTerm *)&from->term, j),
+                              regs,
+                              blocks_start);
+
+                break;
+            default:
+                to->term = (struct IrTerm){ .kind = from->term.kind,
+                                            .value = IR_NONE };
+        }
+    }
+
+    free(regs);
+}
+
+static bool
+inline_fun(struct IrModule *self, struct IrFun *fun)
+{
+    bool changed = false;
+
+    // The blocks added by the inlining are visited too: the rest of the split
+    // block can have other calls.
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            struct IrInst *inst = &fun->blocks[i].insts[j];
+
+            struct IrFun *callee = NULL;
+
+            if (inst->kind == IrInstKindCall)
+                callee = self->funs[inst->value.fun];
+            else if (inst->kind == IrInstKindCallClosure)
+                callee = get_called_lambda(self, fun, inst);
+
+            if (callee != fun && is_inlinable(callee)) {
+                if (inst->kind == IrInstKindCallClosure)
+                    pass_captures(fun, inst);
+
+                inline_call(fun, i, j, callee);
+                changed = true;
+                break;
+            }
+        }
+
+    return changed;
+}
+
+bool
+inline_calls__IrModule(struct IrModule *self)
+{
+    bool changed = false;
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            changed |= inline_fun(self, self->funs[i]);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            changed |= inline_fun(self, self->consts[i]);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            changed |= inline_fun(self, self->lambdas[i].fun);
+
+    return changed;
+}
+
+static double
+now()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static Usize
+count_module_insts(const struct IrModule *self)
+{
+    Usize count = 0;
+
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            count += count_insts__IrFun(self->funs[i]);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            count += count_insts__IrFun(self->consts[i]);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            count += count_insts__IrFun(self->lambdas[i].fun);
+
+    return count;
+}
+
+static bool
+run_pass(struct IrFun *fun, enum IrPass pass, struct IrPassStats *stats)
+{
+    double start = stats ? now() : 0;
+    Usize insts = stats ? count_insts__IrFun(fun) : 0;
+    bool changed;
+
+    switch (pass) {
+        case IrPassCopyPropagation:
+            changed = propagate_copies__IrFun(fun);
+            break;
+        case IrPassConstantFolding:
+            changed = fold_constants__IrFun(fun);
+            break;
+        case IrPassSimplifyCfg:
+            changed = simplify_cfg__IrFun(fun);
+            break;
+        case IrPassDeadCode:
+            changed = eliminate_dead_code__IrFun(fun);
+            break;
+        default:
+            UNREACHABLE("expected a pass on a function");
+    }
+
+    if (stats) {
+        stats->runs[pass]++;
+        stats->time[pass] += now() - start;
+        stats->insts[pass] += (Isize)count_insts__IrFun(fun) - (Isize)insts;
+    }
+
+    return changed;
+}
+
+static void
+optimize_fun(struct IrFun *fun, struct IrPassStats *stats)
+{
+    bool changed = true;
+
+    for (Usize i = 0; i < IR_MAX_ROUNDS && changed; i++) {
+        changed = run_pass(fun, IrPassCopyPropagation, stats);
+        changed |= run_pass(fun, IrPassConstantFolding, stats);
+        changed |= run_pass(fun, IrPassSimplifyCfg, stats);
+        changed |= run_pass(fun, IrPassDeadCode, stats);
+    }
+}
+
+static void
+optimize_funs(struct IrModule *self, struct IrPassStats *stats)
+{
+    for (Usize i = 0; i < self->funs_len; i++)
+        if (self->funs[i])
+            optimize_fun(self->funs[i], stats);
+
+    for (Usize i = 0; i < self->consts_len; i++)
+        if (self->consts[i])
+            optimize_fun(self->consts[i], stats);
+
+    for (Usize i = 0; i < self->lambdas_len; i++)
+        if (self->lambdas[i].fun)
+            optimize_fun(self->lambdas[i].fun, stats);
+}
+
+void
+optimize__IrModule(struct IrModule *self,
+                   Usize level,
+                   struct IrPassStats *stats)
+{
+    if (level == 0) {
+        if (stats)
+            count_checks__IrModule(self, &stats->checks);
+
+        return;
+    }
+
+    optimize_funs(self, stats);
+
+    if (level >= 2) {
+        double start = stats ? now() : 0;
+        Usize insts = stats ? count_module_insts(self) : 0;
+        bool changed = inline_calls__IrModule(self);
+
+        if (stats) {
+            stats->runs[IrPassInline]++;
+            stats->time[IrPassInline] += now() - start;
+            stats->insts[IrPassInline] +=
+              (Isize)count_module_insts(self) - (Isize)insts;
+        }
+
+        // The lambdas whose closures are inlined are removed.
+        if (changed) {
+            optimize_funs(self, stats);
+            remove_unused_lambdas__IrModule(self);
+        }
+    }
+
+    // The closures are marked once their calls are inlined.
+    double start = stats ? now() : 0;
+
+    mark_escaping_closures__IrModule(self);
+
+    if (stats) {
+        stats->runs[IrPassEscape]++;
+        stats->time[IrPassEscape] += now() - start;
+    }
+
+    // The checks are removed once the code does not change anymore.
+    start = stats ? now() : 0;
+
+    eliminate_checks__IrModule(self);
+
+    if (stats) {
+        stats->runs[IrPassRange]++;
+        stats->time[IrPassRange] += now() - start;
+        count_checks__IrModule(self, &stats->checks);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IR_PASS_H
+#define LILY_IR_PASS_H
+
+#include <lang/ir/ir.h>
+#include <lang/ir/range.h>
+
+// A callee is inlined if it has no call, at most IR_INLINE_MAX_INSTS
+// instructions and at most IR_INLINE_MAX_BLOCKS blocks (min, max, add, ...).
+#define IR_INLINE_MAX_INSTS 16
+#define IR_INLINE_MAX_BLOCKS 8
+
+enum IrPass
+{
+    IrPassCopyPropagation,
+    IrPassConstantFolding,
+    IrPassSimplifyCfg,
+    IrPassDeadCode,
+    IrPassInline,
+    IrPassEscape,
+    IrPassRange
+};
+
+#define IR_PASS_COUNT (IrPassRange + 1)
+
+enum IrFoldStatus
+{
+    IrFoldStatusUnknown, // the operation is not computed at compile time
+    IrFoldStatusDone,
+    IrFoldStatusPanic // overflow, division by zero or shift out of range
+};
+
+typedef struct IrPassStats
+{
+    Usize runs[IR_PASS_COUNT];
+    double time[IR_PASS_COUNT]; // seconds
+    Isize insts[IR_PASS_COUNT]; // instructions added (negative: removed)
+    struct IrCheckStats checks; // the checked arithmetic after the passes
+                                // (--stats)
+} IrPassStats;
+
+/**
+ *
+ * @return the name of the pass (--time-passes).
+ */
+Str
+get_name__IrPass(enum IrPass pass);
+
+/**
+ *
+ * @brief Replace the copies by their source and remove the block parameters
+ * which receive a single value.
+ * @return true if the function has changed.
+ */
+bool
+propagate_copies__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Compute the unary or binary instruction with constant operands (y is
+ * NULL for a unary instruction).
+ * @return IrFoldStatusPanic if the operation panics at run time.
+ */
+enum IrFoldStatus
+fold__IrInst(const struct IrFun *fun,
+             const struct IrInst *inst,
+             const struct LiteralSymbol *x,
+             const struct LiteralSymbol *y,
+             struct LiteralSymbol *result);
+
+/**
+ *
+ * @brief Compute the operators whose operands are constants and replace the
+ * branches and the switches on a constant (or a known variant) by a jump. An
+ * arithmetic operation which overflows or divides by zero is kept, it panics
+ * at run time.
+ * @return true if the function has changed.
+ */
+bool
+fold_constants__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Remove the unreachable blocks, merge a block in its single
+ * predecessor and jump over the empty blocks.
+ * @return true if the function has changed.
+ */
+bool
+simplify_cfg__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Remove the instructions and the block parameters whose value is not
+ * used. The calls, the prints and the checked arithmetic are kept.
+ * @return true if the function has changed.
+ */
+bool
+eliminate_dead_code__IrFun(struct IrFun *self);
+
+/**
+ *
+ * @brief Inline the calls of the small functions without call (see
+ * IR_INLINE_MAX_INSTS) and the calls of the closures created in the caller.
+ * @return true if the module has changed.
+ */
+bool
+inline_calls__IrModule(struct IrModule *self);
+
+/**
+ *
+ * @brief Run the passes of the level on the module: -O0 runs nothing, -O1 runs
+ * the copy propagation, the constant folding, the simplification of the CFG
+ * and the dead code elimination until nothing changes, -O2 inlines the small
+ * functions and runs the passes of -O1 again. From -O1, the environment of
+ * the closures which do not escape is allocated on the stack (see closure.h)
+ * and the arithmetic which can't fail is not checked (see range.h).
+ * @param stats The counters of the passes (NULL if not needed).
+ */
+void
+optimize__IrModule(struct IrModule *self,
+                   Usize level,
+                   struct IrPassStats *stats);
+
+#endif // LILY_IR_PASS_H
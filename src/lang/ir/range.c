@@ -0,0 +1,1067 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/ir/range.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The values of a register, empty if max < min. The interval of a register
+// which is not an integer of at most 64 bits is IR_RANGE_UNKNOWN.
+typedef struct IrRange
+{
+    Int128 min;
+    Int128 max;
+} IrRange;
+
+#define IR_RANGE_EMPTY ((struct IrRange){ 1, 0 })
+#define IR_RANGE_UNKNOWN                                                       \
+    ((struct IrRange){ -((Int128)1 << 64), (Int128)1 << 64 })
+
+// The values of an integer data type: bounds holds all its values, fits the
+// results which are not checked (see Isize and Usize in range.h).
+typedef struct IrIntBounds
+{
+    struct IrRange bounds;
+    struct IrRange fits;
+    bool is_signed;
+} IrIntBounds;
+
+// A block is computed at most IR_RANGE_MAX_VISITS times on average, then the
+// checks of the function are kept (the widening ends before).
+#define IR_RANGE_MAX_VISITS 256
+
+// The analysis of a function.
+typedef struct IrRangeFun
+{
+    struct IrFun *fun; // struct IrFun&
+    const struct IrInst **defs; // const struct IrInst& (one per register, NULL
+                                // for a param)
+    Int128 *thresholds; // the constants of the function (c - 1, c, c + 1),
+                        // sorted
+    Usize thresholds_len;
+    struct IrRange **in; // one per block: the intervals of the registers at the
+                         // start of the block (NULL if it's not reached)
+    Usize *joins;        // one per block
+    bool *dirty;         // one per block: the block must be computed again
+    struct IrRange *state; // the intervals in the block being computed
+    struct IrRange *edge;  // the intervals passed by an edge
+    struct IrRange *args;  // the intervals of the arguments of an edge (or of
+                           // the params of its block)
+} IrRangeFun;
+
+// The analysis of the module.
+typedef struct IrRangeModule
+{
+    struct IrModule *module; // struct IrModule&
+    struct IrRange **params; // one per function of the module: the union of
+                             // the arguments of its calls (NULL if the params
+                             // are not known)
+    struct IrRange **args;   // one per function of the module: the arguments
+                             // of the calls of the current round
+} IrRangeModule;
+
+static bool
+get_bounds(struct DataTypeSymbol *data_type, struct IrIntBounds *bounds)
+{
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    Int128 min, max, fits_min, fits_max;
+
+    switch (data_type ? data_type->kind : DataTypeKindCompilerDefined) {
+        case DataTypeKindI8:
+            min = fits_min = INT8_MIN;
+            max = fits_max = INT8_MAX;
+            break;
+        case DataTypeKindI16:
+            min = fits_min = INT16_MIN;
+            max = fits_max = INT16_MAX;
+            break;
+        case DataTypeKindI32:
+            min = fits_min = INT32_MIN;
+            max = fits_max = INT32_MAX;
+            break;
+        case DataTypeKindI64:
+            min = fits_min = INT64_MIN;
+            max = fits_max = INT64_MAX;
+            break;
+        case DataTypeKindIsize:
+            min = INT64_MIN;
+            max = INT64_MAX;
+            fits_min = INT32_MIN;
+            fits_max = INT32_MAX;
+            break;
+        case DataTypeKindU8:
+            min = fits_min = 0;
+            max = fits_max = UINT8_MAX;
+            break;
+        case DataTypeKindU16:
+            min = fits_min = 0;
+            max = fits_max = UINT16_MAX;
+            break;
+        case DataTypeKindU32:
+            min = fits_min = 0;
+            max = fits_max = UINT32_MAX;
+            break;
+        case DataTypeKindU64:
+            min = fits_min = 0;
+            max = fits_max = UINT64_MAX;
+            break;
+        case DataTypeKindUsize:
+            min = fits_min = 0;
+            max = UINT64_MAX;
+            fits_max = UINT32_MAX;
+            break;
+        default:
+            return false;
+    }
+
+    *bounds = (struct IrIntBounds){ .bounds = { min, max },
+                                    .fits = { fits_min, fits_max },
+                                    .is_signed = min < 0 };
+
+    return true;
+}
+
+static inline bool
+is_empty(struct IrRange x)
+{
+    return x.max < x.min;
+}
+
+static inline Int128
+min_int(Int128 x, Int128 y)
+{
+    return x < y ? x : y;
+}
+
+static inline Int128
+max_int(Int128 x, Int128 y)
+{
+    return x > y ? x : y;
+}
+
+static inline struct IrRange
+intersect(struct IrRange x, struct IrRange y)
+{
+    return (struct IrRange){ max_int(x.min, y.min), min_int(x.max, y.max) };
+}
+
+static inline struct IrRange
+join(struct IrRange x, struct IrRange y)
+{
+    if (is_empty(x))
+        return y;
+    else if (is_empty(y))
+        return x;
+
+    return (struct IrRange){ min_int(x.min, y.min), max_int(x.max, y.max) };
+}
+
+static inline bool
+contains(struct IrRange x, struct IrRange y)
+{
+    return is_empty(y) || (x.min <= y.min && y.max <= x.max);
+}
+
+static inline bool
+eq_range(struct IrRange x, struct IrRange y)
+{
+    return (is_empty(x) && is_empty(y)) || (x.min == y.min && x.max == y.max);
+}
+
+// The interval of a register which is not known.
+static struct IrRange
+get_unknown(const struct IrFun *fun, Usize reg)
+{
+    struct IrIntBounds bounds;
+
+    return get_bounds(fun->regs[reg], &bounds) ? bounds.bounds
+                                               : IR_RANGE_UNKNOWN;
+}
+
+// The smallest interval which holds the values of x, y, z and w.
+static struct IrRange
+hull(Int128 x, Int128 y, Int128 z, Int128 w)
+{
+    return (struct IrRange){ min_int(min_int(x, y), min_int(z, w)),
+                             max_int(max_int(x, y), max_int(z, w)) };
+}
+
+// The product of x and y, saturated to the interval of the Int128 (the product
+// of two Uint64 does not fit).
+static Int128
+multiply(Int128 x, Int128 y)
+{
+    Int128 result;
+
+    if (__builtin_mul_overflow(x, y, &result))
+        return (x < 0) != (y < 0) ? -((Int128)1 << 126) : (Int128)1 << 126;
+
+    return result;
+}
+
+// The division of C (truncated), y does not contain 0.
+static struct IrRange
+divide(struct IrRange x, struct IrRange y)
+{
+    return hull(x.min / y.min, x.min / y.max, x.max / y.min, x.max / y.max);
+}
+
+// The smallest 2^n - 1 greater than or equal to x (x >= 0).
+static Int128
+get_mask(Int128 x)
+{
+    Int128 mask = 0;
+
+    while (mask < x)
+        mask = mask * 2 + 1;
+
+    return mask;
+}
+
+int
+get_check__IrInst(const struct IrFun *fun, const struct IrInst *inst)
+{
+    if (inst->kind != IrInstKindUnary && inst->kind != IrInstKindBinary)
+        return -1;
+
+    struct DataTypeSymbol *data_type = fun->regs[inst->args[0]];
+
+    while (data_type && data_type->kind == DataTypeKindMut)
+        data_type = data_type->value.mut;
+
+    // The integers of the generated C (see is_int in generate_c.c).
+    switch (data_type ? data_type->kind : DataTypeKindCompilerDefined) {
+        case DataTypeKindI8:
+        case DataTypeKindI16:
+        case DataTypeKindI32:
+        case DataTypeKindI64:
+        case DataTypeKindI128:
+        case DataTypeKindU8:
+        case DataTypeKindU16:
+        case DataTypeKindU32:
+        case DataTypeKindU64:
+        case DataTypeKindU128:
+        case DataTypeKindIsize:
+        case DataTypeKindUsize:
+            break;
+        default:
+            return -1;
+    }
+
+    switch (inst->value.op) {
+        case IrOpAdd:
+        case IrOpSub:
+        case IrOpMul:
+            return inst->kind == IrInstKindBinary ? IrCheckOverflow : -1;
+        case IrOpNeg:
+            return IrCheckOverflow;
+        case IrOpDiv:
+        case IrOpMod:
+            return IrCheckDivision;
+        default:
+            return -1;
+    }
+}
+
+// The interval of the operand in the data type of the operation.
+static struct IrRange
+get_operand(const struct IrRangeFun *self,
+            const struct IrIntBounds *bounds,
+            Usize reg)
+{
+    return intersect(self->state[reg], bounds->bounds);
+}
+
+static struct IrRange
+compute_binary(const struct IrRangeFun *self,
+               const struct IrInst *inst,
+               const struct IrIntBounds *bounds,
+               bool *is_safe)
+{
+    struct IrRange x = get_operand(self, bounds, inst->args[0]);
+    struct IrRange y = get_operand(self, bounds, inst->args[1]);
+
+    if (is_empty(x) || is_empty(y))
+        return IR_RANGE_EMPTY;
+
+    switch (inst->value.op) {
+        case IrOpAdd:
+            return (struct IrRange){ x.min + y.min, x.max + y.max };
+        case IrOpSub:
+            return (struct IrRange){ x.min - y.max, x.max - y.min };
+        case IrOpMul:
+            return hull(multiply(x.min, y.min),
+                        multiply(x.min, y.max),
+                        multiply(x.max, y.min),
+                        multiply(x.max, y.max));
+        case IrOpDiv:
+        case IrOpMod: {
+            // The negative and the positive divisors.
+            struct IrRange neg = { y.min, min_int(y.max, -1) };
+            struct IrRange pos = { max_int(y.min, 1), y.max };
+
+            *is_safe = !(y.min <= 0 && y.max >= 0) &&
+                       !(bounds->is_signed && x.min <= bounds->fits.min &&
+                         y.min <= -1 && y.max >= -1);
+
+            if (inst->value.op == IrOpDiv)
+                return join(is_empty(neg) ? IR_RANGE_EMPTY : divide(x, neg),
+                            is_empty(pos) ? IR_RANGE_EMPTY : divide(x, pos));
+
+            // The remainder has the sign of x and is smaller than y.
+            Int128 m = max_int(-y.min, y.max) - 1;
+
+            if (m < 0)
+                return IR_RANGE_EMPTY;
+
+            return (struct IrRange){ x.min >= 0 ? 0 : max_int(x.min, -m),
+                                     x.max <= 0 ? 0 : min_int(x.max, m) };
+        }
+        case IrOpBitAnd:
+            if (x.min >= 0 && y.min >= 0)
+                return (struct IrRange){ 0, min_int(x.max, y.max) };
+            else if (x.min >= 0)
+                return (struct IrRange){ 0, x.max };
+            else if (y.min >= 0)
+                return (struct IrRange){ 0, y.max };
+
+            return bounds->bounds;
+        case IrOpBitOr:
+        case IrOpXor:
+            if (x.min >= 0 && y.min >= 0)
+                return (struct IrRange){ 0, get_mask(max_int(x.max, y.max)) };
+
+            return bounds->bounds;
+        case IrOpShr:
+            if (x.min >= 0 && y.min >= 0 && y.max < 32)
+                return (struct IrRange){ x.min >> (int)y.max,
+                                         x.max >> (int)y.min };
+
+            return bounds->bounds;
+        default:
+            return bounds->bounds;
+    }
+}
+
+// The interval of the value of the instruction. is_safe is true if the check
+// of the instruction can be removed.
+static struct IrRange
+compute_inst(const struct IrRangeFun *self,
+             const struct IrInst *inst,
+             bool *is_safe)
+{
+    struct IrIntBounds bounds;
+    struct IrRange result;
+    Int64 value;
+
+    *is_safe = false;
+
+    if (inst->dst == IR_NONE)
+        return IR_RANGE_UNKNOWN;
+    else if (!get_bounds(self->fun->regs[inst->dst], &bounds))
+        return IR_RANGE_UNKNOWN;
+
+    switch (inst->kind) {
+        case IrInstKindConst:
+            if (!get_case_value__LiteralSymbol(&inst->value.literal, &value))
+                return bounds.bounds;
+
+            // A Uint64 greater than INT64_MAX.
+            if (!bounds.is_signed && value < 0)
+                return (struct IrRange){ (Int128)(UInt64)value,
+                                         (Int128)(UInt64)value };
+
+            return intersect((struct IrRange){ value, value }, bounds.bounds);
+        case IrInstKindCopy:
+            result = intersect(self->state[inst->args[0]], bounds.bounds);
+
+            return is_empty(result) ? bounds.bounds : result;
+        case IrInstKindUnary:
+            if (inst->value.op != IrOpNeg)
+                return bounds.bounds;
+
+            result = get_operand(self, &bounds, inst->args[0]);
+
+            if (is_empty(result))
+                return bounds.bounds;
+
+            result = (struct IrRange){ -result.max, -result.min };
+            *is_safe = contains(bounds.fits, result);
+            break;
+        case IrInstKindBinary: {
+            bool is_divide_safe = false;
+
+            result = compute_binary(self, inst, &bounds, &is_divide_safe);
+
+            if (is_empty(result))
+                return bounds.bounds;
+
+            *is_safe = inst->value.op == IrOpDiv || inst->value.op == IrOpMod
+                         ? is_divide_safe
+                         : contains(bounds.fits, result);
+            break;
+        }
+        default:
+            return bounds.bounds;
+    }
+
+    // If the operation overflows, it panics: the value is in the bounds.
+    result = intersect(result, bounds.bounds);
+
+    return is_empty(result) ? bounds.bounds : result;
+}
+
+static enum IrOp
+negate_compare(enum IrOp op)
+{
+    switch (op) {
+        case IrOpLt:
+            return IrOpGe;
+        case IrOpGt:
+            return IrOpLe;
+        case IrOpLe:
+            return IrOpGt;
+        case IrOpGe:
+            return IrOpLt;
+        case IrOpEq:
+            return IrOpNe;
+        case IrOpNe:
+            return IrOpEq;
+        default:
+            UNREACHABLE("expected comparison operator");
+    }
+}
+
+// Remove the value of y from x if it's a bound of x.
+static struct IrRange
+exclude(struct IrRange x, struct IrRange y)
+{
+    if (is_empty(x) || y.min != y.max)
+        return x;
+    else if (x.min == y.min)
+        x.min++;
+    else if (x.max == y.min)
+        x.max--;
+
+    return x;
+}
+
+// Narrow the operands of the condition in state, knowing the condition is
+// value.
+// @return false if the condition can't be value (the edge is never taken).
+static bool
+refine(const struct IrRangeFun *self,
+       struct IrRange *state,
+       Usize cond,
+       bool value)
+{
+    const struct IrInst *def = self->defs[cond];
+
+    if (def && def->kind == IrInstKindUnary && def->value.op == IrOpNot)
+        return refine(self, state, def->args[0], !value);
+    else if (!def || def->kind != IrInstKindBinary ||
+             def->value.op < IrOpLt || def->value.op > IrOpNe)
+        return true;
+
+    struct IrIntBounds bounds;
+    Usize left = def->args[0];
+    Usize right = def->args[1];
+
+    if (!get_bounds(self->fun->regs[left], &bounds))
+        return true;
+
+    struct IrRange x = intersect(state[left], bounds.bounds);
+    struct IrRange y = intersect(state[right], bounds.bounds);
+    struct IrRange new_x = x;
+    struct IrRange new_y = y;
+
+    switch (value ? def->value.op : negate_compare(def->value.op)) {
+        case IrOpLt:
+            new_x.max = min_int(x.max, y.max - 1);
+            new_y.min = max_int(y.min, x.min + 1);
+            break;
+        case IrOpLe:
+            new_x.max = min_int(x.max, y.max);
+            new_y.min = max_int(y.min, x.min);
+            break;
+        case IrOpGt:
+            new_x.min = max_int(x.min, y.min + 1);
+            new_y.max = min_int(y.max, x.max - 1);
+            break;
+        case IrOpGe:
+            new_x.min = max_int(x.min, y.min);
+            new_y.max = min_int(y.max, x.max);
+            break;
+        case IrOpEq:
+            new_x = new_y = intersect(x, y);
+            break;
+        case IrOpNe:
+            new_x = exclude(x, y);
+            new_y = exclude(y, x);
+            break;
+        default:
+            UNREACHABLE("expected comparison operator");
+    }
+
+    state[left] = new_x;
+    state[right] = new_y;
+
+    return !is_empty(new_x) && !is_empty(new_y);
+}
+
+// Narrow the value of the switch in state for the edge.
+// @return false if the edge is never taken.
+static bool
+refine_switch(const struct IrRangeFun *self,
+              struct IrRange *state,
+              const struct IrTerm *term,
+              Usize edge)
+{
+    struct IrIntBounds bounds;
+
+    if (!get_bounds(self->fun->regs[term->value], &bounds))
+        return true;
+
+    struct IrRange *x = &state[term->value];
+
+    *x = intersect(*x, bounds.bounds);
+
+    for (Usize i = 0; i < term->cases_len; i++) {
+        Int64 value = term->cases[i].value;
+        Int128 case_value =
+          !bounds.is_signed && value < 0 ? (Int128)(UInt64)value : value;
+        struct IrRange y = { case_value, case_value };
+
+        if (edge == i + 1) {
+            *x = intersect(*x, y);
+            break;
+        } else if (edge == 0) {
+            *x = exclude(*x, y);
+        }
+    }
+
+    return !is_empty(*x);
+}
+
+// The greatest threshold lower than or equal to x (the minimum if there is
+// none), or the least threshold greater than or equal to x.
+static Int128
+get_threshold(const struct IrRangeFun *self, Int128 x, Int128 none, bool lower)
+{
+    Int128 result = none;
+
+    for (Usize i = 0; i < self->thresholds_len; i++) {
+        Int128 t = self->thresholds[i];
+
+        if (lower && t <= x)
+            result = t;
+        else if (!lower && t >= x)
+            return t;
+    }
+
+    return result;
+}
+
+static struct IrRange
+widen(const struct IrRangeFun *self,
+      Usize reg,
+      struct IrRange old,
+      struct IrRange new)
+{
+    struct IrRange unknown = get_unknown(self->fun, reg);
+
+    if (is_empty(old))
+        return new;
+
+    if (new.min < old.min)
+        new.min = get_threshold(self, new.min, unknown.min, true);
+
+    if (new.max > old.max)
+        new.max = get_threshold(self, new.max, unknown.max, false);
+
+    return new;
+}
+
+// Join the intervals of the edge in the intervals at the start of its block.
+static void
+join_edge(struct IrRangeFun *self, const struct IrEdge *edge)
+{
+    Usize regs_len = self->fun->regs_len;
+    struct IrBlock *block = &self->fun->blocks[edge->block];
+
+    // The arguments are read before the params are assigned.
+    for (Usize i = 0; i < edge->args_len; i++)
+        self->args[i] = self->edge[edge->args[i]];
+
+    for (Usize i = 0; i < edge->args_len && i < block->params_len; i++)
+        self->edge[block->params[i]] = self->args[i];
+
+    struct IrRange *in = self->in[edge->block];
+
+    if (!in) {
+        self->in[edge->block] = malloc(sizeof(struct IrRange) * regs_len);
+        memcpy(self->in[edge->block],
+               self->edge,
+               sizeof(struct IrRange) * regs_len);
+        self->dirty[edge->block] = true;
+        return;
+    }
+
+    // The params before the join.
+    for (Usize i = 0; i < block->params_len; i++)
+        self->args[i] = in[block->params[i]];
+
+    for (Usize i = 0; i < regs_len; i++) {
+        struct IrRange new = join(in[i], self->edge[i]);
+
+        if (!eq_range(new, in[i])) {
+            in[i] = new;
+            self->dirty[edge->block] = true;
+        }
+    }
+
+    // The other registers come from the blocks which dominate the block, they
+    // are widened by their own blocks (a loop counter keeps the bounds of its
+    // condition in the inner loops).
+    if (++self->joins[edge->block] > IR_RANGE_WIDEN_AFTER)
+        for (Usize i = 0; i < block->params_len; i++) {
+            Usize param = block->params[i];
+
+            in[param] = widen(self, param, self->args[i], in[param]);
+        }
+}
+
+static void
+add_call_args(struct IrRangeModule *module,
+              const struct IrRange *state,
+              const struct IrInst *inst)
+{
+    struct IrRange *args = inst->value.fun < module->module->funs_len
+                             ? module->args[inst->value.fun]
+                             : NULL;
+
+    if (!args)
+        return;
+
+    const struct IrFun *callee = module->module->funs[inst->value.fun];
+
+    for (Usize i = 0; i < inst->args_len && i < callee->blocks[0].params_len;
+         i++) {
+        struct IrRange unknown =
+          get_unknown(callee, callee->blocks[0].params[i]);
+
+        args[i] = join(args[i],
+                       state ? intersect(state[inst->args[i]], unknown)
+                             : unknown);
+    }
+}
+
+// Compute the intervals at the end of the block and pass them to its edges.
+// With is_marked, the checks which can't fail are removed instead.
+static void
+compute_block(struct IrRangeFun *self,
+              struct IrRangeModule *module,
+              Usize block,
+              bool is_marked)
+{
+    struct IrBlock *ir_block = &self->fun->blocks[block];
+    Usize size = sizeof(struct IrRange) * self->fun->regs_len;
+
+    memcpy(self->state, self->in[block], size);
+
+    for (Usize i = 0; i < ir_block->insts_len; i++) {
+        struct IrInst *inst = &ir_block->insts[i];
+        bool is_safe;
+        struct IrRange result = compute_inst(self, inst, &is_safe);
+
+        if (is_marked && get_check__IrInst(self->fun, inst) != -1)
+            inst->is_unchecked = is_safe;
+
+        if (inst->kind == IrInstKindCall)
+            add_call_args(module, self->state, inst);
+
+        if (inst->dst != IR_NONE)
+            self->state[inst->dst] = result;
+    }
+
+    if (is_marked)
+        return;
+
+    struct IrTerm *term = &ir_block->term;
+
+    for (Usize i = 0; i < get_edges_len__IrTerm(term); i++) {
+        memcpy(self->edge, self->state, size);
+
+        if (term->kind == IrTermKindBranch &&
+            !refine(self, self->edge, term->value, i == 0))
+            continue;
+        else if (term->kind == IrTermKindSwitch &&
+                 !refine_switch(self, self->edge, term, i))
+            continue;
+
+        join_edge(self, get_edge__IrTerm(term, i));
+    }
+}
+
+static int
+compare_int(const void *x, const void *y)
+{
+    Int128 a = *(const Int128 *)x;
+    Int128 b = *(const Int128 *)y;
+
+    return (a > b) - (a < b);
+}
+
+static void
+collect_thresholds(struct IrRangeFun *self)
+{
+    Usize len = 0;
+
+    for (Usize i = 0; i < self->fun->blocks_len; i++)
+        len += self->fun->blocks[i].insts_len;
+
+    self->thresholds = malloc(sizeof(Int128) * (len * 3 + 1));
+
+    for (Usize i = 0; i < self->fun->blocks_len; i++)
+        for (Usize j = 0; j < self->fun->blocks[i].insts_len; j++) {
+            const struct IrInst *inst = &self->fun->blocks[i].insts[j];
+            bool is_safe;
+
+            if (inst->kind != IrInstKindConst)
+                continue;
+
+            struct IrRange value = compute_inst(self, inst, &is_safe);
+
+            if (value.min != value.max)
+                continue;
+
+            for (int k = -1; k <= 1; k++)
+                self->thresholds[self->thresholds_len++] = value.min + k;
+        }
+
+    qsort(self->thresholds,
+          self->thresholds_len,
+          sizeof(Int128),
+          &compare_int);
+}
+
+// Compute the intervals of the function: params holds the intervals of its
+// params (NULL if they are not known). With is_marked, the checks which can't
+// fail are removed.
+// @return false if the function is too big (its calls pass unknown values).
+static bool
+compute_fun(struct IrRangeModule *module,
+            struct IrFun *fun,
+            const struct IrRange *params,
+            bool is_marked)
+{
+    Usize regs_len = fun->regs_len;
+
+    if (!fun->blocks_len ||
+        fun->blocks_len * (regs_len + 1) > IR_RANGE_MAX_CELLS)
+        return false;
+
+    struct IrRangeFun self = {
+        .fun = fun,
+        .defs = calloc(regs_len + 1, sizeof(struct IrInst *)),
+        .thresholds = NULL,
+        .thresholds_len = 0,
+        .in = calloc(fun->blocks_len, sizeof(struct IrRange *)),
+        .joins = calloc(fun->blocks_len, sizeof(Usize)),
+        .dirty = calloc(fun->blocks_len, sizeof(bool)),
+        .state = malloc(sizeof(struct IrRange) * (regs_len + 1)),
+        .edge = malloc(sizeof(struct IrRange) * (regs_len + 1)),
+        .args = malloc(sizeof(struct IrRange) * (regs_len + 1)),
+    };
+
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            if (fun->blocks[i].insts[j].dst != IR_NONE)
+                self.defs[fun->blocks[i].insts[j].dst] =
+                  &fun->blocks[i].insts[j];
+
+    collect_thresholds(&self);
+
+    // The registers are not defined (empty) before their instruction.
+    self.in[0] = malloc(sizeof(struct IrRange) * (regs_len + 1));
+    self.dirty[0] = true;
+
+    for (Usize i = 0; i < regs_len; i++)
+        self.in[0][i] = IR_RANGE_EMPTY;
+
+    for (Usize i = 0; i < fun->blocks[0].params_len; i++) {
+        Usize param = fun->blocks[0].params[i];
+
+        self.in[0][param] =
+          params ? intersect(params[i], get_unknown(fun, param))
+                 : get_unknown(fun, param);
+    }
+
+    Usize visits = 0;
+    bool is_dirty = true;
+
+    while (is_dirty && visits <= fun->blocks_len * IR_RANGE_MAX_VISITS) {
+        is_dirty = false;
+
+        for (Usize i = 0; i < fun->blocks_len; i++)
+            if (self.dirty[i]) {
+                self.dirty[i] = false;
+                is_dirty = true;
+                visits++;
+                compute_block(&self, module, i, false);
+            }
+    }
+
+    // The intervals are stable: the checks are removed with the final
+    // intervals only (the blocks which are not reached keep their checks).
+    if (is_marked && !is_dirty)
+        for (Usize i = 0; i < fun->blocks_len; i++)
+            if (self.in[i])
+                compute_block(&self, module, i, true);
+
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        free(self.in[i]);
+
+    free(self.defs);
+    free(self.thresholds);
+    free(self.in);
+    free(self.joins);
+    free(self.dirty);
+    free(self.state);
+    free(self.edge);
+    free(self.args);
+
+    return !is_dirty;
+}
+
+// The functions of the module, then the constants and the lambdas.
+static struct IrFun *
+get_body(const struct IrModule *self, Usize i)
+{
+    if (i < self->funs_len)
+        return self->funs[i];
+    else if (i < self->funs_len + self->consts_len)
+        return self->consts[i - self->funs_len];
+
+    return self->lambdas[i - self->funs_len - self->consts_len].fun;
+}
+
+static void
+compute_bodies(struct IrRangeModule *self, bool is_marked)
+{
+    struct IrModule *module = self->module;
+    Usize len = module->funs_len + module->consts_len + module->lambdas_len;
+
+    for (Usize i = 0; i < len; i++) {
+        struct IrFun *fun = get_body(module, i);
+
+        if (!fun || compute_fun(self,
+                                fun,
+                                i < module->funs_len ? self->params[i] : NULL,
+                                is_marked))
+            continue;
+
+        // The arguments of the calls of a function too big are not known, its
+        // checks are kept.
+        for (Usize j = 0; j < fun->blocks_len; j++)
+            for (Usize k = 0; k < fun->blocks[j].insts_len; k++) {
+                struct IrInst *inst = &fun->blocks[j].insts[k];
+
+                if (inst->kind == IrInstKindCall)
+                    add_call_args(self, NULL, inst);
+                else if (is_marked)
+                    inst->is_unchecked = false;
+            }
+    }
+}
+
+// The params of the functions which are called in the module (except main)
+// start empty, the other params are not known.
+static void
+init_params(struct IrRangeModule *self)
+{
+    struct IrModule *module = self->module;
+    Usize len = module->funs_len + module->consts_len + module->lambdas_len;
+
+    for (Usize i = 0; i < len; i++) {
+        const struct IrFun *fun = get_body(module, i);
+
+        if (!fun)
+            continue;
+
+        for (Usize j = 0; j < fun->blocks_len; j++)
+            for (Usize k = 0; k < fun->blocks[j].insts_len; k++) {
+                const struct IrInst *inst = &fun->blocks[j].insts[k];
+                Usize callee = inst->value.fun;
+
+                if (inst->kind != IrInstKindCall ||
+                    callee >= module->funs_len || !module->funs[callee] ||
+                    !module->funs[callee]->blocks_len || self->params[callee])
+                    continue;
+
+                Usize params_len = module->funs[callee]->blocks[0].params_len;
+
+                self->params[callee] =
+                  malloc(sizeof(struct IrRange) * (params_len + 1));
+                self->args[callee] =
+                  malloc(sizeof(struct IrRange) * (params_len + 1));
+
+                for (Usize l = 0; l < params_len; l++)
+                    self->params[callee][l] = IR_RANGE_EMPTY;
+            }
+    }
+
+    // main is also called by the main function of C.
+    for (Usize i = 0; i < module->file_funs_len && i < module->funs_len; i++) {
+        if (!self->params[i])
+            continue;
+
+        Str name = to_Str__String(*get_fun_name__IrModule(module, i));
+
+        if (!strcmp(name, "main")) {
+            free(self->params[i]);
+            free(self->args[i]);
+            self->params[i] = self->args[i] = NULL;
+        }
+
+        free(name);
+    }
+}
+
+// Join the arguments of the round in the params.
+// @return true if a param has changed.
+static bool
+update_params(struct IrRangeModule *self, bool is_widened)
+{
+    struct IrModule *module = self->module;
+    bool changed = false;
+
+    for (Usize i = 0; i < module->funs_len; i++) {
+        if (!self->params[i])
+            continue;
+
+        const struct IrFun *fun = module->funs[i];
+
+        for (Usize j = 0; j < fun->blocks[0].params_len; j++) {
+            struct IrRange *param = &self->params[i][j];
+
+            if (contains(*param, self->args[i][j]))
+                continue;
+
+            *param = is_widened ? get_unknown(fun, fun->blocks[0].params[j])
+                                : join(*param, self->args[i][j]);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+static void
+reset_args(struct IrRangeModule *self)
+{
+    for (Usize i = 0; i < self->module->funs_len; i++)
+        if (self->args[i])
+            for (Usize j = 0; j < self->module->funs[i]->blocks[0].params_len;
+                 j++)
+                self->args[i][j] = IR_RANGE_EMPTY;
+}
+
+Usize
+eliminate_checks__IrModule(struct IrModule *self)
+{
+    struct IrRangeModule module = {
+        .module = self,
+        .params = calloc(self->funs_len + 1, sizeof(struct IrRange *)),
+        .args = calloc(self->funs_len + 1, sizeof(struct IrRange *)),
+    };
+    bool is_stable = false;
+
+    init_params(&module);
+
+    for (Usize round = 0; round < IR_RANGE_MAX_ROUNDS && !is_stable; round++) {
+        reset_args(&module);
+        compute_bodies(&module, false);
+        is_stable = !update_params(&module, round >= IR_RANGE_WIDEN_AFTER);
+    }
+
+    // The params which still change are not known.
+    if (!is_stable)
+        for (Usize i = 0; i < self->funs_len; i++) {
+            free(module.params[i]);
+            module.params[i] = NULL;
+        }
+
+    reset_args(&module);
+    compute_bodies(&module, true);
+
+    for (Usize i = 0; i < self->funs_len; i++) {
+        free(module.params[i]);
+        free(module.args[i]);
+    }
+
+    free(module.params);
+    free(module.args);
+
+    struct IrCheckStats stats = { 0 };
+
+    count_checks__IrModule(self, &stats);
+
+    return stats.eliminated[IrCheckOverflow] +
+           stats.eliminated[IrCheckDivision];
+}
+
+static void
+count_fun_checks(const struct IrFun *fun, struct IrCheckStats *stats)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++) {
+            const struct IrInst *inst = &fun->blocks[i].insts[j];
+            int check = get_check__IrInst(fun, inst);
+
+            if (check == -1)
+                continue;
+
+            stats->checks[check]++;
+
+            if (inst->is_unchecked)
+                stats->eliminated[check]++;
+        }
+}
+
+void
+count_checks__IrModule(const struct IrModule *self, struct IrCheckStats *stats)
+{
+    for (Usize i = 0; i < self->funs_len + self->consts_len + self->lambdas_len;
+         i++) {
+        const struct IrFun *fun = get_body(self, i);
+
+        if (fun)
+            count_fun_checks(fun, stats);
+    }
+}
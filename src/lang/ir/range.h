@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IR_RANGE_H
+#define LILY_IR_RANGE_H
+
+#include <lang/ir/ir.h>
+
+// The range analysis computes an interval of values for each integer register
+// of a function: the constants, the block params joined over their edges (a
+// loop counter is widened to the constants of the function, then to the bounds
+// of its data type) and the arithmetic on intervals. A branch on a comparison
+// narrows its operands on each edge (i < n gives i <= n - 1 in the body of the
+// loop). The params of a function are the union of the arguments of its calls
+// in the module (the params of main and of the functions without call are not
+// known). An addition, a subtraction, a multiplication or a negation whose
+// result is in the range of its data type does not check the overflow, a
+// division or a modulo whose divisor can't be 0 (or -1 with the minimum as
+// dividend) does not check the division. The data types of Isize and Usize
+// are at least 32 bits wide: a result is in their range if it fits in 32
+// bits.
+
+// Beyond IR_RANGE_MAX_CELLS intervals (blocks * registers), the checks of the
+// function are kept.
+#define IR_RANGE_MAX_CELLS (1 << 20)
+
+// A block param is widened after IR_RANGE_WIDEN_AFTER joins, the params of the
+// functions after IR_RANGE_WIDEN_AFTER rounds.
+#define IR_RANGE_WIDEN_AFTER 2
+
+// The params of the functions are computed in at most IR_RANGE_MAX_ROUNDS
+// rounds, then the params which still change are not known.
+#define IR_RANGE_MAX_ROUNDS 8
+
+enum IrCheck
+{
+    IrCheckOverflow, // add, sub, mul and neg on integers
+    IrCheckDivision  // div and mod on integers
+};
+
+#define IR_CHECK_COUNT (IrCheckDivision + 1)
+
+typedef struct IrCheckStats
+{
+    Usize checks[IR_CHECK_COUNT];     // checked operations
+    Usize eliminated[IR_CHECK_COUNT]; // unchecked by the range analysis
+} IrCheckStats;
+
+/**
+ *
+ * @return the check of the instruction (-1 if the instruction is not checked
+ * arithmetic).
+ */
+int
+get_check__IrInst(const struct IrFun *fun, const struct IrInst *inst);
+
+/**
+ *
+ * @brief Remove the checks of the arithmetic which can't overflow or divide
+ * by zero (see above).
+ * @return the number of removed checks.
+ */
+Usize
+eliminate_checks__IrModule(struct IrModule *self);
+
+/**
+ *
+ * @brief Add the checked operations of the module to the counters (--stats).
+ */
+void
+count_checks__IrModule(const struct IrModule *self, struct IrCheckStats *stats);
+
+#endif // LILY_IR_RANGE_H
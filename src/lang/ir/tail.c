@@ -0,0 +1,296 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <lang/ir/tail.h>
+#include <stdlib.h>
+
+static bool
+eq_return_type(const struct IrFun *x, const struct IrFun *y)
+{
+    if (!x->return_type || !y->return_type)
+        return x->return_type == y->return_type;
+
+    return eq__DataTypeSymbol(x->return_type, y->return_type);
+}
+
+bool
+is_tail_call__IrFun(const struct IrFun *self, Usize block)
+{
+    const struct IrBlock *ir_block = &self->blocks[block];
+
+    if (!ir_block->insts_len ||
+        ir_block->insts[ir_block->insts_len - 1].kind != IrInstKindCall)
+        return false;
+
+    Usize value = ir_block->insts[ir_block->insts_len - 1].dst;
+
+    // The jumps to the blocks without instruction (the end of an if, ...)
+    // are followed, the value can be passed to their params.
+    for (Usize i = 0; i < self->blocks_len; i++) {
+        const struct IrTerm *term = &self->blocks[block].term;
+
+        if (term->kind == IrTermKindReturn)
+            return term->value == value;
+        else if (term->kind != IrTermKindJump ||
+                 self->blocks[term->edges[0].block].insts_len)
+            return false;
+
+        block = term->edges[0].block;
+
+        for (Usize j = 0; j < term->edges[0].args_len; j++)
+            if (value != IR_NONE && term->edges[0].args[j] == value) {
+                value = self->blocks[block].params[j];
+                break;
+            }
+    }
+
+    return false;
+}
+
+// The callee of the tail call of the block, IR_NONE if the block does not end
+// with a tail call to a lowered function with the same return data type.
+static Usize
+get_tail_callee(const struct IrModule *module,
+                const struct IrFun *fun,
+                Usize block)
+{
+    if (!is_tail_call__IrFun(fun, block))
+        return IR_NONE;
+
+    const struct IrBlock *ir_block = &fun->blocks[block];
+    Usize callee = ir_block->insts[ir_block->insts_len - 1].value.fun;
+
+    if (callee >= module->funs_len || !module->funs[callee] ||
+        !eq_return_type(fun, module->funs[callee]))
+        return IR_NONE;
+
+    return callee;
+}
+
+// reach[i * funs_len + j] is true if the function i reaches the function j
+// through tail calls.
+static bool *
+compute_reach(const struct IrModule *self)
+{
+    Usize len = self->funs_len;
+    bool *reach = calloc(len * len + 1, sizeof(bool));
+    Usize *stack = malloc((len + 1) * sizeof(Usize));
+
+    for (Usize i = 0; i < len; i++) {
+        bool *from = &reach[i * len];
+        Usize stack_len = 0;
+
+        stack[stack_len++] = i;
+
+        while (stack_len) {
+            const struct IrFun *fun = self->funs[stack[--stack_len]];
+
+            if (!fun)
+                continue;
+
+            for (Usize j = 0; j < fun->blocks_len; j++) {
+                Usize callee = get_tail_callee(self, fun, j);
+
+                if (callee != IR_NONE && !from[callee]) {
+                    from[callee] = true;
+                    stack[stack_len++] = callee;
+                }
+            }
+        }
+    }
+
+    free(stack);
+
+    return reach;
+}
+
+// Copy the blocks of the function at the end of the blocks of self (with new
+// registers).
+// @return the index of the copy of the entry.
+static Usize
+copy_body(struct IrFun *self, const struct IrFun *from)
+{
+    Usize blocks_start = self->blocks_len;
+    Usize *regs = malloc((from->regs_len + 1) * sizeof(Usize));
+
+    for (Usize i = 0; i < from->regs_len; i++)
+        regs[i] = add_reg__IrFun(self, from->regs[i]);
+
+    for (Usize i = 0; i < from->blocks_len; i++)
+        add_block__IrFun(self);
+
+    for (Usize i = 0; i < from->blocks_len; i++) {
+        const struct IrBlock *from_block = &from->blocks[i];
+        struct IrBlock *to = &self->blocks[blocks_start + i];
+        struct IrTerm *from_term = (struct IrTerm *)&from_block->term;
+
+        for (Usize j = 0; j < from_block->params_len; j++)
+            push_param__IrBlock(to, regs[from_block->params[j]]);
+
+        for (Usize j = 0; j < from_block->insts_len; j++) {
+            struct IrInst copy = from_block->insts[j];
+
+            copy.dst = copy.dst == IR_NONE ? IR_NONE : regs[copy.dst];
+            copy.args =
+              copy.args_len ? malloc(copy.args_len * sizeof(Usize)) : NULL;
+
+            for (Usize k = 0; k < copy.args_len; k++)
+                copy.args[k] = regs[from_block->insts[j].args[k]];
+
+            push_inst__IrBlock(to, copy);
+        }
+
+        to->term.kind = from_term->kind;
+        to->term.value =
+          from_term->value == IR_NONE ? IR_NONE : regs[from_term->value];
+
+        for (Usize j = 0; j < from_term->cases_len; j++)
+            push_case__IrTerm(&to->term, from_term->cases[j].value);
+
+        for (Usize j = 0; j < get_edges_len__IrTerm(from_term); j++) {
+            const struct IrEdge *from_edge = get_edge__IrTerm(from_term, j);
+            struct IrEdge *edge = get_edge__IrTerm(&to->term, j);
+
+            edge->block = blocks_start + from_edge->block;
+
+            for (Usize k = 0; k < from_edge->args_len; k++)
+                push_arg__IrEdge(edge, regs[from_edge->args[k]]);
+        }
+    }
+
+    free(regs);
+
+    return blocks_start;
+}
+
+// The first function of the group gets the bodies of the functions of the
+// group: its entry jumps to the copy of its own body, the tail calls to a
+// function of the group jump to the copy of the body of the callee.
+static struct IrFun *
+merge_group(const struct IrModule *self,
+            const Usize *group,
+            Usize group_len,
+            Usize *count)
+{
+    const struct IrFun *fun = self->funs[group[0]];
+    struct IrFun *merged = calloc(1, sizeof(struct IrFun));
+    Usize *headers = malloc(group_len * sizeof(Usize));
+
+    merged->name = fun->name;
+    merged->return_type = fun->return_type;
+    add_block__IrFun(merged);
+
+    for (Usize i = 0; i < group_len; i++)
+        headers[i] = copy_body(merged, self->funs[group[i]]);
+
+    struct IrBlock *entry = &merged->blocks[0];
+
+    entry->term = (struct IrTerm){ .kind = IrTermKindJump,
+                                   .value = IR_NONE,
+                                   .edges[0] = { .block = headers[0] } };
+
+    for (Usize i = 0; i < fun->blocks[0].params_len; i++) {
+        Usize param =
+          add_reg__IrFun(merged, fun->regs[fun->blocks[0].params[i]]);
+
+        push_param__IrBlock(entry, param);
+        push_arg__IrEdge(&entry->term.edges[0], param);
+    }
+
+    for (Usize i = 1; i < merged->blocks_len; i++) {
+        Usize callee = get_tail_callee(self, merged, i);
+        Usize member = 0;
+
+        while (member < group_len && group[member] != callee)
+            member++;
+
+        if (member == group_len)
+            continue;
+
+        struct IrBlock *block = &merged->blocks[i];
+        struct IrInst call = block->insts[--block->insts_len];
+        Usize header = headers[member];
+
+        FREE(IrTerm, &block->term);
+        block->term = (struct IrTerm){ .kind = IrTermKindJump,
+                                       .value = IR_NONE,
+                                       .edges[0] = { .block = header } };
+
+        for (Usize j = 0; j < call.args_len; j++)
+            push_arg__IrEdge(&block->term.edges[0], call.args[j]);
+
+        FREE(IrInst, &call);
+        ++*count;
+    }
+
+    free(headers);
+
+    return merged;
+}
+
+Usize
+eliminate_tail_calls__IrModule(struct IrModule *self)
+{
+    Usize len = self->funs_len;
+    bool *reach = compute_reach(self);
+    struct IrFun **merged = calloc(len + 1, sizeof(struct IrFun *));
+    Usize *group = malloc((len + 1) * sizeof(Usize));
+    Usize count = 0;
+
+    // The groups are computed on the bodies before the elimination.
+    for (Usize i = 0; i < len; i++) {
+        if (!self->funs[i] || !reach[i * len + i])
+            continue;
+
+        Usize group_len = 0;
+        Usize insts = 0;
+
+        group[group_len++] = i;
+
+        for (Usize j = 0; j < len; j++)
+            if (j != i && reach[i * len + j] && reach[j * len + i]) {
+                insts += count_insts__IrFun(self->funs[j]);
+                group[group_len++] = j;
+            }
+
+        if (insts > IR_TAIL_MAX_INSTS)
+            group_len = 1;
+
+        merged[i] = merge_group(self, group, group_len, &count);
+    }
+
+    for (Usize i = 0; i < len; i++)
+        if (merged[i]) {
+            FREE(IrFun, self->funs[i]);
+            self->funs[i] = merged[i];
+        }
+
+    free(reach);
+    free(merged);
+    free(group);
+
+    return count;
+}
@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_IR_TAIL_H
+#define LILY_IR_TAIL_H
+
+#include <lang/ir/ir.h>
+
+// The tail calls are eliminated when the module is lowered, at every level of
+// optimization. A call whose value is returned (a tail call) to the function
+// itself becomes a jump to the start of its body. The functions which call
+// each other in tail position (with the same return data type) form a group:
+// each function of the group has a copy of the bodies of the other functions
+// of the group and its tail calls jump between the bodies, so the recursion
+// runs in constant stack space. Beyond IR_TAIL_MAX_INSTS instructions in the
+// other bodies of its group, a function only eliminates its own tail calls.
+#define IR_TAIL_MAX_INSTS 512
+
+/**
+ *
+ * @return true if the last instruction of the block is a call whose value is
+ * returned by the function (directly or through jumps to blocks without
+ * instruction).
+ */
+bool
+is_tail_call__IrFun(const struct IrFun *self, Usize block);
+
+/**
+ *
+ * @brief Replace the tail calls of the functions of the module by jumps (see
+ * above).
+ * @return the number of eliminated tail calls.
+ */
+Usize
+eliminate_tail_calls__IrModule(struct IrModule *self);
+
+#endif // LILY_IR_TAIL_H
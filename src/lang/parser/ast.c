@@ -3604,7 +3604,8 @@ __new__RecordDecl(struct String *name,
                   struct Vec *generic_params,
                   struct Vec *fields,
                   bool is_pub,
-                  bool is_object)
+                  bool is_object,
+                  bool is_repr_c)
 {
     struct RecordDecl *self = malloc(sizeof(struct RecordDecl));
     self->name = name;
@@ -3612,6 +3613,7 @@ __new__RecordDecl(struct String *name,
     self->fields = fields;
     self->is_pub = is_pub;
     self->is_object = is_object;
+    self->is_repr_c = is_repr_c;
     return self;
 }
 
@@ -3631,6 +3633,9 @@ to_String__RecordDecl(struct RecordDecl self)
     else
         push_str__String(s, "type ");
 
+    if (self.is_repr_c)
+        push_str__String(s, "#repr_c ");
+
     append__String(s, self.name, false);
 
     if (self.generic_params) {
@@ -3716,6 +3721,10 @@ __new__VariantEnum(struct String *name,
 struct String *
 to_String__VariantEnum(struct VariantEnum self)
 {
+    if (!self.data_type)
+        return format(
+          "{Sr}{S}", repeat__String("\t", current_tab_size), self.name);
+
     return format("{Sr}{S} {Sr}",
                   repeat__String("\t", current_tab_size),
                   self.name,
@@ -2619,6 +2619,7 @@ typedef struct RecordDecl
     struct Vec *fields;         // struct Vec<struct FieldRecord*>*
     bool is_pub;
     bool is_object;
+    bool is_repr_c; // tagged #repr_c: the fields keep their order in memory
 } RecordDecl;
 
 /**
@@ -2630,7 +2631,8 @@ __new__RecordDecl(struct String *name,
                   struct Vec *generic_params,
                   struct Vec *fields,
                   bool is_pub,
-                  bool is_object);
+                  bool is_object,
+                  bool is_repr_c);
 
 /**
  *
@@ -0,0 +1,1576 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/util.h>
+#include <lang/parser/ast_dump.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+   A node is written as:
+
+   JSON:  {"kind":"Fun","loc":[1,1,3,4],"name":"add","params":[...]}
+   Sexpr: (Fun :loc (1 1 3 4) :name "add" :params (...))
+
+   The optional fields which are not set (NULL) are not written.
+*/
+
+static const Str data_type_kinds[] = { "Self",
+                                       "Ptr",
+                                       "Ref",
+                                       "Str",
+                                       "BitStr",
+                                       "Char",
+                                       "BitChar",
+                                       "I8",
+                                       "I16",
+                                       "I32",
+                                       "I64",
+                                       "I128",
+                                       "U8",
+                                       "U16",
+                                       "U32",
+                                       "U64",
+                                       "U128",
+                                       "F32",
+                                       "F64",
+                                       "Bool",
+                                       "Isize",
+                                       "Usize",
+                                       "Never",
+                                       "Any",
+                                       "Optional",
+                                       "Unit",
+                                       "Exception",
+                                       "Mut",
+                                       "Lambda",
+                                       "Array",
+                                       "Tuple",
+                                       "Custom",
+                                       "CompilerDefined" };
+
+static const Str literal_kinds[] = { "Bool",
+                                     "Char",
+                                     "BitChar",
+                                     "Int32WithoutSuffix",
+                                     "Int64WithoutSuffix",
+                                     "Int128WithoutSuffix",
+                                     "Int8",
+                                     "Int16",
+                                     "Int32",
+                                     "Int64",
+                                     "Int128",
+                                     "Uint8",
+                                     "Uint16",
+                                     "Uint32",
+                                     "Uint64",
+                                     "Uint128",
+                                     "Float32",
+                                     "Float64",
+                                     "Float",
+                                     "BitStr",
+                                     "Str",
+                                     "Unit" };
+
+static const Str expr_kinds[] = { "UnaryOp",
+                                  "BinaryOp",
+                                  "FunCall",
+                                  "RecordCall",
+                                  "Identifier",
+                                  "IdentifierAccess",
+                                  "GlobalAccess",
+                                  "ArrayAccess",
+                                  "TupleAccess",
+                                  "PropertyAccessInit",
+                                  "Lambda",
+                                  "Tuple",
+                                  "Array",
+                                  "Variant",
+                                  "Try",
+                                  "If",
+                                  "Block",
+                                  "QuestionMark",
+                                  "Dereference",
+                                  "Ref",
+                                  "Self",
+                                  "Undef",
+                                  "Nil",
+                                  "None",
+                                  "Wildcard",
+                                  "Literal",
+                                  "Variable",
+                                  "Grouping" };
+
+static const Str stmt_kinds[] = { "Return", "If",  "Await", "Try",   "Match",
+                                  "While",  "For", "Next",  "Break", "Import" };
+
+static const Str import_value_kinds[] = { "Std",    "Core",     "Builtin",
+                                          "File",   "Url",      "Access",
+                                          "Selector", "Wildcard" };
+
+static const Str decl_kinds[] = { "Fun",   "Constant", "Module", "Alias",
+                                  "Record", "Enum",    "Error",  "Class",
+                                  "Trait", "Tag",      "Import" };
+
+static const Str fun_param_kinds[] = { "DefaultParam", "Param", "SelfParam" };
+
+static void
+push_level(struct AstDump *self, bool is_first);
+static void
+separate(struct AstDump *self);
+static void
+open_node(struct AstDump *self, const Str kind, struct Location *loc);
+static void
+close_node(struct AstDump *self);
+static void
+open_list(struct AstDump *self);
+static void
+close_list(struct AstDump *self);
+static void
+field(struct AstDump *self, const Str name);
+static void
+write_escaped(struct AstDump *self, char c);
+static void
+value_quoted(struct AstDump *self, const char *s, Usize len);
+static void
+value_string(struct AstDump *self, struct String *s);
+static void
+value_symbol(struct AstDump *self, const Str s);
+static void
+value_bool(struct AstDump *self, bool value);
+static void
+value_int(struct AstDump *self, Int64 value);
+static void
+value_uint(struct AstDump *self, UInt64 value);
+static void
+value_location(struct AstDump *self, struct Location loc);
+static void
+dump_data_type_with_loc(struct AstDump *self,
+                        struct DataType *data_type,
+                        struct Location *loc);
+static void
+dump_data_types(struct AstDump *self, struct Vec *data_types);
+static void
+dump_data_types_with_loc(struct AstDump *self, struct Vec *tuples);
+static void
+dump_generics(struct AstDump *self, struct Vec *generics);
+static void
+dump_literal(struct AstDump *self, struct Literal literal);
+static void
+dump_exprs(struct AstDump *self, struct Vec *exprs);
+static void
+dump_if_branch(struct AstDump *self, struct IfBranch *branch);
+static void
+dump_if_cond_fields(struct AstDump *self, struct IfCond *if_cond);
+static void
+dump_import_value(struct AstDump *self, struct ImportStmtValue *value);
+static void
+dump_import_fields(struct AstDump *self, struct ImportStmt *import);
+static void
+dump_stmt(struct AstDump *self, struct Stmt *stmt);
+static void
+dump_body(struct AstDump *self, struct Vec *body);
+static void
+dump_fun_params(struct AstDump *self, struct Vec *params);
+static void
+dump_module_body(struct AstDump *self, struct Vec *body);
+
+struct AstDump
+__new__AstDump(struct Writer *writer, enum AstDumpKind kind)
+{
+    struct AstDump self = { .writer = writer,
+                            .kind = kind,
+                            .is_first = malloc(sizeof(bool) * 32),
+                            .depth = 0,
+                            .capacity = 32,
+                            .after_field = false };
+
+    return self;
+}
+
+static void
+push_level(struct AstDump *self, bool is_first)
+{
+    if (self->depth == self->capacity) {
+        self->capacity *= 2;
+        self->is_first =
+          realloc(self->is_first, sizeof(bool) * self->capacity);
+    }
+
+    self->is_first[self->depth++] = is_first;
+}
+
+// Write the separator before an item of the current node or list.
+static void
+separate(struct AstDump *self)
+{
+    if (self->after_field) {
+        self->after_field = false;
+
+        if (self->kind == AstDumpKindSexpr)
+            write_char__Writer(self->writer, ' ');
+
+        return;
+    }
+
+    if (self->depth == 0)
+        return;
+
+    if (self->is_first[self->depth - 1]) {
+        self->is_first[self->depth - 1] = false;
+        return;
+    }
+
+    write_char__Writer(self->writer,
+                       self->kind == AstDumpKindJson ? ',' : ' ');
+}
+
+static void
+open_node(struct AstDump *self, const Str kind, struct Location *loc)
+{
+    separate(self);
+
+    switch (self->kind) {
+        case AstDumpKindJson:
+            write_str__Writer(self->writer, "{\"kind\":\"");
+            write_str__Writer(self->writer, kind);
+            write_char__Writer(self->writer, '"');
+            break;
+        case AstDumpKindSexpr:
+            write_char__Writer(self->writer, '(');
+            write_str__Writer(self->writer, kind);
+            break;
+    }
+
+    push_level(self, false);
+
+    if (loc) {
+        field(self, "loc");
+        value_location(self, *loc);
+    }
+}
+
+static void
+close_node(struct AstDump *self)
+{
+    self->depth--;
+    write_char__Writer(self->writer, self->kind == AstDumpKindJson ? '}' : ')');
+}
+
+static void
+open_list(struct AstDump *self)
+{
+    separate(self);
+    write_char__Writer(self->writer, self->kind == AstDumpKindJson ? '[' : '(');
+    push_level(self, true);
+}
+
+static void
+close_list(struct AstDump *self)
+{
+    self->depth--;
+    write_char__Writer(self->writer, self->kind == AstDumpKindJson ? ']' : ')');
+}
+
+static void
+field(struct AstDump *self, const Str name)
+{
+    separate(self);
+
+    switch (self->kind) {
+        case AstDumpKindJson:
+            write_char__Writer(self->writer, '"');
+            write_str__Writer(self->writer, name);
+            write_str__Writer(self->writer, "\":");
+            break;
+        case AstDumpKindSexpr:
+            write_char__Writer(self->writer, ':');
+            write_str__Writer(self->writer, name);
+            break;
+    }
+
+    self->after_field = true;
+}
+
+static void
+write_escaped(struct AstDump *self, char c)
+{
+    switch (c) {
+        case '"':
+            write_str__Writer(self->writer, "\\\"");
+            break;
+        case '\\':
+            write_str__Writer(self->writer, "\\\\");
+            break;
+        case '\n':
+            write_str__Writer(self->writer, "\\n");
+            break;
+        case '\t':
+            write_str__Writer(self->writer, "\\t");
+            break;
+        case '\r':
+            write_str__Writer(self->writer, "\\r");
+            break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                const char *hex = "0123456789abcdef";
+
+                write_str__Writer(self->writer, "\\u00");
+                write_char__Writer(self->writer, hex[(c >> 4) & 0xf]);
+                write_char__Writer(self->writer, hex[c & 0xf]);
+            } else
+                write_char__Writer(self->writer, c);
+    }
+}
+
+static void
+value_quoted(struct AstDump *self, const char *s, Usize len)
+{
+    separate(self);
+    write_char__Writer(self->writer, '"');
+
+    for (Usize i = 0; i < len; i++)
+        write_escaped(self, s[i]);
+
+    write_char__Writer(self->writer, '"');
+}
+
+static void
+value_string(struct AstDump *self, struct String *s)
+{
+    separate(self);
+    write_char__Writer(self->writer, '"');
+
+    for (Usize i = 0; i < len__String(*s); i++)
+        write_escaped(self, (char)(UPtr)get__String(*s, i));
+
+    write_char__Writer(self->writer, '"');
+}
+
+// A symbol is an identifier chosen by the dump (kind of operator, ...): it's
+// quoted in JSON and written as is in S-expression.
+static void
+value_symbol(struct AstDump *self, const Str s)
+{
+    if (self->kind == AstDumpKindJson) {
+        value_quoted(self, s, strlen(s));
+        return;
+    }
+
+    separate(self);
+    write_str__Writer(self->writer, s);
+}
+
+static void
+value_bool(struct AstDump *self, bool value)
+{
+    separate(self);
+    write_str__Writer(self->writer, value ? "true" : "false");
+}
+
+static void
+value_int(struct AstDump *self, Int64 value)
+{
+    separate(self);
+    write_int__Writer(self->writer, value);
+}
+
+static void
+value_uint(struct AstDump *self, UInt64 value)
+{
+    separate(self);
+    write_uint__Writer(self->writer, value);
+}
+
+static void
+value_location(struct AstDump *self, struct Location loc)
+{
+    open_list(self);
+    value_uint(self, loc.s_line);
+    value_uint(self, loc.s_col);
+    value_uint(self, loc.e_line);
+    value_uint(self, loc.e_col);
+    close_list(self);
+}
+
+void
+dump_data_type__AstDump(struct AstDump *self, struct DataType *data_type)
+{
+    dump_data_type_with_loc(self, data_type, NULL);
+}
+
+static void
+dump_data_type_with_loc(struct AstDump *self,
+                        struct DataType *data_type,
+                        struct Location *loc)
+{
+    open_node(self, data_type_kinds[data_type->kind], loc);
+
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            field(self, "type");
+            dump_data_type__AstDump(self, data_type->value.ptr);
+            break;
+        case DataTypeKindRef:
+            field(self, "type");
+            dump_data_type__AstDump(self, data_type->value.ref);
+            break;
+        case DataTypeKindOptional:
+            field(self, "type");
+            dump_data_type__AstDump(self, data_type->value.optional);
+            break;
+        case DataTypeKindException:
+            field(self, "type");
+            dump_data_type__AstDump(self, data_type->value.exception);
+            break;
+        case DataTypeKindMut:
+            field(self, "type");
+            dump_data_type__AstDump(self, data_type->value.mut);
+            break;
+        case DataTypeKindLambda:
+            if (data_type->value.lambda->items[0]) {
+                field(self, "params");
+                dump_data_types(self, data_type->value.lambda->items[0]);
+            }
+
+            if (data_type->value.lambda->items[1]) {
+                field(self, "return_type");
+                dump_data_type__AstDump(self,
+                                        data_type->value.lambda->items[1]);
+            }
+
+            break;
+        case DataTypeKindArray:
+            if (data_type->value.array->items[0]) {
+                field(self, "type");
+                dump_data_type__AstDump(self,
+                                        data_type->value.array->items[0]);
+            }
+
+            if (data_type->value.array->items[1]) {
+                field(self, "size");
+                value_uint(self, *(Usize *)data_type->value.array->items[1]);
+            }
+
+            break;
+        case DataTypeKindCustom: {
+            struct Vec *names = data_type->value.custom->items[0];
+
+            field(self, "names");
+            open_list(self);
+
+            for (Usize i = 0; i < len__Vec(*names); i++)
+                value_string(self, get__Vec(*names, i));
+
+            close_list(self);
+
+            if (data_type->value.custom->items[1]) {
+                field(self, "generics");
+                dump_data_types(self, data_type->value.custom->items[1]);
+            }
+
+            break;
+        }
+        case DataTypeKindTuple:
+            field(self, "items");
+            dump_data_types(self, data_type->value.tuple);
+            break;
+        default:
+            break;
+    }
+
+    close_node(self);
+}
+
+static void
+dump_data_types(struct AstDump *self, struct Vec *data_types)
+{
+    open_list(self);
+
+    for (Usize i = 0; i < len__Vec(*data_types); i++)
+        dump_data_type__AstDump(self, get__Vec(*data_types, i));
+
+    close_list(self);
+}
+
+// struct Vec<struct Tuple<struct DataType*, struct Location*>*>&
+static void
+dump_data_types_with_loc(struct AstDump *self, struct Vec *tuples)
+{
+    open_list(self);
+
+    for (Usize i = 0; i < len__Vec(*tuples); i++) {
+        struct Tuple *tuple = get__Vec(*tuples, i);
+
+        dump_data_type_with_loc(self, tuple->items[0], tuple->items[1]);
+    }
+
+    close_list(self);
+}
+
+static void
+dump_generics(struct AstDump *self, struct Vec *generics)
+{
+    open_list(self);
+
+    for (Usize i = 0; i < len__Vec(*generics); i++) {
+        struct Generic *generic = get__Vec(*generics, i);
+
+        open_node(self, "Generic", &generic->loc);
+        field(self, "name");
+        value_string(self, get_name__Generic(generic));
+
+        if (generic->kind == GenericKindRestrictedDataType) {
+            struct Tuple *data_type =
+              generic->value.restricted_data_type->items[1];
+
+            field(self, "restricted");
+            dump_data_type_with_loc(
+              self, data_type->items[0], data_type->items[1]);
+        }
+
+        close_node(self);
+    }
+
+    close_list(self);
+}
+
+static void
+dump_literal(struct AstDump *self, struct Literal literal)
+{
+    field(self, "type");
+    value_symbol(self, literal_kinds[literal.kind]);
+
+    if (literal.kind == LiteralKindUnit)
+        return;
+
+    field(self, "value");
+
+    switch (literal.kind) {
+        case LiteralKindBool:
+            value_bool(self, literal.value.bool_);
+            break;
+        case LiteralKindChar:
+            value_quoted(self, &literal.value.char_, 1);
+            break;
+        case LiteralKindBitChar:
+            value_uint(self, literal.value.bit_char);
+            break;
+        case LiteralKindInt32WithoutSuffix:
+            value_int(self, literal.value.int32_ws);
+            break;
+        case LiteralKindInt64WithoutSuffix:
+            value_int(self, literal.value.int64_ws);
+            break;
+        case LiteralKindInt8:
+            value_int(self, literal.value.int8);
+            break;
+        case LiteralKindInt16:
+            value_int(self, literal.value.int16);
+            break;
+        case LiteralKindInt32:
+            value_int(self, literal.value.int32);
+            break;
+        case LiteralKindInt64:
+            value_int(self, literal.value.int64);
+            break;
+        case LiteralKindInt128WithoutSuffix:
+        case LiteralKindInt128: {
+            Int128 value = literal.kind == LiteralKindInt128
+                             ? literal.value.int128
+                             : literal.value.int128_ws;
+            struct String *s =
+              itoa_u128(value < 0 ? -(UInt128)value : (UInt128)value, 10);
+
+            separate(self);
+
+            if (value < 0)
+                write_char__Writer(self->writer, '-');
+
+            write_String__Writer(self->writer, s);
+            FREE(String, s);
+
+            break;
+        }
+        case LiteralKindUint8:
+            value_uint(self, literal.value.uint8);
+            break;
+        case LiteralKindUint16:
+            value_uint(self, literal.value.uint16);
+            break;
+        case LiteralKindUint32:
+            value_uint(self, literal.value.uint32);
+            break;
+        case LiteralKindUint64:
+            value_uint(self, literal.value.uint64);
+            break;
+        case LiteralKindUint128: {
+            struct String *s = itoa_u128(literal.value.uint128, 10);
+
+            separate(self);
+            write_String__Writer(self->writer, s);
+            FREE(String, s);
+
+            break;
+        }
+        case LiteralKindFloat32:
+            separate(self);
+            write_float__Writer(self->writer, literal.value.float32);
+            break;
+        case LiteralKindFloat64:
+            separate(self);
+            write_float__Writer(self->writer, literal.value.float64);
+            break;
+        case LiteralKindFloat:
+            separate(self);
+            write_float__Writer(self->writer, literal.value.float_);
+            break;
+        case LiteralKindStr:
+            value_quoted(self, literal.value.str, strlen(literal.value.str));
+            break;
+        case LiteralKindBitStr:
+            open_list(self);
+
+            for (Usize i = 0; literal.value.bit_str[i]; i++)
+                value_uint(self, (UInt8)(UPtr)literal.value.bit_str[i]);
+
+            close_list(self);
+
+            break;
+        case LiteralKindUnit:
+            break;
+    }
+}
+
+void
+dump_expr__AstDump(struct AstDump *self, struct Expr *expr)
+{
+    open_node(self, expr_kinds[expr->kind], &expr->loc);
+
+    switch (expr->kind) {
+        case ExprKindUnaryOp:
+            field(self, "op");
+
+            if (expr->value.unary_op.kind == UnaryOpKindCustom)
+                value_string(self, expr->value.unary_op.op);
+            else
+                value_quoted(self,
+                             to_str__UnaryOpKind(expr->value.unary_op.kind),
+                             strlen(to_str__UnaryOpKind(
+                               expr->value.unary_op.kind)));
+
+            field(self, "right");
+            dump_expr__AstDump(self, expr->value.unary_op.right);
+
+            break;
+        case ExprKindBinaryOp:
+            field(self, "op");
+
+            if (expr->value.binary_op.kind == BinaryOpKindCustom)
+                value_string(self, expr->value.binary_op.op);
+            else
+                value_quoted(self,
+                             to_str__BinaryOpKind(expr->value.binary_op.kind),
+                             strlen(to_str__BinaryOpKind(
+                               expr->value.binary_op.kind)));
+
+            field(self, "left");
+            dump_expr__AstDump(self, expr->value.binary_op.left);
+            field(self, "right");
+            dump_expr__AstDump(self, expr->value.binary_op.right);
+
+            break;
+        case ExprKindFunCall: {
+            struct Vec *params = expr->value.fun_call.params;
+
+            field(self, "id");
+            dump_expr__AstDump(self, expr->value.fun_call.id);
+            field(self, "params");
+            open_list(self);
+
+            for (Usize i = 0; i < len__Vec(*params); i++) {
+                struct Tuple *param = get__Vec(*params, i);
+                struct FunParamCall *param_call = param->items[0];
+
+                open_node(
+                  self, fun_param_kinds[param_call->kind], param->items[1]);
+
+                if (param_call->kind == FunParamKindDefault) {
+                    field(self, "name");
+                    value_string(self, param_call->name);
+                }
+
+                field(self, "value");
+                dump_expr__AstDump(self, param_call->value);
+                close_node(self);
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case ExprKindRecordCall: {
+            struct Vec *fields = expr->value.record_call.fields;
+
+            field(self, "id");
+            dump_expr__AstDump(self, expr->value.record_call.id);
+            field(self, "fields");
+            open_list(self);
+
+            for (Usize i = 0; i < len__Vec(*fields); i++) {
+                struct Tuple *field_call = get__Vec(*fields, i);
+                struct FieldCall *value = field_call->items[0];
+
+                open_node(self, "Field", field_call->items[1]);
+                field(self, "name");
+                value_string(self, value->name);
+
+                if (is_Some__Option(value->value)) {
+                    field(self, "value");
+                    dump_expr__AstDump(self, get__Option(value->value));
+                }
+
+                close_node(self);
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case ExprKindIdentifier:
+            field(self, "name");
+            value_string(self, expr->value.identifier);
+            break;
+        case ExprKindIdentifierAccess:
+            field(self, "items");
+            dump_exprs(self, expr->value.identifier_access);
+            break;
+        case ExprKindGlobalAccess:
+            field(self, "items");
+            dump_exprs(self, expr->value.global_access);
+            break;
+        case ExprKindPropertyAccessInit:
+            field(self, "items");
+            dump_exprs(self, expr->value.property_access_init);
+            break;
+        case ExprKindArrayAccess:
+            field(self, "id");
+            dump_expr__AstDump(self, expr->value.array_access.id);
+            field(self, "access");
+            dump_exprs(self, expr->value.array_access.access);
+            break;
+        case ExprKindTupleAccess:
+            field(self, "id");
+            dump_expr__AstDump(self, expr->value.tuple_access.id);
+            field(self, "access");
+            dump_exprs(self, expr->value.tuple_access.access);
+            break;
+        case ExprKindLambda:
+            field(self, "params");
+            dump_fun_params(self, expr->value.lambda.params);
+
+            if (expr->value.lambda.return_type) {
+                field(self, "return_type");
+                dump_data_type__AstDump(self, expr->value.lambda.return_type);
+            }
+
+            field(self, "body");
+            dump_body(self, expr->value.lambda.body);
+            field(self, "instantly_call");
+            value_bool(self, expr->value.lambda.instantly_call);
+
+            break;
+        case ExprKindTuple:
+            field(self, "items");
+            dump_exprs(self, expr->value.tuple);
+            break;
+        case ExprKindArray:
+            field(self, "items");
+            dump_exprs(self, expr->value.array);
+            break;
+        case ExprKindVariant:
+            field(self, "id");
+            dump_expr__AstDump(self, expr->value.variant.id);
+
+            if (expr->value.variant.value) {
+                field(self, "value");
+                dump_expr__AstDump(self, expr->value.variant.value);
+            }
+
+            break;
+        case ExprKindTry:
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.try);
+            break;
+        case ExprKindIf:
+            dump_if_cond_fields(self, expr->value.if_);
+            break;
+        case ExprKindBlock:
+            field(self, "body");
+            dump_body(self, expr->value.block);
+            break;
+        case ExprKindQuestionMark:
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.question_mark);
+            break;
+        case ExprKindDereference:
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.dereference);
+            break;
+        case ExprKindRef:
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.ref);
+            break;
+        case ExprKindLiteral:
+            dump_literal(self, expr->value.literal);
+            break;
+        case ExprKindVariable:
+            field(self, "name");
+            value_string(self, expr->value.variable.name);
+            field(self, "is_mut");
+            value_bool(self, expr->value.variable.is_mut);
+
+            if (expr->value.variable.data_type) {
+                field(self, "data_type");
+                dump_data_type__AstDump(self, expr->value.variable.data_type);
+            }
+
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.variable.expr);
+
+            break;
+        case ExprKindGrouping:
+            field(self, "expr");
+            dump_expr__AstDump(self, expr->value.grouping);
+            break;
+        case ExprKindSelf:
+        case ExprKindUndef:
+        case ExprKindNil:
+        case ExprKindNone:
+        case ExprKindWildcard:
+            break;
+    }
+
+    close_node(self);
+}
+
+static void
+dump_exprs(struct AstDump *self, struct Vec *exprs)
+{
+    open_list(self);
+
+    for (Usize i = 0; i < len__Vec(*exprs); i++)
+        dump_expr__AstDump(self, get__Vec(*exprs, i));
+
+    close_list(self);
+}
+
+static void
+dump_if_branch(struct AstDump *self, struct IfBranch *branch)
+{
+    open_node(self, "Branch", NULL);
+    field(self, "cond");
+    dump_expr__AstDump(self, branch->cond);
+    field(self, "body");
+    dump_body(self, branch->body);
+    close_node(self);
+}
+
+static void
+dump_if_cond_fields(struct AstDump *self, struct IfCond *if_cond)
+{
+    field(self, "if");
+    dump_if_branch(self, if_cond->if_);
+
+    if (if_cond->elif) {
+        field(self, "elif");
+        open_list(self);
+
+        for (Usize i = 0; i < len__Vec(*if_cond->elif); i++)
+            dump_if_branch(self, get__Vec(*if_cond->elif, i));
+
+        close_list(self);
+    }
+
+    if (if_cond->else_) {
+        field(self, "else");
+        dump_body(self, if_cond->else_);
+    }
+}
+
+static void
+dump_import_value(struct AstDump *self, struct ImportStmtValue *value)
+{
+    open_node(self, import_value_kinds[value->kind], NULL);
+
+    switch (value->kind) {
+        case ImportStmtValueKindAccess:
+            field(self, "value");
+            value_string(self, value->value.access);
+            break;
+        case ImportStmtValueKindFile:
+            field(self, "value");
+            value_string(self, value->value.file);
+            break;
+        case ImportStmtValueKindUrl:
+            field(self, "value");
+            value_string(self, value->value.url);
+            break;
+        case ImportStmtValueKindSelector:
+            field(self, "items");
+            open_list(self);
+
+            for (Usize i = 0; i < len__Vec(*value->value.selector); i++) {
+                struct Vec *values = get__Vec(*value->value.selector, i);
+
+                open_list(self);
+
+                for (Usize j = 0; j < len__Vec(*values); j++)
+                    dump_import_value(self, get__Vec(*values, j));
+
+                close_list(self);
+            }
+
+            close_list(self);
+
+            break;
+        default:
+            break;
+    }
+
+    close_node(self);
+}
+
+static void
+dump_import_fields(struct AstDump *self, struct ImportStmt *import)
+{
+    field(self, "is_pub");
+    value_bool(self, import->is_pub);
+    field(self, "values");
+    open_list(self);
+
+    for (Usize i = 0; i < len__Vec(*import->import_value); i++)
+        dump_import_value(self, get__Vec(*import->import_value, i));
+
+    close_list(self);
+
+    if (import->as) {
+        field(self, "as");
+        value_string(self, import->as);
+    }
+}
+
+static void
+dump_stmt(struct AstDump *self, struct Stmt *stmt)
+{
+    open_node(self, stmt_kinds[stmt->kind], &stmt->loc);
+
+    switch (stmt->kind) {
+        case StmtKindReturn:
+            if (stmt->value.return_) {
+                field(self, "expr");
+                dump_expr__AstDump(self, stmt->value.return_);
+            }
+
+            break;
+        case StmtKindIf:
+            dump_if_cond_fields(self, stmt->value.if_);
+            break;
+        case StmtKindAwait:
+            field(self, "expr");
+            dump_expr__AstDump(self, stmt->value.await);
+            break;
+        case StmtKindTry:
+            field(self, "body");
+            dump_body(self, stmt->value.try->try_body);
+
+            if (stmt->value.try->catch_expr) {
+                field(self, "catch_expr");
+                dump_expr__AstDump(self, stmt->value.try->catch_expr);
+            }
+
+            if (stmt->value.try->catch_body) {
+                field(self, "catch_body");
+                dump_body(self, stmt->value.try->catch_body);
+            }
+
+            break;
+        case StmtKindMatch: {
+            struct Vec *pattern = stmt->value.match->pattern;
+
+            field(self, "matching");
+            dump_expr__AstDump(self, stmt->value.match->matching);
+            field(self, "arms");
+            open_list(self);
+
+            for (Usize i = 0; i < len__Vec(*pattern); i++) {
+                struct Tuple *arm = get__Vec(*pattern, i);
+
+                open_node(self, "Arm", NULL);
+                field(self, "pattern");
+                dump_expr__AstDump(self, arm->items[0]);
+
+                if (arm->items[1]) {
+                    field(self, "cond");
+                    dump_expr__AstDump(self, arm->items[1]);
+                }
+
+                field(self, "expr");
+                dump_expr__AstDump(self, arm->items[2]);
+                close_node(self);
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case StmtKindWhile:
+            field(self, "cond");
+            dump_expr__AstDump(self, stmt->value.while_->cond);
+            field(self, "body");
+            dump_body(self, stmt->value.while_->body);
+            break;
+        case StmtKindFor: {
+            struct ForStmtExpr *expr = stmt->value.for_->expr;
+
+            field(self, "expr");
+
+            switch (expr->kind) {
+                case ForStmtExprKindRange:
+                    open_node(self, "Range", &expr->loc);
+                    field(self, "var");
+                    dump_expr__AstDump(self, expr->value.range->items[0]);
+                    field(self, "expr");
+                    dump_expr__AstDump(self, expr->value.range->items[1]);
+                    close_node(self);
+                    break;
+                case ForStmtExprKindTraditional:
+                    open_node(self, "Traditional", &expr->loc);
+
+                    if (expr->value.traditional->var) {
+                        field(self, "var");
+                        dump_expr__AstDump(self, expr->value.traditional->var);
+                    }
+
+                    if (expr->value.traditional->cond) {
+                        field(self, "cond");
+                        dump_expr__AstDump(self,
+                                           expr->value.traditional->cond);
+                    }
+
+                    if (expr->value.traditional->action) {
+                        field(self, "action");
+                        dump_expr__AstDump(self,
+                                           expr->value.traditional->action);
+                    }
+
+                    close_node(self);
+
+                    break;
+            }
+
+            field(self, "body");
+            dump_body(self, stmt->value.for_->body);
+
+            break;
+        }
+        case StmtKindImport:
+            dump_import_fields(self, stmt->value.import);
+            break;
+        case StmtKindNext:
+        case StmtKindBreak:
+            break;
+    }
+
+    close_node(self);
+}
+
+// struct Vec<struct FunBodyItem*>&
+static void
+dump_body(struct AstDump *self, struct Vec *body)
+{
+    open_list(self);
+
+    if (body) {
+        for (Usize i = 0; i < len__Vec(*body); i++) {
+            struct FunBodyItem *item = get__Vec(*body, i);
+
+            switch (item->kind) {
+                case FunBodyItemKindExpr:
+                    dump_expr__AstDump(self, item->expr);
+                    break;
+                case FunBodyItemKindStmt:
+                    dump_stmt(self, item->stmt);
+                    break;
+            }
+        }
+    }
+
+    close_list(self);
+}
+
+// struct Vec<struct FunParam*>&
+static void
+dump_fun_params(struct AstDump *self, struct Vec *params)
+{
+    open_list(self);
+
+    if (params) {
+        for (Usize i = 0; i < len__Vec(*params); i++) {
+            struct FunParam *param = get__Vec(*params, i);
+
+            open_node(self, fun_param_kinds[param->kind], &param->loc);
+
+            if (param->kind != FunParamKindSelf) {
+                field(self, "name");
+                value_string(self, param->name);
+
+                if (param->super_tag.name) {
+                    field(self, "super_tag");
+                    value_string(self, param->super_tag.name);
+                }
+
+                if (param->param_data_type) {
+                    field(self, "data_type");
+                    dump_data_type_with_loc(self,
+                                            param->param_data_type->items[0],
+                                            param->param_data_type->items[1]);
+                }
+
+                if (param->kind == FunParamKindDefault) {
+                    field(self, "default");
+                    dump_expr__AstDump(self, param->value.default_);
+                }
+            }
+
+            close_node(self);
+        }
+    }
+
+    close_list(self);
+}
+
+// struct Vec<struct ModuleBodyItem*>&
+static void
+dump_module_body(struct AstDump *self, struct Vec *body)
+{
+    open_list(self);
+
+    if (body) {
+        for (Usize i = 0; i < len__Vec(*body); i++) {
+            struct ModuleBodyItem *item = get__Vec(*body, i);
+
+            switch (item->kind) {
+                case ModuleBodyItemKindDecl:
+                    dump_decl__AstDump(self, item->value.decl);
+                    break;
+                case ModuleBodyItemKindImport:
+                    open_node(self, "Import", item->value.import->items[1]);
+                    dump_import_fields(self, item->value.import->items[0]);
+                    close_node(self);
+                    break;
+                default:
+                    UNREACHABLE("unknown module body item kind");
+            }
+        }
+    }
+
+    close_list(self);
+}
+
+void
+dump_decl__AstDump(struct AstDump *self, struct Decl *decl)
+{
+    open_node(self, decl_kinds[decl->kind], &decl->loc);
+
+    switch (decl->kind) {
+        case DeclKindFun: {
+            struct FunDecl *fun = decl->value.fun;
+
+            field(self, "name");
+            value_string(self, fun->name);
+            field(self, "is_pub");
+            value_bool(self, fun->is_pub);
+            field(self, "is_async");
+            value_bool(self, fun->is_async);
+
+            if (fun->tags) {
+                field(self, "tags");
+                dump_data_types_with_loc(self, fun->tags);
+            }
+
+            if (fun->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, fun->generic_params);
+            }
+
+            field(self, "params");
+            dump_fun_params(self, fun->params);
+
+            if (fun->return_type) {
+                field(self, "return_type");
+                dump_data_type_with_loc(
+                  self, fun->return_type->items[0], fun->return_type->items[1]);
+            }
+
+            field(self, "body");
+            dump_body(self, fun->body);
+
+            break;
+        }
+        case DeclKindConstant:
+            field(self, "name");
+            value_string(self, decl->value.constant->name);
+            field(self, "is_pub");
+            value_bool(self, decl->value.constant->is_pub);
+
+            if (decl->value.constant->data_type) {
+                field(self, "data_type");
+                dump_data_type__AstDump(self, decl->value.constant->data_type);
+            }
+
+            field(self, "expr");
+            dump_expr__AstDump(self, decl->value.constant->expr);
+
+            break;
+        case DeclKindModule:
+            field(self, "name");
+            value_string(self, decl->value.module->name);
+            field(self, "is_pub");
+            value_bool(self, decl->value.module->is_pub);
+            field(self, "body");
+            dump_module_body(self, decl->value.module->body);
+            break;
+        case DeclKindAlias:
+            field(self, "name");
+            value_string(self, decl->value.alias->name);
+            field(self, "is_pub");
+            value_bool(self, decl->value.alias->is_pub);
+
+            if (decl->value.alias->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, decl->value.alias->generic_params);
+            }
+
+            field(self, "data_type");
+            dump_data_type__AstDump(self, decl->value.alias->data_type);
+
+            break;
+        case DeclKindRecord: {
+            struct RecordDecl *record = decl->value.record;
+
+            field(self, "name");
+            value_string(self, record->name);
+            field(self, "is_pub");
+            value_bool(self, record->is_pub);
+            field(self, "is_object");
+            value_bool(self, record->is_object);
+
+            if (record->is_repr_c) {
+                field(self, "is_repr_c");
+                value_bool(self, true);
+            }
+
+            if (record->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, record->generic_params);
+            }
+
+            field(self, "fields");
+            open_list(self);
+
+            for (Usize i = 0; record->fields && i < len__Vec(*record->fields);
+                 i++) {
+                struct FieldRecord *field_record =
+                  get__Vec(*record->fields, i);
+
+                open_node(self, "Field", &field_record->loc);
+                field(self, "name");
+                value_string(self, field_record->name);
+                field(self, "is_pub");
+                value_bool(self, field_record->is_pub);
+                field(self, "data_type");
+                dump_data_type__AstDump(self, field_record->data_type);
+
+                if (field_record->value) {
+                    field(self, "value");
+                    dump_expr__AstDump(self, field_record->value);
+                }
+
+                close_node(self);
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case DeclKindEnum: {
+            struct EnumDecl *enum_ = decl->value.enum_;
+
+            field(self, "name");
+            value_string(self, enum_->name);
+            field(self, "is_pub");
+            value_bool(self, enum_->is_pub);
+            field(self, "is_object");
+            value_bool(self, enum_->is_object);
+            field(self, "is_error");
+            value_bool(self, enum_->is_error);
+
+            if (enum_->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, enum_->generic_params);
+            }
+
+            if (enum_->type_value) {
+                field(self, "type_value");
+                dump_data_type__AstDump(self, enum_->type_value);
+            }
+
+            field(self, "variants");
+            open_list(self);
+
+            for (Usize i = 0; enum_->variants && i < len__Vec(*enum_->variants);
+                 i++) {
+                struct VariantEnum *variant = get__Vec(*enum_->variants, i);
+
+                open_node(self, "Variant", &variant->loc);
+                field(self, "name");
+                value_string(self, variant->name);
+
+                if (variant->data_type) {
+                    field(self, "data_type");
+                    dump_data_type__AstDump(self, variant->data_type);
+                }
+
+                close_node(self);
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case DeclKindError:
+            field(self, "name");
+            value_string(self, decl->value.error->name);
+            field(self, "is_pub");
+            value_bool(self, decl->value.error->is_pub);
+
+            if (decl->value.error->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, decl->value.error->generic_params);
+            }
+
+            if (decl->value.error->data_type) {
+                field(self, "data_type");
+                dump_data_type__AstDump(self, decl->value.error->data_type);
+            }
+
+            break;
+        case DeclKindClass: {
+            struct ClassDecl *class = decl->value.class;
+
+            field(self, "name");
+            value_string(self, class->name);
+            field(self, "is_pub");
+            value_bool(self, class->is_pub);
+
+            if (class->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, class->generic_params);
+            }
+
+            if (class->inheritance) {
+                field(self, "inheritance");
+                dump_data_types_with_loc(self, class->inheritance);
+            }
+
+            if (class->impl) {
+                field(self, "impl");
+                dump_data_types_with_loc(self, class->impl);
+            }
+
+            field(self, "body");
+            open_list(self);
+
+            for (Usize i = 0; class->body && i < len__Vec(*class->body); i++) {
+                struct ClassBodyItem *item = get__Vec(*class->body, i);
+
+                switch (item->kind) {
+                    case ClassBodyItemKindProperty:
+                        open_node(self, "Property", &item->loc);
+                        field(self, "name");
+                        value_string(self, item->value.property->name);
+                        field(self, "is_pub");
+                        value_bool(self, item->value.property->is_pub);
+                        field(self, "data_type");
+                        dump_data_type__AstDump(
+                          self, item->value.property->data_type);
+                        close_node(self);
+                        break;
+                    case ClassBodyItemKindMethod: {
+                        struct MethodDecl *method = item->value.method;
+
+                        open_node(self, "Method", &item->loc);
+                        field(self, "name");
+                        value_string(self, method->name);
+                        field(self, "is_pub");
+                        value_bool(self, method->is_pub);
+                        field(self, "is_async");
+                        value_bool(self, method->is_async);
+                        field(self, "has_first_self_param");
+                        value_bool(self, method->has_first_self_param);
+
+                        if (method->generic_params) {
+                            field(self, "generic_params");
+                            dump_generics(self, method->generic_params);
+                        }
+
+                        field(self, "params");
+                        dump_fun_params(self, method->params);
+
+                        if (method->return_type) {
+                            field(self, "return_type");
+                            dump_data_type__AstDump(self, method->return_type);
+                        }
+
+                        field(self, "body");
+                        dump_body(self, method->body);
+                        close_node(self);
+
+                        break;
+                    }
+                    case ClassBodyItemKindImport:
+                        open_node(self, "Import", &item->loc);
+                        dump_import_fields(self, item->value.import);
+                        close_node(self);
+                        break;
+                }
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case DeclKindTrait: {
+            struct TraitDecl *trait = decl->value.trait;
+
+            field(self, "name");
+            value_string(self, trait->name);
+            field(self, "is_pub");
+            value_bool(self, trait->is_pub);
+
+            if (trait->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, trait->generic_params);
+            }
+
+            if (trait->inh) {
+                field(self, "inheritance");
+                dump_data_types_with_loc(self, trait->inh);
+            }
+
+            field(self, "body");
+            open_list(self);
+
+            for (Usize i = 0; trait->body && i < len__Vec(*trait->body); i++) {
+                struct TraitBodyItem *item = get__Vec(*trait->body, i);
+
+                switch (item->kind) {
+                    case TraitBodyItemKindPrototype: {
+                        struct Prototype *prototype = item->value.prototype;
+
+                        open_node(self, "Prototype", &item->loc);
+                        field(self, "name");
+                        value_string(self, prototype->name);
+                        field(self, "is_async");
+                        value_bool(self, prototype->is_async);
+                        field(self, "has_first_self_param");
+                        value_bool(self, prototype->has_first_self_param);
+                        field(self, "params_type");
+                        dump_data_types(self, prototype->params_type);
+                        field(self, "return_type");
+                        dump_data_type__AstDump(self, prototype->return_type);
+                        close_node(self);
+
+                        break;
+                    }
+                    case TraitBodyItemKindImport:
+                        open_node(self, "Import", &item->loc);
+                        dump_import_fields(self, item->value.import);
+                        close_node(self);
+                        break;
+                }
+            }
+
+            close_list(self);
+
+            break;
+        }
+        case DeclKindTag:
+            field(self, "name");
+            value_string(self, decl->value.tag->name);
+
+            if (decl->value.tag->generic_params) {
+                field(self, "generic_params");
+                dump_generics(self, decl->value.tag->generic_params);
+            }
+
+            field(self, "body");
+            dump_module_body(self, decl->value.tag->body);
+
+            break;
+        case DeclKindImport:
+            dump_import_fields(self, decl->value.import);
+            break;
+    }
+
+    close_node(self);
+}
+
+void
+dump_decls__AstDump(struct AstDump *self, struct Vec *decls)
+{
+    if (self->kind == AstDumpKindJson)
+        write_str__Writer(self->writer, "[\n");
+
+    for (Usize i = 0; i < len__Vec(*decls); i++) {
+        dump_decl__AstDump(self, get__Vec(*decls, i));
+
+        if (self->kind == AstDumpKindJson && i + 1 < len__Vec(*decls))
+            write_char__Writer(self->writer, ',');
+
+        write_char__Writer(self->writer, '\n');
+    }
+
+    if (self->kind == AstDumpKindJson)
+        write_str__Writer(self->writer, "]\n");
+}
+
+void
+__free__AstDump(struct AstDump self)
+{
+    free(self.is_first);
+}
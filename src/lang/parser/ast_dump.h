@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_AST_DUMP_H
+#define LILY_AST_DUMP_H
+
+#include <base/writer.h>
+#include <lang/parser/ast.h>
+
+enum AstDumpKind
+{
+    AstDumpKindJson,
+    AstDumpKindSexpr
+};
+
+// Each node of the AST is written exactly once and directly in the Writer, so
+// the dump is linear in the size of the tree (unlike to_String__Decl).
+typedef struct AstDump
+{
+    struct Writer *writer; // struct Writer&
+    enum AstDumpKind kind;
+    bool *is_first; // for each open node or list: no item written yet
+    Usize depth;
+    Usize capacity;
+    bool after_field;
+} AstDump;
+
+/**
+ *
+ * @brief Construct the AstDump type.
+ */
+struct AstDump
+__new__AstDump(struct Writer *writer, enum AstDumpKind kind);
+
+/**
+ *
+ * @brief Dump all declarations (one declaration per line).
+ * @param decls struct Vec<struct Decl*>&
+ */
+void
+dump_decls__AstDump(struct AstDump *self, struct Vec *decls);
+
+/**
+ *
+ * @brief Dump the declaration.
+ */
+void
+dump_decl__AstDump(struct AstDump *self, struct Decl *decl);
+
+/**
+ *
+ * @brief Dump the expression.
+ */
+void
+dump_expr__AstDump(struct AstDump *self, struct Expr *expr);
+
+/**
+ *
+ * @brief Dump the data type.
+ */
+void
+dump_data_type__AstDump(struct AstDump *self, struct DataType *data_type);
+
+/**
+ *
+ * @brief Free the AstDump type.
+ */
+void
+__free__AstDump(struct AstDump self);
+
+#endif // LILY_AST_DUMP_H
@@ -0,0 +1,2695 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/format.h>
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/option.h>
+#include <base/platform.h>
+#include <errno.h>
+#include <lang/parser/cache.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef LILY_WINDOWS_OS
+#include <direct.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+   Layout of a cache file:
+
+   +--------------------------------------+
+   | magic "LILYAST\0"          (8 bytes) |
+   | version                    (4 bytes) |
+   | reserved                   (4 bytes) |
+   | hash of the source         (8 bytes) |
+   | size of the payload        (8 bytes) |
+   | checksum of the payload    (8 bytes) |
+   +--------------------------------------+
+   | payload                              |
+   +--------------------------------------+
+
+   All integers of the header are stored in little endian. In the payload,
+   integers are stored as LEB128 (signed integers are zigzag encoded), and
+   each string is stored only once: the first occurrence is written in full,
+   the next ones are written as an index in the table of strings.
+*/
+
+#define AST_CACHE_HEADER_SIZE 40
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef struct AstCacheString
+{
+    Str s; // Str (owned)
+    Usize len;
+    UInt64 hash;
+    Usize id;
+} AstCacheString;
+
+typedef struct AstCacheWriter
+{
+    UInt8 *buffer;
+    Usize len;
+    Usize capacity;
+    struct AstCacheString *strings; // open addressing table
+    Usize strings_len;
+    Usize strings_capacity;
+    // In hash mode (see hash_decl__AstCache), the bytes are hashed instead of
+    // being written.
+    bool hash_only;
+    bool signature_only; // the body of a function is skipped
+    bool with_locations; // the locations are hashed
+    UInt64 hash;
+} AstCacheWriter;
+
+typedef struct AstCacheReader
+{
+    const UInt8 *buffer;
+    Usize size;
+    Usize pos;
+    struct Vec *strings; // struct Vec<struct String*>&
+    struct Vec *table;   // struct Vec<struct String*>*
+} AstCacheReader;
+
+static UInt64
+hash_bytes(UInt64 hash, const UInt8 *bytes, Usize len);
+
+static void
+write_byte(struct AstCacheWriter *self, UInt8 byte);
+static void
+write_bytes(struct AstCacheWriter *self, const void *bytes, Usize len);
+static void
+write_uvarint(struct AstCacheWriter *self, UInt64 value);
+static void
+write_svarint(struct AstCacheWriter *self, Int64 value);
+static void
+write_location(struct AstCacheWriter *self, struct Location loc);
+static void
+write_opt_location(struct AstCacheWriter *self, const struct Location *loc);
+static void
+write_string(struct AstCacheWriter *self, const struct String *s);
+static void
+write_opt_string(struct AstCacheWriter *self, const struct String *s);
+static void
+write_data_type(struct AstCacheWriter *self, const struct DataType *data_type);
+static void
+write_opt_data_type(struct AstCacheWriter *self,
+                    const struct DataType *data_type);
+static void
+write_data_types(struct AstCacheWriter *self, const struct Vec *data_types);
+static void
+write_data_type_with_loc(struct AstCacheWriter *self,
+                         const struct Tuple *tuple);
+static void
+write_data_types_with_loc(struct AstCacheWriter *self,
+                          const struct Vec *tuples);
+static void
+write_generics(struct AstCacheWriter *self, const struct Vec *generics);
+static void
+write_literal(struct AstCacheWriter *self, struct Literal literal);
+static void
+write_expr(struct AstCacheWriter *self, const struct Expr *expr);
+static void
+write_opt_expr(struct AstCacheWriter *self, const struct Expr *expr);
+static void
+write_exprs(struct AstCacheWriter *self, const struct Vec *exprs);
+static void
+write_if_branch(struct AstCacheWriter *self, const struct IfBranch *branch);
+static void
+write_if_cond(struct AstCacheWriter *self, const struct IfCond *if_cond);
+static void
+write_import_values(struct AstCacheWriter *self, const struct Vec *values);
+static void
+write_import_stmt(struct AstCacheWriter *self, const struct ImportStmt *import);
+static void
+write_stmt(struct AstCacheWriter *self, const struct Stmt *stmt);
+static void
+write_fun_body(struct AstCacheWriter *self, const struct Vec *body);
+static void
+write_fun_params(struct AstCacheWriter *self, const struct Vec *params);
+static void
+write_module_body(struct AstCacheWriter *self, const struct Vec *body);
+static void
+write_decl(struct AstCacheWriter *self, const struct Decl *decl);
+
+static UInt8
+read_byte(struct AstCacheReader *self);
+static void
+read_bytes(struct AstCacheReader *self, void *bytes, Usize len);
+static UInt64
+read_uvarint(struct AstCacheReader *self);
+static Int64
+read_svarint(struct AstCacheReader *self);
+static struct Location
+read_location(struct AstCacheReader *self);
+static struct Location *
+read_opt_location(struct AstCacheReader *self);
+static struct String *
+read_string(struct AstCacheReader *self);
+static struct String *
+read_opt_string(struct AstCacheReader *self);
+static struct String *
+read_owned_string(struct AstCacheReader *self);
+static struct DataType *
+read_data_type(struct AstCacheReader *self);
+static struct DataType *
+read_opt_data_type(struct AstCacheReader *self);
+static struct Vec *
+read_data_types(struct AstCacheReader *self);
+static struct Tuple *
+read_data_type_with_loc(struct AstCacheReader *self);
+static struct Vec *
+read_data_types_with_loc(struct AstCacheReader *self);
+static struct Vec *
+read_generics(struct AstCacheReader *self);
+static struct Literal
+read_literal(struct AstCacheReader *self);
+static struct Expr *
+read_expr(struct AstCacheReader *self);
+static struct Expr *
+read_opt_expr(struct AstCacheReader *self);
+static struct Vec *
+read_exprs(struct AstCacheReader *self);
+static struct IfBranch *
+read_if_branch(struct AstCacheReader *self);
+static struct IfCond *
+read_if_cond(struct AstCacheReader *self);
+static struct Vec *
+read_import_values(struct AstCacheReader *self);
+static struct ImportStmt *
+read_import_stmt(struct AstCacheReader *self);
+static struct Stmt *
+read_stmt(struct AstCacheReader *self);
+static struct Vec *
+read_fun_body(struct AstCacheReader *self);
+static struct Vec *
+read_fun_params(struct AstCacheReader *self);
+static struct Vec *
+read_module_body(struct AstCacheReader *self);
+static struct Decl *
+read_decl(struct AstCacheReader *self);
+
+static UInt64
+hash_bytes(UInt64 hash, const UInt8 *bytes, Usize len)
+{
+    for (Usize i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+UInt64
+hash__AstCache(struct String content)
+{
+    UInt64 hash = FNV_OFFSET_BASIS;
+    Usize len = len__String(content);
+
+    for (Usize i = 0; i < len; i++) {
+        hash ^= (UInt8)(UPtr)get__String(content, i);
+        hash *= FNV_PRIME;
+    }
+
+    // Mix the length, to make a collision between two sources of different
+    // size less likely.
+    return hash_bytes(hash, (const UInt8 *)&len, sizeof(Usize));
+}
+
+static inline void
+write_byte(struct AstCacheWriter *self, UInt8 byte)
+{
+    if (self->hash_only) {
+        self->hash = hash_bytes(self->hash, &byte, 1);
+        return;
+    }
+
+    if (self->len == self->capacity) {
+        self->capacity = self->capacity == 0 ? 4096 : self->capacity * 2;
+        self->buffer = realloc(self->buffer, self->capacity);
+    }
+
+    self->buffer[self->len++] = byte;
+}
+
+static void
+write_bytes(struct AstCacheWriter *self, const void *bytes, Usize len)
+{
+    if (self->hash_only) {
+        self->hash = hash_bytes(self->hash, bytes, len);
+        return;
+    }
+
+    while (self->len + len > self->capacity) {
+        self->capacity = self->capacity == 0 ? 4096 : self->capacity * 2;
+        self->buffer = realloc(self->buffer, self->capacity);
+    }
+
+    memcpy(self->buffer + self->len, bytes, len);
+    self->len += len;
+}
+
+static void
+write_uvarint(struct AstCacheWriter *self, UInt64 value)
+{
+    while (value >= 0x80) {
+        write_byte(self, (UInt8)(value | 0x80));
+        value >>= 7;
+    }
+
+    write_byte(self, (UInt8)value);
+}
+
+static inline void
+write_svarint(struct AstCacheWriter *self, Int64 value)
+{
+    write_uvarint(self, ((UInt64)value << 1) ^ (UInt64)(value >> 63));
+}
+
+static inline void
+write_bool(struct AstCacheWriter *self, bool value)
+{
+    write_byte(self, value);
+}
+
+static void
+write_location(struct AstCacheWriter *self, struct Location loc)
+{
+    // A declaration which is only moved keeps its hash.
+    if (self->hash_only && !self->with_locations)
+        return;
+
+    write_uvarint(self, loc.s_line);
+    write_uvarint(self, loc.s_col);
+    write_svarint(self, (Int64)loc.e_line - (Int64)loc.s_line);
+    write_svarint(self, (Int64)loc.e_col - (Int64)loc.s_col);
+}
+
+static void
+write_opt_location(struct AstCacheWriter *self, const struct Location *loc)
+{
+    write_bool(self, loc != NULL);
+
+    if (loc)
+        write_location(self, *loc);
+}
+
+static void
+write_string(struct AstCacheWriter *self, const struct String *s)
+{
+    Str str = to_Str__String(*s);
+    Usize len = strlen(str);
+
+    if (self->hash_only) {
+        write_uvarint(self, len);
+        write_bytes(self, str, len);
+        free(str);
+
+        return;
+    }
+
+    UInt64 hash = hash_bytes(FNV_OFFSET_BASIS, (const UInt8 *)str, len);
+
+    if ((self->strings_len + 1) * 2 > self->strings_capacity) {
+        Usize old_capacity = self->strings_capacity;
+        struct AstCacheString *old_strings = self->strings;
+
+        self->strings_capacity = old_capacity == 0 ? 256 : old_capacity * 2;
+        self->strings =
+          calloc(self->strings_capacity, sizeof(struct AstCacheString));
+
+        for (Usize i = 0; i < old_capacity; i++) {
+            if (old_strings[i].s) {
+                Usize j = old_strings[i].hash & (self->strings_capacity - 1);
+
+                while (self->strings[j].s)
+                    j = (j + 1) & (self->strings_capacity - 1);
+
+                self->strings[j] = old_strings[i];
+            }
+        }
+
+        free(old_strings);
+    }
+
+    Usize i = hash & (self->strings_capacity - 1);
+
+    while (self->strings[i].s) {
+        if (self->strings[i].hash == hash && self->strings[i].len == len &&
+            !memcmp(self->strings[i].s, str, len)) {
+            write_uvarint(self, self->strings[i].id + 1);
+            free(str);
+
+            return;
+        }
+
+        i = (i + 1) & (self->strings_capacity - 1);
+    }
+
+    self->strings[i] = (struct AstCacheString){
+        .s = str, .len = len, .hash = hash, .id = self->strings_len++
+    };
+
+    write_uvarint(self, 0);
+    write_uvarint(self, len);
+    write_bytes(self, str, len);
+}
+
+static void
+write_opt_string(struct AstCacheWriter *self, const struct String *s)
+{
+    write_bool(self, s != NULL);
+
+    if (s)
+        write_string(self, s);
+}
+
+static void
+write_data_type(struct AstCacheWriter *self, const struct DataType *data_type)
+{
+    write_uvarint(self, data_type->kind);
+
+    switch (data_type->kind) {
+        case DataTypeKindPtr:
+            write_data_type(self, data_type->value.ptr);
+            break;
+        case DataTypeKindRef:
+            write_data_type(self, data_type->value.ref);
+            break;
+        case DataTypeKindOptional:
+            write_data_type(self, data_type->value.optional);
+            break;
+        case DataTypeKindException:
+            write_data_type(self, data_type->value.exception);
+            break;
+        case DataTypeKindMut:
+            write_data_type(self, data_type->value.mut);
+            break;
+        case DataTypeKindLambda:
+            write_data_types(self, data_type->value.lambda->items[0]);
+            write_opt_data_type(self, data_type->value.lambda->items[1]);
+            break;
+        case DataTypeKindArray:
+            write_opt_data_type(self, data_type->value.array->items[0]);
+            write_bool(self, data_type->value.array->items[1] != NULL);
+
+            if (data_type->value.array->items[1])
+                write_uvarint(self,
+                              *(Usize *)data_type->value.array->items[1]);
+
+            break;
+        case DataTypeKindCustom: {
+            struct Vec *names = data_type->value.custom->items[0];
+
+            write_uvarint(self, len__Vec(*names));
+
+            for (Usize i = 0; i < len__Vec(*names); i++)
+                write_string(self, get__Vec(*names, i));
+
+            write_data_types(self, data_type->value.custom->items[1]);
+
+            break;
+        }
+        case DataTypeKindTuple:
+            write_data_types(self, data_type->value.tuple);
+            break;
+        case DataTypeKindCompilerDefined:
+            UNREACHABLE("CompilerDefined is not used in AST");
+        default:
+            break;
+    }
+}
+
+static void
+write_opt_data_type(struct AstCacheWriter *self,
+                    const struct DataType *data_type)
+{
+    write_bool(self, data_type != NULL);
+
+    if (data_type)
+        write_data_type(self, data_type);
+}
+
+// A NULL Vec is written as 0, otherwise the length is written plus one.
+static void
+write_data_types(struct AstCacheWriter *self, const struct Vec *data_types)
+{
+    if (!data_types) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*data_types) + 1);
+
+    for (Usize i = 0; i < len__Vec(*data_types); i++)
+        write_data_type(self, get__Vec(*data_types, i));
+}
+
+// struct Tuple<struct DataType*, struct Location*>*
+static void
+write_data_type_with_loc(struct AstCacheWriter *self, const struct Tuple *tuple)
+{
+    write_bool(self, tuple != NULL);
+
+    if (tuple) {
+        write_opt_data_type(self, tuple->items[0]);
+        write_opt_location(self, tuple->items[1]);
+    }
+}
+
+// struct Vec<struct Tuple<struct DataType*, struct Location*>*>*
+static void
+write_data_types_with_loc(struct AstCacheWriter *self, const struct Vec *tuples)
+{
+    if (!tuples) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*tuples) + 1);
+
+    for (Usize i = 0; i < len__Vec(*tuples); i++)
+        write_data_type_with_loc(self, get__Vec(*tuples, i));
+}
+
+static void
+write_generics(struct AstCacheWriter *self, const struct Vec *generics)
+{
+    if (!generics) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*generics) + 1);
+
+    for (Usize i = 0; i < len__Vec(*generics); i++) {
+        struct Generic *generic = get__Vec(*generics, i);
+
+        write_uvarint(self, generic->kind);
+        write_location(self, generic->loc);
+
+        switch (generic->kind) {
+            case GenericKindDataType:
+                write_string(self, generic->value.data_type);
+                break;
+            case GenericKindRestrictedDataType:
+                write_string(self,
+                             generic->value.restricted_data_type->items[0]);
+                write_data_type_with_loc(
+                  self, generic->value.restricted_data_type->items[1]);
+                break;
+        }
+    }
+}
+
+static void
+write_literal(struct AstCacheWriter *self, struct Literal literal)
+{
+    write_uvarint(self, literal.kind);
+
+    switch (literal.kind) {
+        case LiteralKindBool:
+            write_bool(self, literal.value.bool_);
+            break;
+        case LiteralKindChar:
+            write_byte(self, (UInt8)literal.value.char_);
+            break;
+        case LiteralKindBitChar:
+            write_byte(self, literal.value.bit_char);
+            break;
+        case LiteralKindInt32WithoutSuffix:
+            write_svarint(self, literal.value.int32_ws);
+            break;
+        case LiteralKindInt64WithoutSuffix:
+            write_svarint(self, literal.value.int64_ws);
+            break;
+        case LiteralKindInt128WithoutSuffix:
+            write_bytes(self, &literal.value.int128_ws, sizeof(Int128));
+            break;
+        case LiteralKindInt8:
+            write_svarint(self, literal.value.int8);
+            break;
+        case LiteralKindInt16:
+            write_svarint(self, literal.value.int16);
+            break;
+        case LiteralKindInt32:
+            write_svarint(self, literal.value.int32);
+            break;
+        case LiteralKindInt64:
+            write_svarint(self, literal.value.int64);
+            break;
+        case LiteralKindInt128:
+            write_bytes(self, &literal.value.int128, sizeof(Int128));
+            break;
+        case LiteralKindUint8:
+            write_uvarint(self, literal.value.uint8);
+            break;
+        case LiteralKindUint16:
+            write_uvarint(self, literal.value.uint16);
+            break;
+        case LiteralKindUint32:
+            write_uvarint(self, literal.value.uint32);
+            break;
+        case LiteralKindUint64:
+            write_uvarint(self, literal.value.uint64);
+            break;
+        case LiteralKindUint128:
+            write_bytes(self, &literal.value.uint128, sizeof(UInt128));
+            break;
+        case LiteralKindFloat32:
+            write_bytes(self, &literal.value.float32, sizeof(Float32));
+            break;
+        case LiteralKindFloat64:
+            write_bytes(self, &literal.value.float64, sizeof(Float64));
+            break;
+        case LiteralKindFloat:
+            write_bytes(self, &literal.value.float_, sizeof(Float64));
+            break;
+        case LiteralKindStr: {
+            Usize len = strlen(literal.value.str);
+
+            write_uvarint(self, len);
+            write_bytes(self, literal.value.str, len);
+
+            break;
+        }
+        case LiteralKindBitStr: {
+            Usize len = 0;
+
+            while (literal.value.bit_str[len])
+                len++;
+
+            write_uvarint(self, len);
+
+            for (Usize i = 0; i < len; i++)
+                write_byte(self, (UInt8)(UPtr)literal.value.bit_str[i]);
+
+            break;
+        }
+        case LiteralKindUnit:
+            break;
+    }
+}
+
+static void
+write_expr(struct AstCacheWriter *self, const struct Expr *expr)
+{
+    write_uvarint(self, expr->kind);
+    write_location(self, expr->loc);
+
+    switch (expr->kind) {
+        case ExprKindUnaryOp:
+            write_uvarint(self, expr->value.unary_op.kind);
+            write_expr(self, expr->value.unary_op.right);
+
+            if (expr->value.unary_op.kind == UnaryOpKindCustom)
+                write_string(self, expr->value.unary_op.op);
+
+            break;
+        case ExprKindBinaryOp:
+            write_uvarint(self, expr->value.binary_op.kind);
+            write_expr(self, expr->value.binary_op.left);
+            write_expr(self, expr->value.binary_op.right);
+
+            if (expr->value.binary_op.kind == BinaryOpKindCustom)
+                write_string(self, expr->value.binary_op.op);
+
+            break;
+        case ExprKindFunCall: {
+            struct Vec *params = expr->value.fun_call.params;
+
+            write_expr(self, expr->value.fun_call.id);
+            write_uvarint(self, len__Vec(*params));
+
+            for (Usize i = 0; i < len__Vec(*params); i++) {
+                struct Tuple *param = get__Vec(*params, i);
+                struct FunParamCall *param_call = param->items[0];
+
+                write_uvarint(self, param_call->kind);
+                write_expr(self, param_call->value);
+
+                if (param_call->kind == FunParamKindDefault)
+                    write_string(self, param_call->name);
+
+                write_opt_location(self, param->items[1]);
+            }
+
+            break;
+        }
+        case ExprKindRecordCall: {
+            struct Vec *fields = expr->value.record_call.fields;
+
+            write_expr(self, expr->value.record_call.id);
+            write_uvarint(self, len__Vec(*fields));
+
+            for (Usize i = 0; i < len__Vec(*fields); i++) {
+                struct Tuple *field = get__Vec(*fields, i);
+                struct FieldCall *field_call = field->items[0];
+
+                write_string(self, field_call->name);
+
+                if (is_Some__Option(field_call->value))
+                    write_opt_expr(self, get__Option(field_call->value));
+                else
+                    write_opt_expr(self, NULL);
+
+                write_opt_location(self, field->items[1]);
+            }
+
+            break;
+        }
+        case ExprKindIdentifier:
+            write_string(self, expr->value.identifier);
+            break;
+        case ExprKindIdentifierAccess:
+            write_exprs(self, expr->value.identifier_access);
+            break;
+        case ExprKindGlobalAccess:
+            write_exprs(self, expr->value.global_access);
+            break;
+        case ExprKindPropertyAccessInit:
+            write_exprs(self, expr->value.property_access_init);
+            break;
+        case ExprKindArrayAccess:
+            write_expr(self, expr->value.array_access.id);
+            write_exprs(self, expr->value.array_access.access);
+            break;
+        case ExprKindTupleAccess:
+            write_expr(self, expr->value.tuple_access.id);
+            write_exprs(self, expr->value.tuple_access.access);
+            break;
+        case ExprKindLambda:
+            write_fun_params(self, expr->value.lambda.params);
+            write_opt_data_type(self, expr->value.lambda.return_type);
+            write_fun_body(self, expr->value.lambda.body);
+            write_bool(self, expr->value.lambda.instantly_call);
+            break;
+        case ExprKindTuple:
+            write_exprs(self, expr->value.tuple);
+            break;
+        case ExprKindArray:
+            write_exprs(self, expr->value.array);
+            break;
+        case ExprKindVariant:
+            write_expr(self, expr->value.variant.id);
+            write_opt_expr(self, expr->value.variant.value);
+            break;
+        case ExprKindTry:
+            write_expr(self, expr->value.try);
+            break;
+        case ExprKindIf:
+            write_if_cond(self, expr->value.if_);
+            break;
+        case ExprKindBlock:
+            write_fun_body(self, expr->value.block);
+            break;
+        case ExprKindQuestionMark:
+            write_expr(self, expr->value.question_mark);
+            break;
+        case ExprKindDereference:
+            write_expr(self, expr->value.dereference);
+            break;
+        case ExprKindRef:
+            write_expr(self, expr->value.ref);
+            break;
+        case ExprKindLiteral:
+            write_literal(self, expr->value.literal);
+            break;
+        case ExprKindVariable:
+            write_string(self, expr->value.variable.name);
+            write_opt_data_type(self, expr->value.variable.data_type);
+            write_expr(self, expr->value.variable.expr);
+            write_bool(self, expr->value.variable.is_mut);
+            break;
+        case ExprKindGrouping:
+            write_expr(self, expr->value.grouping);
+            break;
+        case ExprKindSelf:
+        case ExprKindUndef:
+        case ExprKindNil:
+        case ExprKindNone:
+        case ExprKindWildcard:
+            break;
+    }
+}
+
+static void
+write_opt_expr(struct AstCacheWriter *self, const struct Expr *expr)
+{
+    write_bool(self, expr != NULL);
+
+    if (expr)
+        write_expr(self, expr);
+}
+
+static void
+write_exprs(struct AstCacheWriter *self, const struct Vec *exprs)
+{
+    if (!exprs) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*exprs) + 1);
+
+    for (Usize i = 0; i < len__Vec(*exprs); i++)
+        write_expr(self, get__Vec(*exprs, i));
+}
+
+static void
+write_if_branch(struct AstCacheWriter *self, const struct IfBranch *branch)
+{
+    write_expr(self, branch->cond);
+    write_fun_body(self, branch->body);
+}
+
+static void
+write_if_cond(struct AstCacheWriter *self, const struct IfCond *if_cond)
+{
+    write_if_branch(self, if_cond->if_);
+
+    if (if_cond->elif) {
+        write_uvarint(self, len__Vec(*if_cond->elif) + 1);
+
+        for (Usize i = 0; i < len__Vec(*if_cond->elif); i++)
+            write_if_branch(self, get__Vec(*if_cond->elif, i));
+    } else
+        write_uvarint(self, 0);
+
+    write_fun_body(self, if_cond->else_);
+}
+
+// struct Vec<struct ImportStmtValue*>*
+static void
+write_import_values(struct AstCacheWriter *self, const struct Vec *values)
+{
+    write_uvarint(self, len__Vec(*values));
+
+    for (Usize i = 0; i < len__Vec(*values); i++) {
+        struct ImportStmtValue *value = get__Vec(*values, i);
+
+        write_uvarint(self, value->kind);
+
+        switch (value->kind) {
+            case ImportStmtValueKindAccess:
+                write_string(self, value->value.access);
+                break;
+            case ImportStmtValueKindFile:
+                write_string(self, value->value.file);
+                break;
+            case ImportStmtValueKindUrl:
+                write_string(self, value->value.url);
+                break;
+            case ImportStmtValueKindSelector:
+                write_uvarint(self, len__Vec(*value->value.selector));
+
+                for (Usize j = 0; j < len__Vec(*value->value.selector); j++)
+                    write_import_values(
+                      self, get__Vec(*value->value.selector, j));
+
+                break;
+            case ImportStmtValueKindStd:
+            case ImportStmtValueKindCore:
+            case ImportStmtValueKindBuiltin:
+            case ImportStmtValueKindWildcard:
+                break;
+        }
+    }
+}
+
+static void
+write_import_stmt(struct AstCacheWriter *self, const struct ImportStmt *import)
+{
+    write_import_values(self, import->import_value);
+    write_bool(self, import->is_pub);
+    write_opt_string(self, import->as);
+}
+
+static void
+write_stmt(struct AstCacheWriter *self, const struct Stmt *stmt)
+{
+    write_uvarint(self, stmt->kind);
+    write_location(self, stmt->loc);
+
+    switch (stmt->kind) {
+        case StmtKindReturn:
+            write_opt_expr(self, stmt->value.return_);
+            break;
+        case StmtKindIf:
+            write_if_cond(self, stmt->value.if_);
+            break;
+        case StmtKindAwait:
+            write_expr(self, stmt->value.await);
+            break;
+        case StmtKindTry:
+            write_fun_body(self, stmt->value.try->try_body);
+            write_opt_expr(self, stmt->value.try->catch_expr);
+            write_fun_body(self, stmt->value.try->catch_body);
+            break;
+        case StmtKindMatch: {
+            struct Vec *pattern = stmt->value.match->pattern;
+
+            write_expr(self, stmt->value.match->matching);
+            write_uvarint(self, len__Vec(*pattern));
+
+            for (Usize i = 0; i < len__Vec(*pattern); i++) {
+                struct Tuple *arm = get__Vec(*pattern, i);
+
+                write_expr(self, arm->items[0]);
+                write_opt_expr(self, arm->items[1]);
+                write_expr(self, arm->items[2]);
+            }
+
+            break;
+        }
+        case StmtKindWhile:
+            write_expr(self, stmt->value.while_->cond);
+            write_fun_body(self, stmt->value.while_->body);
+            break;
+        case StmtKindFor: {
+            struct ForStmtExpr *expr = stmt->value.for_->expr;
+
+            write_uvarint(self, expr->kind);
+            write_location(self, expr->loc);
+
+            switch (expr->kind) {
+                case ForStmtExprKindRange:
+                    write_expr(self, expr->value.range->items[0]);
+                    write_expr(self, expr->value.range->items[1]);
+                    break;
+                case ForStmtExprKindTraditional:
+                    write_opt_expr(self, expr->value.traditional->var);
+                    write_opt_expr(self, expr->value.traditional->cond);
+                    write_opt_expr(self, expr->value.traditional->action);
+                    break;
+            }
+
+            write_fun_body(self, stmt->value.for_->body);
+
+            break;
+        }
+        case StmtKindImport:
+            write_import_stmt(self, stmt->value.import);
+            break;
+        case StmtKindNext:
+        case StmtKindBreak:
+            break;
+    }
+}
+
+// struct Vec<struct FunBodyItem*>*
+static void
+write_fun_body(struct AstCacheWriter *self, const struct Vec *body)
+{
+    if (!body) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*body) + 1);
+
+    for (Usize i = 0; i < len__Vec(*body); i++) {
+        struct FunBodyItem *item = get__Vec(*body, i);
+
+        write_uvarint(self, item->kind);
+
+        switch (item->kind) {
+            case FunBodyItemKindExpr:
+                write_expr(self, item->expr);
+                break;
+            case FunBodyItemKindStmt:
+                write_stmt(self, item->stmt);
+                break;
+        }
+    }
+}
+
+// struct Vec<struct FunParam*>*
+static void
+write_fun_params(struct AstCacheWriter *self, const struct Vec *params)
+{
+    if (!params) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*params) + 1);
+
+    for (Usize i = 0; i < len__Vec(*params); i++) {
+        struct FunParam *param = get__Vec(*params, i);
+
+        write_uvarint(self, param->kind);
+        write_location(self, param->loc);
+
+        if (param->kind == FunParamKindSelf)
+            continue;
+
+        write_string(self, param->name);
+        write_opt_string(self, param->super_tag.name);
+        write_data_type_with_loc(self, param->param_data_type);
+
+        if (param->kind == FunParamKindDefault)
+            write_expr(self, param->value.default_);
+    }
+}
+
+// struct Vec<struct ModuleBodyItem*>*
+static void
+write_module_body(struct AstCacheWriter *self, const struct Vec *body)
+{
+    if (!body) {
+        write_uvarint(self, 0);
+        return;
+    }
+
+    write_uvarint(self, len__Vec(*body) + 1);
+
+    for (Usize i = 0; i < len__Vec(*body); i++) {
+        struct ModuleBodyItem *item = get__Vec(*body, i);
+
+        write_uvarint(self, item->kind);
+
+        switch (item->kind) {
+            case ModuleBodyItemKindDecl:
+                write_decl(self, item->value.decl);
+                break;
+            case ModuleBodyItemKindImport:
+                write_import_stmt(self, item->value.import->items[0]);
+                write_opt_location(self, item->value.import->items[1]);
+                break;
+            default:
+                UNREACHABLE("unknown module body item kind");
+        }
+    }
+}
+
+static void
+write_decl(struct AstCacheWriter *self, const struct Decl *decl)
+{
+    write_uvarint(self, decl->kind);
+
+    // The end of a declaration can be the start of the next one, only its
+    // start is hashed.
+    if (self->hash_only && self->with_locations) {
+        write_uvarint(self, decl->loc.s_line);
+        write_uvarint(self, decl->loc.s_col);
+    } else
+        write_location(self, decl->loc);
+
+    switch (decl->kind) {
+        case DeclKindFun: {
+            struct FunDecl *fun = decl->value.fun;
+
+            write_string(self, fun->name);
+            write_data_types_with_loc(self, fun->tags);
+            write_generics(self, fun->generic_params);
+            write_fun_params(self, fun->params);
+            write_data_type_with_loc(self, fun->return_type);
+
+            if (!self->signature_only)
+                write_fun_body(self, fun->body);
+
+            write_bool(self, fun->is_pub);
+            write_bool(self, fun->is_async);
+
+            break;
+        }
+        case DeclKindConstant:
+            write_string(self, decl->value.constant->name);
+            write_opt_data_type(self, decl->value.constant->data_type);
+            write_expr(self, decl->value.constant->expr);
+            write_bool(self, decl->value.constant->is_pub);
+            break;
+        case DeclKindModule:
+            write_string(self, decl->value.module->name);
+            write_module_body(self, decl->value.module->body);
+            write_bool(self, decl->value.module->is_pub);
+            break;
+        case DeclKindAlias:
+            write_string(self, decl->value.alias->name);
+            write_generics(self, decl->value.alias->generic_params);
+            write_data_type(self, decl->value.alias->data_type);
+            write_bool(self, decl->value.alias->is_pub);
+            break;
+        case DeclKindRecord: {
+            struct RecordDecl *record = decl->value.record;
+
+            write_string(self, record->name);
+            write_generics(self, record->generic_params);
+
+            if (record->fields) {
+                write_uvarint(self, len__Vec(*record->fields) + 1);
+
+                for (Usize i = 0; i < len__Vec(*record->fields); i++) {
+                    struct FieldRecord *field = get__Vec(*record->fields, i);
+
+                    write_string(self, field->name);
+                    write_data_type(self, field->data_type);
+                    write_opt_expr(self, field->value);
+                    write_bool(self, field->is_pub);
+                    write_location(self, field->loc);
+                }
+            } else
+                write_uvarint(self, 0);
+
+            write_bool(self, record->is_pub);
+            write_bool(self, record->is_object);
+            write_bool(self, record->is_repr_c);
+
+            break;
+        }
+        case DeclKindEnum: {
+            struct EnumDecl *enum_ = decl->value.enum_;
+
+            write_string(self, enum_->name);
+            write_generics(self, enum_->generic_params);
+
+            if (enum_->variants) {
+                write_uvarint(self, len__Vec(*enum_->variants) + 1);
+
+                for (Usize i = 0; i < len__Vec(*enum_->variants); i++) {
+                    struct VariantEnum *variant =
+                      get__Vec(*enum_->variants, i);
+
+                    write_string(self, variant->name);
+                    write_opt_data_type(self, variant->data_type);
+                    write_location(self, variant->loc);
+                }
+            } else
+                write_uvarint(self, 0);
+
+            write_opt_data_type(self, enum_->type_value);
+            write_bool(self, enum_->is_pub);
+            write_bool(self, enum_->is_object);
+            write_bool(self, enum_->is_error);
+
+            break;
+        }
+        case DeclKindError:
+            write_string(self, decl->value.error->name);
+            write_generics(self, decl->value.error->generic_params);
+            write_opt_data_type(self, decl->value.error->data_type);
+            write_bool(self, decl->value.error->is_pub);
+            break;
+        case DeclKindClass: {
+            struct ClassDecl *class = decl->value.class;
+
+            write_string(self, class->name);
+            write_generics(self, class->generic_params);
+            write_data_types_with_loc(self, class->inheritance);
+            write_data_types_with_loc(self, class->impl);
+
+            if (class->body) {
+                write_uvarint(self, len__Vec(*class->body) + 1);
+
+                for (Usize i = 0; i < len__Vec(*class->body); i++) {
+                    struct ClassBodyItem *item = get__Vec(*class->body, i);
+
+                    write_uvarint(self, item->kind);
+                    write_location(self, item->loc);
+
+                    switch (item->kind) {
+                        case ClassBodyItemKindProperty:
+                            write_string(self, item->value.property->name);
+                            write_data_type(self,
+                                            item->value.property->data_type);
+                            write_bool(self, item->value.property->is_pub);
+                            break;
+                        case ClassBodyItemKindMethod: {
+                            struct MethodDecl *method = item->value.method;
+
+                            write_string(self, method->name);
+                            write_generics(self, method->generic_params);
+                            write_fun_params(self, method->params);
+                            write_opt_data_type(self, method->return_type);
+                            write_fun_body(self, method->body);
+                            write_bool(self, method->has_first_self_param);
+                            write_bool(self, method->is_async);
+                            write_bool(self, method->is_pub);
+
+                            break;
+                        }
+                        case ClassBodyItemKindImport:
+                            write_import_stmt(self, item->value.import);
+                            break;
+                    }
+                }
+            } else
+                write_uvarint(self, 0);
+
+            write_bool(self, class->is_pub);
+
+            break;
+        }
+        case DeclKindTrait: {
+            struct TraitDecl *trait = decl->value.trait;
+
+            write_string(self, trait->name);
+            write_generics(self, trait->generic_params);
+            write_data_types_with_loc(self, trait->inh);
+
+            if (trait->body) {
+                write_uvarint(self, len__Vec(*trait->body) + 1);
+
+                for (Usize i = 0; i < len__Vec(*trait->body); i++) {
+                    struct TraitBodyItem *item = get__Vec(*trait->body, i);
+
+                    write_uvarint(self, item->kind);
+                    write_location(self, item->loc);
+
+                    switch (item->kind) {
+                        case TraitBodyItemKindPrototype:
+                            write_string(self, item->value.prototype->name);
+                            write_data_types(
+                              self, item->value.prototype->params_type);
+                            write_data_type(
+                              self, item->value.prototype->return_type);
+                            write_bool(self, item->value.prototype->is_async);
+                            write_bool(
+                              self,
+                              item->value.prototype->has_first_self_param);
+                            break;
+                        case TraitBodyItemKindImport:
+                            write_import_stmt(self, item->value.import);
+                            break;
+                    }
+                }
+            } else
+                write_uvarint(self, 0);
+
+            write_bool(self, trait->is_pub);
+
+            break;
+        }
+        case DeclKindTag:
+            write_string(self, decl->value.tag->name);
+            write_generics(self, decl->value.tag->generic_params);
+            write_module_body(self, decl->value.tag->body);
+            break;
+        case DeclKindImport:
+            write_import_stmt(self, decl->value.import);
+            break;
+    }
+}
+
+static void
+write_u32_le(UInt8 *buffer, UInt32 value)
+{
+    for (Usize i = 0; i < 4; i++)
+        buffer[i] = (UInt8)(value >> (i * 8));
+}
+
+static void
+write_u64_le(UInt8 *buffer, UInt64 value)
+{
+    for (Usize i = 0; i < 8; i++)
+        buffer[i] = (UInt8)(value >> (i * 8));
+}
+
+static UInt32
+read_u32_le(const UInt8 *buffer)
+{
+    UInt32 value = 0;
+
+    for (Usize i = 0; i < 4; i++)
+        value |= (UInt32)buffer[i] << (i * 8);
+
+    return value;
+}
+
+static UInt64
+read_u64_le(const UInt8 *buffer)
+{
+    UInt64 value = 0;
+
+    for (Usize i = 0; i < 8; i++)
+        value |= (UInt64)buffer[i] << (i * 8);
+
+    return value;
+}
+
+UInt64
+hash_decl__AstCache(const struct Decl *decl, bool signature_only)
+{
+    struct AstCacheWriter writer = { .buffer = NULL,
+                                     .len = 0,
+                                     .capacity = 0,
+                                     .strings = NULL,
+                                     .strings_len = 0,
+                                     .strings_capacity = 0,
+                                     .hash_only = true,
+                                     .signature_only = signature_only,
+                                     .with_locations = false,
+                                     .hash = FNV_OFFSET_BASIS };
+
+    write_decl(&writer, decl);
+
+    return writer.hash;
+}
+
+UInt64
+hash_decl_with_locations__AstCache(const struct Decl *decl)
+{
+    struct AstCacheWriter writer = { .buffer = NULL,
+                                     .len = 0,
+                                     .capacity = 0,
+                                     .strings = NULL,
+                                     .strings_len = 0,
+                                     .strings_capacity = 0,
+                                     .hash_only = true,
+                                     .signature_only = false,
+                                     .with_locations = true,
+                                     .hash = FNV_OFFSET_BASIS };
+
+    write_decl(&writer, decl);
+
+    return writer.hash;
+}
+
+UInt8 *
+serialize__AstCache(struct Vec *decls,
+                    struct ParseBlock *parse_block,
+                    UInt64 hash,
+                    Usize *size)
+{
+    struct AstCacheWriter writer = { .buffer = NULL,
+                                     .len = 0,
+                                     .capacity = 0,
+                                     .strings = NULL,
+                                     .strings_len = 0,
+                                     .strings_capacity = 0,
+                                     .hash_only = false,
+                                     .signature_only = false,
+                                     .with_locations = true,
+                                     .hash = 0 };
+
+    // Reserve the header, it's filled when the payload is written.
+    for (Usize i = 0; i < AST_CACHE_HEADER_SIZE; i++)
+        write_byte(&writer, 0);
+
+    write_uvarint(&writer, len__Vec(*decls));
+
+    for (Usize i = 0; i < len__Vec(*decls); i++)
+        write_decl(&writer, get__Vec(*decls, i));
+
+    // The disabled warnings are used by the typecheck, and the warnings of the
+    // parse are emitted again when the declarations are loaded.
+    write_uvarint(&writer, len__Vec(*parse_block->disable_warning));
+
+    for (Usize i = 0; i < len__Vec(*parse_block->disable_warning); i++)
+        write_string(&writer, get__Vec(*parse_block->disable_warning, i));
+
+    write_uvarint(&writer, len__Vec(*parse_block->warnings));
+
+    for (Usize i = 0; i < len__Vec(*parse_block->warnings); i++) {
+        struct ParseWarning *warning = get__Vec(*parse_block->warnings, i);
+
+        write_uvarint(&writer, warning->kind);
+        write_location(&writer, warning->loc);
+        write_string(&writer, warning->detail_msg);
+    }
+
+    Usize payload_size = writer.len - AST_CACHE_HEADER_SIZE;
+
+    memcpy(writer.buffer, AST_CACHE_MAGIC, sizeof(AST_CACHE_MAGIC));
+    write_u32_le(writer.buffer + 8, AST_CACHE_VERSION);
+    write_u32_le(writer.buffer + 12, 0);
+    write_u64_le(writer.buffer + 16, hash);
+    write_u64_le(writer.buffer + 24, payload_size);
+    write_u64_le(writer.buffer + 32,
+                 hash_bytes(FNV_OFFSET_BASIS,
+                            writer.buffer + AST_CACHE_HEADER_SIZE,
+                            payload_size));
+
+    for (Usize i = 0; i < writer.strings_capacity; i++)
+        if (writer.strings[i].s)
+            free(writer.strings[i].s);
+
+    free(writer.strings);
+
+    *size = writer.len;
+
+    return writer.buffer;
+}
+
+static inline UInt8
+read_byte(struct AstCacheReader *self)
+{
+    return self->pos < self->size ? self->buffer[self->pos++] : 0;
+}
+
+static void
+read_bytes(struct AstCacheReader *self, void *bytes, Usize len)
+{
+    if (self->pos + len > self->size) {
+        memset(bytes, 0, len);
+        self->pos = self->size;
+
+        return;
+    }
+
+    memcpy(bytes, self->buffer + self->pos, len);
+    self->pos += len;
+}
+
+static UInt64
+read_uvarint(struct AstCacheReader *self)
+{
+    UInt64 value = 0;
+    Usize shift = 0;
+    UInt8 byte;
+
+    do {
+        byte = read_byte(self);
+        value |= (UInt64)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80 && shift < 64);
+
+    return value;
+}
+
+static inline Int64
+read_svarint(struct AstCacheReader *self)
+{
+    UInt64 value = read_uvarint(self);
+
+    return (Int64)(value >> 1) ^ -(Int64)(value & 1);
+}
+
+static inline bool
+read_bool(struct AstCacheReader *self)
+{
+    return read_byte(self) != 0;
+}
+
+static struct Location
+read_location(struct AstCacheReader *self)
+{
+    struct Location loc = NEW(Location);
+
+    loc.s_line = read_uvarint(self);
+    loc.s_col = read_uvarint(self);
+    loc.e_line = loc.s_line + read_svarint(self);
+    loc.e_col = loc.s_col + read_svarint(self);
+
+    return loc;
+}
+
+static struct Location *
+read_opt_location(struct AstCacheReader *self)
+{
+    if (!read_bool(self))
+        return NULL;
+
+    struct Location loc = read_location(self);
+
+    return copy__Location(&loc);
+}
+
+static struct String *
+read_string(struct AstCacheReader *self)
+{
+    UInt64 id = read_uvarint(self);
+
+    if (id > 0)
+        return id <= len__Vec(*self->table) ? get__Vec(*self->table, id - 1)
+                                            : NULL;
+
+    Usize len = read_uvarint(self);
+    Str s = malloc(len + 1);
+
+    read_bytes(self, s, len);
+    s[len] = '\0';
+
+    struct String *res = from__String(s);
+
+    free(s);
+    push__Vec(self->strings, res);
+    push__Vec(self->table, res);
+
+    return res;
+}
+
+static struct String *
+read_opt_string(struct AstCacheReader *self)
+{
+    return read_bool(self) ? read_string(self) : NULL;
+}
+
+// The returned String is not shared with the table of strings, because it's
+// owned (and freed) by the AST.
+static struct String *
+read_owned_string(struct AstCacheReader *self)
+{
+    struct String *shared = read_string(self);
+
+    if (!shared)
+        return NEW(String);
+
+    Str s = to_Str__String(*shared);
+    struct String *res = from__String(s);
+
+    free(s);
+
+    return res;
+}
+
+static struct DataType *
+read_data_type(struct AstCacheReader *self)
+{
+    enum DataTypeKind kind = read_uvarint(self);
+
+    switch (kind) {
+        case DataTypeKindPtr:
+            return NEW(DataTypePtr, read_data_type(self));
+        case DataTypeKindRef:
+            return NEW(DataTypeRef, read_data_type(self));
+        case DataTypeKindOptional:
+            return NEW(DataTypeOptional, read_data_type(self));
+        case DataTypeKindException:
+            return NEW(DataTypeException, read_data_type(self));
+        case DataTypeKindMut:
+            return NEW(DataTypeMut, read_data_type(self));
+        case DataTypeKindLambda: {
+            struct Vec *params = read_data_types(self);
+
+            return NEW(DataTypeLambda, params, read_opt_data_type(self));
+        }
+        case DataTypeKindArray: {
+            struct DataType *data_type = read_opt_data_type(self);
+            Usize *size = NULL;
+
+            if (read_bool(self)) {
+                size = malloc(sizeof(Usize));
+                *size = read_uvarint(self);
+            }
+
+            return NEW(DataTypeArray, data_type, size);
+        }
+        case DataTypeKindCustom: {
+            Usize len = read_uvarint(self);
+            struct Vec *names = NEW(Vec, sizeof(struct String));
+
+            for (Usize i = 0; i < len; i++)
+                push__Vec(names, read_string(self));
+
+            return NEW(DataTypeCustom, names, read_data_types(self));
+        }
+        case DataTypeKindTuple:
+            return NEW(DataTypeTuple, read_data_types(self));
+        default:
+            return NEW(DataType, kind);
+    }
+}
+
+static struct DataType *
+read_opt_data_type(struct AstCacheReader *self)
+{
+    return read_bool(self) ? read_data_type(self) : NULL;
+}
+
+static struct Vec *
+read_data_types(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *data_types = NEW(Vec, sizeof(struct DataType));
+
+    for (Usize i = 0; i < len; i++)
+        push__Vec(data_types, read_data_type(self));
+
+    return data_types;
+}
+
+static struct Tuple *
+read_data_type_with_loc(struct AstCacheReader *self)
+{
+    if (!read_bool(self))
+        return NULL;
+
+    struct DataType *data_type = read_opt_data_type(self);
+
+    return NEW(Tuple, 2, data_type, read_opt_location(self));
+}
+
+static struct Vec *
+read_data_types_with_loc(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *tuples = NEW(Vec, sizeof(struct Tuple));
+
+    for (Usize i = 0; i < len; i++)
+        push__Vec(tuples, read_data_type_with_loc(self));
+
+    return tuples;
+}
+
+static struct Vec *
+read_generics(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *generics = NEW(Vec, sizeof(struct Generic));
+
+    for (Usize i = 0; i < len; i++) {
+        enum GenericKind kind = read_uvarint(self);
+        struct Location loc = read_location(self);
+        struct String *name = read_string(self);
+
+        switch (kind) {
+            case GenericKindDataType:
+                push__Vec(generics, NEW(GenericDataType, name, loc));
+                break;
+            case GenericKindRestrictedDataType:
+                push__Vec(generics,
+                          NEW(GenericRestrictedDataType,
+                              name,
+                              loc,
+                              read_data_type_with_loc(self)));
+                break;
+        }
+    }
+
+    return generics;
+}
+
+static struct Literal
+read_literal(struct AstCacheReader *self)
+{
+    enum LiteralKind kind = read_uvarint(self);
+
+    switch (kind) {
+        case LiteralKindBool:
+            return NEW(LiteralBool, read_bool(self));
+        case LiteralKindChar:
+            return NEW(LiteralChar, (char)read_byte(self));
+        case LiteralKindBitChar:
+            return NEW(LiteralBitChar, read_byte(self));
+        case LiteralKindInt32WithoutSuffix:
+            return NEW(LiteralInt32WithoutSuffix, (Int32)read_svarint(self));
+        case LiteralKindInt64WithoutSuffix:
+            return NEW(LiteralInt64WithoutSuffix, read_svarint(self));
+        case LiteralKindInt128WithoutSuffix: {
+            Int128 value;
+
+            read_bytes(self, &value, sizeof(Int128));
+
+            return NEW(LiteralInt128WithoutSuffix, value);
+        }
+        case LiteralKindInt8:
+            return NEW(LiteralInt8, (Int8)read_svarint(self));
+        case LiteralKindInt16:
+            return NEW(LiteralInt16, (Int16)read_svarint(self));
+        case LiteralKindInt32:
+            return NEW(LiteralInt32, (Int32)read_svarint(self));
+        case LiteralKindInt64:
+            return NEW(LiteralInt64, read_svarint(self));
+        case LiteralKindInt128: {
+            Int128 value;
+
+            read_bytes(self, &value, sizeof(Int128));
+
+            return NEW(LiteralInt128, value);
+        }
+        case LiteralKindUint8:
+            return NEW(LiteralUint8, (UInt8)read_uvarint(self));
+        case LiteralKindUint16:
+            return NEW(LiteralUint16, (UInt16)read_uvarint(self));
+        case LiteralKindUint32:
+            return NEW(LiteralUint32, (UInt32)read_uvarint(self));
+        case LiteralKindUint64:
+            return NEW(LiteralUint64, read_uvarint(self));
+        case LiteralKindUint128: {
+            UInt128 value;
+
+            read_bytes(self, &value, sizeof(UInt128));
+
+            return NEW(LiteralUint128, value);
+        }
+        case LiteralKindFloat32: {
+            Float32 value;
+
+            read_bytes(self, &value, sizeof(Float32));
+
+            return NEW(LiteralFloat32, value);
+        }
+        case LiteralKindFloat64: {
+            Float64 value;
+
+            read_bytes(self, &value, sizeof(Float64));
+
+            return NEW(LiteralFloat64, value);
+        }
+        case LiteralKindFloat: {
+            Float64 value;
+
+            read_bytes(self, &value, sizeof(Float64));
+
+            return NEW(LiteralFloat, value);
+        }
+        case LiteralKindStr: {
+            Usize len = read_uvarint(self);
+            Str str = malloc(len + 1);
+
+            read_bytes(self, str, len);
+            str[len] = '\0';
+
+            return NEW(LiteralStr, str);
+        }
+        case LiteralKindBitStr: {
+            Usize len = read_uvarint(self);
+            UInt8 **bit_str = malloc(sizeof(UInt8 *) * (len + 1));
+
+            for (Usize i = 0; i < len; i++)
+                bit_str[i] = (UInt8 *)(UPtr)read_byte(self);
+
+            bit_str[len] = NULL;
+
+            return NEW(LiteralBitStr, bit_str);
+        }
+        default:
+            return NEW(LiteralUnit);
+    }
+}
+
+static struct Expr *
+read_expr(struct AstCacheReader *self)
+{
+    enum ExprKind kind = read_uvarint(self);
+    struct Location loc = read_location(self);
+
+    switch (kind) {
+        case ExprKindUnaryOp: {
+            enum UnaryOpKind op_kind = read_uvarint(self);
+            struct Expr *right = read_expr(self);
+            struct String *op =
+              op_kind == UnaryOpKindCustom ? read_owned_string(self) : NULL;
+
+            return NEW(ExprUnaryOp, NEW(UnaryOp, op_kind, right, op), loc);
+        }
+        case ExprKindBinaryOp: {
+            enum BinaryOpKind op_kind = read_uvarint(self);
+            struct Expr *left = read_expr(self);
+            struct Expr *right = read_expr(self);
+            struct String *op =
+              op_kind == BinaryOpKindCustom ? read_owned_string(self) : NULL;
+
+            return NEW(
+              ExprBinaryOp, NEW(BinaryOp, op_kind, left, right, op), loc);
+        }
+        case ExprKindFunCall: {
+            struct Expr *id = read_expr(self);
+            Usize len = read_uvarint(self);
+            struct Vec *params = NEW(Vec, sizeof(struct Tuple));
+
+            for (Usize i = 0; i < len; i++) {
+                enum FunParamKind param_kind = read_uvarint(self);
+                struct Expr *value = read_expr(self);
+                struct FunParamCall *param_call =
+                  param_kind == FunParamKindDefault
+                    ? NEW(FunParamCallDefault, value, read_string(self))
+                    : NEW(FunParamCall, value);
+
+                push__Vec(params,
+                          NEW(Tuple, 2, param_call, read_opt_location(self)));
+            }
+
+            return NEW(ExprFunCall, NEW(FunCall, id, params), loc);
+        }
+        case ExprKindRecordCall: {
+            struct Expr *id = read_expr(self);
+            Usize len = read_uvarint(self);
+            struct Vec *fields = NEW(Vec, sizeof(struct Tuple));
+
+            for (Usize i = 0; i < len; i++) {
+                struct String *name = read_string(self);
+                struct Expr *value = read_opt_expr(self);
+                struct FieldCall *field_call =
+                  NEW(FieldCall, name, value ? Some(value) : None());
+
+                push__Vec(fields,
+                          NEW(Tuple, 2, field_call, read_opt_location(self)));
+            }
+
+            return NEW(ExprRecordCall, NEW(RecordCall, id, fields), loc);
+        }
+        case ExprKindIdentifier:
+            return NEW(ExprIdentifier, read_string(self), loc);
+        case ExprKindIdentifierAccess:
+            return NEW(ExprIdentifierAccess, read_exprs(self), loc);
+        case ExprKindGlobalAccess:
+            return NEW(ExprGlobalAccess, read_exprs(self), loc);
+        case ExprKindPropertyAccessInit:
+            return NEW(ExprPropertyAccessInit, read_exprs(self), loc);
+        case ExprKindArrayAccess: {
+            struct Expr *id = read_expr(self);
+
+            return NEW(
+              ExprArrayAccess, NEW(ArrayAccess, id, read_exprs(self)), loc);
+        }
+        case ExprKindTupleAccess: {
+            struct Expr *id = read_expr(self);
+
+            return NEW(
+              ExprTupleAccess, NEW(TupleAccess, id, read_exprs(self)), loc);
+        }
+        case ExprKindLambda: {
+            struct Vec *params = read_fun_params(self);
+            struct DataType *return_type = read_opt_data_type(self);
+            struct Vec *body = read_fun_body(self);
+
+            return NEW(
+              ExprLambda,
+              NEW(Lambda, params, return_type, body, read_bool(self)),
+              loc);
+        }
+        case ExprKindTuple:
+            return NEW(ExprTuple, read_exprs(self), loc);
+        case ExprKindArray:
+            return NEW(ExprArray, read_exprs(self), loc);
+        case ExprKindVariant: {
+            struct Expr *id = read_expr(self);
+
+            return NEW(
+              ExprVariant, NEW(Variant, id, read_opt_expr(self)), loc);
+        }
+        case ExprKindTry:
+            return NEW(ExprTry, read_expr(self), loc);
+        case ExprKindIf:
+            return NEW(ExprIf, read_if_cond(self), loc);
+        case ExprKindBlock:
+            return NEW(ExprBlock, read_fun_body(self), loc);
+        case ExprKindQuestionMark:
+            return NEW(ExprQuestionMark, read_expr(self), loc);
+        case ExprKindDereference:
+            return NEW(ExprDereference, read_expr(self), loc);
+        case ExprKindRef:
+            return NEW(ExprRef, read_expr(self), loc);
+        case ExprKindLiteral:
+            return NEW(ExprLiteral, read_literal(self), loc);
+        case ExprKindVariable: {
+            struct String *name = read_string(self);
+            struct DataType *data_type = read_opt_data_type(self);
+            struct Expr *expr = read_expr(self);
+
+            return NEW(
+              ExprVariable,
+              NEW(VariableDecl, name, data_type, expr, read_bool(self)),
+              loc);
+        }
+        case ExprKindGrouping:
+            return NEW(ExprGrouping, read_expr(self), loc);
+        default:
+            return NEW(Expr, kind, loc);
+    }
+}
+
+static struct Expr *
+read_opt_expr(struct AstCacheReader *self)
+{
+    return read_bool(self) ? read_expr(self) : NULL;
+}
+
+static struct Vec *
+read_exprs(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *exprs = NEW(Vec, sizeof(struct Expr));
+
+    for (Usize i = 0; i < len; i++)
+        push__Vec(exprs, read_expr(self));
+
+    return exprs;
+}
+
+static struct IfBranch *
+read_if_branch(struct AstCacheReader *self)
+{
+    struct Expr *cond = read_expr(self);
+
+    return NEW(IfBranch, cond, read_fun_body(self));
+}
+
+static struct IfCond *
+read_if_cond(struct AstCacheReader *self)
+{
+    struct IfBranch *if_ = read_if_branch(self);
+    struct Vec *elif = NULL;
+    Usize len = read_uvarint(self);
+
+    if (len-- > 0) {
+        elif = NEW(Vec, sizeof(struct IfBranch));
+
+        for (Usize i = 0; i < len; i++)
+            push__Vec(elif, read_if_branch(self));
+    }
+
+    return NEW(IfCond, if_, elif, read_fun_body(self));
+}
+
+static struct Vec *
+read_import_values(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+    struct Vec *values = NEW(Vec, sizeof(struct ImportStmtValue));
+
+    for (Usize i = 0; i < len; i++) {
+        enum ImportStmtValueKind kind = read_uvarint(self);
+
+        switch (kind) {
+            case ImportStmtValueKindAccess:
+                push__Vec(values,
+                          NEW(ImportStmtValueAccess, read_owned_string(self)));
+                break;
+            case ImportStmtValueKindFile:
+                push__Vec(values,
+                          NEW(ImportStmtValueFile, read_owned_string(self)));
+                break;
+            case ImportStmtValueKindUrl:
+                push__Vec(values,
+                          NEW(ImportStmtValueUrl, read_owned_string(self)));
+                break;
+            case ImportStmtValueKindSelector: {
+                Usize selector_len = read_uvarint(self);
+                struct Vec *selector = NEW(Vec, sizeof(struct Vec));
+
+                for (Usize j = 0; j < selector_len; j++)
+                    push__Vec(selector, read_import_values(self));
+
+                push__Vec(values, NEW(ImportStmtValueSelector, selector));
+
+                break;
+            }
+            case ImportStmtValueKindStd:
+                push__Vec(values, NEW(ImportStmtValueStd));
+                break;
+            case ImportStmtValueKindCore:
+                push__Vec(values, NEW(ImportStmtValueCore));
+                break;
+            case ImportStmtValueKindBuiltin:
+                push__Vec(values, NEW(ImportStmtValueBuiltin));
+                break;
+            case ImportStmtValueKindWildcard:
+                push__Vec(values, NEW(ImportStmtValueWildcard));
+                break;
+        }
+    }
+
+    return values;
+}
+
+static struct ImportStmt *
+read_import_stmt(struct AstCacheReader *self)
+{
+    struct Vec *import_value = read_import_values(self);
+    bool is_pub = read_bool(self);
+
+    return NEW(ImportStmt, import_value, is_pub, read_opt_string(self));
+}
+
+static struct Stmt *
+read_stmt(struct AstCacheReader *self)
+{
+    enum StmtKind kind = read_uvarint(self);
+    struct Location loc = read_location(self);
+
+    switch (kind) {
+        case StmtKindReturn:
+            return NEW(StmtReturn, loc, read_opt_expr(self));
+        case StmtKindIf:
+            return NEW(StmtIf, loc, read_if_cond(self));
+        case StmtKindAwait:
+            return NEW(StmtAwait, loc, read_expr(self));
+        case StmtKindTry: {
+            struct Vec *try_body = read_fun_body(self);
+            struct Expr *catch_expr = read_opt_expr(self);
+
+            return NEW(
+              StmtTry,
+              loc,
+              NEW(TryStmt, try_body, catch_expr, read_fun_body(self)));
+        }
+        case StmtKindMatch: {
+            struct Expr *matching = read_expr(self);
+            Usize len = read_uvarint(self);
+            struct Vec *pattern = NEW(Vec, sizeof(struct Tuple));
+
+            for (Usize i = 0; i < len; i++) {
+                struct Expr *arm_pattern = read_expr(self);
+                struct Expr *cond = read_opt_expr(self);
+
+                push__Vec(pattern,
+                          NEW(Tuple, 3, arm_pattern, cond, read_expr(self)));
+            }
+
+            return NEW(StmtMatch, loc, NEW(MatchStmt, matching, pattern));
+        }
+        case StmtKindWhile: {
+            struct Expr *cond = read_expr(self);
+
+            return NEW(
+              StmtWhile, loc, NEW(WhileStmt, cond, read_fun_body(self)));
+        }
+        case StmtKindFor: {
+            enum ForStmtExprKind expr_kind = read_uvarint(self);
+            struct Location expr_loc = read_location(self);
+            struct ForStmtExpr *expr = NULL;
+
+            switch (expr_kind) {
+                case ForStmtExprKindRange: {
+                    struct Expr *start = read_expr(self);
+
+                    expr = NEW(ForStmtExprRange,
+                               NEW(Tuple, 2, start, read_expr(self)),
+                               expr_loc);
+
+                    break;
+                }
+                case ForStmtExprKindTraditional: {
+                    struct Expr *var = read_opt_expr(self);
+                    struct Expr *cond = read_opt_expr(self);
+
+                    expr = NEW(ForStmtExprTraditionalVar,
+                               NEW(ForStmtExprTraditional,
+                                   var,
+                                   cond,
+                                   read_opt_expr(self)),
+                               expr_loc);
+
+                    break;
+                }
+            }
+
+            return NEW(StmtFor, loc, NEW(ForStmt, expr, read_fun_body(self)));
+        }
+        case StmtKindImport:
+            return NEW(StmtImport, loc, read_import_stmt(self));
+        default:
+            return NEW(Stmt, kind, loc);
+    }
+}
+
+static struct Vec *
+read_fun_body(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *body = NEW(Vec, sizeof(struct FunBodyItem));
+
+    for (Usize i = 0; i < len; i++) {
+        switch ((enum FunBodyItemKind)read_uvarint(self)) {
+            case FunBodyItemKindExpr:
+                push__Vec(body, NEW(FunBodyItemExpr, read_expr(self)));
+                break;
+            case FunBodyItemKindStmt:
+                push__Vec(body, NEW(FunBodyItemStmt, read_stmt(self)));
+                break;
+        }
+    }
+
+    return body;
+}
+
+static struct Vec *
+read_fun_params(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *params = NEW(Vec, sizeof(struct FunParam));
+
+    for (Usize i = 0; i < len; i++) {
+        enum FunParamKind kind = read_uvarint(self);
+        struct Location loc = read_location(self);
+
+        if (kind == FunParamKindSelf) {
+            push__Vec(params, NEW(FunParamSelf, loc));
+            continue;
+        }
+
+        struct String *name = read_string(self);
+        struct String *super_tag_name = read_opt_string(self);
+        struct Tuple *param_data_type = read_data_type_with_loc(self);
+
+        if (kind == FunParamKindDefault)
+            push__Vec(params,
+                      NEW(FunParamDefault,
+                          name,
+                          super_tag_name,
+                          param_data_type,
+                          loc,
+                          read_expr(self)));
+        else
+            push__Vec(
+              params,
+              NEW(FunParamNormal, name, super_tag_name, param_data_type, loc));
+    }
+
+    return params;
+}
+
+static struct Vec *
+read_module_body(struct AstCacheReader *self)
+{
+    Usize len = read_uvarint(self);
+
+    if (len-- == 0)
+        return NULL;
+
+    struct Vec *body = NEW(Vec, sizeof(struct ModuleBodyItem));
+
+    for (Usize i = 0; i < len; i++) {
+        switch ((enum ModuleBodyItemKind)read_uvarint(self)) {
+            case ModuleBodyItemKindDecl:
+                push__Vec(body, NEW(ModuleBodyItemDecl, read_decl(self)));
+                break;
+            case ModuleBodyItemKindImport: {
+                struct ImportStmt *import = read_import_stmt(self);
+
+                push__Vec(
+                  body,
+                  NEW(ModuleBodyItemImport,
+                      NEW(Tuple, 2, import, read_opt_location(self))));
+
+                break;
+            }
+            default:
+                UNREACHABLE("unknown module body item kind");
+        }
+    }
+
+    return body;
+}
+
+static struct Decl *
+read_decl(struct AstCacheReader *self)
+{
+    enum DeclKind kind = read_uvarint(self);
+    struct Location loc = read_location(self);
+
+    switch (kind) {
+        case DeclKindFun: {
+            struct String *name = read_string(self);
+            struct Vec *tags = read_data_types_with_loc(self);
+            struct Vec *generic_params = read_generics(self);
+            struct Vec *params = read_fun_params(self);
+            struct Tuple *return_type = read_data_type_with_loc(self);
+            struct Vec *body = read_fun_body(self);
+            bool is_pub = read_bool(self);
+
+            return NEW(DeclFun,
+                       loc,
+                       NEW(FunDecl,
+                           name,
+                           tags,
+                           generic_params,
+                           params,
+                           return_type,
+                           body,
+                           is_pub,
+                           read_bool(self)));
+        }
+        case DeclKindConstant: {
+            struct String *name = read_string(self);
+            struct DataType *data_type = read_opt_data_type(self);
+            struct Expr *expr = read_expr(self);
+
+            return NEW(
+              DeclConstant,
+              loc,
+              NEW(ConstantDecl, name, data_type, expr, read_bool(self)));
+        }
+        case DeclKindModule: {
+            struct String *name = read_string(self);
+            struct Vec *body = read_module_body(self);
+
+            return NEW(
+              DeclModule, loc, NEW(ModuleDecl, name, body, read_bool(self)));
+        }
+        case DeclKindAlias: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct DataType *data_type = read_data_type(self);
+
+            return NEW(
+              DeclAlias,
+              loc,
+              NEW(AliasDecl, name, generic_params, data_type, read_bool(self)));
+        }
+        case DeclKindRecord: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct Vec *fields = NULL;
+            Usize len = read_uvarint(self);
+
+            if (len-- > 0) {
+                fields = NEW(Vec, sizeof(struct FieldRecord));
+
+                for (Usize i = 0; i < len; i++) {
+                    struct String *field_name = read_string(self);
+                    struct DataType *data_type = read_data_type(self);
+                    struct Expr *value = read_opt_expr(self);
+                    bool is_pub = read_bool(self);
+
+                    push__Vec(fields,
+                              NEW(FieldRecord,
+                                  field_name,
+                                  data_type,
+                                  value,
+                                  is_pub,
+                                  read_location(self)));
+                }
+            }
+
+            bool is_pub = read_bool(self);
+            bool is_object = read_bool(self);
+
+            return NEW(DeclRecord,
+                       loc,
+                       NEW(RecordDecl,
+                           name,
+                           generic_params,
+                           fields,
+                           is_pub,
+                           is_object,
+                           read_bool(self)));
+        }
+        case DeclKindEnum: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct Vec *variants = NULL;
+            Usize len = read_uvarint(self);
+
+            if (len-- > 0) {
+                variants = NEW(Vec, sizeof(struct VariantEnum));
+
+                for (Usize i = 0; i < len; i++) {
+                    struct String *variant_name = read_string(self);
+                    struct DataType *data_type = read_opt_data_type(self);
+
+                    push__Vec(variants,
+                              NEW(VariantEnum,
+                                  variant_name,
+                                  data_type,
+                                  read_location(self)));
+                }
+            }
+
+            struct DataType *type_value = read_opt_data_type(self);
+            bool is_pub = read_bool(self);
+            bool is_object = read_bool(self);
+
+            return NEW(DeclEnum,
+                       loc,
+                       NEW(EnumDecl,
+                           name,
+                           generic_params,
+                           variants,
+                           type_value,
+                           is_pub,
+                           is_object,
+                           read_bool(self)));
+        }
+        case DeclKindError: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct DataType *data_type = read_opt_data_type(self);
+
+            return NEW(
+              DeclError,
+              loc,
+              NEW(ErrorDecl, name, generic_params, data_type, read_bool(self)));
+        }
+        case DeclKindClass: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct Vec *inheritance = read_data_types_with_loc(self);
+            struct Vec *impl = read_data_types_with_loc(self);
+            struct Vec *body = NULL;
+            Usize len = read_uvarint(self);
+
+            if (len-- > 0) {
+                body = NEW(Vec, sizeof(struct ClassBodyItem));
+
+                for (Usize i = 0; i < len; i++) {
+                    enum ClassBodyItemKind item_kind = read_uvarint(self);
+                    struct Location item_loc = read_location(self);
+
+                    switch (item_kind) {
+                        case ClassBodyItemKindProperty: {
+                            struct String *property_name = read_string(self);
+                            struct DataType *data_type = read_data_type(self);
+
+                            push__Vec(body,
+                                      NEW(ClassBodyItemProperty,
+                                          NEW(PropertyDecl,
+                                              property_name,
+                                              data_type,
+                                              read_bool(self)),
+                                          item_loc));
+
+                            break;
+                        }
+                        case ClassBodyItemKindMethod: {
+                            struct String *method_name = read_string(self);
+                            struct Vec *method_generic_params =
+                              read_generics(self);
+                            struct Vec *params = read_fun_params(self);
+                            struct DataType *return_type =
+                              read_opt_data_type(self);
+                            struct Vec *method_body = read_fun_body(self);
+                            bool has_first_self_param = read_bool(self);
+                            bool is_async = read_bool(self);
+
+                            push__Vec(body,
+                                      NEW(ClassBodyItemMethod,
+                                          NEW(MethodDecl,
+                                              method_name,
+                                              method_generic_params,
+                                              params,
+                                              return_type,
+                                              method_body,
+                                              has_first_self_param,
+                                              is_async,
+                                              read_bool(self)),
+                                          item_loc));
+
+                            break;
+                        }
+                        case ClassBodyItemKindImport:
+                            push__Vec(body,
+                                      NEW(ClassBodyItemImport,
+                                          read_import_stmt(self),
+                                          item_loc));
+                            break;
+                    }
+                }
+            }
+
+            return NEW(DeclClass,
+                       loc,
+                       NEW(ClassDecl,
+                           name,
+                           generic_params,
+                           inheritance,
+                           impl,
+                           body,
+                           read_bool(self)));
+        }
+        case DeclKindTrait: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+            struct Vec *inh = read_data_types_with_loc(self);
+            struct Vec *body = NULL;
+            Usize len = read_uvarint(self);
+
+            if (len-- > 0) {
+                body = NEW(Vec, sizeof(struct TraitBodyItem));
+
+                for (Usize i = 0; i < len; i++) {
+                    enum TraitBodyItemKind item_kind = read_uvarint(self);
+                    struct Location item_loc = read_location(self);
+
+                    switch (item_kind) {
+                        case TraitBodyItemKindPrototype: {
+                            struct String *prototype_name = read_string(self);
+                            struct Vec *params_type = read_data_types(self);
+                            struct DataType *return_type = read_data_type(self);
+                            bool is_async = read_bool(self);
+
+                            push__Vec(body,
+                                      NEW(TraitBodyItemPrototype,
+                                          item_loc,
+                                          NEW(Prototype,
+                                              prototype_name,
+                                              params_type,
+                                              return_type,
+                                              is_async,
+                                              read_bool(self))));
+
+                            break;
+                        }
+                        case TraitBodyItemKindImport:
+                            push__Vec(body,
+                                      NEW(TraitBodyItemImport,
+                                          item_loc,
+                                          read_import_stmt(self)));
+                            break;
+                    }
+                }
+            }
+
+            return NEW(
+              DeclTrait,
+              loc,
+              NEW(TraitDecl, name, generic_params, inh, body, read_bool(self)));
+        }
+        case DeclKindTag: {
+            struct String *name = read_string(self);
+            struct Vec *generic_params = read_generics(self);
+
+            return NEW(
+              DeclTag,
+              loc,
+              NEW(TagDecl, name, generic_params, read_module_body(self)));
+        }
+        case DeclKindImport:
+            return NEW(DeclImport, loc, read_import_stmt(self));
+        default:
+            UNREACHABLE("unknown decl kind");
+    }
+}
+
+struct Vec *
+deserialize__AstCache(const UInt8 *buffer,
+                      Usize size,
+                      UInt64 hash,
+                      struct Vec *strings,
+                      struct ParseBlock *parse_block)
+{
+    if (size < AST_CACHE_HEADER_SIZE ||
+        memcmp(buffer, AST_CACHE_MAGIC, sizeof(AST_CACHE_MAGIC)) ||
+        read_u32_le(buffer + 8) != AST_CACHE_VERSION ||
+        read_u64_le(buffer + 16) != hash ||
+        read_u64_le(buffer + 24) != size - AST_CACHE_HEADER_SIZE ||
+        read_u64_le(buffer + 32) !=
+          hash_bytes(FNV_OFFSET_BASIS,
+                     buffer + AST_CACHE_HEADER_SIZE,
+                     size - AST_CACHE_HEADER_SIZE))
+        return NULL;
+
+    struct AstCacheReader reader = { .buffer = buffer,
+                                     .size = size,
+                                     .pos = AST_CACHE_HEADER_SIZE,
+                                     .strings = strings,
+                                     .table = NEW(Vec, sizeof(struct String)) };
+    Usize len = read_uvarint(&reader);
+    struct Vec *decls = NEW(Vec, sizeof(struct Decl));
+
+    for (Usize i = 0; i < len; i++)
+        push__Vec(decls, read_decl(&reader));
+
+    if (parse_block) {
+        Usize disable_warning_len = read_uvarint(&reader);
+
+        for (Usize i = 0; i < disable_warning_len; i++)
+            push__Vec(parse_block->disable_warning, read_string(&reader));
+
+        Usize warnings_len = read_uvarint(&reader);
+
+        for (Usize i = 0; i < warnings_len; i++) {
+            enum LilyWarningKind kind = read_uvarint(&reader);
+            struct Location loc = read_location(&reader);
+
+            push__Vec(
+              parse_block->warnings,
+              NEW(ParseWarning, kind, loc, read_owned_string(&reader)));
+        }
+    }
+
+    FREE(Vec, reader.table);
+
+    return decls;
+}
+
+Str
+get_dir__AstCache()
+{
+    Str dir = getenv("LILY_CACHE_DIR");
+
+    if (!dir || !dir[0])
+        dir = AST_CACHE_DEFAULT_DIR;
+
+    Str res = malloc(strlen(dir) + 1);
+
+    strcpy(res, dir);
+
+    return res;
+}
+
+// Create the directory and all its parents (like mkdir -p).
+static bool
+create_dir_all(Str dir)
+{
+    Usize len = strlen(dir);
+    Str path = malloc(len + 1);
+    bool res = true;
+
+    strcpy(path, dir);
+
+    for (Usize i = 1; i <= len; i++) {
+        if (path[i] == '/' || path[i] == '\\' || path[i] == '\0') {
+            char c = path[i];
+
+            path[i] = '\0';
+
+#ifdef LILY_WINDOWS_OS
+            if (_mkdir(path) && errno != EEXIST)
+#else
+            if (mkdir(path, 0755) && errno != EEXIST)
+#endif
+                res = false;
+
+            path[i] = c;
+        }
+    }
+
+    free(path);
+
+    return res;
+}
+
+static Str
+get_path(Str dir, UInt64 hash)
+{
+    Usize size =
+      snprintf(NULL, 0, "%s/%016llx.ast", dir, (unsigned long long)hash) + 1;
+    Str path = malloc(size);
+
+    snprintf(path, size, "%s/%016llx.ast", dir, (unsigned long long)hash);
+
+    return path;
+}
+
+struct Vec *
+load__AstCache(Str dir,
+               struct String content,
+               struct Vec *strings,
+               struct ParseBlock *parse_block)
+{
+    UInt64 hash = hash__AstCache(content);
+    Str path = get_path(dir, hash);
+    FILE *file = fopen(path, "rb");
+
+    free(path);
+
+    if (!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+
+    long size = ftell(file);
+
+    fseek(file, 0, SEEK_SET);
+
+    if (size <= 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    UInt8 *buffer = malloc(size);
+    struct Vec *decls = NULL;
+
+    if (fread(buffer, 1, size, file) == (Usize)size)
+        decls =
+          deserialize__AstCache(buffer, size, hash, strings, parse_block);
+
+    fclose(file);
+    free(buffer);
+
+    return decls;
+}
+
+bool
+store__AstCache(Str dir,
+                struct String content,
+                struct Vec *decls,
+                struct ParseBlock *parse_block)
+{
+    if (!create_dir_all(dir))
+        return false;
+
+    UInt64 hash = hash__AstCache(content);
+    Usize size = 0;
+    UInt8 *buffer = serialize__AstCache(decls, parse_block, hash, &size);
+    Str path = get_path(dir, hash);
+
+    // Write in a temporary file and then rename it, so that a concurrent
+    // compilation never reads a partially written file. The counter makes
+    // the name unique between the threads of the compilation (two imported
+    // modules can have the same content).
+    static _Atomic Usize tmp_count = 0;
+#ifdef LILY_WINDOWS_OS
+    int pid = _getpid();
+#else
+    int pid = getpid();
+#endif
+    Usize tmp_id = atomic_fetch_add(&tmp_count, 1);
+    Usize tmp_size =
+      snprintf(NULL, 0, "%s.%d.%zu.tmp", path, pid, (size_t)tmp_id) + 1;
+    Str tmp_path = malloc(tmp_size);
+
+    snprintf(tmp_path, tmp_size, "%s.%d.%zu.tmp", path, pid, (size_t)tmp_id);
+
+    FILE *file = fopen(tmp_path, "wb");
+    bool res = false;
+
+    if (file) {
+        res = fwrite(buffer, 1, size, file) == size;
+        res = !fclose(file) && res;
+
+        if (res)
+            res = !rename(tmp_path, path);
+
+        if (!res)
+            remove(tmp_path);
+    }
+
+    free(buffer);
+    free(path);
+    free(tmp_path);
+
+    return res;
+}
+
+struct Parser
+__new__ParserFromCache(struct Source *src)
+{
+    Str dir = getenv("LILY_NO_CACHE") ? NULL : get_dir__AstCache();
+
+    if (dir) {
+        struct ParseBlock parse_block = {
+            .current = NULL,
+            .disable_warning = NEW(Vec, sizeof(struct String)),
+            .warnings = NEW(Vec, sizeof(struct ParseWarning)),
+            .pos = 0
+        };
+        struct Vec *strings = NEW(Vec, sizeof(struct String));
+        struct Vec *decls =
+          load__AstCache(dir, *src->file.content, strings, &parse_block);
+
+        if (decls) {
+            // The source is not scanned: the ParseBlock has no token and no
+            // block, so running the ParseBlock or the Parser again is a no-op.
+            parse_block.scanner = NEW(Scanner, src);
+            parse_block.blocks = NEW(Vec, sizeof(struct ParseContext *));
+
+            for (Usize i = 0; i < len__Vec(*parse_block.warnings); i++) {
+                struct ParseWarning *warning =
+                  get__Vec(*parse_block.warnings, i);
+
+                emit__Diagnostic(NEW(DiagnosticWithWarn,
+                                     NEW(LilyWarning, warning->kind),
+                                     warning->loc,
+                                     src->file,
+                                     format("{S}", warning->detail_msg),
+                                     None()));
+            }
+
+            struct Parser self = { .parse_block = parse_block,
+                                   .pos = 0,
+                                   .current = NULL,
+                                   .decls = decls,
+                                   .strings = strings };
+
+            free(dir);
+
+            return self;
+        }
+
+        FREE(Vec, parse_block.disable_warning);
+        FREE(Vec, parse_block.warnings);
+        FREE(Vec, strings);
+    }
+
+    free(dir);
+
+    return NEW(Parser, NEW(ParseBlock, NEW(Scanner, src)));
+}
+
+void
+run__ParserWithCache(struct Parser *self)
+{
+    // The declarations loaded from the cache own their strings.
+    if (self->strings)
+        return;
+
+    run__Parser(self);
+
+    Str dir = getenv("LILY_NO_CACHE") ? NULL : get_dir__AstCache();
+
+    if (dir) {
+        store__AstCache(dir,
+                        *self->parse_block.scanner.src->file.content,
+                        self->decls,
+                        &self->parse_block);
+        free(dir);
+    }
+}
+
+struct Parser
+__new__ParserWithCache(struct Source *src)
+{
+    struct Parser self = NEW(ParserFromCache, src);
+
+    run__ParserWithCache(&self);
+
+    return self;
+}
@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CACHE_H
+#define LILY_CACHE_H
+
+#include <base/types.h>
+#include <lang/parser/parser.h>
+
+// Bump this value each time the layout of the AST (or of the cache file)
+// changes, all the cache files written by another version are ignored.
+#define AST_CACHE_VERSION 5
+
+#define AST_CACHE_MAGIC "LILYAST"
+
+// The directory can be overridden by the LILY_CACHE_DIR environment
+// variable. Set LILY_NO_CACHE to disable the cache.
+#define AST_CACHE_DEFAULT_DIR ".lily/cache"
+
+/**
+ *
+ * @brief Hash the content of the source file (FNV-1a 64 bits).
+ */
+UInt64
+hash__AstCache(struct String content);
+
+/**
+ *
+ * @brief Hash the fields of the declaration, without its locations (a moved
+ * declaration keeps its hash) and without the body of a function if
+ * signature_only is true.
+ */
+UInt64
+hash_decl__AstCache(const struct Decl *decl, bool signature_only);
+
+/**
+ *
+ * @brief Hash the fields of the declaration with their locations (the hash of
+ * a moved declaration changes).
+ */
+UInt64
+hash_decl_with_locations__AstCache(const struct Decl *decl);
+
+/**
+ *
+ * @brief Serialize the declarations in a compact binary buffer (header +
+ * payload).
+ * @param decls struct Vec<struct Decl*>&
+ * @param parse_block Its disabled warnings and its warnings are serialized
+ * after the declarations.
+ * @param size Size of the returned buffer.
+ * @return UInt8* (owned)
+ */
+UInt8 *
+serialize__AstCache(struct Vec *decls,
+                    struct ParseBlock *parse_block,
+                    UInt64 hash,
+                    Usize *size);
+
+/**
+ *
+ * @brief Deserialize the declarations written by serialize__AstCache.
+ * @param strings struct Vec<struct String*>&: receive all names of the AST
+ * (the AST only borrows its names).
+ * @param parse_block Receive the disabled warnings and the warnings (can be
+ * NULL).
+ * @return struct Vec<struct Decl*>* or NULL if the version, the hash or the
+ * checksum of the buffer doesn't match.
+ */
+struct Vec *
+deserialize__AstCache(const UInt8 *buffer,
+                      Usize size,
+                      UInt64 hash,
+                      struct Vec *strings,
+                      struct ParseBlock *parse_block);
+
+/**
+ *
+ * @brief Get the path of the cache directory.
+ * @return Str (owned)
+ */
+Str
+get_dir__AstCache();
+
+/**
+ *
+ * @brief Load the declarations of the source from the cache directory.
+ * @return struct Vec<struct Decl*>* or NULL if there is no valid cache file.
+ */
+struct Vec *
+load__AstCache(Str dir,
+               struct String content,
+               struct Vec *strings,
+               struct ParseBlock *parse_block);
+
+/**
+ *
+ * @brief Store the declarations of the source in the cache directory.
+ * @return true if the cache file has been written.
+ */
+bool
+store__AstCache(Str dir,
+                struct String content,
+                struct Vec *decls,
+                struct ParseBlock *parse_block);
+
+/**
+ *
+ * @brief Construct the Parser type from the cache. If the source content
+ * isn't in the cache, the source is only scanned and split in blocks, its
+ * declarations are parsed by run__ParserWithCache.
+ */
+struct Parser
+__new__ParserFromCache(struct Source *src);
+
+/**
+ *
+ * @brief Parse the declarations of a Parser constructed by
+ * __new__ParserFromCache and store them in the cache (a Parser loaded from the
+ * cache is already parsed).
+ */
+void
+run__ParserWithCache(struct Parser *self);
+
+/**
+ *
+ * @brief Construct the Parser type from the cache. If the source content
+ * isn't in the cache, the source is scanned, parsed and stored in the cache.
+ * In both cases the returned Parser has already been run.
+ */
+struct Parser
+__new__ParserWithCache(struct Source *src);
+
+#endif // LILY_CACHE_H
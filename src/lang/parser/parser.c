@@ -28,9 +28,11 @@
 #include <base/platform.h>
 #include <base/util.h>
 #include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/sink.h>
 #include <lang/diagnostic/summary.h>
 #include <lang/parser/parser.h>
 #include <string.h>
+#include <threads.h>
 
 /*
 
@@ -183,7 +185,7 @@ This last step will just add the analyzer declarations into a vector (decls).
               format("the generic params are ignored because they are empty"), \
               None());                                                         \
                                                                                \
-            emit_warning__Diagnostic(warn, parse_block->disable_warning);      \
+            emit_warning_pb(parse_block, warn);                                \
         }                                                                      \
                                                                                \
         if (len__Vec(*self->generic_params) > 0)                               \
@@ -348,7 +350,8 @@ This last step will just add the analyzer declarations into a vector (decls).
     case TokenKindMutKw:          \
     case TokenKindBar:            \
     case TokenKindArrow:          \
-    case TokenKindStar
+    case TokenKindStar:           \
+    case TokenKindAmpersand
 
 #define PARSE_MODULE_BODY(ctx)                                                 \
     Usize pos = 0;                                                             \
@@ -465,8 +468,9 @@ This last step will just add the analyzer declarations into a vector (decls).
         current = pos < len__Vec(*ctx.body) ? get__Vec(*ctx.body, pos) : NULL; \
     }
 
-Usize count_error = 0;
-Usize count_warning = 0;
+// Per thread: the modules of a wave of imports are parsed in parallel.
+thread_local Usize count_error = 0;
+thread_local Usize count_warning = 0;
 
 struct ParseContext *
 get_block(struct ParseBlock *self, bool in_module, bool in_tag);
@@ -479,7 +483,7 @@ next_token_pb(struct ParseBlock *self);
 static inline void
 skip_to_next_block(struct ParseBlock *self);
 struct String *
-get_type_name(struct ParseBlock *self);
+get_type_name(struct ParseBlock *self, bool *is_repr_c);
 struct ParseContext *
 get_type_context(struct ParseBlock *self, bool is_pub);
 struct String *
@@ -574,6 +578,8 @@ __new__DiagnosticWithNoteParser(struct ParseBlock *self,
                                 struct Location loc,
                                 struct String *detail_msg,
                                 struct Option *help);
+static void
+emit_warning_pb(struct ParseBlock *self, struct Diagnostic *warn);
 static inline void
 next_token(struct ParseDecl *self);
 static inline bool
@@ -756,6 +762,40 @@ parse_tag_declaration(struct Parser *self,
 void
 parse_declaration(struct Parser *self);
 
+struct ParseWarning *
+__new__ParseWarning(enum LilyWarningKind kind,
+                    struct Location loc,
+                    struct String *detail_msg)
+{
+    struct ParseWarning *self = malloc(sizeof(struct ParseWarning));
+    self->kind = kind;
+    self->loc = loc;
+    self->detail_msg = detail_msg;
+    return self;
+}
+
+void
+__free__ParseWarning(struct ParseWarning *self)
+{
+    FREE(String, self->detail_msg);
+    free(self);
+}
+
+// The emitted warning is recorded in the ParseBlock, to be stored in the AST
+// cache with the declarations.
+static void
+emit_warning_pb(struct ParseBlock *self, struct Diagnostic *warn)
+{
+    enum LilyWarningKind kind = warn->warn->kind;
+    struct Location loc = warn->loc;
+    struct String *detail_msg = format("{S}", warn->detail->msg);
+
+    if (emit_warning__Diagnostic(warn, self->disable_warning))
+        push__Vec(self->warnings, NEW(ParseWarning, kind, loc, detail_msg));
+    else
+        FREE(String, detail_msg);
+}
+
 struct ParseBlock
 __new__ParseBlock(struct Scanner scanner)
 {
@@ -766,7 +806,10 @@ __new__ParseBlock(struct Scanner scanner)
                                  NEW(Vec, sizeof(struct ParseContext *)),
                                .current =
                                  (struct Token *)get__Vec(*scanner.tokens, 0),
-                               .disable_warning = NEW(Vec, sizeof(Str)),
+                               .disable_warning =
+                                 NEW(Vec, sizeof(struct String)),
+                               .warnings =
+                                 NEW(Vec, sizeof(struct ParseWarning)),
                                .pos = 0 };
 
     return self;
@@ -1243,10 +1286,38 @@ skip_to_next_block(struct ParseBlock *self)
 }
 
 struct String *
-get_type_name(struct ParseBlock *self)
+get_type_name(struct ParseBlock *self, bool *is_repr_c)
 {
     next_token_pb(self);
 
+    // type #repr_c Point: record = ... (the only tag of a type)
+    if (self->current->kind == TokenKindHashtag) {
+        next_token_pb(self);
+
+        Str tag = self->current->kind == TokenKindIdentifier
+                    ? to_Str__String(*self->current->lit)
+                    : NULL;
+
+        if (tag && !strcmp(tag, "repr_c"))
+            *is_repr_c = true;
+        else {
+            struct Diagnostic *err =
+              NEW(DiagnosticWithErrParser,
+                  self,
+                  NEW(LilyError, LilyErrorUnexpectedToken),
+                  *self->current->loc,
+                  format("unknown tag of type, expected `repr_c`"),
+                  None());
+
+            err->err->s = token_kind_to_String__Token(*self->current);
+
+            emit__Diagnostic(err);
+        }
+
+        free(tag);
+        next_token_pb(self);
+    }
+
     if (self->current->kind != TokenKindIdentifier) {
         struct Diagnostic *err =
           NEW(DiagnosticWithErrParser,
@@ -1270,7 +1341,8 @@ get_type_name(struct ParseBlock *self)
 struct ParseContext *
 get_type_context(struct ParseBlock *self, bool is_pub)
 {
-    struct String *name = get_type_name(self);
+    bool is_repr_c = false;
+    struct String *name = get_type_name(self, &is_repr_c);
     struct Vec *generic_params = NEW(Vec, sizeof(struct Token));
     struct Location loc = NEW(Location);
     bool has_generic_params = false;
@@ -1281,6 +1353,18 @@ get_type_context(struct ParseBlock *self, bool is_pub)
 
     PARSE_GENERIC_TYPE_AND_OBJECT(self);
 
+    if (is_repr_c && self->current->kind != TokenKindRecordKw) {
+        struct Diagnostic *err =
+          NEW(DiagnosticWithErrParser,
+              self,
+              NEW(LilyError, LilyErrorBadUsageOfType),
+              *self->current->loc,
+              format("the tag `#repr_c` is only allowed on a record"),
+              None());
+
+        emit__Diagnostic(err);
+    }
+
     switch (self->current->kind) {
         case TokenKindEnumKw: {
             struct EnumParseContext enum_parse_context = NEW(EnumParseContext);
@@ -1305,6 +1389,7 @@ get_type_context(struct ParseBlock *self, bool is_pub)
             record_parse_context.generic_params = generic_params;
             record_parse_context.is_pub = is_pub;
             record_parse_context.has_generic_params = has_generic_params;
+            record_parse_context.is_repr_c = is_repr_c;
 
             get_record_parse_context(&record_parse_context, self);
             end__Location(
@@ -1611,7 +1696,11 @@ __free__ParseBlock(struct ParseBlock self)
         FREE(ParseContextAll, get__Vec(*self.blocks, i));
 
     FREE(Vec, self.blocks);
+    for (Usize i = 0; i < len__Vec(*self.warnings); i++)
+        FREE(ParseWarning, get__Vec(*self.warnings, i));
+
     FREE(Vec, self.disable_warning);
+    FREE(Vec, self.warnings);
     FREE(Scanner, self.scanner);
 }
 
@@ -1853,7 +1942,7 @@ get_fun_parse_context(struct FunParseContext *self,
                       format("tags are ignored because the tag list is empty"),
                       None());
 
-                emit_warning__Diagnostic(warn, parse_block->disable_warning);
+                emit_warning_pb(parse_block, warn);
             }
 
             if (len__Vec(*self->tags) == 0)
@@ -2083,6 +2172,7 @@ __new__RecordParseContext()
 {
     struct RecordParseContext self = { .is_pub = false,
                                        .has_generic_params = false,
+                                       .is_repr_c = false,
                                        .name = NULL,
                                        .generic_params = NULL,
                                        .fields =
@@ -3449,7 +3539,8 @@ __new__Parser(struct ParseBlock parse_block)
 
     struct Parser self = { .parse_block = parse_block,
                            .pos = 0,
-                           .decls = NEW(Vec, sizeof(struct Decl)) };
+                           .decls = NEW(Vec, sizeof(struct Decl)),
+                           .strings = NULL };
 
     if (len__Vec(*parse_block.blocks) > 0)
         self.current =
@@ -3502,6 +3593,7 @@ is_data_type(struct ParseDecl *self)
 {
     switch (self->current->kind) {
         case TokenKindAmpersand:
+        case TokenKindBar:
         case TokenKindIdentifier:
         case TokenKindInterrogation:
         case TokenKindBang:
@@ -3649,8 +3741,7 @@ parse_data_type(struct Parser self, struct ParseDecl *parse_decl)
                                      "they are empty"),
                               None());
 
-                        emit_warning__Diagnostic(
-                          warn, self.parse_block.disable_warning);
+                        emit_warning_pb(&self.parse_block, warn);
                     }
 
                     data_type = NEW(DataTypeCustom, names, data_types);
@@ -3805,6 +3896,7 @@ parse_data_type(struct Parser self, struct ParseDecl *parse_decl)
 
         case TokenKindAmpersand:
             data_type = NEW(DataTypeRef, parse_data_type(self, parse_decl));
+            break;
 
         case TokenKindBar: {
             struct Vec *params = NEW(Vec, sizeof(struct Vec));
@@ -3835,16 +3927,13 @@ parse_data_type(struct Parser self, struct ParseDecl *parse_decl)
                              "no return data type"),
                       None());
 
-                emit_warning__Diagnostic(warn,
-                                         self.parse_block.disable_warning);
+                emit_warning_pb(&self.parse_block, warn);
 
                 FREE(Vec, params);
 
                 return return_type;
             }
 
-            next_token(parse_decl);
-
             data_type = NEW(DataTypeLambda, params, return_type);
 
             break;
@@ -4464,22 +4553,41 @@ parse_expr_binary_op(struct Parser self,
         if (next_prec > prec)
             break;
 
-        if (next_prec < prec)
-            left = parse_expr_binary_op(self, parse_decl, left, loc, next_prec);
-        else {
-            next_token(parse_decl);
-            struct Expr *right = parse_primary_expr(self, parse_decl);
-            end__Location(&loc,
-                          parse_decl->current->loc->s_line,
-                          parse_decl->current->loc->s_col);
-            left = NEW(ExprBinaryOp,
-                       NEW(BinaryOp,
-                           (enum BinaryOpKind)(UPtr)binary_op_kind,
-                           left,
-                           right,
-                           binary_op_string),
-                       loc);
+        next_token(parse_decl);
+
+        struct Expr *right = parse_primary_expr(self, parse_decl);
+
+        // The operators which bind tighter than this one belong to its right
+        // operand: x + y * z.
+        while (1) {
+            int *right_op_kind = parse_binary_op(parse_decl->current->kind);
+
+            if (!right_op_kind ||
+                get_precedence__BinaryOpKind(
+                  (enum BinaryOpKind)(UPtr)right_op_kind) >= next_prec)
+                break;
+
+            right = parse_expr_binary_op(
+              self,
+              parse_decl,
+              right,
+              right->loc,
+              get_precedence__BinaryOpKind(
+                (enum BinaryOpKind)(UPtr)right_op_kind));
         }
+
+        // The binary operator ends with its right operand, not at the next
+        // token (which can be on the next line).
+        end__Location(&loc,
+                      parse_decl->previous->loc->e_line,
+                      parse_decl->previous->loc->e_col);
+        left = NEW(ExprBinaryOp,
+                   NEW(BinaryOp,
+                       (enum BinaryOpKind)(UPtr)binary_op_kind,
+                       left,
+                       right,
+                       binary_op_string),
+                   loc);
     }
 
     return left;
@@ -4523,6 +4631,7 @@ parse_primary_expr(struct Parser self, struct ParseDecl *parse_decl)
                   None());
 
             emit__Diagnostic(err);
+            flush__DiagnosticSink(global__DiagnosticSink());
             exit(1);
         }
 
@@ -4841,19 +4950,6 @@ exit_unary : {
                 next_token(parse_decl);
 
                 expr = NEW(ExprGrouping, grouping, loc);
-
-                int *binary_op_kind =
-                  parse_binary_op(parse_decl->current->kind);
-
-                if (binary_op_kind) {
-                    expr = parse_expr_binary_op(
-                      self,
-                      parse_decl,
-                      expr,
-                      loc,
-                      get_precedence__BinaryOpKind(
-                        (enum BinaryOpKind)(UPtr)binary_op_kind));
-                }
             }
 
             break;
@@ -5020,6 +5116,7 @@ exit_unary : {
                       None());
 
                 emit__Diagnostic(err);
+                flush__DiagnosticSink(global__DiagnosticSink());
                 exit(1);
             } else if (parse_unary_op(parse_decl->previous->kind)) {
                 struct Diagnostic *err =
@@ -5031,6 +5128,7 @@ exit_unary : {
                       None());
 
                 emit__Diagnostic(err);
+                flush__DiagnosticSink(global__DiagnosticSink());
                 exit(1);
             } else {
                 struct Diagnostic *err =
@@ -5042,6 +5140,7 @@ exit_unary : {
                       None());
 
                 emit__Diagnostic(err);
+                flush__DiagnosticSink(global__DiagnosticSink());
                 exit(1);
             }
         }
@@ -5286,10 +5385,17 @@ parse_lambda_expr(struct Parser self,
     if (parse_decl->current->kind == TokenKindLParen &&
         peek_token(*parse_decl, 1)->kind != TokenKindRParen) {
         struct Vec *tokens = NEW(Vec, sizeof(struct Token));
+        // The body can have parens: fun (x) -> (f(x) + 1).
+        Usize depth = 0;
 
         next_token(parse_decl);
 
-        while (parse_decl->current->kind != TokenKindRParen) {
+        while (depth || parse_decl->current->kind != TokenKindRParen) {
+            if (parse_decl->current->kind == TokenKindLParen)
+                depth++;
+            else if (parse_decl->current->kind == TokenKindRParen)
+                depth--;
+
             push__Vec(tokens, parse_decl->current);
             next_token(parse_decl);
         }
@@ -5841,9 +5947,12 @@ parse_expr(struct Parser self, struct ParseDecl *parse_decl)
       &loc, parse_decl->current->loc->s_line, parse_decl->current->loc->s_col);
 
     struct Expr *left = parse_primary_expr(self, parse_decl);
+    Usize prec = get_precedence__Expr(left);
 
+    // A grouping, a call, an access or a unary operator binds tighter than
+    // the binary operators, so they can all follow it.
     struct Expr *expr = parse_expr_binary_op(
-      self, parse_decl, left, loc, get_precedence__Expr(left));
+      self, parse_decl, left, loc, prec < 17 ? 17 : prec);
 
     if (expr->kind == ExprKindGrouping) {
         assert(0 && "warning: unused paren");
@@ -6347,6 +6456,7 @@ parse_import_value__parse_import_stmt(struct Parser self,
                     push__Vec(import_value, NEW(ImportStmtValueBuiltin));
                 else if (!strcmp(name_str, "file")) {
                     if (current == (char *)'(') {
+                        next_char__parse_import_stmt(*buffer, &current, &i);
                         push__Vec(
                           import_value,
                           NEW(ImportStmtValueFile,
@@ -6364,6 +6474,7 @@ parse_import_value__parse_import_stmt(struct Parser self,
                     }
                 } else if (!strcmp(name_str, "url")) {
                     if (current == (char *)'(') {
+                        next_char__parse_import_stmt(*buffer, &current, &i);
                         push__Vec(
                           import_value,
                           NEW(ImportStmtValueUrl,
@@ -7208,7 +7319,8 @@ parse_record_declaration(struct Parser *self,
                generic_params,
                fields,
                record_parse_context.is_pub,
-               is_object);
+               is_object,
+               record_parse_context.is_repr_c);
 }
 
 struct AliasDecl *
@@ -7927,6 +8039,28 @@ run__Parser(struct Parser *self)
 #endif
 }
 
+struct Vec *
+get_imports__Parser(struct Parser *self)
+{
+    struct Vec *imports = NEW(Vec, sizeof(struct ImportStmt));
+
+    for (Usize i = 0; i < len__Vec(*self->parse_block.blocks); i++) {
+        struct ParseContext *block = get__Vec(*self->parse_block.blocks, i);
+
+        if (block->kind == ParseContextKindImport)
+            push__Vec(imports,
+                      parse_import_declaration(self, block->value.import));
+    }
+
+    if (count_error > 0) {
+        emit__Summary(
+          count_error, count_warning, "the parser phase has been failed");
+        exit(1);
+    }
+
+    return imports;
+}
+
 void
 __free__Parser(struct Parser self)
 {
@@ -7936,4 +8070,11 @@ __free__Parser(struct Parser self)
         FREE(DeclAll, get__Vec(*self.decls, i));
 
     FREE(Vec, self.decls);
+
+    if (self.strings) {
+        for (Usize i = len__Vec(*self.strings); i--;)
+            FREE(String, get__Vec(*self.strings, i));
+
+        FREE(Vec, self.strings);
+    }
 }
@@ -25,15 +25,42 @@
 #ifndef LILY_PARSER_H
 #define LILY_PARSER_H
 
+#include <lang/diagnostic/diagnostic.h>
 #include <lang/parser/ast.h>
 #include <lang/scanner/scanner.h>
 
+// A warning emitted by the parse. It's kept in the AST cache, so that a source
+// loaded from the cache reports the same warnings.
+typedef struct ParseWarning
+{
+    enum LilyWarningKind kind;
+    struct Location loc;
+    struct String *detail_msg;
+} ParseWarning;
+
+/**
+ *
+ * @brief Construct the ParseWarning type.
+ */
+struct ParseWarning *
+__new__ParseWarning(enum LilyWarningKind kind,
+                    struct Location loc,
+                    struct String *detail_msg);
+
+/**
+ *
+ * @brief Free the ParseWarning type.
+ */
+void
+__free__ParseWarning(struct ParseWarning *self);
+
 typedef struct ParseBlock
 {
     struct Scanner scanner;
     struct Vec *blocks;    // struct Vec<struct Vec<struct ParseContext*>*>*
     struct Token *current; // struct Token&
-    struct Vec *disable_warning; // struct Vec<Str>*
+    struct Vec *disable_warning; // struct Vec<struct String&>*
+    struct Vec *warnings;        // struct Vec<struct ParseWarning*>*
     Usize pos;
 } ParseBlock;
 
@@ -121,6 +148,7 @@ typedef struct RecordParseContext
 {
     bool is_pub;
     bool has_generic_params;
+    bool is_repr_c;
     struct String *name;        // struct String&
     struct Vec *generic_params; // struct Vec<struct Token&>*
     struct Vec *fields;         // struct Vec<struct Token&>*
@@ -642,7 +670,9 @@ typedef struct Parser
     struct ParseBlock parse_block;
     Usize pos;
     struct ParseContext *current;
-    struct Vec *decls; // struct Vec<struct Decl*>*
+    struct Vec *decls;   // struct Vec<struct Decl*>*
+    struct Vec *strings; // struct Vec<struct String*>* (only used when the
+                         // decls are loaded from the cache)
 } Parser;
 
 /**
@@ -659,6 +689,15 @@ __new__Parser(struct ParseBlock parse_block);
 void
 run__Parser(struct Parser *self);
 
+/**
+ *
+ * @brief Parse only the import declarations (the other blocks are not
+ * parsed).
+ * @return struct Vec<struct ImportStmt*>*
+ */
+struct Vec *
+get_imports__Parser(struct Parser *self);
+
 /**
  *
  * @brief Free the Parser type.
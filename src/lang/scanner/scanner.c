@@ -30,6 +30,7 @@
 #include <base/result.h>
 #include <base/types.h>
 #include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/file_cache.h>
 #include <lang/diagnostic/summary.h>
 #include <lang/scanner/scanner.h>
 #include <lang/scanner/token.h>
@@ -384,6 +385,7 @@ __new__File(Str name)
 void
 __free__File(struct File self)
 {
+    forget__DiagnosticFile(self.name, self.content);
     FREE(String, self.content);
 }
 
@@ -1945,8 +1947,10 @@ get_token(struct Scanner *self)
                 struct Result *last_doc = Ok(
                   get__Vec(*scan_doc.tokens, len__Vec(*scan_doc.tokens) - 1));
 
-                if (doc)
+                if (doc) {
+                    forget__DiagnosticFile(self->src->file.name, doc);
                     FREE(String, doc);
+                }
 
                 FREE(Vec, scan_doc.tokens);
 
@@ -2,6 +2,7 @@
 #include <base/new.h>
 #include <base/print.h>
 #include <base/test.h>
+#include <lang/analysis/symbol_table.h>
 #include <lang/analysis/typecheck.h>
 #include <lang/parser/parser.h>
 #include <lang/scanner/scanner.h>
@@ -16,10 +17,30 @@ test_alias_generic_param()
     return TEST_SKIPPED;
 }
 
+// An alias is replaced by its data type, also when it names another alias.
 static int
 test_alias_data_type()
 {
-    return TEST_SKIPPED;
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/alias/data_type.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct AliasSymbol *my_integer = get__Vec(*tc.aliases, 0);
+    struct AliasSymbol *integer = get__Vec(*tc.aliases, 1);
+    struct AliasSymbol *opt = get__Vec(*tc.aliases, 2);
+
+    TEST_ASSERT(my_integer->data_type);
+    TEST_ASSERT_EQ(my_integer->data_type->kind, DataTypeKindI32);
+    TEST_ASSERT_EQ(integer->data_type, my_integer->data_type);
+    TEST_ASSERT(opt->data_type);
+    TEST_ASSERT_EQ(opt->data_type->kind, DataTypeKindOptional);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
 }
 
 static int
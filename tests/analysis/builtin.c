@@ -0,0 +1,69 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <base/vec.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/builtin/builtin_c.h>
+#include <string.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_builtin_shared_table()
+{
+    const struct BuiltinTable *builtins = Load_C_builtins();
+
+    TEST_ASSERT_EQ(builtins, Load_C_builtins());
+    TEST_ASSERT_EQ(builtins->module_count, 27);
+    TEST_ASSERT_EQ(len__StrMap(*builtins->index), builtins->entry_count);
+
+    Usize fun_count = 0;
+
+    for (Usize i = 0; i < builtins->module_count; i++)
+        fun_count += builtins->modules[i].fun_count;
+
+    TEST_ASSERT_EQ(fun_count, 521);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_builtin_search()
+{
+    const struct BuiltinTable *builtins = Load_C_builtins();
+
+    // - is defined as a binary and as an unary operator.
+    const struct BuiltinFun *sub =
+      search__BuiltinTable(builtins, "Int32", "-", 3);
+    const struct BuiltinFun *neg =
+      search__BuiltinTable(builtins, "Int32", "-", 2);
+
+    TEST_ASSERT(sub);
+    TEST_ASSERT(neg);
+    TEST_ASSERT_NE(sub, neg);
+    TEST_ASSERT(!strcmp(neg->name, "-"));
+    TEST_ASSERT_EQ(((struct DataTypeSymbol *)get__Vec(*sub->params, 2))->kind,
+                   DataTypeKindI32);
+
+    // The identical data types are shared.
+    TEST_ASSERT_EQ(get__Vec(*sub->params, 0), get__Vec(*neg->params, 0));
+
+    const struct BuiltinFun *assign =
+      search__BuiltinTable(builtins, "Custom", "=", 3);
+    struct DataTypeSymbol *mut = get__Vec(*assign->params, 0);
+
+    TEST_ASSERT_EQ(mut->kind, DataTypeKindMut);
+    TEST_ASSERT_EQ(mut->value.mut->kind, DataTypeKindCompilerDefined);
+
+    const struct BuiltinFun *println =
+      search__BuiltinTable(builtins, "Io", "println", 3);
+
+    TEST_ASSERT_EQ(
+      ((struct DataTypeSymbol *)get__Vec(*println->params, 1))->kind,
+      DataTypeKindArray);
+
+    TEST_ASSERT(!search__BuiltinTable(builtins, "Int32", "-", 4));
+    TEST_ASSERT(!search__BuiltinTable(builtins, "Int32", "println", 3));
+    TEST_ASSERT(!search__BuiltinTable(builtins, "Unknown", "+", 3));
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,135 @@
+#include <base/format.h>
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+#include <lang/analysis/duplicate.h>
+#include <time.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_duplicate_conflicts()
+{
+    struct String *a = from__String("a");
+    struct String *a2 = from__String("a");
+    struct String *a3 = from__String("a");
+    struct String *b = from__String("b");
+    struct String *b2 = from__String("b");
+    struct DuplicateNames *names = NEW(DuplicateNames);
+
+    push__DuplicateNames(names, a, DuplicateKindOther);
+    push__DuplicateNames(names, b, DuplicateKindOther);
+    push__DuplicateNames(names, a2, DuplicateKindOther);
+    push__DuplicateNames(names, a3, DuplicateKindOther);
+    push__DuplicateNames(names, NULL, DuplicateKindOther);
+    push__DuplicateNames(names, b2, DuplicateKindOther);
+
+    Usize *conflicts = get_conflicts__DuplicateNames(names);
+
+    // Each name is in conflict with the next name which is equal.
+    TEST_ASSERT_EQ(conflicts[0], 2);
+    TEST_ASSERT_EQ(conflicts[1], 5);
+    TEST_ASSERT_EQ(conflicts[2], 3);
+    TEST_ASSERT_EQ(conflicts[3], DUPLICATE_NONE);
+    TEST_ASSERT_EQ(conflicts[4], DUPLICATE_NONE);
+    TEST_ASSERT_EQ(conflicts[5], DUPLICATE_NONE);
+
+    free(conflicts);
+    FREE(DuplicateNames, names);
+    FREE(String, a);
+    FREE(String, a2);
+    FREE(String, a3);
+    FREE(String, b);
+    FREE(String, b2);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_duplicate_tag()
+{
+    struct String *tag = from__String("Person");
+    struct String *record = from__String("Person");
+    struct String *enum_ = from__String("Person");
+    struct String *fun = from__String("Person");
+    struct DuplicateNames *names = NEW(DuplicateNames);
+
+    push__DuplicateNames(names, tag, DuplicateKindTag);
+    push__DuplicateNames(names, record, DuplicateKindType);
+    push__DuplicateNames(names, enum_, DuplicateKindType);
+    push__DuplicateNames(names, fun, DuplicateKindOther);
+
+    Usize *conflicts = get_conflicts__DuplicateNames(names);
+
+    // A tag can share its name with a record or an enum.
+    TEST_ASSERT_EQ(conflicts[0], 3);
+    TEST_ASSERT_EQ(conflicts[1], 2);
+    TEST_ASSERT_EQ(conflicts[2], 3);
+    TEST_ASSERT_EQ(conflicts[3], DUPLICATE_NONE);
+
+    free(conflicts);
+    FREE(DuplicateNames, names);
+    FREE(String, tag);
+    FREE(String, record);
+    FREE(String, enum_);
+    FREE(String, fun);
+
+    return TEST_SUCCESS;
+}
+
+// Search the duplicates of len distinct names, plus a copy of the first name.
+static clock_t
+search_duplicates(Usize len, bool *res)
+{
+    struct Vec *strings = NEW(Vec, sizeof(struct String));
+    struct DuplicateNames *names = NEW(DuplicateNames);
+
+    for (Usize i = 0; i <= len; i++) {
+        struct String *name = format("decl{d}", i % len);
+
+        push__Vec(strings, name);
+        push__DuplicateNames(names, name, DuplicateKindOther);
+    }
+
+    clock_t start = clock();
+    Usize *conflicts = get_conflicts__DuplicateNames(names);
+    clock_t time = clock() - start;
+
+    *res = conflicts[0] == len;
+
+    for (Usize i = 1; i <= len; i++)
+        *res = *res && conflicts[i] == DUPLICATE_NONE;
+
+    free(conflicts);
+    FREE(DuplicateNames, names);
+
+    for (Usize i = len__Vec(*strings); i--;)
+        FREE(String, get__Vec(*strings, i));
+
+    FREE(Vec, strings);
+
+    return time;
+}
+
+static int
+test_duplicate_scaling()
+{
+    const Usize lens[] = { 100, 1000, 10000, 100000 };
+    clock_t times[4];
+
+    for (Usize i = 0; i < 4; i++) {
+        bool res = false;
+
+        times[i] = search_duplicates(lens[i], &res);
+        TEST_ASSERT(res);
+    }
+
+    // 100 times more names: a linear search is about 100 times slower, a
+    // quadratic search 10000 times slower.
+    clock_t unit = times[1] > CLOCKS_PER_SEC / 1000 ? times[1]
+                                                    : CLOCKS_PER_SEC / 1000;
+
+    TEST_ASSERT((times[3] < unit * 1000));
+
+    return TEST_SUCCESS;
+}
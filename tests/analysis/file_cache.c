@@ -0,0 +1,103 @@
+#include <base/new.h>
+#include <base/option.h>
+#include <base/test.h>
+#include <base/writer.h>
+#include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/file_cache.h>
+#include <lang/scanner/scanner.h>
+#include <string.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static bool
+is_line(const struct DiagnosticFile *file, Usize line_number, const Str line)
+{
+    Usize len = 0;
+    const char *res = get_line__DiagnosticFile(file, line_number, &len);
+
+    return len == strlen(line) && !memcmp(res, line, len);
+}
+
+static int
+test_file_cache_lines()
+{
+    struct File file = { .name = "lines.lily",
+                         .content = from__String("fun f =\n\n\tend\n") };
+    const struct DiagnosticFile *cache =
+      get__DiagnosticFile(file.name, file.content);
+
+    TEST_ASSERT((get__DiagnosticFile(file.name, file.content) == cache));
+    TEST_ASSERT_EQ(cache->line_count, 4);
+    TEST_ASSERT(is_line(cache, 1, "fun f ="));
+    TEST_ASSERT(is_line(cache, 2, ""));
+    TEST_ASSERT(is_line(cache, 3, "\tend"));
+    TEST_ASSERT(is_line(cache, 4, ""));
+    TEST_ASSERT(is_line(cache, 9, ""));
+
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_file_cache_same_name()
+{
+    struct File file = { .name = "same.lily",
+                         .content = from__String("fun f =\nend") };
+    struct File doc = { .name = "same.lily", .content = from__String("@doc") };
+    const struct DiagnosticFile *file_cache =
+      get__DiagnosticFile(file.name, file.content);
+    const struct DiagnosticFile *doc_cache =
+      get__DiagnosticFile(doc.name, doc.content);
+
+    // The content of the documentation has its own entry, and the entry of
+    // the file stays valid when the documentation is forgotten.
+    TEST_ASSERT((file_cache != doc_cache));
+    TEST_ASSERT(is_line(doc_cache, 1, "@doc"));
+
+    FREE(File, doc);
+
+    TEST_ASSERT((get__DiagnosticFile(file.name, file.content) == file_cache));
+    TEST_ASSERT(is_line(file_cache, 2, "end"));
+
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_file_cache_render()
+{
+    struct File file = { .name = "render.lily",
+                         .content = from__String("fun f =\n\tx := (1)\nend") };
+    struct String *help = from__String("write `1`");
+    struct Diagnostic *diagnostic =
+      NEW(DiagnosticWithWarn,
+          NEW(LilyWarning, LilyWarningUnusedParen),
+          (struct Location){ .s_line = 2, .s_col = 7, .e_line = 2, .e_col = 9 },
+          file,
+          from__String("remove them"),
+          Some(help));
+    struct Writer writer = NEW(WriterBuffer);
+
+    write__Diagnostic(*diagnostic, &writer);
+
+    Str output = take__Writer(&writer);
+
+    // The tabulation of the line is kept before the carets.
+    TEST_ASSERT(!strcmp(output,
+                        "render.lily:2:7: \x1b[33mwarning\x1b[0m[0001]: "
+                        "unused paren\n"
+                        "  |\n"
+                        "2 | \x1b[33m\tx := (1)\x1b[0m\n"
+                        "  | \t     ^^^ remove them\n"
+                        "\x1b[32mhelp\x1b[0m: write `1`"));
+
+    free(output);
+    FREE(Writer, writer);
+    FREE(Diagnostic, diagnostic);
+    FREE(String, help);
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
@@ -10,10 +10,37 @@
 
 #pragma GCC diagnostic ignored "-Wunused-function"
 
+static struct DataTypeSymbol *
+get_param_data_type(struct FunSymbol *fun, Usize i)
+{
+    return ((struct FunParamSymbol *)get__Vec(*fun->params, i))
+      ->param_data_type->items[0];
+}
+
 static int
 test_fun_param_inference()
 {
-    return TEST_SKIPPED;
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/fun/inference.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct FunSymbol *add = get__Vec(*tc.funs, 0);
+    struct FunSymbol *first = get__Vec(*tc.funs, 1);
+
+    // The params which are never constrained are implicit generic params.
+    TEST_ASSERT_EQ(get_param_data_type(add, 0)->kind,
+                   DataTypeKindCompilerDefined);
+    TEST_ASSERT_EQ(get_param_data_type(first, 0)->kind,
+                   DataTypeKindCompilerDefined);
+    TEST_ASSERT_EQ(get_param_data_type(first, 1)->kind,
+                   DataTypeKindCompilerDefined);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
 }
 
 static int
@@ -37,7 +64,28 @@ test_fun_generic_param_omitted()
 static int
 test_fun_return_type_inferance()
 {
-    return TEST_SKIPPED;
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/fun/inference.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct FunSymbol *add = get__Vec(*tc.funs, 0);
+    struct FunSymbol *first = get__Vec(*tc.funs, 1);
+    struct FunSymbol *one = get__Vec(*tc.funs, 2);
+    struct FunSymbol *main_fun = get__Vec(*tc.funs, 3);
+
+    TEST_ASSERT_EQ(add->return_type, get_param_data_type(add, 0));
+    TEST_ASSERT_EQ(first->return_type, get_param_data_type(first, 0));
+    TEST_ASSERT_EQ(one->return_type->kind, DataTypeKindI32);
+
+    // The return data type is never constrained.
+    TEST_ASSERT_EQ(main_fun->return_type, NULL);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
 }
 
 static int
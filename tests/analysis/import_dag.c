@@ -0,0 +1,76 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/import_dag.h>
+#include <string.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+// root imports a and b, a imports c, b imports c and d: c and d are loaded
+// first, then a and b.
+static int
+test_import_dag_waves()
+{
+    struct ImportDag *dag = NEW(ImportDag);
+    struct ImportDagNode *root =
+      add__ImportDag(dag, strdup("root.lily"), strdup("root.lily"));
+    struct ImportDagNode *a =
+      add__ImportDag(dag, strdup("a.lily"), strdup("a.lily"));
+    struct ImportDagNode *b =
+      add__ImportDag(dag, strdup("b.lily"), strdup("b.lily"));
+    struct ImportDagNode *c =
+      add__ImportDag(dag, strdup("c.lily"), strdup("c.lily"));
+    struct ImportDagNode *d =
+      add__ImportDag(dag, strdup("d.lily"), strdup("d.lily"));
+
+    add_dep__ImportDag(root, a);
+    add_dep__ImportDag(root, b);
+    add_dep__ImportDag(a, c);
+    add_dep__ImportDag(b, c);
+    add_dep__ImportDag(b, d);
+    add_dep__ImportDag(b, d);
+
+    TEST_ASSERT_EQ(get__ImportDag(*dag, "c.lily"), c);
+    TEST_ASSERT_EQ(len__Vec(*b->deps), 2);
+    TEST_ASSERT(build_waves__ImportDag(dag));
+    TEST_ASSERT_EQ(len__Vec(*dag->waves), 3);
+
+    struct Vec *wave0 = get__Vec(*dag->waves, 0);
+    struct Vec *wave1 = get__Vec(*dag->waves, 1);
+    struct Vec *wave2 = get__Vec(*dag->waves, 2);
+
+    TEST_ASSERT_EQ(len__Vec(*wave0), 2);
+    TEST_ASSERT_EQ(get__Vec(*wave0, 0), c);
+    TEST_ASSERT_EQ(get__Vec(*wave0, 1), d);
+    TEST_ASSERT_EQ(len__Vec(*wave1), 2);
+    TEST_ASSERT_EQ(get__Vec(*wave1, 0), a);
+    TEST_ASSERT_EQ(get__Vec(*wave1, 1), b);
+    TEST_ASSERT_EQ(len__Vec(*wave2), 1);
+    TEST_ASSERT_EQ(get__Vec(*wave2, 0), root);
+
+    FREE(ImportDag, dag);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_import_dag_cycle()
+{
+    struct ImportDag *dag = NEW(ImportDag);
+    struct ImportDagNode *a =
+      add__ImportDag(dag, strdup("a.lily"), strdup("a.lily"));
+    struct ImportDagNode *b =
+      add__ImportDag(dag, strdup("b.lily"), strdup("b.lily"));
+    struct ImportDagNode *c =
+      add__ImportDag(dag, strdup("c.lily"), strdup("c.lily"));
+
+    add_dep__ImportDag(a, b);
+    add_dep__ImportDag(b, c);
+    add_dep__ImportDag(c, a);
+
+    TEST_ASSERT(!build_waves__ImportDag(dag));
+    TEST_ASSERT_EQ(len__Vec(*dag->waves), 0);
+
+    FREE(ImportDag, dag);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,195 @@
+#include <base/file.h>
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/dep_graph.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/typecheck.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_incremental_dep_graph()
+{
+    struct DepGraph *deps = NEW(DepGraph);
+    int symbols[5];
+
+    // 1 and 2 use the signature of 0, 3 uses 0 in its body and 4 uses the
+    // signature of 2.
+    add__DepGraph(deps, &symbols[1], DepKindSignature, &symbols[0]);
+    add__DepGraph(deps, &symbols[2], DepKindSignature, &symbols[0]);
+    add__DepGraph(deps, &symbols[2], DepKindSignature, &symbols[0]);
+    add__DepGraph(deps, &symbols[3], DepKindBody, &symbols[0]);
+    add__DepGraph(deps, &symbols[4], DepKindSignature, &symbols[2]);
+
+    TEST_ASSERT_EQ(deps->edges_len, 4);
+
+    // A change of the body of 0 doesn't reach its users.
+    invalidate__DepGraph(deps, &symbols[0], DepStateBody);
+    TEST_ASSERT_EQ(get_state__DepGraph(deps, &symbols[0]), DepStateBody);
+    TEST_ASSERT_EQ(deps->invalid_len, 1);
+
+    validate__DepGraph(deps, &symbols[0]);
+    TEST_ASSERT_EQ(deps->invalid_len, 0);
+
+    invalidate__DepGraph(deps, &symbols[0], DepStateSignature);
+    TEST_ASSERT_EQ(get_state__DepGraph(deps, &symbols[1]), DepStateSignature);
+    TEST_ASSERT_EQ(get_state__DepGraph(deps, &symbols[2]), DepStateSignature);
+    TEST_ASSERT_EQ(get_state__DepGraph(deps, &symbols[3]), DepStateBody);
+    TEST_ASSERT_EQ(get_state__DepGraph(deps, &symbols[4]), DepStateSignature);
+    TEST_ASSERT_EQ(deps->invalid_len, 5);
+
+    FREE(DepGraph, deps);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_incremental_deps()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    // The signature of paint uses Color.
+    invalidate__DepGraph(tc.deps, get__Vec(*tc.enums, 0), DepStateSignature);
+
+    TEST_ASSERT_EQ(get_state__DepGraph(tc.deps, get__Vec(*tc.funs, 0)),
+                   DepStateSignature);
+    TEST_ASSERT_EQ(get_state__DepGraph(tc.deps, get__Vec(*tc.funs, 1)),
+                   DepStateValid);
+    TEST_ASSERT_EQ(get_state__DepGraph(tc.deps, get__Vec(*tc.funs, 2)),
+                   DepStateValid);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static Usize
+recheck_with(struct Typecheck *tc, struct Source *src)
+{
+    return recheck__Typecheck(
+      tc, NEW(Parser, NEW(ParseBlock, NEW(Scanner, src))));
+}
+
+static int
+test_incremental_body_change()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Source body =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/body.lily"));
+    struct Source same_body =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/body.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct FunSymbol *paint = get__Vec(*tc.funs, 0);
+    struct FunSymbol *main_fun = get__Vec(*tc.funs, 2);
+
+    // Only main is checked again, paint is bound to its new declaration.
+    TEST_ASSERT_EQ(recheck_with(&tc, &body), 1);
+    TEST_ASSERT_EQ(paint->fun_decl, get__Vec(*tc.parser.decls, 1));
+    TEST_ASSERT_EQ(main_fun->fun_decl, get__Vec(*tc.parser.decls, 3));
+    TEST_ASSERT(main_fun->body);
+    TEST_ASSERT_EQ(tc.deps->invalid_len, 0);
+
+    // Nothing changed.
+    TEST_ASSERT_EQ(recheck_with(&tc, &same_body), 0);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_incremental_signature_change()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Source signature =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/signature.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct FunSymbol *paint = get__Vec(*tc.funs, 0);
+
+    TEST_ASSERT_EQ(recheck_with(&tc, &signature), 1);
+    TEST_ASSERT_EQ(len__Vec(*paint->params), 2);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+// The locations are not hashed: a moved declaration is matched by its name.
+// The moved functions are checked again to update their locations, without
+// invalidating their users.
+static int
+test_incremental_moved_decl()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Source moved =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/moved.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct FunSymbol *paint = get__Vec(*tc.funs, 0);
+    struct FunSymbol *id = get__Vec(*tc.funs, 1);
+    struct FunSymbol *main_fun = get__Vec(*tc.funs, 2);
+
+    TEST_ASSERT_EQ(recheck_with(&tc, &moved), 3);
+    TEST_ASSERT_EQ(tc.deps->invalid_len, 0);
+    TEST_ASSERT_EQ(paint->fun_decl->loc.s_line, 7);
+    TEST_ASSERT_EQ(
+      ((struct FunParamSymbol *)get__Vec(*paint->params, 0))->loc.s_line, 7);
+    TEST_ASSERT_EQ(id->fun_decl->loc.s_line, 11);
+    TEST_ASSERT_EQ(main_fun->fun_decl->loc.s_line, 13);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_incremental_added_decl()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Source added =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/added.lily"));
+    struct Source removed =
+      NEW(Source, NEW(File, "./tests/analysis/incremental/a.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    // The new function is pushed after the other functions, only it is checked.
+    TEST_ASSERT_EQ(recheck_with(&tc, &added), 1);
+    TEST_ASSERT_EQ(len__Vec(*tc.funs), 4);
+
+    struct FunSymbol *two = get__Vec(*tc.funs, 3);
+
+    TEST_ASSERT_EQ(two->fun_decl, get__Vec(*tc.parser.decls, 4));
+    TEST_ASSERT(two->body);
+
+    // The removed function can be used by the checked expressions.
+    TEST_ASSERT_EQ(recheck_with(&tc, &removed), TYPECHECK_RECHECK_ALL);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,233 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <base/vec.h>
+#include <lang/analysis/infer.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/type_interner.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static struct DataTypeSymbol *
+new_t(struct TypeInterner *types)
+{
+    return NEW(DataTypeSymbolCompilerDefined,
+               types,
+               NEW(CompilerDefinedDataType, "T", false));
+}
+
+static int
+test_infer_unify()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct Infer *infer = NEW(Infer, types);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+    struct DataTypeSymbol *str = NEW(DataTypeSymbol, types, DataTypeKindStr);
+    Usize a = fresh__Infer(infer);
+    Usize b = fresh__Infer(infer);
+
+    // *a = *b, b = Int32, so a = Int32.
+    TEST_ASSERT_EQ(
+      unify__Infer(
+        infer,
+        from_data_type__Infer(infer, NEW(DataTypeSymbolPtr, types, i32)),
+        from_data_type__Infer(
+          infer, NEW(DataTypeSymbolPtr, types, new_t(types)))),
+      InferResultOk);
+    TEST_ASSERT_EQ(unify__Infer(infer, a, b), InferResultOk);
+    TEST_ASSERT_EQ(to_data_type__Infer(infer, a), new_t(types));
+    TEST_ASSERT_EQ(
+      unify__Infer(infer, b, from_data_type__Infer(infer, i32)),
+      InferResultOk);
+    TEST_ASSERT_EQ(to_data_type__Infer(infer, a), i32);
+    TEST_ASSERT_EQ(find__Infer(infer, a), find__Infer(infer, b));
+
+    // The data types are rebuilt from the classes of their sub data types.
+    Usize c = fresh__Infer(infer);
+    Usize optional = from_data_type__Infer(
+      infer, NEW(DataTypeSymbolOptional, types, new_t(types)));
+
+    TEST_ASSERT_EQ(unify__Infer(infer, c, optional), InferResultOk);
+    TEST_ASSERT_EQ(
+      unify__Infer(infer,
+                   c,
+                   from_data_type__Infer(
+                     infer, NEW(DataTypeSymbolOptional, types, str))),
+      InferResultOk);
+    TEST_ASSERT_EQ(to_data_type__Infer(infer, optional),
+                   NEW(DataTypeSymbolOptional, types, str));
+
+    FREE(Infer, infer);
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_infer_mismatch()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct Infer *infer = NEW(Infer, types);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+    struct DataTypeSymbol *str = NEW(DataTypeSymbol, types, DataTypeKindStr);
+    Usize size = 4;
+    Usize other_size = 5;
+
+    TEST_ASSERT_EQ(unify__Infer(infer,
+                                from_data_type__Infer(infer, i32),
+                                from_data_type__Infer(infer, str)),
+                   InferResultMismatch);
+    TEST_ASSERT_EQ(
+      unify__Infer(
+        infer,
+        from_data_type__Infer(infer, NEW(DataTypeSymbolPtr, types, i32)),
+        from_data_type__Infer(infer, NEW(DataTypeSymbolRef, types, i32))),
+      InferResultMismatch);
+    TEST_ASSERT_EQ(
+      unify__Infer(
+        infer,
+        from_data_type__Infer(infer,
+                              NEW(DataTypeSymbolArray, types, i32, &size)),
+        from_data_type__Infer(
+          infer, NEW(DataTypeSymbolArray, types, new_t(types), &other_size))),
+      InferResultMismatch);
+
+    // A type variable can't be bound to two data types.
+    Usize a = fresh__Infer(infer);
+
+    TEST_ASSERT_EQ(unify__Infer(infer, a, from_data_type__Infer(infer, i32)),
+                   InferResultOk);
+    TEST_ASSERT_EQ(unify__Infer(infer, a, from_data_type__Infer(infer, str)),
+                   InferResultMismatch);
+
+    FREE(Infer, infer);
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_infer_occurs()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct Infer *infer = NEW(Infer, types);
+    Usize a = fresh__Infer(infer);
+    Usize b = fresh__Infer(infer);
+    Usize ptr = from_data_type__Infer(
+      infer, NEW(DataTypeSymbolPtr, types, new_t(types)));
+
+    // a = *b, b = a
+    TEST_ASSERT_EQ(unify__Infer(infer, a, ptr), InferResultOk);
+    TEST_ASSERT_EQ(
+      unify__Infer(infer, b, infer->children[infer->nodes[ptr].children]),
+      InferResultOk);
+    TEST_ASSERT_EQ(unify__Infer(infer, b, a), InferResultOccurs);
+
+    FREE(Infer, infer);
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_infer_generalize()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct Infer *infer = NEW(Infer, types);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+    struct DataTypeSymbol *str = NEW(DataTypeSymbol, types, DataTypeKindStr);
+    Usize outer = fresh__Infer(infer);
+
+    // fun id(x) = x; the data type of id is T -> T.
+    enter__Infer(infer);
+
+    Usize param = fresh__Infer(infer);
+    Usize captured = fresh__Infer(infer);
+    struct Vec *params = NEW(Vec, sizeof(struct DataTypeSymbol));
+
+    push__Vec(params, new_t(types));
+
+    Usize id = from_data_type__Infer(
+      infer, NEW(DataTypeSymbolLambda, types, params, new_t(types)));
+    Usize id_param = infer->children[infer->nodes[id].children];
+    Usize id_return = infer->children[infer->nodes[id].children + 1];
+
+    TEST_ASSERT_EQ(unify__Infer(infer, id_param, param), InferResultOk);
+    TEST_ASSERT_EQ(unify__Infer(infer, id_return, param), InferResultOk);
+
+    // A type variable of the outer level is not generalized.
+    TEST_ASSERT_EQ(unify__Infer(infer, captured, outer), InferResultOk);
+
+    exit__Infer(infer);
+    generalize__Infer(infer, id);
+    generalize__Infer(infer, captured);
+
+    TEST_ASSERT_EQ(infer->nodes[find__Infer(infer, param)].level,
+                   INFER_GENERIC_LEVEL);
+    TEST_ASSERT_EQ(infer->nodes[find__Infer(infer, captured)].level, 0);
+
+    // Each instance of id has its own type variables.
+    Usize id_i32 = instantiate__Infer(infer, id);
+    Usize id_str = instantiate__Infer(infer, id);
+
+    TEST_ASSERT_NE(find__Infer(infer, id_i32), find__Infer(infer, id));
+    TEST_ASSERT_EQ(
+      unify__Infer(infer,
+                   infer->children[infer->nodes[id_i32].children],
+                   from_data_type__Infer(infer, i32)),
+      InferResultOk);
+    TEST_ASSERT_EQ(
+      unify__Infer(infer,
+                   infer->children[infer->nodes[id_str].children],
+                   from_data_type__Infer(infer, str)),
+      InferResultOk);
+    TEST_ASSERT_EQ(
+      to_data_type__Infer(infer,
+                          infer->children[infer->nodes[id_i32].children + 1]),
+      i32);
+    TEST_ASSERT_EQ(
+      to_data_type__Infer(infer,
+                          infer->children[infer->nodes[id_str].children + 1]),
+      str);
+    TEST_ASSERT_EQ(to_data_type__Infer(infer, param), new_t(types));
+
+    FREE(Infer, infer);
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_infer_chain()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct Infer *infer = NEW(Infer, types);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+    const Usize len = 200000;
+    Usize first = fresh__Infer(infer);
+    Usize last = first;
+
+    // A long chain of type variables: with path compression and union by
+    // rank, each find stays near constant time.
+    for (Usize i = 0; i < len; i++) {
+        Usize next = fresh__Infer(infer);
+
+        TEST_ASSERT_EQ(unify__Infer(infer, last, next), InferResultOk);
+        last = next;
+    }
+
+    TEST_ASSERT_EQ(unify__Infer(infer, last, from_data_type__Infer(infer, i32)),
+                   InferResultOk);
+    TEST_ASSERT_EQ(to_data_type__Infer(infer, first), i32);
+
+    // The ground data types are shared by all their occurrences.
+    TEST_ASSERT_EQ(from_data_type__Infer(infer, i32),
+                   from_data_type__Infer(infer, i32));
+
+    for (Usize i = 0; i <= len; i++)
+        TEST_ASSERT((infer->nodes[i].rank <= 20));
+
+    FREE(Infer, infer);
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
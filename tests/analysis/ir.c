@@ -0,0 +1,429 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/typecheck.h>
+#include <lang/diagnostic/sink.h>
+#include <lang/ir/closure.h>
+#include <lang/ir/ir.h>
+#include <lang/ir/mono.h>
+#include <lang/ir/pass.h>
+#include <lang/ir/range.h>
+#include <lang/ir/tail.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+
+static bool
+has_call(const struct IrFun *fun)
+{
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            if (fun->blocks[i].insts[j].kind == IrInstKindCall)
+                return true;
+
+    return false;
+}
+
+static Usize
+count_closures(const struct IrFun *fun, bool is_heap)
+{
+    Usize count = 0;
+
+    for (Usize i = 0; i < fun->blocks_len; i++)
+        for (Usize j = 0; j < fun->blocks[i].insts_len; j++)
+            if (fun->blocks[i].insts[j].kind == IrInstKindClosure &&
+                fun->blocks[i].insts[j].value.closure.is_heap == is_heap)
+                count++;
+
+    return count;
+}
+
+static int
+test_ir_fold()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/fold.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+    struct IrFun *answer = ir->funs[0];
+
+    TEST_ASSERT(answer);
+
+    // -O0 keeps the IR of the lowering.
+    Usize insts = count_insts__IrFun(answer);
+
+    optimize__IrModule(ir, 0, NULL);
+    TEST_ASSERT_EQ(count_insts__IrFun(answer), insts);
+
+    // y := 6 * 7, then the branch on y > 40 is resolved.
+    optimize__IrModule(ir, 1, NULL);
+    TEST_ASSERT_EQ(answer->blocks_len, 1);
+    TEST_ASSERT_EQ(answer->blocks[0].insts_len, 1);
+    TEST_ASSERT_EQ(answer->blocks[0].insts[0].kind, IrInstKindConst);
+    TEST_ASSERT_EQ(answer->blocks[0].insts[0].value.literal.value.int32, 42);
+    TEST_ASSERT_EQ(answer->blocks[0].term.kind, IrTermKindReturn);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_inline()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/inline.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    optimize__IrModule(ir, 1, NULL);
+    TEST_ASSERT(has_call(ir->funs[1]));
+
+    // min is inlined in clamp at -O2.
+    optimize__IrModule(ir, 2, NULL);
+    TEST_ASSERT(!has_call(ir->funs[1]));
+    TEST_ASSERT_EQ(ir->funs[1]->blocks_len, 2);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_dead_code()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/dead.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    TEST_ASSERT(eliminate_dead_code__IrFun(ir->funs[0]));
+
+    // Only x * x remains: the multiplication may overflow, it is kept even if
+    // its value was unused.
+    TEST_ASSERT_EQ(count_insts__IrFun(ir->funs[0]), 1);
+    TEST_ASSERT_EQ(ir->funs[0]->blocks[0].insts[0].value.op, IrOpMul);
+    TEST_ASSERT(!eliminate_dead_code__IrFun(ir->funs[0]));
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_constant()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/constant.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    // A, B := A * 4 + seven(), C := square_if_large(B), ORIGIN
+    TEST_ASSERT_EQ(ir->values[0]->literal.value.int64, 3);
+    TEST_ASSERT_EQ(ir->values[1]->literal.value.int64, 19);
+    TEST_ASSERT_EQ(ir->values[2]->literal.value.int64, 361);
+    TEST_ASSERT(ir->values[3]->is_record);
+    TEST_ASSERT_EQ(ir->values[3]->fields_len, 2);
+    TEST_ASSERT_EQ(ir->values[3]->fields[1].literal.value.int64, 19);
+
+    // No initialization at run time.
+    for (Usize i = 0; i < ir->consts_len; i++)
+        TEST_ASSERT(!ir->consts[i]);
+
+    // main uses the values of C and B.
+    struct IrFun *main_fun = ir->funs[2];
+
+    TEST_ASSERT_EQ(main_fun->blocks[0].insts[0].kind, IrInstKindConst);
+    TEST_ASSERT_EQ(main_fun->blocks[0].insts[1].kind, IrInstKindConst);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_mono()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/generic.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    // add2 and first are only lowered per instance, add2(a, 5) and
+    // first(c, false) reuse the cached instances.
+    TEST_ASSERT(ir->generics[0]);
+    TEST_ASSERT(ir->generics[1]);
+    TEST_ASSERT(!ir->generics[2]);
+    TEST_ASSERT(!ir->funs[0]);
+    TEST_ASSERT(!ir->funs[1]);
+    TEST_ASSERT(ir->funs[2]);
+    TEST_ASSERT_EQ(ir->instances_len, 4);
+    TEST_ASSERT_EQ(ir->instances[0].uses, 2);
+    TEST_ASSERT_EQ(ir->instances[3].uses, 2);
+    TEST_ASSERT(eq__String(
+      ir->instances[1].name, from__String("add2__Float64"), true));
+    TEST_ASSERT(eq__String(
+      ir->instances[2].name, from__String("first__Float64_Int32"), true));
+
+    // first(b, a) is used the least: it goes to first__box_box, add2 has no
+    // boxed instance (x + y needs the data type).
+    TEST_ASSERT_EQ(limit_instances__IrModule(ir, 1), 1);
+    TEST_ASSERT(ir->instances[2].is_demoted);
+    TEST_ASSERT(!ir->funs[ir->instances[2].id]);
+    TEST_ASSERT(ir->funs[ir->instances[3].id]);
+    TEST_ASSERT(ir->funs[ir->instances[1].id]);
+
+    optimize__IrModule(ir, 1, NULL);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_match()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/match.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+    struct DiagnosticSink *sink = global__DiagnosticSink();
+    Usize count_warning = sink->count_warning;
+
+    run__Typecheck(&tc, NULL);
+
+    // _ => 4 follows the three variants of Color: the arm is dropped.
+    TEST_ASSERT_EQ(sink->count_warning, count_warning + 1);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+    struct IrFun *color_id = ir->funs[0];
+    struct IrFun *area = ir->funs[1];
+
+    TEST_ASSERT(color_id);
+    TEST_ASSERT(area);
+    TEST_ASSERT(ir->funs[2]);
+
+    optimize__IrModule(ir, 1, NULL);
+
+    // One switch on the tag, with a case per variant and no default.
+    struct IrTerm *term = &color_id->blocks[0].term;
+
+    TEST_ASSERT_EQ(term->kind, IrTermKindSwitch);
+    TEST_ASSERT_EQ(term->cases_len, 3);
+    TEST_ASSERT_EQ(color_id->blocks[term->edges[0].block].term.kind,
+                   IrTermKindUnreachable);
+
+    // The two arms of Circle share the test of the tag, then switch on the
+    // value of the variant.
+    term = &area->blocks[0].term;
+
+    TEST_ASSERT_EQ(term->kind, IrTermKindSwitch);
+    TEST_ASSERT_EQ(term->cases_len, 3);
+    TEST_ASSERT_EQ(
+      area->blocks[get_edge__IrTerm(term, 1)->block].insts[0].kind,
+      IrInstKindPayload);
+    TEST_ASSERT_EQ(
+      area->blocks[get_edge__IrTerm(term, 1)->block].term.kind,
+      IrTermKindSwitch);
+
+    // color_id(Color.Green) is inlined, the switch on the known variant is a
+    // jump.
+    optimize__IrModule(ir, 2, NULL);
+
+    TEST_ASSERT_EQ(ir->funs[2]->blocks_len, 1);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_tail()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/tail.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    TEST_ASSERT(((struct FunSymbol *)get__Vec(*tc.funs, 0))->is_tailrec);
+    TEST_ASSERT(!((struct FunSymbol *)get__Vec(*tc.funs, 1))->is_tailrec);
+
+    // The self tail calls (sum, count) and the mutual tail calls (is_even,
+    // is_odd) are jumps even at -O0, the call of fact is not a tail call.
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    for (Usize i = 0; i < 4; i++) {
+        TEST_ASSERT(ir->funs[i]);
+        TEST_ASSERT(!has_call(ir->funs[i]));
+    }
+
+    TEST_ASSERT(has_call(ir->funs[4]));
+    TEST_ASSERT_EQ(eliminate_tail_calls__IrModule(ir), 0);
+
+    // The entry jumps to the loop: the copy of the body of sum.
+    struct IrFun *sum = ir->funs[0];
+
+    TEST_ASSERT_EQ(sum->blocks[0].term.kind, IrTermKindJump);
+    TEST_ASSERT_EQ(sum->blocks[1].params_len, 2);
+
+    optimize__IrModule(ir, 2, NULL);
+
+    for (Usize i = 0; i < 4; i++)
+        TEST_ASSERT(!has_call(ir->funs[i]));
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_closure()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/closure.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    // Each lambda is a function whose first params are its captures (n, k).
+    struct IrModule *ir = NEW(IrModule, &tc);
+    struct IrFun *adder = ir->funs[1];
+    struct IrFun *main = ir->funs[2];
+
+    TEST_ASSERT(ir->funs[0]);
+    TEST_ASSERT(adder);
+    TEST_ASSERT(main);
+    TEST_ASSERT_EQ(ir->lambdas_len, 3);
+
+    for (Usize i = 0; i < 3; i++) {
+        TEST_ASSERT(ir->lambdas[i].fun);
+        TEST_ASSERT_EQ(ir->lambdas[i].captures_len, 1);
+        TEST_ASSERT_EQ(ir->lambdas[i].fun->blocks[0].params_len, 2);
+    }
+
+    // Without optimization, the environments are on the heap.
+    TEST_ASSERT_EQ(count_closures(main, true), 2);
+
+    // The closure returned by adder escapes, the closures of main are only
+    // called or passed to a param which is only called.
+    optimize__IrModule(ir, 1, NULL);
+
+    TEST_ASSERT_EQ(count_closures(adder, true), 1);
+    TEST_ASSERT_EQ(count_closures(main, false), 2);
+    TEST_ASSERT_EQ(mark_escaping_closures__IrModule(ir), 2);
+
+    // add(1) is inlined and its lambda is removed, apply calls its param.
+    optimize__IrModule(ir, 2, NULL);
+
+    TEST_ASSERT(!ir->lambdas[1].fun);
+    TEST_ASSERT_EQ(count_closures(main, false), 1);
+    TEST_ASSERT(has_call(main));
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_range()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/range.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct IrModule *ir = NEW(IrModule, &tc);
+    struct IrPassStats stats = { 0 };
+
+    optimize__IrModule(ir, 0, &stats);
+    TEST_ASSERT_EQ(stats.checks.checks[IrCheckOverflow], 5);
+    TEST_ASSERT_EQ(stats.checks.eliminated[IrCheckOverflow], 0);
+
+    // i < n bounds i * i and i + 1 (n is 1000), i % 7 divides by a constant.
+    // sum grows without bound and i + 10 overflows when n is 250.
+    stats = (struct IrPassStats){ 0 };
+    optimize__IrModule(ir, 1, &stats);
+
+    TEST_ASSERT_EQ(stats.checks.checks[IrCheckOverflow], 5);
+    TEST_ASSERT_EQ(stats.checks.eliminated[IrCheckOverflow], 3);
+    TEST_ASSERT_EQ(stats.checks.checks[IrCheckDivision], 1);
+    TEST_ASSERT_EQ(stats.checks.eliminated[IrCheckDivision], 1);
+
+    const struct IrFun *small = ir->funs[1];
+    const struct IrBlock *last = NULL;
+
+    for (Usize i = 0; i < small->blocks_len; i++)
+        if (small->blocks[i].term.kind == IrTermKindReturn)
+            last = &small->blocks[i];
+
+    TEST_ASSERT(last);
+    TEST_ASSERT_EQ(last->insts[last->insts_len - 1].value.op, IrOpAdd);
+    TEST_ASSERT(!last->insts[last->insts_len - 1].is_unchecked);
+    TEST_ASSERT_EQ(eliminate_checks__IrModule(ir), 4);
+
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_ir_constant_overflow()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/ir/constant_overflow.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+    struct DiagnosticSink *sink = global__DiagnosticSink();
+
+    run__Typecheck(&tc, NULL);
+
+    Usize count_error = sink->count_error;
+    struct IrModule *ir = NEW(IrModule, &tc);
+
+    // BIG * 2 overflows Int8: the error is reported, the value is unknown.
+    TEST_ASSERT_EQ(sink->count_error, count_error + 1);
+    TEST_ASSERT(ir->values[0]);
+    TEST_ASSERT(!ir->values[1]);
+
+    struct Writer writer = NEW(WriterBuffer);
+
+    render__DiagnosticSink(sink, &writer);
+
+    FREE(Writer, writer);
+    FREE(IrModule, ir);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
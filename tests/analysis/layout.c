@@ -0,0 +1,111 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/typecheck.h>
+#include <lang/generate/generate.h>
+#include <lang/generate/generate_c.h>
+#include <lang/generate/layout.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct DataTypeSymbol *
+get_field_data_type(struct RecordSymbol *record, Usize id)
+{
+    return ((struct SymbolTable *)get__Vec(*record->fields, id))
+      ->value.field->data_type;
+}
+
+static int
+test_layout()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/layout/layout.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct LayoutPlanner layout = NEW(LayoutPlanner, &tc);
+
+    // The fields of a #repr_c record keep their order.
+    const struct RecordLayout *pinned =
+      get_record_layout__LayoutPlanner(&layout, 0);
+
+    TEST_ASSERT_EQ(pinned->layout.size, 24);
+    TEST_ASSERT_EQ(pinned->order[0], 0);
+    TEST_ASSERT_EQ(pinned->offsets[2], 16);
+
+    const struct RecordLayout *loose =
+      get_record_layout__LayoutPlanner(&layout, 1);
+
+    TEST_ASSERT_EQ(loose->layout.size, 16);
+    TEST_ASSERT_EQ(loose->order[0], 1);
+    TEST_ASSERT_EQ(loose->offsets[0], 8);
+    TEST_ASSERT_EQ(loose->offsets[2], 9);
+
+    const struct Layout *color = get_enum_layout__LayoutPlanner(&layout, 0);
+    const struct Layout *shape = get_enum_layout__LayoutPlanner(&layout, 1);
+    const struct Layout *name = get_enum_layout__LayoutPlanner(&layout, 2);
+
+    TEST_ASSERT_EQ(color->kind, LayoutKindEnum);
+    TEST_ASSERT_EQ(color->size, 1);
+    TEST_ASSERT_EQ(shape->kind, LayoutKindTagged);
+    TEST_ASSERT_EQ(shape->size, 8);
+    TEST_ASSERT_EQ(shape->payload_offset, 4);
+    TEST_ASSERT_EQ(name->kind, LayoutKindNiche);
+    TEST_ASSERT_EQ(name->size, sizeof(void *));
+
+    // ?&Node and ?Color have a niche, ?Int64 has a flag.
+    struct RecordSymbol *node = get__Vec(*tc.records, 2);
+    struct Layout link =
+      get_layout__LayoutPlanner(&layout, get_field_data_type(node, 1));
+    struct Layout optional_color =
+      get_layout__LayoutPlanner(&layout, get_field_data_type(node, 2));
+    struct Layout count =
+      get_layout__LayoutPlanner(&layout, get_field_data_type(node, 3));
+
+    TEST_ASSERT_EQ(link.kind, LayoutKindNiche);
+    TEST_ASSERT_EQ(link.niche, 0);
+    TEST_ASSERT_EQ(optional_color.kind, LayoutKindNiche);
+    TEST_ASSERT_EQ(optional_color.niche, 3);
+    TEST_ASSERT_EQ(count.kind, LayoutKindOptional);
+    TEST_ASSERT_EQ(count.size, 16);
+    TEST_ASSERT_EQ(
+      get_record_layout__LayoutPlanner(&layout, 2)->layout.size, 40);
+
+    FREE(LayoutPlanner, layout);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_layout_report()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/layout/layout.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct Generate gen = NEW(Generate, tc);
+    struct Writer writer = NEW(WriterBuffer);
+
+    write_layout__GenerateC(gen, &writer);
+
+    Str report = take__Writer(&writer);
+
+    // Node is rejected by the C generator (?Int64 has no C type), so only
+    // the other data types are printed.
+    TEST_ASSERT(strstr(report, "record Loose: size 16, align 8"));
+    TEST_ASSERT(strstr(report, "enum Name: size 8, align 8"));
+    TEST_ASSERT(!strstr(report, "Node"));
+
+    free(report);
+    FREE(Writer, writer);
+    FREE(Generate, gen);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,56 @@
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+#include <lang/analysis/local_scope.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_local_scope_slot()
+{
+    struct LocalScopeChain *chain = NEW(LocalScopeChain);
+    struct String *x = from__String("x");
+    struct String *y = from__String("y");
+    struct Scope *param =
+      NEW(Scope, "test", x, 0, ScopeItemKindParam, ScopeKindLocal, NULL);
+    struct Scope *outer =
+      NEW(Scope, "test", y, 0, ScopeItemKindVariable, ScopeKindLocal, NULL);
+    struct Scope *inner =
+      NEW(Scope, "test", x, 0, ScopeItemKindVariable, ScopeKindLocal, NULL);
+
+    enter__LocalScopeChain(chain);
+    add__LocalScopeChain(chain, param);
+
+    enter__LocalScopeChain(chain);
+    add__LocalScopeChain(chain, outer);
+
+    TEST_ASSERT_EQ(outer->depth, 1);
+    TEST_ASSERT_EQ(outer->id, 0);
+
+    enter__LocalScopeChain(chain);
+    add__LocalScopeChain(chain, inner);
+
+    // x is shadowed by the variable of the innermost scope.
+    TEST_ASSERT_EQ(get__LocalScopeChain(chain, x), inner);
+    TEST_ASSERT_EQ(get__LocalScopeChain(chain, y), outer);
+    TEST_ASSERT_EQ(inner->depth, 2);
+    TEST_ASSERT_EQ(inner->id, 0);
+
+    leave__LocalScopeChain(chain);
+
+    TEST_ASSERT_EQ(get__LocalScopeChain(chain, x), param);
+    TEST_ASSERT_EQ(param->depth, 0);
+
+    leave__LocalScopeChain(chain);
+
+    TEST_ASSERT(!get__LocalScopeChain(chain, y));
+
+    FREE(LocalScopeChain, chain);
+    FREE(Scope, param);
+    FREE(Scope, outer);
+    FREE(Scope, inner);
+    FREE(String, x);
+    FREE(String, y);
+
+    return TEST_SUCCESS;
+}
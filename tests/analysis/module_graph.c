@@ -0,0 +1,109 @@
+#include <base/file.h>
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/module_graph.h>
+#include <lang/analysis/typecheck.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+// a.lily imports b.lily and c.lily, and c.lily imports b.lily: b.lily must be
+// loaded once.
+static int
+test_module_graph_shared_import()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/module_graph/a.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    TEST_ASSERT_EQ(len__Vec(*tc.graph->nodes), 3);
+    TEST_ASSERT_EQ(len__Vec(*tc.graph->stack), 0);
+    TEST_ASSERT_EQ(len__Vec(*tc.buffers), 2);
+
+    struct Path *path = NEW(Path, "./tests/analysis/module_graph/b.lily");
+    Str b_path = get_canonical__Path(*path);
+    struct ModuleNode *b = get__ModuleGraph(*tc.graph, b_path);
+
+    TEST_ASSERT(b);
+    TEST_ASSERT_EQ(b->state, ModuleStateLoaded);
+
+    // The Typecheck of b.lily is shared by a.lily and c.lily.
+    struct Typecheck *c = get__Vec(*tc.buffers, 1);
+
+    TEST_ASSERT_EQ(get__Vec(*tc.buffers, 0), b->tc);
+    TEST_ASSERT_EQ(len__Vec(*c->buffers), 1);
+    TEST_ASSERT_EQ(get__Vec(*c->buffers, 0), b->tc);
+
+    free(b_path);
+    FREE(Path, path);
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+// Same import graph loaded in waves of imports: b.lily, then c.lily.
+static int
+test_module_graph_waves()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/module_graph/a.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    tc.jobs = 4;
+    run__Typecheck(&tc, NULL);
+
+    TEST_ASSERT_EQ(len__Vec(*tc.graph->nodes), 3);
+    TEST_ASSERT_EQ(len__Vec(*tc.graph->stack), 0);
+    TEST_ASSERT_EQ(len__Vec(*tc.buffers), 2);
+
+    struct ModuleNode *b = get__Vec(*tc.graph->nodes, 1);
+    struct ModuleNode *c = get__Vec(*tc.graph->nodes, 2);
+
+    TEST_ASSERT_EQ(b->state, ModuleStateLoaded);
+    TEST_ASSERT_EQ(c->state, ModuleStateLoaded);
+    TEST_ASSERT_EQ(get__Vec(*tc.buffers, 0), b->tc);
+    TEST_ASSERT_EQ(get__Vec(*tc.buffers, 1), c->tc);
+    TEST_ASSERT_EQ(len__Vec(*c->tc->buffers), 1);
+    TEST_ASSERT_EQ(get__Vec(*c->tc->buffers, 0), b->tc);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_module_graph_cycle_path()
+{
+    struct ModuleGraph *graph = NEW(ModuleGraph, NULL);
+    struct ModuleNode *a = add__ModuleGraph(graph, strdup("a.lily"));
+    struct ModuleNode *b = add__ModuleGraph(graph, strdup("b.lily"));
+
+    add__ModuleGraph(graph, strdup("c.lily"));
+
+    TEST_ASSERT_EQ(get__ModuleGraph(*graph, "b.lily"), b);
+    TEST_ASSERT(!get__ModuleGraph(*graph, "d.lily"));
+
+    struct String *cycle_a = get_cycle__ModuleGraph(*graph, a);
+    struct String *cycle_b = get_cycle__ModuleGraph(*graph, b);
+    Str cycle_a_str = to_Str__String(*cycle_a);
+    Str cycle_b_str = to_Str__String(*cycle_b);
+
+    TEST_ASSERT(
+      !strcmp(cycle_a_str, "a.lily -> b.lily -> c.lily -> a.lily"));
+    TEST_ASSERT(!strcmp(cycle_b_str, "b.lily -> c.lily -> b.lily"));
+
+    FREE(String, cycle_a);
+    FREE(String, cycle_b);
+    free(cycle_a_str);
+    free(cycle_b_str);
+    FREE(ModuleGraph, graph);
+
+    return TEST_SUCCESS;
+}
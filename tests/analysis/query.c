@@ -0,0 +1,64 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <lang/analysis/query.h>
+#include <lang/analysis/typecheck.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_query_states()
+{
+    struct QueryEngine *engine = NEW(QueryEngine);
+    enum QueryState state = QueryStateUnchecked;
+
+    TEST_ASSERT_EQ(begin__QueryEngine(engine, QueryKindTypeOf, &state),
+                   QueryStatusMiss);
+    TEST_ASSERT_EQ(state, QueryStateInProgress);
+
+    // Reached again during its own evaluation.
+    TEST_ASSERT_EQ(begin__QueryEngine(engine, QueryKindTypeOf, &state),
+                   QueryStatusCycle);
+
+    end__QueryEngine(&state);
+
+    TEST_ASSERT_EQ(begin__QueryEngine(engine, QueryKindTypeOf, &state),
+                   QueryStatusHit);
+    TEST_ASSERT_EQ(engine->misses[QueryKindTypeOf], 1);
+    TEST_ASSERT_EQ(engine->cycles[QueryKindTypeOf], 1);
+    TEST_ASSERT_EQ(engine->hits[QueryKindTypeOf], 1);
+    TEST_ASSERT_EQ(engine->misses[QueryKindSignatureOf], 0);
+
+    FREE(QueryEngine, engine);
+
+    return TEST_SUCCESS;
+}
+
+// Color is reached by check_symbols and by the data type of A and B: its
+// signature is checked once, and its name is resolved once.
+static int
+test_query_once()
+{
+    struct Source src =
+      NEW(Source, NEW(File, "./tests/analysis/query/signature.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    struct Typecheck tc = NEW(Typecheck, parser);
+
+    run__Typecheck(&tc, NULL);
+
+    struct QueryEngine *queries = tc.graph->queries;
+
+    TEST_ASSERT_EQ(queries->misses[QueryKindSignatureOf], 5);
+    TEST_ASSERT_EQ(queries->hits[QueryKindSignatureOf], 2);
+    TEST_ASSERT_EQ(queries->misses[QueryKindTypeOf], 3);
+    TEST_ASSERT_EQ(queries->misses[QueryKindResolve], 1);
+    TEST_ASSERT_EQ(queries->hits[QueryKindResolve], 1);
+
+    for (Usize i = 0; i < QUERY_KIND_COUNT; i++)
+        TEST_ASSERT_EQ(queries->cycles[i], 0);
+
+    FREE(Typecheck, tc);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,73 @@
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+#include <lang/analysis/scope_index.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static int
+test_scope_index_shadowing()
+{
+    struct ScopeIndex *index = NEW(ScopeIndex);
+    struct String *add = from__String("add");
+    struct String *sub = from__String("sub");
+    struct String *unknown = from__String("unknown");
+    int fun = 0, constant = 0, module = 0;
+
+    add__ScopeIndex(index, add, ScopeItemKindFun, 0, &fun);
+    add__ScopeIndex(index, sub, ScopeItemKindFun, 1, &fun);
+    add__ScopeIndex(index, add, ScopeItemKindConstant, 0, &constant);
+
+    // The last symbol added with a name wins.
+    struct ScopeIndexItem *item = get__ScopeIndex(index, add);
+
+    TEST_ASSERT(item);
+    TEST_ASSERT_EQ(item->kind, ScopeItemKindConstant);
+    TEST_ASSERT_EQ(item->symbol, &constant);
+    TEST_ASSERT_EQ(item->next->symbol, &fun);
+
+    // The shadowed symbols are still reachable by kind.
+    item = get_with_kind__ScopeIndex(index, add, ScopeItemKindFun);
+
+    TEST_ASSERT(item);
+    TEST_ASSERT_EQ(item->id, 0);
+    TEST_ASSERT_EQ(item->symbol, &fun);
+
+    item = get_with_kind__ScopeIndex(index, sub, ScopeItemKindFun);
+
+    TEST_ASSERT(item);
+    TEST_ASSERT_EQ(item->id, 1);
+
+    add__ScopeIndex(index, sub, ScopeItemKindModule, 0, &module);
+
+    TEST_ASSERT_EQ(get__ScopeIndex(index, sub)->symbol, &module);
+    TEST_ASSERT(!get_with_kind__ScopeIndex(index, add, ScopeItemKindModule));
+    TEST_ASSERT(!get__ScopeIndex(index, unknown));
+
+    FREE(String, add);
+    FREE(String, sub);
+    FREE(String, unknown);
+    FREE(ScopeIndex, index);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_scope_index_long_name()
+{
+    struct ScopeIndex *index = NEW(ScopeIndex);
+    struct String *name = NEW(String);
+    int symbol = 0;
+
+    for (Usize i = 0; i < 1000; i++)
+        push__String(name, (char *)(UPtr)('a' + i % 26));
+
+    add__ScopeIndex(index, name, ScopeItemKindVariable, 0, &symbol);
+
+    TEST_ASSERT_EQ(get__ScopeIndex(index, name)->symbol, &symbol);
+
+    FREE(String, name);
+    FREE(ScopeIndex, index);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,159 @@
+#include <base/new.h>
+#include <base/option.h>
+#include <base/test.h>
+#include <base/writer.h>
+#include <lang/diagnostic/diagnostic.h>
+#include <lang/diagnostic/sink.h>
+#include <lang/scanner/scanner.h>
+#include <string.h>
+#include <threads.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static struct Diagnostic *
+new_sink_error(struct File file, Usize line, Usize col)
+{
+    return NEW(DiagnosticWithErr,
+               NEW(LilyError, LilyErrorDuplicateDeclaration),
+               (struct Location){
+                 .s_line = line, .s_col = col, .e_line = line, .e_col = col },
+               file,
+               from__String(""),
+               None());
+}
+
+static struct Diagnostic *
+new_sink_note(struct File file, Usize line, Usize col)
+{
+    return NEW(DiagnosticWithNote,
+               from__String("note"),
+               (struct Location){
+                 .s_line = line, .s_col = col, .e_line = line, .e_col = col },
+               file,
+               from__String(""),
+               None());
+}
+
+// Render the sink in writer and return the output as a C string.
+static Str
+render_sink(struct DiagnosticSink *sink, struct Writer *writer, Usize *len)
+{
+    *len = render__DiagnosticSink(sink, writer);
+    write_char__Writer(writer, '\0');
+
+    return writer->buffer;
+}
+
+static int
+test_sink_sort()
+{
+    struct File file = NEW(File, "./tests/analysis/incremental/a.lily");
+    struct DiagnosticSink *sink = NEW(DiagnosticSink, 0);
+    struct Writer writer = NEW(WriterBuffer);
+    Usize len = 0;
+
+    push__DiagnosticSink(sink, new_sink_error(file, 8, 5));
+    push__DiagnosticSink(sink, new_sink_note(file, 1, 1));
+    push__DiagnosticSink(sink, new_sink_error(file, 6, 1));
+    push__DiagnosticSink(sink, new_sink_error(file, 8, 5));
+    push__DiagnosticSink(sink, new_sink_error(file, 6, 3));
+
+    TEST_ASSERT_EQ(sink->count_error, 4);
+
+    Str output = render_sink(sink, &writer, &len);
+    Str first = strstr(output, "a.lily:6:1:");
+    Str second = strstr(output, "a.lily:6:3:");
+    Str third = strstr(output, "a.lily:8:5:");
+    Str note = strstr(output, "a.lily:1:1:");
+
+    // The duplicate is dropped and the note stays after its error.
+    TEST_ASSERT_EQ(len, 4);
+    TEST_ASSERT_EQ(sink->count_error, 3);
+    TEST_ASSERT(first && second && third && note);
+    TEST_ASSERT(first < second && second < third && third < note);
+    TEST_ASSERT(!strstr(third + 1, "a.lily:8:5:"));
+
+    FREE(Writer, writer);
+    FREE(DiagnosticSink, sink);
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_sink_error_limit()
+{
+    struct File file = NEW(File, "./tests/analysis/incremental/a.lily");
+    struct DiagnosticSink *sink = NEW(DiagnosticSink, 2);
+    struct Writer writer = NEW(WriterBuffer);
+    Usize len = 0;
+
+    for (Usize i = 5; i > 0; i--)
+        push__DiagnosticSink(sink, new_sink_error(file, i, 1));
+
+    Str output = render_sink(sink, &writer, &len);
+
+    TEST_ASSERT_EQ(len, 2);
+    TEST_ASSERT(strstr(output, "a.lily:1:1:"));
+    TEST_ASSERT(strstr(output, "a.lily:2:1:"));
+    TEST_ASSERT(!strstr(output, "a.lily:3:1:"));
+    TEST_ASSERT(strstr(output, "3 more errors are not shown"));
+
+    // The summary counts all the errors.
+    TEST_ASSERT_EQ(sink->count_error, 5);
+
+    FREE(Writer, writer);
+    FREE(DiagnosticSink, sink);
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
+
+typedef struct SinkThread
+{
+    struct DiagnosticSink *sink;
+    struct File file;
+} SinkThread;
+
+static int
+push_sink_thread(void *data)
+{
+    struct SinkThread *thread = data;
+
+    for (Usize i = 0; i < 1000; i++)
+        push__DiagnosticSink(thread->sink,
+                             new_sink_error(thread->file, i % 10 + 1, 1));
+
+    return 0;
+}
+
+static int
+test_sink_threads()
+{
+    struct File file = NEW(File, "./tests/analysis/incremental/a.lily");
+    struct SinkThread thread = { .sink = NEW(DiagnosticSink, 0),
+                                 .file = file };
+    struct Writer writer = NEW(WriterBuffer);
+    thrd_t threads[4];
+    Usize len = 0;
+
+    for (Usize i = 0; i < 4; i++)
+        thrd_create(&threads[i], &push_sink_thread, &thread);
+
+    for (Usize i = 0; i < 4; i++)
+        thrd_join(threads[i], NULL);
+
+    TEST_ASSERT_EQ(thread.sink->len, 4000);
+
+    render_sink(thread.sink, &writer, &len);
+
+    // The identical errors of all the threads are rendered once.
+    TEST_ASSERT_EQ(len, 10);
+    TEST_ASSERT_EQ(thread.sink->count_error, 10);
+
+    FREE(Writer, writer);
+    FREE(DiagnosticSink, thread.sink);
+    FREE(File, file);
+
+    return TEST_SUCCESS;
+}
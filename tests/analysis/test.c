@@ -1,20 +1,35 @@
 #include "alias.c"
+#include "builtin.c"
 #include "class.c"
+#include "duplicate.c"
 #include "enum.c"
 #include "error.c"
 #include "expr.c"
+#include "file_cache.c"
 #include "fun.c"
 #include "global_access.c"
 #include "identifier_access.c"
 #include "import.c"
+#include "import_dag.c"
+#include "incremental.c"
+#include "infer.c"
+#include "ir.c"
+#include "layout.c"
+#include "local_scope.c"
 #include "module.c"
+#include "module_graph.c"
 #include "object.c"
+#include "query.c"
 #include "record.c"
+#include "scope_index.c"
 #include "self_access.c"
+#include "sink.c"
 #include "stmt.c"
 #include "tag.c"
+#include "thread_pool.c"
 #include "trait.c"
 #include "type.c"
+#include "type_interner.c"
 #include "variable.c"
 #include <base/new.h>
 #include <base/test.h>
@@ -41,6 +56,21 @@ main()
     struct Suite *trait = NEW(Suite, "trait");
     struct Suite *type = NEW(Suite, "type");
     struct Suite *variable = NEW(Suite, "variable");
+    struct Suite *module_graph = NEW(Suite, "module_graph");
+    struct Suite *builtin = NEW(Suite, "builtin");
+    struct Suite *scope_index = NEW(Suite, "scope_index");
+    struct Suite *local_scope = NEW(Suite, "local_scope");
+    struct Suite *thread_pool = NEW(Suite, "thread_pool");
+    struct Suite *import_dag = NEW(Suite, "import_dag");
+    struct Suite *type_interner = NEW(Suite, "type_interner");
+    struct Suite *query = NEW(Suite, "query");
+    struct Suite *infer = NEW(Suite, "infer");
+    struct Suite *duplicate = NEW(Suite, "duplicate");
+    struct Suite *incremental = NEW(Suite, "incremental");
+    struct Suite *sink = NEW(Suite, "sink");
+    struct Suite *file_cache = NEW(Suite, "file_cache");
+    struct Suite *ir = NEW(Suite, "ir");
+    struct Suite *layout = NEW(Suite, "layout");
 
     CASE(fun, infer on fun params, test_fun_param_inference);
     CASE(fun, check generic param, test_fun_param_generic);
@@ -141,6 +171,69 @@ main()
     CASE(type, simple test, test_type);
 
     CASE(variable, check variable data type, test_variable_data_type);
+
+    CASE(module_graph, shared import, test_module_graph_shared_import);
+    CASE(module_graph, cycle path, test_module_graph_cycle_path);
+    CASE(module_graph, waves, test_module_graph_waves);
+
+    CASE(builtin, shared table, test_builtin_shared_table);
+    CASE(builtin, search, test_builtin_search);
+
+    CASE(scope_index, shadowing, test_scope_index_shadowing);
+    CASE(scope_index, long name, test_scope_index_long_name);
+
+    CASE(local_scope, depth and slot, test_local_scope_slot);
+
+    CASE(thread_pool, each task once, test_thread_pool_each_task_once);
+
+    CASE(import_dag, waves, test_import_dag_waves);
+    CASE(import_dag, cycle, test_import_dag_cycle);
+
+    CASE(type_interner, equal, test_type_interner_equal);
+    CASE(type_interner, builtins, test_type_interner_builtins);
+    CASE(type_interner, distinct, test_type_interner_distinct);
+
+    CASE(query, states, test_query_states);
+    CASE(query, once, test_query_once);
+
+    CASE(infer, unify, test_infer_unify);
+    CASE(infer, mismatch, test_infer_mismatch);
+    CASE(infer, occurs, test_infer_occurs);
+    CASE(infer, generalize, test_infer_generalize);
+    CASE(infer, chain, test_infer_chain);
+
+    CASE(duplicate, conflicts, test_duplicate_conflicts);
+    CASE(duplicate, tag, test_duplicate_tag);
+    CASE(duplicate, scaling, test_duplicate_scaling);
+
+    CASE(incremental, dep graph, test_incremental_dep_graph);
+    CASE(incremental, deps, test_incremental_deps);
+    CASE(incremental, body change, test_incremental_body_change);
+    CASE(incremental, signature change, test_incremental_signature_change);
+    CASE(incremental, moved decl, test_incremental_moved_decl);
+    CASE(incremental, added decl, test_incremental_added_decl);
+
+    CASE(sink, sort, test_sink_sort);
+    CASE(sink, error limit, test_sink_error_limit);
+    CASE(sink, threads, test_sink_threads);
+
+    CASE(file_cache, lines, test_file_cache_lines);
+    CASE(file_cache, same name, test_file_cache_same_name);
+    CASE(file_cache, render, test_file_cache_render);
+
+    CASE(ir, fold, test_ir_fold);
+    CASE(ir, inline, test_ir_inline);
+    CASE(ir, dead code, test_ir_dead_code);
+    CASE(ir, constant, test_ir_constant);
+    CASE(ir, mono, test_ir_mono);
+    CASE(ir, match, test_ir_match);
+    CASE(ir, tail, test_ir_tail);
+    CASE(ir, closure, test_ir_closure);
+    CASE(ir, range, test_ir_range);
+    CASE(ir, constant overflow, test_ir_constant_overflow);
+
+    CASE(layout, records enums and optionals, test_layout);
+    CASE(layout, report, test_layout_report);
     
     SUITE(t, fun);
     SUITE(t, class);
@@ -160,6 +253,21 @@ main()
     SUITE(t, trait);
     SUITE(t, type);
     SUITE(t, variable);
+    SUITE(t, module_graph);
+    SUITE(t, builtin);
+    SUITE(t, scope_index);
+    SUITE(t, local_scope);
+    SUITE(t, thread_pool);
+    SUITE(t, import_dag);
+    SUITE(t, type_interner);
+    SUITE(t, query);
+    SUITE(t, infer);
+    SUITE(t, duplicate);
+    SUITE(t, incremental);
+    SUITE(t, sink);
+    SUITE(t, file_cache);
+    SUITE(t, layout);
+    SUITE(t, ir);
 
     RUN_TEST(t);
 }
@@ -0,0 +1,42 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <base/thread_pool.h>
+#include <stdatomic.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+#define THREAD_POOL_TASK_COUNT 1000
+
+static void
+count_task(void *data, Usize task)
+{
+    atomic_fetch_add(&((_Atomic Usize *)data)[task], 1);
+}
+
+static int
+test_thread_pool_each_task_once()
+{
+    static _Atomic Usize counts[THREAD_POOL_TASK_COUNT];
+    const Usize worker_counts[] = { 1, 4, 16 };
+    const Usize task_counts[] = { 0, 3, THREAD_POOL_TASK_COUNT };
+
+    for (Usize w = 0; w < sizeof(worker_counts) / sizeof(*worker_counts); w++)
+        for (Usize t = 0; t < sizeof(task_counts) / sizeof(*task_counts); t++) {
+            struct ThreadPool *pool = NEW(ThreadPool, worker_counts[w]);
+
+            for (Usize i = 0; i < THREAD_POOL_TASK_COUNT; i++)
+                atomic_init(&counts[i], 0);
+
+            run__ThreadPool(pool, task_counts[t], &count_task, counts);
+
+            for (Usize i = 0; i < THREAD_POOL_TASK_COUNT; i++) {
+                Usize expected = i < task_counts[t] ? 1 : 0;
+
+                TEST_ASSERT_EQ(atomic_load(&counts[i]), expected);
+            }
+
+            FREE(ThreadPool, pool);
+        }
+
+    return TEST_SUCCESS;
+}
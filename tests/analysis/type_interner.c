@@ -0,0 +1,123 @@
+#include <base/new.h>
+#include <base/test.h>
+#include <base/vec.h>
+#include <lang/analysis/symbol_table.h>
+#include <lang/analysis/type_interner.h>
+#include <lang/builtin/builtin_c.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+static struct DataTypeSymbol *
+new_pair(struct TypeInterner *types,
+         struct DataTypeSymbol *first,
+         struct DataTypeSymbol *second)
+{
+    struct Vec *tuple = NEW(Vec, sizeof(struct DataTypeSymbol));
+
+    push__Vec(tuple, first);
+    push__Vec(tuple, second);
+
+    return NEW(DataTypeSymbolTuple, types, tuple);
+}
+
+static int
+test_type_interner_equal()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+    struct DataTypeSymbol *str = NEW(DataTypeSymbol, types, DataTypeKindStr);
+    Usize size = 4;
+    Usize same_size = 4;
+    Usize other_size = 5;
+
+    TEST_ASSERT_EQ(i32, NEW(DataTypeSymbol, types, DataTypeKindI32));
+    TEST_ASSERT_NE(i32, str);
+    TEST_ASSERT_EQ(
+      NEW(DataTypeSymbolOptional, types, NEW(DataTypeSymbolPtr, types, i32)),
+      NEW(DataTypeSymbolOptional, types, NEW(DataTypeSymbolPtr, types, i32)));
+    TEST_ASSERT_NE(NEW(DataTypeSymbolPtr, types, i32),
+                   NEW(DataTypeSymbolRef, types, i32));
+
+    // The size of an array is compared by value.
+    TEST_ASSERT_EQ(NEW(DataTypeSymbolArray, types, i32, &size),
+                   NEW(DataTypeSymbolArray, types, i32, &same_size));
+    TEST_ASSERT_NE(NEW(DataTypeSymbolArray, types, i32, &size),
+                   NEW(DataTypeSymbolArray, types, i32, &other_size));
+    TEST_ASSERT_NE(NEW(DataTypeSymbolArray, types, i32, &size),
+                   NEW(DataTypeSymbolArray, types, i32, NULL));
+
+    TEST_ASSERT_EQ(new_pair(types, i32, str), new_pair(types, i32, str));
+    TEST_ASSERT_NE(new_pair(types, i32, str), new_pair(types, str, i32));
+    TEST_ASSERT_NE(NEW(DataTypeSymbolTuple, types, NULL),
+                   NEW(DataTypeSymbolTuple,
+                       types,
+                       NEW(Vec, sizeof(struct DataTypeSymbol))));
+
+    TEST_ASSERT_EQ(
+      NEW(DataTypeSymbolCompilerDefined,
+          types,
+          NEW(CompilerDefinedDataType, "T", false)),
+      NEW(DataTypeSymbolCompilerDefined,
+          types,
+          NEW(CompilerDefinedDataType, "T", false)));
+    TEST_ASSERT_NE(
+      NEW(DataTypeSymbolCompilerDefined,
+          types,
+          NEW(CompilerDefinedDataType, "T", false)),
+      NEW(DataTypeSymbolCompilerDefined,
+          types,
+          NEW(CompilerDefinedDataType, "T", true)));
+
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+// The data types of the builtins are the interned instances.
+static int
+test_type_interner_builtins()
+{
+    const struct BuiltinTable *builtins = Load_C_builtins();
+    struct TypeInterner *types = NEW(TypeInterner, builtins);
+    const struct BuiltinFun *sub =
+      search__BuiltinTable(builtins, "Int32", "-", 3);
+    const struct BuiltinFun *assign =
+      search__BuiltinTable(builtins, "Int32", "=", 3);
+    Usize len = len__TypeInterner(types);
+    struct DataTypeSymbol *i32 = NEW(DataTypeSymbol, types, DataTypeKindI32);
+
+    TEST_ASSERT(len >= builtins->type_count);
+    TEST_ASSERT_EQ(get__Vec(*sub->params, 0), i32);
+    TEST_ASSERT_EQ(get__Vec(*assign->params, 0),
+                   NEW(DataTypeSymbolMut, types, i32));
+    TEST_ASSERT_EQ(len__TypeInterner(types), len);
+
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
+
+// The memory is bounded by the number of distinct data types, not by the
+// number of occurrences.
+static int
+test_type_interner_distinct()
+{
+    struct TypeInterner *types = NEW(TypeInterner, NULL);
+    Usize len = 0;
+
+    for (Usize i = 0; i < 10000; i++) {
+        struct DataTypeSymbol *dt = NEW(DataTypeSymbol, types, DataTypeKindU8);
+
+        for (Usize j = 0; j < 8; j++)
+            dt = new_pair(types, NEW(DataTypeSymbolOptional, types, dt), dt);
+
+        if (i == 0)
+            len = len__TypeInterner(types);
+    }
+
+    TEST_ASSERT_EQ(len__TypeInterner(types), len);
+
+    FREE(TypeInterner, types);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#!/bin/sh
+
+# MIT License
+#
+# Copyright (c) 2022 ArthurPV
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Compile each program of the directory with `lily compile` at -O0, -O1 and
+# -O2, build the generated C and compare its output with the .out file of the
+# program. A program with a .err file must be rejected, with -j 1 and -j 4,
+# and the diagnostics (without colors) are compared with this file. The
+# directory named like the program holds the modules imported by the program.
+#
+# Usage: tests/codegen/run.sh <path of lily> [C compiler]
+
+LILY=$(realpath "$1")
+CC=${2:-cc}
+DIR=$(cd "$(dirname "$0")" && pwd)
+OUT=$(mktemp -d)
+FAILED=0
+
+trap 'rm -rf "$OUT"' EXIT
+
+export LILY_NO_CACHE=1
+
+fail() {
+    echo "error: $1" >&2
+    FAILED=1
+}
+
+for program in "$DIR"/*.lily; do
+    name=$(basename "$program" .lily)
+
+    if [ -d "$DIR/$name" ]; then
+        cp -R "$DIR/$name" "$OUT/$name"
+    fi
+
+    if [ -f "$DIR/$name.err" ]; then
+        for jobs in 1 4; do
+            cp "$program" "$OUT/$name.lily"
+
+            if (cd "$OUT" && "$LILY" compile -j $jobs "$name.lily" \
+                  > "$OUT/$name.output" 2>&1); then
+                fail "$name -j $jobs: the program is not rejected"
+                continue
+            fi
+
+            sed 's/\x1b\[[0-9;]*m//g' "$OUT/$name.output" > "$OUT/$name.diagnostics"
+
+            if ! cmp -s "$OUT/$name.diagnostics" "$DIR/$name.err"; then
+                fail "$name -j $jobs: the diagnostics are different"
+                diff "$DIR/$name.err" "$OUT/$name.diagnostics" >&2
+            fi
+        done
+
+        continue
+    fi
+
+    for level in -O0 -O1 -O2; do
+        cp "$program" "$OUT/$name.lily"
+        rm -f "$OUT/$name.lily.c"
+
+        if ! (cd "$OUT" && "$LILY" compile $level "$name.lily" > /dev/null); then
+            fail "$name $level: lily compile has failed"
+            continue
+        fi
+
+        if ! $CC -std=gnu11 -w "$OUT/$name.lily.c" -o "$OUT/$name"; then
+            fail "$name $level: the generated C does not compile"
+            continue
+        fi
+
+        "$OUT/$name" > "$OUT/$name.output" 2> /dev/null
+
+        if ! cmp -s "$OUT/$name.output" "$DIR/$name.out"; then
+            fail "$name $level: the output is different"
+            diff "$DIR/$name.out" "$OUT/$name.output" >&2
+        fi
+    done
+done
+
+exit $FAILED
@@ -0,0 +1,174 @@
+#include <base/file.h>
+#include <base/format.h>
+#include <base/new.h>
+#include <base/test.h>
+#include <base/writer.h>
+#include <lang/parser/ast_dump.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Dump the declarations of ./tests/parser/<name>.lily and compare the dump
+// with ./tests/parser/golden/<name>.<json|sexpr>. When LILY_UPDATE_GOLDEN is
+// set, the golden file is rewritten instead.
+static bool
+compare_golden(Str name, enum AstDumpKind kind)
+{
+    struct String *filename_s = format("./tests/parser/{s}.lily", name);
+    struct String *golden_s =
+      format("./tests/parser/golden/{s}.{s}",
+             name,
+             kind == AstDumpKindJson ? "json" : "sexpr");
+    Str filename = to_Str__String(*filename_s);
+    Str golden = to_Str__String(*golden_s);
+
+    struct Source src = NEW(Source, NEW(File, filename));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    run__Parser(&parser);
+
+    struct Writer writer = NEW(WriterBuffer);
+    struct AstDump dump = NEW(AstDump, &writer, kind);
+
+    dump_decls__AstDump(&dump, parser.decls);
+
+    Str output = take__Writer(&writer);
+    struct Path *path = NEW(Path, golden);
+    bool res = true;
+
+    if (getenv("LILY_UPDATE_GOLDEN"))
+        write_file__Path(*path, output);
+    else {
+        struct String *expected_s = read_file__Path(*path);
+        Str expected = to_Str__String(*expected_s);
+        Usize output_len = strlen(output);
+
+        // read_file__Path adds a newline at the end of the content.
+        res = strlen(expected) == output_len + 1 &&
+              !strncmp(expected, output, output_len);
+
+        if (!res)
+            printf("\n%s differs from the dump:\n%s", golden, output);
+
+        FREE(String, expected_s);
+        free(expected);
+    }
+
+    FREE(Path, path);
+    free(output);
+    FREE(AstDump, dump);
+    FREE(Writer, writer);
+    FREE(Parser, parser);
+    FREE(String, filename_s);
+    FREE(String, golden_s);
+    free(filename);
+    free(golden);
+
+    return res;
+}
+
+static int
+test_ast_dump_golden()
+{
+    const Str names[] = {
+        "alias",
+        "class",
+        "constant",
+        "enum",
+        "error",
+        "expr_array",
+        "expr_array_access",
+        "expr_binaryop",
+        "expr_block",
+        "expr_dereference",
+        "expr_fun_call",
+        "expr_global_access",
+        "expr_grouping",
+        "expr_identifier",
+        "expr_identifier_access",
+        "expr_if",
+        "expr_lambda",
+        "expr_literal",
+        "expr_nil",
+        "expr_none",
+        "expr_question_mark",
+        "expr_record_call",
+        "expr_ref",
+        "expr_self",
+        "expr_try",
+        "expr_tuple",
+        "expr_tuple_access",
+        "expr_unaryop",
+        "expr_undef",
+        "expr_variable",
+        "expr_variant",
+        "expr_wildcard",
+        "fun",
+        "import",
+        "import_builtin",
+        "import_core",
+        "import_file",
+        "import_std",
+        "import_url",
+        "module",
+        "record",
+        "stmt",
+        "stmt_await",
+        "stmt_break",
+        "stmt_for",
+        "stmt_if",
+        "stmt_import",
+        "stmt_match",
+        "stmt_next",
+        "stmt_return",
+        "stmt_try",
+        "stmt_while",
+        "tag",
+        "trait",
+    };
+
+    for (Usize i = 0; i < sizeof(names) / sizeof(*names); i++) {
+        TEST_ASSERT(compare_golden(names[i], AstDumpKindJson));
+        TEST_ASSERT(compare_golden(names[i], AstDumpKindSexpr));
+    }
+
+    return TEST_SUCCESS;
+}
+
+// The writer must give the same dump when it's flushed in a file descriptor.
+static int
+test_ast_dump_fd()
+{
+    struct Source src = NEW(Source, NEW(File, "./tests/parser/class.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    run__Parser(&parser);
+
+    FILE *file = tmpfile();
+    struct Writer fd_writer = NEW(WriterFd, fileno(file));
+    struct Writer buffer_writer = NEW(WriterBuffer);
+    struct AstDump fd_dump = NEW(AstDump, &fd_writer, AstDumpKindJson);
+    struct AstDump buffer_dump = NEW(AstDump, &buffer_writer, AstDumpKindJson);
+
+    dump_decls__AstDump(&fd_dump, parser.decls);
+    dump_decls__AstDump(&buffer_dump, parser.decls);
+    TEST_ASSERT(flush__Writer(&fd_writer));
+
+    Str expected = take__Writer(&buffer_writer);
+    Usize len = strlen(expected);
+    char *output = malloc(len + 1);
+
+    rewind(file);
+    TEST_ASSERT_EQ(fread(output, 1, len + 1, file), len);
+    TEST_ASSERT(!memcmp(expected, output, len));
+
+    free(output);
+    free(expected);
+    fclose(file);
+    FREE(AstDump, fd_dump);
+    FREE(AstDump, buffer_dump);
+    FREE(Writer, fd_writer);
+    FREE(Writer, buffer_writer);
+    FREE(Parser, parser);
+
+    return TEST_SUCCESS;
+}
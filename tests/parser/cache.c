@@ -0,0 +1,265 @@
+#include <base/file.h>
+#include <base/new.h>
+#include <base/print.h>
+#include <base/test.h>
+#include <base/writer.h>
+#include <lang/diagnostic/sink.h>
+#include <lang/parser/cache.h>
+#include <lang/parser/parser.h>
+#include <lang/scanner/scanner.h>
+#include <lang/scanner/token.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+// Serialize and deserialize the declarations of the file, then compare the
+// dump of each declaration with the dump of the original declaration.
+static bool
+round_trip_cache(Str filename)
+{
+    struct Source src = NEW(Source, NEW(File, filename));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    run__Parser(&parser);
+
+    UInt64 hash = hash__AstCache(*src.file.content);
+    Usize size = 0;
+    UInt8 *buffer =
+      serialize__AstCache(parser.decls, &parser.parse_block, hash, &size);
+    struct Vec *strings = NEW(Vec, sizeof(struct String));
+    struct ParseBlock parse_block = {
+        .disable_warning = NEW(Vec, sizeof(struct String)),
+        .warnings = NEW(Vec, sizeof(struct ParseWarning))
+    };
+    struct Vec *decls =
+      deserialize__AstCache(buffer, size, hash, strings, &parse_block);
+    bool res = decls && len__Vec(*decls) == len__Vec(*parser.decls) &&
+               len__Vec(*parse_block.disable_warning) ==
+                 len__Vec(*parser.parse_block.disable_warning) &&
+               len__Vec(*parse_block.warnings) ==
+                 len__Vec(*parser.parse_block.warnings);
+
+    for (Usize i = 0; res && i < len__Vec(*decls); i++) {
+        struct String *expected =
+          to_String__Decl(*(struct Decl *)get__Vec(*parser.decls, i));
+        struct String *output =
+          to_String__Decl(*(struct Decl *)get__Vec(*decls, i));
+        Str expected_str = to_Str__String(*expected);
+        Str output_str = to_Str__String(*output);
+
+        res = !strcmp(expected_str, output_str);
+
+        FREE(String, expected);
+        FREE(String, output);
+        free(expected_str);
+        free(output_str);
+    }
+
+    if (decls) {
+        for (Usize i = len__Vec(*decls); i--;)
+            FREE(DeclAll, get__Vec(*decls, i));
+
+        FREE(Vec, decls);
+    }
+
+    for (Usize i = len__Vec(*parse_block.warnings); i--;)
+        FREE(ParseWarning, get__Vec(*parse_block.warnings, i));
+
+    FREE(Vec, parse_block.disable_warning);
+    FREE(Vec, parse_block.warnings);
+
+    for (Usize i = len__Vec(*strings); i--;)
+        FREE(String, get__Vec(*strings, i));
+
+    FREE(Vec, strings);
+    free(buffer);
+    FREE(Parser, parser);
+
+    return res;
+}
+
+static int
+test_cache_round_trip()
+{
+    const Str filenames[] = {
+        "./tests/parser/alias.lily",
+        "./tests/parser/class.lily",
+        "./tests/parser/constant.lily",
+        "./tests/parser/enum.lily",
+        "./tests/parser/error.lily",
+        "./tests/parser/expr_array.lily",
+        "./tests/parser/expr_array_access.lily",
+        "./tests/parser/expr_binaryop.lily",
+        "./tests/parser/expr_block.lily",
+        "./tests/parser/expr_dereference.lily",
+        "./tests/parser/expr_fun_call.lily",
+        "./tests/parser/expr_global_access.lily",
+        "./tests/parser/expr_grouping.lily",
+        "./tests/parser/expr_identifier.lily",
+        "./tests/parser/expr_identifier_access.lily",
+        "./tests/parser/expr_if.lily",
+        "./tests/parser/expr_lambda.lily",
+        "./tests/parser/expr_literal.lily",
+        "./tests/parser/expr_nil.lily",
+        "./tests/parser/expr_none.lily",
+        "./tests/parser/expr_question_mark.lily",
+        "./tests/parser/expr_record_call.lily",
+        "./tests/parser/expr_ref.lily",
+        "./tests/parser/expr_self.lily",
+        "./tests/parser/expr_try.lily",
+        "./tests/parser/expr_tuple.lily",
+        "./tests/parser/expr_tuple_access.lily",
+        "./tests/parser/expr_unaryop.lily",
+        "./tests/parser/expr_undef.lily",
+        "./tests/parser/expr_variable.lily",
+        "./tests/parser/expr_variant.lily",
+        "./tests/parser/expr_wildcard.lily",
+        "./tests/parser/fun.lily",
+        "./tests/parser/import.lily",
+        "./tests/parser/import_builtin.lily",
+        "./tests/parser/import_core.lily",
+        "./tests/parser/import_file.lily",
+        "./tests/parser/import_std.lily",
+        "./tests/parser/import_url.lily",
+        "./tests/parser/module.lily",
+        "./tests/parser/record.lily",
+        "./tests/parser/stmt.lily",
+        "./tests/parser/stmt_await.lily",
+        "./tests/parser/stmt_break.lily",
+        "./tests/parser/stmt_for.lily",
+        "./tests/parser/stmt_if.lily",
+        "./tests/parser/stmt_import.lily",
+        "./tests/parser/stmt_match.lily",
+        "./tests/parser/stmt_next.lily",
+        "./tests/parser/stmt_return.lily",
+        "./tests/parser/stmt_try.lily",
+        "./tests/parser/stmt_while.lily",
+        "./tests/parser/tag.lily",
+        "./tests/parser/trait.lily",
+        "./tests/parser/warning.lily",
+    };
+
+    for (Usize i = 0; i < sizeof(filenames) / sizeof(*filenames); i++)
+        TEST_ASSERT(round_trip_cache(filenames[i]));
+
+    return TEST_SUCCESS;
+}
+
+static int
+test_cache_invalid()
+{
+    struct Source src = NEW(Source, NEW(File, "./tests/parser/fun.lily"));
+    struct Parser parser = NEW(Parser, NEW(ParseBlock, NEW(Scanner, &src)));
+    run__Parser(&parser);
+
+    UInt64 hash = hash__AstCache(*src.file.content);
+    Usize size = 0;
+    UInt8 *buffer =
+      serialize__AstCache(parser.decls, &parser.parse_block, hash, &size);
+    struct Vec *strings = NEW(Vec, sizeof(struct String));
+
+    // The hash of the source doesn't match.
+    TEST_ASSERT(!deserialize__AstCache(buffer, size, hash + 1, strings, NULL));
+
+    // The buffer is truncated.
+    TEST_ASSERT(!deserialize__AstCache(buffer, size - 1, hash, strings, NULL));
+
+    // The payload is corrupted.
+    buffer[size - 1] ^= 0xff;
+    TEST_ASSERT(!deserialize__AstCache(buffer, size, hash, strings, NULL));
+
+    TEST_ASSERT_EQ(len__Vec(*strings), 0);
+
+    FREE(Vec, strings);
+    free(buffer);
+    FREE(Parser, parser);
+
+    return TEST_SUCCESS;
+}
+
+// Parse the file with the cache and render the diagnostics of the parse.
+static Str
+render_parse_with_cache(Str filename, struct Vec *disable_warning)
+{
+    struct Source src = NEW(Source, NEW(File, filename));
+    struct Parser parser = NEW(ParserWithCache, &src);
+    struct Writer writer = NEW(WriterBuffer);
+
+    render__DiagnosticSink(global__DiagnosticSink(), &writer);
+    write_char__Writer(&writer, '\0');
+
+    for (Usize i = 0; i < len__Vec(*parser.parse_block.disable_warning); i++)
+        push__Vec(disable_warning,
+                  to_Str__String(*(struct String *)get__Vec(
+                    *parser.parse_block.disable_warning, i)));
+
+    Str res = strdup(writer.buffer);
+
+    FREE(Writer, writer);
+    FREE(Parser, parser);
+
+    return res;
+}
+
+// A source loaded from the cache reports the warnings of its parse, and keeps
+// its disabled warnings (used by the typecheck).
+static int
+test_cache_warnings()
+{
+    char dir[] = "/tmp/lily_cache_test_XXXXXX";
+
+    TEST_ASSERT(mkdtemp(dir));
+
+    setenv("LILY_CACHE_DIR", dir, 1);
+    unsetenv("LILY_NO_CACHE");
+
+    // Drop the diagnostics of the previous tests.
+    struct Writer writer = NEW(WriterBuffer);
+
+    render__DiagnosticSink(global__DiagnosticSink(), &writer);
+    FREE(Writer, writer);
+
+    struct Vec *cold_disable_warning = NEW(Vec, sizeof(Str));
+    struct Vec *warm_disable_warning = NEW(Vec, sizeof(Str));
+    Str cold = render_parse_with_cache("./tests/parser/warning.lily",
+                                       cold_disable_warning);
+    Str warm = render_parse_with_cache("./tests/parser/warning.lily",
+                                       warm_disable_warning);
+
+    TEST_ASSERT(strstr(cold, "warning.lily:8:8:"));
+    TEST_ASSERT(!strcmp(cold, warm));
+    TEST_ASSERT_EQ(len__Vec(*cold_disable_warning), 1);
+    TEST_ASSERT_EQ(len__Vec(*warm_disable_warning), 1);
+    TEST_ASSERT(!strcmp(get__Vec(*cold_disable_warning, 0), "0005"));
+    TEST_ASSERT(!strcmp(get__Vec(*warm_disable_warning, 0), "0005"));
+
+    for (Usize i = 0; i < len__Vec(*cold_disable_warning); i++)
+        free(get__Vec(*cold_disable_warning, i));
+
+    for (Usize i = 0; i < len__Vec(*warm_disable_warning); i++)
+        free(get__Vec(*warm_disable_warning, i));
+
+    FREE(Vec, cold_disable_warning);
+    FREE(Vec, warm_disable_warning);
+    free(cold);
+    free(warm);
+
+    // Remove the cache file and its directory.
+    struct File file = NEW(File, "./tests/parser/warning.lily");
+    char path[sizeof(dir) + 32];
+
+    snprintf(path,
+             sizeof(path),
+             "%s/%016llx.ast",
+             dir,
+             (unsigned long long)hash__AstCache(*file.content));
+
+    FREE(File, file);
+
+    TEST_ASSERT(!remove(path));
+    TEST_ASSERT(!rmdir(dir));
+    unsetenv("LILY_CACHE_DIR");
+
+    return TEST_SUCCESS;
+}
@@ -95,7 +95,7 @@ test_import_url()
         Str output_str = to_Str__String(*output);
 
         TEST_ASSERT(
-          !strcmp(output_str, "import \"@url((https://example.com)\""));
+          !strcmp(output_str, "import \"@url(https://example.com)\""));
 
         FREE(String, output);
         free(output_str);
@@ -119,7 +119,7 @@ test_import_file()
           to_String__Decl(*(struct Decl *)get__Vec(*parser.decls, 0));
         Str output_str = to_Str__String(*output);
 
-        TEST_ASSERT(!strcmp(output_str, "import \"@file((../../app)\""));
+        TEST_ASSERT(!strcmp(output_str, "import \"@file(../../app)\""));
 
         FREE(String, output);
         free(output_str);
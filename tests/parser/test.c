@@ -1,4 +1,6 @@
 #include "alias.c"
+#include "ast_dump.c"
+#include "cache.c"
 #include "class.c"
 #include "constant.c"
 #include "enum.c"
@@ -31,6 +33,8 @@ main()
     struct Suite *trait = NEW(Suite, "trait");
     struct Suite *expr = NEW(Suite, "expr");
     struct Suite *stmt = NEW(Suite, "stmt");
+    struct Suite *cache = NEW(Suite, "cache");
+    struct Suite *ast_dump = NEW(Suite, "ast dump");
 
     CASE(fun, simple, test_fun);
     CASE(constant, simple, test_constant);
@@ -91,6 +95,13 @@ main()
     CASE(stmt, import, test_stmt_import);
     CASE(stmt, simple, test_stmt);
 
+    CASE(cache, round trip, test_cache_round_trip);
+    CASE(cache, invalid, test_cache_invalid);
+    CASE(cache, warnings, test_cache_warnings);
+
+    CASE(ast_dump, golden, test_ast_dump_golden);
+    CASE(ast_dump, fd, test_ast_dump_fd);
+
     SUITE(t, fun);
     SUITE(t, constant);
     SUITE(t, module);
@@ -104,6 +115,8 @@ main()
     SUITE(t, trait);
     SUITE(t, expr);
     SUITE(t, stmt);
+    SUITE(t, cache);
+    SUITE(t, ast_dump);
 
     RUN_TEST(t);
 }